@@ -113,6 +113,42 @@ namespace
         PROFILER_FORCE_INLINE static VkSemaphore SignalSemaphore( const VkSubmitInfo2& info, uint32_t i ) { return info.pSignalSemaphoreInfos[ i ].semaphore; }
         PROFILER_FORCE_INLINE static VkSemaphore WaitSemaphore( const VkSubmitInfo2& info, uint32_t i ) { return info.pWaitSemaphoreInfos[ i ].semaphore; }
     };
+
+    static inline void GetPipelineCreationFeedback(
+        Profiler::DeviceProfilerPipelineCreationFeedbackData& feedbackData,
+        const void* pNext,
+        uint32_t stageCount,
+        const VkPipelineShaderStageCreateInfo* pStages )
+    {
+        feedbackData.m_Flags = 0;
+        feedbackData.m_Duration = 0;
+
+        const VkPipelineCreationFeedbackCreateInfo* pCreationFeedbackCreateInfo =
+            Profiler::PNextChain( pNext ).Find<VkPipelineCreationFeedbackCreateInfo>( VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO );
+
+        if( ( pCreationFeedbackCreateInfo == nullptr ) ||
+            ( pCreationFeedbackCreateInfo->pPipelineCreationFeedback == nullptr ) )
+        {
+            return;
+        }
+
+        feedbackData.m_Flags = pCreationFeedbackCreateInfo->pPipelineCreationFeedback->flags;
+        feedbackData.m_Duration = pCreationFeedbackCreateInfo->pPipelineCreationFeedback->duration;
+
+        // The driver may not report the per-stage feedback, e.g. for pipelines created from libraries.
+        const uint32_t stageFeedbackCount = std::min( stageCount, pCreationFeedbackCreateInfo->pipelineStageCreationFeedbackCount );
+        for( uint32_t i = 0; i < stageFeedbackCount; ++i )
+        {
+            const VkPipelineCreationFeedback& stageFeedback = pCreationFeedbackCreateInfo->pPipelineStageCreationFeedbacks[ i ];
+            if( stageFeedback.flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT )
+            {
+                Profiler::DeviceProfilerPipelineCreationFeedbackData::Stage& stage = feedbackData.m_Stages.emplace_back();
+                stage.m_Stage = pStages[ i ].stage;
+                stage.m_Flags = stageFeedback.flags;
+                stage.m_Duration = stageFeedback.duration;
+            }
+        }
+    }
 }
 
 namespace Profiler
@@ -132,19 +168,29 @@ namespace Profiler
         , m_DataMutex()
         , m_pData()
         , m_MemoryManager()
+        , m_IndirectArgumentCompactor()
         , m_DataAggregator()
         , m_FrameIndex( 0 )
         , m_DataBufferSize( 1 )
         , m_MinDataBufferSize( 1 )
         , m_LastFrameBeginTimestamp( 0 )
+        , m_DrawcallCount( 0 )
+        , m_DrawcallSamplingRate( 1 )
         , m_CpuTimestampCounter()
         , m_CpuFpsCounter()
+        , m_CpuTimeline()
         , m_MemoryTracker()
+        , m_Overhead()
+        , m_OverheadData()
+        , m_OverheadDegradations( 0 )
+        , m_OverheadBudgetCpuTime( 0 )
+        , m_OverheadBudgetMeasurementTime( 0 )
         , m_pCommandBuffers()
         , m_pCommandPools()
         , m_pPerformanceCounters( nullptr )
         , m_PipelineExecutablePropertiesEnabled( false )
         , m_ShaderModuleIdentifierEnabled( false )
+        , m_PipelineCreationFeedbackEnabled( false )
         , m_pStablePowerStateHandle( nullptr )
     {
     }
@@ -155,14 +201,16 @@ namespace Profiler
         SetupDeviceCreateInfo
 
     Description:
-        Get list of optional device extensions that may be utilized by the profiler.
+        Get list of optional device extensions and features that may be utilized by
+        the profiler.
 
     \***********************************************************************************/
     void DeviceProfiler::SetupDeviceCreateInfo(
         VkPhysicalDevice_Object& physicalDevice,
         const ProfilerLayerSettings& settings,
         std::unordered_set<std::string>& deviceExtensions,
-        PNextChain& devicePNextChain )
+        PNextChain& devicePNextChain,
+        VkPhysicalDeviceFeatures& enabledFeatures )
     {
         // Check if profiler create info was provided.
         const VkProfilerCreateInfoEXT* pProfilerCreateInfo =
@@ -229,6 +277,14 @@ namespace Profiler
             }
         }
 
+        // Enable pipeline creation feedback if available. The structures are core since Vulkan 1.3.
+        if( availableExtensionNames.count( VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME ) &&
+            ( ( physicalDevice.pInstance->ApplicationInfo.apiVersion < VK_API_VERSION_1_3 ) ||
+                ( physicalDevice.Properties.apiVersion < VK_API_VERSION_1_3 ) ) )
+        {
+            deviceExtensions.insert( VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME );
+        }
+
         // Enable performance query extensions if requested and available.
         if( config.m_EnablePerformanceQueryExt == enable_performance_query_ext_t::intel )
         {
@@ -284,6 +340,15 @@ namespace Profiler
                 deviceExtensions.insert( VK_EXT_MEMORY_BUDGET_EXTENSION_NAME );
             }
         }
+
+        // Enable pipeline statistics queries if requested and supported.
+        // Features passed in VkPhysicalDeviceFeatures2 structure are const and can't be modified by the layer.
+        if( config.m_EnablePipelineStatistics &&
+            physicalDevice.Features.pipelineStatisticsQuery &&
+            !devicePNextChain.Contains( VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2 ) )
+        {
+            enabledFeatures.pipelineStatisticsQuery = VK_TRUE;
+        }
     }
 
     /***********************************************************************************\
@@ -405,7 +470,7 @@ namespace Profiler
         }
 
         // Prepare for memory usage tracking
-        m_MemoryTracker.Initialize( m_pDevice );
+        m_MemoryTracker.Initialize( m_pDevice, m_Config );
 
         // Enable performance counters if available
         if( m_pDevice->EnabledExtensions.count( VK_INTEL_PERFORMANCE_QUERY_EXTENSION_NAME ) )
@@ -464,6 +529,12 @@ namespace Profiler
                 ( pShaderModuleIdentifierFeatures->shaderModuleIdentifier == VK_TRUE );
         }
 
+        // Collect pipeline creation feedback if available
+        m_PipelineCreationFeedbackEnabled =
+            ( ( m_pDevice->pInstance->ApplicationInfo.apiVersion >= VK_API_VERSION_1_3 ) &&
+                ( m_pDevice->pPhysicalDevice->Properties.apiVersion >= VK_API_VERSION_1_3 ) ) ||
+            m_pDevice->EnabledExtensions.count( VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME );
+
         // Initialize synchroniation manager
         DESTROYANDRETURNONFAIL( m_Synchronization.Initialize( m_pDevice ) );
 
@@ -474,16 +545,38 @@ namespace Profiler
         m_CpuFpsCounter.SetTimeDomain( hostTimeDomain );
 
         m_pDevice->TIP.SetTimeDomain( hostTimeDomain );
+        m_Overhead.SetTimeDomain( hostTimeDomain );
+        m_Overhead.SetCpuTimeMeasurementEnabled( m_Config.m_EnableOverheadAccounting || ( m_Config.m_OverheadCpuTimeBudget > 0 ) );
+        m_Overhead.SetCopyMeasurementEnabled( m_Config.m_EnableOverheadAccounting );
+        m_MemoryTracker.SetTimeDomain( hostTimeDomain );
+
+        // Start with the configured sampling rate, it is adjusted to the timestamp budget after each frame.
+        m_DrawcallSamplingRate = static_cast<uint32_t>( std::max( m_Config.m_DrawcallSamplingRate, 1 ) );
 
         // Initialize memory manager
         DESTROYANDRETURNONFAIL( m_MemoryManager.Initialize( m_pDevice ) );
 
+        if( m_Config.m_CaptureIndirectArguments )
+        {
+            // Copy only the live arguments of vkCmdDraw*IndirectCount commands.
+            // Indirect count arguments are captured up to the max draw count if the compaction pipeline is not available.
+            m_IndirectArgumentCompactor.Initialize( m_pDevice );
+        }
+
         // Initialize aggregator
         DESTROYANDRETURNONFAIL( m_DataAggregator.Initialize( this ) );
 
         m_pData = m_DataAggregator.GetAggregatedData();
         assert( !m_pData.empty() );
 
+        for( const std::shared_ptr<DeviceProfilerFrameData>& pFrameData : m_pData )
+        {
+            m_Overhead.AddHostMemory( DeviceProfilerHostMemoryOverheadCategory::eFrameData,
+                DeviceProfilerOverheadCounter::GetFrameDataSize( *pFrameData ) );
+            m_Overhead.AddHostMemory( DeviceProfilerHostMemoryOverheadCategory::eMemorySnapshots,
+                DeviceProfilerOverheadCounter::GetMemoryDataSize( pFrameData->m_Memory ) );
+        }
+
         // Initialize internal pipelines
         CreateInternalPipeline( DeviceProfilerPipelineType::eCopyBuffer, "CopyBuffer" );
         CreateInternalPipeline( DeviceProfilerPipelineType::eCopyBufferToImage, "CopyBufferToImage" );
@@ -539,12 +632,16 @@ namespace Profiler
         // Reset members and destroy resources.
         m_DeferredOperationCallbacks.clear();
 
+        m_PipelineCompilations.clear();
+        m_CpuTimeline.Destroy();
+
         m_pCommandBuffers.clear();
         m_pCommandPools.clear();
 
         m_MemoryTracker.Destroy();
 
         m_Synchronization.Destroy();
+        m_IndirectArgumentCompactor.Destroy();
         m_MemoryManager.Destroy();
 
         m_DataAggregator.Destroy();
@@ -561,6 +658,8 @@ namespace Profiler
         }
 
         m_FrameIndex = 0;
+        m_DrawcallCount = 0;
+        m_DrawcallSamplingRate = 1;
         m_pDevice = nullptr;
     }
 
@@ -661,13 +760,27 @@ namespace Profiler
 
         if( !m_pData.empty() )
         {
-            pData = m_pData.front();
-            m_pData.pop_front();
+            pData = PopFrameData();
         }
 
         return pData;
     }
 
+    /***********************************************************************************\
+
+    Function:
+        GetOverheadData
+
+    Description:
+        Returns resources used by the profiler, collected with the most recent frame.
+
+    \***********************************************************************************/
+    DeviceProfilerOverheadData DeviceProfiler::GetOverheadData()
+    {
+        std::scoped_lock lk( m_DataMutex );
+        return m_OverheadData;
+    }
+
     /***********************************************************************************\
     \***********************************************************************************/
     ProfilerCommandBuffer& DeviceProfiler::GetCommandBuffer( VkCommandBuffer commandBuffer )
@@ -703,6 +816,15 @@ namespace Profiler
         return m_Shaders.at( handle );
     }
 
+    /***********************************************************************************\
+    \***********************************************************************************/
+    VkQueryType DeviceProfiler::GetQueryPoolType( VkQueryPool queryPool ) const
+    {
+        VkQueryType queryType = VK_QUERY_TYPE_MAX_ENUM;
+        m_QueryPoolTypes.find( queryPool, &queryType );
+        return queryType;
+    }
+
     /***********************************************************************************\
     \***********************************************************************************/
     VkObject DeviceProfiler::GetObjectHandle( VkObject object ) const
@@ -745,6 +867,39 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Function:
+        ShouldCapturePipelineCreationFeedback
+
+    Description:
+        Checks whether pipeline creation feedback can be requested from the driver.
+        The feature is available if VK_EXT_pipeline_creation_feedback extension
+        is enabled or the device supports Vulkan 1.3.
+
+    \***********************************************************************************/
+    bool DeviceProfiler::ShouldCapturePipelineCreationFeedback() const
+    {
+        return m_PipelineCreationFeedbackEnabled;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        ShouldCaptureIndirectArguments
+
+    Description:
+        Checks whether the indirect argument buffers should be captured in the
+        command buffers that begin recording now. The capture may be disabled at
+        runtime if the device memory budget of the profiler is exceeded.
+
+    \***********************************************************************************/
+    bool DeviceProfiler::ShouldCaptureIndirectArguments() const
+    {
+        return m_Config.m_CaptureIndirectArguments &&
+            !( m_OverheadDegradations.load() & VK_PROFILER_OVERHEAD_DEGRADATION_INDIRECT_ARGUMENTS_DISABLED_BIT_EXT );
+    }
+
+    /***********************************************************************************\
+
     Function:
         CreateCommandPool
 
@@ -910,10 +1065,13 @@ namespace Profiler
         Register graphics pipelines.
 
     \***********************************************************************************/
-    void DeviceProfiler::CreatePipelines( uint32_t pipelineCount, const VkGraphicsPipelineCreateInfo* pCreateInfos, VkPipeline* pPipelines )
+    void DeviceProfiler::CreatePipelines( uint32_t pipelineCount, const VkGraphicsPipelineCreateInfo* pCreateInfos, VkPipeline* pPipelines, const DeviceProfilerPipelineCompilationData& compilation )
     {
         TipGuard tip( m_pDevice->TIP, __func__ );
 
+        DeviceProfilerPipelineCompilationData compilationData = compilation;
+        compilationData.m_Pipelines.reserve( pipelineCount );
+
         for( uint32_t i = 0; i < pipelineCount; ++i )
         {
             DeviceProfilerPipeline profilerPipeline;
@@ -927,8 +1085,13 @@ namespace Profiler
 
             profilerPipeline.m_pCreateInfo = DeviceProfilerPipeline::CopyPipelineCreateInfo( &createInfo );
 
+            GetPipelineCreationFeedback( compilationData.m_Pipelines.emplace_back(), createInfo.pNext, createInfo.stageCount, createInfo.pStages );
+            compilationData.m_Pipelines.back().m_Pipeline = profilerPipeline;
+
             m_Pipelines.insert( pPipelines[i], profilerPipeline );
         }
+
+        AppendPipelineCompilation( std::move( compilationData ) );
     }
 
     /***********************************************************************************\
@@ -940,10 +1103,13 @@ namespace Profiler
         Register compute pipelines.
 
     \***********************************************************************************/
-    void DeviceProfiler::CreatePipelines( uint32_t pipelineCount, const VkComputePipelineCreateInfo* pCreateInfos, VkPipeline* pPipelines )
+    void DeviceProfiler::CreatePipelines( uint32_t pipelineCount, const VkComputePipelineCreateInfo* pCreateInfos, VkPipeline* pPipelines, const DeviceProfilerPipelineCompilationData& compilation )
     {
         TipGuard tip( m_pDevice->TIP, __func__ );
 
+        DeviceProfilerPipelineCompilationData compilationData = compilation;
+        compilationData.m_Pipelines.reserve( pipelineCount );
+
         for( uint32_t i = 0; i < pipelineCount; ++i )
         {
             DeviceProfilerPipeline profilerPipeline;
@@ -953,8 +1119,13 @@ namespace Profiler
             
             SetPipelineShaderProperties( profilerPipeline, 1, &pCreateInfos[i].stage );
 
+            GetPipelineCreationFeedback( compilationData.m_Pipelines.emplace_back(), pCreateInfos[i].pNext, 1, &pCreateInfos[i].stage );
+            compilationData.m_Pipelines.back().m_Pipeline = profilerPipeline;
+
             m_Pipelines.insert( pPipelines[ i ], profilerPipeline );
         }
+
+        AppendPipelineCompilation( std::move( compilationData ) );
     }
 
     /***********************************************************************************\
@@ -966,10 +1137,13 @@ namespace Profiler
         Register ray-tracing pipelines.
 
     \***********************************************************************************/
-    void DeviceProfiler::CreatePipelines( uint32_t pipelineCount, const VkRayTracingPipelineCreateInfoKHR* pCreateInfos, VkPipeline* pPipelines, bool deferred )
+    void DeviceProfiler::CreatePipelines( uint32_t pipelineCount, const VkRayTracingPipelineCreateInfoKHR* pCreateInfos, VkPipeline* pPipelines, const DeviceProfilerPipelineCompilationData& compilation, bool deferred )
     {
         TipGuard tip( m_pDevice->TIP, __func__ );
 
+        DeviceProfilerPipelineCompilationData compilationData = compilation;
+        compilationData.m_Pipelines.reserve( pipelineCount );
+
         for( uint32_t i = 0; i < pipelineCount; ++i )
         {
             DeviceProfilerPipeline profilerPipeline;
@@ -1078,8 +1252,13 @@ namespace Profiler
                 ( maxRayRecursionDepth - 1 ) * closestHitAndMissStackMax +
                 2 * callableStackMax;
 
+            GetPipelineCreationFeedback( compilationData.m_Pipelines.emplace_back(), createInfo.pNext, createInfo.stageCount, createInfo.pStages );
+            compilationData.m_Pipelines.back().m_Pipeline = profilerPipeline;
+
             m_Pipelines.insert( pPipelines[ i ], profilerPipeline );
         }
+
+        AppendPipelineCompilation( std::move( compilationData ) );
     }
 
     /***********************************************************************************\
@@ -1230,6 +1409,16 @@ namespace Profiler
         DeviceProfilerRenderPass deviceProfilerRenderPass;
         deviceProfilerRenderPass.m_Handle = RegisterObjectHandle<VkRenderPassHandle>( renderPass );
         deviceProfilerRenderPass.m_Type = DeviceProfilerRenderPassType::eGraphics;
+
+        // Get view masks of the subpasses if multiview is used
+        const VkRenderPassMultiviewCreateInfo* pMultiviewCreateInfo = nullptr;
+        for( const auto& it : PNextIterator( pCreateInfo->pNext ) )
+        {
+            if( it.sType == VK_STRUCTURE_TYPE_RENDER_PASS_MULTIVIEW_CREATE_INFO )
+            {
+                pMultiviewCreateInfo = reinterpret_cast<const VkRenderPassMultiviewCreateInfo*>( &it );
+            }
+        }
         
         for( uint32_t subpassIndex = 0; subpassIndex < pCreateInfo->subpassCount; ++subpassIndex )
         {
@@ -1237,6 +1426,11 @@ namespace Profiler
 
             DeviceProfilerSubpass deviceProfilerSubpass;
             deviceProfilerSubpass.m_Index = subpassIndex;
+
+            if( pMultiviewCreateInfo && ( subpassIndex < pMultiviewCreateInfo->subpassCount ) )
+            {
+                deviceProfilerSubpass.m_ViewMask = pMultiviewCreateInfo->pViewMasks[ subpassIndex ];
+            }
             
             // Check if this subpass resolves any attachments at the end
             CountSubpassAttachmentResolves( deviceProfilerSubpass, subpass );
@@ -1273,6 +1467,7 @@ namespace Profiler
 
             DeviceProfilerSubpass deviceProfilerSubpass;
             deviceProfilerSubpass.m_Index = subpassIndex;
+            deviceProfilerSubpass.m_ViewMask = subpass.viewMask;
 
             // Check if this subpass resolves any attachments at the end
             CountSubpassAttachmentResolves( deviceProfilerSubpass, subpass );
@@ -1335,14 +1530,50 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Function:
+        CreateQueryPool
+
+    Description:
+        Registers the application's query pool.
+
+    \***********************************************************************************/
+    void DeviceProfiler::CreateQueryPool( VkQueryPool queryPool, const VkQueryPoolCreateInfo* pCreateInfo )
+    {
+        TipGuard tip( m_pDevice->TIP, __func__ );
+
+        m_QueryPoolTypes.insert( queryPool, pCreateInfo->queryType );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        DestroyQueryPool
+
+    Description:
+        Unregisters the application's query pool.
+
+    \***********************************************************************************/
+    void DeviceProfiler::DestroyQueryPool( VkQueryPool queryPool )
+    {
+        TipGuard tip( m_pDevice->TIP, __func__ );
+
+        m_QueryPoolTypes.remove( queryPool );
+    }
+
+    /***********************************************************************************\
+
     Function:
         PreSubmitCommandBuffers
 
     Description:
+        Prepares the queue for the submission. Returns CPU timestamp of the beginning
+        of the submission, which should be passed to PostSubmitCommandBuffers.
 
     \***********************************************************************************/
-    void DeviceProfiler::PreSubmitCommandBuffers( VkQueue queue )
+    uint64_t DeviceProfiler::PreSubmitCommandBuffers( VkQueue queue )
     {
+        DeviceProfilerOverheadScope overhead( m_Overhead, DeviceProfilerCpuOverheadCategory::eQueueSubmission );
+
         // Synchronize access to the queue if requested.
         if( m_Config.m_SynchronizeQueues )
         {
@@ -1354,6 +1585,8 @@ namespace Profiler
         {
             m_pPerformanceCounters->SetQueuePerformanceConfiguration( queue );
         }
+
+        return m_CpuTimestampCounter.GetCurrentValue();
     }
 
     /***********************************************************************************\
@@ -1364,9 +1597,9 @@ namespace Profiler
     Description:
 
     \***********************************************************************************/
-    void DeviceProfiler::PostSubmitCommandBuffers( VkQueue queue, uint32_t count, const VkSubmitInfo* pSubmitInfo )
+    void DeviceProfiler::PostSubmitCommandBuffers( VkQueue queue, uint32_t count, const VkSubmitInfo* pSubmitInfo, uint64_t submitTimestamp )
     {
-        PostSubmitCommandBuffersImpl<VkSubmitInfo>( queue, count, pSubmitInfo );
+        PostSubmitCommandBuffersImpl<VkSubmitInfo>( queue, count, pSubmitInfo, submitTimestamp );
     }
 
     /***********************************************************************************\
@@ -1377,9 +1610,9 @@ namespace Profiler
     Description:
 
     \***********************************************************************************/
-    void DeviceProfiler::PostSubmitCommandBuffers( VkQueue queue, uint32_t count, const VkSubmitInfo2* pSubmitInfo )
+    void DeviceProfiler::PostSubmitCommandBuffers( VkQueue queue, uint32_t count, const VkSubmitInfo2* pSubmitInfo, uint64_t submitTimestamp )
     {
-        PostSubmitCommandBuffersImpl<VkSubmitInfo2>( queue, count, pSubmitInfo );
+        PostSubmitCommandBuffersImpl<VkSubmitInfo2>( queue, count, pSubmitInfo, submitTimestamp );
     }
 
     /***********************************************************************************\
@@ -1391,21 +1624,31 @@ namespace Profiler
 
     \***********************************************************************************/
     template<typename SubmitInfoT>
-    void DeviceProfiler::PostSubmitCommandBuffersImpl( VkQueue queue, uint32_t submitCount, const SubmitInfoT* pSubmits )
+    void DeviceProfiler::PostSubmitCommandBuffersImpl( VkQueue queue, uint32_t submitCount, const SubmitInfoT* pSubmits, uint64_t submitTimestamp )
     {
         using T = SubmitInfoTraits<SubmitInfoT>;
 
         TipRangeId tip = m_pDevice->TIP.BeginFunction( __func__ );
 
+        DeviceProfilerOverheadScope overhead( m_Overhead, DeviceProfilerCpuOverheadCategory::eQueueSubmission );
+
+        const uint64_t timestamp = m_CpuTimestampCounter.GetCurrentValue();
+        const uint32_t threadId = ProfilerPlatformFunctions::GetCurrentThreadId();
+
+        // Save time spent in the driver's submit function.
+        DeviceProfilerCpuSpanData submitSpan;
+        submitSpan.m_Type = DeviceProfilerCpuSpanType::eQueueSubmit;
+        submitSpan.m_BeginTimestamp = submitTimestamp;
+        submitSpan.m_EndTimestamp = timestamp;
+        submitSpan.m_Queue = ResolveObjectHandle<VkQueueHandle>( queue );
+        m_CpuTimeline.AppendSpan( submitSpan );
+
         // Applications can issue submissions belonging to different frames in a single call.
         // Split those submissions into separate batches.
         std::unordered_map<uint32_t, DeviceProfilerSubmitBatch> submitBatches;
         // List of frames that ended during this submission.
         std::vector<uint32_t> frameBoundaryExtEndedFrames;
 
-        const uint64_t timestamp = m_CpuTimestampCounter.GetCurrentValue();
-        const uint32_t threadId = ProfilerPlatformFunctions::GetCurrentThreadId();
-
         // Synchronize read access to m_pCommandBuffers
         std::shared_lock lk( m_pCommandBuffers );
 
@@ -1438,7 +1681,7 @@ namespace Profiler
             if( it == submitBatches.end() )
             {
                 it = submitBatches.emplace( submitFrameIndex, DeviceProfilerSubmitBatch{} ).first;
-                it->second.m_Handle = ResolveObjectHandle<VkQueueHandle>( queue );
+                it->second.m_Handle = submitSpan.m_Queue;
                 it->second.m_Timestamp = timestamp;
                 it->second.m_ThreadId = threadId;
             }
@@ -1457,9 +1700,6 @@ namespace Profiler
                 VkCommandBuffer commandBuffer = T::CommandBuffer( submitInfo, commandBufferIdx );
                 ProfilerCommandBuffer* pProfilerCommandBuffer = m_pCommandBuffers.unsafe_at( commandBuffer ).get();
 
-                // Dirty command buffer profiling data
-                pProfilerCommandBuffer->Submit();
-
                 submit.m_pCommandBuffers.push_back( pProfilerCommandBuffer );
             }
 
@@ -1504,6 +1744,8 @@ namespace Profiler
             m_pDevice->Callbacks.QueueWaitIdle( queue );
         }
 
+        overhead.End();
+
         // Get data captured during the last frame
         ResolveFrameData( tip );
 
@@ -1534,6 +1776,8 @@ namespace Profiler
         m_DataAggregator.EndFrame( m_FrameIndex );
         m_FrameIndex++;
 
+        UpdateDrawcallSamplingRate();
+
         // Get data captured during the last frame
         ResolveFrameData( tip );
     }
@@ -1573,12 +1817,61 @@ namespace Profiler
             }
         }
 
+        UpdateDrawcallSamplingRate();
+
         // Get data captured during the last frame
         ResolveFrameData( tip );
     }
 
     /***********************************************************************************\
 
+    Function:
+        PostPresent
+
+    Description:
+        Saves time spent in the driver's present function.
+
+    \***********************************************************************************/
+    void DeviceProfiler::PostPresent( VkQueue queue, uint64_t presentTimestamp )
+    {
+        TipGuard tip( m_pDevice->TIP, __func__ );
+
+        DeviceProfilerCpuSpanData presentSpan;
+        presentSpan.m_Type = DeviceProfilerCpuSpanType::eQueuePresent;
+        presentSpan.m_BeginTimestamp = presentTimestamp;
+        presentSpan.m_EndTimestamp = m_CpuTimestampCounter.GetCurrentValue();
+        presentSpan.m_Queue = ResolveObjectHandle<VkQueueHandle>( queue );
+        m_CpuTimeline.AppendSpan( presentSpan );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        UpdateDrawcallSamplingRate
+
+    Description:
+        Increases the drawcall sampling rate when more commands were recorded in the
+        last frame than allowed by the per-frame timestamp budget. The configured
+        rate is restored when the number of commands drops below the budget.
+
+    \***********************************************************************************/
+    void DeviceProfiler::UpdateDrawcallSamplingRate()
+    {
+        const uint32_t drawcallCount = m_DrawcallCount.exchange( 0, std::memory_order_relaxed );
+
+        uint32_t samplingRate = static_cast<uint32_t>( std::max( m_Config.m_DrawcallSamplingRate, 1 ) );
+
+        if( m_Config.m_DrawcallTimestampBudget > 0 )
+        {
+            const uint32_t budget = static_cast<uint32_t>( m_Config.m_DrawcallTimestampBudget );
+            samplingRate = std::max( samplingRate, ( drawcallCount + budget - 1 ) / budget );
+        }
+
+        m_DrawcallSamplingRate.store( samplingRate, std::memory_order_relaxed );
+    }
+
+    /***********************************************************************************\
+
     Function:
         ResolveFrameData
 
@@ -1587,6 +1880,8 @@ namespace Profiler
     \***********************************************************************************/
     void DeviceProfiler::ResolveFrameData( TipRangeId& tip )
     {
+        DeviceProfilerOverheadScope overhead( m_Overhead, DeviceProfilerCpuOverheadCategory::eDataResolve );
+
         if( !m_DataAggregator.IsDataCollectionThreadRunning() )
         {
             // Collect data from the submitted command buffers
@@ -1599,6 +1894,18 @@ namespace Profiler
         auto pResolvedData = m_DataAggregator.GetAggregatedData();
         if( !pResolvedData.empty() )
         {
+            // Assign pipeline compilations and CPU spans to the frames in which they have completed.
+            for( const std::shared_ptr<DeviceProfilerFrameData>& pFrameData : pResolvedData )
+            {
+                CollectPipelineCompilations( *pFrameData );
+                m_CpuTimeline.CollectSpans( pFrameData->m_CPU.m_EndTimestamp, pFrameData->m_CPU.m_Spans );
+
+                m_Overhead.AddHostMemory( DeviceProfilerHostMemoryOverheadCategory::eFrameData,
+                    DeviceProfilerOverheadCounter::GetFrameDataSize( *pFrameData ) );
+                m_Overhead.AddHostMemory( DeviceProfilerHostMemoryOverheadCategory::eMemorySnapshots,
+                    DeviceProfilerOverheadCounter::GetMemoryDataSize( pFrameData->m_Memory ) );
+            }
+
             std::scoped_lock lk( m_DataMutex );
 
             m_pData.insert( m_pData.end(), pResolvedData.begin(), pResolvedData.end() );
@@ -1606,19 +1913,131 @@ namespace Profiler
             // Return TIP data
             m_pData.back()->m_TIP = m_pDevice->TIP.GetData();
 
+            // Return resources used by the profiler.
+            // CPU time and copied data are measured since the previous collection, so they are reported only with the last frame.
+            m_Overhead.CollectData( m_OverheadData );
+            ApplyOverheadBudgets( m_OverheadData );
+            m_OverheadData.m_Degradations = m_OverheadDegradations.load();
+
+            for( const std::shared_ptr<DeviceProfilerFrameData>& pFrameData : pResolvedData )
+            {
+                pFrameData->m_Overhead = m_OverheadData;
+                pFrameData->m_Overhead.m_CpuTime.fill( 0 );
+                pFrameData->m_Overhead.m_CpuMeasurementTime = 0;
+                pFrameData->m_Overhead.m_CopiedDataSize = 0;
+            }
+
+            m_pData.back()->m_Overhead = m_OverheadData;
+
             // Free frames above the buffer size
             if( m_DataBufferSize )
             {
                 while( m_pData.size() > m_DataBufferSize )
                 {
-                    m_pData.pop_front();
+                    // Move hitches detected in the freed frame to the next one to keep the notifications.
+                    std::vector<DeviceProfilerHitchData> hitches = std::move( m_pData.front()->m_Hitches );
+                    PopFrameData();
+
+                    std::vector<DeviceProfilerHitchData>& nextHitches = m_pData.front()->m_Hitches;
+                    nextHitches.insert(
+                        nextHitches.begin(),
+                        std::make_move_iterator( hitches.begin() ),
+                        std::make_move_iterator( hitches.end() ) );
+                }
+            }
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        ApplyOverheadBudgets
+
+    Description:
+        Reduces the amount of collected data if the resources used by the profiler
+        exceed the configured budgets. Each call applies at most one degradation
+        step per budget, the degradations are not reverted.
+
+        Must be called with m_DataMutex locked.
+
+    \***********************************************************************************/
+    void DeviceProfiler::ApplyOverheadBudgets( const DeviceProfilerOverheadData& overhead )
+    {
+        // Host memory budget - keep less frames in the buffer.
+        const uint64_t hostMemoryBudget = static_cast<uint64_t>( std::max( m_Config.m_OverheadHostMemoryBudget, 0 ) ) * 1024 * 1024;
+        if( ( hostMemoryBudget > 0 ) &&
+            ( overhead.GetTotalHostMemory() > hostMemoryBudget ) )
+        {
+            const uint32_t frameCount = ( m_DataBufferSize != 0 )
+                ? m_DataBufferSize
+                : static_cast<uint32_t>( m_pData.size() );
+
+            const uint32_t dataBufferSize = std::max( frameCount / 2, std::max( m_MinDataBufferSize, 1U ) );
+            if( ( m_DataBufferSize == 0 ) || ( dataBufferSize < m_DataBufferSize ) )
+            {
+                m_DataAggregator.SetDataBufferSize( dataBufferSize );
+                m_DataBufferSize = dataBufferSize;
+                m_OverheadDegradations |= VK_PROFILER_OVERHEAD_DEGRADATION_DATA_BUFFER_SIZE_REDUCED_BIT_EXT;
+            }
+        }
+
+        // Device memory budget - stop capturing the indirect arguments.
+        const uint64_t gpuMemoryBudget = static_cast<uint64_t>( std::max( m_Config.m_OverheadGpuMemoryBudget, 0 ) ) * 1024 * 1024;
+        if( ( gpuMemoryBudget > 0 ) &&
+            ( overhead.GetTotalGpuMemory() > gpuMemoryBudget ) &&
+            ( ShouldCaptureIndirectArguments() ) )
+        {
+            m_OverheadDegradations |= VK_PROFILER_OVERHEAD_DEGRADATION_INDIRECT_ARGUMENTS_DISABLED_BIT_EXT;
+        }
+
+        // CPU time budget - use coarser sampling mode.
+        // The time is accumulated over a longer period to avoid reacting to single slow frames.
+        const uint64_t cpuTimeBudget = static_cast<uint64_t>( std::max( m_Config.m_OverheadCpuTimeBudget, 0 ) );
+        if( cpuTimeBudget > 0 )
+        {
+            m_OverheadBudgetCpuTime += overhead.GetTotalCpuTime();
+            m_OverheadBudgetMeasurementTime += overhead.m_CpuMeasurementTime;
+
+            if( m_OverheadBudgetMeasurementTime >= 1'000'000'000 )
+            {
+                if( ( m_OverheadBudgetCpuTime * 100 > m_OverheadBudgetMeasurementTime * cpuTimeBudget ) &&
+                    ( m_Config.m_SamplingMode < VK_PROFILER_MODE_PER_FRAME_EXT ) )
+                {
+                    SetSamplingMode( static_cast<VkProfilerModeEXT>( m_Config.m_SamplingMode.value + 1 ) );
+                    m_OverheadDegradations |= VK_PROFILER_OVERHEAD_DEGRADATION_SAMPLING_MODE_COARSENED_BIT_EXT;
                 }
+
+                m_OverheadBudgetCpuTime = 0;
+                m_OverheadBudgetMeasurementTime = 0;
             }
         }
     }
 
     /***********************************************************************************\
 
+    Function:
+        PopFrameData
+
+    Description:
+        Removes the oldest frame from the buffer.
+        Must be called with m_DataMutex locked.
+
+    \***********************************************************************************/
+    std::shared_ptr<DeviceProfilerFrameData> DeviceProfiler::PopFrameData()
+    {
+        std::shared_ptr<DeviceProfilerFrameData> pData = std::move( m_pData.front() );
+        m_pData.pop_front();
+
+        m_Overhead.AddHostMemory( DeviceProfilerHostMemoryOverheadCategory::eFrameData,
+            -static_cast<int64_t>( DeviceProfilerOverheadCounter::GetFrameDataSize( *pData ) ) );
+        m_Overhead.AddHostMemory( DeviceProfilerHostMemoryOverheadCategory::eMemorySnapshots,
+            -static_cast<int64_t>( DeviceProfilerOverheadCounter::GetMemoryDataSize( pData->m_Memory ) ) );
+
+        return pData;
+    }
+
+    /***********************************************************************************\
+
     Function:
         AllocateMemory
 
@@ -2280,6 +2699,63 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Function:
+        AppendPipelineCompilation
+
+    Description:
+        Save the pipeline compilation until it is assigned to a frame.
+
+    \***********************************************************************************/
+    void DeviceProfiler::AppendPipelineCompilation( DeviceProfilerPipelineCompilationData&& compilation )
+    {
+        // Limit the number of pending compilations in case no frames are presented.
+        static constexpr size_t g_scMaxPendingPipelineCompilations = 16384;
+
+        std::scoped_lock lk( m_PipelineCompilationsMutex );
+
+        if( m_PipelineCompilations.size() >= g_scMaxPendingPipelineCompilations )
+        {
+            m_PipelineCompilations.pop_front();
+        }
+
+        m_PipelineCompilations.push_back( std::move( compilation ) );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        CollectPipelineCompilations
+
+    Description:
+        Move the pipeline compilations that completed before the end of the frame
+        to the frame data.
+
+    \***********************************************************************************/
+    void DeviceProfiler::CollectPipelineCompilations( DeviceProfilerFrameData& frameData )
+    {
+        std::scoped_lock lk( m_PipelineCompilationsMutex );
+
+        frameData.m_PipelineCompilationTicks = 0;
+
+        // Compilations on different threads may complete out of order, so the whole list must be checked.
+        auto it = m_PipelineCompilations.begin();
+        while( it != m_PipelineCompilations.end() )
+        {
+            if( it->m_EndTimestamp <= frameData.m_CPU.m_EndTimestamp )
+            {
+                frameData.m_PipelineCompilationTicks += ( it->m_EndTimestamp - it->m_BeginTimestamp );
+                frameData.m_PipelineCompilations.push_back( std::move( *it ) );
+                it = m_PipelineCompilations.erase( it );
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    /***********************************************************************************\
+
     Function:
         GetObjectName
 
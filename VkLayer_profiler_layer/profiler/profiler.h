@@ -20,12 +20,15 @@
 
 #pragma once
 #include "profiler_counters.h"
+#include "profiler_cpu_timeline.h"
 #include "profiler_command_pool.h"
 #include "profiler_config.h"
 #include "profiler_data_aggregator.h"
 #include "profiler_helpers.h"
+#include "profiler_indirect_arguments.h"
 #include "profiler_memory_manager.h"
 #include "profiler_memory_tracker.h"
+#include "profiler_overhead.h"
 #include "profiler_data.h"
 #include "profiler_sync.h"
 #include "profiler_performance_counters.h"
@@ -64,7 +67,7 @@ namespace Profiler
     public:
         DeviceProfiler();
 
-        static void SetupDeviceCreateInfo( VkPhysicalDevice_Object&, const ProfilerLayerSettings&, std::unordered_set<std::string>&, PNextChain& );
+        static void SetupDeviceCreateInfo( VkPhysicalDevice_Object&, const ProfilerLayerSettings&, std::unordered_set<std::string>&, PNextChain&, VkPhysicalDeviceFeatures& );
         static void SetupInstanceCreateInfo( const VkInstanceCreateInfo&, PFN_vkGetInstanceProcAddr, std::unordered_set<std::string>& );
 
         static void LoadConfiguration( const ProfilerLayerSettings&, const VkProfilerCreateInfoEXT*, DeviceProfilerConfig* );
@@ -79,12 +82,14 @@ namespace Profiler
         VkResult SetDataBufferSize( uint32_t );
         VkResult SetMinDataBufferSize( uint32_t );
         std::shared_ptr<DeviceProfilerFrameData> GetData();
+        DeviceProfilerOverheadData GetOverheadData();
 
         ProfilerCommandBuffer& GetCommandBuffer( VkCommandBuffer commandBuffer );
         DeviceProfilerCommandPool& GetCommandPool( VkCommandPool commandPool );
         DeviceProfilerPipeline& GetPipeline( VkPipeline pipeline );
         DeviceProfilerRenderPass& GetRenderPass( VkRenderPass renderPass );
         ProfilerShader& GetShader( VkShaderEXT shader );
+        VkQueryType GetQueryPoolType( VkQueryPool queryPool ) const;
 
         VkObject GetObjectHandle( VkObject ) const;
         uint32_t GetObjectCreateTime( VkObject ) const;
@@ -96,6 +101,8 @@ namespace Profiler
         VkObjectHandleT ResolveObjectHandle( const VkObjectHandleT& ) const;
 
         bool ShouldCapturePipelineExecutableProperties() const;
+        bool ShouldCapturePipelineCreationFeedback() const;
+        bool ShouldCaptureIndirectArguments() const;
 
         void CreateCommandPool( VkCommandPool, const VkCommandPoolCreateInfo* );
         void DestroyCommandPool( VkCommandPool );
@@ -108,9 +115,9 @@ namespace Profiler
         void SetDeferredOperationCallback( VkDeferredOperationKHR, DeferredOperationCallback );
         void ExecuteDeferredOperationCallback( VkDeferredOperationKHR );
 
-        void CreatePipelines( uint32_t, const VkGraphicsPipelineCreateInfo*, VkPipeline* );
-        void CreatePipelines( uint32_t, const VkComputePipelineCreateInfo*, VkPipeline* );
-        void CreatePipelines( uint32_t, const VkRayTracingPipelineCreateInfoKHR*, VkPipeline*, bool deferred );
+        void CreatePipelines( uint32_t, const VkGraphicsPipelineCreateInfo*, VkPipeline*, const DeviceProfilerPipelineCompilationData& );
+        void CreatePipelines( uint32_t, const VkComputePipelineCreateInfo*, VkPipeline*, const DeviceProfilerPipelineCompilationData& );
+        void CreatePipelines( uint32_t, const VkRayTracingPipelineCreateInfoKHR*, VkPipeline*, const DeviceProfilerPipelineCompilationData&, bool deferred );
         void DestroyPipeline( VkPipeline );
 
         void CreateShaderModule( VkShaderModule, const VkShaderModuleCreateInfo* );
@@ -122,12 +129,16 @@ namespace Profiler
         void CreateRenderPass( VkRenderPass, const VkRenderPassCreateInfo2* );
         void DestroyRenderPass( VkRenderPass );
 
-        void PreSubmitCommandBuffers( VkQueue );
-        void PostSubmitCommandBuffers( VkQueue, uint32_t, const VkSubmitInfo* );
-        void PostSubmitCommandBuffers( VkQueue, uint32_t, const VkSubmitInfo2* );
+        void CreateQueryPool( VkQueryPool, const VkQueryPoolCreateInfo* );
+        void DestroyQueryPool( VkQueryPool );
+
+        uint64_t PreSubmitCommandBuffers( VkQueue );
+        void PostSubmitCommandBuffers( VkQueue, uint32_t, const VkSubmitInfo*, uint64_t );
+        void PostSubmitCommandBuffers( VkQueue, uint32_t, const VkSubmitInfo2*, uint64_t );
 
         void FinishFrame();
         void FinishFrame( const VkPresentInfoKHR* );
+        void PostPresent( VkQueue, uint64_t );
 
         void AllocateMemory( VkDeviceMemory, const VkMemoryAllocateInfo* );
         void FreeMemory( VkDeviceMemory );
@@ -169,6 +180,7 @@ namespace Profiler
         std::list<std::shared_ptr<DeviceProfilerFrameData>> m_pData;
 
         DeviceProfilerMemoryManager m_MemoryManager;
+        DeviceProfilerIndirectArgumentCompactor m_IndirectArgumentCompactor;
         ProfilerDataAggregator  m_DataAggregator;
 
         uint32_t                m_FrameIndex;
@@ -176,11 +188,25 @@ namespace Profiler
         uint32_t                m_MinDataBufferSize;
         uint64_t                m_LastFrameBeginTimestamp;
 
+        // Number of commands recorded in the current frame in the per-drawcall sampling mode.
+        // Used to adjust the drawcall sampling rate to the per-frame timestamp budget.
+        std::atomic<uint32_t>   m_DrawcallCount;
+        std::atomic<uint32_t>   m_DrawcallSamplingRate;
+
         CpuTimestampCounter     m_CpuTimestampCounter;
         CpuEventFrequencyCounter m_CpuFpsCounter;
+        DeviceProfilerCpuTimeline m_CpuTimeline;
 
         DeviceProfilerMemoryTracker m_MemoryTracker;
 
+        DeviceProfilerOverheadCounter m_Overhead;
+        DeviceProfilerOverheadData m_OverheadData;
+        std::atomic<VkProfilerOverheadDegradationFlagsEXT> m_OverheadDegradations;
+
+        // CPU overhead accumulated since the last check of the CPU time budget.
+        uint64_t                m_OverheadBudgetCpuTime;
+        uint64_t                m_OverheadBudgetMeasurementTime;
+
         ConcurrentMap<VkCommandBuffer, std::unique_ptr<ProfilerCommandBuffer>> m_pCommandBuffers;
         ConcurrentMap<VkCommandPool, std::unique_ptr<DeviceProfilerCommandPool>> m_pCommandPools;
 
@@ -195,6 +221,13 @@ namespace Profiler
 
         ConcurrentMap<VkRenderPass, DeviceProfilerRenderPass> m_RenderPasses;
 
+        // Types of the application's query pools, used to avoid overlapping with the profiler's queries.
+        ConcurrentMap<VkQueryPool, VkQueryType> m_QueryPoolTypes;
+
+        // Pipeline compilations not assigned to any frame yet.
+        std::mutex              m_PipelineCompilationsMutex;
+        std::deque<DeviceProfilerPipelineCompilationData> m_PipelineCompilations;
+
         std::unique_ptr<DeviceProfilerPerformanceCounters> m_pPerformanceCounters;
 
         DeviceProfilerSynchronization m_Synchronization;
@@ -209,6 +242,9 @@ namespace Profiler
         // Whether VK_EXT_shader_module_identifier is available for the profiled device.
         bool                    m_ShaderModuleIdentifierEnabled;
 
+        // Whether VK_EXT_pipeline_creation_feedback or Vulkan 1.3 is available for the profiled device.
+        bool                    m_PipelineCreationFeedbackEnabled;
+
         void*                   m_pStablePowerStateHandle;
 
 
@@ -216,13 +252,19 @@ namespace Profiler
 
         void SetPipelineShaderProperties( DeviceProfilerPipeline& pipeline, uint32_t stageCount, const VkPipelineShaderStageCreateInfo* pStages );
 
+        void AppendPipelineCompilation( DeviceProfilerPipelineCompilationData&& );
+        void CollectPipelineCompilations( DeviceProfilerFrameData& );
+
         decltype(m_pCommandBuffers)::iterator FreeCommandBuffer( VkCommandBuffer );
         decltype(m_pCommandBuffers)::iterator FreeCommandBuffer( decltype(m_pCommandBuffers)::iterator );
 
         template<typename SubmitInfoT>
-        void PostSubmitCommandBuffersImpl( VkQueue, uint32_t, const SubmitInfoT* );
+        void PostSubmitCommandBuffersImpl( VkQueue, uint32_t, const SubmitInfoT*, uint64_t );
 
         void ResolveFrameData( TipRangeId& tip );
+        void UpdateDrawcallSamplingRate();
+        void ApplyOverheadBudgets( const DeviceProfilerOverheadData& );
+        std::shared_ptr<DeviceProfilerFrameData> PopFrameData();
 
         template<typename VkObjectHandleT>
         VkObjectHandleT RegisterObjectHandle( VkObjectHandleT );
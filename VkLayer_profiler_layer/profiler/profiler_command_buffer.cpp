@@ -24,7 +24,10 @@
 #include "profiler_stat_comparators.h"
 #include "profiler_query_pool.h"
 #include <algorithm>
+#include <atomic>
+#include <unordered_map>
 #include <assert.h>
+#include <string.h>
 
 #define PROFILER_INDIRECT_ARGS_BUFFER_SIZE 65536
 
@@ -45,22 +48,33 @@ namespace Profiler
         , m_CommandBuffer( commandBuffer )
         , m_Level( level )
         , m_ProfilingEnabled( true )
+        , m_PipelineStatisticsSuspended( false )
+        , m_RecordingBeginTimestamp( 0 )
         , m_pSecondaryCommandBuffers()
         , m_pQueryPool( nullptr )
         , m_Stats()
-        , m_Data()
+        , m_pData( std::make_shared<DeviceProfilerCommandBufferData>() )
         , m_pCurrentRenderPass( nullptr )
         , m_pCurrentRenderPassData( nullptr )
         , m_pCurrentSubpassData( nullptr )
         , m_pCurrentPipelineData( nullptr )
         , m_pCurrentDrawcallData( nullptr )
+        , m_DrawcallTimestampIndices()
         , m_CurrentSubpassIndex( DeviceProfilerSubpassData::ImplicitSubpassIndex )
+        , m_CurrentViewMask( 0 )
+        , m_DrawcallSamplingOffset( 0 )
+        , m_DrawcallSamplingIndex( 0 )
         , m_GraphicsPipeline()
         , m_ComputePipeline()
         , m_IndirectArgumentBufferList()
+        , m_IndirectArgumentRegions()
+        , m_IndirectArgumentDrawcalls()
+        , m_PendingIndirectArgumentRegions()
+        , m_CompactIndirectArguments( false )
+        , m_CaptureIndirectArguments( false )
     {
-        m_Data.m_Handle = m_Profiler.ResolveObjectHandle<VkCommandBufferHandle>( commandBuffer );
-        m_Data.m_Level = level;
+        m_pData->m_Handle = m_Profiler.ResolveObjectHandle<VkCommandBufferHandle>( commandBuffer );
+        m_pData->m_Level = level;
 
         // Profile the command buffer only if it will be submitted to the queue supporting graphics or compute commands
         // This is requirement of vkCmdResetQueryPool (VUID-vkCmdResetQueryPool-commandBuffer-cmdpool)
@@ -90,6 +104,11 @@ namespace Profiler
     \***********************************************************************************/
     ProfilerCommandBuffer::~ProfilerCommandBuffer()
     {
+        for( IndirectArgumentBuffer& buffer : m_IndirectArgumentBufferList )
+        {
+            FreeIndirectArgumentBuffer( buffer );
+        }
+
         delete m_pQueryPool;
     }
 
@@ -123,32 +142,6 @@ namespace Profiler
 
     /***********************************************************************************\
 
-    Function:
-        Submit
-
-    Description:
-        Dirty cached profiling data.
-
-    \***********************************************************************************/
-    void ProfilerCommandBuffer::Submit()
-    {
-        TipGuard tip( m_Profiler.m_pDevice->TIP, __func__ );
-
-        if( m_ProfilingEnabled )
-        {
-            // Contents of the command buffer did not change, but all queries will be executed again
-            m_Data.m_DataValid = false;
-        }
-
-        // Secondary command buffers will be executed as well
-        for( ProfilerCommandBuffer* pSecondaryCommandBuffer : m_pSecondaryCommandBuffers )
-        {
-            pSecondaryCommandBuffer->Submit();
-        }
-    }
-
-    /***********************************************************************************\
-
     Function:
         Begin
 
@@ -159,23 +152,81 @@ namespace Profiler
     void ProfilerCommandBuffer::Begin( const VkCommandBufferBeginInfo* pBeginInfo )
     {
         TipGuard tip( m_Profiler.m_pDevice->TIP, __func__ );
+        DeviceProfilerOverheadScope overhead( m_Profiler.m_Overhead, DeviceProfilerCpuOverheadCategory::eCommandRecording );
 
         if( m_ProfilingEnabled )
         {
+            m_RecordingBeginTimestamp = m_Profiler.m_CpuTimestampCounter.GetCurrentValue();
+
             // Restore initial state
             Reset( 0 /*flags*/ );
 
+            // Capture of the indirect arguments may be disabled at runtime when the profiler exceeds its memory budget.
+            m_CaptureIndirectArguments = m_Profiler.ShouldCaptureIndirectArguments();
+
+            if( !m_CaptureIndirectArguments )
+            {
+                for( IndirectArgumentBuffer& buffer : m_IndirectArgumentBufferList )
+                {
+                    FreeIndirectArgumentBuffer( buffer );
+                }
+
+                m_IndirectArgumentBufferList.clear();
+            }
+
             // Reset query pools.
             m_pQueryPool->Reset( m_CommandBuffer );
 
             // Make sure there is at least one query pool available.
             m_pQueryPool->PreallocateQueries( m_CommandBuffer );
 
+            // Secondary command buffers that inherit the application's pipeline statistics query
+            // must not begin queries of the same type (VUID-vkCmdBeginQuery-queryPool-01922).
+            m_PipelineStatisticsSuspended =
+                ( pBeginInfo->pInheritanceInfo != nullptr ) &&
+                ( pBeginInfo->pInheritanceInfo->pipelineStatistics != 0 ) &&
+                ( m_Level == VK_COMMAND_BUFFER_LEVEL_SECONDARY );
+
+            // Indirect count arguments are compacted with a dispatch at the end of the command buffer,
+            // which is not possible if the command buffer ends inside a render pass.
+            m_CompactIndirectArguments =
+                ( m_Profiler.m_IndirectArgumentCompactor.IsAvailable() ) &&
+                ( m_CommandPool.SupportsComputeCommands() ) &&
+                ( ( pBeginInfo->flags & VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT ) == 0 );
+
+            // Rotate the subset of sampled drawcalls on each recording.
+            m_DrawcallSamplingIndex = m_DrawcallSamplingOffset++;
+
+            // Secondary command buffers continuing a multiview render pass must allocate pipeline statistics queries for each view.
+            if( (m_pQueryPool->GetPipelineStatisticsFlags() != 0) &&
+                (pBeginInfo->flags & VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT) &&
+                (pBeginInfo->pInheritanceInfo != nullptr) )
+            {
+                if( pBeginInfo->pInheritanceInfo->renderPass != VK_NULL_HANDLE )
+                {
+                    const DeviceProfilerRenderPass& renderPass = m_Profiler.GetRenderPass( pBeginInfo->pInheritanceInfo->renderPass );
+                    if( pBeginInfo->pInheritanceInfo->subpass < renderPass.m_Subpasses.size() )
+                    {
+                        m_CurrentViewMask = renderPass.m_Subpasses[ pBeginInfo->pInheritanceInfo->subpass ].m_ViewMask;
+                    }
+                }
+                else
+                {
+                    for( const auto& it : PNextIterator( pBeginInfo->pInheritanceInfo->pNext ) )
+                    {
+                        if( it.sType == VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO )
+                        {
+                            m_CurrentViewMask = reinterpret_cast<const VkCommandBufferInheritanceRenderingInfo&>( it ).viewMask;
+                        }
+                    }
+                }
+            }
+
             // Begin collection of vendor metrics.
             m_pQueryPool->BeginPerformanceQuery( m_CommandBuffer );
 
             // Send global timestamp query for the whole command buffer.
-            m_Data.m_BeginTimestamp.m_Index = m_pQueryPool->WriteTimestamp( m_CommandBuffer );
+            m_pData->m_BeginTimestamp.m_Index = m_pQueryPool->WriteTimestamp( m_CommandBuffer );
         }
     }
 
@@ -191,26 +242,31 @@ namespace Profiler
     void ProfilerCommandBuffer::End()
     {
         TipGuard tip( m_Profiler.m_pDevice->TIP, __func__ );
+        DeviceProfilerOverheadScope overhead( m_Profiler.m_Overhead, DeviceProfilerCpuOverheadCategory::eCommandRecording );
 
         if( m_ProfilingEnabled )
         {
+            // Queries must not be active when the command buffer ends.
+            m_pQueryPool->EndPipelineStatisticsQuery( m_CommandBuffer );
+
             // Send global timestamp query for the whole command buffer.
-            m_Data.m_EndTimestamp.m_Index =
+            m_pData->m_EndTimestamp.m_Index =
                 m_pQueryPool->WriteTimestamp( m_CommandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT );
 
             if( (m_pCurrentRenderPassData != nullptr) &&
                 (m_Profiler.m_Config.m_SamplingMode <= VK_PROFILER_MODE_PER_RENDER_PASS_EXT) )
             {
                 uint64_t lastTimestampInRenderPassIndex =
-                    m_Data.m_EndTimestamp.m_Index;
+                    m_pData->m_EndTimestamp.m_Index;
 
+                // Indices of the last drawcall are at the back of the array if the current pipeline is not empty.
                 if( (m_Profiler.m_Config.m_SamplingMode == VK_PROFILER_MODE_PER_DRAWCALL_EXT) &&
                     (m_pCurrentPipelineData != nullptr) &&
                     !m_pCurrentPipelineData->m_Drawcalls.empty() &&
-                    (m_pCurrentPipelineData->m_Drawcalls.back().m_EndTimestamp.m_Index != UINT64_MAX) )
+                    (m_DrawcallTimestampIndices.back().m_EndIndex != UINT64_MAX) )
                 {
                     lastTimestampInRenderPassIndex =
-                        m_pCurrentPipelineData->m_Drawcalls.back().m_EndTimestamp.m_Index;
+                        m_DrawcallTimestampIndices.back().m_EndIndex;
                 }
 
                 // Update an ending timestamp for the previous render pass.
@@ -237,6 +293,10 @@ namespace Profiler
             // Perform deferred indirect argument buffer copies.
             FlushIndirectArgumentCopyLists();
 
+            // Copy only the live indirect count arguments to the readback buffers.
+            // The application's state is not used after this point, so the compaction pipeline can be bound freely.
+            CompactIndirectArgumentBuffers();
+
             // Flush all memory writes to make timestamp queries available for reading
             // in the next command buffer that copies the data to the readback buffer.
             VkMemoryBarrier memoryBarrier = {};
@@ -252,6 +312,14 @@ namespace Profiler
                 1, &memoryBarrier,
                 0, nullptr,
                 0, nullptr );
+
+            // Save time spent by the application recording the command buffer.
+            DeviceProfilerCpuSpanData recordingSpan;
+            recordingSpan.m_Type = DeviceProfilerCpuSpanType::eCommandBufferRecording;
+            recordingSpan.m_BeginTimestamp = m_RecordingBeginTimestamp;
+            recordingSpan.m_EndTimestamp = m_Profiler.m_CpuTimestampCounter.GetCurrentValue();
+            recordingSpan.m_CommandBuffer = m_pData->m_Handle;
+            m_Profiler.m_CpuTimeline.AppendSpan( recordingSpan );
         }
     }
 
@@ -273,28 +341,39 @@ namespace Profiler
             // The data must be collected before the command bufer is reused.
             m_Profiler.m_DataAggregator.Aggregate( this );
 
+            // The frames may still reference the collected data, don't clear it.
+            MakeDataWritable( false /*preserveContents*/ );
+
             // Reset data
             m_Stats = {};
-            m_Data.m_RenderPasses.clear();
+            m_pData->m_RenderPasses.clear();
+            m_pData->m_HasTraceTriggerLabel = false;
             m_pSecondaryCommandBuffers.clear();
 
             m_CurrentSubpassIndex = DeviceProfilerSubpassData::ImplicitSubpassIndex;
+            m_CurrentViewMask = 0;
             m_pCurrentRenderPass = nullptr;
             m_pCurrentRenderPassData = nullptr;
             m_pCurrentSubpassData = nullptr;
             m_pCurrentPipelineData = nullptr;
             m_pCurrentDrawcallData = nullptr;
+            m_DrawcallTimestampIndices.clear();
 
-            m_Data.m_DataValid = false;
+            m_pData->m_DataValid = false;
 
-            if( m_Profiler.m_Config.m_CaptureIndirectArguments )
+            if( m_CaptureIndirectArguments )
             {
                 // Reset indirect argument buffers.
                 for( auto& buffer : m_IndirectArgumentBufferList )
                 {
                     buffer.m_Offset = 0;
                     buffer.m_PendingCopyList.clear();
+                    buffer.m_CompactionList.clear();
                 }
+
+                m_IndirectArgumentRegions.clear();
+                m_IndirectArgumentDrawcalls.clear();
+                m_PendingIndirectArgumentRegions.clear();
             }
         }
     }
@@ -311,6 +390,7 @@ namespace Profiler
     void ProfilerCommandBuffer::PreBeginRenderPass( const VkRenderPassBeginInfo* pBeginInfo, VkSubpassContents )
     {
         TipGuard tip( m_Profiler.m_pDevice->TIP, __func__ );
+        DeviceProfilerOverheadScope overhead( m_Profiler.m_Overhead, DeviceProfilerCpuOverheadCategory::eCommandRecording );
 
         if( m_ProfilingEnabled )
         {
@@ -318,7 +398,7 @@ namespace Profiler
 
             // Setup pointers for the new render pass.
             m_pCurrentRenderPass = &m_Profiler.GetRenderPass( pBeginInfo->renderPass );
-            m_pCurrentRenderPassData = &m_Data.m_RenderPasses.emplace_back();
+            m_pCurrentRenderPassData = &m_pData->m_RenderPasses.emplace_back();
             m_pCurrentRenderPassData->m_Handle = m_pCurrentRenderPass->m_Handle;
             m_pCurrentRenderPassData->m_Type = m_pCurrentRenderPass->m_Type;
 
@@ -351,6 +431,7 @@ namespace Profiler
     void ProfilerCommandBuffer::PostBeginRenderPass( const VkRenderPassBeginInfo*, VkSubpassContents contents )
     {
         TipGuard tip( m_Profiler.m_pDevice->TIP, __func__ );
+        DeviceProfilerOverheadScope overhead( m_Profiler.m_Overhead, DeviceProfilerCpuOverheadCategory::eCommandRecording );
 
         if( m_ProfilingEnabled )
         {
@@ -383,6 +464,7 @@ namespace Profiler
     void ProfilerCommandBuffer::PreEndRenderPass()
     {
         TipGuard tip( m_Profiler.m_pDevice->TIP, __func__ );
+        DeviceProfilerOverheadScope overhead( m_Profiler.m_Overhead, DeviceProfilerCpuOverheadCategory::eCommandRecording );
 
         if( m_ProfilingEnabled )
         {
@@ -416,6 +498,7 @@ namespace Profiler
     void ProfilerCommandBuffer::PostEndRenderPass()
     {
         TipGuard tip( m_Profiler.m_pDevice->TIP, __func__ );
+        DeviceProfilerOverheadScope overhead( m_Profiler.m_Overhead, DeviceProfilerCpuOverheadCategory::eCommandRecording );
 
         if( m_ProfilingEnabled )
         {
@@ -439,7 +522,7 @@ namespace Profiler
                 }
             }
 
-            if( m_Profiler.m_Config.m_CaptureIndirectArguments )
+            if( m_CaptureIndirectArguments )
             {
                 // Record pending indirect argument buffer copies after the render pass.
                 FlushIndirectArgumentCopyLists();
@@ -447,6 +530,7 @@ namespace Profiler
 
             // No more subpasses in this render pass.
             m_CurrentSubpassIndex = DeviceProfilerSubpassData::ImplicitSubpassIndex;
+            m_CurrentViewMask = 0;
             m_pCurrentRenderPass = nullptr;
             m_pCurrentRenderPassData = nullptr;
             m_pCurrentSubpassData = nullptr;
@@ -466,17 +550,20 @@ namespace Profiler
     void ProfilerCommandBuffer::PreBeginRendering( const VkRenderingInfo* pRenderingInfo )
     {
         TipGuard tip( m_Profiler.m_pDevice->TIP, __func__ );
+        DeviceProfilerOverheadScope overhead( m_Profiler.m_Overhead, DeviceProfilerCpuOverheadCategory::eCommandRecording );
 
         if( m_ProfilingEnabled )
         {
             PreBeginRenderPassCommonProlog();
 
             // Setup pointers for the new render pass.
-            m_pCurrentRenderPassData = &m_Data.m_RenderPasses.emplace_back();
+            m_pCurrentRenderPassData = &m_pData->m_RenderPasses.emplace_back();
             m_pCurrentRenderPassData->m_Handle = VK_NULL_HANDLE;
             m_pCurrentRenderPassData->m_Type = DeviceProfilerRenderPassType::eGraphics;
             m_pCurrentRenderPassData->m_Dynamic = true;
 
+            m_CurrentViewMask = pRenderingInfo->viewMask;
+
             // Helper function to accumulate common attachment operations.
             auto AccumulateAttachmentOperations = [&](
                 const VkRenderingAttachmentInfo* pAttachmentInfo,
@@ -606,6 +693,7 @@ namespace Profiler
     void ProfilerCommandBuffer::NextSubpass( VkSubpassContents contents )
     {
         TipGuard tip( m_Profiler.m_pDevice->TIP, __func__ );
+        DeviceProfilerOverheadScope overhead( m_Profiler.m_Overhead, DeviceProfilerCpuOverheadCategory::eCommandRecording );
 
         if( m_ProfilingEnabled )
         {
@@ -617,6 +705,13 @@ namespace Profiler
             m_pCurrentSubpassData->m_Index = ++m_CurrentSubpassIndex;
             m_pCurrentSubpassData->m_Contents = contents;
 
+            // Dynamic rendering sets the view mask in PreBeginRendering.
+            if( (m_pCurrentRenderPass != nullptr) &&
+                (m_CurrentSubpassIndex < m_pCurrentRenderPass->m_Subpasses.size()) )
+            {
+                m_CurrentViewMask = m_pCurrentRenderPass->m_Subpasses[ m_CurrentSubpassIndex ].m_ViewMask;
+            }
+
             if( m_Profiler.m_Config.m_SamplingMode <= VK_PROFILER_MODE_PER_RENDER_PASS_EXT )
             {
                 // Write begin timestamp of the subpass.
@@ -638,6 +733,7 @@ namespace Profiler
     void ProfilerCommandBuffer::BindPipeline( const DeviceProfilerPipeline& pipeline )
     {
         TipGuard tip( m_Profiler.m_pDevice->TIP, __func__ );
+        DeviceProfilerOverheadScope overhead( m_Profiler.m_Overhead, DeviceProfilerCpuOverheadCategory::eCommandRecording );
 
         if( m_ProfilingEnabled )
         {
@@ -670,6 +766,7 @@ namespace Profiler
     void ProfilerCommandBuffer::BindShaders( uint32_t shaderCount, const VkShaderStageFlagBits* pStages, const VkShaderEXT* pShaders )
     {
         TipGuard tip( m_Profiler.m_pDevice->TIP, __func__ );
+        DeviceProfilerOverheadScope overhead( m_Profiler.m_Overhead, DeviceProfilerCpuOverheadCategory::eCommandRecording );
 
         constexpr VkShaderStageFlags allGraphicsShaderStages =
             VK_SHADER_STAGE_ALL_GRAPHICS |
@@ -777,6 +874,7 @@ namespace Profiler
     void ProfilerCommandBuffer::PreCommand( const DeviceProfilerDrawcall& drawcall )
     {
         TipGuard tip( m_Profiler.m_pDevice->TIP, __func__ );
+        DeviceProfilerOverheadScope overhead( m_Profiler.m_Overhead, DeviceProfilerCpuOverheadCategory::eCommandRecording );
 
         if( m_ProfilingEnabled )
         {
@@ -807,22 +905,37 @@ namespace Profiler
                 break;
             }
 
+            // Begin collection of pipeline statistics before the first command in the pipeline
+            if( m_pCurrentPipelineData->m_Drawcalls.empty() )
+            {
+                BeginPipelineStatisticsQuery();
+            }
+
             // Append drawcall to the current pipeline
             m_pCurrentDrawcallData = &m_pCurrentPipelineData->m_Drawcalls.emplace_back( drawcall );
             m_pCurrentDrawcallData->ResolveObjectHandles( m_Profiler );
+            m_DrawcallTimestampIndices.emplace_back();
 
-            if( m_Profiler.m_Config.m_CaptureIndirectArguments )
+            if( m_CaptureIndirectArguments )
             {
                 // Save indirect arguments
                 SaveIndirectArgs( *m_pCurrentDrawcallData );
             }
 
+            // Match the debug labels once, when recorded, instead of searching the data of each frame.
+            if( (drawcall.m_Type == DeviceProfilerDrawcallType::eInsertDebugLabel) ||
+                (drawcall.m_Type == DeviceProfilerDrawcallType::eBeginDebugLabel) )
+            {
+                MatchTraceTriggerLabel( drawcall.m_Payload.m_DebugLabel.m_pName );
+            }
+
             // Increment drawcall stats
             m_Stats.AddCount( drawcall );
 
             uint64_t timestampIndex = UINT64_MAX;
 
-            if( m_Profiler.m_Config.m_SamplingMode == VK_PROFILER_MODE_PER_DRAWCALL_EXT )
+            if( (m_Profiler.m_Config.m_SamplingMode == VK_PROFILER_MODE_PER_DRAWCALL_EXT) &&
+                ShouldSampleDrawcall( drawcall ) )
             {
                 // Begin timestamp query
                 if( timestampIndex == UINT64_MAX )
@@ -830,7 +943,7 @@ namespace Profiler
                     timestampIndex = m_pQueryPool->WriteTimestamp( m_CommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT );
                 }
 
-                m_pCurrentDrawcallData->m_BeginTimestamp.m_Index = timestampIndex;
+                m_DrawcallTimestampIndices.back().m_BeginIndex = timestampIndex;
             }
 
             if( m_Profiler.m_Config.m_SamplingMode <= VK_PROFILER_MODE_PER_PIPELINE_EXT )
@@ -883,6 +996,7 @@ namespace Profiler
     void ProfilerCommandBuffer::PostCommand( const DeviceProfilerDrawcall& drawcall )
     {
         TipGuard tip( m_Profiler.m_pDevice->TIP, __func__ );
+        DeviceProfilerOverheadScope overhead( m_Profiler.m_Overhead, DeviceProfilerCpuOverheadCategory::eCommandRecording );
 
         if( m_ProfilingEnabled )
         {
@@ -890,17 +1004,22 @@ namespace Profiler
             if( m_Profiler.m_Config.m_SamplingMode == VK_PROFILER_MODE_PER_DRAWCALL_EXT )
             {
                 assert( m_pCurrentDrawcallData );
+                DrawcallTimestampIndices& timestampIndices = m_DrawcallTimestampIndices.back();
 
-                if( drawcall.GetPipelineType() != DeviceProfilerPipelineType::eDebug )
-                {
-                    // Send a timestamp query at the end of the command.
-                    m_pCurrentDrawcallData->m_EndTimestamp.m_Index =
-                        m_pQueryPool->WriteTimestamp(m_CommandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
-                }
-                else
+                // Skip drawcalls that have not been sampled.
+                if( timestampIndices.m_BeginIndex != UINT64_MAX )
                 {
-                    // Debug labels have 0 duration, so there is no need for the second query.
-                    m_pCurrentDrawcallData->m_EndTimestamp = m_pCurrentDrawcallData->m_BeginTimestamp;
+                    if( drawcall.GetPipelineType() != DeviceProfilerPipelineType::eDebug )
+                    {
+                        // Send a timestamp query at the end of the command.
+                        timestampIndices.m_EndIndex =
+                            m_pQueryPool->WriteTimestamp(m_CommandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+                    }
+                    else
+                    {
+                        // Debug labels have 0 duration, so there is no need for the second query.
+                        timestampIndices.m_EndIndex = timestampIndices.m_BeginIndex;
+                    }
                 }
 
                 m_pCurrentDrawcallData = nullptr;
@@ -920,26 +1039,36 @@ namespace Profiler
     void ProfilerCommandBuffer::ExecuteCommands( uint32_t count, const VkCommandBuffer* pCommandBuffers )
     {
         TipGuard tip( m_Profiler.m_pDevice->TIP, __func__ );
+        DeviceProfilerOverheadScope overhead( m_Profiler.m_Overhead, DeviceProfilerCpuOverheadCategory::eCommandRecording );
 
         if( m_ProfilingEnabled )
         {
             // Ensure there is a render pass and subpass with VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS flag
             SetupCommandBufferForSecondaryBuffers();
 
-            auto& currentRenderPass = m_Data.m_RenderPasses.back();
+            // Inline commands recorded before the secondary command buffers belong to a separate pipeline scope.
+            // This also ends the pipeline statistics query, which can't be inherited by the secondary command buffers.
+            EndPipeline();
+
+            auto& currentRenderPass = m_pData->m_RenderPasses.back();
             auto& currentSubpass = currentRenderPass.m_Subpasses.back();
 
             for( uint32_t i = 0; i < count; ++i )
             {
-                currentSubpass.m_Data.push_back( DeviceProfilerCommandBufferData{
-                    m_Profiler.ResolveObjectHandle<VkCommandBufferHandle>( pCommandBuffers[i] ),
-                    VK_COMMAND_BUFFER_LEVEL_SECONDARY
-                    } );
+                // Placeholder for the data of the secondary command buffer, replaced when the data is resolved.
+                auto pCommandBufferData = std::make_shared<DeviceProfilerCommandBufferData>();
+                pCommandBufferData->m_Handle = m_Profiler.ResolveObjectHandle<VkCommandBufferHandle>( pCommandBuffers[i] );
+                pCommandBufferData->m_Level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+
+                currentSubpass.m_Data.push_back( DeviceProfilerCommandBufferDataPtr( std::move( pCommandBufferData ) ) );
 
                 // Add command buffer reference
                 ProfilerCommandBuffer* pSecondaryCommandBuffer = &m_Profiler.GetCommandBuffer( pCommandBuffers[i] );
                 m_pSecondaryCommandBuffers.insert( pSecondaryCommandBuffer );
 
+                // Secondary command buffers are fully recorded before they are executed.
+                m_pData->m_HasTraceTriggerLabel |= pSecondaryCommandBuffer->m_pData->m_HasTraceTriggerLabel;
+
                 // Keep track of nested secondary command buffers
                 if( m_Profiler.m_pDevice->EnabledFeatures.NestedCommandBuffer )
                 {
@@ -969,6 +1098,7 @@ namespace Profiler
         uint32_t imageMemoryBarrierCount, const VkImageMemoryBarrier* pImageMemoryBarriers )
     {
         TipGuard tip( m_Profiler.m_pDevice->TIP, __func__ );
+        DeviceProfilerOverheadScope overhead( m_Profiler.m_Overhead, DeviceProfilerCpuOverheadCategory::eCommandRecording );
 
         if( m_ProfilingEnabled )
         {
@@ -978,7 +1108,7 @@ namespace Profiler
                 bufferMemoryBarrierCount +
                 imageMemoryBarrierCount;
 
-            if( m_Profiler.m_Config.m_CaptureIndirectArguments )
+            if( m_CaptureIndirectArguments )
             {
                 // Flush any pending indirect argument buffer copies.
                 FlushIndirectArgumentCopyLists();
@@ -988,6 +1118,56 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Function:
+        BeginQuery
+
+    Description:
+        Marks beginning of the application's query.
+
+        Only one query of each type can be active in the command buffer. Collection of
+        pipeline statistics is suspended until the application's query ends, and the
+        statistics of the current pipeline are discarded, as they would be incomplete.
+
+    \***********************************************************************************/
+    void ProfilerCommandBuffer::BeginQuery( VkQueryType queryType )
+    {
+        TipGuard tip( m_Profiler.m_pDevice->TIP, __func__ );
+
+        if( m_ProfilingEnabled && ( queryType == VK_QUERY_TYPE_PIPELINE_STATISTICS ) )
+        {
+            m_pQueryPool->EndPipelineStatisticsQuery( m_CommandBuffer );
+
+            if( m_pCurrentPipelineData != nullptr )
+            {
+                m_pCurrentPipelineData->m_PipelineStatistics.m_Index = UINT64_MAX;
+            }
+
+            m_PipelineStatisticsSuspended = true;
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        EndQuery
+
+    Description:
+        Marks end of the application's query. Collection of pipeline statistics is
+        resumed with the next pipeline.
+
+    \***********************************************************************************/
+    void ProfilerCommandBuffer::EndQuery( VkQueryType queryType )
+    {
+        TipGuard tip( m_Profiler.m_pDevice->TIP, __func__ );
+
+        if( m_ProfilingEnabled && ( queryType == VK_QUERY_TYPE_PIPELINE_STATISTICS ) )
+        {
+            m_PipelineStatisticsSuspended = false;
+        }
+    }
+
+    /***********************************************************************************\
+
     Function:
         PipelineBarrier
 
@@ -998,6 +1178,7 @@ namespace Profiler
     void ProfilerCommandBuffer::PipelineBarrier( const VkDependencyInfo* pDependencyInfo )
     {
         TipGuard tip( m_Profiler.m_pDevice->TIP, __func__ );
+        DeviceProfilerOverheadScope overhead( m_Profiler.m_Overhead, DeviceProfilerCpuOverheadCategory::eCommandRecording );
 
         if( m_ProfilingEnabled )
         {
@@ -1007,7 +1188,7 @@ namespace Profiler
                 pDependencyInfo->bufferMemoryBarrierCount +
                 pDependencyInfo->imageMemoryBarrierCount;
 
-            if( m_Profiler.m_Config.m_CaptureIndirectArguments )
+            if( m_CaptureIndirectArguments )
             {
                 // Flush any pending indirect argument buffer copies.
                 FlushIndirectArgumentCopyLists();
@@ -1079,24 +1260,30 @@ namespace Profiler
         Reads all queried timestamps.
         Returns structure containing ordered list of timestamps and statistics.
 
+        The returned data is shared with the command buffer, which copies it before
+        the next resolve only if it is still referenced by then.
+
     \***********************************************************************************/
-    const DeviceProfilerCommandBufferData& ProfilerCommandBuffer::GetData( DeviceProfilerQueryDataBufferReader& reader )
+    DeviceProfilerCommandBufferDataPtr ProfilerCommandBuffer::GetData( DeviceProfilerQueryDataBufferReader& reader )
     {
         TipGuard tip( m_Profiler.m_pDevice->TIP, __func__ );
 
         if( m_ProfilingEnabled )
         {
+            // Keep the results of the previous submissions intact.
+            MakeDataWritable( true /*preserveContents*/ );
+
             reader.SetContext( this );
 
             // Reset accumulated stats if buffer is being reused
-            m_Data.m_Stats = m_Stats;
+            m_pData->m_Stats = m_Stats;
 
             // Read global timestamp values
-            m_Data.m_BeginTimestamp.m_Value = reader.ReadTimestampQueryResult( m_Data.m_BeginTimestamp.m_Index );
+            m_pData->m_BeginTimestamp.m_Value = reader.ReadTimestampQueryResult( m_pData->m_BeginTimestamp.m_Index );
 
             if( m_Profiler.m_Config.m_SamplingMode <= VK_PROFILER_MODE_PER_RENDER_PASS_EXT )
             {
-                for( auto& renderPass : m_Data.m_RenderPasses )
+                for( auto& renderPass : m_pData->m_RenderPasses )
                 {
                     // If this is a secondary command buffer and render pass starts with a nested command buffers,
                     // use the timestamp of the nested command buffer as a begin point of the render pass.
@@ -1116,11 +1303,11 @@ namespace Profiler
 
                         if( renderPass.m_ClearsColorAttachments )
                         {
-                            m_Data.m_Stats.m_ClearColorStats.AddTicks( renderPassBeginDuration );
+                            m_pData->m_Stats.m_ClearColorStats.AddTicks( renderPassBeginDuration );
                         }
                         if( renderPass.m_ClearsDepthStencilAttachments )
                         {
-                            m_Data.m_Stats.m_ClearDepthStencilStats.AddTicks( renderPassBeginDuration );
+                            m_pData->m_Stats.m_ClearDepthStencilStats.AddTicks( renderPassBeginDuration );
                         }
                     }
 
@@ -1241,6 +1428,14 @@ namespace Profiler
                     }
 
                     renderPass.m_EndTimestamp.m_Value = reader.ReadTimestampQueryResult( renderPass.m_EndTimestamp.m_Index );
+
+                    // Read pipeline statistics of the pipelines and sum them up for the render pass.
+                    ResolveRenderPassPipelineStatistics( reader, renderPass );
+                }
+
+                if( m_Profiler.m_Config.m_SamplingMode <= VK_PROFILER_MODE_PER_DRAWCALL_EXT )
+                {
+                    ResolveDrawcallTimestamps( reader );
                 }
             }
 
@@ -1250,15 +1445,20 @@ namespace Profiler
                 auto ResolveSecondaryCommandBufferData = [&]( DeviceProfilerSubpassData::Data& data )
                 {
                     assert( data.GetType() == DeviceProfilerSubpassDataType::eCommandBuffer );
-                    auto& commandBufferData = std::get<DeviceProfilerCommandBufferData>( data );
+                    auto& pCommandBufferData = std::get<DeviceProfilerCommandBufferDataPtr>( data );
 
                     ProfilerCommandBuffer& secondaryCommandBuffer =
-                        *m_Profiler.m_pCommandBuffers.unsafe_at( commandBufferData.m_Handle );
+                        *m_Profiler.m_pCommandBuffers.unsafe_at( pCommandBufferData->m_Handle );
 
-                    commandBufferData = secondaryCommandBuffer.GetData( reader );
+                    // Drop the reference to the previous results, so they can be reused if no frame holds them.
+                    pCommandBufferData.reset();
+                    pCommandBufferData = secondaryCommandBuffer.GetData( reader );
+
+                    // Restore context of this command buffer.
+                    reader.SetContext( this );
                 };
 
-                for( auto& renderPass : m_Data.m_RenderPasses )
+                for( auto& renderPass : m_pData->m_RenderPasses )
                 {
                     for( auto& subpass : renderPass.m_Subpasses )
                     {
@@ -1286,7 +1486,7 @@ namespace Profiler
                 }
             }
 
-            m_Data.m_EndTimestamp.m_Value = reader.ReadTimestampQueryResult( m_Data.m_EndTimestamp.m_Index );
+            m_pData->m_EndTimestamp.m_Value = reader.ReadTimestampQueryResult( m_pData->m_EndTimestamp.m_Index );
 
             // Read vendor-specific data
             if( reader.HasPerformanceQueryResult() )
@@ -1301,23 +1501,130 @@ namespace Profiler
                     m_CommandPool.GetQueueFamilyIndex(),
                     performanceQueryResultSize,
                     pPerformanceQueryResult,
-                    m_Data.m_PerformanceCounters.m_Results );
+                    m_pData->m_PerformanceCounters.m_Results );
 
-                m_Data.m_PerformanceCounters.m_MetricsSetIndex = performanceQueryMetricsSetIndex;
+                m_pData->m_PerformanceCounters.m_MetricsSetIndex = performanceQueryMetricsSetIndex;
+            }
+            else if( ( m_Profiler.m_pPerformanceCounters != nullptr ) &&
+                     ( m_Profiler.m_pPerformanceCounters->GetSamplingMode() == VK_PROFILER_PERFORMANCE_COUNTERS_SAMPLING_MODE_STREAM_EXT ) )
+            {
+                // Streamed metrics are collected per frame with the active metrics set.
+                // The index is set here, because the data can't be modified once it is passed to the frame.
+                m_pData->m_PerformanceCounters.m_MetricsSetIndex = m_Profiler.m_pPerformanceCounters->GetActiveMetricsSetIndex();
             }
 
             // Copy captured indirect argument buffer data
-            m_Data.m_IndirectPayload.clear();
+            m_pData->m_IndirectPayload.clear();
+
+            if( m_CaptureIndirectArguments )
+            {
+                ReadIndirectArgumentBuffers( m_pData->m_IndirectPayload );
+            }
+
+            m_pData->m_DataValid = true;
+        }
+
+        return m_pData;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        MakeDataWritable
+
+    Description:
+        Ensure that the data is not referenced by any frame before it is modified.
+        The resolved data is passed to the frames without copying, so it is copied
+        here only if the results of the previous submission are still in use.
+        If the contents are going to be cleared, a new structure is allocated instead.
+
+    \***********************************************************************************/
+    void ProfilerCommandBuffer::MakeDataWritable( bool preserveContents )
+    {
+        if( m_pData.use_count() > 1 )
+        {
+            std::shared_ptr<DeviceProfilerCommandBufferData> pData;
 
-            if( m_Profiler.m_Config.m_CaptureIndirectArguments )
+            if( preserveContents )
             {
-                ReadIndirectArgumentBuffers( m_Data.m_IndirectPayload );
+                pData = std::make_shared<DeviceProfilerCommandBufferData>( *m_pData );
+                m_Profiler.m_Overhead.AddCopiedData( *pData );
+
+                // Indirect argument offsets are written to the drawcalls in each resolve.
+                RemapIndirectArgumentDrawcalls( *m_pData, *pData );
+            }
+            else
+            {
+                pData = std::make_shared<DeviceProfilerCommandBufferData>();
+                pData->m_Handle = m_pData->m_Handle;
+                pData->m_Level = m_pData->m_Level;
             }
 
-            m_Data.m_DataValid = true;
+            m_pData = std::move( pData );
+
+            // Pointers into the render pass tree are owned by the frames now.
+            m_pCurrentRenderPassData = nullptr;
+            m_pCurrentSubpassData = nullptr;
+            m_pCurrentPipelineData = nullptr;
+            m_pCurrentDrawcallData = nullptr;
+        }
+        else
+        {
+            // The frames may have released the data on other threads.
+            // Synchronize with their reads before the data is modified.
+            std::atomic_thread_fence( std::memory_order_acquire );
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        RemapIndirectArgumentDrawcalls
+
+    Description:
+        Point the drawcalls with captured indirect arguments to their copies in dst.
+        Both structures must have the same layout.
+
+    \***********************************************************************************/
+    void ProfilerCommandBuffer::RemapIndirectArgumentDrawcalls( const DeviceProfilerCommandBufferData& src, DeviceProfilerCommandBufferData& dst )
+    {
+        if( m_IndirectArgumentDrawcalls.empty() )
+        {
+            return;
         }
 
-        return m_Data;
+        std::unordered_map<const DeviceProfilerDrawcall*, DeviceProfilerDrawcall*> drawcalls;
+
+        for( size_t renderPassIndex = 0; renderPassIndex < src.m_RenderPasses.size(); ++renderPassIndex )
+        {
+            const DeviceProfilerRenderPassData& srcRenderPass = src.m_RenderPasses[ renderPassIndex ];
+            DeviceProfilerRenderPassData& dstRenderPass = dst.m_RenderPasses[ renderPassIndex ];
+
+            for( size_t subpassIndex = 0; subpassIndex < srcRenderPass.m_Subpasses.size(); ++subpassIndex )
+            {
+                const DeviceProfilerSubpassData& srcSubpass = srcRenderPass.m_Subpasses[ subpassIndex ];
+                DeviceProfilerSubpassData& dstSubpass = dstRenderPass.m_Subpasses[ subpassIndex ];
+
+                for( size_t dataIndex = 0; dataIndex < srcSubpass.m_Data.size(); ++dataIndex )
+                {
+                    if( srcSubpass.m_Data[ dataIndex ].GetType() == DeviceProfilerSubpassDataType::ePipeline )
+                    {
+                        const auto& srcPipeline = std::get<DeviceProfilerPipelineData>( srcSubpass.m_Data[ dataIndex ] );
+                        auto& dstPipeline = std::get<DeviceProfilerPipelineData>( dstSubpass.m_Data[ dataIndex ] );
+
+                        for( size_t drawcallIndex = 0; drawcallIndex < srcPipeline.m_Drawcalls.size(); ++drawcallIndex )
+                        {
+                            drawcalls.emplace( &srcPipeline.m_Drawcalls[ drawcallIndex ], &dstPipeline.m_Drawcalls[ drawcallIndex ] );
+                        }
+                    }
+                }
+            }
+        }
+
+        for( IndirectArgumentDrawcall& indirectArgumentDrawcall : m_IndirectArgumentDrawcalls )
+        {
+            indirectArgumentDrawcall.m_pDrawcall = drawcalls.at( indirectArgumentDrawcall.m_pDrawcall );
+        }
     }
 
     /***********************************************************************************\
@@ -1326,7 +1633,8 @@ namespace Profiler
         ResolveSubpassPipelineData
 
     Description:
-        Read timestamps for all drawcalls in the pipeline.
+        Read begin and end timestamps of the pipeline.
+        Timestamps of the drawcalls are read by ResolveDrawcallTimestamps.
 
     \***********************************************************************************/
     void ProfilerCommandBuffer::ResolveSubpassPipelineData( const DeviceProfilerQueryDataBufferReader& reader, DeviceProfilerSubpassData& subpass, size_t subpassDataIndex )
@@ -1339,29 +1647,76 @@ namespace Profiler
         auto& pipeline = std::get<DeviceProfilerPipelineData>( data );
         pipeline.m_BeginTimestamp.m_Value = reader.ReadTimestampQueryResult( pipeline.m_BeginTimestamp.m_Index );
         pipeline.m_EndTimestamp.m_Value = reader.ReadTimestampQueryResult( pipeline.m_EndTimestamp.m_Index );
+    }
 
-        if( m_Profiler.m_Config.m_SamplingMode <= VK_PROFILER_MODE_PER_DRAWCALL_EXT )
+    /***********************************************************************************\
+
+    Function:
+        ResolveDrawcallTimestamps
+
+    Description:
+        Read timestamps of all drawcalls recorded in the command buffer.
+        The drawcalls are visited in recording order, so their query indices are read
+        sequentially from the array instead of from each node of the tree.
+
+    \***********************************************************************************/
+    void ProfilerCommandBuffer::ResolveDrawcallTimestamps( const DeviceProfilerQueryDataBufferReader& reader )
+    {
+        TipGuard tip( m_Profiler.m_pDevice->TIP, __func__ );
+
+        const DrawcallTimestampIndices* pTimestampIndices = m_DrawcallTimestampIndices.data();
+        const DrawcallTimestampIndices* pTimestampIndicesEnd = pTimestampIndices + m_DrawcallTimestampIndices.size();
+
+        for( auto& renderPass : m_pData->m_RenderPasses )
         {
-            for( auto& drawcall : pipeline.m_Drawcalls )
+            for( auto& subpass : renderPass.m_Subpasses )
             {
-                // Don't collect data for debug labels
-                if( drawcall.GetPipelineType() != DeviceProfilerPipelineType::eDebug )
+                for( auto& data : subpass.m_Data )
                 {
-                    // Update drawcall timestamps
-                    drawcall.m_BeginTimestamp.m_Value = reader.ReadTimestampQueryResult( drawcall.m_BeginTimestamp.m_Index );
-                    drawcall.m_EndTimestamp.m_Value = reader.ReadTimestampQueryResult( drawcall.m_EndTimestamp.m_Index );
+                    // Drawcalls of the secondary command buffers are resolved by them.
+                    if( data.GetType() != DeviceProfilerSubpassDataType::ePipeline )
+                    {
+                        continue;
+                    }
 
-                    // Increment drawcall stats
-                    m_Data.m_Stats.AddTicks( drawcall.m_Type, GetDuration( drawcall ) );
-                }
-                else
-                {
-                    // Provide timestamps for debug commands
-                    drawcall.m_BeginTimestamp.m_Value = reader.ReadTimestampQueryResult( drawcall.m_BeginTimestamp.m_Index );
-                    drawcall.m_EndTimestamp.m_Value = drawcall.m_BeginTimestamp.m_Value;
+                    auto& pipeline = std::get<DeviceProfilerPipelineData>( data );
+                    for( auto& drawcall : pipeline.m_Drawcalls )
+                    {
+                        assert( pTimestampIndices < pTimestampIndicesEnd );
+                        const DrawcallTimestampIndices& timestampIndices = *pTimestampIndices++;
+
+                        // Estimate stats of the drawcalls that have not been sampled.
+                        // Keep the invalid timestamps so the outputs can skip them.
+                        if( timestampIndices.m_BeginIndex == UINT64_MAX )
+                        {
+                            drawcall.m_BeginTimestamp.m_Value = UINT64_MAX;
+                            drawcall.m_EndTimestamp.m_Value = UINT64_MAX;
+
+                            m_pData->m_Stats.AddSkippedSample( drawcall.m_Type );
+                            continue;
+                        }
+
+                        drawcall.m_BeginTimestamp.m_Value = reader.ReadTimestampQueryResult( timestampIndices.m_BeginIndex );
+
+                        // Don't collect data for debug labels
+                        if( drawcall.GetPipelineType() != DeviceProfilerPipelineType::eDebug )
+                        {
+                            drawcall.m_EndTimestamp.m_Value = reader.ReadTimestampQueryResult( timestampIndices.m_EndIndex );
+
+                            // Increment drawcall stats
+                            m_pData->m_Stats.AddTicks( drawcall.m_Type, GetDuration( drawcall ) );
+                        }
+                        else
+                        {
+                            // Provide timestamps for debug commands
+                            drawcall.m_EndTimestamp.m_Value = drawcall.m_BeginTimestamp.m_Value;
+                        }
+                    }
                 }
             }
         }
+
+        assert( pTimestampIndices == pTimestampIndicesEnd );
     }
 
     /***********************************************************************************\
@@ -1374,7 +1729,7 @@ namespace Profiler
 
     \***********************************************************************************/
     void ProfilerCommandBuffer::ResolveSubpassSecondaryCommandBufferData(
-        DeviceProfilerQueryDataBufferReader reader,
+        DeviceProfilerQueryDataBufferReader& reader,
         DeviceProfilerSubpassData& subpass,
         size_t subpassDataIndex,
         size_t subpassDataCount,
@@ -1386,13 +1741,21 @@ namespace Profiler
         auto& data = subpass.m_Data[subpassDataIndex];
         assert( data.GetType() == DeviceProfilerSubpassDataType::eCommandBuffer );
 
-        auto& commandBuffer = std::get<DeviceProfilerCommandBufferData>( data );
-        VkCommandBuffer handle = commandBuffer.m_Handle;
+        auto& pCommandBufferData = std::get<DeviceProfilerCommandBufferDataPtr>( data );
+        VkCommandBuffer handle = pCommandBufferData->m_Handle;
         ProfilerCommandBuffer& profilerCommandBuffer = *m_Profiler.m_pCommandBuffers.unsafe_at( handle );
 
+        // Drop the reference to the previous results, so they can be reused if no frame holds them.
+        pCommandBufferData.reset();
+
         // Collect secondary command buffer data
-        commandBuffer = profilerCommandBuffer.GetData( reader );
-        assert( commandBuffer.m_Handle == handle );
+        pCommandBufferData = profilerCommandBuffer.GetData( reader );
+        assert( pCommandBufferData->m_Handle == handle );
+
+        const DeviceProfilerCommandBufferData& commandBuffer = *pCommandBufferData;
+
+        // Restore context of this command buffer.
+        reader.SetContext( this );
 
         // Propagate timestamps from command buffer to subpass
         if( subpassDataIndex == 0 )
@@ -1407,7 +1770,52 @@ namespace Profiler
         }
 
         // Collect secondary command buffer stats
-        m_Data.m_Stats += commandBuffer.m_Stats;
+        m_pData->m_Stats += commandBuffer.m_Stats;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        ResolveRenderPassPipelineStatistics
+
+    Description:
+        Read pipeline statistics of all pipelines in the render pass. Statistics of the
+        render pass are the sum of statistics of its pipelines and secondary command
+        buffers, which must be resolved before calling this function.
+
+    \***********************************************************************************/
+    void ProfilerCommandBuffer::ResolveRenderPassPipelineStatistics( const DeviceProfilerQueryDataBufferReader& reader, DeviceProfilerRenderPassData& renderPass )
+    {
+        TipGuard tip( m_Profiler.m_pDevice->TIP, __func__ );
+
+        renderPass.m_PipelineStatistics = {};
+
+        for( auto& subpass : renderPass.m_Subpasses )
+        {
+            for( auto& data : subpass.m_Data )
+            {
+                switch( data.GetType() )
+                {
+                case DeviceProfilerSubpassDataType::ePipeline:
+                {
+                    auto& pipeline = std::get<DeviceProfilerPipelineData>( data );
+                    reader.ReadPipelineStatisticsQueryResult( pipeline.m_PipelineStatistics );
+
+                    renderPass.m_PipelineStatistics += pipeline.m_PipelineStatistics;
+                    break;
+                }
+                case DeviceProfilerSubpassDataType::eCommandBuffer:
+                {
+                    const auto& commandBuffer = *std::get<DeviceProfilerCommandBufferDataPtr>( data );
+                    for( const auto& commandBufferRenderPass : commandBuffer.m_RenderPasses )
+                    {
+                        renderPass.m_PipelineStatistics += commandBufferRenderPass.m_PipelineStatistics;
+                    }
+                    break;
+                }
+                }
+            }
+        }
     }
 
     /***********************************************************************************\
@@ -1429,7 +1837,7 @@ namespace Profiler
             // Finalize render pass instrumentation.
             EndRenderPass();
 
-            if( m_Profiler.m_Config.m_CaptureIndirectArguments )
+            if( m_CaptureIndirectArguments )
             {
                 // Record pending indirect argument buffer copies after the last render pass.
                 FlushIndirectArgumentCopyLists();
@@ -1481,6 +1889,63 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Function:
+        MatchTraceTriggerLabel
+
+    Description:
+        Marks the command buffer if the debug label name contains the pattern that
+        triggers the trace capture.
+
+    \***********************************************************************************/
+    void ProfilerCommandBuffer::MatchTraceTriggerLabel( const char* pName )
+    {
+        const std::string& pattern = m_Profiler.m_Config.m_TraceTriggerDebugLabel;
+
+        if( !m_pData->m_HasTraceTriggerLabel &&
+            !pattern.empty() &&
+            (pName != nullptr) &&
+            (strstr( pName, pattern.c_str() ) != nullptr) )
+        {
+            m_pData->m_HasTraceTriggerLabel = true;
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        BeginPipelineStatisticsQuery
+
+    Description:
+        Begins collection of pipeline statistics for the current pipeline.
+        The query is scoped to the pipeline, because queries of the same type must not
+        overlap and a query begun in a subpass must end in the same subpass. No query is
+        begun while the application's pipeline statistics query is active.
+
+    \***********************************************************************************/
+    void ProfilerCommandBuffer::BeginPipelineStatisticsQuery()
+    {
+        TipGuard tip( m_Profiler.m_pDevice->TIP, __func__ );
+
+        if( (m_pCurrentPipelineData != nullptr) &&
+            (m_Profiler.m_Config.m_SamplingMode <= VK_PROFILER_MODE_PER_RENDER_PASS_EXT) &&
+            (!m_PipelineStatisticsSuspended) )
+        {
+            // Statistics are meaningful only for the commands that execute shaders.
+            if( (m_pCurrentPipelineData->m_Type == DeviceProfilerPipelineType::eGraphics) ||
+                (m_pCurrentPipelineData->m_Type == DeviceProfilerPipelineType::eCompute) )
+            {
+                // Multiview render passes use one query per view.
+                const uint32_t viewCount = std::max( 1u, BitCount( m_CurrentViewMask ) );
+
+                m_pCurrentPipelineData->m_PipelineStatistics.m_ViewCount = viewCount;
+                m_pCurrentPipelineData->m_PipelineStatistics.m_Index =
+                    m_pQueryPool->BeginPipelineStatisticsQuery( m_CommandBuffer, viewCount );
+            }
+        }
+    }
+
+    /***********************************************************************************\
+
     Function:
         EndPipeline
 
@@ -1494,13 +1959,16 @@ namespace Profiler
 
         if( m_pCurrentPipelineData )
         {
+            // End collection of pipeline statistics.
+            m_pQueryPool->EndPipelineStatisticsQuery( m_CommandBuffer );
+
             if( m_Profiler.m_Config.m_SamplingMode <= VK_PROFILER_MODE_PER_PIPELINE_EXT )
             {
                 // Reuse drawcall end timestamp if available.
-                auto lastDrawcallIt = m_pCurrentPipelineData->m_Drawcalls.rbegin();
-                if( lastDrawcallIt != m_pCurrentPipelineData->m_Drawcalls.rend() )
+                // Indices of the last drawcall are at the back of the array if the current pipeline is not empty.
+                if( !m_pCurrentPipelineData->m_Drawcalls.empty() )
                 {
-                    m_pCurrentPipelineData->m_EndTimestamp = lastDrawcallIt->m_EndTimestamp;
+                    m_pCurrentPipelineData->m_EndTimestamp.m_Index = m_DrawcallTimestampIndices.back().m_EndIndex;
                 }
 
                 if( m_pCurrentPipelineData->m_EndTimestamp.m_Index == UINT64_MAX )
@@ -1634,7 +2102,7 @@ namespace Profiler
         {
             EndRenderPass();
 
-            m_pCurrentRenderPassData = &m_Data.m_RenderPasses.emplace_back();
+            m_pCurrentRenderPassData = &m_pData->m_RenderPasses.emplace_back();
             m_pCurrentRenderPassData->m_Handle = VK_NULL_HANDLE;
             m_pCurrentRenderPassData->m_Type = renderPassType;
         }
@@ -1685,7 +2153,7 @@ namespace Profiler
         {
             EndRenderPass();
 
-            m_pCurrentRenderPassData = &m_Data.m_RenderPasses.emplace_back();
+            m_pCurrentRenderPassData = &m_pData->m_RenderPasses.emplace_back();
             m_pCurrentRenderPassData->m_Handle = VK_NULL_HANDLE;
             m_pCurrentRenderPassData->m_Type = DeviceProfilerRenderPassType::eNone;
         }
@@ -1705,6 +2173,40 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Function:
+        ShouldSampleDrawcall
+
+    Description:
+        Checks whether timestamps should be written around the drawcall when drawcall
+        sampling rate is greater than 1. Debug labels are always sampled.
+
+        The rate is increased by the profiler when the number of commands recorded in
+        the previous frame exceeds the per-frame timestamp budget.
+
+    \***********************************************************************************/
+    bool ProfilerCommandBuffer::ShouldSampleDrawcall( const DeviceProfilerDrawcall& drawcall )
+    {
+        if( drawcall.GetPipelineType() == DeviceProfilerPipelineType::eDebug )
+        {
+            return true;
+        }
+
+        if( m_Profiler.m_Config.m_DrawcallTimestampBudget > 0 )
+        {
+            m_Profiler.m_DrawcallCount.fetch_add( 1, std::memory_order_relaxed );
+        }
+
+        const uint32_t samplingRate = m_Profiler.m_DrawcallSamplingRate.load( std::memory_order_relaxed );
+        if( samplingRate <= 1 )
+        {
+            return true;
+        }
+
+        return (m_DrawcallSamplingIndex++ % samplingRate) == 0;
+    }
+
+    /***********************************************************************************\
+
     Function:
         GetRenderPassTypeFromPipelineType
 
@@ -1745,72 +2247,178 @@ namespace Profiler
     \***********************************************************************************/
     void ProfilerCommandBuffer::SaveIndirectArgs( DeviceProfilerDrawcall& drawcall )
     {
+        size_t regionIndex = 0;
+
         switch( drawcall.m_Type )
         {
         case DeviceProfilerDrawcallType::eDrawIndirect:
         case DeviceProfilerDrawcallType::eDrawIndexedIndirect: {
-            DeviceProfilerDrawcallDrawIndirectPayload& payload = drawcall.m_Payload.m_DrawIndirect;
-            const size_t indirectPayloadSize = payload.m_DrawCount * payload.m_Stride;
-
-            IndirectArgumentBuffer& buffer = AcquireIndirectArgumentBuffer( indirectPayloadSize );
-            payload.m_IndirectArgsOffset = buffer.m_Offset;
-            buffer.m_Offset += indirectPayloadSize;
-
-            IndirectArgumentBufferCopy& copy = buffer.m_PendingCopyList.emplace_back();
-            copy.m_SrcBuffer = payload.m_Buffer;
-            copy.m_DstBuffer = buffer.m_Buffer;
-            copy.m_Region.srcOffset = payload.m_Offset;
-            copy.m_Region.dstOffset = payload.m_IndirectArgsOffset;
-            copy.m_Region.size = indirectPayloadSize;
-
+            const DeviceProfilerDrawcallDrawIndirectPayload& payload = drawcall.m_Payload.m_DrawIndirect;
+            regionIndex = SaveIndirectArgsRegion(
+                payload.m_Buffer,
+                payload.m_Offset,
+                payload.m_DrawCount * payload.m_Stride );
             break;
         }
 
         case DeviceProfilerDrawcallType::eDrawIndirectCount:
         case DeviceProfilerDrawcallType::eDrawIndexedIndirectCount: {
-            DeviceProfilerDrawcallDrawIndirectCountPayload& payload = drawcall.m_Payload.m_DrawIndirectCount;
-            const size_t indirectPayloadSize = sizeof( uint32_t ) + payload.m_MaxDrawCount * payload.m_Stride;
-
-            IndirectArgumentBuffer& buffer = AcquireIndirectArgumentBuffer( indirectPayloadSize );
-            payload.m_IndirectCountOffset = buffer.m_Offset;
-            payload.m_IndirectArgsOffset = buffer.m_Offset + sizeof( uint32_t );
-            buffer.m_Offset += indirectPayloadSize;
-
-            IndirectArgumentBufferCopy& countCopy = buffer.m_PendingCopyList.emplace_back();
-            countCopy.m_SrcBuffer = payload.m_CountBuffer;
-            countCopy.m_DstBuffer = buffer.m_Buffer;
-            countCopy.m_Region.srcOffset = payload.m_CountOffset;
-            countCopy.m_Region.dstOffset = payload.m_IndirectCountOffset;
-            countCopy.m_Region.size = sizeof( uint32_t );
-
-            IndirectArgumentBufferCopy& argsCopy = buffer.m_PendingCopyList.emplace_back();
-            argsCopy.m_SrcBuffer = payload.m_Buffer;
-            argsCopy.m_DstBuffer = buffer.m_Buffer;
-            argsCopy.m_Region.srcOffset = payload.m_Offset;
-            argsCopy.m_Region.dstOffset = payload.m_IndirectArgsOffset;
-            argsCopy.m_Region.size = indirectPayloadSize;
-
+            const DeviceProfilerDrawcallDrawIndirectCountPayload& payload = drawcall.m_Payload.m_DrawIndirectCount;
+            regionIndex = SaveIndirectCountArgsRegion(
+                payload.m_Buffer,
+                payload.m_Offset,
+                payload.m_CountBuffer,
+                payload.m_CountOffset,
+                payload.m_MaxDrawCount,
+                payload.m_Stride );
             break;
         }
 
         case DeviceProfilerDrawcallType::eDispatchIndirect: {
-            DeviceProfilerDrawcallDispatchIndirectPayload& payload = drawcall.m_Payload.m_DispatchIndirect;
-            const size_t indirectPayloadSize = sizeof( VkDispatchIndirectCommand );
+            const DeviceProfilerDrawcallDispatchIndirectPayload& payload = drawcall.m_Payload.m_DispatchIndirect;
+            regionIndex = SaveIndirectArgsRegion(
+                payload.m_Buffer,
+                payload.m_Offset,
+                sizeof( VkDispatchIndirectCommand ) );
+            break;
+        }
 
-            IndirectArgumentBuffer& buffer = AcquireIndirectArgumentBuffer( indirectPayloadSize );
-            payload.m_IndirectArgsOffset = buffer.m_Offset;
-            buffer.m_Offset += indirectPayloadSize;
+        default:
+            return;
+        }
 
-            IndirectArgumentBufferCopy& copy = buffer.m_PendingCopyList.emplace_back();
-            copy.m_SrcBuffer = payload.m_Buffer;
-            copy.m_DstBuffer = buffer.m_Buffer;
-            copy.m_Region.srcOffset = payload.m_Offset;
-            copy.m_Region.dstOffset = payload.m_IndirectArgsOffset;
-            copy.m_Region.size = indirectPayloadSize;
+        // Offsets in the payload are known after the data is read back.
+        IndirectArgumentDrawcall& indirectArgumentDrawcall = m_IndirectArgumentDrawcalls.emplace_back();
+        indirectArgumentDrawcall.m_pDrawcall = &drawcall;
+        indirectArgumentDrawcall.m_RegionIndex = regionIndex;
+    }
 
-            break;
+    /***********************************************************************************\
+
+    Function:
+        SaveIndirectArgsRegion
+
+    Description:
+        Schedule a copy of a fixed-size indirect argument range to the readback buffer.
+        Returns index of the captured region.
+
+        Commands reading the same range before the next flush share the region, because
+        all pending copies are executed at the same point in the command buffer.
+
+    \***********************************************************************************/
+    size_t ProfilerCommandBuffer::SaveIndirectArgsRegion( VkBuffer buffer, VkDeviceSize offset, size_t size )
+    {
+        const IndirectArgumentRegionKey key( buffer, offset, VK_NULL_HANDLE, 0, size, 0 );
+
+        auto pendingRegionIt = m_PendingIndirectArgumentRegions.find( key );
+        if( pendingRegionIt != m_PendingIndirectArgumentRegions.end() )
+        {
+            return pendingRegionIt->second;
         }
+
+        IndirectArgumentBuffer& indirectArgumentBuffer = AcquireIndirectArgumentBuffer( size, false /*staging*/ );
+
+        const size_t regionIndex = m_IndirectArgumentRegions.size();
+        IndirectArgumentRegion& region = m_IndirectArgumentRegions.emplace_back();
+        region.m_pBuffer = &indirectArgumentBuffer;
+        region.m_Offset = indirectArgumentBuffer.m_Offset;
+        region.m_Size = size;
+        region.m_Stride = 0;
+        region.m_PayloadOffset = 0;
+        region.m_PayloadSize = 0;
+
+        indirectArgumentBuffer.m_Offset += size;
+
+        if( size > 0 )
+        {
+            IndirectArgumentBufferCopy& copy = indirectArgumentBuffer.m_PendingCopyList.emplace_back();
+            copy.m_SrcBuffer = buffer;
+            copy.m_DstBuffer = indirectArgumentBuffer.m_Buffer;
+            copy.m_Region.srcOffset = offset;
+            copy.m_Region.dstOffset = region.m_Offset;
+            copy.m_Region.size = size;
         }
+
+        m_PendingIndirectArgumentRegions.emplace( key, regionIndex );
+
+        return regionIndex;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        SaveIndirectCountArgsRegion
+
+    Description:
+        Schedule a copy of the draw count and indirect arguments of a
+        vkCmdDraw*IndirectCount command. Returns index of the captured region.
+
+        If possible, the data is copied to the device-local staging buffer, from which
+        only the draws below the captured count are copied to the readback buffer at
+        the end of the command buffer. Otherwise, all arguments up to the max draw count
+        are copied to the readback buffer.
+
+    \***********************************************************************************/
+    size_t ProfilerCommandBuffer::SaveIndirectCountArgsRegion( VkBuffer buffer, VkDeviceSize offset, VkBuffer countBuffer, VkDeviceSize countOffset, uint32_t maxDrawCount, uint32_t stride )
+    {
+        const size_t argsSize = static_cast<size_t>( maxDrawCount ) * stride;
+        const size_t size = sizeof( uint32_t ) + argsSize;
+
+        const IndirectArgumentRegionKey key( buffer, offset, countBuffer, countOffset, size, stride );
+
+        auto pendingRegionIt = m_PendingIndirectArgumentRegions.find( key );
+        if( pendingRegionIt != m_PendingIndirectArgumentRegions.end() )
+        {
+            return pendingRegionIt->second;
+        }
+
+        const bool compact =
+            ( m_CompactIndirectArguments ) &&
+            ( size <= m_Profiler.m_IndirectArgumentCompactor.GetMaxBufferSize() );
+
+        IndirectArgumentBuffer& indirectArgumentBuffer = AcquireIndirectArgumentBuffer( size, compact );
+
+        const VkBuffer dstBuffer = ( indirectArgumentBuffer.m_StagingBuffer != VK_NULL_HANDLE )
+            ? indirectArgumentBuffer.m_StagingBuffer
+            : indirectArgumentBuffer.m_Buffer;
+
+        const size_t regionIndex = m_IndirectArgumentRegions.size();
+        IndirectArgumentRegion& region = m_IndirectArgumentRegions.emplace_back();
+        region.m_pBuffer = &indirectArgumentBuffer;
+        region.m_Offset = indirectArgumentBuffer.m_Offset;
+        region.m_Size = size;
+        region.m_Stride = stride;
+        region.m_PayloadOffset = 0;
+        region.m_PayloadSize = 0;
+
+        indirectArgumentBuffer.m_Offset += size;
+
+        IndirectArgumentBufferCopy& countCopy = indirectArgumentBuffer.m_PendingCopyList.emplace_back();
+        countCopy.m_SrcBuffer = countBuffer;
+        countCopy.m_DstBuffer = dstBuffer;
+        countCopy.m_Region.srcOffset = countOffset;
+        countCopy.m_Region.dstOffset = region.m_Offset;
+        countCopy.m_Region.size = sizeof( uint32_t );
+
+        if( argsSize > 0 )
+        {
+            IndirectArgumentBufferCopy& argsCopy = indirectArgumentBuffer.m_PendingCopyList.emplace_back();
+            argsCopy.m_SrcBuffer = buffer;
+            argsCopy.m_DstBuffer = dstBuffer;
+            argsCopy.m_Region.srcOffset = offset;
+            argsCopy.m_Region.dstOffset = region.m_Offset + sizeof( uint32_t );
+            argsCopy.m_Region.size = argsSize;
+        }
+
+        if( dstBuffer == indirectArgumentBuffer.m_StagingBuffer )
+        {
+            indirectArgumentBuffer.m_CompactionList.push_back(
+                DeviceProfilerIndirectArgumentCompactor::GetCompactionRegion( region.m_Offset, maxDrawCount, stride ) );
+        }
+
+        m_PendingIndirectArgumentRegions.emplace( key, regionIndex );
+
+        return regionIndex;
     }
 
     /***********************************************************************************\
@@ -1830,14 +2438,17 @@ namespace Profiler
         {
             while( !indirectArgumentBuffer.m_PendingCopyList.empty() )
             {
-                // Batch copies to the same buffer to save CPU cycles in the driver.
+                // Batch copies between the same buffers to save CPU cycles in the driver.
                 VkBuffer srcBuffer = VK_NULL_HANDLE;
+                VkBuffer dstBuffer = VK_NULL_HANDLE;
 
                 auto firstCopy = indirectArgumentBuffer.m_PendingCopyList.begin();
                 auto lastCopy = indirectArgumentBuffer.m_PendingCopyList.end();
                 while( ( srcBuffer == VK_NULL_HANDLE ) && ( firstCopy != lastCopy ) )
                 {
-                    srcBuffer = ( firstCopy++ )->m_SrcBuffer;
+                    srcBuffer = firstCopy->m_SrcBuffer;
+                    dstBuffer = firstCopy->m_DstBuffer;
+                    firstCopy++;
                 }
 
                 if( srcBuffer == VK_NULL_HANDLE )
@@ -1847,10 +2458,10 @@ namespace Profiler
                     continue;
                 }
 
-                // Find all regions that copy from the same source buffer.
+                // Find all regions that copy from the same source buffer to the same destination buffer.
                 for( auto it = firstCopy - 1; it != lastCopy; ++it )
                 {
-                    if( it->m_SrcBuffer == srcBuffer )
+                    if( ( it->m_SrcBuffer == srcBuffer ) && ( it->m_DstBuffer == dstBuffer ) )
                     {
                         bufferCopyRegions.push_back( it->m_Region );
                         it->m_SrcBuffer = VK_NULL_HANDLE;
@@ -1861,13 +2472,69 @@ namespace Profiler
                 m_Profiler.m_pDevice->Callbacks.CmdCopyBuffer(
                     m_CommandBuffer,
                     srcBuffer,
-                    indirectArgumentBuffer.m_Buffer,
+                    dstBuffer,
                     static_cast<uint32_t>( bufferCopyRegions.size() ),
                     bufferCopyRegions.data() );
 
                 bufferCopyRegions.clear();
             }
         }
+
+        // Ranges read by the next commands may be modified by the application after this point.
+        m_PendingIndirectArgumentRegions.clear();
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        CompactIndirectArgumentBuffers
+
+    Description:
+        Record dispatches copying the live indirect count arguments from the staging
+        buffers to the readback buffers.
+
+    \***********************************************************************************/
+    void ProfilerCommandBuffer::CompactIndirectArgumentBuffers()
+    {
+        const bool compactionPending = std::any_of(
+            m_IndirectArgumentBufferList.begin(),
+            m_IndirectArgumentBufferList.end(),
+            []( const IndirectArgumentBuffer& buffer ) { return !buffer.m_CompactionList.empty(); } );
+
+        if( !compactionPending )
+        {
+            return;
+        }
+
+        // Make the captured arguments visible to the compaction shader.
+        VkMemoryBarrier memoryBarrier = {};
+        memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+        m_Profiler.m_pDevice->Callbacks.CmdPipelineBarrier(
+            m_CommandBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0,
+            1, &memoryBarrier,
+            0, nullptr,
+            0, nullptr );
+
+        const DeviceProfilerIndirectArgumentCompactor& compactor = m_Profiler.m_IndirectArgumentCompactor;
+        compactor.BindPipeline( m_CommandBuffer );
+
+        for( const IndirectArgumentBuffer& indirectArgumentBuffer : m_IndirectArgumentBufferList )
+        {
+            if( !indirectArgumentBuffer.m_CompactionList.empty() )
+            {
+                compactor.Compact(
+                    m_CommandBuffer,
+                    indirectArgumentBuffer.m_CompactionDescriptorSet,
+                    static_cast<uint32_t>( indirectArgumentBuffer.m_CompactionList.size() ),
+                    indirectArgumentBuffer.m_CompactionList.data() );
+            }
+        }
     }
 
     /***********************************************************************************\
@@ -1876,22 +2543,83 @@ namespace Profiler
         ReadIndirectArgumentBuffers
 
     Description:
-        Copy captured indirect buffers to the destination buffer.
+        Copy captured indirect arguments to the destination buffer and update offsets
+        of the payloads in the drawcalls.
+
+        Only the draws below the captured count are copied for vkCmdDraw*IndirectCount
+        commands, so the payload may be much smaller than the readback buffers.
 
     \***********************************************************************************/
     void ProfilerCommandBuffer::ReadIndirectArgumentBuffers( std::vector<uint8_t>& dst )
     {
         for( const IndirectArgumentBuffer& indirectArgumentBuffer : m_IndirectArgumentBufferList )
         {
-            const uint8_t* pIndirectData = static_cast<const uint8_t*>( indirectArgumentBuffer.m_AllocationInfo.pMappedData );
-            const size_t indirectDataSize = indirectArgumentBuffer.m_Offset;
-
-            if( indirectDataSize )
+            if( indirectArgumentBuffer.m_Offset )
             {
+                if( indirectArgumentBuffer.m_AllocationInfo.pMappedData == nullptr )
+                {
+                    // Allocation of the readback buffer has failed.
+                    return;
+                }
+
                 m_Profiler.m_MemoryManager.Invalidate( indirectArgumentBuffer.m_Allocation );
-                dst.insert( dst.end(),
-                    pIndirectData,
-                    pIndirectData + indirectDataSize );
+            }
+        }
+
+        // Compute the layout of the payload.
+        size_t payloadSize = 0;
+
+        for( IndirectArgumentRegion& region : m_IndirectArgumentRegions )
+        {
+            region.m_PayloadOffset = payloadSize;
+            region.m_PayloadSize = region.m_Size;
+
+            if( region.m_Stride != 0 )
+            {
+                const uint8_t* pIndirectData = static_cast<const uint8_t*>( region.m_pBuffer->m_AllocationInfo.pMappedData ) + region.m_Offset;
+                region.m_PayloadSize = DeviceProfilerIndirectArgumentCompactor::GetCompactedRegionSize( pIndirectData, region.m_Size, region.m_Stride );
+            }
+
+            payloadSize += region.m_PayloadSize;
+        }
+
+        dst.resize( payloadSize );
+
+        for( const IndirectArgumentRegion& region : m_IndirectArgumentRegions )
+        {
+            const uint8_t* pIndirectData = static_cast<const uint8_t*>( region.m_pBuffer->m_AllocationInfo.pMappedData ) + region.m_Offset;
+            memcpy( dst.data() + region.m_PayloadOffset, pIndirectData, region.m_PayloadSize );
+
+            if( region.m_Stride != 0 )
+            {
+                // Store the clamped draw count, which may differ if the arguments were not compacted.
+                const uint32_t drawCount = static_cast<uint32_t>( ( region.m_PayloadSize - sizeof( uint32_t ) ) / region.m_Stride );
+                memcpy( dst.data() + region.m_PayloadOffset, &drawCount, sizeof( drawCount ) );
+            }
+        }
+
+        // Point the drawcalls to their arguments in the payload.
+        for( const IndirectArgumentDrawcall& indirectArgumentDrawcall : m_IndirectArgumentDrawcalls )
+        {
+            DeviceProfilerDrawcall& drawcall = *indirectArgumentDrawcall.m_pDrawcall;
+            const IndirectArgumentRegion& region = m_IndirectArgumentRegions[ indirectArgumentDrawcall.m_RegionIndex ];
+
+            switch( drawcall.m_Type )
+            {
+            case DeviceProfilerDrawcallType::eDrawIndirect:
+            case DeviceProfilerDrawcallType::eDrawIndexedIndirect:
+                drawcall.m_Payload.m_DrawIndirect.m_IndirectArgsOffset = region.m_PayloadOffset;
+                break;
+
+            case DeviceProfilerDrawcallType::eDrawIndirectCount:
+            case DeviceProfilerDrawcallType::eDrawIndexedIndirectCount:
+                drawcall.m_Payload.m_DrawIndirectCount.m_IndirectCountOffset = region.m_PayloadOffset;
+                drawcall.m_Payload.m_DrawIndirectCount.m_IndirectArgsOffset = region.m_PayloadOffset + sizeof( uint32_t );
+                break;
+
+            case DeviceProfilerDrawcallType::eDispatchIndirect:
+                drawcall.m_Payload.m_DispatchIndirect.m_IndirectArgsOffset = region.m_PayloadOffset;
+                break;
             }
         }
     }
@@ -1903,15 +2631,24 @@ namespace Profiler
 
     Description:
         Get a buffer for storing indirect argument data.
+        If staging is requested, tries to get a buffer with a staging buffer for the
+        compaction of the indirect count arguments.
 
     \***********************************************************************************/
-    ProfilerCommandBuffer::IndirectArgumentBuffer& ProfilerCommandBuffer::AcquireIndirectArgumentBuffer( size_t size )
+    ProfilerCommandBuffer::IndirectArgumentBuffer& ProfilerCommandBuffer::AcquireIndirectArgumentBuffer( size_t size, bool staging )
     {
         // Check for an existing buffer in the list.
         for( IndirectArgumentBuffer& buffer : m_IndirectArgumentBufferList )
         {
-            if( buffer.m_AllocationInfo.size - buffer.m_Offset >= size )
+            if( ( buffer.m_AllocationInfo.size - buffer.m_Offset >= size ) &&
+                ( !staging || ( buffer.m_AllocationInfo.size <= m_Profiler.m_IndirectArgumentCompactor.GetMaxBufferSize() ) ) )
             {
+                if( staging && ( buffer.m_StagingBuffer == VK_NULL_HANDLE ) )
+                {
+                    // Fallback to the copy to the readback buffer if the staging buffer can't be created.
+                    CreateIndirectArgumentStagingBuffer( buffer );
+                }
+
                 return buffer;
             }
         }
@@ -1922,20 +2659,142 @@ namespace Profiler
         bufferCreateInfo.size = std::max<size_t>( size, PROFILER_INDIRECT_ARGS_BUFFER_SIZE );
         bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
 
+        if( m_Profiler.m_IndirectArgumentCompactor.IsAvailable() )
+        {
+            // The buffer may be a destination of the compaction shader.
+            bufferCreateInfo.usage |= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+        }
+
         VmaAllocationCreateInfo allocationCreateInfo = {};
         allocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
         allocationCreateInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT;
 
         IndirectArgumentBuffer& buffer = m_IndirectArgumentBufferList.emplace_back();
-        m_Profiler.m_MemoryManager.AllocateBuffer(
+        VkResult result = m_Profiler.m_MemoryManager.AllocateBuffer(
             bufferCreateInfo,
             allocationCreateInfo,
             &buffer.m_Buffer,
             &buffer.m_Allocation,
             &buffer.m_AllocationInfo );
 
+        if( result == VK_SUCCESS )
+        {
+            m_Profiler.m_Overhead.AddGpuMemory( DeviceProfilerGpuMemoryOverheadCategory::eIndirectArguments,
+                static_cast<int64_t>( buffer.m_AllocationInfo.size ) );
+        }
+
         buffer.m_Offset = 0;
+        buffer.m_StagingBuffer = VK_NULL_HANDLE;
+        buffer.m_StagingAllocation = VK_NULL_HANDLE;
+        buffer.m_CompactionDescriptorPool = VK_NULL_HANDLE;
+        buffer.m_CompactionDescriptorSet = VK_NULL_HANDLE;
+
+        if( staging )
+        {
+            CreateIndirectArgumentStagingBuffer( buffer );
+        }
 
         return buffer;
     }
+
+    /***********************************************************************************\
+
+    Function:
+        CreateIndirectArgumentStagingBuffer
+
+    Description:
+        Create a device-local buffer for the indirect count arguments, which are
+        compacted into the readback buffer at the end of the command buffer.
+
+    \***********************************************************************************/
+    VkResult ProfilerCommandBuffer::CreateIndirectArgumentStagingBuffer( IndirectArgumentBuffer& buffer )
+    {
+        if( buffer.m_Buffer == VK_NULL_HANDLE )
+        {
+            return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+        }
+
+        VkBufferCreateInfo bufferCreateInfo = {};
+        bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferCreateInfo.size = buffer.m_AllocationInfo.size;
+        bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+
+        VmaAllocationCreateInfo allocationCreateInfo = {};
+        allocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+
+        VkResult result = m_Profiler.m_MemoryManager.AllocateBuffer(
+            bufferCreateInfo,
+            allocationCreateInfo,
+            &buffer.m_StagingBuffer,
+            &buffer.m_StagingAllocation );
+
+        if( result == VK_SUCCESS )
+        {
+            result = m_Profiler.m_IndirectArgumentCompactor.AllocateDescriptorSet(
+                buffer.m_StagingBuffer,
+                buffer.m_Buffer,
+                &buffer.m_CompactionDescriptorPool,
+                &buffer.m_CompactionDescriptorSet );
+        }
+
+        if( result == VK_SUCCESS )
+        {
+            m_Profiler.m_Overhead.AddGpuMemory( DeviceProfilerGpuMemoryOverheadCategory::eIndirectArguments,
+                static_cast<int64_t>( bufferCreateInfo.size ) );
+        }
+
+        if( result != VK_SUCCESS )
+        {
+            if( buffer.m_StagingBuffer != VK_NULL_HANDLE )
+            {
+                m_Profiler.m_MemoryManager.FreeBuffer(
+                    buffer.m_StagingBuffer,
+                    buffer.m_StagingAllocation );
+            }
+
+            buffer.m_StagingBuffer = VK_NULL_HANDLE;
+            buffer.m_StagingAllocation = VK_NULL_HANDLE;
+        }
+
+        return result;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        FreeIndirectArgumentBuffer
+
+    Description:
+        Release resources of the indirect argument buffer.
+
+    \***********************************************************************************/
+    void ProfilerCommandBuffer::FreeIndirectArgumentBuffer( IndirectArgumentBuffer& buffer )
+    {
+        if( buffer.m_CompactionDescriptorSet != VK_NULL_HANDLE )
+        {
+            m_Profiler.m_IndirectArgumentCompactor.FreeDescriptorSet(
+                buffer.m_CompactionDescriptorPool,
+                buffer.m_CompactionDescriptorSet );
+        }
+
+        if( buffer.m_StagingBuffer != VK_NULL_HANDLE )
+        {
+            m_Profiler.m_MemoryManager.FreeBuffer(
+                buffer.m_StagingBuffer,
+                buffer.m_StagingAllocation );
+
+            m_Profiler.m_Overhead.AddGpuMemory( DeviceProfilerGpuMemoryOverheadCategory::eIndirectArguments,
+                -static_cast<int64_t>( buffer.m_AllocationInfo.size ) );
+        }
+
+        if( buffer.m_Buffer != VK_NULL_HANDLE )
+        {
+            m_Profiler.m_MemoryManager.FreeBuffer(
+                buffer.m_Buffer,
+                buffer.m_Allocation );
+
+            m_Profiler.m_Overhead.AddGpuMemory( DeviceProfilerGpuMemoryOverheadCategory::eIndirectArguments,
+                -static_cast<int64_t>( buffer.m_AllocationInfo.size ) );
+        }
+    }
 }
@@ -22,8 +22,13 @@
 #include "profiler_command_buffer_query_pool.h"
 #include "profiler_data.h"
 #include "profiler_counters.h"
+#include "profiler_indirect_arguments.h"
 #include <vulkan/vk_layer.h>
 #include <vk_mem_alloc.h>
+#include <list>
+#include <map>
+#include <memory>
+#include <tuple>
 #include <vector>
 #include <unordered_set>
 
@@ -54,8 +59,6 @@ namespace Profiler
         DeviceProfilerCommandPool& GetCommandPool() const;
         VkCommandBuffer GetHandle() const;
 
-        void Submit();
-
         void Begin( const VkCommandBufferBeginInfo* );
         void End();
 
@@ -79,6 +82,8 @@ namespace Profiler
         void PreCommand( const DeviceProfilerDrawcall& );
         void PostCommand( const DeviceProfilerDrawcall& );
         void ExecuteCommands( uint32_t, const VkCommandBuffer* );
+        void BeginQuery( VkQueryType );
+        void EndQuery( VkQueryType );
         void PipelineBarrier(
             uint32_t, const VkMemoryBarrier*,
             uint32_t, const VkBufferMemoryBarrier*,
@@ -90,7 +95,7 @@ namespace Profiler
 
         const std::unordered_set<ProfilerCommandBuffer*>& GetSecondaryCommandBuffers() const;
 
-        const DeviceProfilerCommandBufferData& GetData( DeviceProfilerQueryDataBufferReader& );
+        DeviceProfilerCommandBufferDataPtr GetData( DeviceProfilerQueryDataBufferReader& );
 
     protected:
         DeviceProfiler&                     m_Profiler;
@@ -101,12 +106,19 @@ namespace Profiler
 
         bool                                m_ProfilingEnabled;
 
+        // Pipeline statistics are not collected while the application's pipeline statistics query is active.
+        bool                                m_PipelineStatisticsSuspended;
+
+        // CPU timestamp of the beginning of the recording.
+        uint64_t                            m_RecordingBeginTimestamp;
+
         std::unordered_set<ProfilerCommandBuffer*> m_pSecondaryCommandBuffers;
 
         CommandBufferQueryPool*             m_pQueryPool;
 
         DeviceProfilerDrawcallStats         m_Stats;
-        DeviceProfilerCommandBufferData     m_Data;
+        // Shared with the frames after the data is resolved.
+        std::shared_ptr<DeviceProfilerCommandBufferData> m_pData;
 
         DeviceProfilerRenderPass*           m_pCurrentRenderPass;
         DeviceProfilerRenderPassData*       m_pCurrentRenderPassData;
@@ -114,7 +126,21 @@ namespace Profiler
         DeviceProfilerPipelineData*         m_pCurrentPipelineData;
         DeviceProfilerDrawcall*             m_pCurrentDrawcallData;
 
+        struct DrawcallTimestampIndices
+        {
+            uint64_t m_BeginIndex = UINT64_MAX;
+            uint64_t m_EndIndex = UINT64_MAX;
+        };
+
+        // Timestamp query indices of the drawcalls in recording order.
+        // Kept outside of the frame data, because they are needed only to resolve the drawcalls.
+        std::vector<DrawcallTimestampIndices> m_DrawcallTimestampIndices;
+
         uint32_t                            m_CurrentSubpassIndex;
+        uint32_t                            m_CurrentViewMask;
+
+        uint32_t                            m_DrawcallSamplingOffset;
+        uint32_t                            m_DrawcallSamplingIndex;
 
         DeviceProfilerPipeline              m_GraphicsPipeline;
         DeviceProfilerPipeline              m_ComputePipeline;
@@ -134,13 +160,45 @@ namespace Profiler
             VmaAllocationInfo               m_AllocationInfo;
             size_t                          m_Offset;
             std::vector<IndirectArgumentBufferCopy> m_PendingCopyList;
+
+            // Device-local copy of vkCmdDraw*IndirectCount arguments, compacted into m_Buffer
+            // at the end of the command buffer.
+            VkBuffer                        m_StagingBuffer;
+            VmaAllocation                   m_StagingAllocation;
+            VkDescriptorPool                m_CompactionDescriptorPool;
+            VkDescriptorSet                 m_CompactionDescriptorSet;
+            std::vector<DeviceProfilerIndirectArgumentCompactionRegion> m_CompactionList;
         };
 
+        struct IndirectArgumentRegion
+        {
+            const IndirectArgumentBuffer*   m_pBuffer;
+            size_t                          m_Offset;
+            size_t                          m_Size;
+            uint32_t                        m_Stride;
+            size_t                          m_PayloadOffset;
+            size_t                          m_PayloadSize;
+        };
+
+        struct IndirectArgumentDrawcall
+        {
+            DeviceProfilerDrawcall*         m_pDrawcall;
+            size_t                          m_RegionIndex;
+        };
+
+        using IndirectArgumentRegionKey = std::tuple<VkBuffer, VkDeviceSize, VkBuffer, VkDeviceSize, size_t, uint32_t>;
+
         std::list<IndirectArgumentBuffer>   m_IndirectArgumentBufferList;
+        std::vector<IndirectArgumentRegion> m_IndirectArgumentRegions;
+        std::vector<IndirectArgumentDrawcall> m_IndirectArgumentDrawcalls;
+        std::map<IndirectArgumentRegionKey, size_t> m_PendingIndirectArgumentRegions;
+        bool                                m_CompactIndirectArguments;
+        bool                                m_CaptureIndirectArguments;
 
         void PreBeginRenderPassCommonProlog();
         void PreBeginRenderPassCommonEpilog();
 
+        void BeginPipelineStatisticsQuery();
         void EndPipeline();
         void EndSubpass();
         void EndRenderPass();
@@ -150,13 +208,26 @@ namespace Profiler
 
         DeviceProfilerRenderPassType GetRenderPassTypeFromPipelineType( DeviceProfilerPipelineType ) const;
 
+        bool ShouldSampleDrawcall( const DeviceProfilerDrawcall& );
+        void MatchTraceTriggerLabel( const char* );
+
         void ResolveSubpassPipelineData( const DeviceProfilerQueryDataBufferReader&, DeviceProfilerSubpassData&, size_t );
-        void ResolveSubpassSecondaryCommandBufferData( DeviceProfilerQueryDataBufferReader, DeviceProfilerSubpassData&, size_t, size_t, bool&, bool& );
+        void ResolveDrawcallTimestamps( const DeviceProfilerQueryDataBufferReader& );
+        void ResolveSubpassSecondaryCommandBufferData( DeviceProfilerQueryDataBufferReader&, DeviceProfilerSubpassData&, size_t, size_t, bool&, bool& );
+        void ResolveRenderPassPipelineStatistics( const DeviceProfilerQueryDataBufferReader&, DeviceProfilerRenderPassData& );
+
+        void MakeDataWritable( bool preserveContents );
+        void RemapIndirectArgumentDrawcalls( const DeviceProfilerCommandBufferData& src, DeviceProfilerCommandBufferData& dst );
 
         void SaveIndirectArgs( DeviceProfilerDrawcall& drawcall );
+        size_t SaveIndirectArgsRegion( VkBuffer buffer, VkDeviceSize offset, size_t size );
+        size_t SaveIndirectCountArgsRegion( VkBuffer buffer, VkDeviceSize offset, VkBuffer countBuffer, VkDeviceSize countOffset, uint32_t maxDrawCount, uint32_t stride );
         void FlushIndirectArgumentCopyLists();
+        void CompactIndirectArgumentBuffers();
         void ReadIndirectArgumentBuffers( std::vector<uint8_t>& dst );
 
-        IndirectArgumentBuffer& AcquireIndirectArgumentBuffer( size_t size );
+        IndirectArgumentBuffer& AcquireIndirectArgumentBuffer( size_t size, bool staging );
+        VkResult CreateIndirectArgumentStagingBuffer( IndirectArgumentBuffer& buffer );
+        void FreeIndirectArgumentBuffer( IndirectArgumentBuffer& buffer );
     };
 }
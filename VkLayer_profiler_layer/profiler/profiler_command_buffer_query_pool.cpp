@@ -49,7 +49,44 @@ namespace Profiler
         , m_AbsQueryIndex( UINT64_MAX )
         , m_PerformanceQueryPool( VK_NULL_HANDLE )
         , m_PerformanceQueryMetricsSetIndex( UINT32_MAX )
+        , m_PipelineStatisticsQueryPools( 0 )
+        , m_PipelineStatisticsQueryPoolSize( 4096 )
+        , m_CurrentPipelineStatisticsQueryPoolIndex( 0 )
+        , m_CurrentPipelineStatisticsQueryCount( 0 )
+        , m_PipelineStatisticsFlags( 0 )
+        , m_ActivePipelineStatisticsQueryPool( VK_NULL_HANDLE )
+        , m_ActivePipelineStatisticsQueryIndex( 0 )
     {
+        // Collect pipeline statistics only if the feature has been enabled on the device.
+        if( m_Profiler.m_Config.m_EnablePipelineStatistics &&
+            m_Device.EnabledFeatures.PipelineStatisticsQuery )
+        {
+            const VkQueueFlags queueFlags =
+                m_Device.pPhysicalDevice->QueueFamilyProperties[ queueFamilyIndex ].queueFlags;
+
+            // Graphics statistics can be queried only in command buffers submitted to graphics queues
+            // and the compute statistic only in compute-capable queues (VUID-vkCmdBeginQuery-queryType-00804/00805).
+            if( queueFlags & VK_QUEUE_GRAPHICS_BIT )
+            {
+                m_PipelineStatisticsFlags |=
+                    VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT |
+                    VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+                    VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+                    VK_QUERY_PIPELINE_STATISTIC_GEOMETRY_SHADER_INVOCATIONS_BIT |
+                    VK_QUERY_PIPELINE_STATISTIC_GEOMETRY_SHADER_PRIMITIVES_BIT |
+                    VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT |
+                    VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+                    VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT |
+                    VK_QUERY_PIPELINE_STATISTIC_TESSELLATION_CONTROL_SHADER_PATCHES_BIT |
+                    VK_QUERY_PIPELINE_STATISTIC_TESSELLATION_EVALUATION_SHADER_INVOCATIONS_BIT;
+            }
+
+            if( queueFlags & VK_QUEUE_COMPUTE_BIT )
+            {
+                m_PipelineStatisticsFlags |=
+                    VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
+            }
+        }
     }
 
     /***********************************************************************************\
@@ -63,6 +100,12 @@ namespace Profiler
     \***********************************************************************************/
     CommandBufferQueryPool::~CommandBufferQueryPool()
     {
+        m_Profiler.m_Overhead.AddGpuMemory( DeviceProfilerGpuMemoryOverheadCategory::eQueryPools,
+            -static_cast<int64_t>( m_QueryPools.size() * GetTimestampQueryPoolMemorySize() ) );
+
+        m_Profiler.m_Overhead.AddGpuMemory( DeviceProfilerGpuMemoryOverheadCategory::eQueryPools,
+            -static_cast<int64_t>( m_PipelineStatisticsQueryPools.size() * GetPipelineStatisticsQueryPoolMemorySize() ) );
+
         for( VkQueryPool queryPool : m_QueryPools )
         {
             m_Device.Callbacks.DestroyQueryPool(
@@ -78,6 +121,14 @@ namespace Profiler
                 m_PerformanceQueryPool,
                 nullptr );
         }
+
+        for( VkQueryPool queryPool : m_PipelineStatisticsQueryPools )
+        {
+            m_Device.Callbacks.DestroyQueryPool(
+                m_Device.Handle,
+                queryPool,
+                nullptr );
+        }
     }
 
     /***********************************************************************************\
@@ -111,6 +162,38 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Function:
+        GetPipelineStatisticsQueryCount
+
+    Description:
+        Returns total number of pipeline statistics queries reserved by this query pool.
+        Includes queries skipped at the end of the pools and additional queries used by
+        multiview render passes.
+
+    \***********************************************************************************/
+    uint64_t CommandBufferQueryPool::GetPipelineStatisticsQueryCount() const
+    {
+        return (static_cast<uint64_t>( m_CurrentPipelineStatisticsQueryPoolIndex ) * m_PipelineStatisticsQueryPoolSize) +
+            m_CurrentPipelineStatisticsQueryCount;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        GetPipelineStatisticsFlags
+
+    Description:
+        Returns set of statistics collected by the pipeline statistics queries, or 0 if
+        pipeline statistics are not collected in this command buffer.
+
+    \***********************************************************************************/
+    VkQueryPipelineStatisticFlags CommandBufferQueryPool::GetPipelineStatisticsFlags() const
+    {
+        return m_PipelineStatisticsFlags;
+    }
+
+    /***********************************************************************************\
+
     Function:
         GetRequiredBufferSize
 
@@ -122,7 +205,8 @@ namespace Profiler
     {
         // Performance query report doesn't have to be included in the reported size,
         // beacuse the data can't be copied on the GPU.
-        return GetTimestampQueryCount() * sizeof( uint64_t );
+        return (GetTimestampQueryCount() * sizeof( uint64_t )) +
+            (GetPipelineStatisticsQueryCount() * BitCount( m_PipelineStatisticsFlags ) * sizeof( uint64_t ));
     }
 
     /***********************************************************************************\
@@ -146,6 +230,14 @@ namespace Profiler
         {
             AllocateQueryPool( commandBuffer );
         }
+
+        if( (m_PipelineStatisticsFlags != 0) &&
+            ((m_PipelineStatisticsQueryPools.empty()) ||
+                ((m_CurrentPipelineStatisticsQueryPoolIndex + 1 == m_PipelineStatisticsQueryPools.size()) &&
+                    (m_CurrentPipelineStatisticsQueryCount >= (m_PipelineStatisticsQueryPoolSize * 0.8f)))) )
+        {
+            AllocatePipelineStatisticsQueryPool( commandBuffer );
+        }
     }
 
     /***********************************************************************************\
@@ -182,6 +274,27 @@ namespace Profiler
         m_AbsQueryIndex = UINT64_MAX;
         m_CurrentQueryIndex = UINT32_MAX;
         m_CurrentQueryPoolIndex = 0;
+
+        // Reset the pipeline statistics query pools.
+        for( uint32_t queryPoolIndex = 0; queryPoolIndex < m_CurrentPipelineStatisticsQueryPoolIndex; ++queryPoolIndex )
+        {
+            m_Device.Callbacks.CmdResetQueryPool(
+                commandBuffer,
+                m_PipelineStatisticsQueryPools[ queryPoolIndex ],
+                0, m_PipelineStatisticsQueryPoolSize );
+        }
+
+        if( m_CurrentPipelineStatisticsQueryCount != 0 )
+        {
+            m_Device.Callbacks.CmdResetQueryPool(
+                commandBuffer,
+                m_PipelineStatisticsQueryPools[ m_CurrentPipelineStatisticsQueryPoolIndex ],
+                0, m_CurrentPipelineStatisticsQueryCount );
+        }
+
+        m_CurrentPipelineStatisticsQueryPoolIndex = 0;
+        m_CurrentPipelineStatisticsQueryCount = 0;
+        m_ActivePipelineStatisticsQueryPool = VK_NULL_HANDLE;
     }
 
     /***********************************************************************************\
@@ -246,6 +359,88 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Function:
+        BeginPipelineStatisticsQuery
+
+    Description:
+        Begins collection of pipeline statistics. Returns index to the first query used
+        by the scope, or UINT64_MAX if the statistics are not collected.
+
+        In multiview render passes the query uses one consecutive query per view.
+
+    \***********************************************************************************/
+    uint64_t CommandBufferQueryPool::BeginPipelineStatisticsQuery( VkCommandBuffer commandBuffer, uint32_t viewCount )
+    {
+        assert( m_ActivePipelineStatisticsQueryPool == VK_NULL_HANDLE );
+
+        if( (m_PipelineStatisticsFlags == 0) ||
+            (viewCount > m_PipelineStatisticsQueryPoolSize) )
+        {
+            return UINT64_MAX;
+        }
+
+        const uint32_t previousQueryPoolIndex = m_CurrentPipelineStatisticsQueryPoolIndex;
+        const uint32_t previousQueryCount = m_CurrentPipelineStatisticsQueryCount;
+
+        // All queries used by the scope must be allocated from the same pool.
+        if( (m_CurrentPipelineStatisticsQueryCount + viewCount) > m_PipelineStatisticsQueryPoolSize )
+        {
+            m_CurrentPipelineStatisticsQueryPoolIndex++;
+            m_CurrentPipelineStatisticsQueryCount = 0;
+        }
+
+        if( m_CurrentPipelineStatisticsQueryPoolIndex == m_PipelineStatisticsQueryPools.size() )
+        {
+            AllocatePipelineStatisticsQueryPool( commandBuffer );
+
+            if( m_CurrentPipelineStatisticsQueryPoolIndex == m_PipelineStatisticsQueryPools.size() )
+            {
+                // Allocation failed, restore the previous state.
+                m_CurrentPipelineStatisticsQueryPoolIndex = previousQueryPoolIndex;
+                m_CurrentPipelineStatisticsQueryCount = previousQueryCount;
+                return UINT64_MAX;
+            }
+        }
+
+        const uint64_t queryIndex = GetPipelineStatisticsQueryCount();
+
+        m_ActivePipelineStatisticsQueryPool = m_PipelineStatisticsQueryPools[ m_CurrentPipelineStatisticsQueryPoolIndex ];
+        m_ActivePipelineStatisticsQueryIndex = m_CurrentPipelineStatisticsQueryCount;
+        m_CurrentPipelineStatisticsQueryCount += viewCount;
+
+        m_Device.Callbacks.CmdBeginQuery(
+            commandBuffer,
+            m_ActivePipelineStatisticsQueryPool,
+            m_ActivePipelineStatisticsQueryIndex,
+            0 );
+
+        return queryIndex;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        EndPipelineStatisticsQuery
+
+    Description:
+        Ends the active pipeline statistics query, if any.
+
+    \***********************************************************************************/
+    void CommandBufferQueryPool::EndPipelineStatisticsQuery( VkCommandBuffer commandBuffer )
+    {
+        if( m_ActivePipelineStatisticsQueryPool != VK_NULL_HANDLE )
+        {
+            m_Device.Callbacks.CmdEndQuery(
+                commandBuffer,
+                m_ActivePipelineStatisticsQueryPool,
+                m_ActivePipelineStatisticsQueryIndex );
+
+            m_ActivePipelineStatisticsQueryPool = VK_NULL_HANDLE;
+        }
+    }
+
+    /***********************************************************************************\
+
     Function:
         ResolveTimestampsGpu
 
@@ -270,6 +465,23 @@ namespace Profiler
             writer.WriteTimestampQueryResults( m_QueryPools[ m_CurrentQueryPoolIndex ], m_CurrentQueryIndex + 1 );
         }
 
+        // Copy data from the pipeline statistics query pools.
+        for( uint32_t queryPoolIndex = 0; queryPoolIndex < m_CurrentPipelineStatisticsQueryPoolIndex; ++queryPoolIndex )
+        {
+            writer.WritePipelineStatisticsQueryResults(
+                m_PipelineStatisticsQueryPools[ queryPoolIndex ],
+                m_PipelineStatisticsQueryPoolSize,
+                m_PipelineStatisticsFlags );
+        }
+
+        if( m_CurrentPipelineStatisticsQueryCount != 0 )
+        {
+            writer.WritePipelineStatisticsQueryResults(
+                m_PipelineStatisticsQueryPools[ m_CurrentPipelineStatisticsQueryPoolIndex ],
+                m_CurrentPipelineStatisticsQueryCount,
+                m_PipelineStatisticsFlags );
+        }
+
         // Copy data from the performance query pool.
         if( m_PerformanceQueryPool != VK_NULL_HANDLE )
         {
@@ -359,6 +571,9 @@ namespace Profiler
             assert( queryPool != VK_NULL_HANDLE );
             m_QueryPools.push_back( queryPool );
 
+            m_Profiler.m_Overhead.AddGpuMemory( DeviceProfilerGpuMemoryOverheadCategory::eQueryPools,
+                static_cast<int64_t>( GetTimestampQueryPoolMemorySize() ) );
+
             // Pools must be reset before first use
             m_Device.Callbacks.CmdResetQueryPool( commandBuffer, queryPool, 0, m_QueryPoolSize );
         }
@@ -412,4 +627,74 @@ namespace Profiler
         // Save the metrics set index for post-processing.
         m_PerformanceQueryMetricsSetIndex = activeMetricsSetIndex;
     }
+
+    /***********************************************************************************\
+
+    Function:
+        AllocatePipelineStatisticsQueryPool
+
+    Description:
+        Allocates a new pipeline statistics query pool.
+
+    \***********************************************************************************/
+    void CommandBufferQueryPool::AllocatePipelineStatisticsQueryPool( VkCommandBuffer commandBuffer )
+    {
+        TipGuard tip( m_Profiler.m_pDevice->TIP, __func__ );
+
+        VkQueryPoolCreateInfo queryPoolCreateInfo = {};
+        queryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queryPoolCreateInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+        queryPoolCreateInfo.queryCount = m_PipelineStatisticsQueryPoolSize;
+        queryPoolCreateInfo.pipelineStatistics = m_PipelineStatisticsFlags;
+
+        VkQueryPool queryPool = VK_NULL_HANDLE;
+        VkResult result = m_Device.Callbacks.CreateQueryPool(
+            m_Device.Handle,
+            &queryPoolCreateInfo,
+            nullptr,
+            &queryPool );
+
+        if( result == VK_SUCCESS )
+        {
+            assert( queryPool != VK_NULL_HANDLE );
+            m_PipelineStatisticsQueryPools.push_back( queryPool );
+
+            m_Profiler.m_Overhead.AddGpuMemory( DeviceProfilerGpuMemoryOverheadCategory::eQueryPools,
+                static_cast<int64_t>( GetPipelineStatisticsQueryPoolMemorySize() ) );
+
+            // Pools must be reset before first use
+            m_Device.Callbacks.CmdResetQueryPool( commandBuffer, queryPool, 0, m_PipelineStatisticsQueryPoolSize );
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        GetTimestampQueryPoolMemorySize
+
+    Description:
+        Estimates the device memory used by a timestamp query pool.
+        The actual size is implementation-dependent and is not reported by the driver.
+
+    \***********************************************************************************/
+    uint64_t CommandBufferQueryPool::GetTimestampQueryPoolMemorySize() const
+    {
+        return static_cast<uint64_t>( m_QueryPoolSize ) * sizeof( uint64_t );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        GetPipelineStatisticsQueryPoolMemorySize
+
+    Description:
+        Estimates the device memory used by a pipeline statistics query pool.
+        The actual size is implementation-dependent and is not reported by the driver.
+
+    \***********************************************************************************/
+    uint64_t CommandBufferQueryPool::GetPipelineStatisticsQueryPoolMemorySize() const
+    {
+        return static_cast<uint64_t>( m_PipelineStatisticsQueryPoolSize ) *
+            BitCount( m_PipelineStatisticsFlags ) * sizeof( uint64_t );
+    }
 }
@@ -54,6 +54,8 @@ namespace Profiler
 
         uint32_t GetPerformanceQueryMetricsSetIndex() const;
         uint64_t GetTimestampQueryCount() const;
+        uint64_t GetPipelineStatisticsQueryCount() const;
+        VkQueryPipelineStatisticFlags GetPipelineStatisticsFlags() const;
         uint64_t GetRequiredBufferSize() const;
 
         void PreallocateQueries( VkCommandBuffer commandBuffer );
@@ -63,6 +65,9 @@ namespace Profiler
         void BeginPerformanceQuery( VkCommandBuffer commandBuffer );
         void EndPerformanceQuery( VkCommandBuffer commandBuffer );
 
+        uint64_t BeginPipelineStatisticsQuery( VkCommandBuffer commandBuffer, uint32_t viewCount );
+        void EndPipelineStatisticsQuery( VkCommandBuffer commandBuffer );
+
         void WriteQueryData( DeviceProfilerQueryDataBufferWriter& writer ) const;
 
         uint64_t WriteTimestamp( VkCommandBuffer commandBuffer, VkPipelineStageFlagBits stage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT );
@@ -85,7 +90,20 @@ namespace Profiler
         VkQueryPool                      m_PerformanceQueryPool;
         uint32_t                         m_PerformanceQueryMetricsSetIndex;
 
+        std::vector<VkQueryPool>         m_PipelineStatisticsQueryPools;
+        uint32_t                         m_PipelineStatisticsQueryPoolSize;
+        uint32_t                         m_CurrentPipelineStatisticsQueryPoolIndex;
+        uint32_t                         m_CurrentPipelineStatisticsQueryCount;
+        VkQueryPipelineStatisticFlags    m_PipelineStatisticsFlags;
+
+        VkQueryPool                      m_ActivePipelineStatisticsQueryPool;
+        uint32_t                         m_ActivePipelineStatisticsQueryIndex;
+
         void AllocateQueryPool( VkCommandBuffer commandBuffer );
         void AllocatePerformanceQueryPool();
+        void AllocatePipelineStatisticsQueryPool( VkCommandBuffer commandBuffer );
+
+        uint64_t GetTimestampQueryPoolMemorySize() const;
+        uint64_t GetPipelineStatisticsQueryPoolMemorySize() const;
     };
 }
@@ -36,6 +36,7 @@ namespace Profiler
         : m_CommandPool( commandPool )
         , m_QueueFamilyIndex( createInfo.queueFamilyIndex )
         , m_SupportsTimestampQuery( false )
+        , m_SupportsComputeCommands( false )
     {
         // Get target command queue family properties
         const VkQueueFamilyProperties& queueFamilyProperties =
@@ -53,6 +54,10 @@ namespace Profiler
         {
             m_SupportsTimestampQuery = true;
         }
+
+        // Internal compute passes can be recorded only to the command buffers submitted to the compute queues.
+        m_SupportsComputeCommands =
+            (queueFamilyProperties.queueFlags & VK_QUEUE_COMPUTE_BIT) != 0;
     }
 
     /***********************************************************************************\
@@ -99,6 +104,20 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Function:
+        SupportsComputeCommands
+
+    Description:
+        Checks whether the target command queue supports dispatches.
+
+    \***********************************************************************************/
+    bool DeviceProfilerCommandPool::SupportsComputeCommands() const
+    {
+        return m_SupportsComputeCommands;
+    }
+
+    /***********************************************************************************\
+
     Function:
         DeviceProfilerInternalCommandPool
 
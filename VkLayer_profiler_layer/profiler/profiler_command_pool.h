@@ -43,11 +43,13 @@ namespace Profiler
         VkCommandPool GetHandle() const;
         uint32_t GetQueueFamilyIndex() const;
         bool SupportsTimestampQuery() const;
+        bool SupportsComputeCommands() const;
 
     private:
         VkCommandPool m_CommandPool;
         uint32_t m_QueueFamilyIndex;
         bool m_SupportsTimestampQuery;
+        bool m_SupportsComputeCommands;
     };
 
     /***********************************************************************************\
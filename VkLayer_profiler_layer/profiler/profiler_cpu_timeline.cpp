@@ -0,0 +1,107 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "profiler_cpu_timeline.h"
+#include <algorithm>
+
+namespace Profiler
+{
+    // Maximum number of spans kept for a thread until they are collected.
+    static constexpr size_t MaxSpansPerThread = 16384;
+
+    /***********************************************************************************\
+
+    Function:
+        DeviceProfilerCpuTimeline
+
+    Description:
+        Constructor.
+
+    \***********************************************************************************/
+    DeviceProfilerCpuTimeline::DeviceProfilerCpuTimeline()
+        : m_ThreadBuffers()
+    {
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        Destroy
+
+    Description:
+        Frees the buffers of all threads.
+
+    \***********************************************************************************/
+    void DeviceProfilerCpuTimeline::Destroy()
+    {
+        m_ThreadBuffers.Clear();
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        AppendSpan
+
+    Description:
+        Saves the span in the buffer of the current thread.
+
+        The spans must be appended in order of their end timestamps, which is
+        satisfied if the span ends when it is appended.
+
+    \***********************************************************************************/
+    void DeviceProfilerCpuTimeline::AppendSpan( DeviceProfilerCpuSpanData span )
+    {
+        span.m_ThreadId = m_ThreadBuffers.GetCurrentThreadId();
+
+        ThreadBuffer& threadBuffer = m_ThreadBuffers.GetCurrentThreadBuffer();
+        std::scoped_lock lk( threadBuffer.m_Mutex );
+
+        // Drop the spans if the frames are not resolved.
+        if( threadBuffer.m_Spans.size() < MaxSpansPerThread )
+        {
+            threadBuffer.m_Spans.push_back( span );
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        CollectSpans
+
+    Description:
+        Moves the spans that ended before the given timestamp from the buffers of
+        all threads to the output vector.
+
+    \***********************************************************************************/
+    void DeviceProfilerCpuTimeline::CollectSpans( uint64_t endTimestamp, std::vector<DeviceProfilerCpuSpanData>& spans )
+    {
+        m_ThreadBuffers.ForEachBuffer( [&]( ThreadBuffer& threadBuffer )
+            {
+                std::scoped_lock bufferLock( threadBuffer.m_Mutex );
+                std::vector<DeviceProfilerCpuSpanData>& threadSpans = threadBuffer.m_Spans;
+
+                // Spans of a single thread are ordered by their end timestamps.
+                auto collectedSpansEnd = std::partition_point( threadSpans.begin(), threadSpans.end(),
+                    [&]( const DeviceProfilerCpuSpanData& span ) { return span.m_EndTimestamp <= endTimestamp; } );
+
+                spans.insert( spans.end(), threadSpans.begin(), collectedSpansEnd );
+                threadSpans.erase( threadSpans.begin(), collectedSpansEnd );
+            } );
+    }
+}
@@ -0,0 +1,61 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+#include "profiler_data.h"
+#include "profiler_thread_buffers.h"
+#include <mutex>
+#include <vector>
+
+namespace Profiler
+{
+    /***********************************************************************************\
+
+    Class:
+        DeviceProfilerCpuTimeline
+
+    Description:
+        Collects CPU spans of the command buffer recording and queue submissions on
+        the application threads.
+
+        Each thread appends the spans to its own buffer, so the threads recording
+        command buffers in parallel do not contend for a single lock. The buffers
+        are drained when the frames are resolved.
+
+    \***********************************************************************************/
+    class DeviceProfilerCpuTimeline
+    {
+    public:
+        DeviceProfilerCpuTimeline();
+
+        void Destroy();
+
+        void AppendSpan( DeviceProfilerCpuSpanData span );
+        void CollectSpans( uint64_t endTimestamp, std::vector<DeviceProfilerCpuSpanData>& spans );
+
+    private:
+        struct ThreadBuffer
+        {
+            std::mutex                                  m_Mutex;
+            std::vector<DeviceProfilerCpuSpanData>      m_Spans;
+        };
+
+        DeviceProfilerThreadBuffers<ThreadBuffer>       m_ThreadBuffers;
+    };
+}
@@ -0,0 +1,277 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "profiler_critical_path.h"
+#include "profiler_counters.h"
+#include <algorithm>
+#include <unordered_map>
+
+namespace Profiler
+{
+    /***********************************************************************************\
+
+    Function:
+        DeviceProfilerCriticalPathAnalyzer
+
+    Description:
+        Constructor.
+
+    \***********************************************************************************/
+    DeviceProfilerCriticalPathAnalyzer::DeviceProfilerCriticalPathAnalyzer()
+        : m_TimestampPeriod( 0 )
+    {
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        Initialize
+
+    Description:
+        Sets the period of the GPU timestamps used to correlate them with the CPU
+        submission timestamps.
+
+    \***********************************************************************************/
+    void DeviceProfilerCriticalPathAnalyzer::Initialize( float timestampPeriod )
+    {
+        m_TimestampPeriod = timestampPeriod;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        Destroy
+
+    Description:
+
+    \***********************************************************************************/
+    void DeviceProfilerCriticalPathAnalyzer::Destroy()
+    {
+        m_TimestampPeriod = 0;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        ProcessFrame
+
+    Description:
+        Analyzes dependencies between the submits of the frame and writes the results
+        to the submit data.
+
+        The submits are processed in the order of submission, so all dependencies of
+        a submit are visited before the submit itself.
+
+    \***********************************************************************************/
+    void DeviceProfilerCriticalPathAnalyzer::ProcessFrame( DeviceProfilerFrameData& frameData ) const
+    {
+        frameData.m_SemaphoreDependencies.clear();
+        frameData.m_CriticalPathTicks = 0;
+
+        // CPU submission timestamps can be compared with the GPU timestamps only if calibrated timestamps are available.
+        const DeviceProfilerSynchronizationTimestamps& syncTimestamps = frameData.m_SyncTimestamps;
+        const uint64_t hostTimestampFrequency = ( syncTimestamps.m_HostCalibratedTimestamp != 0 )
+            ? OSGetTimestampFrequency( syncTimestamps.m_HostTimeDomain )
+            : 0;
+
+        const bool hostTimestampsCalibrated =
+            ( hostTimestampFrequency != 0 ) &&
+            ( syncTimestamps.m_DeviceCalibratedTimestamp != 0 ) &&
+            ( m_TimestampPeriod > 0 );
+
+        const double hostToDeviceTicks = hostTimestampsCalibrated
+            ? ( 1'000'000'000.0 / ( hostTimestampFrequency * static_cast<double>( m_TimestampPeriod ) ) )
+            : 0.0;
+
+        std::vector<Node> nodes;
+        std::unordered_map<VkQueueHandle, uint32_t> lastQueueNodes;
+        std::unordered_map<VkSemaphoreHandle, uint32_t> lastSignalNodes;
+        std::vector<uint32_t> predecessors;
+
+        const uint32_t submitBatchCount = static_cast<uint32_t>( frameData.m_Submits.size() );
+        for( uint32_t submitBatchIndex = 0; submitBatchIndex < submitBatchCount; ++submitBatchIndex )
+        {
+            DeviceProfilerSubmitBatchData& submitBatch = frameData.m_Submits[ submitBatchIndex ];
+
+            int64_t submitDeviceTimestamp = 0;
+            if( hostTimestampsCalibrated )
+            {
+                const int64_t hostDelta = static_cast<int64_t>( submitBatch.m_Timestamp - syncTimestamps.m_HostCalibratedTimestamp );
+                submitDeviceTimestamp = static_cast<int64_t>( syncTimestamps.m_DeviceCalibratedTimestamp ) +
+                    static_cast<int64_t>( hostDelta * hostToDeviceTicks );
+            }
+
+            const uint32_t submitCount = static_cast<uint32_t>( submitBatch.m_Submits.size() );
+            for( uint32_t submitIndex = 0; submitIndex < submitCount; ++submitIndex )
+            {
+                DeviceProfilerSubmitData& submit = submitBatch.m_Submits[ submitIndex ];
+                submit.m_IdleTicks = 0;
+                submit.m_IdleReason = DeviceProfilerQueueIdleReason::eNone;
+                submit.m_SlackTicks = 0;
+                submit.m_CriticalPath = false;
+
+                // Collect the submits that must complete before this one can start.
+                predecessors.clear();
+
+                uint32_t queuePredecessor = UINT32_MAX;
+                auto lastQueueNodeIt = lastQueueNodes.find( submitBatch.m_Handle );
+                if( lastQueueNodeIt != lastQueueNodes.end() )
+                {
+                    queuePredecessor = lastQueueNodeIt->second;
+                    predecessors.push_back( queuePredecessor );
+                }
+
+                uint64_t semaphoresSignaledTimestamp = 0;
+                for( const VkSemaphoreHandle& semaphore : submit.m_WaitSemaphores )
+                {
+                    auto lastSignalNodeIt = lastSignalNodes.find( semaphore );
+                    if( lastSignalNodeIt != lastSignalNodes.end() )
+                    {
+                        const Node& signalNode = nodes[ lastSignalNodeIt->second ];
+                        semaphoresSignaledTimestamp = std::max( semaphoresSignaledTimestamp, signalNode.m_EndTimestamp );
+                        predecessors.push_back( lastSignalNodeIt->second );
+                    }
+                }
+
+                const bool hasTimestamps =
+                    ( submit.m_EndTimestamp.m_Value > submit.m_BeginTimestamp.m_Value );
+
+                if( !hasTimestamps )
+                {
+                    // Forward the dependencies of submits without timestamps to the following submits.
+                    if( !predecessors.empty() )
+                    {
+                        const uint32_t lastPredecessor = *std::max_element( predecessors.begin(), predecessors.end(),
+                            [&]( uint32_t left, uint32_t right )
+                            { return nodes[ left ].m_EndTimestamp < nodes[ right ].m_EndTimestamp; } );
+
+                        lastQueueNodes[ submitBatch.m_Handle ] = lastPredecessor;
+                        for( const VkSemaphoreHandle& semaphore : submit.m_SignalSemaphores )
+                        {
+                            lastSignalNodes[ semaphore ] = lastPredecessor;
+                        }
+                    }
+                    continue;
+                }
+
+                const uint32_t nodeIndex = static_cast<uint32_t>( nodes.size() );
+                Node& node = nodes.emplace_back();
+                node.m_Index = { submitBatchIndex, submitIndex };
+                node.m_pSubmit = &submit;
+                node.m_BeginTimestamp = submit.m_BeginTimestamp.m_Value;
+                node.m_EndTimestamp = submit.m_EndTimestamp.m_Value;
+                node.m_Predecessors = predecessors;
+
+                for( const VkSemaphoreHandle& semaphore : submit.m_WaitSemaphores )
+                {
+                    auto lastSignalNodeIt = lastSignalNodes.find( semaphore );
+                    if( lastSignalNodeIt != lastSignalNodes.end() )
+                    {
+                        DeviceProfilerSemaphoreDependencyData& dependency = frameData.m_SemaphoreDependencies.emplace_back();
+                        dependency.m_Semaphore = semaphore;
+                        dependency.m_SignalSubmit = nodes[ lastSignalNodeIt->second ].m_Index;
+                        dependency.m_WaitSubmit = node.m_Index;
+                    }
+                }
+
+                // Classify the gap between the previous submit on the queue and this one.
+                const uint64_t idleBeginTimestamp = ( queuePredecessor != UINT32_MAX )
+                    ? nodes[ queuePredecessor ].m_EndTimestamp
+                    : frameData.m_BeginTimestamp;
+
+                if( node.m_BeginTimestamp > idleBeginTimestamp )
+                {
+                    submit.m_IdleTicks = node.m_BeginTimestamp - idleBeginTimestamp;
+
+                    if( hostTimestampsCalibrated &&
+                        ( submitDeviceTimestamp > static_cast<int64_t>( idleBeginTimestamp ) ) &&
+                        ( submitDeviceTimestamp >= static_cast<int64_t>( semaphoresSignaledTimestamp ) ) )
+                    {
+                        // The submit was recorded after the queue became idle.
+                        submit.m_IdleReason = DeviceProfilerQueueIdleReason::eCpuSubmission;
+                    }
+                    else if( semaphoresSignaledTimestamp > idleBeginTimestamp )
+                    {
+                        // The queue waited for a semaphore signaled by another submit.
+                        submit.m_IdleReason = DeviceProfilerQueueIdleReason::eSemaphoreWait;
+                    }
+                    else if( hostTimestampsCalibrated )
+                    {
+                        // The submit was ready, but the GPU did not start it immediately.
+                        submit.m_IdleReason = DeviceProfilerQueueIdleReason::eStarvation;
+                    }
+                    else
+                    {
+                        submit.m_IdleReason = DeviceProfilerQueueIdleReason::eUnknown;
+                    }
+                }
+
+                lastQueueNodes[ submitBatch.m_Handle ] = nodeIndex;
+                for( const VkSemaphoreHandle& semaphore : submit.m_SignalSemaphores )
+                {
+                    lastSignalNodes[ semaphore ] = nodeIndex;
+                }
+            }
+        }
+
+        if( nodes.empty() )
+        {
+            return;
+        }
+
+        const uint32_t lastNodeIndex = static_cast<uint32_t>( std::max_element( nodes.begin(), nodes.end(),
+            []( const Node& left, const Node& right )
+            { return left.m_EndTimestamp < right.m_EndTimestamp; } ) - nodes.begin() );
+
+        // Propagate the latest allowed end timestamps from the end of the frame back to the first submits.
+        const uint64_t frameEndTimestamp = nodes[ lastNodeIndex ].m_EndTimestamp;
+        for( uint32_t i = static_cast<uint32_t>( nodes.size() ); i > 0; --i )
+        {
+            Node& node = nodes[ i - 1 ];
+            node.m_LatestEndTimestamp = std::max( std::min( node.m_LatestEndTimestamp, frameEndTimestamp ), node.m_EndTimestamp );
+            node.m_pSubmit->m_SlackTicks = node.m_LatestEndTimestamp - node.m_EndTimestamp;
+
+            const uint64_t latestBeginTimestamp = node.m_LatestEndTimestamp - ( node.m_EndTimestamp - node.m_BeginTimestamp );
+            for( uint32_t predecessor : node.m_Predecessors )
+            {
+                nodes[ predecessor ].m_LatestEndTimestamp = std::min( nodes[ predecessor ].m_LatestEndTimestamp, latestBeginTimestamp );
+            }
+        }
+
+        // Follow the last completed dependency of each submit, starting from the last submit in the frame.
+        uint32_t nodeIndex = lastNodeIndex;
+        while( nodeIndex != UINT32_MAX )
+        {
+            const Node& node = nodes[ nodeIndex ];
+            node.m_pSubmit->m_CriticalPath = true;
+            frameData.m_CriticalPathTicks += node.m_EndTimestamp - node.m_BeginTimestamp;
+
+            nodeIndex = UINT32_MAX;
+            for( uint32_t predecessor : node.m_Predecessors )
+            {
+                if( ( nodeIndex == UINT32_MAX ) ||
+                    ( nodes[ predecessor ].m_EndTimestamp > nodes[ nodeIndex ].m_EndTimestamp ) )
+                {
+                    nodeIndex = predecessor;
+                }
+            }
+        }
+    }
+}
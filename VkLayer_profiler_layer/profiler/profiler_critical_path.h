@@ -0,0 +1,68 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include "profiler_data.h"
+
+namespace Profiler
+{
+    /***********************************************************************************\
+
+    Class:
+        DeviceProfilerCriticalPathAnalyzer
+
+    Description:
+        Builds a graph of dependencies between the submits of a frame, using the order
+        of submission on each queue and the semaphores waited and signaled by the submits.
+
+        For each submit, the analyzer computes the slack - time by which the submit could
+        be delayed without delaying the end of the frame - and classifies the idle gap
+        on the queue before the submit. The longest chain of dependent submits ending
+        with the last submit of the frame is marked as the critical path.
+
+        Semaphores are matched by handles, the last submit signaling a semaphore is
+        assumed to satisfy the following waits. Values of timeline semaphores are not
+        tracked.
+
+    \***********************************************************************************/
+    class DeviceProfilerCriticalPathAnalyzer
+    {
+    public:
+        DeviceProfilerCriticalPathAnalyzer();
+
+        void Initialize( float timestampPeriod );
+        void Destroy();
+
+        void ProcessFrame( DeviceProfilerFrameData& frameData ) const;
+
+    private:
+        struct Node
+        {
+            DeviceProfilerSubmitIndex               m_Index = {};
+            DeviceProfilerSubmitData*               m_pSubmit = nullptr;
+            uint64_t                                m_BeginTimestamp = 0;
+            uint64_t                                m_EndTimestamp = 0;
+            uint64_t                                m_LatestEndTimestamp = UINT64_MAX;
+            std::vector<uint32_t>                   m_Predecessors = {};
+        };
+
+        float                                       m_TimestampPeriod;
+    };
+}
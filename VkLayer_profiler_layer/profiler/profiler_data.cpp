@@ -19,6 +19,10 @@
 // SOFTWARE.
 
 #include "profiler_data.h"
+#include "profiler_overhead.h"
+#include <memory>
+#include <mutex>
+#include <new>
 
 template<typename T>
 constexpr size_t GetPNextChainSize( const T* pStructure )
@@ -221,40 +225,6 @@ size_t GetStructureSize( const VkRayTracingPipelineInterfaceCreateInfoKHR* pStru
     return 0;
 }
 
-template<>
-size_t GetStructureSize( const VkGraphicsPipelineCreateInfo* pStructure )
-{
-    if( pStructure != nullptr )
-    {
-        return sizeof( VkGraphicsPipelineCreateInfo ) +
-               GetPNextChainSize( pStructure ) +
-               GetStructureSize( pStructure->pVertexInputState ) +
-               GetStructureSize( pStructure->pInputAssemblyState ) +
-               GetStructureSize( pStructure->pTessellationState ) +
-               GetStructureSize( pStructure->pViewportState ) +
-               GetStructureSize( pStructure->pRasterizationState ) +
-               GetStructureSize( pStructure->pMultisampleState ) +
-               GetStructureSize( pStructure->pDepthStencilState ) +
-               GetStructureSize( pStructure->pColorBlendState ) +
-               GetStructureSize( pStructure->pDynamicState );
-    }
-    return 0;
-}
-
-template<>
-size_t GetStructureSize( const VkRayTracingPipelineCreateInfoKHR* pStructure )
-{
-    if( pStructure != nullptr )
-    {
-        return sizeof( VkRayTracingPipelineCreateInfoKHR ) +
-               GetPNextChainSize( pStructure ) +
-               GetStructureArraySize( pStructure->pGroups, pStructure->groupCount ) +
-               GetStructureSize( pStructure->pLibraryInterface ) +
-               GetStructureSize( pStructure->pDynamicState );
-    }
-    return 0;
-}
-
 template<>
 size_t GetStructureSize( const VkAccelerationStructureGeometryKHR* pStructure )
 {
@@ -369,43 +339,6 @@ void CopyStructureTo( VkRayTracingPipelineInterfaceCreateInfoKHR* pDst, const Vk
     }
 }
 
-template<>
-void CopyStructureTo( VkGraphicsPipelineCreateInfo* pDst, const VkGraphicsPipelineCreateInfo* pSrc, std::byte** ppNext )
-{
-    if( pSrc != nullptr )
-    {
-        memcpy( pDst, pSrc, sizeof( VkGraphicsPipelineCreateInfo ) );
-        pDst->pNext = CopyPNextChain( pSrc->pNext, ppNext );
-        pDst->stageCount = 0;
-        pDst->pStages = nullptr;
-        pDst->pVertexInputState = CopyStructure( pSrc->pVertexInputState, ppNext );
-        pDst->pInputAssemblyState = CopyStructure( pSrc->pInputAssemblyState, ppNext );
-        pDst->pTessellationState = CopyStructure( pSrc->pTessellationState, ppNext );
-        pDst->pViewportState = CopyStructure( pSrc->pViewportState, ppNext );
-        pDst->pRasterizationState = CopyStructure( pSrc->pRasterizationState, ppNext );
-        pDst->pMultisampleState = CopyStructure( pSrc->pMultisampleState, ppNext );
-        pDst->pDepthStencilState = CopyStructure( pSrc->pDepthStencilState, ppNext );
-        pDst->pColorBlendState = CopyStructure( pSrc->pColorBlendState, ppNext );
-        pDst->pDynamicState = CopyStructure( pSrc->pDynamicState, ppNext );
-    }
-}
-
-template<>
-void CopyStructureTo( VkRayTracingPipelineCreateInfoKHR* pDst, const VkRayTracingPipelineCreateInfoKHR* pSrc, std::byte** ppNext )
-{
-    if( pSrc != nullptr )
-    {
-        memcpy( pDst, pSrc, sizeof( VkRayTracingPipelineCreateInfoKHR ) );
-        pDst->pNext = CopyPNextChain( pSrc->pNext, ppNext );
-        pDst->stageCount = 0;
-        pDst->pStages = nullptr;
-        pDst->pGroups = CopyStructureArray( pSrc->pGroups, pSrc->groupCount, ppNext );
-        pDst->pLibraryInfo = nullptr;
-        pDst->pLibraryInterface = CopyStructure( pSrc->pLibraryInterface, ppNext );
-        pDst->pDynamicState = CopyStructure( pSrc->pDynamicState, ppNext );
-    }
-}
-
 template<>
 void CopyStructureTo( VkAccelerationStructureBuildGeometryInfoKHR* pDst, const VkAccelerationStructureBuildGeometryInfoKHR* pSrc, std::byte** ppNext )
 {
@@ -430,111 +363,428 @@ void CopyStructureTo( VkMicromapBuildInfoEXT* pDst, const VkMicromapBuildInfoEXT
     }
 }
 
-template<typename CreateInfoT>
-std::shared_ptr<Profiler::DeviceProfilerPipeline::CreateInfo> CopyPipelineCreateInfoImpl( const CreateInfoT* pCreateInfo )
+template<typename T>
+void AddStructureFieldsToHashInput( Profiler::HashInput& input, const T& structure )
+{
+    // By default structures are hashed as a whole.
+    // Structures with padding or pointers must specialize this function.
+    input.Add( &structure, sizeof( T ) );
+}
+
+template<typename T>
+void AddStructureToHashInput( Profiler::HashInput& input, const T* pStructure )
 {
-    void* pMemory = AllocateMemoryForStructures( pCreateInfo );
-    if( pMemory != nullptr )
+    input.Add( pStructure != nullptr );
+    if( pStructure != nullptr )
     {
-        auto* pNext = reinterpret_cast<std::byte*>( pMemory );
-        CopyStructure( pCreateInfo, &pNext );
+        AddStructureFieldsToHashInput( input, *pStructure );
     }
-    return std::shared_ptr<Profiler::DeviceProfilerPipeline::CreateInfo>(
-        reinterpret_cast<Profiler::DeviceProfilerPipeline::CreateInfo*>( pMemory ), free );
 }
 
-static VkAccelerationStructureBuildGeometryInfoKHR* CopyAccelerationStructureBuildGeometryInfos(
-    uint32_t infoCount,
-    const VkAccelerationStructureBuildGeometryInfoKHR* pInfos )
+template<typename T>
+void AddStructureArrayToHashInput( Profiler::HashInput& input, const T* pStructures, uint32_t count )
 {
-    void* pMemory = AllocateMemoryForStructures( pInfos, infoCount );
-    if( pMemory != nullptr )
+    input.Add( count );
+    input.Add( pStructures != nullptr );
+    if( pStructures != nullptr )
     {
-        auto* pNext = reinterpret_cast<std::byte*>( pMemory );
-        CopyStructureArray( pInfos, infoCount, &pNext );
+        for( uint32_t i = 0; i < count; ++i )
+        {
+            AddStructureFieldsToHashInput( input, pStructures[i] );
+        }
     }
-    return reinterpret_cast<VkAccelerationStructureBuildGeometryInfoKHR*>( pMemory );
 }
 
-static VkAccelerationStructureBuildRangeInfoKHR** CopyAccelerationStructureBuildRangeInfos(
-    uint32_t infoCount,
-    const VkAccelerationStructureBuildGeometryInfoKHR* pInfos,
-    const VkAccelerationStructureBuildRangeInfoKHR* const* ppRanges )
+template<>
+void AddStructureFieldsToHashInput( Profiler::HashInput& input, const VkPipelineVertexInputStateCreateInfo& structure )
 {
-    size_t size = 0;
-    for( uint32_t i = 0; i < infoCount; ++i )
+    input.Add( structure.sType );
+    input.Add( structure.flags );
+    AddStructureArrayToHashInput( input, structure.pVertexBindingDescriptions, structure.vertexBindingDescriptionCount );
+    AddStructureArrayToHashInput( input, structure.pVertexAttributeDescriptions, structure.vertexAttributeDescriptionCount );
+}
+
+template<>
+void AddStructureFieldsToHashInput( Profiler::HashInput& input, const VkPipelineInputAssemblyStateCreateInfo& structure )
+{
+    input.Add( structure.sType );
+    input.Add( structure.flags );
+    input.Add( structure.topology );
+    input.Add( structure.primitiveRestartEnable );
+}
+
+template<>
+void AddStructureFieldsToHashInput( Profiler::HashInput& input, const VkPipelineTessellationStateCreateInfo& structure )
+{
+    input.Add( structure.sType );
+    input.Add( structure.flags );
+    input.Add( structure.patchControlPoints );
+}
+
+template<>
+void AddStructureFieldsToHashInput( Profiler::HashInput& input, const VkPipelineViewportStateCreateInfo& structure )
+{
+    input.Add( structure.sType );
+    input.Add( structure.flags );
+    AddStructureArrayToHashInput( input, structure.pViewports, structure.viewportCount );
+    AddStructureArrayToHashInput( input, structure.pScissors, structure.scissorCount );
+}
+
+template<>
+void AddStructureFieldsToHashInput( Profiler::HashInput& input, const VkPipelineRasterizationStateCreateInfo& structure )
+{
+    input.Add( structure.sType );
+    input.Add( structure.flags );
+    input.Add( structure.depthClampEnable );
+    input.Add( structure.rasterizerDiscardEnable );
+    input.Add( structure.polygonMode );
+    input.Add( structure.cullMode );
+    input.Add( structure.frontFace );
+    input.Add( structure.depthBiasEnable );
+    input.Add( structure.depthBiasConstantFactor );
+    input.Add( structure.depthBiasClamp );
+    input.Add( structure.depthBiasSlopeFactor );
+    input.Add( structure.lineWidth );
+}
+
+template<>
+void AddStructureFieldsToHashInput( Profiler::HashInput& input, const VkPipelineMultisampleStateCreateInfo& structure )
+{
+    input.Add( structure.sType );
+    input.Add( structure.flags );
+    input.Add( structure.rasterizationSamples );
+    input.Add( structure.sampleShadingEnable );
+    input.Add( structure.minSampleShading );
+    AddStructureToHashInput( input, structure.pSampleMask );
+    input.Add( structure.alphaToCoverageEnable );
+    input.Add( structure.alphaToOneEnable );
+}
+
+template<>
+void AddStructureFieldsToHashInput( Profiler::HashInput& input, const VkPipelineDepthStencilStateCreateInfo& structure )
+{
+    input.Add( structure.sType );
+    input.Add( structure.flags );
+    input.Add( structure.depthTestEnable );
+    input.Add( structure.depthWriteEnable );
+    input.Add( structure.depthCompareOp );
+    input.Add( structure.depthBoundsTestEnable );
+    input.Add( structure.stencilTestEnable );
+    input.Add( &structure.front, sizeof( structure.front ) );
+    input.Add( &structure.back, sizeof( structure.back ) );
+    input.Add( structure.minDepthBounds );
+    input.Add( structure.maxDepthBounds );
+}
+
+template<>
+void AddStructureFieldsToHashInput( Profiler::HashInput& input, const VkPipelineColorBlendStateCreateInfo& structure )
+{
+    input.Add( structure.sType );
+    input.Add( structure.flags );
+    input.Add( structure.logicOpEnable );
+    input.Add( structure.logicOp );
+    AddStructureArrayToHashInput( input, structure.pAttachments, structure.attachmentCount );
+    input.Add( structure.blendConstants, sizeof( structure.blendConstants ) );
+}
+
+template<>
+void AddStructureFieldsToHashInput( Profiler::HashInput& input, const VkPipelineDynamicStateCreateInfo& structure )
+{
+    input.Add( structure.sType );
+    input.Add( structure.flags );
+    AddStructureArrayToHashInput( input, structure.pDynamicStates, structure.dynamicStateCount );
+}
+
+template<>
+void AddStructureFieldsToHashInput( Profiler::HashInput& input, const VkRayTracingPipelineInterfaceCreateInfoKHR& structure )
+{
+    input.Add( structure.sType );
+    input.Add( structure.maxPipelineRayPayloadSize );
+    input.Add( structure.maxPipelineRayHitAttributeSize );
+}
+
+namespace
+{
+    /***********************************************************************************\
+
+    Class:
+        PipelineStateStore
+
+    Description:
+        Shared store of immutable pipeline state blocks.
+
+        Pipelines created by the applications often share most of their fixed-function
+        state. Each unique state block is copied only once and is referenced by all
+        pipelines that use it. The blocks are released when the last pipeline that
+        references them is destroyed.
+
+    \***********************************************************************************/
+    class PipelineStateStore
+    {
+    public:
+        template<typename T>
+        std::shared_ptr<const T> Intern( const T* pStructure )
+        {
+            if( pStructure == nullptr )
+            {
+                return nullptr;
+            }
+
+            // Identify the state block by its content.
+            Profiler::HashInput hashInput;
+            AddStructureFieldsToHashInput( hashInput, *pStructure );
+
+            std::string key( hashInput.GetData(), hashInput.GetSize() );
+
+            std::scoped_lock lk( m_Mutex );
+
+            // Remove entries of the released blocks.
+            if( m_Blocks.size() >= m_PurgeThreshold )
+            {
+                for( auto it = m_Blocks.begin(); it != m_Blocks.end(); )
+                {
+                    if( it->second.expired() )
+                        it = m_Blocks.erase( it );
+                    else
+                        ++it;
+                }
+
+                m_PurgeThreshold = std::max<size_t>( g_scMinPurgeThreshold, 2 * m_Blocks.size() );
+            }
+
+            std::weak_ptr<const void>& pBlock = m_Blocks[ std::move( key ) ];
+            if( auto pExistingBlock = pBlock.lock() )
+            {
+                return std::static_pointer_cast<const T>( pExistingBlock );
+            }
+
+            // Create a new copy of the state.
+            void* pMemory = AllocateMemoryForStructures( pStructure );
+            if( pMemory == nullptr )
+            {
+                return nullptr;
+            }
+
+            auto* pNext = reinterpret_cast<std::byte*>( pMemory );
+            const T* pCopy = CopyStructure( pStructure, &pNext );
+
+            const int64_t size = static_cast<int64_t>( GetStructureSize( pStructure ) );
+            Profiler::DeviceProfilerOverheadCounter::AddSharedHostMemory(
+                Profiler::DeviceProfilerHostMemoryOverheadCategory::ePipelineCreateInfos, size );
+
+            std::shared_ptr<const T> pNewBlock( pCopy, [size]( const T* p )
+                {
+                    Profiler::DeviceProfilerOverheadCounter::AddSharedHostMemory(
+                        Profiler::DeviceProfilerHostMemoryOverheadCategory::ePipelineCreateInfos, -size );
+                    free( const_cast<T*>( p ) );
+                } );
+            pBlock = pNewBlock;
+
+            return pNewBlock;
+        }
+
+    private:
+        static constexpr size_t g_scMinPurgeThreshold = 256;
+
+        std::mutex m_Mutex;
+        std::unordered_map<std::string, std::weak_ptr<const void>> m_Blocks;
+        size_t m_PurgeThreshold = g_scMinPurgeThreshold;
+    };
+
+    PipelineStateStore& GetPipelineStateStore()
     {
-        size += sizeof( VkAccelerationStructureBuildRangeInfoKHR* ) +
-                sizeof( VkAccelerationStructureBuildRangeInfoKHR ) * pInfos[i].geometryCount;
+        static PipelineStateStore store;
+        return store;
     }
 
-    void* pMemory = malloc( size );
-    if( pMemory != nullptr )
+    /***********************************************************************************\
+
+    Structure:
+        PipelineCreateInfoStorage
+
+    Description:
+        Copy of the pipeline create info that references the shared state blocks.
+
+    \***********************************************************************************/
+    struct PipelineCreateInfoStorage
     {
-        auto** ppDstRanges = reinterpret_cast<VkAccelerationStructureBuildRangeInfoKHR**>( pMemory );
-        auto* pDstRangeInfos = reinterpret_cast<VkAccelerationStructureBuildRangeInfoKHR*>( ppDstRanges + infoCount );
-        for( uint32_t i = 0; i < infoCount; ++i )
+        Profiler::DeviceProfilerPipeline::CreateInfo m_CreateInfo = {};
+        std::vector<VkRayTracingShaderGroupCreateInfoKHR> m_RayTracingShaderGroups;
+        std::vector<std::shared_ptr<const void>> m_StateBlocks;
+
+        PipelineCreateInfoStorage()
         {
-            memcpy( pDstRangeInfos, ppRanges[i], pInfos[i].geometryCount * sizeof( VkAccelerationStructureBuildRangeInfoKHR ) );
-            ppDstRanges[i] = pDstRangeInfos;
-            pDstRangeInfos += pInfos[i].geometryCount;
+            Profiler::DeviceProfilerOverheadCounter::AddSharedHostMemory(
+                Profiler::DeviceProfilerHostMemoryOverheadCategory::ePipelineCreateInfos,
+                static_cast<int64_t>( sizeof( PipelineCreateInfoStorage ) ) );
+        }
+
+        ~PipelineCreateInfoStorage()
+        {
+            Profiler::DeviceProfilerOverheadCounter::AddSharedHostMemory(
+                Profiler::DeviceProfilerHostMemoryOverheadCategory::ePipelineCreateInfos,
+                -static_cast<int64_t>( sizeof( PipelineCreateInfoStorage ) + GetRayTracingShaderGroupsSize() ) );
         }
-    }
 
-    return reinterpret_cast<VkAccelerationStructureBuildRangeInfoKHR**>( pMemory );
+        size_t GetRayTracingShaderGroupsSize() const
+        {
+            return m_RayTracingShaderGroups.capacity() * sizeof( VkRayTracingShaderGroupCreateInfoKHR );
+        }
+
+        template<typename T>
+        const T* Intern( const T* pStructure )
+        {
+            std::shared_ptr<const T> pBlock = GetPipelineStateStore().Intern( pStructure );
+            if( pBlock != nullptr )
+            {
+                m_StateBlocks.push_back( pBlock );
+            }
+            return pBlock.get();
+        }
+    };
 }
 
-static uint32_t** CopyAccelerationStructureMaxPrimitiveCounts(
+template<typename T>
+static size_t GetPerGeometryArraysSize(
     uint32_t infoCount,
     const VkAccelerationStructureBuildGeometryInfoKHR* pInfos,
-    const uint32_t* const* ppMaxPrimitiveCounts )
+    const T* const* ppSrc )
 {
     size_t size = 0;
-    for( uint32_t i = 0; i < infoCount; ++i )
-    {
-        size += sizeof( uint32_t* ) +
-                sizeof( uint32_t ) * pInfos[i].geometryCount;
-    }
-
-    void* pMemory = malloc( size );
-    if( pMemory != nullptr )
+    if( ppSrc != nullptr )
     {
-        auto** ppDstMaxPrimitiveCounts = reinterpret_cast<uint32_t**>( pMemory );
-        auto* pDstMaxPrimitiveCounts = reinterpret_cast<uint32_t*>( ppDstMaxPrimitiveCounts + infoCount );
         for( uint32_t i = 0; i < infoCount; ++i )
         {
-            memcpy( pDstMaxPrimitiveCounts, ppMaxPrimitiveCounts[i], pInfos[i].geometryCount * sizeof( uint32_t ) );
-            ppDstMaxPrimitiveCounts[i] = pDstMaxPrimitiveCounts;
-            pDstMaxPrimitiveCounts += pInfos[i].geometryCount;
+            size += sizeof( T* ) +
+                    sizeof( T ) * pInfos[i].geometryCount;
         }
     }
-
-    return reinterpret_cast<uint32_t**>( pMemory );
+    return size;
 }
 
-static VkMicromapBuildInfoEXT* CopyMicromapBuildInfos(
+template<typename T>
+static T** CopyPerGeometryArrays(
     uint32_t infoCount,
-    const VkMicromapBuildInfoEXT* pInfos )
+    const VkAccelerationStructureBuildGeometryInfoKHR* pInfos,
+    const T* const* ppSrc,
+    std::byte** ppNext )
 {
-    void* pMemory = AllocateMemoryForStructures( pInfos, infoCount );
-    if( pMemory != nullptr )
+    if( ppSrc == nullptr || infoCount == 0 )
+    {
+        return nullptr;
+    }
+
+    auto** ppDst = reinterpret_cast<T**>( *ppNext );
+    auto* pDst = reinterpret_cast<T*>( ppDst + infoCount );
+    for( uint32_t i = 0; i < infoCount; ++i )
     {
-        auto* pNext = reinterpret_cast<std::byte*>( pMemory );
-        CopyStructureArray( pInfos, infoCount, &pNext );
+        memcpy( pDst, ppSrc[i], pInfos[i].geometryCount * sizeof( T ) );
+        ppDst[i] = pDst;
+        pDst += pInfos[i].geometryCount;
     }
-    return reinterpret_cast<VkMicromapBuildInfoEXT*>( pMemory );
+
+    *ppNext = reinterpret_cast<std::byte*>( pDst );
+    return ppDst;
+}
+
+static VkAccelerationStructureBuildRangeInfoKHR** CopyAccelerationStructureBuildRangeInfos(
+    uint32_t infoCount,
+    const VkAccelerationStructureBuildGeometryInfoKHR* pInfos,
+    const VkAccelerationStructureBuildRangeInfoKHR* const* ppRanges,
+    std::byte** ppNext )
+{
+    return CopyPerGeometryArrays( infoCount, pInfos, ppRanges, ppNext );
+}
+
+static uint32_t** CopyAccelerationStructureMaxPrimitiveCounts(
+    uint32_t infoCount,
+    const VkAccelerationStructureBuildGeometryInfoKHR* pInfos,
+    const uint32_t* const* ppMaxPrimitiveCounts,
+    std::byte** ppNext )
+{
+    return CopyPerGeometryArrays( infoCount, pInfos, ppMaxPrimitiveCounts, ppNext );
 }
 
 namespace Profiler
 {
+    /***********************************************************************************\
+
+    Function:
+        CopyPipelineCreateInfo
+
+    Description:
+        Copy the graphics pipeline create info.
+        Fixed-function state blocks are shared between pipelines with the same state.
+
+    \***********************************************************************************/
     std::shared_ptr<DeviceProfilerPipeline::CreateInfo> DeviceProfilerPipeline::CopyPipelineCreateInfo( const VkGraphicsPipelineCreateInfo* pCreateInfo )
     {
-        return CopyPipelineCreateInfoImpl( pCreateInfo );
+        if( pCreateInfo == nullptr )
+        {
+            return nullptr;
+        }
+
+        auto pStorage = std::make_shared<PipelineCreateInfoStorage>();
+
+        VkGraphicsPipelineCreateInfo& createInfo = pStorage->m_CreateInfo.m_GraphicsPipelineCreateInfo;
+        memcpy( &createInfo, pCreateInfo, sizeof( VkGraphicsPipelineCreateInfo ) );
+        createInfo.pNext = nullptr;
+        createInfo.stageCount = 0;
+        createInfo.pStages = nullptr;
+        createInfo.pVertexInputState = pStorage->Intern( pCreateInfo->pVertexInputState );
+        createInfo.pInputAssemblyState = pStorage->Intern( pCreateInfo->pInputAssemblyState );
+        createInfo.pTessellationState = pStorage->Intern( pCreateInfo->pTessellationState );
+        createInfo.pViewportState = pStorage->Intern( pCreateInfo->pViewportState );
+        createInfo.pRasterizationState = pStorage->Intern( pCreateInfo->pRasterizationState );
+        createInfo.pMultisampleState = pStorage->Intern( pCreateInfo->pMultisampleState );
+        createInfo.pDepthStencilState = pStorage->Intern( pCreateInfo->pDepthStencilState );
+        createInfo.pColorBlendState = pStorage->Intern( pCreateInfo->pColorBlendState );
+        createInfo.pDynamicState = pStorage->Intern( pCreateInfo->pDynamicState );
+
+        return std::shared_ptr<CreateInfo>( pStorage, &pStorage->m_CreateInfo );
     }
 
+    /***********************************************************************************\
+
+    Function:
+        CopyPipelineCreateInfo
+
+    Description:
+        Copy the ray tracing pipeline create info.
+        Shader groups are copied per pipeline, the remaining state blocks are shared.
+
+    \***********************************************************************************/
     std::shared_ptr<DeviceProfilerPipeline::CreateInfo> DeviceProfilerPipeline::CopyPipelineCreateInfo( const VkRayTracingPipelineCreateInfoKHR* pCreateInfo )
     {
-        return CopyPipelineCreateInfoImpl( pCreateInfo );
+        if( pCreateInfo == nullptr )
+        {
+            return nullptr;
+        }
+
+        auto pStorage = std::make_shared<PipelineCreateInfoStorage>();
+
+        if( pCreateInfo->pGroups != nullptr )
+        {
+            pStorage->m_RayTracingShaderGroups.assign(
+                pCreateInfo->pGroups,
+                pCreateInfo->pGroups + pCreateInfo->groupCount );
+
+            DeviceProfilerOverheadCounter::AddSharedHostMemory(
+                DeviceProfilerHostMemoryOverheadCategory::ePipelineCreateInfos,
+                static_cast<int64_t>( pStorage->GetRayTracingShaderGroupsSize() ) );
+        }
+
+        VkRayTracingPipelineCreateInfoKHR& createInfo = pStorage->m_CreateInfo.m_RayTracingPipelineCreateInfoKHR;
+        memcpy( &createInfo, pCreateInfo, sizeof( VkRayTracingPipelineCreateInfoKHR ) );
+        createInfo.pNext = nullptr;
+        createInfo.stageCount = 0;
+        createInfo.pStages = nullptr;
+        createInfo.pGroups = pStorage->m_RayTracingShaderGroups.empty() ? nullptr : pStorage->m_RayTracingShaderGroups.data();
+        createInfo.pLibraryInfo = nullptr;
+        createInfo.pLibraryInterface = pStorage->Intern( pCreateInfo->pLibraryInterface );
+        createInfo.pDynamicState = pStorage->Intern( pCreateInfo->pDynamicState );
+
+        return std::shared_ptr<CreateInfo>( pStorage, &pStorage->m_CreateInfo );
     }
 
     void DeviceProfilerDrawcallDrawMultiPayload::CopyDynamicAllocations( const DeviceProfilerDrawcallDrawMultiPayload& other )
@@ -578,77 +828,154 @@ namespace Profiler
         }
     }
 
-    template<DeviceProfilerDrawcallType Type>
-    void DeviceProfilerDrawcallBuildAccelerationStructuresBasePayload<Type>::CopyDynamicAllocations( const DeviceProfilerDrawcallBuildAccelerationStructuresBasePayload& other )
+    /***********************************************************************************\
+
+    Function:
+        Allocate
+
+    Description:
+        Allocates a block for size bytes of payload data with a single reference.
+
+    \***********************************************************************************/
+    DeviceProfilerDrawcallSharedPayloadData* DeviceProfilerDrawcallSharedPayloadData::Allocate( size_t size )
     {
-        m_pInfos = CopyAccelerationStructureBuildGeometryInfos(
-            other.m_InfoCount,
-            other.m_pInfos );
+        void* pMemory = malloc( sizeof( DeviceProfilerDrawcallSharedPayloadData ) + size );
+        if( pMemory == nullptr )
+        {
+            return nullptr;
+        }
 
-        m_OwnsDynamicAllocations = true;
+        auto* pData = new( pMemory ) DeviceProfilerDrawcallSharedPayloadData;
+        pData->m_ReferenceCount.store( 1, std::memory_order_relaxed );
+        return pData;
     }
 
-    template<DeviceProfilerDrawcallType Type>
-    void DeviceProfilerDrawcallBuildAccelerationStructuresBasePayload<Type>::FreeDynamicAllocations()
+    /***********************************************************************************\
+
+    Function:
+        Release
+
+    Description:
+        Releases the reference to the block and frees it if it was the last one.
+        Drawcalls may be copied and destroyed concurrently by the data aggregation
+        threads, so the counter is updated atomically.
+
+    \***********************************************************************************/
+    void DeviceProfilerDrawcallSharedPayloadData::Release( DeviceProfilerDrawcallSharedPayloadData* pData )
     {
-        if( m_OwnsDynamicAllocations )
+        if( ( pData != nullptr ) &&
+            ( pData->m_ReferenceCount.fetch_sub( 1, std::memory_order_acq_rel ) == 1 ) )
         {
-            this->FreeConst( m_pInfos );
+            pData->~DeviceProfilerDrawcallSharedPayloadData();
+            free( pData );
         }
     }
 
+    /***********************************************************************************\
+
+    Function:
+        CopyDynamicAllocations
+
+    Description:
+        Copies the build infos and ranges captured from the application to a shared
+        block. Copies of the drawcall reference the same block.
+
+    \***********************************************************************************/
     void DeviceProfilerDrawcallBuildAccelerationStructuresPayload::CopyDynamicAllocations( const DeviceProfilerDrawcallBuildAccelerationStructuresPayload& other )
     {
-        DeviceProfilerDrawcallBuildAccelerationStructuresBasePayload::CopyDynamicAllocations( other );
+        m_InfoCount = other.m_InfoCount;
 
-        m_ppRanges = CopyAccelerationStructureBuildRangeInfos(
-            other.m_InfoCount,
-            other.m_pInfos,
-            other.m_ppRanges );
-    }
+        if( other.m_pSharedData != nullptr )
+        {
+            m_pSharedData = DeviceProfilerDrawcallSharedPayloadData::AddReference( other.m_pSharedData );
+            m_pInfos = other.m_pInfos;
+            m_ppRanges = other.m_ppRanges;
+            return;
+        }
 
-    void DeviceProfilerDrawcallBuildAccelerationStructuresPayload::FreeDynamicAllocations()
-    {
-        DeviceProfilerDrawcallBuildAccelerationStructuresBasePayload::FreeDynamicAllocations();
+        m_pSharedData = DeviceProfilerDrawcallSharedPayloadData::Allocate(
+            GetStructureArraySize( other.m_pInfos, other.m_InfoCount ) +
+            GetPerGeometryArraysSize( other.m_InfoCount, other.m_pInfos, other.m_ppRanges ) );
 
-        if( m_OwnsDynamicAllocations )
+        m_pInfos = nullptr;
+        m_ppRanges = nullptr;
+
+        if( m_pSharedData != nullptr )
         {
-            this->FreeConst( m_ppRanges );
+            std::byte* pNext = m_pSharedData->GetData();
+            m_pInfos = CopyStructureArray( other.m_pInfos, other.m_InfoCount, &pNext );
+            m_ppRanges = CopyAccelerationStructureBuildRangeInfos( other.m_InfoCount, other.m_pInfos, other.m_ppRanges, &pNext );
         }
     }
 
+    /***********************************************************************************\
+
+    Function:
+        CopyDynamicAllocations
+
+    Description:
+        Copies the build infos and max primitive counts captured from the application
+        to a shared block. Copies of the drawcall reference the same block.
+
+    \***********************************************************************************/
     void DeviceProfilerDrawcallBuildAccelerationStructuresIndirectPayload::CopyDynamicAllocations( const DeviceProfilerDrawcallBuildAccelerationStructuresIndirectPayload& other )
     {
-        DeviceProfilerDrawcallBuildAccelerationStructuresBasePayload::CopyDynamicAllocations( other );
+        m_InfoCount = other.m_InfoCount;
 
-        m_ppMaxPrimitiveCounts = CopyAccelerationStructureMaxPrimitiveCounts(
-            other.m_InfoCount,
-            other.m_pInfos,
-            other.m_ppMaxPrimitiveCounts );
-    }
+        if( other.m_pSharedData != nullptr )
+        {
+            m_pSharedData = DeviceProfilerDrawcallSharedPayloadData::AddReference( other.m_pSharedData );
+            m_pInfos = other.m_pInfos;
+            m_ppMaxPrimitiveCounts = other.m_ppMaxPrimitiveCounts;
+            return;
+        }
 
-    void DeviceProfilerDrawcallBuildAccelerationStructuresIndirectPayload::FreeDynamicAllocations()
-    {
-        DeviceProfilerDrawcallBuildAccelerationStructuresBasePayload::FreeDynamicAllocations();
+        m_pSharedData = DeviceProfilerDrawcallSharedPayloadData::Allocate(
+            GetStructureArraySize( other.m_pInfos, other.m_InfoCount ) +
+            GetPerGeometryArraysSize( other.m_InfoCount, other.m_pInfos, other.m_ppMaxPrimitiveCounts ) );
 
-        if( m_OwnsDynamicAllocations )
+        m_pInfos = nullptr;
+        m_ppMaxPrimitiveCounts = nullptr;
+
+        if( m_pSharedData != nullptr )
         {
-            this->FreeConst( m_ppMaxPrimitiveCounts );
+            // Max primitive counts are not aligned to the pointer size, so they are copied last.
+            std::byte* pNext = m_pSharedData->GetData();
+            m_pInfos = CopyStructureArray( other.m_pInfos, other.m_InfoCount, &pNext );
+            m_ppMaxPrimitiveCounts = CopyAccelerationStructureMaxPrimitiveCounts( other.m_InfoCount, other.m_pInfos, other.m_ppMaxPrimitiveCounts, &pNext );
         }
     }
 
+    /***********************************************************************************\
+
+    Function:
+        CopyDynamicAllocations
+
+    Description:
+        Copies the micromap build infos captured from the application to a shared
+        block. Copies of the drawcall reference the same block.
+
+    \***********************************************************************************/
     void DeviceProfilerDrawcallBuildMicromapsPayload::CopyDynamicAllocations( const DeviceProfilerDrawcallBuildMicromapsPayload& other )
     {
-        m_pInfos = CopyMicromapBuildInfos(
-            other.m_InfoCount,
-            other.m_pInfos );
-    }
+        m_InfoCount = other.m_InfoCount;
 
-    void DeviceProfilerDrawcallBuildMicromapsPayload::FreeDynamicAllocations()
-    {
-        if( m_OwnsDynamicAllocations )
+        if( other.m_pSharedData != nullptr )
+        {
+            m_pSharedData = DeviceProfilerDrawcallSharedPayloadData::AddReference( other.m_pSharedData );
+            m_pInfos = other.m_pInfos;
+            return;
+        }
+
+        m_pSharedData = DeviceProfilerDrawcallSharedPayloadData::Allocate(
+            GetStructureArraySize( other.m_pInfos, other.m_InfoCount ) );
+
+        m_pInfos = nullptr;
+
+        if( m_pSharedData != nullptr )
         {
-            this->FreeConst( m_pInfos );
+            std::byte* pNext = m_pSharedData->GetData();
+            m_pInfos = CopyStructureArray( other.m_pInfos, other.m_InfoCount, &pNext );
         }
     }
 }
@@ -22,13 +22,19 @@
 #include "profiler_counters.h"
 #include "profiler_shader.h"
 #include <assert.h>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <vector>
+#include <string>
 #include <list>
 #include <deque>
+#include <memory>
 #include <variant>
 #include <unordered_map>
 #include <cstring>
+#include <cmath>
 #include <vulkan/vulkan.h>
 
 #include "profiler_layer_objects/VkObject.h"
@@ -191,6 +197,105 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Structure:
+        DeviceProfilerTimestampValue
+
+    Description:
+        Last recorded value of the timestamp.
+        Used by the drawcalls, which keep their timestamp indices in the command buffer.
+
+    \***********************************************************************************/
+    struct DeviceProfilerTimestampValue
+    {
+        uint64_t m_Value = UINT64_MAX;
+    };
+
+    /***********************************************************************************\
+
+    Structure:
+        DeviceProfilerPipelineStatistics
+
+    Description:
+        Contains results of VK_QUERY_TYPE_PIPELINE_STATISTICS query.
+        m_Flags is a set of statistics that have been collected.
+
+    \***********************************************************************************/
+    struct DeviceProfilerPipelineStatistics
+    {
+        uint64_t m_Index = UINT64_MAX;
+        uint32_t m_ViewCount = 1;
+
+        VkQueryPipelineStatisticFlags m_Flags = 0;
+        uint64_t m_InputAssemblyVertices = 0;
+        uint64_t m_InputAssemblyPrimitives = 0;
+        uint64_t m_VertexShaderInvocations = 0;
+        uint64_t m_GeometryShaderInvocations = 0;
+        uint64_t m_GeometryShaderPrimitives = 0;
+        uint64_t m_ClippingInvocations = 0;
+        uint64_t m_ClippingPrimitives = 0;
+        uint64_t m_FragmentShaderInvocations = 0;
+        uint64_t m_TessellationControlShaderPatches = 0;
+        uint64_t m_TessellationEvaluationShaderInvocations = 0;
+        uint64_t m_ComputeShaderInvocations = 0;
+
+        inline uint64_t* GetCounter( VkQueryPipelineStatisticFlagBits flag )
+        {
+            switch( flag )
+            {
+            case VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT: return &m_InputAssemblyVertices;
+            case VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT: return &m_InputAssemblyPrimitives;
+            case VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT: return &m_VertexShaderInvocations;
+            case VK_QUERY_PIPELINE_STATISTIC_GEOMETRY_SHADER_INVOCATIONS_BIT: return &m_GeometryShaderInvocations;
+            case VK_QUERY_PIPELINE_STATISTIC_GEOMETRY_SHADER_PRIMITIVES_BIT: return &m_GeometryShaderPrimitives;
+            case VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT: return &m_ClippingInvocations;
+            case VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT: return &m_ClippingPrimitives;
+            case VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT: return &m_FragmentShaderInvocations;
+            case VK_QUERY_PIPELINE_STATISTIC_TESSELLATION_CONTROL_SHADER_PATCHES_BIT: return &m_TessellationControlShaderPatches;
+            case VK_QUERY_PIPELINE_STATISTIC_TESSELLATION_EVALUATION_SHADER_INVOCATIONS_BIT: return &m_TessellationEvaluationShaderInvocations;
+            case VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT: return &m_ComputeShaderInvocations;
+            default: return nullptr;
+            }
+        }
+
+        // Accumulates a single query result. The values are written in the order of the flag bits.
+        inline void AddQueryResult( VkQueryPipelineStatisticFlags flags, const uint64_t* pResult )
+        {
+            for( VkQueryPipelineStatisticFlags remainingFlags = flags; remainingFlags != 0; remainingFlags &= (remainingFlags - 1) )
+            {
+                const VkQueryPipelineStatisticFlagBits flag =
+                    static_cast<VkQueryPipelineStatisticFlagBits>( remainingFlags & (~remainingFlags + 1) );
+
+                if( uint64_t* pCounter = GetCounter( flag ) )
+                {
+                    *pCounter += *pResult;
+                }
+
+                pResult++;
+            }
+
+            m_Flags |= flags;
+        }
+
+        inline DeviceProfilerPipelineStatistics& operator+=( const DeviceProfilerPipelineStatistics& rh )
+        {
+            m_Flags |= rh.m_Flags;
+            m_InputAssemblyVertices += rh.m_InputAssemblyVertices;
+            m_InputAssemblyPrimitives += rh.m_InputAssemblyPrimitives;
+            m_VertexShaderInvocations += rh.m_VertexShaderInvocations;
+            m_GeometryShaderInvocations += rh.m_GeometryShaderInvocations;
+            m_GeometryShaderPrimitives += rh.m_GeometryShaderPrimitives;
+            m_ClippingInvocations += rh.m_ClippingInvocations;
+            m_ClippingPrimitives += rh.m_ClippingPrimitives;
+            m_FragmentShaderInvocations += rh.m_FragmentShaderInvocations;
+            m_TessellationControlShaderPatches += rh.m_TessellationControlShaderPatches;
+            m_TessellationEvaluationShaderInvocations += rh.m_TessellationEvaluationShaderInvocations;
+            m_ComputeShaderInvocations += rh.m_ComputeShaderInvocations;
+            return *this;
+        }
+    };
+
+    /***********************************************************************************\
+
     Drawcall-specific playloads
 
     \***********************************************************************************/
@@ -223,6 +328,36 @@ namespace Profiler
         }
     };
 
+    /***********************************************************************************\
+
+    Structure:
+        DeviceProfilerDrawcallSharedPayloadData
+
+    Description:
+        Header of an immutable block of payload data shared by the copies of a drawcall.
+        The data is allocated together with the header and freed when the last copy of
+        the drawcall releases it, so copying the drawcall does not copy the data again.
+
+    \***********************************************************************************/
+    struct alignas( std::max_align_t ) DeviceProfilerDrawcallSharedPayloadData
+    {
+        std::atomic_uint32_t m_ReferenceCount;
+
+        static DeviceProfilerDrawcallSharedPayloadData* Allocate( size_t size );
+        static void Release( DeviceProfilerDrawcallSharedPayloadData* pData );
+
+        inline static DeviceProfilerDrawcallSharedPayloadData* AddReference( DeviceProfilerDrawcallSharedPayloadData* pData )
+        {
+            pData->m_ReferenceCount.fetch_add( 1, std::memory_order_relaxed );
+            return pData;
+        }
+
+        inline std::byte* GetData()
+        {
+            return reinterpret_cast<std::byte*>( this + 1 );
+        }
+    };
+
     template<DeviceProfilerDrawcallType Type>
     struct DeviceProfilerDrawcallDebugLabelBasePayload
         : DeviceProfilerDrawcallBasePayload<Type>
@@ -668,11 +803,13 @@ namespace Profiler
         : DeviceProfilerDrawcallBasePayload<Type>
     {
         uint32_t m_InfoCount;
-        bool m_OwnsDynamicAllocations;
+        DeviceProfilerDrawcallSharedPayloadData* m_pSharedData;
         const VkAccelerationStructureBuildGeometryInfoKHR* m_pInfos;
 
-        void CopyDynamicAllocations( const DeviceProfilerDrawcallBuildAccelerationStructuresBasePayload& other );
-        void FreeDynamicAllocations();
+        inline void FreeDynamicAllocations()
+        {
+            DeviceProfilerDrawcallSharedPayloadData::Release( m_pSharedData );
+        }
     };
 
     struct DeviceProfilerDrawcallBuildAccelerationStructuresPayload
@@ -682,7 +819,6 @@ namespace Profiler
         const VkAccelerationStructureBuildRangeInfoKHR* const* m_ppRanges;
 
         void CopyDynamicAllocations( const DeviceProfilerDrawcallBuildAccelerationStructuresPayload& other );
-        void FreeDynamicAllocations();
     };
 
     struct DeviceProfilerDrawcallBuildAccelerationStructuresIndirectPayload
@@ -692,7 +828,6 @@ namespace Profiler
         const uint32_t* const* m_ppMaxPrimitiveCounts;
 
         void CopyDynamicAllocations( const DeviceProfilerDrawcallBuildAccelerationStructuresIndirectPayload& other );
-        void FreeDynamicAllocations();
     };
 
     struct DeviceProfilerDrawcallCopyAccelerationStructurePayload
@@ -746,11 +881,15 @@ namespace Profiler
               DeviceProfilerDrawcallType::eBuildMicromapsEXT>
     {
         uint32_t m_InfoCount;
-        bool m_OwnsDynamicAllocations;
+        DeviceProfilerDrawcallSharedPayloadData* m_pSharedData;
         const VkMicromapBuildInfoEXT* m_pInfos;
 
         void CopyDynamicAllocations( const DeviceProfilerDrawcallBuildMicromapsPayload& other );
-        void FreeDynamicAllocations();
+
+        inline void FreeDynamicAllocations()
+        {
+            DeviceProfilerDrawcallSharedPayloadData::Release( m_pSharedData );
+        }
     };
 
     struct DeviceProfilerDrawcallCopyMicromapPayload
@@ -876,17 +1015,19 @@ namespace Profiler
 
     Description:
         Contains data collected per-drawcall.
+        Indices of the timestamp queries are kept by the command buffer, so only the
+        resolved values are stored in each drawcall.
 
     \***********************************************************************************/
     struct DeviceProfilerDrawcall
     {
         DeviceProfilerDrawcallType                          m_Type = {};
         DeviceProfilerDrawcallPayload                       m_Payload = {};
-        DeviceProfilerTimestamp                             m_BeginTimestamp;
-        DeviceProfilerTimestamp                             m_EndTimestamp;
+        DeviceProfilerTimestampValue                        m_BeginTimestamp;
+        DeviceProfilerTimestampValue                        m_EndTimestamp;
 
-        inline DeviceProfilerTimestamp GetBeginTimestamp() const { return m_BeginTimestamp; }
-        inline DeviceProfilerTimestamp GetEndTimestamp() const { return m_EndTimestamp; }
+        inline DeviceProfilerTimestampValue GetBeginTimestamp() const { return m_BeginTimestamp; }
+        inline DeviceProfilerTimestampValue GetEndTimestamp() const { return m_EndTimestamp; }
 
         inline DeviceProfilerPipelineType GetPipelineType() const
         {
@@ -1010,9 +1151,44 @@ namespace Profiler
             uint64_t m_TicksMax = 0;
             uint64_t m_TicksMin = 0;
 
+            // Number of measured and not measured commands when drawcall sampling is enabled.
+            uint64_t m_SampleCount = 0;
+            uint64_t m_SkippedSampleCount = 0;
+            double m_TicksSquaredSum = 0;
+
             inline uint64_t GetTicksAvg() const
             {
-                return m_Count ? (m_TicksSum / m_Count) : 0;
+                return m_Count ? (GetEstimatedTicksSum() / m_Count) : 0;
+            }
+
+            // Returns total ticks extrapolated from the sampled commands.
+            inline uint64_t GetEstimatedTicksSum() const
+            {
+                if( (m_SkippedSampleCount == 0) || (m_SampleCount == 0) )
+                {
+                    return m_TicksSum;
+                }
+
+                const double sampleMean = static_cast<double>( m_TicksSum ) / m_SampleCount;
+                return static_cast<uint64_t>( sampleMean * (m_SampleCount + m_SkippedSampleCount) );
+            }
+
+            // Returns half-width of the 95% confidence interval of the estimated total ticks.
+            inline uint64_t GetEstimatedTicksSumError() const
+            {
+                if( (m_SkippedSampleCount == 0) || (m_SampleCount < 2) )
+                {
+                    return 0;
+                }
+
+                const double n = static_cast<double>( m_SampleCount );
+                const double N = static_cast<double>( m_SampleCount + m_SkippedSampleCount );
+                const double sampleMean = m_TicksSum / n;
+                const double sampleVariance = std::max( 0.0, (m_TicksSquaredSum - n * sampleMean * sampleMean) / (n - 1) );
+
+                // Apply finite population correction, as each command is sampled at most once.
+                const double standardError = N * std::sqrt( (sampleVariance / n) * ((N - n) / (N - 1)) );
+                return static_cast<uint64_t>( 1.96 * standardError );
             }
 
             inline void AddTicks( uint64_t ticks )
@@ -1029,6 +1205,13 @@ namespace Profiler
                 }
 
                 m_TicksSum += ticks;
+                m_TicksSquaredSum += static_cast<double>( ticks ) * ticks;
+                m_SampleCount++;
+            }
+
+            inline void AddSkippedSample()
+            {
+                m_SkippedSampleCount++;
             }
 
             inline void AddStats( const Stats& stats )
@@ -1047,6 +1230,9 @@ namespace Profiler
                 }
 
                 m_TicksSum += stats.m_TicksSum;
+                m_TicksSquaredSum += stats.m_TicksSquaredSum;
+                m_SampleCount += stats.m_SampleCount;
+                m_SkippedSampleCount += stats.m_SkippedSampleCount;
             }
         };
 
@@ -1190,6 +1376,16 @@ namespace Profiler
             }
         }
 
+        // Increment count of commands of the specific drawcall type that were not measured.
+        void AddSkippedSample( DeviceProfilerDrawcallType type )
+        {
+            Stats* pStats = GetStats( type );
+            if( pStats )
+            {
+                pStats->AddSkippedSample();
+            }
+        }
+
         // Increment all stats with stats from the other structure.
         void AddStats( const DeviceProfilerDrawcallStats& stats )
         {
@@ -1274,6 +1470,7 @@ namespace Profiler
     {
         DeviceProfilerTimestamp                             m_BeginTimestamp;
         DeviceProfilerTimestamp                             m_EndTimestamp;
+        DeviceProfilerPipelineStatistics                    m_PipelineStatistics;
         ContainerType<struct DeviceProfilerDrawcall>        m_Drawcalls = {};
 
         inline DeviceProfilerPipelineData() = default;
@@ -1305,6 +1502,7 @@ namespace Profiler
     {
         uint32_t                                            m_Index = {};
         uint32_t                                            m_ResolveCount = {};
+        uint32_t                                            m_ViewMask = {};
     };
 
     /***********************************************************************************\
@@ -1418,6 +1616,8 @@ namespace Profiler
         DeviceProfilerRenderPassBeginData                   m_Begin = {};
         DeviceProfilerRenderPassEndData                     m_End = {};
 
+        DeviceProfilerPipelineStatistics                    m_PipelineStatistics;
+
         ContainerType<struct DeviceProfilerSubpassData>     m_Subpasses = {};
 
         bool HasBeginCommand() const { return m_Handle != VK_NULL_HANDLE || m_Dynamic; }
@@ -1479,6 +1679,10 @@ namespace Profiler
 
         bool                                                m_DataValid = false;
 
+        // Set when the command buffer, or any secondary command buffer executed by it,
+        // contains a debug label matching the trace capture trigger.
+        bool                                                m_HasTraceTriggerLabel = false;
+
         ContainerType<struct DeviceProfilerRenderPassData>  m_RenderPasses = {};
 
         DeviceProfilerPerformanceCountersData               m_PerformanceCounters = {};
@@ -1489,6 +1693,61 @@ namespace Profiler
         inline DeviceProfilerTimestamp GetEndTimestamp() const { return m_EndTimestamp; }
     };
 
+    // Resolved command buffer data is immutable and shared by all frames and command buffers that reference it.
+    using DeviceProfilerCommandBufferDataPtr = std::shared_ptr<const DeviceProfilerCommandBufferData>;
+
+    /***********************************************************************************\
+
+    Enumeration:
+        DeviceProfilerQueueIdleReason
+
+    Description:
+        Reasons of the queue being idle before a submit.
+
+        eUnknown is reported when the CPU and GPU timestamps can't be correlated and
+        the gap is not explained by a semaphore wait.
+
+    \***********************************************************************************/
+    enum class DeviceProfilerQueueIdleReason
+    {
+        eNone,
+        eUnknown,
+        eSemaphoreWait,
+        eCpuSubmission,
+        eStarvation
+    };
+
+    /***********************************************************************************\
+
+    Structure:
+        DeviceProfilerSubmitIndex
+
+    Description:
+        Identifies a submit in the frame by its position in DeviceProfilerFrameData::m_Submits.
+
+    \***********************************************************************************/
+    struct DeviceProfilerSubmitIndex
+    {
+        uint32_t m_SubmitBatchIndex = UINT32_MAX;
+        uint32_t m_SubmitIndex = UINT32_MAX;
+    };
+
+    /***********************************************************************************\
+
+    Structure:
+        DeviceProfilerSemaphoreDependencyData
+
+    Description:
+        Dependency between two submits established by a semaphore.
+
+    \***********************************************************************************/
+    struct DeviceProfilerSemaphoreDependencyData
+    {
+        VkSemaphoreHandle                                   m_Semaphore = {};
+        DeviceProfilerSubmitIndex                           m_SignalSubmit = {};
+        DeviceProfilerSubmitIndex                           m_WaitSubmit = {};
+    };
+
     /***********************************************************************************\
 
     Structure:
@@ -1500,13 +1759,19 @@ namespace Profiler
     \***********************************************************************************/
     struct DeviceProfilerSubmitData
     {
-        ContainerType<struct DeviceProfilerCommandBufferData> m_CommandBuffers = {};
+        ContainerType<DeviceProfilerCommandBufferDataPtr>   m_CommandBuffers = {};
         std::vector<VkSemaphoreHandle>                      m_SignalSemaphores = {};
         std::vector<VkSemaphoreHandle>                      m_WaitSemaphores = {};
 
         DeviceProfilerTimestamp                             m_BeginTimestamp;
         DeviceProfilerTimestamp                             m_EndTimestamp;
 
+        // Results of the queue dependency analysis.
+        uint64_t                                            m_IdleTicks = 0;
+        DeviceProfilerQueueIdleReason                       m_IdleReason = DeviceProfilerQueueIdleReason::eNone;
+        uint64_t                                            m_SlackTicks = 0;
+        bool                                                m_CriticalPath = false;
+
         inline DeviceProfilerTimestamp GetBeginTimestamp() const { return m_BeginTimestamp; }
         inline DeviceProfilerTimestamp GetEndTimestamp() const { return m_EndTimestamp; }
     };
@@ -1815,20 +2080,86 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Enumeration:
+        DeviceProfilerMemoryEventType
+
+    Description:
+        Type of the change of the device memory state.
+
+    \***********************************************************************************/
+    enum class DeviceProfilerMemoryEventType : uint32_t
+    {
+        eAllocate,
+        eFree,
+        eBind,
+        eUnbind,
+        eCreate,
+        eDestroy,
+        eUpdate
+    };
+
+    /***********************************************************************************\
+
     Structure:
-        DeviceProfilerMemoryData
+        DeviceProfilerMemoryEventData
 
     Description:
+        Single entry of the memory event log.
+
+        Bind and unbind events describe the range of the device memory
+        (m_MemoryOffset, m_Size) occupied by the resource. Heap and type indices
+        are set for all memory events.
+
+        Create, destroy and update events only identify the resource. Update events
+        are logged for the changes that don't occupy a tracked memory range, like
+        block bindings of sparse images.
 
     \***********************************************************************************/
-    struct DeviceProfilerMemoryData
+    struct DeviceProfilerMemoryEventData
     {
-        uint64_t m_TotalAllocationSize = {};
-        uint64_t m_TotalAllocationCount = {};
+        DeviceProfilerMemoryEventType m_Type = {};
+        uint32_t m_ThreadId = {};
+        uint64_t m_Timestamp = {};
+        VkDeviceMemoryHandle m_Memory = {};
+        uint32_t m_HeapIndex = {};
+        uint32_t m_TypeIndex = {};
+        VkDeviceSize m_MemoryOffset = {};
+        VkDeviceSize m_Size = {};
+        VkObject m_Resource = {};
+    };
 
-        std::vector<struct DeviceProfilerMemoryHeapData> m_Heaps = {};
-        std::vector<struct DeviceProfilerMemoryTypeData> m_Types = {};
+    /***********************************************************************************\
+
+    Structure:
+        DeviceProfilerMemoryChurnData
+
+    Description:
+        Number and total size of the memory events logged since the previous frame.
+
+    \***********************************************************************************/
+    struct DeviceProfilerMemoryChurnData
+    {
+        uint64_t m_AllocationCount = {};
+        uint64_t m_AllocationSize = {};
+        uint64_t m_FreeCount = {};
+        uint64_t m_FreeSize = {};
+        uint64_t m_BindCount = {};
+        uint64_t m_BindSize = {};
+        uint64_t m_UnbindCount = {};
+        uint64_t m_UnbindSize = {};
+    };
+
+    /***********************************************************************************\
+
+    Structure:
+        DeviceProfilerMemorySnapshotData
 
+    Description:
+        Allocations and resources tracked by the profiler at the time of the snapshot.
+
+    \***********************************************************************************/
+    struct DeviceProfilerMemorySnapshotData
+    {
         std::unordered_map<VkDeviceMemoryHandle, struct DeviceProfilerDeviceMemoryData> m_Allocations = {};
         std::unordered_map<VkBufferHandle, struct DeviceProfilerBufferMemoryData> m_Buffers = {};
         std::unordered_map<VkImageHandle, struct DeviceProfilerImageMemoryData> m_Images = {};
@@ -1839,6 +2170,103 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Structure:
+        DeviceProfilerMemorySnapshotChangesData
+
+    Description:
+        Allocations and resources changed in a frame since the previous one.
+        Applying the changes of all frames since the snapshot, starting from the
+        oldest, gives the allocations and resources of the frame.
+
+    \***********************************************************************************/
+    struct DeviceProfilerMemorySnapshotChangesData
+    {
+        // Changes of the previous frames, null in the first frame after the snapshot.
+        std::shared_ptr<const DeviceProfilerMemorySnapshotChangesData> m_pPrevious = {};
+
+        // Allocations and resources created or modified in the frame.
+        DeviceProfilerMemorySnapshotData m_Updated = {};
+
+        // Allocations and resources destroyed in the frame.
+        std::vector<VkObject> m_Removed = {};
+    };
+
+    /***********************************************************************************\
+
+    Structure:
+        DeviceProfilerMemoryData
+
+    Description:
+        If the memory event log is enabled, the snapshot of the allocations and
+        resources is captured periodically and shared by the frames in between.
+        The changes made since the snapshot are described by the events and the
+        state of the changed objects is kept in m_pChanges.
+
+    \***********************************************************************************/
+    struct DeviceProfilerMemoryData
+    {
+        uint64_t m_TotalAllocationSize = {};
+        uint64_t m_TotalAllocationCount = {};
+
+        std::vector<struct DeviceProfilerMemoryHeapData> m_Heaps = {};
+        std::vector<struct DeviceProfilerMemoryTypeData> m_Types = {};
+
+        std::shared_ptr<const DeviceProfilerMemorySnapshotData> m_pSnapshot = std::make_shared<DeviceProfilerMemorySnapshotData>();
+
+        // Number of frames since the snapshot was captured, 0 if it was captured in this frame.
+        uint32_t m_SnapshotAge = {};
+
+        // Changes made since the snapshot was captured, null if it was captured in this frame.
+        std::shared_ptr<const DeviceProfilerMemorySnapshotChangesData> m_pChanges = {};
+
+        // Events logged since the previous frame, if the memory event log is enabled.
+        // Applying them to the state of the previous frame gives the allocations and bindings of this one.
+        std::vector<struct DeviceProfilerMemoryEventData> m_Events = {};
+        DeviceProfilerMemoryChurnData m_Churn = {};
+        uint64_t m_DroppedEventCount = {};
+    };
+
+    /***********************************************************************************\
+
+    Enumeration:
+        DeviceProfilerCpuSpanType
+
+    Description:
+        Type of the work done by the application thread in a CPU span.
+
+    \***********************************************************************************/
+    enum class DeviceProfilerCpuSpanType : uint32_t
+    {
+        eCommandBufferRecording,
+        eQueueSubmit,
+        eQueuePresent
+    };
+
+    /***********************************************************************************\
+
+    Structure:
+        DeviceProfilerCpuSpanData
+
+    Description:
+        Time spent by an application thread recording a command buffer or in the
+        driver's vkQueueSubmit or vkQueuePresentKHR.
+
+        Timestamps are CPU timestamps in the same time domain as the frame's CPU
+        timestamps.
+
+    \***********************************************************************************/
+    struct DeviceProfilerCpuSpanData
+    {
+        DeviceProfilerCpuSpanType                           m_Type = {};
+        uint32_t                                            m_ThreadId = {};
+        uint64_t                                            m_BeginTimestamp = {};
+        uint64_t                                            m_EndTimestamp = {};
+        VkCommandBufferHandle                               m_CommandBuffer = {};
+        VkQueueHandle                                       m_Queue = {};
+    };
+
+    /***********************************************************************************\
+
     Structure:
         DeviceProfilerCPUData
 
@@ -1852,6 +2280,7 @@ namespace Profiler
         float                                               m_FramesPerSec = {};
         uint32_t                                            m_FrameIndex = {};
         uint32_t                                            m_ThreadId = {};
+        std::vector<DeviceProfilerCpuSpanData>              m_Spans = {};
     };
 
     /***********************************************************************************\
@@ -1871,6 +2300,195 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Enumeration:
+        DeviceProfilerHitchRegionType
+
+    Description:
+        Types of regions monitored by the hitch detector.
+
+    \***********************************************************************************/
+    enum class DeviceProfilerHitchRegionType : uint32_t
+    {
+        ePipeline,
+        eRenderPass,
+        eDebugLabel
+    };
+
+    /***********************************************************************************\
+
+    Structure:
+        DeviceProfilerHitchData
+
+    Description:
+        Describes a region which GPU time in a frame exceeded its running average by
+        more than the configured number of standard deviations.
+
+        Only one of m_Pipeline, m_RenderPass and m_DebugLabel is valid, depending
+        on m_RegionType.
+
+    \***********************************************************************************/
+    struct DeviceProfilerHitchData
+    {
+        DeviceProfilerHitchRegionType                       m_RegionType = {};
+        DeviceProfilerPipeline                              m_Pipeline = {};
+        VkRenderPassHandle                                  m_RenderPass = {};
+        std::string                                         m_DebugLabel = {};
+
+        uint32_t                                            m_FrameIndex = {};
+        uint64_t                                            m_Ticks = {};
+        double                                              m_MeanTicks = {};
+        double                                              m_StdDevTicks = {};
+        double                                              m_P99Ticks = {};
+    };
+
+    /***********************************************************************************\
+
+    Structure:
+        DeviceProfilerPipelineCreationFeedbackData
+
+    Description:
+        Creation feedback reported by the driver for a single pipeline.
+
+        m_Flags and m_Duration are valid only if VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT
+        is set. Stage feedback is stored in the order of the shader stages in the
+        pipeline create info.
+
+    \***********************************************************************************/
+    struct DeviceProfilerPipelineCreationFeedbackData
+    {
+        struct Stage
+        {
+            VkShaderStageFlagBits                           m_Stage = {};
+            VkPipelineCreationFeedbackFlags                 m_Flags = {};
+            uint64_t                                        m_Duration = {};
+        };
+
+        DeviceProfilerPipeline                              m_Pipeline = {};
+        VkPipelineCreationFeedbackFlags                     m_Flags = {};
+        uint64_t                                            m_Duration = {};
+        std::vector<Stage>                                  m_Stages = {};
+
+        inline bool HasFeedback() const { return ( m_Flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT ) != 0; }
+        inline bool IsCacheHit() const { return ( m_Flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT ) != 0; }
+    };
+
+    /***********************************************************************************\
+
+    Structure:
+        DeviceProfilerPipelineCompilationData
+
+    Description:
+        Describes a single vkCreate*Pipelines call.
+
+        Timestamps are CPU timestamps in the same time domain as the frame's CPU
+        timestamps. For deferred ray tracing pipelines the end timestamp is the time
+        when the deferred operation has been joined.
+
+    \***********************************************************************************/
+    struct DeviceProfilerPipelineCompilationData
+    {
+        uint32_t                                            m_ThreadId = {};
+        uint64_t                                            m_BeginTimestamp = {};
+        uint64_t                                            m_EndTimestamp = {};
+        bool                                                m_Deferred = false;
+
+        std::vector<DeviceProfilerPipelineCreationFeedbackData> m_Pipelines = {};
+    };
+
+    /***********************************************************************************\
+
+    Enumeration:
+        DeviceProfilerCpuOverheadCategory
+
+    Description:
+        Parts of the layer in which the profiler spends CPU time.
+
+    \***********************************************************************************/
+    enum class DeviceProfilerCpuOverheadCategory : uint32_t
+    {
+        eCommandRecording,
+        eQueueSubmission,
+        eDataResolve,
+        eOutput,
+        eCount
+    };
+
+    /***********************************************************************************\
+
+    Enumeration:
+        DeviceProfilerHostMemoryOverheadCategory
+
+    Description:
+        Kinds of host memory allocated by the profiler.
+
+    \***********************************************************************************/
+    enum class DeviceProfilerHostMemoryOverheadCategory : uint32_t
+    {
+        eFrameData,
+        eMemorySnapshots,
+        eShaderBytecode,
+        ePipelineCreateInfos,
+        eCount
+    };
+
+    /***********************************************************************************\
+
+    Enumeration:
+        DeviceProfilerGpuMemoryOverheadCategory
+
+    Description:
+        Kinds of device memory allocated by the profiler.
+
+    \***********************************************************************************/
+    enum class DeviceProfilerGpuMemoryOverheadCategory : uint32_t
+    {
+        eQueryPools,
+        eQueryDataBuffers,
+        eIndirectArguments,
+        eCount
+    };
+
+    /***********************************************************************************\
+
+    Structure:
+        DeviceProfilerOverheadData
+
+    Description:
+        Resources used by the profiler itself.
+
+        CPU times are in nanoseconds and cover the time elapsed since the previous
+        collection (m_CpuMeasurementTime). Memory sizes are in bytes and describe the
+        state at the time of the collection.
+
+    \***********************************************************************************/
+    struct DeviceProfilerOverheadData
+    {
+        static constexpr size_t CpuCategoryCount = static_cast<size_t>( DeviceProfilerCpuOverheadCategory::eCount );
+        static constexpr size_t HostMemoryCategoryCount = static_cast<size_t>( DeviceProfilerHostMemoryOverheadCategory::eCount );
+        static constexpr size_t GpuMemoryCategoryCount = static_cast<size_t>( DeviceProfilerGpuMemoryOverheadCategory::eCount );
+
+        std::array<uint64_t, CpuCategoryCount>              m_CpuTime = {};
+        uint64_t                                            m_CpuMeasurementTime = {};
+
+        std::array<uint64_t, HostMemoryCategoryCount>       m_HostMemory = {};
+        std::array<uint64_t, GpuMemoryCategoryCount>        m_GpuMemory = {};
+
+        // Bytes of the command buffer data deep-copied while resolving the frames.
+        uint64_t                                            m_CopiedDataSize = {};
+
+        VkProfilerOverheadDegradationFlagsEXT               m_Degradations = {};
+
+        inline uint64_t GetCpuTime( DeviceProfilerCpuOverheadCategory category ) const { return m_CpuTime[ static_cast<size_t>( category ) ]; }
+        inline uint64_t GetHostMemory( DeviceProfilerHostMemoryOverheadCategory category ) const { return m_HostMemory[ static_cast<size_t>( category ) ]; }
+        inline uint64_t GetGpuMemory( DeviceProfilerGpuMemoryOverheadCategory category ) const { return m_GpuMemory[ static_cast<size_t>( category ) ]; }
+
+        inline uint64_t GetTotalCpuTime() const { uint64_t sum = 0; for( uint64_t time : m_CpuTime ) sum += time; return sum; }
+        inline uint64_t GetTotalHostMemory() const { uint64_t sum = 0; for( uint64_t size : m_HostMemory ) sum += size; return sum; }
+        inline uint64_t GetTotalGpuMemory() const { uint64_t sum = 0; for( uint64_t size : m_GpuMemory ) sum += size; return sum; }
+    };
+
+    /***********************************************************************************\
+
     Structure:
         DeviceProfilerFrameData
 
@@ -1897,6 +2515,16 @@ namespace Profiler
         DeviceProfilerPerformanceCountersData               m_PerformanceCounters = {};
 
         DeviceProfilerSynchronizationTimestamps             m_SyncTimestamps = {};
+
+        std::vector<DeviceProfilerHitchData>                m_Hitches = {};
+
+        std::vector<DeviceProfilerSemaphoreDependencyData>  m_SemaphoreDependencies = {};
+        uint64_t                                            m_CriticalPathTicks = {};
+
+        std::vector<DeviceProfilerPipelineCompilationData>  m_PipelineCompilations = {};
+        uint64_t                                            m_PipelineCompilationTicks = {};
+
+        DeviceProfilerOverheadData                          m_Overhead = {};
     };
 
     /***********************************************************************************\
@@ -1909,10 +2537,10 @@ namespace Profiler
     \***********************************************************************************/
     struct DeviceProfilerSubpassData::Data : public std::variant<
         DeviceProfilerPipelineData,
-        DeviceProfilerCommandBufferData>
+        DeviceProfilerCommandBufferDataPtr>
     {
         // Use std::variant's constructors.
-        using std::variant<DeviceProfilerPipelineData, DeviceProfilerCommandBufferData>::variant;
+        using std::variant<DeviceProfilerPipelineData, DeviceProfilerCommandBufferDataPtr>::variant;
 
         constexpr DeviceProfilerSubpassDataType GetType() const
         {
@@ -1926,7 +2554,7 @@ namespace Profiler
             case DeviceProfilerSubpassDataType::ePipeline:
                 return std::get<DeviceProfilerPipelineData>( *this ).GetBeginTimestamp();
             case DeviceProfilerSubpassDataType::eCommandBuffer:
-                return std::get<DeviceProfilerCommandBufferData>( *this ).GetBeginTimestamp();
+                return std::get<DeviceProfilerCommandBufferDataPtr>( *this )->GetBeginTimestamp();
             default:
                 return DeviceProfilerTimestamp();
             }
@@ -1939,7 +2567,7 @@ namespace Profiler
             case DeviceProfilerSubpassDataType::ePipeline:
                 return std::get<DeviceProfilerPipelineData>( *this ).GetEndTimestamp();
             case DeviceProfilerSubpassDataType::eCommandBuffer:
-                return std::get<DeviceProfilerCommandBufferData>( *this ).GetEndTimestamp();
+                return std::get<DeviceProfilerCommandBufferDataPtr>( *this )->GetEndTimestamp();
             default:
                 return DeviceProfilerTimestamp();
             }
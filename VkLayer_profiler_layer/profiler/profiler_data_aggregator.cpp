@@ -26,6 +26,7 @@
 #include "profiler_performance_counters.h"
 #include <assert.h>
 #include <algorithm>
+#include <iterator>
 #include <unordered_set>
 
 namespace Profiler
@@ -192,10 +193,18 @@ namespace Profiler
         , m_DataCollectionThread()
         , m_DataCollectionThreadRunning( false )
         , m_pResolvedFrames()
+        , m_ResolvedFramesMutex()
         , m_pPendingFrames()
-        , m_Mutex()
+        , m_AggregateMutex()
+        , m_FrameEnds()
+        , m_FrameEndsMutex()
+        , m_NextSubmitIndex( 0 )
+        , m_LastSubmitFrameIndex( UINT32_MAX )
+        , m_FrameBeginMutex()
+        , m_HitchDetector()
+        , m_CriticalPathAnalyzer()
         , m_MaxResolvedFrameCount( 1 )
-        , m_CopyCommandPools()
+        , m_SubmitLanes()
     {
     }
 
@@ -214,7 +223,7 @@ namespace Profiler
 
         VkResult result = VK_SUCCESS;
 
-        // Create command pools to copy query data using GPU.
+        // Create submission lanes with command pools to copy query data using GPU.
         for( const auto& [queue, queueObj] : m_pProfiler->m_pDevice->Queues )
         {
             VkCommandPoolCreateInfo commandPoolCreateInfo = {};
@@ -234,7 +243,7 @@ namespace Profiler
                 break;
             }
 
-            m_CopyCommandPools.try_emplace( queue, *m_pProfiler, commandPool, commandPoolCreateInfo );
+            m_SubmitLanes.try_emplace( queue, *m_pProfiler, commandPool, commandPoolCreateInfo );
         }
 
         // Prepare the initial frame with no data.
@@ -247,6 +256,12 @@ namespace Profiler
         pInitFrame->m_Memory = m_pProfiler->m_MemoryTracker.GetMemoryData();
         m_pResolvedFrames.push_back( pInitFrame );
 
+        // Setup detection of hitches in the resolved frames.
+        m_HitchDetector.Initialize( m_pProfiler->m_Config.m_HitchDetectionThreshold );
+
+        // Setup analysis of the dependencies between the queues.
+        m_CriticalPathAnalyzer.Initialize( m_pProfiler->m_pDevice->pPhysicalDevice->Properties.limits.timestampPeriod );
+
         // Try to start data collection thread.
         if( m_pProfiler->m_Config.m_EnableThreading )
         {
@@ -282,7 +297,22 @@ namespace Profiler
     {
         StopDataCollectionThread();
 
-        m_CopyCommandPools.clear();
+        // Free the submit batches that have not been aggregated.
+        for( auto& [queue, submitLane] : m_SubmitLanes )
+        {
+            DrainSubmitLane( submitLane );
+
+            for( std::unique_ptr<SubmitBatch>& pSubmitBatch : submitLane.m_pPendingSubmits )
+            {
+                FreeDynamicAllocations( *pSubmitBatch );
+            }
+        }
+
+        m_SubmitLanes.clear();
+        m_pPendingFrames.clear();
+        m_FrameEnds.clear();
+        m_HitchDetector.Destroy();
+        m_CriticalPathAnalyzer.Destroy();
         m_pProfiler = nullptr;
     }
 
@@ -315,7 +345,7 @@ namespace Profiler
     \***********************************************************************************/
     void ProfilerDataAggregator::SetDataBufferSize( uint32_t maxFrames )
     {
-        std::scoped_lock lk( m_Mutex );
+        std::scoped_lock lk( m_ResolvedFramesMutex );
         m_MaxResolvedFrameCount = maxFrames;
     }
 
@@ -327,13 +357,32 @@ namespace Profiler
     Description:
         Add submit data to the aggregator.
 
+        The submit batch is appended to the lane of the submitted queue without
+        locking, so the threads submitting to different queues do not contend.
+        The batches are merged into frames by the thread that aggregates the data.
+
     \***********************************************************************************/
     void ProfilerDataAggregator::AppendSubmit( uint32_t frameIndex, const DeviceProfilerSubmitBatch& submit )
     {
         TipGuard tip( m_pProfiler->m_pDevice->TIP, __func__ );
 
         // Prepare submit batch info.
-        SubmitBatch submitBatch( submit );
+        auto pSubmitBatch = std::make_unique<SubmitBatch>( submit );
+        SubmitBatch& submitBatch = *pSubmitBatch;
+        submitBatch.m_FrameIndex = frameIndex;
+        submitBatch.m_SubmitIndex = m_NextSubmitIndex.fetch_add( 1, std::memory_order_relaxed );
+
+        // Capture the frame properties when the submission begins a new frame, so they are
+        // not affected by how long the batch waits in the lane before it is aggregated.
+        if( m_LastSubmitFrameIndex.exchange( frameIndex, std::memory_order_relaxed ) != frameIndex )
+        {
+            // Synchronization timestamps are exchanged for the next frame.
+            std::scoped_lock lk( m_FrameBeginMutex );
+            submitBatch.m_BeginsFrame = true;
+            submitBatch.m_FramesPerSec = m_pProfiler->m_CpuFpsCounter.GetValue();
+            submitBatch.m_FrameDelimiter = static_cast<VkProfilerFrameDelimiterEXT>( m_pProfiler->m_Config.m_FrameDelimiter.value );
+            submitBatch.m_SyncTimestamps = m_pProfiler->GetSynchronizationTimestamps();
+        }
 
         for( const DeviceProfilerSubmit& _submit : submitBatch.m_Submits )
         {
@@ -372,33 +421,22 @@ namespace Profiler
             return;
         }
 
-        // Synchronize with data collection thread.
-        std::scoped_lock lk( m_Mutex );
-        std::shared_ptr<Frame> pFrame = GetPendingFrame( frameIndex );
+        // Push the submit batch to the lane of the queue.
+        SubmitLane& submitLane = m_SubmitLanes.at( submit.m_Handle );
+        SubmitBatch* pIncomingSubmits = submitLane.m_pIncomingSubmits.load( std::memory_order_relaxed );
 
-        if( pFrame == nullptr )
+        do
         {
-            pFrame = std::make_shared<Frame>();
-            pFrame->m_FrameIndex = frameIndex;
-            pFrame->m_ThreadId = submit.m_ThreadId;
-            pFrame->m_Timestamp = submit.m_Timestamp;
-            pFrame->m_FramesPerSec = m_pProfiler->m_CpuFpsCounter.GetValue();
-            pFrame->m_FrameDelimiter = static_cast<VkProfilerFrameDelimiterEXT>( m_pProfiler->m_Config.m_FrameDelimiter.value );
-            pFrame->m_SyncTimestamps = m_pProfiler->GetSynchronizationTimestamps();
-
-            m_pPendingFrames.push_back( pFrame );
+            submitBatch.m_pNext = pIncomingSubmits;
         }
-
-        Frame& frame = *pFrame;
-        submitBatch.m_SubmitBatchDataIndex = static_cast<uint32_t>( frame.m_CompleteSubmits.size() );
-
-        DeviceProfilerSubmitBatchData& submitBatchData = frame.m_CompleteSubmits.emplace_back();
-        submitBatchData.m_Handle = submit.m_Handle;
-        submitBatchData.m_ThreadId = submit.m_ThreadId;
-        submitBatchData.m_Timestamp = submit.m_Timestamp;
-
-        // Append the submit to the last frame in the queue.
-        frame.m_PendingSubmits.push_back( std::move( submitBatch ) );
+        while( !submitLane.m_pIncomingSubmits.compare_exchange_weak(
+            pIncomingSubmits,
+            pSubmitBatch.get(),
+            std::memory_order_release,
+            std::memory_order_relaxed ) );
+
+        // The batch is owned by the lane now.
+        pSubmitBatch.release();
     }
 
     /***********************************************************************************\
@@ -416,17 +454,13 @@ namespace Profiler
     {
         TipGuard tip( m_pProfiler->m_pDevice->TIP, __func__ );
 
-        const uint64_t timestamp = m_pProfiler->m_CpuTimestampCounter.GetCurrentValue();
-
-        // Synchronize with data collection thread.
-        std::scoped_lock lk( m_Mutex );
-        std::shared_ptr<Frame> pFrame = GetPendingFrame( frameIndex );
+        FrameEnd frameEnd;
+        frameEnd.m_FrameIndex = frameIndex;
+        frameEnd.m_Timestamp = m_pProfiler->m_CpuTimestampCounter.GetCurrentValue();
 
-        if( pFrame )
-        {
-            pFrame->m_EndTimestamp = timestamp;
-            pFrame->m_Ended = true;
-        }
+        // The frame is marked as ended by the thread that aggregates the data.
+        std::scoped_lock lk( m_FrameEndsMutex );
+        m_FrameEnds.push_back( frameEnd );
     }
 
     /***********************************************************************************\
@@ -442,16 +476,12 @@ namespace Profiler
     {
         TipGuard tip( m_pProfiler->m_pDevice->TIP, __func__ );
 
-        const uint64_t timestamp = m_pProfiler->m_CpuTimestampCounter.GetCurrentValue();
+        FrameEnd frameEnd;
+        frameEnd.m_Timestamp = m_pProfiler->m_CpuTimestampCounter.GetCurrentValue();
+        frameEnd.m_AllFrames = true;
 
-        // Synchronize with data collection thread.
-        std::scoped_lock lk( m_Mutex );
-
-        for( std::shared_ptr<Frame>& pFrame : m_pPendingFrames )
-        {
-            pFrame->m_EndTimestamp = timestamp;
-            pFrame->m_Ended = true;
-        }
+        std::scoped_lock lk( m_FrameEndsMutex );
+        m_FrameEnds.push_back( frameEnd );
     }
 
     /***********************************************************************************\
@@ -467,25 +497,29 @@ namespace Profiler
     {
         TipGuard tip( m_pProfiler->m_pDevice->TIP, __func__ );
 
-        std::unique_lock uniqueLock( m_Mutex, std::defer_lock );
+        DeviceProfilerOverheadScope overhead( m_pProfiler->m_Overhead, DeviceProfilerCpuOverheadCategory::eDataResolve );
+
+        std::unique_lock aggregateLock( m_AggregateMutex, std::defer_lock );
 
         // The synchronization may be required if a command buffer is being freed.
         // In such case, the profiler has to wait for the timestamp data.
         if( pWaitForCommandBuffer )
         {
-            // Acquire a shared lock so other thread doesn't free the fences while this thread waits.
-            std::shared_lock sharedLock( m_Mutex );
+            aggregateLock.lock();
+
             std::vector<VkFence> waitFences;
 
             // Wait for all pending submits that reference the command buffer.
-            for( const std::shared_ptr<Frame>& pFrame : m_pPendingFrames )
+            for( auto& [queue, submitLane] : m_SubmitLanes )
             {
-                for( const SubmitBatch& submitBatch : pFrame->m_PendingSubmits )
+                DrainSubmitLane( submitLane );
+
+                for( const std::unique_ptr<SubmitBatch>& pSubmitBatch : submitLane.m_pPendingSubmits )
                 {
-                    if( submitBatch.m_pSubmittedCommandBuffers.count( pWaitForCommandBuffer ) )
+                    if( pSubmitBatch->m_pSubmittedCommandBuffers.count( pWaitForCommandBuffer ) )
                     {
                         // Wait for this submit batch.
-                        waitFences.push_back( submitBatch.m_DataCopyFence );
+                        waitFences.push_back( pSubmitBatch->m_DataCopyFence );
                     }
                 }
             }
@@ -501,104 +535,154 @@ namespace Profiler
                     UINT64_MAX );
             }
 
-            // Force synchronization because the command buffer is about to be destroyed.
-            sharedLock.unlock();
-            uniqueLock.lock();
-        }
-        else
-        {
-            // Don't aggregate if another thread already processes the data.
-            if( !uniqueLock.try_lock() )
+            // Complete the submits that reference the command buffer, because it is about to be destroyed.
+            for( auto& [queue, submitLane] : m_SubmitLanes )
             {
-                return;
+                auto submitBatchIt = submitLane.m_pPendingSubmits.begin();
+                while( submitBatchIt != submitLane.m_pPendingSubmits.end() )
+                {
+                    if( ( *submitBatchIt )->m_pSubmittedCommandBuffers.count( pWaitForCommandBuffer ) )
+                    {
+                        CompleteSubmitBatch( **submitBatchIt );
+                        submitBatchIt = submitLane.m_pPendingSubmits.erase( submitBatchIt );
+                    }
+                    else
+                    {
+                        submitBatchIt = std::next( submitBatchIt );
+                    }
+                }
             }
+
+            return;
+        }
+
+        // Don't aggregate if another thread already processes the data.
+        if( !aggregateLock.try_lock() )
+        {
+            return;
+        }
+
+        // Take the frame ends before draining the lanes, so all submits appended before
+        // the end of the frame are already in the pending frames when it is applied.
+        std::vector<FrameEnd> frameEnds;
+        {
+            std::scoped_lock lk( m_FrameEndsMutex );
+            std::swap( frameEnds, m_FrameEnds );
         }
 
         // Check if any submit has completed.
-        for( const std::shared_ptr<Frame>& pFrame : m_pPendingFrames )
+        for( auto& [queue, submitLane] : m_SubmitLanes )
         {
-            auto submitBatchIt = pFrame->m_PendingSubmits.begin();
-            while( submitBatchIt != pFrame->m_PendingSubmits.end() )
+            DrainSubmitLane( submitLane );
+
+            // Data copies on the same queue complete in submission order, so the lane
+            // can be skipped after the first submit that is still in flight.
+            while( !submitLane.m_pPendingSubmits.empty() )
             {
-                VkResult result = VK_NOT_READY;
+                SubmitBatch& submitBatch = *submitLane.m_pPendingSubmits.front();
 
-                // Aggregate only submits that contain the specified command buffer.
-                if( !pWaitForCommandBuffer || submitBatchIt->m_pSubmittedCommandBuffers.count( pWaitForCommandBuffer ) )
-                {
-                    result = m_pProfiler->m_pDevice->Callbacks.GetFenceStatus(
-                        m_pProfiler->m_pDevice->Handle,
-                        submitBatchIt->m_DataCopyFence );
-                }
+                VkResult result = m_pProfiler->m_pDevice->Callbacks.GetFenceStatus(
+                    m_pProfiler->m_pDevice->Handle,
+                    submitBatch.m_DataCopyFence );
 
-                if( result == VK_SUCCESS )
+                if( result != VK_SUCCESS )
                 {
-                    bool succeeded = true;
-                    if( !submitBatchIt->m_pDataBuffer->UsesGpuAllocation() )
-                    {
-                        succeeded = WriteQueryDataToCpuBuffer( *submitBatchIt );
-                    }
-
-                    if( succeeded )
-                    {
-                        ResolveSubmitBatchData(
-                            *submitBatchIt,
-                            pFrame->m_CompleteSubmits[submitBatchIt->m_SubmitBatchDataIndex] );
-                    }
+                    break;
+                }
 
-                    FreeDynamicAllocations( *submitBatchIt );
+                CompleteSubmitBatch( submitBatch );
+                submitLane.m_pPendingSubmits.pop_front();
+            }
+        }
 
-                    submitBatchIt = pFrame->m_PendingSubmits.erase( submitBatchIt );
-                }
-                else
+        // Mark the frames as ended.
+        for( const FrameEnd& frameEnd : frameEnds )
+        {
+            if( frameEnd.m_AllFrames )
+            {
+                for( auto& [frameIndex, pFrame] : m_pPendingFrames )
                 {
-                    submitBatchIt = std::next( submitBatchIt );
+                    pFrame->m_EndTimestamp = frameEnd.m_Timestamp;
+                    pFrame->m_Ended = true;
                 }
             }
+            else if( std::shared_ptr<Frame> pFrame = GetPendingFrame( frameEnd.m_FrameIndex ) )
+            {
+                pFrame->m_EndTimestamp = frameEnd.m_Timestamp;
+                pFrame->m_Ended = true;
+            }
         }
 
         // Check if any frame has completed.
-        if( !pWaitForCommandBuffer )
+        while( !m_pPendingFrames.empty() )
         {
-            while( !m_pPendingFrames.empty()  )
+            std::shared_ptr<Frame> pFrame = m_pPendingFrames.begin()->second;
+
+            // A frame is completed when all its submits have been processed and no more are expected.
+            const bool frameCompleted =
+                ( pFrame->m_Ended ) &&
+                ( pFrame->m_PendingSubmitCount == 0 );
+
+            if( !frameCompleted )
             {
-                std::shared_ptr<Frame> pFrame = m_pPendingFrames.front();
+                // This, and all subsequent frames, are not completed yet.
+                break;
+            }
 
-                // A frame is completed when all its submits have been processed and no more are expected.
-                const bool frameCompleted =
-                    ( pFrame->m_Ended ) &&
-                    ( pFrame->m_PendingSubmits.empty() );
+            m_pPendingFrames.erase( m_pPendingFrames.begin() );
 
-                if( !frameCompleted )
-                {
-                    // This, and all subsequent frames, are not completed yet.
-                    break;
-                }
+            // Resolving frame data is time consuming, release the lock while processing to avoid
+            // blocking the threads that free the command buffers.
+            aggregateLock.unlock();
+
+            // Merge the submits from all lanes in submission order.
+            for( auto& [submitIndex, submitBatchData] : pFrame->m_ResolvedSubmits )
+            {
+                pFrame->m_CompleteSubmits.push_back( std::move( submitBatchData ) );
+            }
 
-                m_pPendingFrames.pop_front();
+            pFrame->m_ResolvedSubmits.clear();
 
-                // Resolving frame data is time consuming, release the lock while processing to avoid
-                // blocking recording of the next frames.
-                uniqueLock.unlock();
+            std::shared_ptr<DeviceProfilerFrameData> pFrameData = std::make_shared<DeviceProfilerFrameData>();
+            ResolveFrameData( *pFrame, *pFrameData );
 
-                std::shared_ptr<DeviceProfilerFrameData> pFrameData = std::make_shared<DeviceProfilerFrameData>();
-                ResolveFrameData( *pFrame, *pFrameData );
+            // Find the critical path through the submits of the frame.
+            m_CriticalPathAnalyzer.ProcessFrame( *pFrameData );
 
-                pFrame.reset();
+            // Update statistics of the regions before the frame may be dropped from the buffer.
+            m_HitchDetector.ProcessFrame( *pFrameData );
 
-                // Re-acquire the lock to update the resolved frames list.
-                uniqueLock.lock();
+            pFrame.reset();
+
+            // Update the resolved frames list.
+            {
+                std::scoped_lock lk( m_ResolvedFramesMutex );
 
                 // Remove unconsumed frames.
                 if( m_MaxResolvedFrameCount != 0 )
                 {
+                    std::vector<DeviceProfilerHitchData> droppedHitches;
+
                     while( m_pResolvedFrames.size() >= m_MaxResolvedFrameCount )
                     {
+                        // Keep the hitches detected in the removed frames.
+                        std::vector<DeviceProfilerHitchData>& hitches = m_pResolvedFrames.front()->m_Hitches;
+                        std::move( hitches.begin(), hitches.end(), std::back_inserter( droppedHitches ) );
+
                         m_pResolvedFrames.pop_front();
                     }
+
+                    pFrameData->m_Hitches.insert(
+                        pFrameData->m_Hitches.begin(),
+                        std::make_move_iterator( droppedHitches.begin() ),
+                        std::make_move_iterator( droppedHitches.end() ) );
                 }
 
                 m_pResolvedFrames.push_back( std::move( pFrameData ) );
             }
+
+            // Re-acquire the lock to check the next frames.
+            aggregateLock.lock();
         }
     }
 
@@ -612,7 +696,7 @@ namespace Profiler
     \***********************************************************************************/
     std::list<std::shared_ptr<DeviceProfilerFrameData>> ProfilerDataAggregator::GetAggregatedData()
     {
-        std::scoped_lock lk( m_Mutex );
+        std::scoped_lock lk( m_ResolvedFramesMutex );
         std::list<std::shared_ptr<DeviceProfilerFrameData>> pResolvedFrames;
         std::swap( pResolvedFrames, m_pResolvedFrames );
         return pResolvedFrames;
@@ -624,21 +708,115 @@ namespace Profiler
         GetPendingFrame
 
     Description:
-        Get the frame with the given index from the pending frames list.
-        m_Mutex must be locked by the caller.
+        Get the frame with the given index from the pending frames.
+        m_AggregateMutex must be locked by the caller.
 
     \***********************************************************************************/
     std::shared_ptr<ProfilerDataAggregator::Frame> ProfilerDataAggregator::GetPendingFrame( uint32_t frameIndex ) const
     {
-        for( std::shared_ptr<Frame> pFrame : m_pPendingFrames )
+        auto it = m_pPendingFrames.find( frameIndex );
+        if( it != m_pPendingFrames.end() )
         {
-            if( pFrame->m_FrameIndex == frameIndex )
+            return it->second;
+        }
+
+        return nullptr;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        DrainSubmitLane
+
+    Description:
+        Move the submit batches appended by the application threads to the pending
+        submits of the lane and register them in their frames.
+        m_AggregateMutex must be locked by the caller.
+
+    \***********************************************************************************/
+    void ProfilerDataAggregator::DrainSubmitLane( SubmitLane& submitLane )
+    {
+        SubmitBatch* pSubmitBatch = submitLane.m_pIncomingSubmits.exchange( nullptr, std::memory_order_acquire );
+
+        // The incoming submits are linked in reverse order.
+        auto insertIt = submitLane.m_pPendingSubmits.end();
+
+        while( pSubmitBatch != nullptr )
+        {
+            SubmitBatch* pNextSubmitBatch = std::exchange( pSubmitBatch->m_pNext, nullptr );
+            const SubmitBatch& submitBatch = *pSubmitBatch;
+
+            // Insert the older batches before the newer ones.
+            insertIt = submitLane.m_pPendingSubmits.emplace( insertIt, pSubmitBatch );
+
+            std::shared_ptr<Frame>& pFrame = m_pPendingFrames[ submitBatch.m_FrameIndex ];
+            if( pFrame == nullptr )
             {
-                return pFrame;
+                pFrame = std::make_shared<Frame>();
+                pFrame->m_FrameIndex = submitBatch.m_FrameIndex;
             }
+
+            // Use the properties captured by the earliest batch that began the frame.
+            // Batches from different lanes may be drained in any order.
+            if( submitBatch.m_BeginsFrame && ( submitBatch.m_SubmitIndex < pFrame->m_FrameBeginSubmitIndex ) )
+            {
+                pFrame->m_FrameBeginSubmitIndex = submitBatch.m_SubmitIndex;
+                pFrame->m_FramesPerSec = submitBatch.m_FramesPerSec;
+                pFrame->m_FrameDelimiter = submitBatch.m_FrameDelimiter;
+                pFrame->m_SyncTimestamps = submitBatch.m_SyncTimestamps;
+            }
+
+            // The frame begins with its first submission, regardless of the lane it came from.
+            if( submitBatch.m_SubmitIndex < pFrame->m_FirstSubmitIndex )
+            {
+                pFrame->m_FirstSubmitIndex = submitBatch.m_SubmitIndex;
+                pFrame->m_ThreadId = submitBatch.m_ThreadId;
+                pFrame->m_Timestamp = submitBatch.m_Timestamp;
+            }
+
+            DeviceProfilerSubmitBatchData& submitBatchData = pFrame->m_ResolvedSubmits[ submitBatch.m_SubmitIndex ];
+            submitBatchData.m_Handle = submitBatch.m_Handle;
+            submitBatchData.m_ThreadId = submitBatch.m_ThreadId;
+            submitBatchData.m_Timestamp = submitBatch.m_Timestamp;
+
+            pFrame->m_PendingSubmitCount++;
+
+            pSubmitBatch = pNextSubmitBatch;
         }
+    }
 
-        return nullptr;
+    /***********************************************************************************\
+
+    Function:
+        CompleteSubmitBatch
+
+    Description:
+        Resolve the data of the submit batch whose query data copy has completed and
+        free its resources.
+        m_AggregateMutex must be locked by the caller.
+
+    \***********************************************************************************/
+    void ProfilerDataAggregator::CompleteSubmitBatch( SubmitBatch& submitBatch )
+    {
+        std::shared_ptr<Frame> pFrame = GetPendingFrame( submitBatch.m_FrameIndex );
+        assert( pFrame != nullptr );
+
+        bool succeeded = true;
+        if( !submitBatch.m_pDataBuffer->UsesGpuAllocation() )
+        {
+            succeeded = WriteQueryDataToCpuBuffer( submitBatch );
+        }
+
+        if( succeeded )
+        {
+            ResolveSubmitBatchData(
+                submitBatch,
+                pFrame->m_ResolvedSubmits.at( submitBatch.m_SubmitIndex ) );
+        }
+
+        FreeDynamicAllocations( submitBatch );
+
+        pFrame->m_PendingSubmitCount--;
     }
 
     /***********************************************************************************\
@@ -673,17 +851,19 @@ namespace Profiler
             for( const auto& pCommandBuffer : submit.m_pCommandBuffers )
             {
                 // Collect command buffer data
-                const DeviceProfilerCommandBufferData& commandBufferData = pCommandBuffer->GetData( reader );
+                DeviceProfilerCommandBufferDataPtr pCommandBufferData = pCommandBuffer->GetData( reader );
 
                 // Skip if instrumentation was disabled for this command buffer
-                if( commandBufferData.m_DataValid )
+                if( pCommandBufferData->m_DataValid )
                 {
-                    submitData.m_CommandBuffers.push_back( commandBufferData );
-
                     submitData.m_BeginTimestamp.m_Value = std::min(
-                        submitData.m_BeginTimestamp.m_Value, commandBufferData.m_BeginTimestamp.m_Value );
+                        submitData.m_BeginTimestamp.m_Value, pCommandBufferData->m_BeginTimestamp.m_Value );
                     submitData.m_EndTimestamp.m_Value = std::max(
-                        submitData.m_EndTimestamp.m_Value, commandBufferData.m_EndTimestamp.m_Value );
+                        submitData.m_EndTimestamp.m_Value, pCommandBufferData->m_EndTimestamp.m_Value );
+
+                    // The data is shared with the command buffer, which copies it only if it is resolved again
+                    // while this frame still references it.
+                    submitData.m_CommandBuffers.push_back( std::move( pCommandBufferData ) );
                 }
             }
         }
@@ -715,8 +895,9 @@ namespace Profiler
         {
             for( const auto& submit : submitBatch.m_Submits )
             {
-                for( const auto& commandBuffer : submit.m_CommandBuffers )
+                for( const auto& pCommandBuffer : submit.m_CommandBuffers )
                 {
+                    const DeviceProfilerCommandBufferData& commandBuffer = *pCommandBuffer;
                     frameData.m_Stats += commandBuffer.m_Stats;
                     frameData.m_Ticks += ( commandBuffer.m_EndTimestamp.m_Value - commandBuffer.m_BeginTimestamp.m_Value );
                     frameData.m_BeginTimestamp = std::min( frameData.m_BeginTimestamp, commandBuffer.m_BeginTimestamp.m_Value );
@@ -750,11 +931,6 @@ namespace Profiler
                     frameData.m_BeginTimestamp,
                     frameData.m_EndTimestamp,
                     frameData.m_PerformanceCounters );
-
-                // Post-process the data.
-                AggregatePerformanceStreamMetrics(
-                    frame.m_CompleteSubmits,
-                    frameData.m_PerformanceCounters );
                 break;
             }
         }
@@ -990,8 +1166,9 @@ namespace Profiler
         {
             for( const auto& submitData : submitBatchData.m_Submits )
             {
-                for( const auto& commandBufferData : submitData.m_CommandBuffers )
+                for( const auto& pCommandBufferData : submitData.m_CommandBuffers )
                 {
+                    const DeviceProfilerCommandBufferData& commandBufferData = *pCommandBufferData;
                     if( commandBufferData.m_PerformanceCounters.m_MetricsSetIndex != performanceMetricsSetIndex )
                     {
                         // The command buffer has been recorded with at different set of metrics.
@@ -1072,33 +1249,6 @@ namespace Profiler
 
     /***********************************************************************************\
 
-    Function:
-        AggregatePerformanceStreamMetrics
-
-    Description:
-        Patch metrics set index in the command buffer performance data.
-
-    \***********************************************************************************/
-    void ProfilerDataAggregator::AggregatePerformanceStreamMetrics(
-        ContainerType<DeviceProfilerSubmitBatchData>& submits,
-        DeviceProfilerPerformanceCountersData& frameData ) const
-    {
-        TipGuard tip( m_pProfiler->m_pDevice->TIP, __func__ );
-
-        for( auto& submitBatchData : submits )
-        {
-            for( auto& submitData : submitBatchData.m_Submits )
-            {
-                for( auto& commandBufferData : submitData.m_CommandBuffers )
-                {
-                    commandBufferData.m_PerformanceCounters.m_MetricsSetIndex = frameData.m_MetricsSetIndex;
-                }
-            }
-        }
-    }
-
-    /***********************************************************************************\
-
     Function:
         CollectTopPipelines
 
@@ -1118,9 +1268,9 @@ namespace Profiler
         {
             for( const auto& submit : submitBatch.m_Submits )
             {
-                for( const auto& commandBuffer : submit.m_CommandBuffers )
+                for( const auto& pCommandBuffer : submit.m_CommandBuffers )
                 {
-                    CollectPipelinesFromCommandBuffer( commandBuffer, aggregatedPipelines );
+                    CollectPipelinesFromCommandBuffer( *pCommandBuffer, aggregatedPipelines );
                 }
             }
         }
@@ -1128,9 +1278,9 @@ namespace Profiler
         // Sort by time
         ContainerType<DeviceProfilerPipelineData> pipelines;
 
-        for( const auto& [_, aggregatedPipeline] : aggregatedPipelines )
+        for( auto& [_, aggregatedPipeline] : aggregatedPipelines )
         {
-            pipelines.push_back( aggregatedPipeline );
+            pipelines.push_back( std::move( aggregatedPipeline ) );
         }
 
         std::sort( pipelines.begin(), pipelines.end(),
@@ -1188,7 +1338,7 @@ namespace Profiler
                 {
                     for( const auto& data : subpass.m_Data )
                     {
-                        CollectPipelinesFromCommandBuffer( std::get<DeviceProfilerCommandBufferData>( data ), aggregatedPipelines );
+                        CollectPipelinesFromCommandBuffer( *std::get<DeviceProfilerCommandBufferDataPtr>( data ), aggregatedPipelines );
                     }
                 }
 
@@ -1203,7 +1353,7 @@ namespace Profiler
                             CollectPipeline( std::get<DeviceProfilerPipelineData>( data ), aggregatedPipelines, topLevelPipelineRanges );
                             break;
                         case DeviceProfilerSubpassDataType::eCommandBuffer:
-                            CollectPipelinesFromCommandBuffer( std::get<DeviceProfilerCommandBufferData>( data ), aggregatedPipelines );
+                            CollectPipelinesFromCommandBuffer( *std::get<DeviceProfilerCommandBufferDataPtr>( data ), aggregatedPipelines );
                             break;
                         }
                     }
@@ -1337,7 +1487,7 @@ namespace Profiler
         if( submitBatch.m_pDataBuffer->UsesGpuAllocation() )
         {
             // Get the command pool associated with the queue.
-            DeviceProfilerInternalCommandPool& commandPool = m_CopyCommandPools.at( submitBatch.m_Handle );
+            DeviceProfilerInternalCommandPool& commandPool = m_SubmitLanes.at( submitBatch.m_Handle ).m_CopyCommandPool;
             submitBatch.m_pDataCopyCommandPool = &commandPool;
 
             // Synchronize access to the command pool.
@@ -22,9 +22,14 @@
 #include "profiler_data.h"
 #include "profiler_command_buffer.h"
 #include "profiler_command_pool.h"
+#include "profiler_critical_path.h"
+#include "profiler_hitch_detector.h"
+#include <atomic>
 #include <list>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
-#include <shared_mutex>
 #include <thread>
 #include <unordered_set>
 #include <unordered_map>
@@ -70,14 +75,48 @@ namespace Profiler
             VkCommandBuffer                             m_DataCopyCommandBuffer = {};
             VkFence                                     m_DataCopyFence = {};
 
-            uint32_t                                    m_SubmitBatchDataIndex = 0;
+            uint32_t                                    m_FrameIndex = 0;
+            uint64_t                                    m_SubmitIndex = 0;
             std::unordered_set<ProfilerCommandBuffer*>  m_pSubmittedCommandBuffers = {};
 
+            // Frame properties captured at submission by the batch that began a new frame.
+            bool                                        m_BeginsFrame = false;
+            float                                       m_FramesPerSec = 0;
+            VkProfilerFrameDelimiterEXT                 m_FrameDelimiter = {};
+            DeviceProfilerSynchronizationTimestamps     m_SyncTimestamps = {};
+
+            // Next submit batch in the incoming submits list of the lane.
+            SubmitBatch*                                m_pNext = nullptr;
+
             SubmitBatch( const DeviceProfilerSubmitBatch& submitBatch )
                 : DeviceProfilerSubmitBatch( submitBatch )
             {}
         };
 
+        struct SubmitLane
+        {
+            // Command pool used for copying query data on the lane's queue.
+            DeviceProfilerInternalCommandPool           m_CopyCommandPool;
+
+            // Lock-free list of the submit batches appended by the application threads, in reverse order.
+            std::atomic<SubmitBatch*>                   m_pIncomingSubmits = nullptr;
+
+            // Submit batches waiting for the query data, in submission order.
+            // Accessed only by the thread that aggregates the data.
+            std::list<std::unique_ptr<SubmitBatch>>     m_pPendingSubmits = {};
+
+            SubmitLane( DeviceProfiler& profiler, VkCommandPool commandPool, const VkCommandPoolCreateInfo& createInfo )
+                : m_CopyCommandPool( profiler, commandPool, createInfo )
+            {}
+        };
+
+        struct FrameEnd
+        {
+            uint32_t                                    m_FrameIndex = 0;
+            uint64_t                                    m_Timestamp = 0;
+            bool                                        m_AllFrames = false;
+        };
+
         struct Frame
         {
             uint32_t                                    m_FrameIndex = 0;
@@ -87,7 +126,12 @@ namespace Profiler
             VkProfilerFrameDelimiterEXT                 m_FrameDelimiter = {};
             DeviceProfilerSynchronizationTimestamps     m_SyncTimestamps = {};
 
-            std::list<SubmitBatch>                      m_PendingSubmits = {};
+            uint64_t                                    m_FirstSubmitIndex = UINT64_MAX;
+            uint64_t                                    m_FrameBeginSubmitIndex = UINT64_MAX;
+            uint32_t                                    m_PendingSubmitCount = 0;
+
+            // Submit batches from all lanes, ordered by submission.
+            std::map<uint64_t, DeviceProfilerSubmitBatchData> m_ResolvedSubmits = {};
             std::deque<DeviceProfilerSubmitBatchData>   m_CompleteSubmits = {};
 
             uint64_t                                    m_EndTimestamp = {};
@@ -121,23 +165,44 @@ namespace Profiler
         std::atomic_bool m_DataCollectionThreadRunning;
 
         std::list<std::shared_ptr<DeviceProfilerFrameData>> m_pResolvedFrames;
-        std::list<std::shared_ptr<Frame>> m_pPendingFrames;
+        std::mutex m_ResolvedFramesMutex;
 
-        std::shared_mutex m_Mutex;
+        // Frames with pending submits, indexed by the frame index.
+        std::map<uint32_t, std::shared_ptr<Frame>> m_pPendingFrames;
+        std::mutex m_AggregateMutex;
+
+        // Ends of the frames requested by the application threads since the last aggregation.
+        std::vector<FrameEnd> m_FrameEnds;
+        std::mutex m_FrameEndsMutex;
+
+        // Order of the submit batches across all lanes.
+        std::atomic_uint64_t m_NextSubmitIndex;
+
+        // Frame index of the most recent submit batch, used to detect beginning of a new frame.
+        std::atomic_uint32_t m_LastSubmitFrameIndex;
+        std::mutex m_FrameBeginMutex;
+
+        // Statistics of the regions across all resolved frames
+        DeviceProfilerHitchDetector m_HitchDetector;
+
+        // Dependencies between the submits of the resolved frames
+        DeviceProfilerCriticalPathAnalyzer m_CriticalPathAnalyzer;
 
         uint32_t m_MaxResolvedFrameCount;
 
-        // Command pools used for copying query data
-        std::unordered_map<VkQueue, DeviceProfilerInternalCommandPool> m_CopyCommandPools;
+        // Submission lanes of the queues, created once during initialization
+        std::unordered_map<VkQueue, SubmitLane> m_SubmitLanes;
 
         std::shared_ptr<Frame> GetPendingFrame( uint32_t ) const;
 
+        void DrainSubmitLane( SubmitLane& );
+        void CompleteSubmitBatch( SubmitBatch& );
+
         void DataCollectionThreadProc();
 
         void LoadPerformanceMetricsProperties( uint32_t, std::vector<VkProfilerPerformanceCounterProperties2EXT>& ) const;
         void CollectPerformanceMetricsStreamData( uint64_t, uint64_t, DeviceProfilerPerformanceCountersData& ) const;
         void AggregatePerformanceQueryMetrics( ContainerType<DeviceProfilerSubmitBatchData>&, DeviceProfilerPerformanceCountersData& ) const;
-        void AggregatePerformanceStreamMetrics( ContainerType<DeviceProfilerSubmitBatchData>&, DeviceProfilerPerformanceCountersData& ) const;
 
         ContainerType<DeviceProfilerPipelineData> CollectTopPipelines( const Frame& ) const;
         void CollectPipelinesFromCommandBuffer( const DeviceProfilerCommandBufferData&, std::unordered_map<uint32_t, DeviceProfilerPipelineData>& ) const;
@@ -164,6 +164,29 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Function:
+        BitCount
+
+    Description:
+        Get number of bits set in the binary representation of the number.
+
+    \***********************************************************************************/
+    template<typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+    PROFILER_FORCE_INLINE uint32_t BitCount( T value )
+    {
+        uint32_t count = 0;
+
+        // Clear the lowest set bit until there are no bits left
+        for( ; value != 0; value &= (value - 1) )
+        {
+            count++;
+        }
+
+        return count;
+    }
+
+    /***********************************************************************************\
+
     Function:
         GetNthElement
 
@@ -910,6 +933,11 @@ namespace Profiler
 
         static std::optional<std::string> GetEnvironmentVar(const char* pVariableName);
 
+        static void* CreateSharedMemory( const char* pName, size_t size, void** ppHandle );
+        static void DestroySharedMemory( const char* pName, void* pMemory, size_t size, void* pHandle );
+        static void* OpenSharedMemory( const char* pName, size_t size, void** ppHandle );
+        static void CloseSharedMemory( void* pMemory, size_t size, void* pHandle );
+
         static void* OpenLibrary( const char* pLibraryName );
         static void CloseLibrary( void* pLibraryHandle );
         static VoidFunction GetProcAddress( void* pLibraryHandle, const char* pProcName );
@@ -24,10 +24,15 @@
 #include <assert.h>
 
 #include <dlfcn.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 
+#include <string>
+
 namespace Profiler
 {
     /***********************************************************************************\
@@ -237,6 +242,118 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Function:
+        CreateSharedMemory
+
+    Description:
+        Creates a named shared memory segment and maps it into the address space of the
+        process. Returns nullptr on failure, also if a segment with the same name exists.
+
+    \***********************************************************************************/
+    void* ProfilerPlatformFunctions::CreateSharedMemory( const char* pName, size_t size, void** ppHandle )
+    {
+        // POSIX shared memory object names must begin with a slash.
+        const std::string name = std::string( "/" ) + pName;
+
+        // Don't attach to a segment created by another device or process.
+        int fd = shm_open( name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR );
+        if( fd < 0 )
+        {
+            return nullptr;
+        }
+
+        void* pMemory = MAP_FAILED;
+        if( ftruncate( fd, static_cast<off_t>( size ) ) == 0 )
+        {
+            pMemory = mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+        }
+
+        if( pMemory == MAP_FAILED )
+        {
+            close( fd );
+            shm_unlink( name.c_str() );
+            return nullptr;
+        }
+
+        *ppHandle = reinterpret_cast<void*>( static_cast<intptr_t>( fd ) );
+        return pMemory;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        DestroySharedMemory
+
+    Description:
+        Unmaps and removes the shared memory segment.
+
+    \***********************************************************************************/
+    void ProfilerPlatformFunctions::DestroySharedMemory( const char* pName, void* pMemory, size_t size, void* pHandle )
+    {
+        const std::string name = std::string( "/" ) + pName;
+
+        munmap( pMemory, size );
+        close( static_cast<int>( reinterpret_cast<intptr_t>( pHandle ) ) );
+        shm_unlink( name.c_str() );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        OpenSharedMemory
+
+    Description:
+        Maps an existing shared memory segment into the address space of the process.
+        Returns nullptr on failure, also if the segment is smaller than the requested size.
+
+    \***********************************************************************************/
+    void* ProfilerPlatformFunctions::OpenSharedMemory( const char* pName, size_t size, void** ppHandle )
+    {
+        const std::string name = std::string( "/" ) + pName;
+
+        int fd = shm_open( name.c_str(), O_RDWR, 0 );
+        if( fd < 0 )
+        {
+            return nullptr;
+        }
+
+        void* pMemory = MAP_FAILED;
+
+        struct stat fileStatus = {};
+        if( ( fstat( fd, &fileStatus ) == 0 ) &&
+            ( static_cast<size_t>( fileStatus.st_size ) >= size ) )
+        {
+            pMemory = mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+        }
+
+        if( pMemory == MAP_FAILED )
+        {
+            close( fd );
+            return nullptr;
+        }
+
+        *ppHandle = reinterpret_cast<void*>( static_cast<intptr_t>( fd ) );
+        return pMemory;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        CloseSharedMemory
+
+    Description:
+        Unmaps the shared memory segment opened with OpenSharedMemory.
+        The segment is removed by the process that created it.
+
+    \***********************************************************************************/
+    void ProfilerPlatformFunctions::CloseSharedMemory( void* pMemory, size_t size, void* pHandle )
+    {
+        munmap( pMemory, size );
+        close( static_cast<int>( reinterpret_cast<intptr_t>( pHandle ) ) );
+    }
+
+    /***********************************************************************************\
+
     Function:
         OpenLibrary
 
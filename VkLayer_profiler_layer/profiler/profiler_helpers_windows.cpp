@@ -417,6 +417,112 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Function:
+        CreateSharedMemory
+
+    Description:
+        Creates a named shared memory segment and maps it into the address space of the
+        process. Returns nullptr on failure, also if a segment with the same name exists.
+
+    \***********************************************************************************/
+    void* ProfilerPlatformFunctions::CreateSharedMemory( const char* pName, size_t size, void** ppHandle )
+    {
+        const uint64_t size64 = static_cast<uint64_t>( size );
+
+        HANDLE hMapping = CreateFileMappingA(
+            INVALID_HANDLE_VALUE,
+            nullptr,
+            PAGE_READWRITE,
+            static_cast<DWORD>( size64 >> 32 ),
+            static_cast<DWORD>( size64 & 0xFFFFFFFF ),
+            pName );
+
+        if( hMapping == nullptr )
+        {
+            return nullptr;
+        }
+
+        // Don't attach to a segment created by another device or process.
+        if( GetLastError() == ERROR_ALREADY_EXISTS )
+        {
+            CloseHandle( hMapping );
+            return nullptr;
+        }
+
+        void* pMemory = MapViewOfFile( hMapping, FILE_MAP_ALL_ACCESS, 0, 0, size );
+        if( pMemory == nullptr )
+        {
+            CloseHandle( hMapping );
+            return nullptr;
+        }
+
+        *ppHandle = hMapping;
+        return pMemory;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        DestroySharedMemory
+
+    Description:
+        Unmaps and closes the shared memory segment.
+        The segment is removed by the system when the last handle is closed.
+
+    \***********************************************************************************/
+    void ProfilerPlatformFunctions::DestroySharedMemory( const char*, void* pMemory, size_t, void* pHandle )
+    {
+        UnmapViewOfFile( pMemory );
+        CloseHandle( static_cast<HANDLE>( pHandle ) );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        OpenSharedMemory
+
+    Description:
+        Maps an existing shared memory segment into the address space of the process.
+        Returns nullptr on failure, also if the segment is smaller than the requested size.
+
+    \***********************************************************************************/
+    void* ProfilerPlatformFunctions::OpenSharedMemory( const char* pName, size_t size, void** ppHandle )
+    {
+        HANDLE hMapping = OpenFileMappingA( FILE_MAP_ALL_ACCESS, FALSE, pName );
+        if( hMapping == nullptr )
+        {
+            return nullptr;
+        }
+
+        // Mapping fails if the requested size exceeds the size of the segment.
+        void* pMemory = MapViewOfFile( hMapping, FILE_MAP_ALL_ACCESS, 0, 0, size );
+        if( pMemory == nullptr )
+        {
+            CloseHandle( hMapping );
+            return nullptr;
+        }
+
+        *ppHandle = hMapping;
+        return pMemory;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        CloseSharedMemory
+
+    Description:
+        Unmaps the shared memory segment opened with OpenSharedMemory.
+
+    \***********************************************************************************/
+    void ProfilerPlatformFunctions::CloseSharedMemory( void* pMemory, size_t, void* pHandle )
+    {
+        UnmapViewOfFile( pMemory );
+        CloseHandle( static_cast<HANDLE>( pHandle ) );
+    }
+
+    /***********************************************************************************\
+
     Function:
         OpenLibrary
 
@@ -0,0 +1,552 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "profiler_hitch_detector.h"
+#include <algorithm>
+
+namespace Profiler
+{
+    // Number of frames in which a region must appear before it can be flagged.
+    static constexpr uint64_t MinSampleCount = 30;
+
+    // Weight of the new sample in the moving average (effective window of ~40 frames).
+    static constexpr double SmoothingFactor = 0.05;
+
+    // Minimal standard deviation relative to the mean. Prevents flagging negligible
+    // changes in time of very stable regions.
+    static constexpr double MinRelativeStdDev = 0.05;
+
+    // Number of frames after which regions that were not seen are evicted.
+    static constexpr uint32_t StaleRegionFrameCount = 1000;
+
+    /***********************************************************************************\
+
+    Function:
+        ProfilerQuantileEstimator
+
+    Description:
+        Constructor.
+
+    \***********************************************************************************/
+    ProfilerQuantileEstimator::ProfilerQuantileEstimator( double quantile )
+        : m_Quantile( quantile )
+        , m_Count( 0 )
+        , m_Heights()
+        , m_Positions()
+        , m_DesiredPositions()
+        , m_Increments()
+    {
+        m_Increments[ 0 ] = 0;
+        m_Increments[ 1 ] = quantile / 2;
+        m_Increments[ 2 ] = quantile;
+        m_Increments[ 3 ] = ( 1 + quantile ) / 2;
+        m_Increments[ 4 ] = 1;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        AddSample
+
+    Description:
+        Update the markers with a new sample.
+
+    \***********************************************************************************/
+    void ProfilerQuantileEstimator::AddSample( double value )
+    {
+        // Collect the first 5 samples to initialize the markers.
+        if( m_Count < 5 )
+        {
+            m_Heights[ m_Count++ ] = value;
+
+            if( m_Count == 5 )
+            {
+                std::sort( std::begin( m_Heights ), std::end( m_Heights ) );
+
+                for( uint32_t i = 0; i < 5; ++i )
+                {
+                    m_Positions[ i ] = i + 1;
+                    m_DesiredPositions[ i ] = 1 + 4 * m_Increments[ i ];
+                }
+            }
+
+            return;
+        }
+
+        m_Count++;
+
+        // Find the cell containing the sample and update the extreme markers.
+        uint32_t cell = 0;
+
+        if( value < m_Heights[ 0 ] )
+        {
+            m_Heights[ 0 ] = value;
+        }
+        else if( value >= m_Heights[ 4 ] )
+        {
+            m_Heights[ 4 ] = value;
+            cell = 3;
+        }
+        else
+        {
+            while( value >= m_Heights[ cell + 1 ] )
+            {
+                cell++;
+            }
+        }
+
+        // Shift positions of the markers above the sample.
+        for( uint32_t i = cell + 1; i < 5; ++i )
+        {
+            m_Positions[ i ] += 1;
+        }
+
+        for( uint32_t i = 0; i < 5; ++i )
+        {
+            m_DesiredPositions[ i ] += m_Increments[ i ];
+        }
+
+        // Adjust heights of the middle markers if they drifted from the desired positions.
+        for( uint32_t i = 1; i < 4; ++i )
+        {
+            const double delta = m_DesiredPositions[ i ] - m_Positions[ i ];
+
+            if( ( delta >= 1 && ( m_Positions[ i + 1 ] - m_Positions[ i ] ) > 1 ) ||
+                ( delta <= -1 && ( m_Positions[ i - 1 ] - m_Positions[ i ] ) < -1 ) )
+            {
+                const int32_t direction = ( delta >= 0 ) ? 1 : -1;
+
+                const double height = GetParabolicHeight( i, direction );
+                if( ( m_Heights[ i - 1 ] < height ) && ( height < m_Heights[ i + 1 ] ) )
+                {
+                    m_Heights[ i ] = height;
+                }
+                else
+                {
+                    m_Heights[ i ] = GetLinearHeight( i, direction );
+                }
+
+                m_Positions[ i ] += direction;
+            }
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        GetValue
+
+    Description:
+        Get the current estimate of the quantile.
+
+    \***********************************************************************************/
+    double ProfilerQuantileEstimator::GetValue() const
+    {
+        if( m_Count >= 5 )
+        {
+            return m_Heights[ 2 ];
+        }
+
+        if( m_Count == 0 )
+        {
+            return 0;
+        }
+
+        // Not enough samples to initialize the markers, return the nearest-rank value.
+        double samples[ 5 ];
+        std::copy( m_Heights, m_Heights + m_Count, samples );
+        std::sort( samples, samples + m_Count );
+
+        return samples[ static_cast<uint64_t>( m_Quantile * ( m_Count - 1 ) + 0.5 ) ];
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        GetParabolicHeight
+
+    Description:
+        Piecewise-parabolic prediction of the marker height after moving it by one
+        position in the given direction.
+
+    \***********************************************************************************/
+    double ProfilerQuantileEstimator::GetParabolicHeight( uint32_t i, double d ) const
+    {
+        const double* q = m_Heights;
+        const double* n = m_Positions;
+
+        return q[ i ] + d / ( n[ i + 1 ] - n[ i - 1 ] ) * (
+            ( n[ i ] - n[ i - 1 ] + d ) * ( q[ i + 1 ] - q[ i ] ) / ( n[ i + 1 ] - n[ i ] ) +
+            ( n[ i + 1 ] - n[ i ] - d ) * ( q[ i ] - q[ i - 1 ] ) / ( n[ i ] - n[ i - 1 ] ) );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        GetLinearHeight
+
+    Description:
+        Linear prediction of the marker height, used when the parabolic prediction
+        would break the ordering of the markers.
+
+    \***********************************************************************************/
+    double ProfilerQuantileEstimator::GetLinearHeight( uint32_t i, int32_t d ) const
+    {
+        const double* q = m_Heights;
+        const double* n = m_Positions;
+
+        return q[ i ] + d * ( q[ i + d ] - q[ i ] ) / ( n[ i + d ] - n[ i ] );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        AddSample
+
+    Description:
+        Update the running statistics with a new sample.
+
+    \***********************************************************************************/
+    void ProfilerRunningStatistics::AddSample( double value, double smoothingFactor )
+    {
+        m_SampleCount++;
+
+        // Use cumulative average until enough samples are collected.
+        const double alpha = std::max( smoothingFactor, 1.0 / m_SampleCount );
+
+        const double delta = value - m_Mean;
+        const double increment = alpha * delta;
+
+        m_Mean += increment;
+        m_Variance = ( 1 - alpha ) * ( m_Variance + delta * increment );
+
+        m_P99.AddSample( value );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        DeviceProfilerHitchDetector
+
+    Description:
+        Constructor.
+
+    \***********************************************************************************/
+    DeviceProfilerHitchDetector::DeviceProfilerHitchDetector()
+        : m_Mutex()
+        , m_Threshold( 0 )
+        , m_ProcessedFrameCount( 0 )
+        , m_Pipelines()
+        , m_RenderPasses()
+        , m_DebugLabels()
+        , m_FrameRenderPasses()
+        , m_FrameDebugLabels()
+        , m_FrameDebugLabelStacks()
+        , m_pCurrentDebugLabelStack( nullptr )
+    {
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        Initialize
+
+    Description:
+        Set the number of standard deviations above the mean at which a region is
+        flagged. The detector is disabled if the threshold is 0.
+
+    \***********************************************************************************/
+    void DeviceProfilerHitchDetector::Initialize( float threshold )
+    {
+        std::scoped_lock lk( m_Mutex );
+        m_Threshold = std::max( threshold, 0.f );
+        m_ProcessedFrameCount = 0;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        Destroy
+
+    Description:
+        Disable the detector and release the statistics collected for all regions.
+
+    \***********************************************************************************/
+    void DeviceProfilerHitchDetector::Destroy()
+    {
+        std::scoped_lock lk( m_Mutex );
+        m_Threshold = 0;
+        m_Pipelines.clear();
+        m_RenderPasses.clear();
+        m_DebugLabels.clear();
+        m_FrameRenderPasses.clear();
+        m_FrameDebugLabels.clear();
+        m_FrameDebugLabelStacks.clear();
+        m_pCurrentDebugLabelStack = nullptr;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        ProcessFrame
+
+    Description:
+        Update the statistics with the regions of the resolved frame and append
+        the detected hitches to the frame data.
+
+    \***********************************************************************************/
+    void DeviceProfilerHitchDetector::ProcessFrame( DeviceProfilerFrameData& frameData )
+    {
+        if( !IsEnabled() )
+        {
+            return;
+        }
+
+        std::scoped_lock lk( m_Mutex );
+        m_ProcessedFrameCount++;
+
+        DeviceProfilerHitchData hitch;
+        hitch.m_FrameIndex = frameData.m_CPU.m_FrameIndex;
+
+        // Top pipelines already contain total time of each pipeline in the frame.
+        for( const DeviceProfilerPipelineData& pipeline : frameData.m_TopPipelines )
+        {
+            const uint64_t ticks = pipeline.m_EndTimestamp.m_Value - pipeline.m_BeginTimestamp.m_Value;
+            if( ticks == 0 )
+            {
+                continue;
+            }
+
+            if( UpdateStatistics( m_Pipelines[ pipeline.m_ShaderTuple.m_Hash ], ticks, hitch ) )
+            {
+                DeviceProfilerHitchData& pipelineHitch = frameData.m_Hitches.emplace_back( hitch );
+                pipelineHitch.m_RegionType = DeviceProfilerHitchRegionType::ePipeline;
+                pipelineHitch.m_Pipeline = pipeline;
+            }
+        }
+
+        // Render passes and debug labels must be collected from the command buffers.
+        for( const DeviceProfilerSubmitBatchData& submitBatch : frameData.m_Submits )
+        {
+            m_pCurrentDebugLabelStack = &m_FrameDebugLabelStacks[ submitBatch.m_Handle ];
+
+            for( const DeviceProfilerSubmitData& submit : submitBatch.m_Submits )
+            {
+                for( const DeviceProfilerCommandBufferDataPtr& pCommandBuffer : submit.m_CommandBuffers )
+                {
+                    CollectRegions( *pCommandBuffer );
+                }
+            }
+        }
+
+        for( const auto& [renderPass, ticks] : m_FrameRenderPasses )
+        {
+            if( UpdateStatistics( m_RenderPasses[ renderPass ], ticks, hitch ) )
+            {
+                DeviceProfilerHitchData& renderPassHitch = frameData.m_Hitches.emplace_back( hitch );
+                renderPassHitch.m_RegionType = DeviceProfilerHitchRegionType::eRenderPass;
+                renderPassHitch.m_RenderPass = renderPass;
+            }
+        }
+
+        for( const auto& [debugLabel, ticks] : m_FrameDebugLabels )
+        {
+            if( UpdateStatistics( m_DebugLabels[ debugLabel ], ticks, hitch ) )
+            {
+                DeviceProfilerHitchData& debugLabelHitch = frameData.m_Hitches.emplace_back( hitch );
+                debugLabelHitch.m_RegionType = DeviceProfilerHitchRegionType::eDebugLabel;
+                debugLabelHitch.m_DebugLabel = debugLabel;
+            }
+        }
+
+        // Labels that did not end in this frame are not tracked.
+        m_FrameRenderPasses.clear();
+        m_FrameDebugLabels.clear();
+        m_FrameDebugLabelStacks.clear();
+        m_pCurrentDebugLabelStack = nullptr;
+
+        // Periodically remove regions that are no longer used by the application.
+        if( ( m_ProcessedFrameCount % StaleRegionFrameCount ) == 0 )
+        {
+            EvictStaleRegions( m_Pipelines );
+            EvictStaleRegions( m_RenderPasses );
+            EvictStaleRegions( m_DebugLabels );
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        CollectRegions
+
+    Description:
+        Sum time of the render passes and debug label regions in the command buffer.
+
+    \***********************************************************************************/
+    void DeviceProfilerHitchDetector::CollectRegions( const DeviceProfilerCommandBufferData& commandBuffer )
+    {
+        for( const DeviceProfilerRenderPassData& renderPass : commandBuffer.m_RenderPasses )
+        {
+            // Commands recorded outside of render passes and dynamic render passes are not tracked.
+            if( ( renderPass.m_Handle != VK_NULL_HANDLE ) &&
+                ( renderPass.m_BeginTimestamp.m_Index != UINT64_MAX ) )
+            {
+                m_FrameRenderPasses[ renderPass.m_Handle ] +=
+                    renderPass.m_EndTimestamp.m_Value - renderPass.m_BeginTimestamp.m_Value;
+            }
+
+            for( const DeviceProfilerSubpassData& subpass : renderPass.m_Subpasses )
+            {
+                for( const DeviceProfilerSubpassData::Data& data : subpass.m_Data )
+                {
+                    switch( data.GetType() )
+                    {
+                    case DeviceProfilerSubpassDataType::ePipeline:
+                        CollectRegions( std::get<DeviceProfilerPipelineData>( data ) );
+                        break;
+
+                    case DeviceProfilerSubpassDataType::eCommandBuffer:
+                        CollectRegions( *std::get<DeviceProfilerCommandBufferDataPtr>( data ) );
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        CollectRegions
+
+    Description:
+        Sum time of the debug label regions in the pipeline.
+
+    \***********************************************************************************/
+    void DeviceProfilerHitchDetector::CollectRegions( const DeviceProfilerPipelineData& pipeline )
+    {
+        for( const DeviceProfilerDrawcall& drawcall : pipeline.m_Drawcalls )
+        {
+            CollectRegions( drawcall );
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        CollectRegions
+
+    Description:
+        Track begin and end of the debug label regions.
+        Timestamps of the labels are available only in per-drawcall sampling mode.
+
+    \***********************************************************************************/
+    void DeviceProfilerHitchDetector::CollectRegions( const DeviceProfilerDrawcall& drawcall )
+    {
+        if( drawcall.m_Type == DeviceProfilerDrawcallType::eBeginDebugLabel )
+        {
+            const char* pDebugLabel = drawcall.m_Payload.m_DebugLabel.m_pName == nullptr ? "" : drawcall.m_Payload.m_DebugLabel.m_pName;
+            const uint64_t beginTimestamp = drawcall.m_BeginTimestamp.m_Value;
+
+            m_pCurrentDebugLabelStack->emplace_back( pDebugLabel, beginTimestamp );
+        }
+
+        if( drawcall.m_Type == DeviceProfilerDrawcallType::eEndDebugLabel )
+        {
+            // Skip labels that began in the previous frame.
+            if( m_pCurrentDebugLabelStack->empty() )
+            {
+                return;
+            }
+
+            const auto [pDebugLabel, beginTimestamp] = m_pCurrentDebugLabelStack->back();
+            m_pCurrentDebugLabelStack->pop_back();
+
+            if( ( beginTimestamp != UINT64_MAX ) &&
+                ( drawcall.m_BeginTimestamp.m_Value != UINT64_MAX ) &&
+                ( drawcall.m_BeginTimestamp.m_Value > beginTimestamp ) )
+            {
+                m_FrameDebugLabels[ pDebugLabel ] += drawcall.m_BeginTimestamp.m_Value - beginTimestamp;
+            }
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        UpdateStatistics
+
+    Description:
+        Compare time of the region with its running statistics and add it to the
+        statistics. Returns true and fills the statistics of the hitch if the region
+        deviates from the mean by more than the threshold.
+
+    \***********************************************************************************/
+    bool DeviceProfilerHitchDetector::UpdateStatistics( RegionStatistics& statistics, uint64_t ticks, DeviceProfilerHitchData& hitch )
+    {
+        bool hitchDetected = false;
+
+        if( statistics.m_SampleCount >= MinSampleCount )
+        {
+            const double stdDev = statistics.GetStdDev();
+            const double minStdDev = statistics.m_Mean * MinRelativeStdDev;
+
+            if( ticks > statistics.m_Mean + m_Threshold * std::max( stdDev, minStdDev ) )
+            {
+                hitch.m_Ticks = ticks;
+                hitch.m_MeanTicks = statistics.m_Mean;
+                hitch.m_StdDevTicks = stdDev;
+                hitch.m_P99Ticks = statistics.m_P99.GetValue();
+                hitchDetected = true;
+            }
+        }
+
+        statistics.AddSample( static_cast<double>( ticks ), SmoothingFactor );
+        statistics.m_LastUpdate = m_ProcessedFrameCount;
+
+        return hitchDetected;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        EvictStaleRegions
+
+    Description:
+        Remove statistics of the regions that were not seen for a long time.
+
+    \***********************************************************************************/
+    template<typename KeyType>
+    void DeviceProfilerHitchDetector::EvictStaleRegions( RegionMap<KeyType>& regions )
+    {
+        auto it = regions.begin();
+        while( it != regions.end() )
+        {
+            if( ( m_ProcessedFrameCount - it->second.m_LastUpdate ) >= StaleRegionFrameCount )
+            {
+                it = regions.erase( it );
+            }
+            else
+            {
+                it = std::next( it );
+            }
+        }
+    }
+}
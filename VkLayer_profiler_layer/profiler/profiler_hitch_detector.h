@@ -0,0 +1,152 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include "profiler_data.h"
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace Profiler
+{
+    /***********************************************************************************\
+
+    Structure:
+        ProfilerQuantileEstimator
+
+    Description:
+        Estimates a quantile of a stream of samples in constant memory using the P^2
+        algorithm (Jain, Chlamtac, 1985). Five markers track the minimum, the maximum,
+        the requested quantile and two intermediate quantiles. Heights of the markers
+        are adjusted with piecewise-parabolic interpolation when their positions drift
+        from the desired ones.
+
+    \***********************************************************************************/
+    struct ProfilerQuantileEstimator
+    {
+        double   m_Quantile;
+        uint64_t m_Count;
+        double   m_Heights[ 5 ];
+        double   m_Positions[ 5 ];
+        double   m_DesiredPositions[ 5 ];
+        double   m_Increments[ 5 ];
+
+        explicit ProfilerQuantileEstimator( double quantile );
+
+        void AddSample( double value );
+        double GetValue() const;
+
+    private:
+        double GetParabolicHeight( uint32_t index, double direction ) const;
+        double GetLinearHeight( uint32_t index, int32_t direction ) const;
+    };
+
+    /***********************************************************************************\
+
+    Structure:
+        ProfilerRunningStatistics
+
+    Description:
+        Exponentially weighted moving average and variance of a stream of samples,
+        with a running estimate of the 99th percentile.
+
+        First samples are averaged with equal weights, so the statistics do not depend
+        on the first sample until enough history is collected.
+
+    \***********************************************************************************/
+    struct ProfilerRunningStatistics
+    {
+        double                                      m_Mean = 0;
+        double                                      m_Variance = 0;
+        uint64_t                                    m_SampleCount = 0;
+        ProfilerQuantileEstimator                   m_P99 = ProfilerQuantileEstimator( 0.99 );
+
+        void AddSample( double value, double smoothingFactor );
+        double GetStdDev() const { return std::sqrt( m_Variance ); }
+    };
+
+    /***********************************************************************************\
+
+    Class:
+        DeviceProfilerHitchDetector
+
+    Description:
+        Keeps running statistics of GPU time of pipelines, render passes and debug
+        label regions across all resolved frames, including frames that are dropped
+        from the data buffer, and flags frames in which a region deviates from its
+        statistics by more than the configured threshold.
+
+        Pipelines are identified by the shader tuple hash, render passes by their
+        handles and debug label regions by the label names. Regions not seen for
+        a long time are evicted to keep memory usage bounded.
+
+    \***********************************************************************************/
+    class DeviceProfilerHitchDetector
+    {
+    public:
+        DeviceProfilerHitchDetector();
+
+        void Initialize( float threshold );
+        void Destroy();
+
+        bool IsEnabled() const { return m_Threshold > 0; }
+
+        void ProcessFrame( DeviceProfilerFrameData& frameData );
+
+    private:
+        struct RegionStatistics : ProfilerRunningStatistics
+        {
+            uint32_t                                m_LastUpdate = 0;
+        };
+
+        template<typename KeyType>
+        using RegionMap = std::unordered_map<KeyType, RegionStatistics>;
+
+        template<typename KeyType>
+        using FrameRegionMap = std::unordered_map<KeyType, uint64_t>;
+
+        std::mutex                                  m_Mutex;
+
+        float                                       m_Threshold;
+        uint32_t                                    m_ProcessedFrameCount;
+
+        RegionMap<uint32_t>                         m_Pipelines;
+        RegionMap<VkRenderPassHandle>               m_RenderPasses;
+        RegionMap<std::string>                      m_DebugLabels;
+
+        // Temporary storage for the regions of the currently processed frame.
+        // Debug labels may span multiple command buffers, so the stacks are tracked per queue.
+        using DebugLabelStack = std::vector<std::pair<const char*, uint64_t>>;
+
+        FrameRegionMap<VkRenderPassHandle>          m_FrameRenderPasses;
+        FrameRegionMap<std::string>                 m_FrameDebugLabels;
+        std::unordered_map<VkQueueHandle, DebugLabelStack> m_FrameDebugLabelStacks;
+        DebugLabelStack*                            m_pCurrentDebugLabelStack;
+
+        void CollectRegions( const DeviceProfilerCommandBufferData& );
+        void CollectRegions( const DeviceProfilerPipelineData& );
+        void CollectRegions( const DeviceProfilerDrawcall& );
+
+        bool UpdateStatistics( RegionStatistics&, uint64_t ticks, DeviceProfilerHitchData& );
+
+        template<typename KeyType>
+        void EvictStaleRegions( RegionMap<KeyType>& );
+    };
+}
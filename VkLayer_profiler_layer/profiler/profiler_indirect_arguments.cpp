@@ -0,0 +1,623 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "profiler_indirect_arguments.h"
+#include "profiler_helpers.h"
+#include "profiler_shader.h"
+#include <algorithm>
+#include <assert.h>
+#include <string.h>
+
+namespace
+{
+    // Compaction shader, assembled at runtime with SPIRV-Tools. Equivalent GLSL:
+    //
+    //  layout( local_size_x = 64 ) in;
+    //  layout( set = 0, binding = 0 ) buffer CaptureBuffer { uint captureData[]; };
+    //  layout( set = 0, binding = 1 ) buffer ReadbackBuffer { uint readbackData[]; };
+    //  layout( push_constant ) uniform Region { uint offset; uint maxDrawCount; uint stride; };
+    //
+    //  void main()
+    //  {
+    //      uint drawCount = min( captureData[ offset ], maxDrawCount );
+    //      if( gl_GlobalInvocationID.x == 0 )
+    //          readbackData[ offset ] = drawCount;
+    //
+    //      uint size = drawCount * stride;
+    //      for( uint i = gl_GlobalInvocationID.x; i < size; i += gl_NumWorkGroups.x * 64 )
+    //          readbackData[ offset + 1 + i ] = captureData[ offset + 1 + i ];
+    //  }
+    static constexpr char g_scIndirectArgumentCompactionShader[] = R"(
+                        OpCapability Shader
+               %glsl = OpExtInstImport "GLSL.std.450"
+                        OpMemoryModel Logical GLSL450
+                        OpEntryPoint GLCompute %main "main" %gl_GlobalInvocationID %gl_NumWorkGroups
+                        OpExecutionMode %main LocalSize 64 1 1
+                        OpDecorate %gl_GlobalInvocationID BuiltIn GlobalInvocationId
+                        OpDecorate %gl_NumWorkGroups BuiltIn NumWorkgroups
+                        OpDecorate %uint_array ArrayStride 4
+                        OpMemberDecorate %Buffer 0 Offset 0
+                        OpDecorate %Buffer BufferBlock
+                        OpDecorate %captureBuffer DescriptorSet 0
+                        OpDecorate %captureBuffer Binding 0
+                        OpDecorate %readbackBuffer DescriptorSet 0
+                        OpDecorate %readbackBuffer Binding 1
+                        OpMemberDecorate %Region 0 Offset 0
+                        OpMemberDecorate %Region 1 Offset 4
+                        OpMemberDecorate %Region 2 Offset 8
+                        OpDecorate %Region Block
+               %void = OpTypeVoid
+            %void_fn = OpTypeFunction %void
+               %bool = OpTypeBool
+               %uint = OpTypeInt 32 0
+                %int = OpTypeInt 32 1
+             %v3uint = OpTypeVector %uint 3
+         %uint_array = OpTypeRuntimeArray %uint
+             %Buffer = OpTypeStruct %uint_array
+             %Region = OpTypeStruct %uint %uint %uint
+       %input_v3uint = OpTypePointer Input %v3uint
+     %uniform_Buffer = OpTypePointer Uniform %Buffer
+       %uniform_uint = OpTypePointer Uniform %uint
+%pushconstant_Region = OpTypePointer PushConstant %Region
+  %pushconstant_uint = OpTypePointer PushConstant %uint
+              %int_0 = OpConstant %int 0
+              %int_1 = OpConstant %int 1
+              %int_2 = OpConstant %int 2
+             %uint_0 = OpConstant %uint 0
+             %uint_1 = OpConstant %uint 1
+            %uint_64 = OpConstant %uint 64
+%gl_GlobalInvocationID = OpVariable %input_v3uint Input
+   %gl_NumWorkGroups = OpVariable %input_v3uint Input
+      %captureBuffer = OpVariable %uniform_Buffer Uniform
+     %readbackBuffer = OpVariable %uniform_Buffer Uniform
+             %region = OpVariable %pushconstant_Region PushConstant
+               %main = OpFunction %void None %void_fn
+              %entry = OpLabel
+         %offset_ptr = OpAccessChain %pushconstant_uint %region %int_0
+             %offset = OpLoad %uint %offset_ptr
+   %maxDrawCount_ptr = OpAccessChain %pushconstant_uint %region %int_1
+       %maxDrawCount = OpLoad %uint %maxDrawCount_ptr
+         %stride_ptr = OpAccessChain %pushconstant_uint %region %int_2
+             %stride = OpLoad %uint %stride_ptr
+          %count_ptr = OpAccessChain %uniform_uint %captureBuffer %int_0 %offset
+              %count = OpLoad %uint %count_ptr
+          %drawCount = OpExtInst %uint %glsl UMin %count %maxDrawCount
+               %size = OpIMul %uint %drawCount %stride
+              %first = OpIAdd %uint %offset %uint_1
+       %invocationID = OpLoad %v3uint %gl_GlobalInvocationID
+         %invocation = OpCompositeExtract %uint %invocationID 0
+      %numWorkGroups = OpLoad %v3uint %gl_NumWorkGroups
+     %numWorkGroupsX = OpCompositeExtract %uint %numWorkGroups 0
+               %step = OpIMul %uint %numWorkGroupsX %uint_64
+    %firstInvocation = OpIEqual %bool %invocation %uint_0
+                        OpSelectionMerge %loop_preheader None
+                        OpBranchConditional %firstInvocation %write_count %loop_preheader
+        %write_count = OpLabel
+   %readbackCount_ptr = OpAccessChain %uniform_uint %readbackBuffer %int_0 %offset
+                        OpStore %readbackCount_ptr %drawCount
+                        OpBranch %loop_preheader
+     %loop_preheader = OpLabel
+                        OpBranch %loop_header
+        %loop_header = OpLabel
+                  %i = OpPhi %uint %invocation %loop_preheader %i_next %loop_continue
+                        OpLoopMerge %loop_merge %loop_continue None
+                        OpBranch %loop_condition
+     %loop_condition = OpLabel
+           %in_range = OpULessThan %bool %i %size
+                        OpBranchConditional %in_range %loop_body %loop_merge
+          %loop_body = OpLabel
+              %index = OpIAdd %uint %first %i
+        %capture_ptr = OpAccessChain %uniform_uint %captureBuffer %int_0 %index
+              %value = OpLoad %uint %capture_ptr
+       %readback_ptr = OpAccessChain %uniform_uint %readbackBuffer %int_0 %index
+                        OpStore %readback_ptr %value
+                        OpBranch %loop_continue
+      %loop_continue = OpLabel
+             %i_next = OpIAdd %uint %i %step
+                        OpBranch %loop_header
+         %loop_merge = OpLabel
+                        OpReturn
+                        OpFunctionEnd
+)";
+
+    static constexpr uint32_t g_scIndirectArgumentCompactionGroupSize = 64;
+    static constexpr uint32_t g_scIndirectArgumentCompactionMaxGroupCount = 1024;
+    static constexpr uint32_t g_scIndirectArgumentCompactionDescriptorPoolSize = 64;
+}
+
+namespace Profiler
+{
+    /***********************************************************************************\
+
+    Function:
+        DeviceProfilerIndirectArgumentCompactor
+
+    Description:
+        Constructor.
+
+    \***********************************************************************************/
+    DeviceProfilerIndirectArgumentCompactor::DeviceProfilerIndirectArgumentCompactor()
+        : m_pDevice( nullptr )
+        , m_DescriptorSetLayout( VK_NULL_HANDLE )
+        , m_PipelineLayout( VK_NULL_HANDLE )
+        , m_Pipeline( VK_NULL_HANDLE )
+        , m_DescriptorPoolsMutex()
+        , m_DescriptorPools()
+    {
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        Initialize
+
+    Description:
+        Creates the compaction pipeline.
+
+    \***********************************************************************************/
+    VkResult DeviceProfilerIndirectArgumentCompactor::Initialize( VkDevice_Object* pDevice )
+    {
+        m_pDevice = pDevice;
+
+        // Storage buffers with the captured and compacted arguments.
+        VkDescriptorSetLayoutBinding bindings[ 2 ] = {};
+        for( uint32_t i = 0; i < std::size( bindings ); ++i )
+        {
+            bindings[ i ].binding = i;
+            bindings[ i ].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            bindings[ i ].descriptorCount = 1;
+            bindings[ i ].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+
+        VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo = {};
+        descriptorSetLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        descriptorSetLayoutCreateInfo.bindingCount = static_cast<uint32_t>( std::size( bindings ) );
+        descriptorSetLayoutCreateInfo.pBindings = bindings;
+
+        DESTROYANDRETURNONFAIL( m_pDevice->Callbacks.CreateDescriptorSetLayout(
+            m_pDevice->Handle,
+            &descriptorSetLayoutCreateInfo,
+            nullptr,
+            &m_DescriptorSetLayout ) );
+
+        VkPushConstantRange pushConstantRange = {};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof( DeviceProfilerIndirectArgumentCompactionRegion );
+
+        VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = {};
+        pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutCreateInfo.setLayoutCount = 1;
+        pipelineLayoutCreateInfo.pSetLayouts = &m_DescriptorSetLayout;
+        pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+        pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+
+        DESTROYANDRETURNONFAIL( m_pDevice->Callbacks.CreatePipelineLayout(
+            m_pDevice->Handle,
+            &pipelineLayoutCreateInfo,
+            nullptr,
+            &m_PipelineLayout ) );
+
+        DESTROYANDRETURNONFAIL( CreatePipeline() );
+
+        return VK_SUCCESS;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        Destroy
+
+    Description:
+        Destroys the compaction pipeline and all descriptor pools.
+
+    \***********************************************************************************/
+    void DeviceProfilerIndirectArgumentCompactor::Destroy()
+    {
+        if( m_pDevice == nullptr )
+        {
+            return;
+        }
+
+        for( VkDescriptorPool descriptorPool : m_DescriptorPools )
+        {
+            m_pDevice->Callbacks.DestroyDescriptorPool( m_pDevice->Handle, descriptorPool, nullptr );
+        }
+
+        m_DescriptorPools.clear();
+
+        if( m_Pipeline != VK_NULL_HANDLE )
+        {
+            m_pDevice->Callbacks.DestroyPipeline( m_pDevice->Handle, m_Pipeline, nullptr );
+            m_Pipeline = VK_NULL_HANDLE;
+        }
+
+        if( m_PipelineLayout != VK_NULL_HANDLE )
+        {
+            m_pDevice->Callbacks.DestroyPipelineLayout( m_pDevice->Handle, m_PipelineLayout, nullptr );
+            m_PipelineLayout = VK_NULL_HANDLE;
+        }
+
+        if( m_DescriptorSetLayout != VK_NULL_HANDLE )
+        {
+            m_pDevice->Callbacks.DestroyDescriptorSetLayout( m_pDevice->Handle, m_DescriptorSetLayout, nullptr );
+            m_DescriptorSetLayout = VK_NULL_HANDLE;
+        }
+
+        m_pDevice = nullptr;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        IsAvailable
+
+    Description:
+        Checks whether the compaction pipeline has been created successfully.
+
+    \***********************************************************************************/
+    bool DeviceProfilerIndirectArgumentCompactor::IsAvailable() const
+    {
+        return m_Pipeline != VK_NULL_HANDLE;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        GetMaxBufferSize
+
+    Description:
+        Returns the maximum size of the buffers that can be bound to the pipeline.
+
+    \***********************************************************************************/
+    VkDeviceSize DeviceProfilerIndirectArgumentCompactor::GetMaxBufferSize() const
+    {
+        return m_pDevice->pPhysicalDevice->Properties.limits.maxStorageBufferRange;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        AllocateDescriptorSet
+
+    Description:
+        Allocates a descriptor set binding the staging buffer with the captured
+        arguments and the readback buffer.
+
+    \***********************************************************************************/
+    VkResult DeviceProfilerIndirectArgumentCompactor::AllocateDescriptorSet(
+        VkBuffer stagingBuffer,
+        VkBuffer readbackBuffer,
+        VkDescriptorPool* pDescriptorPool,
+        VkDescriptorSet* pDescriptorSet )
+    {
+        VkDescriptorSetAllocateInfo allocateInfo = {};
+        allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.descriptorSetCount = 1;
+        allocateInfo.pSetLayouts = &m_DescriptorSetLayout;
+
+        VkResult result = VK_ERROR_OUT_OF_POOL_MEMORY;
+
+        {
+            std::scoped_lock lk( m_DescriptorPoolsMutex );
+
+            // Try the most recently created pools first.
+            for( auto it = m_DescriptorPools.rbegin(); it != m_DescriptorPools.rend(); ++it )
+            {
+                allocateInfo.descriptorPool = *it;
+                result = m_pDevice->Callbacks.AllocateDescriptorSets(
+                    m_pDevice->Handle,
+                    &allocateInfo,
+                    pDescriptorSet );
+
+                if( result == VK_SUCCESS )
+                {
+                    break;
+                }
+            }
+
+            if( result != VK_SUCCESS )
+            {
+                // All pools are full.
+                result = CreateDescriptorPool( &allocateInfo.descriptorPool );
+
+                if( result == VK_SUCCESS )
+                {
+                    result = m_pDevice->Callbacks.AllocateDescriptorSets(
+                        m_pDevice->Handle,
+                        &allocateInfo,
+                        pDescriptorSet );
+                }
+            }
+        }
+
+        if( result == VK_SUCCESS )
+        {
+            *pDescriptorPool = allocateInfo.descriptorPool;
+
+            VkDescriptorBufferInfo bufferInfos[ 2 ] = {};
+            bufferInfos[ 0 ].buffer = stagingBuffer;
+            bufferInfos[ 0 ].range = VK_WHOLE_SIZE;
+            bufferInfos[ 1 ].buffer = readbackBuffer;
+            bufferInfos[ 1 ].range = VK_WHOLE_SIZE;
+
+            VkWriteDescriptorSet writes[ 2 ] = {};
+            for( uint32_t i = 0; i < std::size( writes ); ++i )
+            {
+                writes[ i ].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                writes[ i ].dstSet = *pDescriptorSet;
+                writes[ i ].dstBinding = i;
+                writes[ i ].descriptorCount = 1;
+                writes[ i ].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                writes[ i ].pBufferInfo = &bufferInfos[ i ];
+            }
+
+            m_pDevice->Callbacks.UpdateDescriptorSets(
+                m_pDevice->Handle,
+                static_cast<uint32_t>( std::size( writes ) ),
+                writes,
+                0, nullptr );
+        }
+
+        return result;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        FreeDescriptorSet
+
+    Description:
+        Returns the descriptor set to the pool it was allocated from.
+
+    \***********************************************************************************/
+    void DeviceProfilerIndirectArgumentCompactor::FreeDescriptorSet(
+        VkDescriptorPool descriptorPool,
+        VkDescriptorSet descriptorSet )
+    {
+        std::scoped_lock lk( m_DescriptorPoolsMutex );
+        m_pDevice->Callbacks.FreeDescriptorSets( m_pDevice->Handle, descriptorPool, 1, &descriptorSet );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        BindPipeline
+
+    Description:
+        Binds the compaction pipeline to the compute bind point.
+
+        The application's compute state is not restored, so the pipeline must only be
+        bound after the last application command in the command buffer.
+
+    \***********************************************************************************/
+    void DeviceProfilerIndirectArgumentCompactor::BindPipeline( VkCommandBuffer commandBuffer ) const
+    {
+        m_pDevice->Callbacks.CmdBindPipeline(
+            commandBuffer,
+            VK_PIPELINE_BIND_POINT_COMPUTE,
+            m_Pipeline );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        Compact
+
+    Description:
+        Records compaction of the regions of one staging buffer. The pipeline must be
+        bound with BindPipeline before.
+
+    \***********************************************************************************/
+    void DeviceProfilerIndirectArgumentCompactor::Compact(
+        VkCommandBuffer commandBuffer,
+        VkDescriptorSet descriptorSet,
+        uint32_t regionCount,
+        const DeviceProfilerIndirectArgumentCompactionRegion* pRegions ) const
+    {
+        m_pDevice->Callbacks.CmdBindDescriptorSets(
+            commandBuffer,
+            VK_PIPELINE_BIND_POINT_COMPUTE,
+            m_PipelineLayout,
+            0, 1, &descriptorSet,
+            0, nullptr );
+
+        for( uint32_t i = 0; i < regionCount; ++i )
+        {
+            const DeviceProfilerIndirectArgumentCompactionRegion& region = pRegions[ i ];
+
+            m_pDevice->Callbacks.CmdPushConstants(
+                commandBuffer,
+                m_PipelineLayout,
+                VK_SHADER_STAGE_COMPUTE_BIT,
+                0, sizeof( region ), &region );
+
+            // The shader loops over the arguments, so the number of groups can be limited.
+            const uint64_t maxSize = static_cast<uint64_t>( region.m_MaxDrawCount ) * region.m_Stride;
+            const uint32_t groupCount = static_cast<uint32_t>( std::clamp<uint64_t>(
+                ( maxSize + g_scIndirectArgumentCompactionGroupSize - 1 ) / g_scIndirectArgumentCompactionGroupSize,
+                1, g_scIndirectArgumentCompactionMaxGroupCount ) );
+
+            m_pDevice->Callbacks.CmdDispatch( commandBuffer, groupCount, 1, 1 );
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        GetCompactionRegion
+
+    Description:
+        Returns the compaction region of the arguments captured at the given byte offset
+        of the staging buffer.
+
+        All offsets and sizes are multiples of 4 (VUID-vkCmdDrawIndirectCount-stride-03110).
+
+    \***********************************************************************************/
+    DeviceProfilerIndirectArgumentCompactionRegion DeviceProfilerIndirectArgumentCompactor::GetCompactionRegion(
+        VkDeviceSize offset,
+        uint32_t maxDrawCount,
+        uint32_t stride )
+    {
+        DeviceProfilerIndirectArgumentCompactionRegion region = {};
+        region.m_Offset = static_cast<uint32_t>( offset / sizeof( uint32_t ) );
+        region.m_MaxDrawCount = maxDrawCount;
+        region.m_Stride = stride / sizeof( uint32_t );
+        return region;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        GetCompactedRegionSize
+
+    Description:
+        Returns number of bytes of the region that hold the draw count and the draws
+        below it. The count is clamped to the number of draws captured in the region.
+
+    \***********************************************************************************/
+    size_t DeviceProfilerIndirectArgumentCompactor::GetCompactedRegionSize(
+        const void* pRegionData,
+        size_t regionSize,
+        uint32_t stride )
+    {
+        uint32_t drawCount = 0;
+        memcpy( &drawCount, pRegionData, sizeof( drawCount ) );
+
+        const uint32_t maxDrawCount = static_cast<uint32_t>( ( regionSize - sizeof( uint32_t ) ) / stride );
+        return sizeof( uint32_t ) + static_cast<size_t>( std::min( drawCount, maxDrawCount ) ) * stride;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        AssembleShader
+
+    Description:
+        Assembles and validates the compaction shader module.
+
+    \***********************************************************************************/
+    bool DeviceProfilerIndirectArgumentCompactor::AssembleShader( std::vector<uint32_t>& code )
+    {
+        return AssembleShaderModule(
+            g_scIndirectArgumentCompactionShader,
+            std::size( g_scIndirectArgumentCompactionShader ) - 1,
+            code );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        CreatePipeline
+
+    Description:
+        Assembles the compaction shader and creates the compute pipeline.
+
+    \***********************************************************************************/
+    VkResult DeviceProfilerIndirectArgumentCompactor::CreatePipeline()
+    {
+        std::vector<uint32_t> code;
+        const bool assembled = AssembleShader( code );
+
+        assert( assembled );
+
+        VkResult result = assembled
+            ? VK_SUCCESS
+            : VK_ERROR_INITIALIZATION_FAILED;
+
+        VkShaderModule shaderModule = VK_NULL_HANDLE;
+
+        if( result == VK_SUCCESS )
+        {
+            VkShaderModuleCreateInfo shaderModuleCreateInfo = {};
+            shaderModuleCreateInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+            shaderModuleCreateInfo.codeSize = code.size() * sizeof( uint32_t );
+            shaderModuleCreateInfo.pCode = code.data();
+
+            result = m_pDevice->Callbacks.CreateShaderModule(
+                m_pDevice->Handle,
+                &shaderModuleCreateInfo,
+                nullptr,
+                &shaderModule );
+        }
+
+        if( result == VK_SUCCESS )
+        {
+            VkComputePipelineCreateInfo pipelineCreateInfo = {};
+            pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+            pipelineCreateInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+            pipelineCreateInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+            pipelineCreateInfo.stage.module = shaderModule;
+            pipelineCreateInfo.stage.pName = "main";
+            pipelineCreateInfo.layout = m_PipelineLayout;
+
+            result = m_pDevice->Callbacks.CreateComputePipelines(
+                m_pDevice->Handle,
+                VK_NULL_HANDLE,
+                1, &pipelineCreateInfo,
+                nullptr,
+                &m_Pipeline );
+        }
+
+        if( shaderModule != VK_NULL_HANDLE )
+        {
+            m_pDevice->Callbacks.DestroyShaderModule( m_pDevice->Handle, shaderModule, nullptr );
+        }
+
+        return result;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        CreateDescriptorPool
+
+    Description:
+        Creates a new descriptor pool for the compaction descriptor sets.
+        Called with m_DescriptorPoolsMutex locked.
+
+    \***********************************************************************************/
+    VkResult DeviceProfilerIndirectArgumentCompactor::CreateDescriptorPool( VkDescriptorPool* pDescriptorPool )
+    {
+        VkDescriptorPoolSize poolSize = {};
+        poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        poolSize.descriptorCount = 2 * g_scIndirectArgumentCompactionDescriptorPoolSize;
+
+        VkDescriptorPoolCreateInfo descriptorPoolCreateInfo = {};
+        descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        descriptorPoolCreateInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+        descriptorPoolCreateInfo.maxSets = g_scIndirectArgumentCompactionDescriptorPoolSize;
+        descriptorPoolCreateInfo.poolSizeCount = 1;
+        descriptorPoolCreateInfo.pPoolSizes = &poolSize;
+
+        VkResult result = m_pDevice->Callbacks.CreateDescriptorPool(
+            m_pDevice->Handle,
+            &descriptorPoolCreateInfo,
+            nullptr,
+            pDescriptorPool );
+
+        if( result == VK_SUCCESS )
+        {
+            m_DescriptorPools.push_back( *pDescriptorPool );
+        }
+
+        return result;
+    }
+}
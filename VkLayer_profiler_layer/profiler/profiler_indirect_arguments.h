@@ -0,0 +1,111 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+#include "profiler_layer_objects/VkDevice_object.h"
+#include <mutex>
+#include <vector>
+
+namespace Profiler
+{
+    /***********************************************************************************\
+
+    Structure:
+        DeviceProfilerIndirectArgumentCompactionRegion
+
+    Description:
+        Describes a captured vkCmdDraw*IndirectCount argument range to compact.
+        The layout matches the push constants of the compaction shader.
+
+        All values are in dwords. The draw count is stored at m_Offset, followed by
+        m_MaxDrawCount records of m_Stride dwords.
+
+    \***********************************************************************************/
+    struct DeviceProfilerIndirectArgumentCompactionRegion
+    {
+        uint32_t m_Offset;
+        uint32_t m_MaxDrawCount;
+        uint32_t m_Stride;
+    };
+
+    /***********************************************************************************\
+
+    Class:
+        DeviceProfilerIndirectArgumentCompactor
+
+    Description:
+        Internal compute pass that copies only the draws below the count read from
+        the captured count buffer to the readback buffer.
+
+    \***********************************************************************************/
+    class DeviceProfilerIndirectArgumentCompactor
+    {
+    public:
+        DeviceProfilerIndirectArgumentCompactor();
+
+        VkResult Initialize( VkDevice_Object* pDevice );
+        void Destroy();
+
+        bool IsAvailable() const;
+        VkDeviceSize GetMaxBufferSize() const;
+
+        VkResult AllocateDescriptorSet(
+            VkBuffer stagingBuffer,
+            VkBuffer readbackBuffer,
+            VkDescriptorPool* pDescriptorPool,
+            VkDescriptorSet* pDescriptorSet );
+
+        void FreeDescriptorSet(
+            VkDescriptorPool descriptorPool,
+            VkDescriptorSet descriptorSet );
+
+        void BindPipeline( VkCommandBuffer commandBuffer ) const;
+
+        void Compact(
+            VkCommandBuffer commandBuffer,
+            VkDescriptorSet descriptorSet,
+            uint32_t regionCount,
+            const DeviceProfilerIndirectArgumentCompactionRegion* pRegions ) const;
+
+        static DeviceProfilerIndirectArgumentCompactionRegion GetCompactionRegion(
+            VkDeviceSize offset,
+            uint32_t maxDrawCount,
+            uint32_t stride );
+
+        static size_t GetCompactedRegionSize(
+            const void* pRegionData,
+            size_t regionSize,
+            uint32_t stride );
+
+        static bool AssembleShader( std::vector<uint32_t>& code );
+
+    private:
+        VkDevice_Object* m_pDevice;
+
+        VkDescriptorSetLayout m_DescriptorSetLayout;
+        VkPipelineLayout m_PipelineLayout;
+        VkPipeline m_Pipeline;
+
+        std::mutex m_DescriptorPoolsMutex;
+        std::vector<VkDescriptorPool> m_DescriptorPools;
+
+        VkResult CreatePipeline();
+        VkResult CreateDescriptorPool( VkDescriptorPool* pDescriptorPool );
+    };
+}
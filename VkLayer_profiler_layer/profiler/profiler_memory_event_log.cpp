@@ -0,0 +1,156 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "profiler_memory_event_log.h"
+#include <algorithm>
+
+namespace Profiler
+{
+    // Default capacity of the ring of each thread.
+    static constexpr size_t DefaultMaxEventsPerThread = 16384;
+
+    /***********************************************************************************\
+
+    Function:
+        DeviceProfilerMemoryEventLog
+
+    Description:
+        Constructor.
+
+    \***********************************************************************************/
+    DeviceProfilerMemoryEventLog::DeviceProfilerMemoryEventLog()
+        : m_MaxEventsPerThread( DefaultMaxEventsPerThread )
+        , m_ThreadBuffers()
+    {
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        Initialize
+
+    Description:
+        Sets capacity of the ring of each thread. Must be called before any event
+        is appended.
+
+    \***********************************************************************************/
+    void DeviceProfilerMemoryEventLog::Initialize( size_t maxEventsPerThread )
+    {
+        m_MaxEventsPerThread = std::max<size_t>( maxEventsPerThread, 1 );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        Destroy
+
+    Description:
+        Frees the buffers of all threads.
+
+    \***********************************************************************************/
+    void DeviceProfilerMemoryEventLog::Destroy()
+    {
+        m_ThreadBuffers.Clear();
+        m_MaxEventsPerThread = DefaultMaxEventsPerThread;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        AppendEvent
+
+    Description:
+        Saves the event in the ring of the current thread. Overwrites the oldest
+        event if the ring is full.
+
+        The ring does not wrap around until it reaches its capacity, so it can be
+        grown by appending the events at its end.
+
+    \***********************************************************************************/
+    void DeviceProfilerMemoryEventLog::AppendEvent( DeviceProfilerMemoryEventData event )
+    {
+        event.m_ThreadId = m_ThreadBuffers.GetCurrentThreadId();
+
+        ThreadBuffer& threadBuffer = m_ThreadBuffers.GetCurrentThreadBuffer();
+        std::scoped_lock lk( threadBuffer.m_Mutex );
+
+        const size_t eventIndex = ( threadBuffer.m_FirstEventIndex + threadBuffer.m_EventCount ) % m_MaxEventsPerThread;
+        if( eventIndex < threadBuffer.m_Events.size() )
+        {
+            threadBuffer.m_Events[ eventIndex ] = event;
+        }
+        else
+        {
+            threadBuffer.m_Events.push_back( event );
+        }
+
+        if( threadBuffer.m_EventCount < m_MaxEventsPerThread )
+        {
+            threadBuffer.m_EventCount++;
+        }
+        else
+        {
+            threadBuffer.m_FirstEventIndex = ( threadBuffer.m_FirstEventIndex + 1 ) % m_MaxEventsPerThread;
+            threadBuffer.m_DroppedEventCount++;
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        CollectEvents
+
+    Description:
+        Moves the events from the rings of all threads to the output vector, sorted
+        by their timestamps. Returns the number of events dropped since the previous
+        collection.
+
+    \***********************************************************************************/
+    uint64_t DeviceProfilerMemoryEventLog::CollectEvents( std::vector<DeviceProfilerMemoryEventData>& events )
+    {
+        const size_t firstCollectedEvent = events.size();
+        uint64_t droppedEventCount = 0;
+
+        m_ThreadBuffers.ForEachBuffer( [&]( ThreadBuffer& threadBuffer )
+            {
+                std::scoped_lock bufferLock( threadBuffer.m_Mutex );
+
+                // Copy the events in two ranges if the ring wraps around.
+                const size_t firstRangeSize = std::min( threadBuffer.m_EventCount, threadBuffer.m_Events.size() - threadBuffer.m_FirstEventIndex );
+                const auto firstEvent = threadBuffer.m_Events.begin() + threadBuffer.m_FirstEventIndex;
+                events.insert( events.end(), firstEvent, firstEvent + firstRangeSize );
+                events.insert( events.end(),
+                    threadBuffer.m_Events.begin(),
+                    threadBuffer.m_Events.begin() + ( threadBuffer.m_EventCount - firstRangeSize ) );
+
+                droppedEventCount += threadBuffer.m_DroppedEventCount;
+
+                threadBuffer.m_FirstEventIndex = 0;
+                threadBuffer.m_EventCount = 0;
+                threadBuffer.m_DroppedEventCount = 0;
+            } );
+
+        // Events of a single thread are already ordered, merge the threads.
+        std::stable_sort( events.begin() + firstCollectedEvent, events.end(),
+            []( const DeviceProfilerMemoryEventData& left, const DeviceProfilerMemoryEventData& right )
+            { return left.m_Timestamp < right.m_Timestamp; } );
+
+        return droppedEventCount;
+    }
+}
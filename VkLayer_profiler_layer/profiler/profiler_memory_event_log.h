@@ -0,0 +1,67 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+#include "profiler_data.h"
+#include "profiler_thread_buffers.h"
+#include <mutex>
+#include <vector>
+
+namespace Profiler
+{
+    /***********************************************************************************\
+
+    Class:
+        DeviceProfilerMemoryEventLog
+
+    Description:
+        Collects allocate, free, bind and unbind events of the device memory.
+
+        Each thread appends the events to its own ring, so the threads do not
+        contend for a single lock. The rings grow with the number of events logged
+        between two collections up to the configured capacity. If the events are
+        not collected in time, the oldest ones are overwritten and reported as
+        dropped.
+
+    \***********************************************************************************/
+    class DeviceProfilerMemoryEventLog
+    {
+    public:
+        DeviceProfilerMemoryEventLog();
+
+        void Initialize( size_t maxEventsPerThread );
+        void Destroy();
+
+        void AppendEvent( DeviceProfilerMemoryEventData event );
+        uint64_t CollectEvents( std::vector<DeviceProfilerMemoryEventData>& events );
+
+    private:
+        struct ThreadBuffer
+        {
+            std::mutex                                  m_Mutex;
+            std::vector<DeviceProfilerMemoryEventData>  m_Events;
+            size_t                                      m_FirstEventIndex = 0;
+            size_t                                      m_EventCount = 0;
+            uint64_t                                    m_DroppedEventCount = 0;
+        };
+
+        size_t                                          m_MaxEventsPerThread;
+        DeviceProfilerThreadBuffers<ThreadBuffer>       m_ThreadBuffers;
+    };
+}
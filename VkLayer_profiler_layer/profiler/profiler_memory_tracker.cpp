@@ -19,7 +19,11 @@
 // SOFTWARE.
 
 #include "profiler_memory_tracker.h"
+#include "profiler_config.h"
+#include "profiler_counters.h"
 #include "profiler_layer_objects/VkDevice_object.h"
+#include <algorithm>
+#include <unordered_set>
 
 namespace Profiler
 {
@@ -36,6 +40,13 @@ namespace Profiler
         : m_pDevice( nullptr )
         , m_pfnGetPhysicalDeviceMemoryProperties2( nullptr )
         , m_MemoryBudgetEnabled( false )
+        , m_EventLogEnabled( false )
+        , m_TimeDomain( OSGetDefaultTimeDomain() )
+        , m_EventLog()
+        , m_SnapshotInterval( 1 )
+        , m_SnapshotAge( 0 )
+        , m_pSnapshot()
+        , m_pChanges()
         , m_AggregatedDataMutex()
         , m_TotalAllocationSize( 0 )
         , m_TotalAllocationCount( 0 )
@@ -57,9 +68,18 @@ namespace Profiler
     Description:
 
     \***********************************************************************************/
-    VkResult DeviceProfilerMemoryTracker::Initialize( VkDevice_Object* pDevice )
+    VkResult DeviceProfilerMemoryTracker::Initialize( VkDevice_Object* pDevice, const DeviceProfilerConfig& config )
     {
         m_pDevice = pDevice;
+        m_EventLogEnabled = config.m_EnableMemoryEventLog;
+
+        if( m_EventLogEnabled )
+        {
+            m_EventLog.Initialize( static_cast<size_t>( std::max( config.m_MemoryEventLogSize, 1 ) ) );
+
+            // The events describe the changes between the snapshots, so they don't have to be captured in each frame.
+            m_SnapshotInterval = static_cast<uint32_t>( std::max( config.m_MemorySnapshotInterval, 1 ) );
+        }
 
         // Resolve function pointers.
         if( m_pDevice->pInstance->Callbacks.GetPhysicalDeviceMemoryProperties2 )
@@ -102,11 +122,29 @@ namespace Profiler
         m_Heaps.clear();
         m_Types.clear();
 
+        m_EventLog.Destroy();
+        m_EventLogEnabled = false;
+        m_SnapshotInterval = 1;
+
         ResetMemoryData();
     }
 
     /***********************************************************************************\
 
+    Function:
+        SetTimeDomain
+
+    Description:
+        Sets the time domain of the timestamps of the logged memory events.
+
+    \***********************************************************************************/
+    void DeviceProfilerMemoryTracker::SetTimeDomain( VkTimeDomainEXT timeDomain )
+    {
+        m_TimeDomain = timeDomain;
+    }
+
+    /***********************************************************************************\
+
     Function:
         RegisterAllocation
 
@@ -125,6 +163,21 @@ namespace Profiler
         data.m_TypeIndex = pAllocateInfo->memoryTypeIndex;
         data.m_HeapIndex = memoryProperties.memoryTypes[ data.m_TypeIndex ].heapIndex;
 
+        // Logged events must be collected together with the snapshot that includes them.
+        std::shared_lock bindingLock( m_MemoryBindingMutex, std::defer_lock );
+        if( m_EventLogEnabled )
+        {
+            bindingLock.lock();
+
+            DeviceProfilerMemoryEventData event;
+            event.m_Type = DeviceProfilerMemoryEventType::eAllocate;
+            event.m_Memory = memory;
+            event.m_HeapIndex = data.m_HeapIndex;
+            event.m_TypeIndex = data.m_TypeIndex;
+            event.m_Size = data.m_Size;
+            AppendEvent( event );
+        }
+
         m_Allocations.insert( memory, data );
 
         std::scoped_lock lk( m_AggregatedDataMutex );
@@ -151,9 +204,26 @@ namespace Profiler
     {
         TipGuard tip( m_pDevice->TIP, __func__ );
 
+        std::shared_lock bindingLock( m_MemoryBindingMutex, std::defer_lock );
+        if( m_EventLogEnabled )
+        {
+            bindingLock.lock();
+        }
+
         DeviceProfilerDeviceMemoryData data;
         if( m_Allocations.find( memory, &data ) )
         {
+            if( m_EventLogEnabled )
+            {
+                DeviceProfilerMemoryEventData event;
+                event.m_Type = DeviceProfilerMemoryEventType::eFree;
+                event.m_Memory = memory;
+                event.m_HeapIndex = data.m_HeapIndex;
+                event.m_TypeIndex = data.m_TypeIndex;
+                event.m_Size = data.m_Size;
+                AppendEvent( event );
+            }
+
             std::scoped_lock lk( m_AggregatedDataMutex );
 
             m_Heaps[ data.m_HeapIndex ].m_AllocationCount--;
@@ -192,6 +262,14 @@ namespace Profiler
             buffer,
             &data.m_MemoryRequirements );
 
+        // Logged events must be collected together with the snapshot that includes them.
+        std::shared_lock bindingLock( m_MemoryBindingMutex, std::defer_lock );
+        if( m_EventLogEnabled )
+        {
+            bindingLock.lock();
+            AppendResourceEvent( DeviceProfilerMemoryEventType::eCreate, buffer );
+        }
+
         m_Buffers.insert( buffer, data );
     }
 
@@ -206,6 +284,32 @@ namespace Profiler
     void DeviceProfilerMemoryTracker::UnregisterBuffer( VkBufferHandle buffer )
     {
         TipGuard tip( m_pDevice->TIP, __func__ );
+
+        std::shared_lock bindingLock( m_MemoryBindingMutex, std::defer_lock );
+        if( m_EventLogEnabled )
+        {
+            bindingLock.lock();
+
+            // Release the memory ranges occupied by the buffer.
+            DeviceProfilerBufferMemoryData data;
+            if( m_Buffers.find( buffer, &data ) )
+            {
+                const size_t bindingCount = data.GetMemoryBindingCount();
+                const DeviceProfilerBufferMemoryBindingData* pBindings = data.GetMemoryBindings();
+
+                for( size_t i = 0; i < bindingCount; ++i )
+                {
+                    const VkDeviceSize size = std::holds_alternative<DeviceProfilerBufferMemoryBindingData>( data.m_MemoryBindings )
+                        ? data.m_MemoryRequirements.size
+                        : pBindings[i].m_Size;
+
+                    AppendBindingEvent( DeviceProfilerMemoryEventType::eUnbind, pBindings[i].m_Memory, pBindings[i].m_MemoryOffset, size, buffer );
+                }
+            }
+
+            AppendResourceEvent( DeviceProfilerMemoryEventType::eDestroy, buffer );
+        }
+
         m_Buffers.remove( buffer );
     }
 
@@ -241,6 +345,12 @@ namespace Profiler
 
             // Only one binding at a time is allowed using this API.
             bufferData.m_MemoryBindings = binding;
+
+            if( m_EventLogEnabled )
+            {
+                // The buffer occupies the whole size from the memory requirements.
+                AppendBindingEvent( DeviceProfilerMemoryEventType::eBind, memory, offset, bufferData.m_MemoryRequirements.size, buffer );
+            }
         }
     }
 
@@ -285,6 +395,11 @@ namespace Profiler
                 binding.m_MemoryOffset = memoryOffset;
                 binding.m_BufferOffset = bufferOffset;
                 binding.m_Size = size;
+
+                if( m_EventLogEnabled )
+                {
+                    AppendBindingEvent( DeviceProfilerMemoryEventType::eBind, memory, memoryOffset, size, buffer );
+                }
             }
             else
             {
@@ -298,6 +413,21 @@ namespace Profiler
                     const VkDeviceSize startBindingOffset = binding->m_BufferOffset;
                     const VkDeviceSize endBindingOffset = binding->m_BufferOffset + binding->m_Size;
 
+                    if( m_EventLogEnabled &&
+                        ( startUnbindOffset < endBindingOffset ) &&
+                        ( endUnbindOffset > startBindingOffset ) )
+                    {
+                        // Log the part of the memory released by the unbound range.
+                        const VkDeviceSize startUnboundMemoryOffset = std::max( startUnbindOffset, startBindingOffset );
+                        const VkDeviceSize endUnboundMemoryOffset = std::min( endUnbindOffset, endBindingOffset );
+
+                        AppendBindingEvent( DeviceProfilerMemoryEventType::eUnbind,
+                            binding->m_Memory,
+                            binding->m_MemoryOffset + ( startUnboundMemoryOffset - startBindingOffset ),
+                            endUnboundMemoryOffset - startUnboundMemoryOffset,
+                            buffer );
+                    }
+
                     if( ( startUnbindOffset <= startBindingOffset ) && ( endUnbindOffset >= endBindingOffset ) )
                     {
                         // Binding entirely covered by the unbound range, remove it.
@@ -383,6 +513,14 @@ namespace Profiler
                 data.m_SparseMemoryRequirements.data() );
         }
 
+        // Logged events must be collected together with the snapshot that includes them.
+        std::shared_lock bindingLock( m_MemoryBindingMutex, std::defer_lock );
+        if( m_EventLogEnabled )
+        {
+            bindingLock.lock();
+            AppendResourceEvent( DeviceProfilerMemoryEventType::eCreate, image );
+        }
+
         m_Images.insert( image, data );
     }
 
@@ -397,6 +535,31 @@ namespace Profiler
     void DeviceProfilerMemoryTracker::UnregisterImage( VkImageHandle image )
     {
         TipGuard tip( m_pDevice->TIP, __func__ );
+
+        std::shared_lock bindingLock( m_MemoryBindingMutex, std::defer_lock );
+        if( m_EventLogEnabled )
+        {
+            bindingLock.lock();
+
+            // Release the memory ranges occupied by the image.
+            DeviceProfilerImageMemoryData data;
+            if( m_Images.find( image, &data ) )
+            {
+                const size_t bindingCount = data.GetMemoryBindingCount();
+                const DeviceProfilerImageMemoryBindingData* pBindings = data.GetMemoryBindings();
+
+                for( size_t i = 0; i < bindingCount; ++i )
+                {
+                    if( pBindings[i].m_Type == DeviceProfilerImageMemoryBindingType::eOpaque )
+                    {
+                        AppendBindingEvent( DeviceProfilerMemoryEventType::eUnbind, pBindings[i].m_Opaque.m_Memory, pBindings[i].m_Opaque.m_MemoryOffset, pBindings[i].m_Opaque.m_Size, image );
+                    }
+                }
+            }
+
+            AppendResourceEvent( DeviceProfilerMemoryEventType::eDestroy, image );
+        }
+
         m_Images.remove( image );
     }
 
@@ -433,6 +596,11 @@ namespace Profiler
 
             // Only one binding at a time is allowed using this API.
             imageData.m_MemoryBindings = binding;
+
+            if( m_EventLogEnabled )
+            {
+                AppendBindingEvent( DeviceProfilerMemoryEventType::eBind, memory, offset, binding.m_Opaque.m_Size, image );
+            }
         }
     }
 
@@ -478,6 +646,11 @@ namespace Profiler
                 binding.m_Opaque.m_MemoryOffset = memoryOffset;
                 binding.m_Opaque.m_ImageOffset = imageOffset;
                 binding.m_Opaque.m_Size = size;
+
+                if( m_EventLogEnabled )
+                {
+                    AppendBindingEvent( DeviceProfilerMemoryEventType::eBind, memory, memoryOffset, size, image );
+                }
             }
             else
             {
@@ -553,6 +726,12 @@ namespace Profiler
                 binding.m_Block.m_ImageOffset = offset;
                 binding.m_Block.m_ImageExtent = extent;
             }
+
+            if( m_EventLogEnabled )
+            {
+                // Block bindings don't occupy tracked memory ranges, but change the state of the image.
+                AppendResourceEvent( DeviceProfilerMemoryEventType::eUpdate, image );
+            }
         }
     }
 
@@ -576,6 +755,14 @@ namespace Profiler
         data.m_Offset = pCreateInfo->offset;
         data.m_Size = pCreateInfo->size;
 
+        // Logged events must be collected together with the snapshot that includes them.
+        std::shared_lock bindingLock( m_MemoryBindingMutex, std::defer_lock );
+        if( m_EventLogEnabled )
+        {
+            bindingLock.lock();
+            AppendResourceEvent( DeviceProfilerMemoryEventType::eCreate, accelerationStructure );
+        }
+
         m_AccelerationStructures.insert( accelerationStructure, data );
     }
 
@@ -590,6 +777,14 @@ namespace Profiler
     void DeviceProfilerMemoryTracker::UnregisterAccelerationStructure( VkAccelerationStructureKHRHandle accelerationStructure )
     {
         TipGuard tip( m_pDevice->TIP, __func__ );
+
+        std::shared_lock bindingLock( m_MemoryBindingMutex, std::defer_lock );
+        if( m_EventLogEnabled )
+        {
+            bindingLock.lock();
+            AppendResourceEvent( DeviceProfilerMemoryEventType::eDestroy, accelerationStructure );
+        }
+
         m_AccelerationStructures.remove( accelerationStructure );
     }
 
@@ -613,6 +808,14 @@ namespace Profiler
         data.m_Offset = pCreateInfo->offset;
         data.m_Size = pCreateInfo->size;
 
+        // Logged events must be collected together with the snapshot that includes them.
+        std::shared_lock bindingLock( m_MemoryBindingMutex, std::defer_lock );
+        if( m_EventLogEnabled )
+        {
+            bindingLock.lock();
+            AppendResourceEvent( DeviceProfilerMemoryEventType::eCreate, micromap );
+        }
+
         m_Micromaps.insert( micromap, data );
     }
 
@@ -627,6 +830,14 @@ namespace Profiler
     void DeviceProfilerMemoryTracker::UnregisterMicromap( VkMicromapEXTHandle micromap )
     {
         TipGuard tip( m_pDevice->TIP, __func__ );
+
+        std::shared_lock bindingLock( m_MemoryBindingMutex, std::defer_lock );
+        if( m_EventLogEnabled )
+        {
+            bindingLock.lock();
+            AppendResourceEvent( DeviceProfilerMemoryEventType::eDestroy, micromap );
+        }
+
         m_Micromaps.remove( micromap );
     }
 
@@ -645,13 +856,67 @@ namespace Profiler
         DeviceProfilerMemoryData data;
 
         std::unique_lock bindingLock( m_MemoryBindingMutex );
-        data.m_Allocations = m_Allocations.to_unordered_map();
-        data.m_Buffers = m_Buffers.to_unordered_map();
-        data.m_Images = m_Images.to_unordered_map();
-        data.m_AccelerationStructures = m_AccelerationStructures.to_unordered_map();
-        data.m_Micromaps = m_Micromaps.to_unordered_map();
+
+        if( m_EventLogEnabled )
+        {
+            // Collect the events logged since the previous frame.
+            data.m_DroppedEventCount = m_EventLog.CollectEvents( data.m_Events );
+        }
+
+        // Capture a new snapshot periodically, or if the events dropped from the log
+        // have to be replaced by the current state.
+        if( !m_pSnapshot || ( m_SnapshotAge + 1 >= m_SnapshotInterval ) || ( data.m_DroppedEventCount > 0 ) )
+        {
+            auto pSnapshot = std::make_shared<DeviceProfilerMemorySnapshotData>();
+            pSnapshot->m_Allocations = m_Allocations.to_unordered_map();
+            pSnapshot->m_Buffers = m_Buffers.to_unordered_map();
+            pSnapshot->m_Images = m_Images.to_unordered_map();
+            pSnapshot->m_AccelerationStructures = m_AccelerationStructures.to_unordered_map();
+            pSnapshot->m_Micromaps = m_Micromaps.to_unordered_map();
+
+            m_pSnapshot = std::move( pSnapshot );
+            m_pChanges = nullptr;
+            m_SnapshotAge = 0;
+        }
+        else
+        {
+            // Copy only the objects changed in this frame, the previous changes are shared.
+            m_pChanges = CollectSnapshotChanges( data.m_Events );
+            m_SnapshotAge++;
+        }
+
+        data.m_pSnapshot = m_pSnapshot;
+        data.m_pChanges = m_pChanges;
+        data.m_SnapshotAge = m_SnapshotAge;
+
         bindingLock.unlock();
 
+        for( const DeviceProfilerMemoryEventData& event : data.m_Events )
+        {
+            switch( event.m_Type )
+            {
+            case DeviceProfilerMemoryEventType::eAllocate:
+                data.m_Churn.m_AllocationCount++;
+                data.m_Churn.m_AllocationSize += event.m_Size;
+                break;
+            case DeviceProfilerMemoryEventType::eFree:
+                data.m_Churn.m_FreeCount++;
+                data.m_Churn.m_FreeSize += event.m_Size;
+                break;
+            case DeviceProfilerMemoryEventType::eBind:
+                data.m_Churn.m_BindCount++;
+                data.m_Churn.m_BindSize += event.m_Size;
+                break;
+            case DeviceProfilerMemoryEventType::eUnbind:
+                data.m_Churn.m_UnbindCount++;
+                data.m_Churn.m_UnbindSize += event.m_Size;
+                break;
+            default:
+                // Resource events don't change the device memory usage.
+                break;
+            }
+        }
+
         std::unique_lock dataLock( m_AggregatedDataMutex );
         data.m_TotalAllocationSize = m_TotalAllocationSize;
         data.m_TotalAllocationCount = m_TotalAllocationCount;
@@ -712,5 +977,145 @@ namespace Profiler
         m_Images.clear();
         m_AccelerationStructures.clear();
         m_Micromaps.clear();
+        m_pSnapshot = nullptr;
+        m_pChanges = nullptr;
+        m_SnapshotAge = 0;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        CollectSnapshotChanges
+
+    Description:
+        Copies the current state of the allocations and resources referenced by the
+        events logged since the previous frame. Objects that no longer exist are
+        recorded as removed.
+
+        Must be called with the memory binding mutex locked exclusively, so that the
+        state matches the collected events.
+
+    \***********************************************************************************/
+    std::shared_ptr<const DeviceProfilerMemorySnapshotChangesData> DeviceProfilerMemoryTracker::CollectSnapshotChanges(
+        const std::vector<DeviceProfilerMemoryEventData>& events ) const
+    {
+        std::unordered_set<VkObject> changedObjects;
+
+        for( const DeviceProfilerMemoryEventData& event : events )
+        {
+            if( ( event.m_Type == DeviceProfilerMemoryEventType::eAllocate ) ||
+                ( event.m_Type == DeviceProfilerMemoryEventType::eFree ) )
+            {
+                changedObjects.insert( event.m_Memory );
+            }
+
+            if( event.m_Resource != VK_NULL_HANDLE )
+            {
+                changedObjects.insert( event.m_Resource );
+            }
+        }
+
+        auto pChanges = std::make_shared<DeviceProfilerMemorySnapshotChangesData>();
+        pChanges->m_pPrevious = m_pChanges;
+
+        auto CopyObjectData = [&]( const VkObject& object, const auto& map, auto& updated )
+            {
+                using HandleType = typename std::decay_t<decltype( updated )>::key_type;
+                using DataType = typename std::decay_t<decltype( updated )>::mapped_type;
+
+                DataType data;
+                if( map.find( HandleType( object ), &data ) )
+                {
+                    updated.emplace( HandleType( object ), std::move( data ) );
+                }
+                else
+                {
+                    pChanges->m_Removed.push_back( object );
+                }
+            };
+
+        for( const VkObject& object : changedObjects )
+        {
+            switch( object.m_Type )
+            {
+            case VK_OBJECT_TYPE_DEVICE_MEMORY:
+                CopyObjectData( object, m_Allocations, pChanges->m_Updated.m_Allocations );
+                break;
+            case VK_OBJECT_TYPE_BUFFER:
+                CopyObjectData( object, m_Buffers, pChanges->m_Updated.m_Buffers );
+                break;
+            case VK_OBJECT_TYPE_IMAGE:
+                CopyObjectData( object, m_Images, pChanges->m_Updated.m_Images );
+                break;
+            case VK_OBJECT_TYPE_ACCELERATION_STRUCTURE_KHR:
+                CopyObjectData( object, m_AccelerationStructures, pChanges->m_Updated.m_AccelerationStructures );
+                break;
+            case VK_OBJECT_TYPE_MICROMAP_EXT:
+                CopyObjectData( object, m_Micromaps, pChanges->m_Updated.m_Micromaps );
+                break;
+            default:
+                break;
+            }
+        }
+
+        return pChanges;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        AppendEvent
+
+    Description:
+        Saves the event in the memory event log.
+
+    \***********************************************************************************/
+    void DeviceProfilerMemoryTracker::AppendEvent( DeviceProfilerMemoryEventData& event )
+    {
+        event.m_Timestamp = OSGetTimestamp( m_TimeDomain );
+        m_EventLog.AppendEvent( event );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        AppendResourceEvent
+
+    Description:
+        Saves the creation, destruction or update of the resource in the memory event log.
+
+    \***********************************************************************************/
+    void DeviceProfilerMemoryTracker::AppendResourceEvent( DeviceProfilerMemoryEventType type, const VkObject& resource )
+    {
+        DeviceProfilerMemoryEventData event;
+        event.m_Type = type;
+        event.m_Resource = resource;
+        AppendEvent( event );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        AppendBindingEvent
+
+    Description:
+        Saves the bind or unbind event of the memory range in the memory event log.
+
+    \***********************************************************************************/
+    void DeviceProfilerMemoryTracker::AppendBindingEvent( DeviceProfilerMemoryEventType type, VkDeviceMemoryHandle memory, VkDeviceSize offset, VkDeviceSize size, const VkObject& resource )
+    {
+        DeviceProfilerDeviceMemoryData memoryData;
+        if( m_Allocations.find( memory, &memoryData ) )
+        {
+            DeviceProfilerMemoryEventData event;
+            event.m_Type = type;
+            event.m_Memory = memory;
+            event.m_HeapIndex = memoryData.m_HeapIndex;
+            event.m_TypeIndex = memoryData.m_TypeIndex;
+            event.m_MemoryOffset = offset;
+            event.m_Size = size;
+            event.m_Resource = resource;
+            AppendEvent( event );
+        }
     }
 }
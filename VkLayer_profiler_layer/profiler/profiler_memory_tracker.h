@@ -20,6 +20,7 @@
 
 #pragma once
 #include "profiler_data.h"
+#include "profiler_memory_event_log.h"
 #include "profiler_layer_objects/VkObject.h"
 #include "utils/lockable_unordered_map.h"
 #include <vulkan/vulkan.h>
@@ -27,6 +28,7 @@
 namespace Profiler
 {
     struct VkDevice_Object;
+    struct DeviceProfilerConfig;
 
     /***********************************************************************************\
 
@@ -42,9 +44,11 @@ namespace Profiler
     public:
         DeviceProfilerMemoryTracker();
 
-        VkResult Initialize( VkDevice_Object* pDevice );
+        VkResult Initialize( VkDevice_Object* pDevice, const DeviceProfilerConfig& config );
         void Destroy();
 
+        void SetTimeDomain( VkTimeDomainEXT timeDomain );
+
         void RegisterAllocation( VkDeviceMemoryHandle memory, const VkMemoryAllocateInfo* pAllocateInfo );
         void UnregisterAllocation( VkDeviceMemoryHandle memory );
 
@@ -74,6 +78,16 @@ namespace Profiler
 
         bool m_MemoryBudgetEnabled;
 
+        bool m_EventLogEnabled;
+        VkTimeDomainEXT m_TimeDomain;
+        DeviceProfilerMemoryEventLog mutable m_EventLog;
+
+        // Snapshot of the allocations and resources shared by the frames until the next one is captured.
+        uint32_t m_SnapshotInterval;
+        uint32_t mutable m_SnapshotAge;
+        std::shared_ptr<const DeviceProfilerMemorySnapshotData> mutable m_pSnapshot;
+        std::shared_ptr<const DeviceProfilerMemorySnapshotChangesData> mutable m_pChanges;
+
         std::shared_mutex mutable m_AggregatedDataMutex;
         uint64_t m_TotalAllocationSize;
         uint64_t m_TotalAllocationCount;
@@ -89,5 +103,11 @@ namespace Profiler
         std::shared_mutex mutable m_MemoryBindingMutex;
 
         void ResetMemoryData();
+
+        std::shared_ptr<const DeviceProfilerMemorySnapshotChangesData> CollectSnapshotChanges( const std::vector<DeviceProfilerMemoryEventData>& events ) const;
+
+        void AppendEvent( DeviceProfilerMemoryEventData& event );
+        void AppendResourceEvent( DeviceProfilerMemoryEventType type, const VkObject& resource );
+        void AppendBindingEvent( DeviceProfilerMemoryEventType type, VkDeviceMemoryHandle memory, VkDeviceSize offset, VkDeviceSize size, const VkObject& resource );
     };
 }
@@ -0,0 +1,454 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include "profiler_overhead.h"
+#include <algorithm>
+
+namespace Profiler
+{
+    // Host memory of the objects shared by all devices in the process.
+    static std::atomic_int64_t g_SharedHostMemory[ DeviceProfilerOverheadData::HostMemoryCategoryCount ];
+
+    // Innermost overhead scope of the current thread.
+    static thread_local DeviceProfilerOverheadScope* g_pCurrentOverheadScope = nullptr;
+
+    /***********************************************************************************\
+
+    Function:
+        GetPerformanceCountersDataSize
+
+    Description:
+        Estimates the host memory used by the performance counter results.
+
+    \***********************************************************************************/
+    static uint64_t GetPerformanceCountersDataSize( const DeviceProfilerPerformanceCountersData& data )
+    {
+        uint64_t size = 0;
+        size += data.m_Results.capacity() * sizeof( VkProfilerPerformanceCounterResultEXT );
+        size += data.m_StreamTimestamps.capacity() * sizeof( uint64_t );
+
+        for( const DeviceProfilerPerformanceCounterStreamData& stream : data.m_StreamResults )
+        {
+            size += sizeof( stream ) + stream.m_Samples.capacity() * sizeof( VkProfilerPerformanceCounterResultEXT );
+        }
+
+        return size;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        GetCommandBufferDataSize
+
+    Description:
+        Estimates the host memory used by the command buffer data, optionally including
+        the data of the executed secondary command buffers.
+
+    \***********************************************************************************/
+    uint64_t DeviceProfilerOverheadCounter::GetCommandBufferDataSize( const DeviceProfilerCommandBufferData& commandBuffer, bool includeSecondaryCommandBuffers )
+    {
+        uint64_t size = sizeof( commandBuffer ) + commandBuffer.m_IndirectPayload.capacity();
+
+        for( const DeviceProfilerRenderPassData& renderPass : commandBuffer.m_RenderPasses )
+        {
+            size += sizeof( renderPass );
+
+            for( const DeviceProfilerSubpassData& subpass : renderPass.m_Subpasses )
+            {
+                size += sizeof( subpass );
+
+                for( const DeviceProfilerSubpassData::Data& data : subpass.m_Data )
+                {
+                    switch( data.GetType() )
+                    {
+                    case DeviceProfilerSubpassDataType::ePipeline:
+                    {
+                        const DeviceProfilerPipelineData& pipeline = std::get<DeviceProfilerPipelineData>( data );
+                        size += sizeof( data ) + pipeline.m_Drawcalls.size() * sizeof( DeviceProfilerDrawcall );
+                        break;
+                    }
+
+                    case DeviceProfilerSubpassDataType::eCommandBuffer:
+                        size += sizeof( data );
+                        if( includeSecondaryCommandBuffers )
+                        {
+                            size += GetCommandBufferDataSize( *std::get<DeviceProfilerCommandBufferDataPtr>( data ) );
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+
+        size += GetPerformanceCountersDataSize( commandBuffer.m_PerformanceCounters );
+
+        return size;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        DeviceProfilerOverheadCounter
+
+    Description:
+        Constructor.
+
+    \***********************************************************************************/
+    DeviceProfilerOverheadCounter::DeviceProfilerOverheadCounter()
+        : m_TimeDomain( OSGetDefaultTimeDomain() )
+        , m_CpuTimeMeasurementEnabled( false )
+        , m_CopyMeasurementEnabled( false )
+        , m_LastCollectionTimestamp( 0 )
+        , m_CpuTicks()
+        , m_HostMemory()
+        , m_GpuMemory()
+        , m_CopiedDataSize( 0 )
+    {
+        m_LastCollectionTimestamp = GetCurrentTimestamp();
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        SetTimeDomain
+
+    Description:
+        Set the time domain of the CPU timestamps used to measure the overhead.
+
+    \***********************************************************************************/
+    void DeviceProfilerOverheadCounter::SetTimeDomain( VkTimeDomainEXT timeDomain )
+    {
+        m_TimeDomain = timeDomain;
+        m_LastCollectionTimestamp = GetCurrentTimestamp();
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        SetCpuTimeMeasurementEnabled
+
+    Description:
+        Enable or disable the measurement of the CPU time in DeviceProfilerOverheadScope.
+        Must be set before any scope is created.
+
+    \***********************************************************************************/
+    void DeviceProfilerOverheadCounter::SetCpuTimeMeasurementEnabled( bool enabled )
+    {
+        m_CpuTimeMeasurementEnabled = enabled;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        SetCopyMeasurementEnabled
+
+    Description:
+        Enable or disable the measurement of the command buffer data copied when
+        the frames are resolved. Estimating the size requires a walk of the copied
+        data, so it is done only when the overhead accounting is enabled.
+
+    \***********************************************************************************/
+    void DeviceProfilerOverheadCounter::SetCopyMeasurementEnabled( bool enabled )
+    {
+        m_CopyMeasurementEnabled = enabled;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        AddCpuTime
+
+    Description:
+        Add CPU time spent in the profiler's code, in timestamp ticks.
+
+    \***********************************************************************************/
+    void DeviceProfilerOverheadCounter::AddCpuTime( DeviceProfilerCpuOverheadCategory category, uint64_t ticks )
+    {
+        m_CpuTicks[ static_cast<size_t>( category ) ].fetch_add( ticks, std::memory_order_relaxed );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        AddHostMemory
+
+    Description:
+        Register allocation (positive size) or release (negative size) of the host
+        memory owned by the device.
+
+    \***********************************************************************************/
+    void DeviceProfilerOverheadCounter::AddHostMemory( DeviceProfilerHostMemoryOverheadCategory category, int64_t size )
+    {
+        m_HostMemory[ static_cast<size_t>( category ) ].fetch_add( size, std::memory_order_relaxed );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        AddGpuMemory
+
+    Description:
+        Register allocation (positive size) or release (negative size) of the device
+        memory.
+
+    \***********************************************************************************/
+    void DeviceProfilerOverheadCounter::AddGpuMemory( DeviceProfilerGpuMemoryOverheadCategory category, int64_t size )
+    {
+        m_GpuMemory[ static_cast<size_t>( category ) ].fetch_add( size, std::memory_order_relaxed );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        AddCopiedData
+
+    Description:
+        Register a copy of the command buffer data made while resolving a frame.
+        Data of the secondary command buffers is shared by reference, so it is not counted.
+
+    \***********************************************************************************/
+    void DeviceProfilerOverheadCounter::AddCopiedData( const DeviceProfilerCommandBufferData& data )
+    {
+        if( m_CopyMeasurementEnabled )
+        {
+            m_CopiedDataSize.fetch_add( GetCommandBufferDataSize( data, false ), std::memory_order_relaxed );
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        AddSharedHostMemory
+
+    Description:
+        Register allocation (positive size) or release (negative size) of the host
+        memory shared by all devices in the process.
+
+    \***********************************************************************************/
+    void DeviceProfilerOverheadCounter::AddSharedHostMemory( DeviceProfilerHostMemoryOverheadCategory category, int64_t size )
+    {
+        g_SharedHostMemory[ static_cast<size_t>( category ) ].fetch_add( size, std::memory_order_relaxed );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        CollectData
+
+    Description:
+        Write the current state of the counters to the overhead data.
+        CPU times and copied data sizes are reset, so the next collection reports
+        the values accumulated after this call. Must not be called concurrently.
+
+    \***********************************************************************************/
+    void DeviceProfilerOverheadCounter::CollectData( DeviceProfilerOverheadData& data )
+    {
+        const uint64_t timestamp = GetCurrentTimestamp();
+        const double nanosecondsPerTick = 1'000'000'000.0 / OSGetTimestampFrequency( m_TimeDomain );
+
+        for( size_t i = 0; i < DeviceProfilerOverheadData::CpuCategoryCount; ++i )
+        {
+            const uint64_t ticks = m_CpuTicks[ i ].exchange( 0, std::memory_order_relaxed );
+            data.m_CpuTime[ i ] = static_cast<uint64_t>( ticks * nanosecondsPerTick );
+        }
+
+        data.m_CpuMeasurementTime = static_cast<uint64_t>( ( timestamp - m_LastCollectionTimestamp ) * nanosecondsPerTick );
+        m_LastCollectionTimestamp = timestamp;
+
+        for( size_t i = 0; i < DeviceProfilerOverheadData::HostMemoryCategoryCount; ++i )
+        {
+            const int64_t size = m_HostMemory[ i ].load( std::memory_order_relaxed ) +
+                g_SharedHostMemory[ i ].load( std::memory_order_relaxed );
+            data.m_HostMemory[ i ] = static_cast<uint64_t>( std::max<int64_t>( size, 0 ) );
+        }
+
+        for( size_t i = 0; i < DeviceProfilerOverheadData::GpuMemoryCategoryCount; ++i )
+        {
+            const int64_t size = m_GpuMemory[ i ].load( std::memory_order_relaxed );
+            data.m_GpuMemory[ i ] = static_cast<uint64_t>( std::max<int64_t>( size, 0 ) );
+        }
+
+        data.m_CopiedDataSize = m_CopiedDataSize.exchange( 0, std::memory_order_relaxed );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        GetFrameDataSize
+
+    Description:
+        Estimates the host memory used by the frame data, excluding the memory
+        snapshot, hitches and TIP data.
+
+    \***********************************************************************************/
+    uint64_t DeviceProfilerOverheadCounter::GetFrameDataSize( const DeviceProfilerFrameData& data )
+    {
+        uint64_t size = sizeof( data );
+
+        for( const DeviceProfilerSubmitBatchData& submitBatch : data.m_Submits )
+        {
+            size += sizeof( submitBatch );
+
+            for( const DeviceProfilerSubmitData& submit : submitBatch.m_Submits )
+            {
+                size += sizeof( submit );
+                size += ( submit.m_SignalSemaphores.capacity() + submit.m_WaitSemaphores.capacity() ) * sizeof( VkSemaphoreHandle );
+
+                for( const DeviceProfilerCommandBufferDataPtr& pCommandBuffer : submit.m_CommandBuffers )
+                {
+                    size += GetCommandBufferDataSize( *pCommandBuffer );
+                }
+            }
+        }
+
+        size += data.m_TopPipelines.size() * sizeof( DeviceProfilerPipelineData );
+        size += GetPerformanceCountersDataSize( data.m_PerformanceCounters );
+        size += data.m_CPU.m_Spans.capacity() * sizeof( DeviceProfilerCpuSpanData );
+        size += data.m_SemaphoreDependencies.capacity() * sizeof( DeviceProfilerSemaphoreDependencyData );
+
+        for( const DeviceProfilerPipelineCompilationData& compilation : data.m_PipelineCompilations )
+        {
+            size += sizeof( compilation ) + compilation.m_Pipelines.capacity() * sizeof( DeviceProfilerPipelineCreationFeedbackData );
+        }
+
+        return size;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        GetMemoryDataSize
+
+    Description:
+        Estimates the host memory used by the memory snapshot of a frame.
+        Snapshots and changes shared with the previous frames are not counted again.
+
+    \***********************************************************************************/
+    uint64_t DeviceProfilerOverheadCounter::GetMemoryDataSize( const DeviceProfilerMemoryData& data )
+    {
+        // Approximate size of a node of std::unordered_map.
+        auto GetMapSize = []( const auto& map ) -> uint64_t
+            {
+                using MapType = std::decay_t<decltype( map )>;
+                return ( map.size() * ( sizeof( typename MapType::value_type ) + 2 * sizeof( void* ) ) ) +
+                    ( map.bucket_count() * sizeof( void* ) );
+            };
+
+        uint64_t size = 0;
+        size += data.m_Heaps.capacity() * sizeof( DeviceProfilerMemoryHeapData );
+        size += data.m_Types.capacity() * sizeof( DeviceProfilerMemoryTypeData );
+        if( data.m_SnapshotAge == 0 )
+        {
+            size += GetMapSize( data.m_pSnapshot->m_Allocations );
+            size += GetMapSize( data.m_pSnapshot->m_Buffers );
+            size += GetMapSize( data.m_pSnapshot->m_Images );
+            size += GetMapSize( data.m_pSnapshot->m_AccelerationStructures );
+            size += GetMapSize( data.m_pSnapshot->m_Micromaps );
+        }
+        if( data.m_pChanges )
+        {
+            // Changes of the previous frames are shared.
+            size += GetMapSize( data.m_pChanges->m_Updated.m_Allocations );
+            size += GetMapSize( data.m_pChanges->m_Updated.m_Buffers );
+            size += GetMapSize( data.m_pChanges->m_Updated.m_Images );
+            size += GetMapSize( data.m_pChanges->m_Updated.m_AccelerationStructures );
+            size += GetMapSize( data.m_pChanges->m_Updated.m_Micromaps );
+            size += data.m_pChanges->m_Removed.capacity() * sizeof( VkObject );
+        }
+        size += data.m_Events.capacity() * sizeof( DeviceProfilerMemoryEventData );
+
+        return size;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        DeviceProfilerOverheadScope
+
+    Description:
+        Constructor. Pauses the enclosing scope of the current thread.
+
+    \***********************************************************************************/
+    DeviceProfilerOverheadScope::DeviceProfilerOverheadScope( DeviceProfilerOverheadCounter& counter, DeviceProfilerCpuOverheadCategory category )
+        : m_Counter( counter )
+        , m_Category( category )
+        , m_pParentScope( nullptr )
+        , m_BeginTimestamp( 0 )
+        , m_Active( counter.IsCpuTimeMeasurementEnabled() )
+    {
+        if( !m_Active )
+        {
+            // Don't read the timestamps if the overhead accounting is disabled.
+            return;
+        }
+
+        m_pParentScope = g_pCurrentOverheadScope;
+        m_BeginTimestamp = counter.GetCurrentTimestamp();
+
+        if( m_pParentScope )
+        {
+            m_pParentScope->m_Counter.AddCpuTime(
+                m_pParentScope->m_Category,
+                m_BeginTimestamp - m_pParentScope->m_BeginTimestamp );
+        }
+
+        g_pCurrentOverheadScope = this;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        ~DeviceProfilerOverheadScope
+
+    Description:
+        Destructor.
+
+    \***********************************************************************************/
+    DeviceProfilerOverheadScope::~DeviceProfilerOverheadScope()
+    {
+        End();
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        End
+
+    Description:
+        Stops the measurement before the end of the scope and resumes the enclosing
+        scope.
+
+    \***********************************************************************************/
+    void DeviceProfilerOverheadScope::End()
+    {
+        if( m_Active )
+        {
+            const uint64_t timestamp = m_Counter.GetCurrentTimestamp();
+            m_Counter.AddCpuTime( m_Category, timestamp - m_BeginTimestamp );
+            m_Active = false;
+
+            if( m_pParentScope )
+            {
+                m_pParentScope->m_BeginTimestamp = timestamp;
+            }
+
+            g_pCurrentOverheadScope = m_pParentScope;
+        }
+    }
+}
@@ -0,0 +1,109 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+#include "profiler_counters.h"
+#include "profiler_data.h"
+#include <atomic>
+
+namespace Profiler
+{
+    /***********************************************************************************\
+
+    Class:
+        DeviceProfilerOverheadCounter
+
+    Description:
+        Accumulates the CPU time and memory used by the profiler itself.
+
+        Counters are updated concurrently by the application threads and collected
+        when the frames are resolved. Host memory of shader bytecode and pipeline
+        create infos is shared by all devices in the process and is reported as such.
+
+    \***********************************************************************************/
+    class DeviceProfilerOverheadCounter
+    {
+    public:
+        DeviceProfilerOverheadCounter();
+
+        void SetTimeDomain( VkTimeDomainEXT timeDomain );
+        void SetCpuTimeMeasurementEnabled( bool enabled );
+        void SetCopyMeasurementEnabled( bool enabled );
+
+        void AddCpuTime( DeviceProfilerCpuOverheadCategory category, uint64_t ticks );
+        void AddHostMemory( DeviceProfilerHostMemoryOverheadCategory category, int64_t size );
+        void AddGpuMemory( DeviceProfilerGpuMemoryOverheadCategory category, int64_t size );
+
+        void AddCopiedData( const DeviceProfilerCommandBufferData& data );
+
+        static void AddSharedHostMemory( DeviceProfilerHostMemoryOverheadCategory category, int64_t size );
+
+        void CollectData( DeviceProfilerOverheadData& data );
+
+        static uint64_t GetFrameDataSize( const DeviceProfilerFrameData& data );
+        static uint64_t GetCommandBufferDataSize( const DeviceProfilerCommandBufferData& data, bool includeSecondaryCommandBuffers = true );
+        static uint64_t GetMemoryDataSize( const DeviceProfilerMemoryData& data );
+
+        inline uint64_t GetCurrentTimestamp() const { return OSGetTimestamp( m_TimeDomain ); }
+        inline bool IsCpuTimeMeasurementEnabled() const { return m_CpuTimeMeasurementEnabled; }
+
+    private:
+        VkTimeDomainEXT m_TimeDomain;
+        bool m_CpuTimeMeasurementEnabled;
+        bool m_CopyMeasurementEnabled;
+        uint64_t m_LastCollectionTimestamp;
+
+        std::atomic_uint64_t m_CpuTicks[ DeviceProfilerOverheadData::CpuCategoryCount ];
+        std::atomic_int64_t m_HostMemory[ DeviceProfilerOverheadData::HostMemoryCategoryCount ];
+        std::atomic_int64_t m_GpuMemory[ DeviceProfilerOverheadData::GpuMemoryCategoryCount ];
+        std::atomic_uint64_t m_CopiedDataSize;
+    };
+
+    /***********************************************************************************\
+
+    Class:
+        DeviceProfilerOverheadScope
+
+    Description:
+        Measures CPU time spent by the profiler in the current scope.
+
+        Nested scopes pause the enclosing scope of the same thread, so the time is
+        attributed to the innermost category only. The scope does nothing if the
+        CPU time measurement is disabled in the counter.
+
+    \***********************************************************************************/
+    class DeviceProfilerOverheadScope
+    {
+    public:
+        DeviceProfilerOverheadScope( DeviceProfilerOverheadCounter& counter, DeviceProfilerCpuOverheadCategory category );
+        ~DeviceProfilerOverheadScope();
+
+        DeviceProfilerOverheadScope( const DeviceProfilerOverheadScope& ) = delete;
+        DeviceProfilerOverheadScope& operator=( const DeviceProfilerOverheadScope& ) = delete;
+
+        void End();
+
+    private:
+        DeviceProfilerOverheadCounter& m_Counter;
+        DeviceProfilerCpuOverheadCategory m_Category;
+        DeviceProfilerOverheadScope* m_pParentScope;
+        uint64_t m_BeginTimestamp;
+        bool m_Active;
+    };
+}
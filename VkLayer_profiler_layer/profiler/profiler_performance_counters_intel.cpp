@@ -47,7 +47,9 @@
 #define PROFILER_METRICS_DLL_INTEL "libigdmd.so"
 #endif
 
+#include <algorithm>
 #include <fstream>
+#include <iterator>
 
 namespace MD = MetricsDiscovery;
 
@@ -835,9 +837,6 @@ namespace Profiler
             return true;
         }
 
-        auto begin = m_MetricsStreamResults.begin();
-        auto end = m_MetricsStreamResults.end();
-
         const uint64_t beginTimestampNs = ConvertGpuTimestampToNanoseconds( beginTimestamp );
         const uint64_t endTimestampNs = ConvertGpuTimestampToNanoseconds( endTimestamp );
 
@@ -845,13 +844,25 @@ namespace Profiler
         {
             return true;
         }
-        else
-        {
-            while( ( begin != end ) && ( begin->m_GpuTimestamp < beginTimestampNs ) )
-                begin++;
-            while( ( end != begin ) && ( end - 1 )->m_GpuTimestamp > endTimestampNs )
-                end--;
-        }
+
+        // Samples are stored in the order of increasing timestamps.
+        const auto begin = std::lower_bound(
+            m_MetricsStreamResults.begin(),
+            m_MetricsStreamResults.end(),
+            beginTimestampNs,
+            []( const DeviceProfilerPerformanceCountersStreamResult& result, uint64_t timestamp )
+            {
+                return result.m_GpuTimestamp < timestamp;
+            } );
+
+        const auto end = std::upper_bound(
+            begin,
+            m_MetricsStreamResults.end(),
+            endTimestampNs,
+            []( uint64_t timestamp, const DeviceProfilerPerformanceCountersStreamResult& result )
+            {
+                return timestamp < result.m_GpuTimestamp;
+            } );
 
         bool dataComplete = ( end != m_MetricsStreamResults.end() );
 
@@ -864,8 +875,10 @@ namespace Profiler
                     ConvertNanosecondsToGpuTimestamp( it->m_GpuTimestamp - beginTimestampNs );
             }
 
-            // Copy the data to the output buffer.
-            samples.insert( samples.begin(), begin, end );
+            // Move the data to the output buffer.
+            samples.insert( samples.end(),
+                std::make_move_iterator( begin ),
+                std::make_move_iterator( end ) );
 
             m_MetricsStreamResults.erase( begin, end );
         }
@@ -1410,7 +1423,7 @@ namespace Profiler
     \***********************************************************************************/
     size_t DeviceProfilerPerformanceCountersINTEL::CollectMetricsStreamSamples()
     {
-        thread_local std::vector<VkProfilerPerformanceCounterResultEXT> parsedResults;
+        thread_local std::vector<DeviceProfilerPerformanceCountersStreamResult> parsedSamples;
 
         // Don't switch the active metrics set while reading the stream.
         std::shared_lock lk( m_ActiveMetricSetMutex );
@@ -1448,34 +1461,47 @@ namespace Profiler
         {
             const uint8_t* pReport = reinterpret_cast<const uint8_t*>( m_MetricsStreamDataBuffer.data() );
 
-            // Parse each report
+            // Parse each report into a local batch to avoid locking the results for each sample.
             for( uint32_t i = 0; i < reportCount; ++i )
             {
+                DeviceProfilerPerformanceCountersStreamResult& sample = parsedSamples.emplace_back();
+                sample.m_CpuTimestamp = cpuTimestamp;
+                sample.m_MetricsSetIndex = activeMetricsSetIndex;
+
                 ReportInformations informations;
                 ParseReport(
                     activeMetricsSetIndex,
                     VK_QUEUE_FAMILY_IGNORED,
                     reportSize,
                     pReport,
-                    parsedResults,
+                    sample.m_Data,
                     &informations );
 
-                // Save the parsed results.
-                if( !parsedResults.empty() &&
+                // Drop invalid and duplicated reports.
+                if( !sample.m_Data.empty() &&
                     ( informations.m_Timestamp != m_MetricsStreamLastResultTimestamp ) )
                 {
-                    std::scoped_lock resultsLock( m_MetricsStreamResultsMutex );
-                    m_MetricsStreamResults.push_back( {
-                        informations.m_Timestamp,
-                        cpuTimestamp,
-                        activeMetricsSetIndex,
-                        parsedResults } );
-
+                    sample.m_GpuTimestamp = informations.m_Timestamp;
                     m_MetricsStreamLastResultTimestamp = informations.m_Timestamp;
                 }
+                else
+                {
+                    parsedSamples.pop_back();
+                }
 
                 pReport += reportSize;
             }
+
+            if( !parsedSamples.empty() )
+            {
+                // Save the parsed results.
+                std::scoped_lock resultsLock( m_MetricsStreamResultsMutex );
+                m_MetricsStreamResults.insert( m_MetricsStreamResults.end(),
+                    std::make_move_iterator( parsedSamples.begin() ),
+                    std::make_move_iterator( parsedSamples.end() ) );
+
+                parsedSamples.clear();
+            }
         }
 
         return reportCount;
@@ -1497,18 +1523,17 @@ namespace Profiler
         {
             const uint64_t currentTimestamp = m_CpuTimestampCounter.GetCurrentValue();
 
-            const auto begin = m_MetricsStreamResults.begin();
-            const auto end = m_MetricsStreamResults.end();
-
             // Find the first sample that is within the max buffer length.
-            auto it = begin;
-            while( ( it != end ) && ( m_CpuTimestampCounter.Convert( currentTimestamp - it->m_CpuTimestamp ).count() > m_MetricsStreamMaxBufferLengthInNanoseconds ) )
-                it++;
+            // Samples are stored in the order of increasing timestamps.
+            const auto it = std::partition_point(
+                m_MetricsStreamResults.begin(),
+                m_MetricsStreamResults.end(),
+                [&]( const DeviceProfilerPerformanceCountersStreamResult& result )
+                {
+                    return m_CpuTimestampCounter.Convert( currentTimestamp - result.m_CpuTimestamp ).count() > m_MetricsStreamMaxBufferLengthInNanoseconds;
+                } );
 
-            if( it != begin )
-            {
-                m_MetricsStreamResults.erase( begin, it );
-            }
+            m_MetricsStreamResults.erase( m_MetricsStreamResults.begin(), it );
         }
     }
 
@@ -22,6 +22,7 @@
 #include "profiler_performance_counters.h"
 #include "profiler_counters.h"
 #include <metrics_discovery_api.h>
+#include <deque>
 #include <filesystem>
 #include <vector>
 #include <string>
@@ -156,7 +157,7 @@ namespace Profiler
         std::vector<char>                     m_MetricsStreamDataBuffer;
 
         std::mutex mutable                    m_MetricsStreamResultsMutex;
-        std::vector<DeviceProfilerPerformanceCountersStreamResult> m_MetricsStreamResults;
+        std::deque<DeviceProfilerPerformanceCountersStreamResult> m_MetricsStreamResults;
         uint64_t                              m_MetricsStreamLastResultTimestamp;
 
         std::filesystem::path FindMetricsDiscoveryLibrary();
@@ -24,6 +24,9 @@
 
 #include <profiler_layer_objects/VkDevice_object.h>
 
+#include <algorithm>
+#include <iterator>
+
 #include <NvPerfMetricsConfigBuilder.h>
 #include <NvPerfMetricConfigurationsHAL.h>
 
@@ -829,27 +832,38 @@ namespace Profiler
             return true;
         }
 
-        auto begin = m_MetricsStreamResults.begin();
-        auto end = m_MetricsStreamResults.end();
-
         if( endTimestamp < beginTimestamp )
         {
             return true;
         }
-        else
-        {
-            while( ( begin != end ) && ( begin->m_GpuTimestamp < beginTimestamp ) )
-                begin++;
-            while( ( end != begin ) && ( end - 1 )->m_GpuTimestamp > endTimestamp )
-                end--;
-        }
+
+        // Samples are stored in the order of increasing timestamps.
+        const auto begin = std::lower_bound(
+            m_MetricsStreamResults.begin(),
+            m_MetricsStreamResults.end(),
+            beginTimestamp,
+            []( const DeviceProfilerPerformanceCountersStreamResult& result, uint64_t timestamp )
+            {
+                return result.m_GpuTimestamp < timestamp;
+            } );
+
+        const auto end = std::upper_bound(
+            begin,
+            m_MetricsStreamResults.end(),
+            endTimestamp,
+            []( uint64_t timestamp, const DeviceProfilerPerformanceCountersStreamResult& result )
+            {
+                return timestamp < result.m_GpuTimestamp;
+            } );
 
         bool dataComplete = ( end != m_MetricsStreamResults.end() );
 
         if( begin != end )
         {
-            // Copy the data to the output buffer.
-            samples.insert( samples.begin(), begin, end );
+            // Move the data to the output buffer.
+            samples.insert( samples.end(),
+                std::make_move_iterator( begin ),
+                std::make_move_iterator( end ) );
 
             m_MetricsStreamResults.erase( begin, end );
         }
@@ -1040,7 +1054,7 @@ namespace Profiler
     size_t DeviceProfilerPerformanceCountersNVIDIA::CollectMetricsStreamSamples()
     {
         thread_local std::vector<double> parsedValues;
-        thread_local std::vector<VkProfilerPerformanceCounterResultEXT> parsedResults;
+        thread_local std::vector<DeviceProfilerPerformanceCountersStreamResult> parsedSamples;
 
         // Don't switch the active metrics set while reading the stream.
         std::shared_lock lk( m_ActiveMetricsSetMutex );
@@ -1108,7 +1122,6 @@ namespace Profiler
             GetMetricEvalRequests( activeMetricsSetIndex );
 
         parsedValues.resize( metricEvalRequests.size() );
-        parsedResults.resize( metricEvalRequests.size() );
 
         uint32_t reportCount = 0;
 
@@ -1128,11 +1141,6 @@ namespace Profiler
                 return false;
             }
 
-            for( size_t i = 0; i < parsedValues.size(); ++i )
-            {
-                parsedResults[i].float32 = static_cast<float>( parsedValues[i] );
-            }
-
             // Read the sample collection timestamp.
             nv::perf::sampler::SampleTimestamp sampleTimestamp = {};
 
@@ -1146,13 +1154,17 @@ namespace Profiler
 
             if( sampleTimestamp.end != m_MetricsStreamLastResultTimestamp )
             {
-                // Store the parsed results in the stream results buffer.
-                std::scoped_lock resultsLock( m_MetricsStreamResultsMutex );
-                m_MetricsStreamResults.push_back( {
-                    sampleTimestamp.end,
-                    cpuTimestamp,
-                    activeMetricsSetIndex,
-                    parsedResults } );
+                // Store the parsed results in a local batch to avoid locking the results for each sample.
+                DeviceProfilerPerformanceCountersStreamResult& sample = parsedSamples.emplace_back();
+                sample.m_GpuTimestamp = sampleTimestamp.end;
+                sample.m_CpuTimestamp = cpuTimestamp;
+                sample.m_MetricsSetIndex = activeMetricsSetIndex;
+                sample.m_Data.resize( parsedValues.size() );
+
+                for( size_t i = 0; i < parsedValues.size(); ++i )
+                {
+                    sample.m_Data[i].float32 = static_cast<float>( parsedValues[i] );
+                }
 
                 m_MetricsStreamLastResultTimestamp = sampleTimestamp.end;
             }
@@ -1161,7 +1173,20 @@ namespace Profiler
             return true;
         };
 
-        if( !m_CounterData.ConsumeData( ConsumeProc ) )
+        const bool dataConsumed = m_CounterData.ConsumeData( ConsumeProc );
+
+        if( !parsedSamples.empty() )
+        {
+            // Save the parsed results.
+            std::scoped_lock resultsLock( m_MetricsStreamResultsMutex );
+            m_MetricsStreamResults.insert( m_MetricsStreamResults.end(),
+                std::make_move_iterator( parsedSamples.begin() ),
+                std::make_move_iterator( parsedSamples.end() ) );
+
+            parsedSamples.clear();
+        }
+
+        if( !dataConsumed )
         {
             return 0;
         }
@@ -1190,18 +1215,17 @@ namespace Profiler
         {
             const uint64_t currentTimestamp = m_CpuTimestampCounter.GetCurrentValue();
 
-            const auto begin = m_MetricsStreamResults.begin();
-            const auto end = m_MetricsStreamResults.end();
-
             // Find the first sample that is within the max buffer length.
-            auto it = begin;
-            while( ( it != end ) && ( m_CpuTimestampCounter.Convert( currentTimestamp - it->m_CpuTimestamp ).count() > m_MetricsStreamMaxBufferLengthInNanoseconds ) )
-                it++;
+            // Samples are stored in the order of increasing timestamps.
+            const auto it = std::partition_point(
+                m_MetricsStreamResults.begin(),
+                m_MetricsStreamResults.end(),
+                [&]( const DeviceProfilerPerformanceCountersStreamResult& result )
+                {
+                    return m_CpuTimestampCounter.Convert( currentTimestamp - result.m_CpuTimestamp ).count() > m_MetricsStreamMaxBufferLengthInNanoseconds;
+                } );
 
-            if( it != begin )
-            {
-                m_MetricsStreamResults.erase( begin, it );
-            }
+            m_MetricsStreamResults.erase( m_MetricsStreamResults.begin(), it );
         }
     }
 
@@ -30,6 +30,7 @@
 #include <NvPerfPeriodicSamplerGpu.h>
 #include <NvPerfCounterData.h>
 
+#include <deque>
 #include <vector>
 #include <mutex>
 #include <shared_mutex>
@@ -126,7 +127,7 @@ namespace Profiler
         bool                        m_MetricsStreamCollectionThreadExit;
         
         std::mutex mutable          m_MetricsStreamResultsMutex;
-        std::vector<DeviceProfilerPerformanceCountersStreamResult> m_MetricsStreamResults;
+        std::deque<DeviceProfilerPerformanceCountersStreamResult> m_MetricsStreamResults;
         uint64_t                    m_MetricsStreamLastResultTimestamp;
         uint64_t                    m_MetricsStreamMaxBufferLengthInNanoseconds;
         uint32_t                    m_MetricsStreamMaxReportCount;
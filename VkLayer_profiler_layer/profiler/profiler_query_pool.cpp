@@ -20,6 +20,7 @@
 
 #include "profiler_query_pool.h"
 #include "profiler_memory_manager.h"
+#include "profiler_data.h"
 #include "profiler.h"
 
 namespace Profiler
@@ -61,6 +62,12 @@ namespace Profiler
             &m_Allocation,
             &m_AllocationInfo );
 
+        if( result == VK_SUCCESS )
+        {
+            m_Profiler.m_Overhead.AddGpuMemory( DeviceProfilerGpuMemoryOverheadCategory::eQueryDataBuffers,
+                static_cast<int64_t>( m_AllocationInfo.size ) );
+        }
+
         if( result != VK_SUCCESS )
         {
             memset( &m_AllocationInfo, 0, sizeof( m_AllocationInfo ) );
@@ -92,6 +99,9 @@ namespace Profiler
             m_Profiler.m_MemoryManager.FreeBuffer(
                 m_Buffer,
                 m_Allocation );
+
+            m_Profiler.m_Overhead.AddGpuMemory( DeviceProfilerGpuMemoryOverheadCategory::eQueryDataBuffers,
+                -static_cast<int64_t>( m_AllocationInfo.size ) );
         }
 
         if( m_pCpuAllocation )
@@ -117,8 +127,13 @@ namespace Profiler
             m_Profiler.m_MemoryManager.FreeBuffer(
                 m_Buffer,
                 m_Allocation );
+            m_Buffer = VK_NULL_HANDLE;
+            m_Allocation = VK_NULL_HANDLE;
             memset( &m_AllocationInfo, 0, sizeof( m_AllocationInfo ) );
 
+            m_Profiler.m_Overhead.AddGpuMemory( DeviceProfilerGpuMemoryOverheadCategory::eQueryDataBuffers,
+                -static_cast<int64_t>( bufferSize ) );
+
             m_pCpuAllocation = malloc( bufferSize );
 
             if( m_pCpuAllocation != nullptr )
@@ -222,6 +237,28 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Function:
+        GetQueryDataSize
+
+    Description:
+        Returns number of bytes occupied by the timestamp and pipeline statistics query
+        results of all contexts. The contexts are stored one after another from the
+        beginning of the buffer.
+
+    \***********************************************************************************/
+    uint32_t DeviceProfilerQueryDataBuffer::GetQueryDataSize() const
+    {
+        uint32_t size = 0;
+        for( const auto& [handle, context] : m_Contexts )
+        {
+            size = std::max( size, context.m_TimestampDataOffset + context.m_TimestampDataSize );
+            size = std::max( size, context.m_PipelineStatisticsDataOffset + context.m_PipelineStatisticsDataSize );
+        }
+        return size;
+    }
+
+    /***********************************************************************************\
+
     Function:
         DeviceProfilerQueryDataBufferWriter
 
@@ -308,6 +345,58 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Function:
+        WritePipelineStatisticsQueryResults
+
+    Description:
+        Copies pipeline statistics query results the same way as the timestamps.
+        Each query occupies one 64-bit value per statistic enabled in the flags.
+
+    \***********************************************************************************/
+    void DeviceProfilerQueryDataBufferWriter::WritePipelineStatisticsQueryResults( VkQueryPool queryPool, uint32_t queryCount, VkQueryPipelineStatisticFlags flags )
+    {
+        const uint32_t stride = (BitCount( flags ) * sizeof( uint64_t ));
+        const uint32_t dataSize = (queryCount * stride);
+
+        if( m_pContext->m_PipelineStatisticsDataSize == 0 )
+        {
+            // Statistics of the context are stored after its timestamps.
+            m_pContext->m_PipelineStatisticsDataOffset = m_DataOffset;
+            m_pContext->m_PipelineStatisticsFlags = flags;
+        }
+
+        assert( m_pContext->m_PipelineStatisticsFlags == flags );
+        assert( m_pContext->m_PipelineStatisticsDataOffset + m_pContext->m_PipelineStatisticsDataSize == m_DataOffset );
+
+        if( m_CommandBuffer != VK_NULL_HANDLE )
+        {
+            m_pProfiler->m_pDevice->Callbacks.CmdCopyQueryPoolResults(
+                m_CommandBuffer,
+                queryPool,
+                0, queryCount,
+                m_GpuBuffer,
+                m_DataOffset,
+                stride,
+                VK_QUERY_RESULT_64_BIT );
+        }
+        else
+        {
+            m_pProfiler->m_pDevice->Callbacks.GetQueryPoolResults(
+                m_pProfiler->m_pDevice->Handle,
+                queryPool,
+                0, queryCount,
+                dataSize,
+                m_CpuBuffer + m_DataOffset,
+                stride,
+                VK_QUERY_RESULT_64_BIT );
+        }
+
+        m_pContext->m_PipelineStatisticsDataSize += dataSize;
+        m_DataOffset += dataSize;
+    }
+
+    /***********************************************************************************\
+
     Function:
         WritePerformanceQueryResults
 
@@ -342,9 +431,23 @@ namespace Profiler
         , m_pData( &dataBuffer )
         , m_pContext( nullptr )
         , m_pMappedData( m_pData->GetMappedData() )
-        , m_pMappedTimestampQueryData( nullptr )
+        , m_QueryData( 0 )
+        , m_pContextTimestampQueryData( nullptr )
+        , m_ContextTimestampQueryCount( 0 )
+        , m_pContextPipelineStatisticsQueryData( nullptr )
+        , m_ContextPipelineStatisticsQueryDataCount( 0 )
         , m_PerformanceQueryData( 0 )
-    {}
+    {
+        // Copy all query results in a single sequential read instead of accessing the mapped
+        // memory randomly while traversing the command buffers.
+        const uint32_t queryDataSize = m_pData->GetQueryDataSize();
+
+        if( (m_pMappedData != nullptr) && (queryDataSize > 0) )
+        {
+            m_QueryData.resize( queryDataSize / sizeof( uint64_t ) );
+            memcpy( m_QueryData.data(), m_pMappedData, queryDataSize );
+        }
+    }
 
     /***********************************************************************************\
 
@@ -358,23 +461,46 @@ namespace Profiler
     void DeviceProfilerQueryDataBufferReader::SetContext( const void* handle )
     {
         m_pContext = m_pData->GetContext( handle );
-        m_pMappedTimestampQueryData = reinterpret_cast<const uint64_t*>(m_pMappedData + m_pContext->m_TimestampDataOffset);
+        m_pContextTimestampQueryData = m_QueryData.data() + (m_pContext->m_TimestampDataOffset / sizeof( uint64_t ));
+        m_ContextTimestampQueryCount = m_pContext->m_TimestampDataSize / sizeof( uint64_t );
+        m_pContextPipelineStatisticsQueryData = m_QueryData.data() + (m_pContext->m_PipelineStatisticsDataOffset / sizeof( uint64_t ));
+        m_ContextPipelineStatisticsQueryDataCount = m_pContext->m_PipelineStatisticsDataSize / sizeof( uint64_t );
         m_PerformanceQueryData.resize( m_pContext->m_PerformanceDataSize );
     }
 
     /***********************************************************************************\
 
     Function:
-        ReadTimestampQueryResult
+        ReadPipelineStatisticsQueryResult
 
     Description:
-        Returns timestamp query value at the given index. The indices are counted
-        independently for each command buffer context.
+        Reads results of the pipeline statistics query at statistics.m_Index. Results of
+        all views of a multiview render pass are summed. The statistics are cleared if
+        the query was not collected.
 
     \***********************************************************************************/
-    uint64_t DeviceProfilerQueryDataBufferReader::ReadTimestampQueryResult( uint64_t queryIndex ) const
+    void DeviceProfilerQueryDataBufferReader::ReadPipelineStatisticsQueryResult( DeviceProfilerPipelineStatistics& statistics ) const
     {
-        return m_pMappedTimestampQueryData[ queryIndex ];
+        DeviceProfilerPipelineStatistics result;
+        result.m_Index = statistics.m_Index;
+        result.m_ViewCount = statistics.m_ViewCount;
+
+        if( (statistics.m_Index != UINT64_MAX) &&
+            (m_pContext->m_PipelineStatisticsFlags != 0) )
+        {
+            const VkQueryPipelineStatisticFlags flags = m_pContext->m_PipelineStatisticsFlags;
+            const size_t stride = BitCount( flags );
+
+            for( uint32_t viewIndex = 0; viewIndex < statistics.m_ViewCount; ++viewIndex )
+            {
+                const size_t offset = (statistics.m_Index + viewIndex) * stride;
+                assert( offset + stride <= m_ContextPipelineStatisticsQueryDataCount );
+
+                result.AddQueryResult( flags, m_pContextPipelineStatisticsQueryData + offset );
+            }
+        }
+
+        statistics = result;
     }
 
     /***********************************************************************************\
@@ -29,11 +29,15 @@
 namespace Profiler
 {
     class DeviceProfiler;
+    struct DeviceProfilerPipelineStatistics;
 
     struct DeviceProfilerQueryDataContext
     {
         uint32_t m_TimestampDataOffset = 0;
         uint32_t m_TimestampDataSize = 0;
+        uint32_t m_PipelineStatisticsDataOffset = 0;
+        uint32_t m_PipelineStatisticsDataSize = 0;
+        VkQueryPipelineStatisticFlags m_PipelineStatisticsFlags = 0;
         uint32_t m_PerformanceDataSize = 0;
         uint32_t m_PerformanceDataMetricsSetIndex = 0;
         VkQueryPool m_PerformanceQueryPool = VK_NULL_HANDLE;
@@ -45,7 +49,8 @@ namespace Profiler
         DeviceProfilerQueryDataBuffer
 
     Description:
-        An allocation that stores results of timestamp and performance queries.
+        An allocation that stores results of timestamp, pipeline statistics and
+        performance queries.
 
     \***********************************************************************************/
     class DeviceProfilerQueryDataBuffer
@@ -70,6 +75,8 @@ namespace Profiler
         DeviceProfilerQueryDataContext* CreateContext( const void* handle );
         const DeviceProfilerQueryDataContext* GetContext( const void* handle ) const;
 
+        uint32_t GetQueryDataSize() const;
+
     private:
         DeviceProfiler&   m_Profiler;
         VkBuffer          m_Buffer;
@@ -98,6 +105,7 @@ namespace Profiler
 
         void SetContext( const void* handle );
         void WriteTimestampQueryResults( VkQueryPool queryPool, uint32_t queryCount );
+        void WritePipelineStatisticsQueryResults( VkQueryPool queryPool, uint32_t queryCount, VkQueryPipelineStatisticFlags flags );
         void WritePerformanceQueryResults( VkQueryPool queryPool, uint32_t metricsSetIndex, uint32_t queueFamilyIndex );
 
     private:
@@ -115,11 +123,18 @@ namespace Profiler
     /***********************************************************************************\
 
     Class:
-        DeviceProfilerQueryDataBufferWriter
+        DeviceProfilerQueryDataBufferReader
 
     Description:
         Helper class that can be used to read the data from the buffer.
 
+        All timestamps and pipeline statistics stored in the buffer are copied to
+        a contiguous host array at construction, so resolving a command buffer does not
+        touch the mapped memory (which may be uncached) once per query.
+
+        The resolved values are written to the nodes of the command buffer tree. Each
+        output converts the ticks to time with its own period and calibration.
+
     \***********************************************************************************/
     class DeviceProfilerQueryDataBufferReader
     {
@@ -128,8 +143,12 @@ namespace Profiler
             const DeviceProfiler& profiler,
             const DeviceProfilerQueryDataBuffer& dataBuffer );
 
+        DeviceProfilerQueryDataBufferReader( const DeviceProfilerQueryDataBufferReader& ) = delete;
+        DeviceProfilerQueryDataBufferReader& operator=( const DeviceProfilerQueryDataBufferReader& ) = delete;
+
         void SetContext( const void* handle );
         uint64_t ReadTimestampQueryResult( uint64_t index ) const;
+        void ReadPipelineStatisticsQueryResult( DeviceProfilerPipelineStatistics& statistics ) const;
         uint32_t GetPerformanceQueryMetricsSetIndex() const;
         uint32_t GetPerformanceQueryResultSize() const;
         const uint8_t* ReadPerformanceQueryResult();
@@ -140,7 +159,29 @@ namespace Profiler
         const DeviceProfilerQueryDataBuffer*  m_pData;
         const DeviceProfilerQueryDataContext* m_pContext;
         const uint8_t*                        m_pMappedData;
-        const uint64_t*                       m_pMappedTimestampQueryData;
+        std::vector<uint64_t>                 m_QueryData;
+        const uint64_t*                       m_pContextTimestampQueryData;
+        size_t                                m_ContextTimestampQueryCount;
+        const uint64_t*                       m_pContextPipelineStatisticsQueryData;
+        size_t                                m_ContextPipelineStatisticsQueryDataCount;
         std::vector<uint8_t>                  m_PerformanceQueryData;
     };
+
+    /***********************************************************************************\
+
+    Function:
+        ReadTimestampQueryResult
+
+    Description:
+        Returns timestamp query value at the given index. The indices are counted
+        independently for each command buffer context.
+
+        Defined inline, as it is called for each timestamp in the command buffer tree.
+
+    \***********************************************************************************/
+    inline uint64_t DeviceProfilerQueryDataBufferReader::ReadTimestampQueryResult( uint64_t queryIndex ) const
+    {
+        assert( queryIndex < m_ContextTimestampQueryCount );
+        return m_pContextTimestampQueryData[ queryIndex ];
+    }
 }
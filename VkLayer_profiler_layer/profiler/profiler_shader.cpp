@@ -19,12 +19,21 @@
 // SOFTWARE.
 
 #include "profiler_shader.h"
+#include "profiler_overhead.h"
 
 #include <assert.h>
 #include <utility>
 #include <sstream>
 
 #include <farmhash.h>
+#include <spirv-tools/libspirv.h>
+
+namespace
+{
+    // Header of a SPIR-V module: magic number, version, generator, bound and schema.
+    static constexpr uint32_t g_scSpirvMagicNumber = 0x07230203;
+    static constexpr size_t g_scSpirvHeaderWordCount = 5;
+}
 
 namespace Profiler
 {
@@ -511,11 +520,29 @@ namespace Profiler
                     m_pFileName = ( pFileName ? pFileName + 1 : it->second );
                 }
             }
+
+            DeviceProfilerOverheadCounter::AddSharedHostMemory( DeviceProfilerHostMemoryOverheadCategory::eShaderBytecode,
+                static_cast<int64_t>( m_Bytecode.capacity() * sizeof( uint32_t ) ) );
         }
     }
 
     /***********************************************************************************\
 
+    Function:
+        ~ProfilerShaderModule
+
+    Description:
+        Destructor.
+
+    \***********************************************************************************/
+    ProfilerShaderModule::~ProfilerShaderModule()
+    {
+        DeviceProfilerOverheadCounter::AddSharedHostMemory( DeviceProfilerHostMemoryOverheadCategory::eShaderBytecode,
+            -static_cast<int64_t>( m_Bytecode.capacity() * sizeof( uint32_t ) ) );
+    }
+
+    /***********************************************************************************\
+
     Function:
         UsesRayQuery
 
@@ -725,4 +752,52 @@ namespace Profiler
 
         return buffer.str();
     }
+
+    /***********************************************************************************\
+
+    Function:
+        AssembleShaderModule
+
+    Description:
+        Assemble and validate a SPIR-V module for Vulkan 1.0 from the assembly text.
+        Used for the internal shaders of the layer.
+
+    \***********************************************************************************/
+    bool AssembleShaderModule( const char* pText, size_t textSize, std::vector<uint32_t>& code )
+    {
+        spv_context context = spvContextCreate( SPV_ENV_VULKAN_1_0 );
+        spv_binary binary = nullptr;
+        spv_diagnostic diagnostic = nullptr;
+
+        spv_result_t result = spvTextToBinary(
+            context,
+            pText,
+            textSize,
+            &binary,
+            &diagnostic );
+
+        if( result == SPV_SUCCESS )
+        {
+            spv_const_binary_t validateBinary = {};
+            validateBinary.code = binary->code;
+            validateBinary.wordCount = binary->wordCount;
+
+            result = spvValidate( context, &validateBinary, &diagnostic );
+        }
+
+        if( result == SPV_SUCCESS )
+        {
+            code.assign( binary->code, binary->code + binary->wordCount );
+        }
+
+        spvBinaryDestroy( binary );
+        spvDiagnosticDestroy( diagnostic );
+        spvContextDestroy( context );
+
+        // Check the header of the module.
+        return ( result == SPV_SUCCESS ) &&
+            ( code.size() > g_scSpirvHeaderWordCount ) &&
+            ( code[ 0 ] == g_scSpirvMagicNumber ) &&
+            ( code[ 3 ] != 0 );
+    }
 }
@@ -41,6 +41,11 @@ namespace Profiler
 
         ProfilerShaderModule() = default;
         ProfilerShaderModule( const uint32_t* pBytecode, size_t bytecodeSize, const uint8_t* pIdentifier, uint32_t identifierSize );
+        ~ProfilerShaderModule();
+
+        // m_pFileName points to the bytecode, so the module must not be copied.
+        ProfilerShaderModule( const ProfilerShaderModule& ) = delete;
+        ProfilerShaderModule& operator=( const ProfilerShaderModule& ) = delete;
     };
 
     struct ProfilerShader
@@ -146,6 +151,8 @@ namespace Profiler
 
         std::string GetShaderStageHashesString( VkShaderStageFlags stages, bool showEntryPoints = false, bool skipEmptyStages = false ) const;
     };
+
+    bool AssembleShaderModule( const char* pText, size_t textSize, std::vector<uint32_t>& code );
 }
 
 
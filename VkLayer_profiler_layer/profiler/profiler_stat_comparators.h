@@ -19,6 +19,7 @@
 // SOFTWARE.
 
 #pragma once
+#include <memory>
 
 namespace Profiler
 {
@@ -29,6 +30,12 @@ namespace Profiler
         return (a.GetEndTimestamp().m_Value - a.GetBeginTimestamp().m_Value);
     }
 
+    template<typename Data>
+    inline uint64_t GetDuration( const std::shared_ptr<Data>& a )
+    {
+        return GetDuration( *a );
+    }
+
     // Extracts a specific type from an std::variant
     template<typename TypeHint, typename Data>
     struct DataCast
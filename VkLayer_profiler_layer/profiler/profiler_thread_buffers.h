@@ -0,0 +1,164 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+#include "profiler_helpers.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace Profiler
+{
+    /***********************************************************************************\
+
+    Class:
+        DeviceProfilerThreadBuffers
+
+    Description:
+        Map of buffers owned by the application threads.
+
+        Each thread gets its own buffer, so the threads do not contend for a single
+        lock when they append the data. The buffer of the current thread is cached
+        in a thread-local variable to avoid the lookup in the common case. The cache
+        is invalidated by assigning a new identifier to the map when it is cleared.
+
+        The buffers are not synchronized by the map and must provide their own lock.
+
+    \***********************************************************************************/
+    template<typename BufferType>
+    class DeviceProfilerThreadBuffers
+    {
+    public:
+        DeviceProfilerThreadBuffers()
+            : m_Id( NextId++ )
+            , m_Mutex()
+            , m_Buffers()
+        {
+        }
+
+        /***********************************************************************************\
+
+        Function:
+            GetCurrentThreadId
+
+        Description:
+            Returns ID of the current thread. Querying the thread ID requires a system
+            call on some platforms, so it is cached in a thread-local variable.
+
+        \***********************************************************************************/
+        static uint32_t GetCurrentThreadId()
+        {
+            thread_local const uint32_t threadId = ProfilerPlatformFunctions::GetCurrentThreadId();
+            return threadId;
+        }
+
+        /***********************************************************************************\
+
+        Function:
+            GetCurrentThreadBuffer
+
+        Description:
+            Returns the buffer of the current thread. Creates the buffer on the first
+            use in the thread.
+
+        \***********************************************************************************/
+        BufferType& GetCurrentThreadBuffer()
+        {
+            thread_local uint64_t cachedId = 0;
+            thread_local BufferType* pCachedBuffer = nullptr;
+
+            std::shared_lock lk( m_Mutex );
+
+            if( cachedId != m_Id )
+            {
+                const uint32_t threadId = GetCurrentThreadId();
+
+                auto it = m_Buffers.find( threadId );
+                if( it == m_Buffers.end() )
+                {
+                    // Upgrade the lock to insert the buffer for the new thread.
+                    lk.unlock();
+                    {
+                        std::unique_lock writeLock( m_Mutex );
+                        std::unique_ptr<BufferType>& pBuffer = m_Buffers[ threadId ];
+                        if( !pBuffer )
+                        {
+                            pBuffer = std::make_unique<BufferType>();
+                        }
+                    }
+                    lk.lock();
+
+                    it = m_Buffers.find( threadId );
+                }
+
+                cachedId = m_Id;
+                pCachedBuffer = it->second.get();
+            }
+
+            return *pCachedBuffer;
+        }
+
+        /***********************************************************************************\
+
+        Function:
+            ForEachBuffer
+
+        Description:
+            Invokes the function for the buffers of all threads.
+
+        \***********************************************************************************/
+        template<typename FunctionType>
+        void ForEachBuffer( FunctionType&& function )
+        {
+            std::shared_lock lk( m_Mutex );
+
+            for( auto& [threadId, pBuffer] : m_Buffers )
+            {
+                function( *pBuffer );
+            }
+        }
+
+        /***********************************************************************************\
+
+        Function:
+            Clear
+
+        Description:
+            Frees the buffers of all threads.
+
+        \***********************************************************************************/
+        void Clear()
+        {
+            std::unique_lock lk( m_Mutex );
+            m_Buffers.clear();
+            m_Id = NextId++;
+        }
+
+    private:
+        // Source of unique map identifiers.
+        inline static std::atomic_uint64_t NextId = 1;
+
+        uint64_t                                        m_Id;
+
+        std::shared_mutex                               m_Mutex;
+        std::unordered_map<uint32_t, std::unique_ptr<BufferType>> m_Buffers;
+    };
+}
@@ -20,6 +20,9 @@
 
 #include "VkProfilerEXT.h"
 #include "VkDevice_functions.h"
+#include "profiler_trace/profiler_trace.h"
+
+#include <algorithm>
 
 using namespace Profiler;
 
@@ -77,28 +80,86 @@ private:
         delete[] ptr;
     }
 
+    inline static size_t align_up( size_t value, size_t alignment )
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    // Strictest alignment of the structures allocated from the caller-provided buffer.
+    static constexpr size_t MaxAlignment =
+        std::max( alignof( VkProfilerRegionDataEXT ), alignof( VkProfilerRenderPassDataEXT ) );
+
+    // Returns offset of the next suitably aligned address relative to the buffer's base address.
+    inline static size_t align_offset( uintptr_t base, size_t offset, size_t alignment )
+    {
+        return static_cast<size_t>( align_up( base + offset, alignment ) - base );
+    }
+
+    // Allocates memory from the caller-provided buffer, if set, or from the heap otherwise.
+    template<typename T>
+    inline VkResult Allocate( size_t count, T** pptr )
+    {
+        if( !m_pBuffer )
+        {
+            return safe_alloc<T>( count, pptr );
+        }
+
+        // The caller's buffer may be arbitrarily aligned, align the absolute address.
+        const size_t offset = align_offset( reinterpret_cast<uintptr_t>( m_pBuffer ), m_BufferOffset, alignof( T ) );
+        const size_t size = count * sizeof( T );
+
+        if( (offset + size) > m_BufferSize )
+        {
+            (*pptr) = nullptr;
+            return VK_INCOMPLETE;
+        }
+
+        (*pptr) = (count > 0) ? reinterpret_cast<T*>( m_pBuffer + offset ) : nullptr;
+        m_BufferOffset = offset + size;
+        return VK_SUCCESS;
+    }
+
+    // Accounts for memory required by Allocate in a buffer placed at m_MeasureBase.
+    template<typename T>
+    inline void Reserve( size_t count )
+    {
+        m_BufferOffset = align_offset( m_MeasureBase, m_BufferOffset, alignof( T ) ) + (count * sizeof( T ));
+    }
+
     template<typename DataContainer, typename CallbackType>
     inline VkResult SerializeSubregions(
         const DataContainer& data,
         CallbackType callback,
         VkProfilerRegionDataEXT& out )
     {
+        if( m_Depth >= m_MaxDepth )
+        {
+            // Subregions are below the requested depth
+            out.subregionCount = 0;
+            out.pSubregions = nullptr;
+            return VK_SUCCESS;
+        }
+
         // Subregions (VkRenderPass)
         out.subregionCount = safe_cast<uint32_t>( data.size() );
 
         // Allocate space for subregion list
-        VkResult result = safe_alloc<VkProfilerRegionDataEXT>( data.size(), &out.pSubregions );
+        VkResult result = Allocate<VkProfilerRegionDataEXT>( data.size(), &out.pSubregions );
 
         // Data is stored in lists so indexing cannot be used
         auto it = data.begin();
 
+        m_Depth++;
+
         for( uint32_t i = 0; (result == VK_SUCCESS) && (i < data.size()); ++i, ++it )
         {
             // Serialize VkRenderPass
             result = (this->*callback)( *it, out.pSubregions[ i ] );
         }
 
-        if( result != VK_SUCCESS )
+        m_Depth--;
+
+        if( (result != VK_SUCCESS) && !m_pBuffer )
         {
             // Revert from partially-initialized state
             FreeProfilerRegion( out );
@@ -108,6 +169,28 @@ private:
         return result;
     }
 
+    template<typename DataContainer, typename CallbackType>
+    inline void MeasureSubregions(
+        const DataContainer& data,
+        CallbackType callback )
+    {
+        if( m_Depth >= m_MaxDepth )
+        {
+            return;
+        }
+
+        Reserve<VkProfilerRegionDataEXT>( data.size() );
+
+        m_Depth++;
+
+        for( const auto& subregion : data )
+        {
+            (this->*callback)( subregion );
+        }
+
+        m_Depth--;
+    }
+
     inline VkProfilerCommandTypeEXT DrawcallTypeToCommandType( DeviceProfilerDrawcallType type ) const
     {
         static const std::unordered_map<DeviceProfilerDrawcallType, VkProfilerCommandTypeEXT> commandTypes =
@@ -162,10 +245,26 @@ private:
 
 private:
     const float m_TimestampPeriodMs;
+    const uint32_t m_MaxDepth;
+    uint32_t m_Depth;
+
+    // Optional caller-provided buffer for all subregions.
+    uint8_t* const m_pBuffer;
+    const size_t m_BufferSize;
+    size_t m_BufferOffset;
+
+    // Base address assumed by the measurement helpers.
+    uintptr_t m_MeasureBase;
 
 public:
-    RegionBuilder( float timestampPeriod )
+    RegionBuilder( float timestampPeriod, uint32_t maxDepth = UINT32_MAX, void* pBuffer = nullptr, size_t bufferSize = 0 )
         : m_TimestampPeriodMs( timestampPeriod / 1000000.f )
+        , m_MaxDepth( maxDepth )
+        , m_Depth( 0 )
+        , m_pBuffer( static_cast<uint8_t*>( pBuffer ) )
+        , m_BufferSize( bufferSize )
+        , m_BufferOffset( 0 )
+        , m_MeasureBase( 0 )
     {
     }
 
@@ -228,7 +327,7 @@ public:
         case DeviceProfilerSubpassDataType::ePipeline:
             return SerializePipeline( std::get<DeviceProfilerPipelineData>( data ), out );
         case DeviceProfilerSubpassDataType::eCommandBuffer:
-            return SerializeCommandBuffer( std::get<DeviceProfilerCommandBufferData>( data ), out );
+            return SerializeCommandBuffer( std::get<DeviceProfilerCommandBufferDataPtr>( data ), out );
         default:
             assert( !"Invalid subpass contents" );
             return VK_ERROR_UNKNOWN;
@@ -256,7 +355,7 @@ public:
         out.properties.renderPass.handle = data.m_Handle;
 
         VkProfilerRenderPassDataEXT* pRenderPassData = nullptr;
-        VkResult result = safe_alloc<VkProfilerRenderPassDataEXT>( 1, &pRenderPassData );
+        VkResult result = Allocate<VkProfilerRenderPassDataEXT>( 1, &pRenderPassData );
 
         if( result == VK_SUCCESS )
         {
@@ -274,8 +373,9 @@ public:
     }
 
     // VkCommandBuffer serialization helper
-    inline VkResult SerializeCommandBuffer( const DeviceProfilerCommandBufferData& data, VkProfilerRegionDataEXT& out )
+    inline VkResult SerializeCommandBuffer( const DeviceProfilerCommandBufferDataPtr& pData, VkProfilerRegionDataEXT& out )
     {
+        const DeviceProfilerCommandBufferData& data = *pData;
         out.sType = VK_STRUCTURE_TYPE_PROFILER_REGION_DATA_EXT;
         out.pNext = nullptr;
         out.regionType = VK_PROFILER_REGION_TYPE_COMMAND_BUFFER_EXT;
@@ -315,6 +415,79 @@ public:
         out.duration = data.m_Ticks * m_TimestampPeriodMs;
         return SerializeSubregions( data.m_Submits, &RegionBuilder::SerializeSubmit, out );
     }
+
+    // Measurement helpers for serialization into the caller-provided buffer.
+    // The regions must be visited in the same order as in the serialization helpers.
+    inline void MeasureDrawcall( const DeviceProfilerDrawcall& )
+    {
+    }
+
+    inline void MeasurePipeline( const DeviceProfilerPipelineData& data )
+    {
+        MeasureSubregions( data.m_Drawcalls, &RegionBuilder::MeasureDrawcall );
+    }
+
+    inline void MeasureSubpassContents( const DeviceProfilerSubpassData::Data& data )
+    {
+        switch( data.GetType() )
+        {
+        case DeviceProfilerSubpassDataType::ePipeline:
+            return MeasurePipeline( std::get<DeviceProfilerPipelineData>( data ) );
+        case DeviceProfilerSubpassDataType::eCommandBuffer:
+            return MeasureCommandBuffer( std::get<DeviceProfilerCommandBufferDataPtr>( data ) );
+        default:
+            assert( !"Invalid subpass contents" );
+        }
+    }
+
+    inline void MeasureSubpass( const DeviceProfilerSubpassData& data )
+    {
+        MeasureSubregions( data.m_Data, &RegionBuilder::MeasureSubpassContents );
+    }
+
+    inline void MeasureRenderPass( const DeviceProfilerRenderPassData& data )
+    {
+        Reserve<VkProfilerRenderPassDataEXT>( 1 );
+        MeasureSubregions( data.m_Subpasses, &RegionBuilder::MeasureSubpass );
+    }
+
+    inline void MeasureCommandBuffer( const DeviceProfilerCommandBufferDataPtr& pData )
+    {
+        MeasureSubregions( pData->m_RenderPasses, &RegionBuilder::MeasureRenderPass );
+    }
+
+    inline void MeasureSubmitInfo( const DeviceProfilerSubmitData& data )
+    {
+        MeasureSubregions( data.m_CommandBuffers, &RegionBuilder::MeasureCommandBuffer );
+    }
+
+    inline void MeasureSubmit( const DeviceProfilerSubmitBatchData& data )
+    {
+        MeasureSubregions( data.m_Submits, &RegionBuilder::MeasureSubmitInfo );
+    }
+
+    // Returns size of the buffer required to serialize the frame's subregions
+    // into the caller-provided buffer at its actual address.
+    inline size_t GetRequiredBufferSize( const DeviceProfilerFrameData& data )
+    {
+        m_BufferOffset = 0;
+        m_MeasureBase = reinterpret_cast<uintptr_t>( m_pBuffer );
+        MeasureSubregions( data.m_Submits, &RegionBuilder::MeasureSubmit );
+        return std::exchange( m_BufferOffset, 0 );
+    }
+
+    // Returns size of the buffer required to serialize the frame's subregions
+    // into a buffer at any address. Measures the layout for a suitably aligned
+    // base address and adds the worst-case padding in front of the first region.
+    // Once the first region is aligned, the rest of the layout matches the aligned case.
+    inline size_t GetMaxRequiredBufferSize( const DeviceProfilerFrameData& data )
+    {
+        m_BufferOffset = 0;
+        m_MeasureBase = 0;
+        MeasureSubregions( data.m_Submits, &RegionBuilder::MeasureSubmit );
+        const size_t size = std::exchange( m_BufferOffset, 0 );
+        return (size > 0) ? (size + MaxAlignment - 1) : 0;
+    }
 };
 
 /***************************************************************************************\
@@ -438,6 +611,74 @@ VKAPI_ATTR void VKAPI_CALL vkFreeProfilerFrameDataEXT(
 
 /***************************************************************************************\
 
+Function:
+    vkGetProfilerFrameDataBufferEXT
+
+Description:
+    Fill provided structure with data collected during the previous frame.
+    All subregions are stored in the caller-provided buffer, so the data must not
+    be freed with vkFreeProfilerFrameDataEXT.
+    If pBuffer is null, the required size of the buffer is returned in pBufferSize.
+    The returned size includes the padding required to align the regions in a buffer
+    placed at any address. On success, the number of bytes used is returned instead.
+    Regions deeper than maxDepth (the frame being at depth 0) are not serialized.
+    Result values:
+     VK_SUCCESS - function succeeded
+     VK_INCOMPLETE - the buffer is too small to hold the latest frame's data,
+       the required size (for any buffer address) is returned in pBufferSize
+     VK_NOT_READY - function called before first call to vkQueuePresentKHR
+       or no profiling data available
+
+\***************************************************************************************/
+VKAPI_ATTR VkResult VKAPI_CALL vkGetProfilerFrameDataBufferEXT(
+    VkDevice device,
+    uint32_t maxDepth,
+    VkProfilerDataEXT* pData,
+    size_t* pBufferSize,
+    void* pBuffer )
+{
+    auto& dd = VkDevice_Functions::DeviceDispatch.Get( device );
+
+    // Get latest data from profiler
+    std::shared_ptr<DeviceProfilerFrameData> data = dd.Profiler.GetData();
+
+    if( data->m_Submits.empty() )
+    {
+        // Data not ready yet
+        //  Check if application called vkQueuePresentKHR or vkFlushProfilerEXT
+        return VK_NOT_READY;
+    }
+
+    RegionBuilder builder(
+        dd.Device.pPhysicalDevice->Properties.limits.timestampPeriod,
+        maxDepth,
+        pBuffer,
+        pBuffer ? *pBufferSize : 0 );
+
+    if( !pBuffer )
+    {
+        // Query the required buffer size, including the padding needed for any buffer address
+        *pBufferSize = builder.GetMaxRequiredBufferSize( *data );
+        return VK_SUCCESS;
+    }
+
+    const size_t requiredBufferSize = builder.GetRequiredBufferSize( *data );
+
+    if( *pBufferSize < requiredBufferSize )
+    {
+        // The latest frame may be bigger than the one measured in the previous call
+        *pBufferSize = builder.GetMaxRequiredBufferSize( *data );
+        return VK_INCOMPLETE;
+    }
+
+    *pBufferSize = requiredBufferSize;
+
+    // Serialize last frame
+    return builder.SerializeFrame( *data, pData->frame );
+}
+
+/***************************************************************************************\
+
 Function:
     vkFlushProfilerEXT
 
@@ -827,3 +1068,70 @@ VKAPI_ATTR void VKAPI_CALL vkGetProfilerActivePerformanceMetricsSetIndexEXT(
 {
     (*pIndex) = VkDevice_Functions::DeviceDispatch.Get( device ).ProfilerFrontend.GetPerformanceMetricsSetIndex();
 }
+
+/***************************************************************************************\
+
+Function:
+    vkTriggerProfilerTraceCaptureEXT
+
+Description:
+    Write frames kept in the trace output ring buffer to the trace file.
+    Returns VK_ERROR_FEATURE_NOT_PRESENT if the trace output is not used.
+
+\***************************************************************************************/
+VKAPI_ATTR VkResult VKAPI_CALL vkTriggerProfilerTraceCaptureEXT(
+    VkDevice device )
+{
+    auto& dd = VkDevice_Functions::DeviceDispatch.Get( device );
+
+    auto pTraceOutput = dynamic_cast<ProfilerTraceOutput*>( dd.pOutput.get() );
+    if( pTraceOutput && pTraceOutput->IsAvailable() )
+    {
+        pTraceOutput->TriggerCapture();
+        return VK_SUCCESS;
+    }
+
+    return VK_ERROR_FEATURE_NOT_PRESENT;
+}
+
+/***************************************************************************************\
+
+Function:
+    vkGetProfilerOverheadEXT
+
+Description:
+    Returns CPU time and memory used by the profiler, collected with the most recent
+    frame. CPU times are in nanoseconds, memory sizes are in bytes.
+    CPU times are 0 if the overhead accounting is disabled.
+
+\***************************************************************************************/
+VKAPI_ATTR VkResult VKAPI_CALL vkGetProfilerOverheadEXT(
+    VkDevice device,
+    VkProfilerOverheadPropertiesEXT* pProperties )
+{
+    auto& dd = VkDevice_Functions::DeviceDispatch.Get( device );
+
+    if( !pProperties ||
+        ( pProperties->sType != VK_STRUCTURE_TYPE_PROFILER_OVERHEAD_PROPERTIES_EXT ) )
+    {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    const DeviceProfilerOverheadData overhead = dd.Profiler.GetOverheadData();
+    pProperties->measurementTime = overhead.m_CpuMeasurementTime;
+    pProperties->commandRecordingTime = overhead.GetCpuTime( DeviceProfilerCpuOverheadCategory::eCommandRecording );
+    pProperties->queueSubmissionTime = overhead.GetCpuTime( DeviceProfilerCpuOverheadCategory::eQueueSubmission );
+    pProperties->dataResolveTime = overhead.GetCpuTime( DeviceProfilerCpuOverheadCategory::eDataResolve );
+    pProperties->outputTime = overhead.GetCpuTime( DeviceProfilerCpuOverheadCategory::eOutput );
+    pProperties->frameDataHostMemorySize = overhead.GetHostMemory( DeviceProfilerHostMemoryOverheadCategory::eFrameData );
+    pProperties->memorySnapshotsHostMemorySize = overhead.GetHostMemory( DeviceProfilerHostMemoryOverheadCategory::eMemorySnapshots );
+    pProperties->shaderBytecodeHostMemorySize = overhead.GetHostMemory( DeviceProfilerHostMemoryOverheadCategory::eShaderBytecode );
+    pProperties->pipelineCreateInfosHostMemorySize = overhead.GetHostMemory( DeviceProfilerHostMemoryOverheadCategory::ePipelineCreateInfos );
+    pProperties->queryPoolsDeviceMemorySize = overhead.GetGpuMemory( DeviceProfilerGpuMemoryOverheadCategory::eQueryPools );
+    pProperties->queryDataBuffersDeviceMemorySize = overhead.GetGpuMemory( DeviceProfilerGpuMemoryOverheadCategory::eQueryDataBuffers );
+    pProperties->indirectArgumentsDeviceMemorySize = overhead.GetGpuMemory( DeviceProfilerGpuMemoryOverheadCategory::eIndirectArguments );
+    pProperties->copiedFrameDataSize = overhead.m_CopiedDataSize;
+    pProperties->degradationFlags = overhead.m_Degradations;
+
+    return VK_SUCCESS;
+}
@@ -27,7 +27,7 @@ extern "C" {
 
 #ifndef VK_EXT_profiler
 #define VK_EXT_profiler 1
-#define VK_EXT_PROFILER_SPEC_VERSION 6
+#define VK_EXT_PROFILER_SPEC_VERSION 9
 #define VK_EXT_PROFILER_EXTENSION_NAME "VK_EXT_profiler"
 
 #define VK_STRUCTURE_TYPE_PROFILER_CREATE_INFO_EXT ((VkStructureType)1000999000)
@@ -39,6 +39,7 @@ extern "C" {
 #define VK_STRUCTURE_TYPE_PROFILER_CUSTOM_PERFORMANCE_METRICS_SET_CREATE_INFO_EXT ((VkStructureType)1000999006)
 #define VK_STRUCTURE_TYPE_PROFILER_CUSTOM_PERFORMANCE_METRICS_SET_UPDATE_INFO_EXT ((VkStructureType)1000999007)
 #define VK_STRUCTURE_TYPE_PROFILER_PERFORMANCE_COUNTERS_CREATE_INFO_EXT ((VkStructureType)1000999008)
+#define VK_STRUCTURE_TYPE_PROFILER_OVERHEAD_PROPERTIES_EXT ((VkStructureType)1000999009)
 
 typedef enum VkProfilerCreateFlagBitsEXT
 {
@@ -178,6 +179,15 @@ typedef enum VkProfilerPerformanceCountersSamplingModeEXT
     VK_PROFILER_PERFORMANCE_COUNTERS_SAMPLING_MODE_MAX_ENUM_EXT = 0x7FFFFFFF
 } VkProfilerPerformanceCountersSamplingModeEXT;
 
+typedef enum VkProfilerOverheadDegradationFlagBitsEXT
+{
+    VK_PROFILER_OVERHEAD_DEGRADATION_DATA_BUFFER_SIZE_REDUCED_BIT_EXT = 1,
+    VK_PROFILER_OVERHEAD_DEGRADATION_INDIRECT_ARGUMENTS_DISABLED_BIT_EXT = 2,
+    VK_PROFILER_OVERHEAD_DEGRADATION_SAMPLING_MODE_COARSENED_BIT_EXT = 4,
+    VK_PROFILER_OVERHEAD_DEGRADATION_FLAG_BITS_MAX_ENUM_EXT = 0x7FFFFFFF
+} VkProfilerOverheadDegradationFlagBitsEXT;
+typedef VkFlags VkProfilerOverheadDegradationFlagsEXT;
+
 typedef struct VkProfilerCreateInfoEXT
 {
     VkStructureType sType;
@@ -339,12 +349,33 @@ typedef struct VkProfilerCustomPerformanceMetricsSetUpdateInfoEXT
     const char* pDescription;
 } VkProfilerCustomPerformanceMetricsSetUpdateInfoEXT;
 
+typedef struct VkProfilerOverheadPropertiesEXT
+{
+    VkStructureType sType;
+    void* pNext;
+    uint64_t measurementTime;
+    uint64_t commandRecordingTime;
+    uint64_t queueSubmissionTime;
+    uint64_t dataResolveTime;
+    uint64_t outputTime;
+    uint64_t frameDataHostMemorySize;
+    uint64_t memorySnapshotsHostMemorySize;
+    uint64_t shaderBytecodeHostMemorySize;
+    uint64_t pipelineCreateInfosHostMemorySize;
+    uint64_t queryPoolsDeviceMemorySize;
+    uint64_t queryDataBuffersDeviceMemorySize;
+    uint64_t indirectArgumentsDeviceMemorySize;
+    uint64_t copiedFrameDataSize;
+    VkProfilerOverheadDegradationFlagsEXT degradationFlags;
+} VkProfilerOverheadPropertiesEXT;
+
 typedef VkResult( VKAPI_PTR* PFN_vkSetProfilerSamplingModeEXT )(VkDevice, VkProfilerModeEXT);
 typedef void( VKAPI_PTR* PFN_vkGetProfilerSamplingModeEXT )(VkDevice, VkProfilerModeEXT*);
 typedef VkResult( VKAPI_PTR* PFN_vkSetProfilerFrameDelimiterEXT )(VkDevice, VkProfilerFrameDelimiterEXT);
 typedef void( VKAPI_PTR* PFN_vkGetProfilerFrameDelimiterEXT )(VkDevice, VkProfilerFrameDelimiterEXT*);
 typedef VkResult( VKAPI_PTR* PFN_vkGetProfilerFrameDataEXT )(VkDevice, VkProfilerDataEXT*);
 typedef void( VKAPI_PTR* PFN_vkFreeProfilerFrameDataEXT )(VkDevice, VkProfilerDataEXT*);
+typedef VkResult( VKAPI_PTR* PFN_vkGetProfilerFrameDataBufferEXT )(VkDevice, uint32_t, VkProfilerDataEXT*, size_t*, void*);
 typedef VkResult( VKAPI_PTR* PFN_vkFlushProfilerEXT )(VkDevice);
 typedef void( VKAPI_PTR* PFN_vkGetProfilerCustomPerfomanceMetricsSetsSupportEXT )( VkDevice, VkBool32* );
 typedef VkResult( VKAPI_PTR* PFN_vkCreateProfilerCustomPerformanceMetricsSetEXT )( VkDevice, const VkProfilerCustomPerformanceMetricsSetCreateInfoEXT*, const VkAllocationCallbacks*, uint32_t* );
@@ -358,6 +389,8 @@ typedef VkResult( VKAPI_PTR* PFN_vkEnumerateProfilerPerformanceMetricsSetsEXT )(
 typedef VkResult( VKAPI_PTR* PFN_vkEnumerateProfilerPerformanceCounterPropertiesEXT )(VkDevice, uint32_t, uint32_t*, VkProfilerPerformanceCounterPropertiesEXT*);
 typedef VkResult( VKAPI_PTR* PFN_vkSetProfilerPerformanceMetricsSetEXT )(VkDevice, uint32_t);
 typedef void( VKAPI_PTR* PFN_vkGetProfilerActivePerformanceMetricsSetIndexEXT )(VkDevice, uint32_t*);
+typedef VkResult( VKAPI_PTR* PFN_vkTriggerProfilerTraceCaptureEXT )(VkDevice);
+typedef VkResult( VKAPI_PTR* PFN_vkGetProfilerOverheadEXT )(VkDevice, VkProfilerOverheadPropertiesEXT*);
 
 #ifndef VK_NO_PROTOTYPES
 VKAPI_ATTR VkResult VKAPI_CALL vkSetProfilerSamplingModeEXT(
@@ -384,6 +417,13 @@ VKAPI_ATTR void VKAPI_CALL vkFreeProfilerFrameDataEXT(
     VkDevice device,
     VkProfilerDataEXT* pData );
 
+VKAPI_ATTR VkResult VKAPI_CALL vkGetProfilerFrameDataBufferEXT(
+    VkDevice device,
+    uint32_t maxDepth,
+    VkProfilerDataEXT* pData,
+    size_t* pBufferSize,
+    void* pBuffer );
+
 VKAPI_ATTR VkResult VKAPI_CALL vkFlushProfilerEXT(
     VkDevice device );
 
@@ -447,6 +487,13 @@ VKAPI_ATTR VkResult VKAPI_CALL vkSetProfilerPerformanceMetricsSetEXT(
 VKAPI_ATTR void VKAPI_CALL vkGetProfilerActivePerformanceMetricsSetIndexEXT(
     VkDevice device,
     uint32_t* pMetricsSetIndex );
+
+VKAPI_ATTR VkResult VKAPI_CALL vkTriggerProfilerTraceCaptureEXT(
+    VkDevice device );
+
+VKAPI_ATTR VkResult VKAPI_CALL vkGetProfilerOverheadEXT(
+    VkDevice device,
+    VkProfilerOverheadPropertiesEXT* pProperties );
 #endif // VK_NO_PROTOTYPES
 #endif // VK_EXT_profiler
 
@@ -120,13 +120,13 @@ namespace Profiler
         Open CSV file for writing.
 
     \***********************************************************************************/
-    bool DeviceProfilerCsvSerializer::Open( const std::string& filename )
+    bool DeviceProfilerCsvSerializer::Open( const std::string& filename, DeviceProfilerFileCompression compression )
     {
         try
         {
-            m_File.open( filename, std::ios::out | std::ios::trunc );
+            m_File.Open( filename, std::ios::trunc, compression );
             m_IsFirstHeaderRow = true;
-            return m_File.is_open();
+            return m_File.IsOpen();
         }
         catch( ... )
         {
@@ -145,11 +145,11 @@ namespace Profiler
     \***********************************************************************************/
     void DeviceProfilerCsvSerializer::Close()
     {
-        if( m_File.is_open() )
+        if( m_File.IsOpen() )
         {
             try
             {
-                m_File.close();
+                m_File.Close();
             }
             catch( ... )
             {
@@ -275,7 +275,37 @@ namespace Profiler
             m_File << sep( i ) << values[i];
         }
 
-        m_File << std::endl;
+        // Don't flush the file after each row, large exports are written in batches.
+        m_File << '\n';
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        Flush
+
+    Description:
+        Write buffered rows to the file.
+
+    \***********************************************************************************/
+    void DeviceProfilerCsvSerializer::Flush()
+    {
+        m_File.flush();
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        GetFileSize
+
+    Description:
+        Get number of bytes written to the file.
+
+    \***********************************************************************************/
+    uint64_t DeviceProfilerCsvSerializer::GetFileSize()
+    {
+        const std::streamoff size = m_File.tellp();
+        return ( size > 0 ) ? static_cast<uint64_t>( size ) : 0;
     }
 
     /***********************************************************************************\
@@ -313,15 +343,16 @@ namespace Profiler
         Open
 
     Description:
-        Open CSV file for reading.
+        Open CSV file for reading. Compressed files are decompressed
+        transparently.
 
     \***********************************************************************************/
     bool DeviceProfilerCsvDeserializer::Open( const std::string& filename )
     {
         try
         {
-            m_File.open( filename, std::ios::in );
-            return m_File.is_open();
+            m_File.Open( filename, std::ios::in );
+            return m_File.IsOpen();
         }
         catch( ... )
         {
@@ -340,11 +371,11 @@ namespace Profiler
     \***********************************************************************************/
     void DeviceProfilerCsvDeserializer::Close()
     {
-        if( m_File.is_open() )
+        if( m_File.IsOpen() )
         {
             try
             {
-                m_File.close();
+                m_File.Close();
             }
             catch( ... )
             {
@@ -19,6 +19,7 @@
 // SOFTWARE.
 
 #pragma once
+#include "profiler_file_stream.h"
 #include <stdint.h>
 #include <fstream>
 #include <string>
@@ -44,7 +45,7 @@ namespace Profiler
         DeviceProfilerCsvSerializer();
         ~DeviceProfilerCsvSerializer();
 
-        bool Open( const std::string& filename );
+        bool Open( const std::string& filename, DeviceProfilerFileCompression compression = DeviceProfilerFileCompression::eNone );
         void Close();
 
         void WriteHeader( uint32_t count, const VkProfilerPerformanceCounterProperties2EXT* pProperties );
@@ -53,8 +54,11 @@ namespace Profiler
         void WriteHeader( const std::vector<std::string>& names );
         void WriteRow( const std::vector<std::string>& values );
 
+        void Flush();
+        uint64_t GetFileSize();
+
     private:
-        std::ofstream m_File;
+        DeviceProfilerOutputFileStream m_File;
         std::vector<VkProfilerPerformanceCounterProperties2EXT> m_Properties;
         bool m_IsFirstHeaderRow;
     };
@@ -81,7 +85,7 @@ namespace Profiler
         std::vector<VkProfilerPerformanceCounterResultEXT> ReadRow();
 
     private:
-        std::ifstream m_File;
+        DeviceProfilerInputFileStream m_File;
         std::vector<VkProfilerPerformanceCounterProperties2EXT> m_Properties;
     };
 }
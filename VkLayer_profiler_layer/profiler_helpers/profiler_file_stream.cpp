@@ -0,0 +1,738 @@
+// Copyright (c) 2026 Lukasz Stalmirski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "profiler_file_stream.h"
+
+#include <string.h>
+#include <vector>
+
+#if PROFILER_ENABLE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace Profiler
+{
+    // Header of the zstd frames (ZSTD_MAGICNUMBER in little-endian byte order).
+    static constexpr char g_ZstdMagicNumber[] = { '\x28', '\xB5', '\x2F', '\xFD' };
+
+#if PROFILER_ENABLE_ZSTD
+    /*************************************************************************\
+
+    Class:
+        DeviceProfilerZstdOutputBuffer
+
+    Description:
+        Stream buffer compressing the data before writing it to the
+        underlying buffer.
+
+    \*************************************************************************/
+    class DeviceProfilerZstdOutputBuffer : public std::streambuf
+    {
+    public:
+        DeviceProfilerZstdOutputBuffer( std::streambuf* pOutput );
+        ~DeviceProfilerZstdOutputBuffer();
+
+        bool Initialize( uint32_t threadCount );
+        bool Finish();
+
+    protected:
+        int_type overflow( int_type ch ) override;
+        int sync() override;
+        pos_type seekoff( off_type off, std::ios::seekdir dir, std::ios::openmode which ) override;
+
+    private:
+        std::streambuf* m_pOutput;
+        ZSTD_CCtx* m_pContext;
+
+        std::vector<char> m_InputBuffer;
+        std::vector<char> m_OutputBuffer;
+        uint64_t m_CompressedSize;
+
+        bool Compress( ZSTD_EndDirective directive );
+    };
+
+    /*************************************************************************\
+
+    Class:
+        DeviceProfilerZstdInputBuffer
+
+    Description:
+        Stream buffer decompressing the data read from the underlying buffer.
+
+    \*************************************************************************/
+    class DeviceProfilerZstdInputBuffer : public std::streambuf
+    {
+    public:
+        DeviceProfilerZstdInputBuffer( std::streambuf* pInput );
+        ~DeviceProfilerZstdInputBuffer();
+
+        bool Initialize();
+
+    protected:
+        int_type underflow() override;
+
+    private:
+        std::streambuf* m_pInput;
+        ZSTD_DCtx* m_pContext;
+
+        std::vector<char> m_InputBuffer;
+        size_t m_InputOffset;
+        size_t m_InputSize;
+
+        std::vector<char> m_OutputBuffer;
+        bool m_OutputPending;
+    };
+
+    /*************************************************************************\
+
+    Function:
+        DeviceProfilerZstdOutputBuffer
+
+    Description:
+        Constructor.
+
+    \*************************************************************************/
+    DeviceProfilerZstdOutputBuffer::DeviceProfilerZstdOutputBuffer( std::streambuf* pOutput )
+        : m_pOutput( pOutput )
+        , m_pContext( nullptr )
+        , m_InputBuffer()
+        , m_OutputBuffer()
+        , m_CompressedSize( 0 )
+    {
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ~DeviceProfilerZstdOutputBuffer
+
+    Description:
+        Destructor.
+
+    \*************************************************************************/
+    DeviceProfilerZstdOutputBuffer::~DeviceProfilerZstdOutputBuffer()
+    {
+        ZSTD_freeCCtx( m_pContext );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Initialize
+
+    Description:
+        Creates the compression context.
+
+        The data is compressed by the given number of zstd worker threads.
+        If the library has been built without multithreading support, the
+        data is compressed on the thread writing to the stream.
+
+    \*************************************************************************/
+    bool DeviceProfilerZstdOutputBuffer::Initialize( uint32_t threadCount )
+    {
+        m_pContext = ZSTD_createCCtx();
+        if( m_pContext == nullptr )
+        {
+            return false;
+        }
+
+        if( threadCount > 0 )
+        {
+            ZSTD_CCtx_setParameter( m_pContext, ZSTD_c_nbWorkers, static_cast<int>( threadCount ) );
+        }
+
+        m_InputBuffer.resize( ZSTD_CStreamInSize() );
+        m_OutputBuffer.resize( ZSTD_CStreamOutSize() );
+
+        setp( m_InputBuffer.data(), m_InputBuffer.data() + m_InputBuffer.size() );
+        return true;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Finish
+
+    Description:
+        Compresses the remaining data and ends the frame.
+
+    \*************************************************************************/
+    bool DeviceProfilerZstdOutputBuffer::Finish()
+    {
+        return Compress( ZSTD_e_end ) && ( m_pOutput->pubsync() != -1 );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        overflow
+
+    Description:
+        Compresses the buffered data when the buffer is full.
+
+    \*************************************************************************/
+    DeviceProfilerZstdOutputBuffer::int_type DeviceProfilerZstdOutputBuffer::overflow( int_type ch )
+    {
+        if( !Compress( ZSTD_e_continue ) )
+        {
+            return traits_type::eof();
+        }
+
+        if( !traits_type::eq_int_type( ch, traits_type::eof() ) )
+        {
+            *pptr() = traits_type::to_char_type( ch );
+            pbump( 1 );
+        }
+
+        return traits_type::not_eof( ch );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        sync
+
+    Description:
+        Compresses the buffered data and writes all pending blocks to the
+        underlying buffer.
+
+    \*************************************************************************/
+    int DeviceProfilerZstdOutputBuffer::sync()
+    {
+        return ( Compress( ZSTD_e_flush ) && ( m_pOutput->pubsync() != -1 ) ) ? 0 : -1;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        seekoff
+
+    Description:
+        Only querying the current position is supported. Returns number of
+        the compressed bytes written to the underlying buffer.
+
+    \*************************************************************************/
+    DeviceProfilerZstdOutputBuffer::pos_type DeviceProfilerZstdOutputBuffer::seekoff( off_type off, std::ios::seekdir dir, std::ios::openmode which )
+    {
+        if( ( off == 0 ) && ( dir == std::ios::cur ) && ( which & std::ios::out ) )
+        {
+            return pos_type( static_cast<off_type>( m_CompressedSize ) );
+        }
+
+        return pos_type( off_type( -1 ) );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Compress
+
+    Description:
+        Compresses the buffered data and writes the output to the underlying
+        buffer.
+
+    \*************************************************************************/
+    bool DeviceProfilerZstdOutputBuffer::Compress( ZSTD_EndDirective directive )
+    {
+        ZSTD_inBuffer input = { pbase(), static_cast<size_t>( pptr() - pbase() ), 0 };
+
+        bool finished = false;
+        while( !finished )
+        {
+            ZSTD_outBuffer output = { m_OutputBuffer.data(), m_OutputBuffer.size(), 0 };
+
+            const size_t remaining = ZSTD_compressStream2( m_pContext, &output, &input, directive );
+            if( ZSTD_isError( remaining ) )
+            {
+                return false;
+            }
+
+            if( output.pos > 0 )
+            {
+                const std::streamsize size = static_cast<std::streamsize>( output.pos );
+                if( m_pOutput->sputn( m_OutputBuffer.data(), size ) != size )
+                {
+                    return false;
+                }
+
+                m_CompressedSize += output.pos;
+            }
+
+            // Workers may not consume all input at once.
+            // Flush and end directives must also wait until the internal buffers are written.
+            finished = ( directive == ZSTD_e_continue )
+                ? ( input.pos == input.size )
+                : ( remaining == 0 );
+        }
+
+        setp( m_InputBuffer.data(), m_InputBuffer.data() + m_InputBuffer.size() );
+        return true;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        DeviceProfilerZstdInputBuffer
+
+    Description:
+        Constructor.
+
+    \*************************************************************************/
+    DeviceProfilerZstdInputBuffer::DeviceProfilerZstdInputBuffer( std::streambuf* pInput )
+        : m_pInput( pInput )
+        , m_pContext( nullptr )
+        , m_InputBuffer()
+        , m_InputOffset( 0 )
+        , m_InputSize( 0 )
+        , m_OutputBuffer()
+        , m_OutputPending( false )
+    {
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ~DeviceProfilerZstdInputBuffer
+
+    Description:
+        Destructor.
+
+    \*************************************************************************/
+    DeviceProfilerZstdInputBuffer::~DeviceProfilerZstdInputBuffer()
+    {
+        ZSTD_freeDCtx( m_pContext );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Initialize
+
+    Description:
+        Creates the decompression context.
+
+    \*************************************************************************/
+    bool DeviceProfilerZstdInputBuffer::Initialize()
+    {
+        m_pContext = ZSTD_createDCtx();
+        if( m_pContext == nullptr )
+        {
+            return false;
+        }
+
+        m_InputBuffer.resize( ZSTD_DStreamInSize() );
+        m_OutputBuffer.resize( ZSTD_DStreamOutSize() );
+        return true;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        underflow
+
+    Description:
+        Decompresses the next block of data when the buffer is empty.
+        Consecutive frames are decompressed as a single stream.
+
+    \*************************************************************************/
+    DeviceProfilerZstdInputBuffer::int_type DeviceProfilerZstdInputBuffer::underflow()
+    {
+        if( gptr() < egptr() )
+        {
+            return traits_type::to_int_type( *gptr() );
+        }
+
+        while( true )
+        {
+            // Read more data only when the decompressor has flushed all output of the current input.
+            if( ( m_InputOffset == m_InputSize ) && !m_OutputPending )
+            {
+                const std::streamsize size = m_pInput->sgetn(
+                    m_InputBuffer.data(),
+                    static_cast<std::streamsize>( m_InputBuffer.size() ) );
+
+                if( size <= 0 )
+                {
+                    return traits_type::eof();
+                }
+
+                m_InputOffset = 0;
+                m_InputSize = static_cast<size_t>( size );
+            }
+
+            ZSTD_inBuffer input = { m_InputBuffer.data(), m_InputSize, m_InputOffset };
+            ZSTD_outBuffer output = { m_OutputBuffer.data(), m_OutputBuffer.size(), 0 };
+
+            const size_t result = ZSTD_decompressStream( m_pContext, &output, &input );
+            if( ZSTD_isError( result ) )
+            {
+                return traits_type::eof();
+            }
+
+            m_InputOffset = input.pos;
+            m_OutputPending = ( output.pos == output.size );
+
+            if( output.pos > 0 )
+            {
+                setg( m_OutputBuffer.data(), m_OutputBuffer.data(), m_OutputBuffer.data() + output.pos );
+                return traits_type::to_int_type( *gptr() );
+            }
+        }
+    }
+#endif // PROFILER_ENABLE_ZSTD
+
+    /*************************************************************************\
+
+    Function:
+        DeviceProfilerOutputFileStream
+
+    Description:
+        Constructor.
+
+    \*************************************************************************/
+    DeviceProfilerOutputFileStream::DeviceProfilerOutputFileStream()
+        : std::ostream( nullptr )
+        , m_FileBuffer()
+        , m_pCompressionBuffer()
+    {
+        rdbuf( &m_FileBuffer );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ~DeviceProfilerOutputFileStream
+
+    Description:
+        Destructor.
+
+    \*************************************************************************/
+    DeviceProfilerOutputFileStream::~DeviceProfilerOutputFileStream()
+    {
+        Close();
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Open
+
+    Description:
+        Opens the file for writing. Compressed files are always opened in
+        binary mode.
+
+    \*************************************************************************/
+    bool DeviceProfilerOutputFileStream::Open(
+        const std::filesystem::path& filename,
+        std::ios::openmode mode,
+        DeviceProfilerFileCompression compression,
+        [[maybe_unused]] uint32_t threadCount )
+    {
+        Close();
+
+        // Resets the state of the stream.
+        rdbuf( &m_FileBuffer );
+
+        if( compression != DeviceProfilerFileCompression::eNone )
+        {
+            mode |= std::ios::binary;
+        }
+
+        if( !IsCompressionSupported( compression ) ||
+            !m_FileBuffer.open( filename, mode | std::ios::out ) )
+        {
+            setstate( std::ios::failbit );
+            return false;
+        }
+
+#if PROFILER_ENABLE_ZSTD
+        if( compression == DeviceProfilerFileCompression::eZstd )
+        {
+            auto pCompressionBuffer = std::make_unique<DeviceProfilerZstdOutputBuffer>( &m_FileBuffer );
+            if( !pCompressionBuffer->Initialize( threadCount ) )
+            {
+                m_FileBuffer.close();
+                setstate( std::ios::failbit );
+                return false;
+            }
+
+            m_pCompressionBuffer = std::move( pCompressionBuffer );
+            rdbuf( m_pCompressionBuffer.get() );
+        }
+#endif
+
+        return true;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Close
+
+    Description:
+        Ends the compressed frame and closes the file. Errors that occurred
+        before closing the file are preserved in the state of the stream.
+
+    \*************************************************************************/
+    bool DeviceProfilerOutputFileStream::Close()
+    {
+        const std::ios::iostate state = rdstate();
+        bool result = true;
+
+#if PROFILER_ENABLE_ZSTD
+        if( m_pCompressionBuffer )
+        {
+            result &= static_cast<DeviceProfilerZstdOutputBuffer*>( m_pCompressionBuffer.get() )->Finish();
+        }
+#endif
+
+        rdbuf( &m_FileBuffer );
+        setstate( state );
+
+        m_pCompressionBuffer.reset();
+
+        if( m_FileBuffer.is_open() )
+        {
+            result &= ( m_FileBuffer.close() != nullptr );
+        }
+
+        if( !result )
+        {
+            setstate( std::ios::failbit );
+        }
+
+        return result;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        IsOpen
+
+    Description:
+        Checks whether the file is open.
+
+    \*************************************************************************/
+    bool DeviceProfilerOutputFileStream::IsOpen() const
+    {
+        return m_FileBuffer.is_open();
+    }
+
+    /*************************************************************************\
+
+    Function:
+        IsCompressed
+
+    Description:
+        Checks whether the data written to the file is compressed.
+
+    \*************************************************************************/
+    bool DeviceProfilerOutputFileStream::IsCompressed() const
+    {
+        return m_pCompressionBuffer != nullptr;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        IsCompressionSupported
+
+    Description:
+        Checks whether the compression is available in the current build.
+
+    \*************************************************************************/
+    bool DeviceProfilerOutputFileStream::IsCompressionSupported( DeviceProfilerFileCompression compression )
+    {
+        switch( compression )
+        {
+        case DeviceProfilerFileCompression::eNone:
+            return true;
+
+#if PROFILER_ENABLE_ZSTD
+        case DeviceProfilerFileCompression::eZstd:
+            return true;
+#endif
+
+        default:
+            return false;
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetCompressionFromFileName
+
+    Description:
+        Selects the compression based on the extension of the file.
+
+    \*************************************************************************/
+    DeviceProfilerFileCompression DeviceProfilerOutputFileStream::GetCompressionFromFileName( const std::filesystem::path& filename )
+    {
+        if( filename.extension() == ".zst" )
+        {
+            return DeviceProfilerFileCompression::eZstd;
+        }
+
+        return DeviceProfilerFileCompression::eNone;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        DeviceProfilerInputFileStream
+
+    Description:
+        Constructor.
+
+    \*************************************************************************/
+    DeviceProfilerInputFileStream::DeviceProfilerInputFileStream()
+        : std::istream( nullptr )
+        , m_FileBuffer()
+        , m_pDecompressionBuffer()
+    {
+        rdbuf( &m_FileBuffer );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ~DeviceProfilerInputFileStream
+
+    Description:
+        Destructor.
+
+    \*************************************************************************/
+    DeviceProfilerInputFileStream::~DeviceProfilerInputFileStream()
+    {
+        Close();
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Open
+
+    Description:
+        Opens the file for reading. Compressed files are detected by the
+        header of the first frame.
+
+    \*************************************************************************/
+    bool DeviceProfilerInputFileStream::Open( const std::filesystem::path& filename, std::ios::openmode mode )
+    {
+        Close();
+
+        if( !m_FileBuffer.open( filename, std::ios::in | std::ios::binary ) )
+        {
+            setstate( std::ios::failbit );
+            return false;
+        }
+
+        char header[ sizeof( g_ZstdMagicNumber ) ] = {};
+        const bool compressed =
+            ( m_FileBuffer.sgetn( header, sizeof( header ) ) == sizeof( header ) ) &&
+            ( memcmp( header, g_ZstdMagicNumber, sizeof( header ) ) == 0 );
+
+        if( !compressed )
+        {
+            // Reopen the file in the requested mode.
+            m_FileBuffer.close();
+
+            if( !m_FileBuffer.open( filename, mode | std::ios::in ) )
+            {
+                setstate( std::ios::failbit );
+                return false;
+            }
+
+            return true;
+        }
+
+#if PROFILER_ENABLE_ZSTD
+        m_FileBuffer.pubseekpos( 0, std::ios::in );
+
+        auto pDecompressionBuffer = std::make_unique<DeviceProfilerZstdInputBuffer>( &m_FileBuffer );
+        if( !pDecompressionBuffer->Initialize() )
+        {
+            m_FileBuffer.close();
+            setstate( std::ios::failbit );
+            return false;
+        }
+
+        m_pDecompressionBuffer = std::move( pDecompressionBuffer );
+        rdbuf( m_pDecompressionBuffer.get() );
+        return true;
+#else
+        // Compressed files cannot be read without zstd.
+        m_FileBuffer.close();
+        setstate( std::ios::failbit );
+        return false;
+#endif
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Close
+
+    Description:
+        Closes the file.
+
+    \*************************************************************************/
+    void DeviceProfilerInputFileStream::Close()
+    {
+        // Resets the state of the stream.
+        rdbuf( &m_FileBuffer );
+
+        m_pDecompressionBuffer.reset();
+
+        if( m_FileBuffer.is_open() )
+        {
+            m_FileBuffer.close();
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        IsOpen
+
+    Description:
+        Checks whether the file is open.
+
+    \*************************************************************************/
+    bool DeviceProfilerInputFileStream::IsOpen() const
+    {
+        return m_FileBuffer.is_open();
+    }
+
+    /*************************************************************************\
+
+    Function:
+        IsCompressed
+
+    Description:
+        Checks whether the data read from the file is decompressed.
+
+    \*************************************************************************/
+    bool DeviceProfilerInputFileStream::IsCompressed() const
+    {
+        return m_pDecompressionBuffer != nullptr;
+    }
+}
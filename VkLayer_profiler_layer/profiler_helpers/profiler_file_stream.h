@@ -0,0 +1,111 @@
+// Copyright (c) 2026 Lukasz Stalmirski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <stdint.h>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <ostream>
+
+namespace Profiler
+{
+    /*************************************************************************\
+
+    Enumeration:
+        DeviceProfilerFileCompression
+
+    Description:
+        Compression of the data written to the output files.
+
+    \*************************************************************************/
+    enum class DeviceProfilerFileCompression
+    {
+        eNone,
+        eZstd
+    };
+
+    /*************************************************************************\
+
+    Class:
+        DeviceProfilerOutputFileStream
+
+    Description:
+        Output stream writing to a file, optionally compressing the data.
+
+        Compressed data is written in zstd frames. Flushing the stream ends
+        the current block, so the data written before the flush can be
+        decompressed even if the file is not closed properly. The compressed
+        stream cannot be repositioned.
+
+    \*************************************************************************/
+    class DeviceProfilerOutputFileStream : public std::ostream
+    {
+    public:
+        DeviceProfilerOutputFileStream();
+        ~DeviceProfilerOutputFileStream();
+
+        bool Open(
+            const std::filesystem::path& filename,
+            std::ios::openmode mode,
+            DeviceProfilerFileCompression compression = DeviceProfilerFileCompression::eNone,
+            uint32_t threadCount = 0 );
+
+        bool Close();
+
+        bool IsOpen() const;
+        bool IsCompressed() const;
+
+        static bool IsCompressionSupported( DeviceProfilerFileCompression compression );
+        static DeviceProfilerFileCompression GetCompressionFromFileName( const std::filesystem::path& filename );
+
+    private:
+        std::filebuf m_FileBuffer;
+        std::unique_ptr<std::streambuf> m_pCompressionBuffer;
+    };
+
+    /*************************************************************************\
+
+    Class:
+        DeviceProfilerInputFileStream
+
+    Description:
+        Input stream reading from a file. Compressed files are detected by
+        the header of the file and decompressed transparently.
+
+    \*************************************************************************/
+    class DeviceProfilerInputFileStream : public std::istream
+    {
+    public:
+        DeviceProfilerInputFileStream();
+        ~DeviceProfilerInputFileStream();
+
+        bool Open( const std::filesystem::path& filename, std::ios::openmode mode );
+        void Close();
+
+        bool IsOpen() const;
+        bool IsCompressed() const;
+
+    private:
+        std::filebuf m_FileBuffer;
+        std::unique_ptr<std::streambuf> m_pDecompressionBuffer;
+    };
+}
@@ -197,7 +197,7 @@ namespace Profiler
         }
 
         m_pData->m_DocumentStream = std::move( iterateResult.value_unsafe() );
-        m_pData->m_DocumentStreamIterator = m_pData->m_DocumentStream->begin();
+        m_pData->m_DocumentStreamIterator = std::nullopt;
 
         return true;
     }
@@ -218,7 +218,7 @@ namespace Profiler
             m_pData->m_Document = std::nullopt;
 
             m_pData->m_DocumentStream = std::nullopt;
-            m_pData->m_DocumentStreamIterator = simdjson::ondemand::document_stream::iterator();
+            m_pData->m_DocumentStreamIterator = std::nullopt;
 
             m_pData->m_DataBuffer = simdjson::padded_string();
         }
@@ -248,7 +248,8 @@ namespace Profiler
 
         if( m_pData->m_DocumentStream.has_value() )
         {
-            m_pData->m_DocumentStreamIterator = m_pData->m_DocumentStream->begin();
+            // The iterator is started by the next GetParsedDocument call.
+            m_pData->m_DocumentStreamIterator = std::nullopt;
             return;
         }
     }
@@ -19,6 +19,7 @@
 // SOFTWARE.
 
 #include "profiler_memory_comparator.h"
+#include "profiler_memory_history.h"
 
 namespace Profiler
 {
@@ -202,73 +203,77 @@ namespace Profiler
             diff.m_CountDifference = cmpHeap.m_AllocationCount - refHeap.m_AllocationCount;
         }
 
+        // Frames between the snapshots share the snapshot, so their state is rebuilt from the changes.
+        m_pReferenceSnapshot = DeviceProfilerMemoryHistory::GetFrameSnapshot( m_pReferenceData->m_Memory );
+        m_pComparisonSnapshot = DeviceProfilerMemoryHistory::GetFrameSnapshot( m_pComparisonData->m_Memory );
+
         // Find differences between the reference and comparison data.
-        for( const auto& [buffer, data] : m_pReferenceData->m_Memory.m_Buffers )
+        for( const auto& [buffer, data] : m_pReferenceSnapshot->m_Buffers )
         {
-            if( !m_pComparisonData->m_Memory.m_Buffers.count( buffer ) )
+            if( !m_pComparisonSnapshot->m_Buffers.count( buffer ) )
             {
                 // Buffer was freed in the comparison data.
                 m_Results.m_FreedBuffers.emplace( buffer, &data );
             }
         }
 
-        for( const auto& [buffer, data] : m_pComparisonData->m_Memory.m_Buffers )
+        for( const auto& [buffer, data] : m_pComparisonSnapshot->m_Buffers )
         {
-            if( !m_pReferenceData->m_Memory.m_Buffers.count( buffer ) )
+            if( !m_pReferenceSnapshot->m_Buffers.count( buffer ) )
             {
                 // Buffer was allocated in the comparison data.
                 m_Results.m_AllocatedBuffers.emplace( buffer, &data );
             }
         }
 
-        for( const auto& [image, data] : m_pReferenceData->m_Memory.m_Images )
+        for( const auto& [image, data] : m_pReferenceSnapshot->m_Images )
         {
-            if( !m_pComparisonData->m_Memory.m_Images.count( image ) )
+            if( !m_pComparisonSnapshot->m_Images.count( image ) )
             {
                 // Image was freed in the comparison data.
                 m_Results.m_FreedImages.emplace( image, &data );
             }
         }
 
-        for( const auto& [image, data] : m_pComparisonData->m_Memory.m_Images )
+        for( const auto& [image, data] : m_pComparisonSnapshot->m_Images )
         {
-            if( !m_pReferenceData->m_Memory.m_Images.count( image ) )
+            if( !m_pReferenceSnapshot->m_Images.count( image ) )
             {
                 // Image was allocated in the comparison data.
                 m_Results.m_AllocatedImages.emplace( image, &data );
             }
         }
 
-        for( const auto& [accelerationStructure, data] : m_pReferenceData->m_Memory.m_AccelerationStructures )
+        for( const auto& [accelerationStructure, data] : m_pReferenceSnapshot->m_AccelerationStructures )
         {
-            if( !m_pComparisonData->m_Memory.m_AccelerationStructures.count( accelerationStructure ) )
+            if( !m_pComparisonSnapshot->m_AccelerationStructures.count( accelerationStructure ) )
             {
                 // Acceleration structure was freed in the comparison data.
                 m_Results.m_FreedAccelerationStructures.emplace( accelerationStructure, &data );
             }
         }
 
-        for( const auto& [accelerationStructure, data] : m_pComparisonData->m_Memory.m_AccelerationStructures )
+        for( const auto& [accelerationStructure, data] : m_pComparisonSnapshot->m_AccelerationStructures )
         {
-            if( !m_pReferenceData->m_Memory.m_AccelerationStructures.count( accelerationStructure ) )
+            if( !m_pReferenceSnapshot->m_AccelerationStructures.count( accelerationStructure ) )
             {
                 // Acceleration structure was allocated in the comparison data.
                 m_Results.m_AllocatedAccelerationStructures.emplace( accelerationStructure, &data );
             }
         }
 
-        for( const auto& [micromap, data] : m_pReferenceData->m_Memory.m_Micromaps )
+        for( const auto& [micromap, data] : m_pReferenceSnapshot->m_Micromaps )
         {
-            if( !m_pComparisonData->m_Memory.m_Micromaps.count( micromap ) )
+            if( !m_pComparisonSnapshot->m_Micromaps.count( micromap ) )
             {
                 // Micromap was freed in the comparison data.
                 m_Results.m_FreedMicromaps.emplace( micromap, &data );
             }
         }
 
-        for( const auto& [micromap, data] : m_pComparisonData->m_Memory.m_Micromaps )
+        for( const auto& [micromap, data] : m_pComparisonSnapshot->m_Micromaps )
         {
-            if( !m_pReferenceData->m_Memory.m_Micromaps.count( micromap ) )
+            if( !m_pReferenceSnapshot->m_Micromaps.count( micromap ) )
             {
                 // Micromap was allocated in the comparison data.
                 m_Results.m_AllocatedMicromaps.emplace( micromap, &data );
@@ -300,5 +305,9 @@ namespace Profiler
 
         m_Results.m_AllocatedMicromaps.clear();
         m_Results.m_FreedMicromaps.clear();
+
+        // Results point to the data in the snapshots.
+        m_pReferenceSnapshot = nullptr;
+        m_pComparisonSnapshot = nullptr;
     }
 }
@@ -87,6 +87,10 @@ namespace Profiler
         std::shared_ptr<DeviceProfilerFrameData> m_pReferenceData;
         std::shared_ptr<DeviceProfilerFrameData> m_pComparisonData;
 
+        // Allocations and resources at the end of the compared frames.
+        std::shared_ptr<const DeviceProfilerMemorySnapshotData> m_pReferenceSnapshot;
+        std::shared_ptr<const DeviceProfilerMemorySnapshotData> m_pComparisonSnapshot;
+
         // Comparison results.
         DeviceProfilerMemoryComparisonResults m_Results;
 
@@ -0,0 +1,539 @@
+// Copyright (c) 2025 Lukasz Stalmirski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "profiler_memory_history.h"
+#include <algorithm>
+
+namespace Profiler
+{
+    /***********************************************************************************\
+
+    Function:
+        Initialize
+
+    Description:
+        Initializes the state from the memory snapshot.
+        Uses the same sizes of the bound ranges as the memory tracker uses for the
+        bind and unbind events, so the events can be applied to the state.
+
+    \***********************************************************************************/
+    void DeviceProfilerMemoryHistoryState::Initialize( const DeviceProfilerMemorySnapshotData& snapshot )
+    {
+        m_Allocations = snapshot.m_Allocations;
+        m_Ranges.clear();
+
+        for( const auto& [buffer, bufferData] : snapshot.m_Buffers )
+        {
+            const size_t bindingCount = bufferData.GetMemoryBindingCount();
+            const DeviceProfilerBufferMemoryBindingData* pBindings = bufferData.GetMemoryBindings();
+
+            for( size_t i = 0; i < bindingCount; ++i )
+            {
+                if( m_Allocations.count( pBindings[i].m_Memory ) )
+                {
+                    DeviceProfilerMemoryRangeData& range = m_Ranges[pBindings[i].m_Memory].emplace_back();
+                    range.m_Offset = pBindings[i].m_MemoryOffset;
+                    range.m_Size = std::holds_alternative<DeviceProfilerBufferMemoryBindingData>( bufferData.m_MemoryBindings )
+                        ? bufferData.m_MemoryRequirements.size
+                        : pBindings[i].m_Size;
+                    range.m_Resource = buffer;
+                }
+            }
+        }
+
+        for( const auto& [image, imageData] : snapshot.m_Images )
+        {
+            const size_t bindingCount = imageData.GetMemoryBindingCount();
+            const DeviceProfilerImageMemoryBindingData* pBindings = imageData.GetMemoryBindings();
+
+            for( size_t i = 0; i < bindingCount; ++i )
+            {
+                // Block bindings of sparse images are not logged.
+                if( ( pBindings[i].m_Type == DeviceProfilerImageMemoryBindingType::eOpaque ) &&
+                    m_Allocations.count( pBindings[i].m_Opaque.m_Memory ) )
+                {
+                    DeviceProfilerMemoryRangeData& range = m_Ranges[pBindings[i].m_Opaque.m_Memory].emplace_back();
+                    range.m_Offset = pBindings[i].m_Opaque.m_MemoryOffset;
+                    range.m_Size = pBindings[i].m_Opaque.m_Size;
+                    range.m_Resource = image;
+                }
+            }
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        ApplyEvent
+
+    Description:
+        Updates the state with the memory event.
+
+    \***********************************************************************************/
+    void DeviceProfilerMemoryHistoryState::ApplyEvent( const DeviceProfilerMemoryEventData& event )
+    {
+        switch( event.m_Type )
+        {
+        case DeviceProfilerMemoryEventType::eAllocate:
+        {
+            DeviceProfilerDeviceMemoryData& allocation = m_Allocations[event.m_Memory];
+            allocation.m_Size = event.m_Size;
+            allocation.m_TypeIndex = event.m_TypeIndex;
+            allocation.m_HeapIndex = event.m_HeapIndex;
+            break;
+        }
+
+        case DeviceProfilerMemoryEventType::eFree:
+        {
+            // Resources still bound to the memory no longer occupy it.
+            m_Allocations.erase( event.m_Memory );
+            m_Ranges.erase( event.m_Memory );
+            break;
+        }
+
+        case DeviceProfilerMemoryEventType::eBind:
+        {
+            if( m_Allocations.count( event.m_Memory ) )
+            {
+                DeviceProfilerMemoryRangeData& range = m_Ranges[event.m_Memory].emplace_back();
+                range.m_Offset = event.m_MemoryOffset;
+                range.m_Size = event.m_Size;
+                range.m_Resource = event.m_Resource;
+            }
+            break;
+        }
+
+        case DeviceProfilerMemoryEventType::eUnbind:
+        {
+            auto it = m_Ranges.find( event.m_Memory );
+            if( it == m_Ranges.end() )
+            {
+                break;
+            }
+
+            // Remove the unbound range from the ranges occupied by the resource.
+            std::vector<DeviceProfilerMemoryRangeData>& ranges = it->second;
+            const VkDeviceSize startUnbindOffset = event.m_MemoryOffset;
+            const VkDeviceSize endUnbindOffset = event.m_MemoryOffset + event.m_Size;
+
+            for( size_t i = 0; i < ranges.size(); )
+            {
+                DeviceProfilerMemoryRangeData& range = ranges[i];
+                const VkDeviceSize startRangeOffset = range.m_Offset;
+                const VkDeviceSize endRangeOffset = range.m_Offset + range.m_Size;
+
+                if( ( range.m_Resource != event.m_Resource ) ||
+                    ( startUnbindOffset >= endRangeOffset ) ||
+                    ( endUnbindOffset <= startRangeOffset ) )
+                {
+                    // Range not affected by the event.
+                    ++i;
+                }
+                else if( ( startUnbindOffset <= startRangeOffset ) && ( endUnbindOffset >= endRangeOffset ) )
+                {
+                    // Range entirely covered by the unbound range, remove it.
+                    ranges.erase( ranges.begin() + i );
+                }
+                else if( ( startUnbindOffset > startRangeOffset ) && ( endUnbindOffset < endRangeOffset ) )
+                {
+                    // Range partially-unbound in the middle.
+                    DeviceProfilerMemoryRangeData newRange = range;
+                    newRange.m_Offset = endUnbindOffset;
+                    newRange.m_Size = endRangeOffset - endUnbindOffset;
+                    range.m_Size = startUnbindOffset - startRangeOffset;
+                    ranges.push_back( newRange );
+                    ++i;
+                }
+                else if( startUnbindOffset <= startRangeOffset )
+                {
+                    // Range partially-unbound at the beginning.
+                    range.m_Offset = endUnbindOffset;
+                    range.m_Size = endRangeOffset - endUnbindOffset;
+                    ++i;
+                }
+                else
+                {
+                    // Range partially-unbound at the end.
+                    range.m_Size = startUnbindOffset - startRangeOffset;
+                    ++i;
+                }
+            }
+
+            if( ranges.empty() )
+            {
+                m_Ranges.erase( it );
+            }
+            break;
+        }
+
+        default:
+            // Resource events don't change the occupied memory ranges.
+            break;
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        GetFragmentation
+
+    Description:
+        Computes occupancy of the memory allocation.
+        Aliased ranges are counted once.
+
+    \***********************************************************************************/
+    DeviceProfilerMemoryFragmentationData DeviceProfilerMemoryHistoryState::GetFragmentation( VkDeviceMemoryHandle memory ) const
+    {
+        DeviceProfilerMemoryFragmentationData fragmentation;
+
+        auto allocation = m_Allocations.find( memory );
+        if( allocation == m_Allocations.end() )
+        {
+            return fragmentation;
+        }
+
+        const VkDeviceSize allocationSize = allocation->second.m_Size;
+
+        std::vector<DeviceProfilerMemoryRangeData> ranges;
+        auto it = m_Ranges.find( memory );
+        if( it != m_Ranges.end() )
+        {
+            ranges = it->second;
+        }
+
+        std::sort( ranges.begin(), ranges.end(),
+            []( const DeviceProfilerMemoryRangeData& a, const DeviceProfilerMemoryRangeData& b )
+            {
+                return a.m_Offset < b.m_Offset;
+            } );
+
+        auto AddFreeBlock = [&]( VkDeviceSize size )
+            {
+                fragmentation.m_FreeSize += size;
+                fragmentation.m_FreeBlockCount++;
+                fragmentation.m_LargestFreeBlockSize = std::max( fragmentation.m_LargestFreeBlockSize, size );
+            };
+
+        VkDeviceSize offset = 0;
+        for( const DeviceProfilerMemoryRangeData& range : ranges )
+        {
+            const VkDeviceSize startOffset = std::min( range.m_Offset, allocationSize );
+            const VkDeviceSize endOffset = std::min( range.m_Offset + range.m_Size, allocationSize );
+
+            if( startOffset > offset )
+            {
+                AddFreeBlock( startOffset - offset );
+            }
+
+            if( endOffset > offset )
+            {
+                fragmentation.m_BoundSize += endOffset - std::max( startOffset, offset );
+                offset = endOffset;
+            }
+        }
+
+        if( allocationSize > offset )
+        {
+            AddFreeBlock( allocationSize - offset );
+        }
+
+        if( fragmentation.m_FreeSize > 0 )
+        {
+            fragmentation.m_Fragmentation = 1.f -
+                static_cast<float>( fragmentation.m_LargestFreeBlockSize ) /
+                static_cast<float>( fragmentation.m_FreeSize );
+        }
+
+        return fragmentation;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        DeviceProfilerMemoryHistory
+
+    Description:
+        Constructor.
+
+    \***********************************************************************************/
+    DeviceProfilerMemoryHistory::DeviceProfilerMemoryHistory()
+        : m_Empty( true )
+        , m_MaxEventCount( 262144 )
+        , m_EventCount( 0 )
+        , m_BaseState()
+        , m_BaseFrameIndex( 0 )
+        , m_Frames()
+        , m_CachedState()
+        , m_CachedFrameIndex( 0 )
+        , m_CachedStateValid( false )
+    {
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        Reset
+
+    Description:
+        Removes all frames from the history.
+
+    \***********************************************************************************/
+    void DeviceProfilerMemoryHistory::Reset()
+    {
+        m_Empty = true;
+        m_EventCount = 0;
+        m_BaseState = {};
+        m_BaseFrameIndex = 0;
+        m_Frames.clear();
+        m_CachedState = {};
+        m_CachedStateValid = false;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        SetMaxEventCount
+
+    Description:
+        Sets the number of events kept in the history.
+        Events of the oldest frames are applied to the snapshot when the limit is exceeded.
+
+    \***********************************************************************************/
+    void DeviceProfilerMemoryHistory::SetMaxEventCount( size_t maxEventCount )
+    {
+        m_MaxEventCount = maxEventCount;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        AppendFrame
+
+    Description:
+        Adds the memory events of the next frame to the history.
+
+        The history is restarted from the state of the frame if any frame was skipped
+        or the events were dropped, because the events of such frame cannot be
+        applied to the previous state.
+
+    \***********************************************************************************/
+    void DeviceProfilerMemoryHistory::AppendFrame( uint32_t frameIndex, const DeviceProfilerMemoryData& data )
+    {
+        if( m_Empty || ( data.m_DroppedEventCount > 0 ) || ( frameIndex != GetLastFrameIndex() + 1 ) )
+        {
+            m_Empty = false;
+            m_EventCount = 0;
+            m_BaseState.Initialize( *GetFrameSnapshot( data ) );
+            m_BaseFrameIndex = frameIndex;
+            m_Frames.clear();
+            m_CachedStateValid = false;
+            return;
+        }
+
+        Frame& frame = m_Frames.emplace_back();
+        frame.m_FrameIndex = frameIndex;
+        frame.m_Events = data.m_Events;
+        m_EventCount += frame.m_Events.size();
+
+        // Move the snapshot forward to keep the number of events within the limit.
+        while( ( m_EventCount > m_MaxEventCount ) && !m_Frames.empty() )
+        {
+            const Frame& oldestFrame = m_Frames.front();
+            for( const DeviceProfilerMemoryEventData& event : oldestFrame.m_Events )
+            {
+                m_BaseState.ApplyEvent( event );
+            }
+
+            m_BaseFrameIndex = oldestFrame.m_FrameIndex;
+            m_EventCount -= oldestFrame.m_Events.size();
+            m_Frames.pop_front();
+        }
+
+        if( m_CachedStateValid && ( m_CachedFrameIndex < m_BaseFrameIndex ) )
+        {
+            m_CachedStateValid = false;
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        IsEmpty
+
+    Description:
+        Checks if any frame has been added to the history.
+
+    \***********************************************************************************/
+    bool DeviceProfilerMemoryHistory::IsEmpty() const
+    {
+        return m_Empty;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        GetFirstFrameIndex
+
+    Description:
+        Returns index of the oldest frame in the history.
+
+    \***********************************************************************************/
+    uint32_t DeviceProfilerMemoryHistory::GetFirstFrameIndex() const
+    {
+        return m_BaseFrameIndex;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        GetLastFrameIndex
+
+    Description:
+        Returns index of the newest frame in the history.
+
+    \***********************************************************************************/
+    uint32_t DeviceProfilerMemoryHistory::GetLastFrameIndex() const
+    {
+        return m_Frames.empty() ? m_BaseFrameIndex : m_Frames.back().m_FrameIndex;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        GetState
+
+    Description:
+        Reconstructs the state of the memory at the end of the frame.
+        Returns nullptr if the frame is not in the history.
+
+        The returned pointer is valid until the next call to any non-const method.
+
+    \***********************************************************************************/
+    const DeviceProfilerMemoryHistoryState* DeviceProfilerMemoryHistory::GetState( uint32_t frameIndex )
+    {
+        if( m_Empty || ( frameIndex < m_BaseFrameIndex ) || ( frameIndex > GetLastFrameIndex() ) )
+        {
+            return nullptr;
+        }
+
+        if( frameIndex == m_BaseFrameIndex )
+        {
+            return &m_BaseState;
+        }
+
+        if( !m_CachedStateValid || ( m_CachedFrameIndex > frameIndex ) )
+        {
+            // Replay the events from the snapshot.
+            m_CachedState = m_BaseState;
+            m_CachedFrameIndex = m_BaseFrameIndex;
+            m_CachedStateValid = true;
+        }
+
+        // Frames in the history are consecutive.
+        while( m_CachedFrameIndex < frameIndex )
+        {
+            const Frame& frame = m_Frames[m_CachedFrameIndex - m_BaseFrameIndex];
+            for( const DeviceProfilerMemoryEventData& event : frame.m_Events )
+            {
+                m_CachedState.ApplyEvent( event );
+            }
+
+            m_CachedFrameIndex++;
+        }
+
+        return &m_CachedState;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        GetFrameSnapshot
+
+    Description:
+        Returns the allocations and resources at the end of the frame.
+
+        Frames between the snapshots share the snapshot, so the changes made since it
+        was captured are applied to its copy, starting from the oldest frame.
+
+    \***********************************************************************************/
+    std::shared_ptr<const DeviceProfilerMemorySnapshotData> DeviceProfilerMemoryHistory::GetFrameSnapshot( const DeviceProfilerMemoryData& data )
+    {
+        if( !data.m_pChanges )
+        {
+            return data.m_pSnapshot;
+        }
+
+        // Changes are linked from the newest frame.
+        std::vector<const DeviceProfilerMemorySnapshotChangesData*> changes;
+        for( const DeviceProfilerMemorySnapshotChangesData* pChanges = data.m_pChanges.get();
+             pChanges != nullptr;
+             pChanges = pChanges->m_pPrevious.get() )
+        {
+            changes.push_back( pChanges );
+        }
+
+        auto pSnapshot = std::make_shared<DeviceProfilerMemorySnapshotData>( *data.m_pSnapshot );
+
+        auto ApplyUpdates = []( auto& dst, const auto& src )
+            {
+                for( const auto& [handle, objectData] : src )
+                {
+                    dst.insert_or_assign( handle, objectData );
+                }
+            };
+
+        for( auto it = changes.rbegin(); it != changes.rend(); ++it )
+        {
+            const DeviceProfilerMemorySnapshotChangesData& frameChanges = **it;
+
+            for( const VkObject& object : frameChanges.m_Removed )
+            {
+                switch( object.m_Type )
+                {
+                case VK_OBJECT_TYPE_DEVICE_MEMORY:
+                    pSnapshot->m_Allocations.erase( VkDeviceMemoryHandle( object ) );
+                    break;
+                case VK_OBJECT_TYPE_BUFFER:
+                    pSnapshot->m_Buffers.erase( VkBufferHandle( object ) );
+                    break;
+                case VK_OBJECT_TYPE_IMAGE:
+                    pSnapshot->m_Images.erase( VkImageHandle( object ) );
+                    break;
+                case VK_OBJECT_TYPE_ACCELERATION_STRUCTURE_KHR:
+                    pSnapshot->m_AccelerationStructures.erase( VkAccelerationStructureKHRHandle( object ) );
+                    break;
+                case VK_OBJECT_TYPE_MICROMAP_EXT:
+                    pSnapshot->m_Micromaps.erase( VkMicromapEXTHandle( object ) );
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            ApplyUpdates( pSnapshot->m_Allocations, frameChanges.m_Updated.m_Allocations );
+            ApplyUpdates( pSnapshot->m_Buffers, frameChanges.m_Updated.m_Buffers );
+            ApplyUpdates( pSnapshot->m_Images, frameChanges.m_Updated.m_Images );
+            ApplyUpdates( pSnapshot->m_AccelerationStructures, frameChanges.m_Updated.m_AccelerationStructures );
+            ApplyUpdates( pSnapshot->m_Micromaps, frameChanges.m_Updated.m_Micromaps );
+        }
+
+        return pSnapshot;
+    }
+}
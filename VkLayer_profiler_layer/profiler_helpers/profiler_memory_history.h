@@ -0,0 +1,141 @@
+// Copyright (c) 2025 Lukasz Stalmirski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include "profiler/profiler_data.h"
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Profiler
+{
+    /***********************************************************************************\
+
+    Structure:
+        DeviceProfilerMemoryRangeData
+
+    Description:
+        Range of the device memory occupied by a resource.
+
+    \***********************************************************************************/
+    struct DeviceProfilerMemoryRangeData
+    {
+        VkDeviceSize m_Offset = {};
+        VkDeviceSize m_Size = {};
+        VkObject m_Resource = {};
+    };
+
+    /***********************************************************************************\
+
+    Structure:
+        DeviceProfilerMemoryFragmentationData
+
+    Description:
+        Occupancy of a device memory allocation.
+
+        Fragmentation is 0 if all free space is available in a single block, and
+        approaches 1 as the free space gets split into many small blocks.
+
+    \***********************************************************************************/
+    struct DeviceProfilerMemoryFragmentationData
+    {
+        VkDeviceSize m_BoundSize = {};
+        VkDeviceSize m_FreeSize = {};
+        VkDeviceSize m_LargestFreeBlockSize = {};
+        uint64_t m_FreeBlockCount = {};
+        float m_Fragmentation = {};
+    };
+
+    /***********************************************************************************\
+
+    Structure:
+        DeviceProfilerMemoryHistoryState
+
+    Description:
+        Allocations and bound memory ranges at the end of a frame.
+
+    \***********************************************************************************/
+    struct DeviceProfilerMemoryHistoryState
+    {
+        std::unordered_map<VkDeviceMemoryHandle, DeviceProfilerDeviceMemoryData> m_Allocations;
+        std::unordered_map<VkDeviceMemoryHandle, std::vector<DeviceProfilerMemoryRangeData>> m_Ranges;
+
+        void Initialize( const DeviceProfilerMemorySnapshotData& snapshot );
+        void ApplyEvent( const DeviceProfilerMemoryEventData& event );
+
+        DeviceProfilerMemoryFragmentationData GetFragmentation( VkDeviceMemoryHandle memory ) const;
+    };
+
+    /***********************************************************************************\
+
+    Class:
+        DeviceProfilerMemoryHistory
+
+    Description:
+        Reconstructs the state of the device memory at the end of past frames by
+        replaying the memory events on top of the oldest kept snapshot.
+
+        Only one snapshot and the events of the following frames are kept, so the
+        history can cover many more frames than the frame data list.
+
+    \***********************************************************************************/
+    class DeviceProfilerMemoryHistory
+    {
+    public:
+        DeviceProfilerMemoryHistory();
+
+        void Reset();
+        void SetMaxEventCount( size_t maxEventCount );
+
+        void AppendFrame( uint32_t frameIndex, const DeviceProfilerMemoryData& data );
+
+        bool IsEmpty() const;
+        uint32_t GetFirstFrameIndex() const;
+        uint32_t GetLastFrameIndex() const;
+
+        const DeviceProfilerMemoryHistoryState* GetState( uint32_t frameIndex );
+
+        static std::shared_ptr<const DeviceProfilerMemorySnapshotData> GetFrameSnapshot( const DeviceProfilerMemoryData& data );
+
+    private:
+        struct Frame
+        {
+            uint32_t m_FrameIndex;
+            std::vector<DeviceProfilerMemoryEventData> m_Events;
+        };
+
+        bool m_Empty;
+        size_t m_MaxEventCount;
+        size_t m_EventCount;
+
+        // Snapshot of the oldest frame in the history.
+        DeviceProfilerMemoryHistoryState m_BaseState;
+        uint32_t m_BaseFrameIndex;
+
+        // Events of the following frames.
+        std::deque<Frame> m_Frames;
+
+        // Last reconstructed state, reused if the next requested frame is newer.
+        DeviceProfilerMemoryHistoryState m_CachedState;
+        uint32_t m_CachedFrameIndex;
+        bool m_CachedStateValid;
+    };
+}
@@ -493,6 +493,33 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Function:
+        GetName
+
+    Description:
+        Returns name of the region in which the hitch was detected.
+
+    \***********************************************************************************/
+    std::string DeviceProfilerStringSerializer::GetName( const DeviceProfilerHitchData& hitch, bool showEntryPoints ) const
+    {
+        switch( hitch.m_RegionType )
+        {
+        case DeviceProfilerHitchRegionType::ePipeline:
+            return GetName( DeviceProfilerPipelineData( hitch.m_Pipeline ), showEntryPoints );
+
+        case DeviceProfilerHitchRegionType::eRenderPass:
+            return GetName( hitch.m_RenderPass );
+
+        case DeviceProfilerHitchRegionType::eDebugLabel:
+            return hitch.m_DebugLabel;
+
+        default:
+            return std::string();
+        }
+    }
+
+    /***********************************************************************************\
+
     Function:
         GetName
 
@@ -612,15 +639,16 @@ namespace Profiler
 
     Description:
         Returns name of the Vulkan API function.
+        The returned string is static, so it can be used without copying.
 
     \***********************************************************************************/
-    std::string DeviceProfilerStringSerializer::GetCommandName( const DeviceProfilerDrawcall& drawcall ) const
+    std::string_view DeviceProfilerStringSerializer::GetCommandName( const DeviceProfilerDrawcall& drawcall ) const
     {
         switch( drawcall.m_Type )
         {
         default:
         case DeviceProfilerDrawcallType::eUnknown:
-            return fmt::format( "Unknown command ({})", static_cast<uint32_t>( drawcall.m_Type ) );
+            return "Unknown command";
 
         case DeviceProfilerDrawcallType::eInsertDebugLabel:
             return "vkCmdInsertDebugLabelEXT";
@@ -929,6 +957,32 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Function:
+        GetQueueIdleReasonName
+
+    Description:
+        Returns description of the reason of the queue being idle.
+
+    \***********************************************************************************/
+    std::string DeviceProfilerStringSerializer::GetQueueIdleReasonName( DeviceProfilerQueueIdleReason reason ) const
+    {
+        switch( reason )
+        {
+        case DeviceProfilerQueueIdleReason::eSemaphoreWait:
+            return "Waiting for semaphore";
+        case DeviceProfilerQueueIdleReason::eCpuSubmission:
+            return "Waiting for CPU submission";
+        case DeviceProfilerQueueIdleReason::eStarvation:
+            return "Starvation";
+        case DeviceProfilerQueueIdleReason::eUnknown:
+            return "Unknown";
+        default:
+            return "Idle";
+        }
+    }
+
+    /***********************************************************************************\
+
     Function:
         GetShaderName
 
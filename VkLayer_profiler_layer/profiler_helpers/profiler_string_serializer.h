@@ -21,10 +21,12 @@
 #pragma once
 #include <vulkan/vulkan.h>
 #include <string>
+#include <string_view>
 
 namespace Profiler
 {
     class DeviceProfilerFrontend;
+    enum class DeviceProfilerQueueIdleReason;
 
     /***********************************************************************************\
 
@@ -49,13 +51,14 @@ namespace Profiler
         std::string GetName( const struct DeviceProfilerRenderPassBeginData&, bool dynamic ) const;
         std::string GetName( const struct DeviceProfilerRenderPassEndData&, bool dynamic ) const;
         std::string GetName( const struct DeviceProfilerCommandBufferData& ) const;
+        std::string GetName( const struct DeviceProfilerHitchData&, bool showEntryPoints ) const;
 
         std::string GetName( const struct VkObject& object ) const;
         std::string GetObjectID( const struct VkObject& object ) const;
         std::string GetObjectTypeName( const VkObjectType objectType ) const;
         std::string GetShortObjectTypeName( const VkObjectType objectType ) const;
 
-        std::string GetCommandName( const struct DeviceProfilerDrawcall& ) const;
+        std::string_view GetCommandName( const struct DeviceProfilerDrawcall& ) const;
 
         std::string GetPointer( const void* ) const;
         std::string GetBool( VkBool32 ) const;
@@ -67,6 +70,7 @@ namespace Profiler
 
         std::string GetQueueTypeName( VkQueueFlags ) const;
         std::string GetQueueFlagNames( VkQueueFlags ) const;
+        std::string GetQueueIdleReasonName( DeviceProfilerQueueIdleReason ) const;
 
         std::string GetShaderName( const struct ProfilerShader& ) const;
         std::string GetShortShaderName( const struct ProfilerShader& ) const;
@@ -345,6 +345,57 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Function:
+        CmdBeginQuery
+
+    Description:
+
+    \***********************************************************************************/
+    VKAPI_ATTR void VKAPI_CALL VkCommandBuffer_Functions::CmdBeginQuery(
+        VkCommandBuffer commandBuffer,
+        VkQueryPool queryPool,
+        uint32_t query,
+        VkQueryControlFlags flags )
+    {
+        auto& dd = DeviceDispatch.Get( commandBuffer );
+        TipGuard tip( dd.Device.TIP, __func__ );
+
+        auto& profiledCommandBuffer = dd.Profiler.GetCommandBuffer( commandBuffer );
+
+        // Suspend profiler's queries that conflict with the application's query
+        profiledCommandBuffer.BeginQuery( dd.Profiler.GetQueryPoolType( queryPool ) );
+
+        // Begin the query
+        dd.Device.Callbacks.CmdBeginQuery( commandBuffer, queryPool, query, flags );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        CmdEndQuery
+
+    Description:
+
+    \***********************************************************************************/
+    VKAPI_ATTR void VKAPI_CALL VkCommandBuffer_Functions::CmdEndQuery(
+        VkCommandBuffer commandBuffer,
+        VkQueryPool queryPool,
+        uint32_t query )
+    {
+        auto& dd = DeviceDispatch.Get( commandBuffer );
+        TipGuard tip( dd.Device.TIP, __func__ );
+
+        auto& profiledCommandBuffer = dd.Profiler.GetCommandBuffer( commandBuffer );
+
+        // End the query
+        dd.Device.Callbacks.CmdEndQuery( commandBuffer, queryPool, query );
+
+        // Resume profiler's queries
+        profiledCommandBuffer.EndQuery( dd.Profiler.GetQueryPoolType( queryPool ) );
+    }
+
+    /***********************************************************************************\
+
     Function:
         CmdPipelineBarrier
 
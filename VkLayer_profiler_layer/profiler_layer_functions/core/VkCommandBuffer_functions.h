@@ -101,6 +101,19 @@ namespace Profiler
             uint32_t commandBufferCount,
             const VkCommandBuffer* pCommandBuffers );
 
+        // vkCmdBeginQuery
+        static VKAPI_ATTR void VKAPI_CALL CmdBeginQuery(
+            VkCommandBuffer commandBuffer,
+            VkQueryPool queryPool,
+            uint32_t query,
+            VkQueryControlFlags flags );
+
+        // vkCmdEndQuery
+        static VKAPI_ATTR void VKAPI_CALL CmdEndQuery(
+            VkCommandBuffer commandBuffer,
+            VkQueryPool queryPool,
+            uint32_t query );
+
         // vkCmdPipelineBarrier
         static VKAPI_ATTR void VKAPI_CALL CmdPipelineBarrier(
             VkCommandBuffer commandBuffer,
@@ -69,6 +69,8 @@ namespace Profiler
         GETPROCADDR( DestroyImage );
         GETPROCADDR( BindImageMemory );
         GETPROCADDR( BindImageMemory2 );
+        GETPROCADDR( CreateQueryPool );
+        GETPROCADDR( DestroyQueryPool );
 
         // VkCommandBuffer core functions
         GETPROCADDR( BeginCommandBuffer );
@@ -84,6 +86,8 @@ namespace Profiler
         GETPROCADDR( CmdEndRendering );
         GETPROCADDR( CmdBindPipeline );
         GETPROCADDR( CmdExecuteCommands );
+        GETPROCADDR( CmdBeginQuery );
+        GETPROCADDR( CmdEndQuery );
         GETPROCADDR( CmdPipelineBarrier );
         GETPROCADDR( CmdPipelineBarrier2 );
         GETPROCADDR( CmdDraw );
@@ -191,6 +195,10 @@ namespace Profiler
         GETPROCADDR( CmdDrawMultiEXT );
         GETPROCADDR( CmdDrawMultiIndexedEXT );
 
+        // VK_EXT_transform_feedback functions
+        GETPROCADDR( CmdBeginQueryIndexedEXT );
+        GETPROCADDR( CmdEndQueryIndexedEXT );
+
         // VK_EXT_opacity_micromap functions
         GETPROCADDR( CreateMicromapEXT );
         GETPROCADDR( DestroyMicromapEXT );
@@ -237,11 +245,14 @@ namespace Profiler
         GETPROCADDR_EXT( vkGetProfilerFrameDelimiterEXT );
         GETPROCADDR_EXT( vkGetProfilerFrameDataEXT );
         GETPROCADDR_EXT( vkFreeProfilerFrameDataEXT );
+        GETPROCADDR_EXT( vkGetProfilerFrameDataBufferEXT );
         GETPROCADDR_EXT( vkFlushProfilerEXT );
         GETPROCADDR_EXT( vkEnumerateProfilerPerformanceMetricsSetsEXT );
         GETPROCADDR_EXT( vkEnumerateProfilerPerformanceCounterPropertiesEXT );
         GETPROCADDR_EXT( vkSetProfilerPerformanceMetricsSetEXT );
         GETPROCADDR_EXT( vkGetProfilerActivePerformanceMetricsSetIndexEXT );
+        GETPROCADDR_EXT( vkTriggerProfilerTraceCaptureEXT );
+        GETPROCADDR_EXT( vkGetProfilerOverheadEXT );
         // VK_EXT_profiler functions aliases for backwards compatibility
         GETPROCADDR_EXT_ALIAS( "vkSetProfilerModeEXT", vkSetProfilerSamplingModeEXT );
         GETPROCADDR_EXT_ALIAS( "vkGetProfilerModeEXT", vkGetProfilerSamplingModeEXT );
@@ -358,21 +369,32 @@ namespace Profiler
         TipGuard tip( dd.Device.TIP, __func__ );
 
         // Capture executable properties for shader inspection.
-        VkGraphicsPipelineCreateInfo* pCreateInfosWithExecutableProperties = nullptr;
+        VkGraphicsPipelineCreateInfo* pModifiedCreateInfos = nullptr;
         VkPipelineExecutablePropertiesKhr_Functions::CapturePipelineExecutableProperties(
-            dd, createInfoCount, &pCreateInfos, &pCreateInfosWithExecutableProperties );
+            dd, createInfoCount, &pCreateInfos, &pModifiedCreateInfos );
+
+        // Capture creation feedback to get compilation time of each pipeline.
+        VkPipelineCreationFeedbackExt_Functions::CreationFeedback creationFeedback;
+        VkPipelineCreationFeedbackExt_Functions::CapturePipelineCreationFeedback(
+            dd, createInfoCount, &pCreateInfos, &pModifiedCreateInfos, creationFeedback );
+
+        DeviceProfilerPipelineCompilationData compilation;
+        compilation.m_ThreadId = ProfilerPlatformFunctions::GetCurrentThreadId();
+        compilation.m_BeginTimestamp = dd.Profiler.m_CpuTimestampCounter.GetCurrentValue();
 
         // Create the pipelines
         VkResult result = dd.Device.Callbacks.CreateGraphicsPipelines(
             device, pipelineCache, createInfoCount, pCreateInfos, pAllocator, pPipelines );
 
+        compilation.m_EndTimestamp = dd.Profiler.m_CpuTimestampCounter.GetCurrentValue();
+
         if( result == VK_SUCCESS )
         {
             // Register pipelines
-            dd.Profiler.CreatePipelines( createInfoCount, pCreateInfos, pPipelines );
+            dd.Profiler.CreatePipelines( createInfoCount, pCreateInfos, pPipelines, compilation );
         }
 
-        free( pCreateInfosWithExecutableProperties );
+        free( pModifiedCreateInfos );
 
         return result;
     }
@@ -397,21 +419,32 @@ namespace Profiler
         TipGuard tip( dd.Device.TIP, __func__ );
 
         // Capture executable properties for shader inspection.
-        VkComputePipelineCreateInfo* pCreateInfosWithExecutableProperties = nullptr;
+        VkComputePipelineCreateInfo* pModifiedCreateInfos = nullptr;
         VkPipelineExecutablePropertiesKhr_Functions::CapturePipelineExecutableProperties(
-            dd, createInfoCount, &pCreateInfos, &pCreateInfosWithExecutableProperties );
+            dd, createInfoCount, &pCreateInfos, &pModifiedCreateInfos );
+
+        // Capture creation feedback to get compilation time of each pipeline.
+        VkPipelineCreationFeedbackExt_Functions::CreationFeedback creationFeedback;
+        VkPipelineCreationFeedbackExt_Functions::CapturePipelineCreationFeedback(
+            dd, createInfoCount, &pCreateInfos, &pModifiedCreateInfos, creationFeedback );
+
+        DeviceProfilerPipelineCompilationData compilation;
+        compilation.m_ThreadId = ProfilerPlatformFunctions::GetCurrentThreadId();
+        compilation.m_BeginTimestamp = dd.Profiler.m_CpuTimestampCounter.GetCurrentValue();
 
         // Create the pipelines
         VkResult result = dd.Device.Callbacks.CreateComputePipelines(
             device, pipelineCache, createInfoCount, pCreateInfos, pAllocator, pPipelines );
 
+        compilation.m_EndTimestamp = dd.Profiler.m_CpuTimestampCounter.GetCurrentValue();
+
         if( result == VK_SUCCESS )
         {
             // Register pipelines
-            dd.Profiler.CreatePipelines( createInfoCount, pCreateInfos, pPipelines );
+            dd.Profiler.CreatePipelines( createInfoCount, pCreateInfos, pPipelines, compilation );
         }
 
-        free( pCreateInfosWithExecutableProperties );
+        free( pModifiedCreateInfos );
 
         return result;
     }
@@ -955,4 +988,57 @@ namespace Profiler
 
         return result;
     }
+
+    /***********************************************************************************\
+
+    Function:
+        CreateQueryPool
+
+    Description:
+
+    \***********************************************************************************/
+    VKAPI_ATTR VkResult VKAPI_CALL VkDevice_Functions::CreateQueryPool(
+        VkDevice device,
+        const VkQueryPoolCreateInfo* pCreateInfo,
+        const VkAllocationCallbacks* pAllocator,
+        VkQueryPool* pQueryPool )
+    {
+        auto& dd = DeviceDispatch.Get( device );
+        TipGuard tip( dd.Device.TIP, __func__ );
+
+        // Create the query pool
+        VkResult result = dd.Device.Callbacks.CreateQueryPool(
+            device, pCreateInfo, pAllocator, pQueryPool );
+
+        if( result == VK_SUCCESS )
+        {
+            // Register new query pool
+            dd.Profiler.CreateQueryPool( *pQueryPool, pCreateInfo );
+        }
+
+        return result;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        DestroyQueryPool
+
+    Description:
+
+    \***********************************************************************************/
+    VKAPI_ATTR void VKAPI_CALL VkDevice_Functions::DestroyQueryPool(
+        VkDevice device,
+        VkQueryPool queryPool,
+        const VkAllocationCallbacks* pAllocator )
+    {
+        auto& dd = DeviceDispatch.Get( device );
+        TipGuard tip( dd.Device.TIP, __func__ );
+
+        // Unregister the query pool
+        dd.Profiler.DestroyQueryPool( queryPool );
+
+        // Destroy the query pool
+        dd.Device.Callbacks.DestroyQueryPool( device, queryPool, pAllocator );
+    }
 }
@@ -37,12 +37,14 @@
 #include "VkMeshShaderNv_functions.h"
 #include "VkMultiDrawExt_functions.h"
 #include "VkOpacityMicromapExt_functions.h"
+#include "VkPipelineCreationFeedbackExt_functions.h"
 #include "VkPipelineExecutablePropertiesKhr_functions.h"
 #include "VkRayTracingMaintenance1Khr_functions.h"
 #include "VkRayTracingPipelineKhr_functions.h"
 #include "VkShaderObjectExt_functions.h"
 #include "VkSwapchainKhr_functions.h"
 #include "VkSynchronization2Khr_functions.h"
+#include "VkTransformFeedbackExt_functions.h"
 
 namespace Profiler
 {
@@ -80,6 +82,7 @@ namespace Profiler
         , VkShaderObjectExt_Functions
         , VkSwapchainKhr_Functions
         , VkSynchronization2Khr_Functions
+        , VkTransformFeedbackExt_Functions
     {
         // vkGetDeviceProcAddr
         static VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL GetDeviceProcAddr(
@@ -244,5 +247,18 @@ namespace Profiler
             VkDevice device,
             uint32_t bindInfoCount,
             const VkBindImageMemoryInfo* pBindInfos );
+
+        // vkCreateQueryPool
+        static VKAPI_ATTR VkResult VKAPI_CALL CreateQueryPool(
+            VkDevice device,
+            const VkQueryPoolCreateInfo* pCreateInfo,
+            const VkAllocationCallbacks* pAllocator,
+            VkQueryPool* pQueryPool );
+
+        // vkDestroyQueryPool
+        static VKAPI_ATTR void VKAPI_CALL DestroyQueryPool(
+            VkDevice device,
+            VkQueryPool queryPool,
+            const VkAllocationCallbacks* pAllocator );
     };
 }
@@ -22,6 +22,8 @@
 #include "VkInstance_functions.h"
 #include "profiler_layer_functions/Helpers.h"
 #include "profiler/profiler_helpers.h"
+#include "profiler_shared_memory/profiler_shared_memory.h"
+#include "profiler_telemetry/profiler_telemetry.h"
 #include "profiler_trace/profiler_trace.h"
 
 namespace Profiler
@@ -68,10 +70,23 @@ namespace Profiler
         }
 
         // Save enabled features
+        if( pCreateInfo->pEnabledFeatures )
+        {
+            dd.Device.EnabledFeatures.PipelineStatisticsQuery = pCreateInfo->pEnabledFeatures->pipelineStatisticsQuery;
+        }
+
         for( const auto& it : PNextIterator( pCreateInfo->pNext ) )
         {
             switch( it.sType )
             {
+            case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2:
+            {
+                const VkPhysicalDeviceFeatures2& features =
+                    reinterpret_cast<const VkPhysicalDeviceFeatures2&>( it );
+
+                dd.Device.EnabledFeatures.PipelineStatisticsQuery = features.features.pipelineStatisticsQuery;
+                break;
+            }
             case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_NESTED_COMMAND_BUFFER_FEATURES_EXT:
             {
                 const VkPhysicalDeviceNestedCommandBufferFeaturesEXT& nestedCommandBufferFeatures =
@@ -135,6 +150,36 @@ namespace Profiler
                     }
                 }
             }
+            else if( dd.Profiler.m_Config.m_Output == output_t::shared_memory )
+            {
+                result = CreateUniqueObject<ProfilerSharedMemoryOutput>(
+                    &dd.pOutput,
+                    dd.ProfilerFrontend );
+
+                if( result == VK_SUCCESS )
+                {
+                    bool success = dd.pOutput->Initialize();
+                    if( !success )
+                    {
+                        result = VK_ERROR_INITIALIZATION_FAILED;
+                    }
+                }
+            }
+            else if( dd.Profiler.m_Config.m_Output == output_t::telemetry )
+            {
+                result = CreateUniqueObject<ProfilerTelemetryOutput>(
+                    &dd.pOutput,
+                    dd.ProfilerFrontend );
+
+                if( result == VK_SUCCESS )
+                {
+                    bool success = dd.pOutput->Initialize();
+                    if( !success )
+                    {
+                        result = VK_ERROR_INITIALIZATION_FAILED;
+                    }
+                }
+            }
         }
 
         if( result != VK_SUCCESS )
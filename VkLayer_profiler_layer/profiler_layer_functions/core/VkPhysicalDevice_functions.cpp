@@ -86,6 +86,9 @@ namespace Profiler
             // Get physical device memory properties
             id.Instance.Callbacks.GetPhysicalDeviceMemoryProperties( physicalDevice, &dev.MemoryProperties );
 
+            // Get physical device features
+            id.Instance.Callbacks.GetPhysicalDeviceFeatures( physicalDevice, &dev.Features );
+
             dev.VendorID = static_cast<VkPhysicalDevice_Vendor_ID>(dev.Properties.vendorID);
         }
 
@@ -97,13 +100,22 @@ namespace Profiler
             deviceExtensions.insert( pCreateInfo->ppEnabledExtensionNames[ i ] );
         }
 
+        // Core features may be enabled by the profiler, copy the structure provided by the application
+        VkPhysicalDeviceFeatures enabledFeatures = {};
+
+        if( pCreateInfo->pEnabledFeatures )
+        {
+            enabledFeatures = *pCreateInfo->pEnabledFeatures;
+        }
+
         // Configure device extensions and pNext chain to enable profiler features
         PNextChain pNextChain( pCreateInfo->pNext );
         DeviceProfiler::SetupDeviceCreateInfo(
             dev,
             id.Instance.LayerSettings,
             deviceExtensions,
-            pNextChain );
+            pNextChain,
+            enabledFeatures );
 
         // Convert to continuous memory block
         std::vector<const char*> enabledDeviceExtensions;
@@ -120,6 +132,12 @@ namespace Profiler
         createInfo.enabledExtensionCount = static_cast<uint32_t>(enabledDeviceExtensions.size());
         createInfo.ppEnabledExtensionNames = enabledDeviceExtensions.data();
 
+        // VkPhysicalDeviceFeatures2 in the pNext chain replaces pEnabledFeatures
+        if( !pNextChain.Contains( VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2 ) )
+        {
+            createInfo.pEnabledFeatures = &enabledFeatures;
+        }
+
         // Move chain on for next layer
         pLayerLinkInfo->u.pLayerInfo = pLayerLinkInfo->u.pLayerInfo->pNext;
 
@@ -42,16 +42,18 @@ namespace Profiler
         // Synchronize host access to the queue object in case the overlay tries to use it.
         VkQueue_Object_Scope queueScope( dd.Device.Queues.at( queue ) );
 
-        dd.Profiler.PreSubmitCommandBuffers( queue );
+        const uint64_t submitTimestamp = dd.Profiler.PreSubmitCommandBuffers( queue );
 
         // Submit the command buffers
         VkResult result = dd.Device.Callbacks.QueueSubmit( queue, submitCount, pSubmits, fence );
 
-        dd.Profiler.PostSubmitCommandBuffers( queue, submitCount, pSubmits );
+        dd.Profiler.PostSubmitCommandBuffers( queue, submitCount, pSubmits, submitTimestamp );
 
         // Consume the collected data
         if( dd.pOutput )
         {
+            DeviceProfilerOverheadScope overhead( dd.Profiler.m_Overhead, DeviceProfilerCpuOverheadCategory::eOutput );
+
             dd.pOutput->Update();
         }
 
@@ -78,16 +80,18 @@ namespace Profiler
         // Synchronize host access to the queue object in case the overlay tries to use it.
         VkQueue_Object_Scope queueScope( dd.Device.Queues.at( queue ) );
 
-        dd.Profiler.PreSubmitCommandBuffers( queue );
+        const uint64_t submitTimestamp = dd.Profiler.PreSubmitCommandBuffers( queue );
 
         // Submit the command buffers
         VkResult result = dd.Device.Callbacks.QueueSubmit2( queue, submitCount, pSubmits, fence );
 
-        dd.Profiler.PostSubmitCommandBuffers( queue, submitCount, pSubmits );
+        dd.Profiler.PostSubmitCommandBuffers( queue, submitCount, pSubmits, submitTimestamp );
 
         // Consume the collected data
         if( dd.pOutput )
         {
+            DeviceProfilerOverheadScope overhead( dd.Profiler.m_Overhead, DeviceProfilerCpuOverheadCategory::eOutput );
+
             dd.pOutput->Update();
         }
 
@@ -0,0 +1,137 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include "VkDevice_functions_base.h"
+#include <vector>
+
+namespace Profiler
+{
+    struct VkPipelineCreationFeedbackExt_Functions : VkDevice_Functions_Base
+    {
+        /***********************************************************************************\
+
+        Structure:
+            CreationFeedback
+
+        Description:
+            Storage for the creation feedback structures chained by the layer.
+            It must not be moved until the pipelines are created.
+
+        \***********************************************************************************/
+        struct CreationFeedback
+        {
+            std::vector<VkPipelineCreationFeedbackCreateInfo> m_CreateInfos;
+            std::vector<VkPipelineCreationFeedback> m_Feedbacks;
+
+            CreationFeedback() = default;
+            CreationFeedback( const CreationFeedback& ) = delete;
+            CreationFeedback& operator=( const CreationFeedback& ) = delete;
+        };
+
+        /***********************************************************************************\
+
+        Function:
+            CapturePipelineCreationFeedback
+
+        Description:
+            Chain VkPipelineCreationFeedbackCreateInfo to the pipeline create infos to
+            get the compilation time and the pipeline cache hits reported by the driver.
+
+            Create infos that already have the creation feedback structure chained by
+            the application are left unchanged, the profiler reads the application's
+            feedback after the pipelines are created.
+
+            The create infos are copied to ppModifiedCreateInfos if they have not been
+            copied yet. The caller is responsible for freeing the copy.
+
+        \***********************************************************************************/
+        template<typename VkPipelineCreateInfoT>
+        static void CapturePipelineCreationFeedback(
+            Dispatch& dd,
+            uint32_t createInfoCount,
+            const VkPipelineCreateInfoT** ppCreateInfos,
+            VkPipelineCreateInfoT** ppModifiedCreateInfos,
+            CreationFeedback& creationFeedback )
+        {
+            if( !dd.Profiler.ShouldCapturePipelineCreationFeedback() )
+            {
+                return;
+            }
+
+            if( *ppModifiedCreateInfos == nullptr )
+            {
+                const size_t createInfoSize = createInfoCount * sizeof( VkPipelineCreateInfoT );
+
+                *ppModifiedCreateInfos =
+                    reinterpret_cast<VkPipelineCreateInfoT*>( malloc( createInfoSize ) );
+
+                if( *ppModifiedCreateInfos == nullptr )
+                {
+                    return;
+                }
+
+                memcpy( *ppModifiedCreateInfos, *ppCreateInfos, createInfoSize );
+                *ppCreateInfos = *ppModifiedCreateInfos;
+            }
+
+            // Reserve space for all structures up front, the pointers must remain valid.
+            size_t feedbackCount = 0;
+            for( uint32_t i = 0; i < createInfoCount; ++i )
+            {
+                feedbackCount += 1 + GetShaderStageCount( ( *ppModifiedCreateInfos )[ i ] );
+            }
+
+            creationFeedback.m_CreateInfos.resize( createInfoCount );
+            creationFeedback.m_Feedbacks.resize( feedbackCount );
+
+            VkPipelineCreationFeedback* pFeedbacks = creationFeedback.m_Feedbacks.data();
+
+            for( uint32_t i = 0; i < createInfoCount; ++i )
+            {
+                VkPipelineCreateInfoT& createInfo = ( *ppModifiedCreateInfos )[ i ];
+
+                const PNextChain pNextChain( createInfo.pNext );
+                if( pNextChain.Contains( VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO ) )
+                {
+                    continue;
+                }
+
+                const uint32_t stageCount = GetShaderStageCount( createInfo );
+
+                VkPipelineCreationFeedbackCreateInfo& feedbackCreateInfo = creationFeedback.m_CreateInfos[ i ];
+                feedbackCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO;
+                feedbackCreateInfo.pNext = createInfo.pNext;
+                feedbackCreateInfo.pPipelineCreationFeedback = pFeedbacks;
+                feedbackCreateInfo.pipelineStageCreationFeedbackCount = stageCount;
+                feedbackCreateInfo.pPipelineStageCreationFeedbacks = ( stageCount > 0 ) ? ( pFeedbacks + 1 ) : nullptr;
+
+                createInfo.pNext = &feedbackCreateInfo;
+
+                pFeedbacks += 1 + stageCount;
+            }
+        }
+
+    private:
+        static uint32_t GetShaderStageCount( const VkGraphicsPipelineCreateInfo& createInfo ) { return createInfo.stageCount; }
+        static uint32_t GetShaderStageCount( const VkComputePipelineCreateInfo& ) { return 1; }
+        static uint32_t GetShaderStageCount( const VkRayTracingPipelineCreateInfoKHR& createInfo ) { return createInfo.stageCount; }
+    };
+}
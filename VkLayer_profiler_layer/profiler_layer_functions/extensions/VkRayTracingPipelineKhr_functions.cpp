@@ -19,6 +19,7 @@
 // SOFTWARE.
 
 #include "VkRayTracingPipelineKhr_functions.h"
+#include "VkPipelineCreationFeedbackExt_functions.h"
 #include "VkPipelineExecutablePropertiesKhr_functions.h"
 
 namespace Profiler
@@ -44,23 +45,39 @@ namespace Profiler
         TipGuard tip( dd.Device.TIP, __func__ );
 
         // Capture executable properties for shader inspection.
-        VkRayTracingPipelineCreateInfoKHR* pCreateInfosWithExecutableProperties = nullptr;
+        VkRayTracingPipelineCreateInfoKHR* pModifiedCreateInfos = nullptr;
         VkPipelineExecutablePropertiesKhr_Functions::CapturePipelineExecutableProperties(
-            dd, createInfoCount, &pCreateInfos, &pCreateInfosWithExecutableProperties );
+            dd, createInfoCount, &pCreateInfos, &pModifiedCreateInfos );
+
+        // Capture creation feedback to get compilation time of each pipeline.
+        // The feedback is written when the pipelines are created, so it must outlive the deferred operation.
+        auto pCreationFeedback = std::make_shared<VkPipelineCreationFeedbackExt_Functions::CreationFeedback>();
+        VkPipelineCreationFeedbackExt_Functions::CapturePipelineCreationFeedback(
+            dd, createInfoCount, &pCreateInfos, &pModifiedCreateInfos, *pCreationFeedback );
+
+        DeviceProfilerPipelineCompilationData compilation;
+        compilation.m_ThreadId = ProfilerPlatformFunctions::GetCurrentThreadId();
+        compilation.m_BeginTimestamp = dd.Profiler.m_CpuTimestampCounter.GetCurrentValue();
 
         // Create the pipelines
         VkResult result = dd.Device.Callbacks.CreateRayTracingPipelinesKHR(
             device, deferredOperation, pipelineCache, createInfoCount, pCreateInfos, pAllocator, pPipelines );
 
+        compilation.m_EndTimestamp = dd.Profiler.m_CpuTimestampCounter.GetCurrentValue();
+
         // Register the pipelines once the deferred host operation completes.
         if( (deferredOperation != VK_NULL_HANDLE) && (result == VK_OPERATION_DEFERRED_KHR) )
         {
             // If the operation has been deferred, the pointer must be kept alive until the pipeline creation is complete.
             // The spec requires the application to join with the operation before freeing the memory, so we just need to
             // keep the reference to both handles and handle join function to free the create info when the pipeline is ready.
-            auto registerDeferredPipelines = [ &dd, createInfoCount, pCreateInfos, pPipelines, pCreateInfosWithExecutableProperties ]
-                ( VkDeferredOperationKHR deferredOperation )
+            auto registerDeferredPipelines = [ &dd, createInfoCount, pCreateInfos, pPipelines, pModifiedCreateInfos, pCreationFeedback, compilation ]
+                ( VkDeferredOperationKHR deferredOperation ) mutable
             {
+                // The compilation ends when the deferred operation is joined.
+                compilation.m_EndTimestamp = dd.Profiler.m_CpuTimestampCounter.GetCurrentValue();
+                compilation.m_Deferred = true;
+
                 // Get the result of the deferred operation.
                 VkResult pipelineCreationResult = dd.Device.Callbacks.GetDeferredOperationResultKHR(
                     dd.Device.Handle,
@@ -69,27 +86,27 @@ namespace Profiler
                 if( pipelineCreationResult == VK_SUCCESS )
                 {
                     // Register the pipelines.
-                    dd.Profiler.CreatePipelines( createInfoCount, pCreateInfos, pPipelines, true /*deferred*/ );
+                    dd.Profiler.CreatePipelines( createInfoCount, pCreateInfos, pPipelines, compilation, true /*deferred*/ );
                 }
 
                 // Release pointer to the extended create info when the operation is complete.
-                free( pCreateInfosWithExecutableProperties );
+                free( pModifiedCreateInfos );
             };
 
             dd.Profiler.SetDeferredOperationCallback( deferredOperation, registerDeferredPipelines );
 
             // Clear the pointer - it will be freed as part of the deferred operation.
-            pCreateInfosWithExecutableProperties = nullptr;
+            pModifiedCreateInfos = nullptr;
         }
 
         // Register the pipelines now if pipeline compilation succeeded immediatelly.
         if( (result == VK_SUCCESS) || (result == VK_OPERATION_NOT_DEFERRED_KHR) )
         {
             // Register pipelines
-            dd.Profiler.CreatePipelines( createInfoCount, pCreateInfos, pPipelines, false );
+            dd.Profiler.CreatePipelines( createInfoCount, pCreateInfos, pPipelines, compilation, false );
         }
 
-        free( pCreateInfosWithExecutableProperties );
+        free( pModifiedCreateInfos );
 
         return result;
     }
@@ -197,6 +197,8 @@ namespace Profiler
 
         if( dd.pOutput )
         {
+            DeviceProfilerOverheadScope overhead( dd.Profiler.m_Overhead, DeviceProfilerCpuOverheadCategory::eOutput );
+
             // Consume the collected data from the profiler.
             // Treat QueuePresentKHR as a submit to collect at least one frame of data before the presentation.
             if( dd.Profiler.m_Config.m_FrameDelimiter >= VK_PROFILER_FRAME_DELIMITER_PRESENT_EXT )
@@ -216,6 +218,11 @@ namespace Profiler
         dd.Device.TIP.Reset();
 
         // Present the image
-        return dd.Device.Callbacks.QueuePresentKHR( queue, pPresentInfo );
+        const uint64_t presentTimestamp = dd.Profiler.m_CpuTimestampCounter.GetCurrentValue();
+        VkResult result = dd.Device.Callbacks.QueuePresentKHR( queue, pPresentInfo );
+
+        dd.Profiler.PostPresent( queue, presentTimestamp );
+
+        return result;
     }
 }
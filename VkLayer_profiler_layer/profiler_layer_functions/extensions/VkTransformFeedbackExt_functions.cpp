@@ -0,0 +1,77 @@
+// Copyright (c) 2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "VkTransformFeedbackExt_functions.h"
+
+namespace Profiler
+{
+    /***********************************************************************************\
+
+    Function:
+        CmdBeginQueryIndexedEXT
+
+    Description:
+
+    \***********************************************************************************/
+    VKAPI_ATTR void VKAPI_CALL VkTransformFeedbackExt_Functions::CmdBeginQueryIndexedEXT(
+        VkCommandBuffer commandBuffer,
+        VkQueryPool queryPool,
+        uint32_t query,
+        VkQueryControlFlags flags,
+        uint32_t index )
+    {
+        auto& dd = DeviceDispatch.Get( commandBuffer );
+        TipGuard tip( dd.Device.TIP, __func__ );
+
+        auto& profiledCommandBuffer = dd.Profiler.GetCommandBuffer( commandBuffer );
+
+        // Suspend profiler's queries that conflict with the application's query
+        profiledCommandBuffer.BeginQuery( dd.Profiler.GetQueryPoolType( queryPool ) );
+
+        // Begin the query
+        dd.Device.Callbacks.CmdBeginQueryIndexedEXT( commandBuffer, queryPool, query, flags, index );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        CmdEndQueryIndexedEXT
+
+    Description:
+
+    \***********************************************************************************/
+    VKAPI_ATTR void VKAPI_CALL VkTransformFeedbackExt_Functions::CmdEndQueryIndexedEXT(
+        VkCommandBuffer commandBuffer,
+        VkQueryPool queryPool,
+        uint32_t query,
+        uint32_t index )
+    {
+        auto& dd = DeviceDispatch.Get( commandBuffer );
+        TipGuard tip( dd.Device.TIP, __func__ );
+
+        auto& profiledCommandBuffer = dd.Profiler.GetCommandBuffer( commandBuffer );
+
+        // End the query
+        dd.Device.Callbacks.CmdEndQueryIndexedEXT( commandBuffer, queryPool, query, index );
+
+        // Resume profiler's queries
+        profiledCommandBuffer.EndQuery( dd.Profiler.GetQueryPoolType( queryPool ) );
+    }
+}
@@ -47,6 +47,7 @@ namespace Profiler
         struct
         {
             bool NestedCommandBuffer : 1;
+            bool PipelineStatisticsQuery : 1;
         } EnabledFeatures;
 
         // Dispatch tables
@@ -42,6 +42,7 @@ namespace Profiler
 
         VkPhysicalDeviceProperties Properties;
         VkPhysicalDeviceMemoryProperties MemoryProperties;
+        VkPhysicalDeviceFeatures Features;
 
         VkPhysicalDevice_Vendor_ID VendorID;
 
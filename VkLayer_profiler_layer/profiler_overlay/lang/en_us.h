@@ -44,9 +44,12 @@ namespace Profiler
         inline static constexpr char PerformanceCountersMenuItem[] = "Performance counters" PROFILER_MENU_ITEM;
         inline static constexpr char QueueUtilizationMenuItem[] = "Queue utilization" PROFILER_MENU_ITEM;
         inline static constexpr char TopPipelinesMenuItem[] = "Top pipelines" PROFILER_MENU_ITEM;
+        inline static constexpr char PipelineCompilationMenuItem[] = "Pipeline compilation" PROFILER_MENU_ITEM;
         inline static constexpr char MemoryMenuItem[] = "Memory" PROFILER_MENU_ITEM;
+        inline static constexpr char MemoryEventsMenuItem[] = "Memory events" PROFILER_MENU_ITEM;
         inline static constexpr char InspectorMenuItem[] = "Inspector" PROFILER_MENU_ITEM;
         inline static constexpr char StatisticsMenuItem[] = "Statistics" PROFILER_MENU_ITEM;
+        inline static constexpr char ProfilerOverheadMenuItem[] = "Profiler overhead" PROFILER_MENU_ITEM;
         inline static constexpr char SettingsMenuItem[] = "Settings" PROFILER_MENU_ITEM;
         inline static constexpr char ApplicationInfoMenuItem[] = "Application info" PROFILER_MENU_ITEM;
         inline static constexpr char Fullscreen[] = "Fullscreen";
@@ -54,8 +57,10 @@ namespace Profiler
         // Tabs
         inline static constexpr char Performance[] = "Performance###Performance";
         inline static constexpr char Memory[] = "Memory###Memory";
+        inline static constexpr char MemoryEvents[] = "Memory events###Memory events";
         inline static constexpr char Inspector[] = "Inspector###Inspector";
         inline static constexpr char Statistics[] = "Statistics###Statistics";
+        inline static constexpr char ProfilerOverhead[] = "Profiler overhead###Profiler overhead";
         inline static constexpr char Settings[] = "Settings###Settings";
         inline static constexpr char ApplicationInfo[] = "Application info###ApplicationInfo";
 
@@ -78,6 +83,7 @@ namespace Profiler
         inline static constexpr char GPUCycles[] = "GPU Cycles";
         inline static constexpr char QueueUtilization[] = "Queue utilization###QueueUtilization";
         inline static constexpr char TopPipelines[] = "Top pipelines###Top pipelines";
+        inline static constexpr char PipelineCompilation[] = "Pipeline compilation###Pipeline compilation";
         inline static constexpr char PerformanceCounters[] = "Performance counters###Performance counters";
         inline static constexpr char Metric[] = "Metric";
         inline static constexpr char Contrib[] = "Contrib";
@@ -108,6 +114,29 @@ namespace Profiler
         inline static constexpr char ShaderCapabilityTooltipFmt[] = "At least one shader in the pipeline uses '%s' capability.";
         inline static constexpr char ShaderObjectsTooltip[] = "Pipeline constructed from VkShaderEXT objects passed via vkCmdBindShadersEXT.";
 
+        inline static constexpr char PipelineStatistics[] = "Pipeline statistics";
+        inline static constexpr char InputAssemblyVertices[] = "Input assembly vertices";
+        inline static constexpr char InputAssemblyPrimitives[] = "Input assembly primitives";
+        inline static constexpr char VertexShaderInvocations[] = "Vertex shader invocations";
+        inline static constexpr char GeometryShaderInvocations[] = "Geometry shader invocations";
+        inline static constexpr char GeometryShaderPrimitives[] = "Geometry shader primitives";
+        inline static constexpr char ClippingInvocations[] = "Clipping invocations";
+        inline static constexpr char ClippingPrimitives[] = "Clipping primitives";
+        inline static constexpr char FragmentShaderInvocations[] = "Fragment shader invocations";
+        inline static constexpr char TessellationControlShaderPatches[] = "Tessellation control shader patches";
+        inline static constexpr char TessellationEvaluationShaderInvocations[] = "Tessellation evaluation shader invocations";
+        inline static constexpr char ComputeShaderInvocations[] = "Compute shader invocations";
+
+        inline static constexpr char HitchDetectedFmt[] = "Hitch in frame #%u: %s took %.2f ms (average %.2f ms, p99 %.2f ms)";
+        inline static constexpr char MoreHitchesFmt[] = "... and %zu more";
+
+        inline static constexpr char CompilationTime[] = "Compilation time";
+        inline static constexpr char DriverTime[] = "Driver time";
+        inline static constexpr char CacheHits[] = "Cache hits";
+        inline static constexpr char Thread[] = "Thread";
+        inline static constexpr char Deferred[] = "Deferred";
+        inline static constexpr char NoPipelineCompilations[] = "No pipelines were compiled in the selected frames.";
+
         inline static constexpr char PerformanceCountersFilter[] = "Filter";
         inline static constexpr char PerformanceCountersRange[] = "Range";
         inline static constexpr char PerformanceCountersSet[] = "Metrics set";
@@ -124,6 +153,26 @@ namespace Profiler
         inline static constexpr char Buffers[] = "Buffers";
         inline static constexpr char Images[] = "Images";
 
+        // Memory events tab
+        inline static constexpr char MemoryEventLogDisabled[] = "Memory event log disabled.";
+        inline static constexpr char MemoryEventsDropped[] = "events dropped, the history has been restarted.";
+        inline static constexpr char MemoryEventChurn[] = "Events in the frame";
+        inline static constexpr char MemoryEventType[] = "Event";
+        inline static constexpr char MemoryEventCount[] = "Count";
+        inline static constexpr char MemoryEventSize[] = "Size";
+        inline static constexpr char MemoryEventAllocate[] = "Allocate";
+        inline static constexpr char MemoryEventFree[] = "Free";
+        inline static constexpr char MemoryEventBind[] = "Bind";
+        inline static constexpr char MemoryEventUnbind[] = "Unbind";
+        inline static constexpr char MemoryFragmentation[] = "Fragmentation";
+        inline static constexpr char MemoryHistoryFrame[] = "Frame";
+        inline static constexpr char MemoryHistoryFollowLatest[] = "Follow latest frame";
+        inline static constexpr char MemoryAllocation[] = "Allocation";
+        inline static constexpr char MemoryBoundSize[] = "Bound";
+        inline static constexpr char MemoryFreeSize[] = "Free";
+        inline static constexpr char MemoryLargestFreeBlock[] = "Largest free block";
+        inline static constexpr char MemoryFreeBlocks[] = "Free blocks";
+
         // Statistics tab
         inline static constexpr char ShowEmptyStatistics[] = "Show empty statistics...";
         inline static constexpr char HideEmptyStatistics[] = "Hide empty statistics";
@@ -153,9 +202,35 @@ namespace Profiler
         inline static constexpr char FillBufferCalls[] = "Fill buffer calls";
         inline static constexpr char UpdateBufferCalls[] = "Update buffer calls";
 
+        // Profiler overhead tab
+        inline static constexpr char OverheadCpuTime[] = "CPU time";
+        inline static constexpr char OverheadCpuTimeDisabled[] = "CPU time measurement disabled.";
+        inline static constexpr char OverheadHostMemory[] = "Host memory";
+        inline static constexpr char OverheadGpuMemory[] = "GPU memory";
+        inline static constexpr char OverheadShare[] = "Share";
+        inline static constexpr char OverheadSize[] = "Size";
+        inline static constexpr char OverheadCommandRecording[] = "Command recording";
+        inline static constexpr char OverheadQueueSubmission[] = "Queue submission";
+        inline static constexpr char OverheadDataResolve[] = "Data resolve";
+        inline static constexpr char OverheadOutput[] = "Output";
+        inline static constexpr char OverheadFrameData[] = "Frame data";
+        inline static constexpr char OverheadCopiedFrameData[] = "Frame data copied";
+        inline static constexpr char OverheadMemorySnapshots[] = "Memory snapshots";
+        inline static constexpr char OverheadShaderBytecode[] = "Shader bytecode";
+        inline static constexpr char OverheadPipelineCreateInfos[] = "Pipeline create infos";
+        inline static constexpr char OverheadQueryPools[] = "Query pools";
+        inline static constexpr char OverheadQueryDataBuffers[] = "Query data buffers";
+        inline static constexpr char OverheadIndirectArguments[] = "Indirect arguments";
+        inline static constexpr char OverheadDegradations[] = "Budget degradations";
+        inline static constexpr char OverheadDataBufferSizeReduced[] = "Number of kept frames reduced";
+        inline static constexpr char OverheadIndirectArgumentsDisabled[] = "Indirect arguments capture disabled";
+        inline static constexpr char OverheadSamplingModeCoarsened[] = "Sampling mode coarsened";
+        inline static constexpr char OverheadNoDegradations[] = "None";
+
         // Inspector tab
         inline static constexpr char PipelineState[] = "Pipeline state";
         inline static constexpr char PipelineStateNotAvailable[] = "Pipeline state info is not available for this pipeline.";
+        inline static constexpr char ShaderDisassemblyPending[] = "Disassembling shader...";
         inline static constexpr char PipelineStateVertexInput[] = "Vertex input";
         inline static constexpr char PipelineStateInputAssembly[] = "Input assembly";
         inline static constexpr char PipelineStateTessellation[] = "Tessellation";
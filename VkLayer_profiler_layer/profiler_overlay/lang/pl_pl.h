@@ -41,9 +41,12 @@ namespace Profiler
         inline static constexpr char PerformanceCountersMenuItem[] = u8"Liczniki wydajności" PROFILER_MENU_ITEM;
         inline static constexpr char QueueUtilizationMenuItem[] = u8"Wykorzystanie kolejek" PROFILER_MENU_ITEM;
         inline static constexpr char TopPipelinesMenuItem[] = u8"Najdłuższe stany potoku" PROFILER_MENU_ITEM;
+        inline static constexpr char PipelineCompilationMenuItem[] = u8"Kompilacja stanów potoku" PROFILER_MENU_ITEM;
         inline static constexpr char MemoryMenuItem[] = u8"Pamięć" PROFILER_MENU_ITEM;
+        inline static constexpr char MemoryEventsMenuItem[] = u8"Zdarzenia pamięci" PROFILER_MENU_ITEM;
         inline static constexpr char InspectorMenuItem[] = u8"Inspektor" PROFILER_MENU_ITEM;
         inline static constexpr char StatisticsMenuItem[] = u8"Statystyki" PROFILER_MENU_ITEM;
+        inline static constexpr char ProfilerOverheadMenuItem[] = u8"Narzut profilera" PROFILER_MENU_ITEM;
         inline static constexpr char SettingsMenuItem[] = u8"Ustawienia" PROFILER_MENU_ITEM;
         inline static constexpr char ApplicationInfoMenuItem[] = u8"Informacje o aplikacji" PROFILER_MENU_ITEM;
         inline static constexpr char Fullscreen[] = u8"Pełny ekran";
@@ -51,8 +54,10 @@ namespace Profiler
         // Tabs
         inline static constexpr char Performance[] = u8"Wydajność###Performance";
         inline static constexpr char Memory[] = u8"Pamięć###Memory";
+        inline static constexpr char MemoryEvents[] = u8"Zdarzenia pamięci###Memory events";
         inline static constexpr char Inspector[] = u8"Inspektor###Inspector";
         inline static constexpr char Statistics[] = u8"Statystyki###Statistics";
+        inline static constexpr char ProfilerOverhead[] = u8"Narzut profilera###Profiler overhead";
         inline static constexpr char Settings[] = u8"Ustawienia###Settings";
         inline static constexpr char ApplicationInfo[] = "Informacje o aplikacji###ApplicationInfo";
 
@@ -73,6 +78,7 @@ namespace Profiler
         inline static constexpr char GPUCycles[] = u8"Cykle GPU";
         inline static constexpr char QueueUtilization[] = u8"Wykorzystanie kolejek###QueueUtilization";
         inline static constexpr char TopPipelines[] = u8"Najdłuższe stany potoku###Top pipelines";
+        inline static constexpr char PipelineCompilation[] = u8"Kompilacja stanów potoku###Pipeline compilation";
         inline static constexpr char PerformanceCounters[] = u8"Liczniki wydajności###Performance counters";
         inline static constexpr char Metric[] = u8"Metryka";
         inline static constexpr char Contrib[] = u8"Udział";
@@ -101,6 +107,29 @@ namespace Profiler
         inline static constexpr char ShaderCapabilityTooltipFmt[] = u8"Co najmniej jeden shader w potoku korzysta z funkcjonalności '%s'.";
         inline static constexpr char ShaderObjectsTooltip[] = u8"Potok utworzony z objektów VkShaderEXT za pomocą vkCmdBindShadersEXT.";
 
+        inline static constexpr char PipelineStatistics[] = u8"Statystyki potoku";
+        inline static constexpr char InputAssemblyVertices[] = u8"Wierzchołki na wejściu";
+        inline static constexpr char InputAssemblyPrimitives[] = u8"Prymitywy na wejściu";
+        inline static constexpr char VertexShaderInvocations[] = u8"Wywołania shadera wierzchołków";
+        inline static constexpr char GeometryShaderInvocations[] = u8"Wywołania shadera geometrii";
+        inline static constexpr char GeometryShaderPrimitives[] = u8"Prymitywy shadera geometrii";
+        inline static constexpr char ClippingInvocations[] = u8"Wywołania obcinania";
+        inline static constexpr char ClippingPrimitives[] = u8"Prymitywy po obcinaniu";
+        inline static constexpr char FragmentShaderInvocations[] = u8"Wywołania shadera fragmentów";
+        inline static constexpr char TessellationControlShaderPatches[] = u8"Płaty shadera kontroli teselacji";
+        inline static constexpr char TessellationEvaluationShaderInvocations[] = u8"Wywołania shadera ewaluacji teselacji";
+        inline static constexpr char ComputeShaderInvocations[] = u8"Wywołania shadera obliczeniowego";
+
+        inline static constexpr char HitchDetectedFmt[] = u8"Spowolnienie w ramce #%u: %s trwało %.2f ms (średnio %.2f ms, p99 %.2f ms)";
+        inline static constexpr char MoreHitchesFmt[] = u8"... i %zu więcej";
+
+        inline static constexpr char CompilationTime[] = u8"Czas kompilacji";
+        inline static constexpr char DriverTime[] = u8"Czas sterownika";
+        inline static constexpr char CacheHits[] = u8"Trafienia w pamięci podręcznej";
+        inline static constexpr char Thread[] = u8"Wątek";
+        inline static constexpr char Deferred[] = u8"Odroczona";
+        inline static constexpr char NoPipelineCompilations[] = u8"W wybranych ramkach nie skompilowano żadnych stanów potoku.";
+
         inline static constexpr char PerformanceCountersFilter[] = u8"Filtr";
         inline static constexpr char PerformanceCountersRange[] = u8"Zakres";
         inline static constexpr char PerformanceCountersSet[] = u8"Zbiór metryk";
@@ -142,9 +171,55 @@ namespace Profiler
         inline static constexpr char FillBufferCalls[] = u8"Wypełnienia buforów";
         inline static constexpr char UpdateBufferCalls[] = u8"Aktualizacje buforów";
 
+        // Memory events tab
+        inline static constexpr char MemoryEventLogDisabled[] = u8"Dziennik zdarzeń pamięci wyłączony.";
+        inline static constexpr char MemoryEventsDropped[] = u8"zdarzeń utraconych, historia została rozpoczęta od nowa.";
+        inline static constexpr char MemoryEventChurn[] = u8"Zdarzenia w ramce";
+        inline static constexpr char MemoryEventType[] = u8"Zdarzenie";
+        inline static constexpr char MemoryEventCount[] = u8"Liczba";
+        inline static constexpr char MemoryEventSize[] = u8"Rozmiar";
+        inline static constexpr char MemoryEventAllocate[] = u8"Alokacja";
+        inline static constexpr char MemoryEventFree[] = u8"Zwolnienie";
+        inline static constexpr char MemoryEventBind[] = u8"Powiązanie";
+        inline static constexpr char MemoryEventUnbind[] = u8"Odłączenie";
+        inline static constexpr char MemoryFragmentation[] = u8"Fragmentacja";
+        inline static constexpr char MemoryHistoryFrame[] = u8"Ramka";
+        inline static constexpr char MemoryHistoryFollowLatest[] = u8"Śledź najnowszą ramkę";
+        inline static constexpr char MemoryAllocation[] = u8"Alokacja";
+        inline static constexpr char MemoryBoundSize[] = u8"Zajęte";
+        inline static constexpr char MemoryFreeSize[] = u8"Wolne";
+        inline static constexpr char MemoryLargestFreeBlock[] = u8"Największy wolny blok";
+        inline static constexpr char MemoryFreeBlocks[] = u8"Wolne bloki";
+
+        // Profiler overhead tab
+        inline static constexpr char OverheadCpuTime[] = u8"Czas procesora";
+        inline static constexpr char OverheadCpuTimeDisabled[] = u8"Pomiar czasu procesora wyłączony.";
+        inline static constexpr char OverheadHostMemory[] = u8"Pamięć hosta";
+        inline static constexpr char OverheadGpuMemory[] = u8"Pamięć GPU";
+        inline static constexpr char OverheadShare[] = u8"Udział";
+        inline static constexpr char OverheadSize[] = u8"Rozmiar";
+        inline static constexpr char OverheadCommandRecording[] = u8"Nagrywanie komend";
+        inline static constexpr char OverheadQueueSubmission[] = u8"Wysyłanie do kolejek";
+        inline static constexpr char OverheadDataResolve[] = u8"Przetwarzanie danych";
+        inline static constexpr char OverheadOutput[] = u8"Wyjście";
+        inline static constexpr char OverheadFrameData[] = u8"Dane ramek";
+        inline static constexpr char OverheadCopiedFrameData[] = u8"Skopiowane dane ramek";
+        inline static constexpr char OverheadMemorySnapshots[] = u8"Zrzuty pamięci";
+        inline static constexpr char OverheadShaderBytecode[] = u8"Kod shaderów";
+        inline static constexpr char OverheadPipelineCreateInfos[] = u8"Opisy stanów potoku";
+        inline static constexpr char OverheadQueryPools[] = u8"Pule zapytań";
+        inline static constexpr char OverheadQueryDataBuffers[] = u8"Bufory wyników zapytań";
+        inline static constexpr char OverheadIndirectArguments[] = u8"Argumenty komend indirect";
+        inline static constexpr char OverheadDegradations[] = u8"Ograniczenia po przekroczeniu budżetu";
+        inline static constexpr char OverheadDataBufferSizeReduced[] = u8"Zmniejszono liczbę przechowywanych ramek";
+        inline static constexpr char OverheadIndirectArgumentsDisabled[] = u8"Wyłączono przechwytywanie argumentów komend indirect";
+        inline static constexpr char OverheadSamplingModeCoarsened[] = u8"Zmniejszono częstotliwość próbkowania";
+        inline static constexpr char OverheadNoDegradations[] = u8"Brak";
+
         // Inspector tab
         inline static constexpr char PipelineState[] = u8"Stan potoku";
         inline static constexpr char PipelineStateNotAvailable[] = u8"Informacje o stanie potoku nie są dostępne.";
+        inline static constexpr char ShaderDisassemblyPending[] = u8"Deasemblacja shadera...";
 
         // Settings tab
         inline static constexpr char SamplingMode[] = u8"Częstotliwość próbkowania";
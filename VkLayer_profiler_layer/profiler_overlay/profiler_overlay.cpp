@@ -32,6 +32,7 @@
 #include <string>
 #include <sstream>
 #include <stack>
+#include <map>
 #include <fstream>
 #include <regex>
 #include <inttypes.h>
@@ -52,14 +53,7 @@
 #include <imgui_stdlib.h>
 
 // Languages
-#include "lang/en_us.h"
-#include "lang/pl_pl.h"
-
-#if 1
-using Lang = Profiler::DeviceProfilerOverlayLanguage_Base;
-#else
-using Lang = Profiler::DeviceProfilerOverlayLanguage_PL;
-#endif
+#include "lang/lang.h"
 
 namespace Profiler
 {
@@ -159,10 +153,12 @@ namespace Profiler
             eCommandBuffer,
             eSignalSemaphores,
             eWaitSemaphores,
+            eCpuSpan,
         };
 
         DataType userDataType;
         FrameBrowserTreeNodeIndex nodeIndex;
+        const DeviceProfilerSubmitData* submitData = nullptr;
     };
 
     struct ProfilerOverlayOutput::ResourceListExporter
@@ -347,10 +343,13 @@ namespace Profiler
         , m_PerformanceWindowState{ m_Settings.AddBool( "PerformanceWindowOpen", true ), true }
         , m_QueueUtilizationWindowState{ m_Settings.AddBool( "QueueUtilizationWindowOpen", true ), true }
         , m_TopPipelinesWindowState{ m_Settings.AddBool( "TopPipelinesWindowOpen", true ), true }
+        , m_PipelineCompilationWindowState{ m_Settings.AddBool( "PipelineCompilationWindowOpen", true ), true }
         , m_PerformanceCountersWindowState{ m_Settings.AddBool( "PerformanceCountersWindowOpen", true ), true }
         , m_MemoryWindowState{ m_Settings.AddBool( "MemoryWindowOpen", true ), true }
+        , m_MemoryEventsWindowState{ m_Settings.AddBool( "MemoryEventsWindowOpen", false ), true }
         , m_InspectorWindowState{ m_Settings.AddBool( "InspectorWindowOpen", true ), true }
         , m_StatisticsWindowState{ m_Settings.AddBool( "StatisticsWindowOpen", true ), true }
+        , m_ProfilerOverheadWindowState{ m_Settings.AddBool( "ProfilerOverheadWindowOpen", false ), true }
         , m_SettingsWindowState{ m_Settings.AddBool( "SettingsWindowOpen", true ), true }
     {
         ResetMembers();
@@ -425,6 +424,14 @@ namespace Profiler
                 m_SetLastMainWindowPos = true;
             }
 
+            // Render the overlay from the cached image if the UI refresh rate is limited
+            const int refreshRate = m_Frontend.GetProfilerConfig().m_OverlayRefreshRate;
+            if( refreshRate > 0 )
+            {
+                m_UIRefreshLimiter.SetRefreshRate( refreshRate );
+                m_Backend.SetRenderCacheEnabled( true );
+            }
+
             // Initialize ImGui backends
             success = m_Backend.PrepareImGuiBackend();
 
@@ -556,6 +563,14 @@ namespace Profiler
             }
 
             SetMaxFrameCount( std::max( config.m_FrameCount, 0 ) );
+
+            if( config.m_OverlayThreadedUi )
+            {
+                // Build the UI on a dedicated thread to keep the present thread overhead low.
+                m_UIThreadExit = false;
+                m_UIFrameRequested = false;
+                m_UIThread = std::thread( &ProfilerOverlayOutput::UIThreadProc, this );
+            }
         }
 
         // Don't leave object in partly-initialized state if something went wrong
@@ -578,6 +593,18 @@ namespace Profiler
     \***********************************************************************************/
     void ProfilerOverlayOutput::Destroy()
     {
+        if( m_UIThread.joinable() )
+        {
+            // Stop the UI thread before destroying the ImGui context.
+            {
+                std::scoped_lock lk( m_UIThreadMutex );
+                m_UIThreadExit = true;
+            }
+
+            m_UIThreadCondition.notify_one();
+            m_UIThread.join();
+        }
+
         if( m_pImGuiContext )
         {
             std::scoped_lock imGuiLock( s_ImGuiMutex );
@@ -637,6 +664,13 @@ namespace Profiler
 
         m_pData = nullptr;
 
+        m_UIThread = std::thread();
+        m_UIThreadExit = false;
+        m_UIFrameRequested = false;
+        m_PendingUpdateCount = 0;
+
+        m_UIRefreshLimiter.SetRefreshRate( 0 );
+
         m_Opacity = 0.9f;
         m_Pause = false;
         m_Fullscreen = false;
@@ -669,6 +703,8 @@ namespace Profiler
         m_InspectorTabIndex = 0;
 
         m_MemoryComparator.Reset();
+        m_pMemorySnapshotFrameData = nullptr;
+        m_pMemorySnapshot = nullptr;
         m_MemoryCompareRefFrameIndex = InvalidFrameIndex;
         m_MemoryCompareSelFrameIndex = CurrentFrameIndex;
         m_ResourceBrowserNameFilter.clear();
@@ -698,6 +734,10 @@ namespace Profiler
 
         memset( m_MemoryConsumptionHistoryMax, 0, sizeof( m_MemoryConsumptionHistoryMax ) );
 
+        m_MemoryHistory.Reset();
+        m_MemoryHistoryFrameIndex = 0;
+        m_MemoryHistoryFollowLatest = true;
+
         m_pActivePerformanceQueryMetricsSet = nullptr;
         m_pPerformanceQueryMetricsSets.clear();
         m_ActivePerformanceQueryMetricsFilterResults.clear();
@@ -736,11 +776,18 @@ namespace Profiler
 
         m_pTraceExporter = nullptr;
 
+        m_HitchNotificationMessage.clear();
+        m_HitchNotificationTimestamp = std::chrono::high_resolution_clock::time_point();
+
         m_RenderPassColumnColor = 0;
         m_GraphicsPipelineColumnColor = 0;
         m_ComputePipelineColumnColor = 0;
         m_RayTracingPipelineColumnColor = 0;
         m_InternalPipelineColumnColor = 0;
+        m_CriticalPathColumnColor = 0;
+        m_CpuRecordingColumnColor = 0;
+        m_CpuSubmitColumnColor = 0;
+        m_CpuPresentColumnColor = 0;
 
         m_pStringSerializer = nullptr;
 
@@ -787,6 +834,21 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Function:
+        SetFullscreen
+
+    Description:
+        Enable or disable the fullscreen mode of the main window.
+
+    \***********************************************************************************/
+    void ProfilerOverlayOutput::SetFullscreen( bool fullscreen )
+    {
+        m_Fullscreen = fullscreen;
+        m_SetLastMainWindowPos = false;
+    }
+
+    /***********************************************************************************\
+
     Function:
         Update
 
@@ -795,6 +857,28 @@ namespace Profiler
 
     \***********************************************************************************/
     void ProfilerOverlayOutput::Update()
+    {
+        if( m_UIThread.joinable() )
+        {
+            // The data will be consumed by the UI thread before building the next frame.
+            // Consuming it here would block the caller until the current frame is built.
+            m_PendingUpdateCount++;
+            return;
+        }
+
+        UpdateData();
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        UpdateData
+
+    Description:
+        Consume available data from the frontend.
+
+    \***********************************************************************************/
+    void ProfilerOverlayOutput::UpdateData()
     {
         std::scoped_lock lk( m_DataMutex );
 
@@ -804,6 +888,17 @@ namespace Profiler
             auto pData = m_Frontend.GetData();
             if( pData )
             {
+                if( !pData->m_Hitches.empty() )
+                {
+                    UpdateHitchNotification( *pData );
+                }
+
+                if( m_Frontend.GetProfilerConfig().m_EnableMemoryEventLog )
+                {
+                    // Keep the memory events to reconstruct the memory state of the past frames.
+                    m_MemoryHistory.AppendFrame( pData->m_CPU.m_FrameIndex, pData->m_Memory );
+                }
+
                 m_pFrames.push_back( std::move( pData ) );
             }
         }
@@ -866,6 +961,13 @@ namespace Profiler
     \***********************************************************************************/
     void ProfilerOverlayOutput::Present()
     {
+        if( m_UIThread.joinable() )
+        {
+            // The UI is built on a separate thread, only render the latest frame here.
+            PresentThreaded();
+            return;
+        }
+
         std::scoped_lock lk( s_ImGuiMutex );
         ScopedValue imGuiLockFlag( s_ImGuiMutexLockedInThisThread, true );
 
@@ -876,11 +978,139 @@ namespace Profiler
         ImGuiIO& io = ImGui::GetIO();
         io.DisplaySize = m_Backend.GetRenderArea();
 
-        if( !m_Backend.NewFrame() )
+        if( !m_Backend.PrepareImGuiBackend() || !m_Backend.NewFrame() )
         {
             return;
         }
 
+        if( IsUIRefreshRequired( ImGui::GetDrawData() ) )
+        {
+            BuildFrame();
+        }
+
+        m_Backend.RenderDrawData( ImGui::GetDrawData() );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        PresentThreaded
+
+    Description:
+        Submit the most recent frame recorded by the UI thread and request the next one.
+        The present thread doesn't use the ImGui context, so it never waits for the UI
+        thread building the frame. It is synchronized with the UI thread only by the
+        backend, which serializes the updates of the shared resources.
+
+    \***********************************************************************************/
+    void ProfilerOverlayOutput::PresentThreaded()
+    {
+        m_Backend.SubmitRecordedDrawData();
+
+        // Request the next frame. The UI thread polls the input and rebuilds the frame if required.
+        {
+            std::scoped_lock lk( m_UIThreadMutex );
+            m_UIFrameRequested = true;
+        }
+
+        m_UIThreadCondition.notify_one();
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        IsUIRefreshRequired
+
+    Description:
+        Check whether the UI has to be rebuilt in the current frame.
+        Requires the ImGui mutex to be locked and the overlay's context to be current.
+
+    \***********************************************************************************/
+    bool ProfilerOverlayOutput::IsUIRefreshRequired( const ImDrawData* pDrawData )
+    {
+        const ImGuiContext& context = *ImGui::GetCurrentContext();
+
+        // The platform backend polls the input in NewFrame, which must be called before this check,
+        // so the events received since the last refresh are already in the queue.
+        return m_UIRefreshLimiter.IsRefreshRequired(
+            pDrawData,
+            context.IO.DisplaySize,
+            !context.InputEventsQueue.empty(),
+            OverlayRefreshLimiter::Clock::now() );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        UIThreadProc
+
+    Description:
+        Poll the input and build the UI frames requested by the present thread.
+        The draw data is recorded by the backend while the overlay's ImGui context is
+        current and submitted by PresentThreaded.
+
+    \***********************************************************************************/
+    void ProfilerOverlayOutput::UIThreadProc()
+    {
+        std::unique_lock lk( m_UIThreadMutex );
+
+        while( true )
+        {
+            m_UIThreadCondition.wait( lk, [this]() { return m_UIFrameRequested || m_UIThreadExit; } );
+
+            if( m_UIThreadExit )
+            {
+                break;
+            }
+
+            m_UIFrameRequested = false;
+            lk.unlock();
+
+            // Consume the data deferred by Update calls.
+            uint32_t pendingUpdateCount = m_PendingUpdateCount.exchange( 0 );
+            while( pendingUpdateCount-- )
+            {
+                UpdateData();
+            }
+
+            {
+                std::scoped_lock imGuiLock( s_ImGuiMutex );
+                ScopedValue imGuiLockFlag( s_ImGuiMutexLockedInThisThread, true );
+
+                ImGui::SetCurrentContext( m_pImGuiContext );
+                ImPlot::SetCurrentContext( m_pImPlotContext );
+
+                // Must be set before calling NewFrame to avoid clipping on window resize.
+                ImGuiIO& io = ImGui::GetIO();
+                io.DisplaySize = m_Backend.GetRenderArea();
+
+                // The backends are (re)initialized here, because they require the ImGui context.
+                if( m_Backend.PrepareImGuiBackend() &&
+                    m_Backend.NewFrame() &&
+                    IsUIRefreshRequired( ImGui::GetDrawData() ) )
+                {
+                    BuildFrame();
+
+                    m_Backend.RecordDrawData( ImGui::GetDrawData() );
+                }
+            }
+
+            lk.lock();
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        BuildFrame
+
+    Description:
+        Build the ImGui frame with the overlay UI.
+        Requires the ImGui mutex to be locked and the overlay's context to be current.
+
+    \***********************************************************************************/
+    void ProfilerOverlayOutput::BuildFrame()
+    {
         ImGui::NewFrame();
 
         // Prevent data modification during presentation.
@@ -970,10 +1200,13 @@ namespace Profiler
                 ImGui::MenuItem( Lang::PerformanceMenuItem, nullptr, m_PerformanceWindowState.pOpen );
                 ImGui::MenuItem( Lang::QueueUtilizationMenuItem, nullptr, m_QueueUtilizationWindowState.pOpen );
                 ImGui::MenuItem( Lang::TopPipelinesMenuItem, nullptr, m_TopPipelinesWindowState.pOpen );
+                ImGui::MenuItem( Lang::PipelineCompilationMenuItem, nullptr, m_PipelineCompilationWindowState.pOpen );
                 ImGui::MenuItem( Lang::PerformanceCountersMenuItem, nullptr, m_PerformanceCountersWindowState.pOpen );
                 ImGui::MenuItem( Lang::MemoryMenuItem, nullptr, m_MemoryWindowState.pOpen );
+                ImGui::MenuItem( Lang::MemoryEventsMenuItem, nullptr, m_MemoryEventsWindowState.pOpen );
                 ImGui::MenuItem( Lang::InspectorMenuItem, nullptr, m_InspectorWindowState.pOpen );
                 ImGui::MenuItem( Lang::StatisticsMenuItem, nullptr, m_StatisticsWindowState.pOpen );
+                ImGui::MenuItem( Lang::ProfilerOverheadMenuItem, nullptr, m_ProfilerOverheadWindowState.pOpen );
                 ImGui::MenuItem( Lang::SettingsMenuItem, nullptr, m_SettingsWindowState.pOpen );
                 ImGui::EndMenu();
             }
@@ -1010,7 +1243,7 @@ namespace Profiler
         ImGui::SetCursorPosY( ImGui::GetCursorPosY() + 5 );
 
         m_MainDockSpaceId = ImGui::GetID( "##m_MainDockSpaceId" );
-        m_PerformanceTabDockSpaceId = ImGui::GetID( "##m_PerformanceTabDockSpaceId_3" );
+        m_PerformanceTabDockSpaceId = ImGui::GetID( "##m_PerformanceTabDockSpaceId_4" );
         m_MemoryTabDockSpaceId = ImGui::GetID( "##m_MemoryTabDockSpaceId" );
 
         ImU32 defaultWindowBg = ImGui::GetColorU32( ImGuiCol_WindowBg );
@@ -1098,6 +1331,13 @@ namespace Profiler
         }
         EndDockingWindow();
 
+        // Pipeline compilation
+        if( BeginDockingWindow( Lang::PipelineCompilation, m_PerformanceTabDockSpaceId, m_PipelineCompilationWindowState ) )
+        {
+            UpdatePipelineCompilationTab();
+        }
+        EndDockingWindow();
+
         if( BeginDockingWindow( Lang::PerformanceCounters, m_PerformanceTabDockSpaceId, m_PerformanceCountersWindowState ) )
         {
             UpdatePerformanceCountersTab();
@@ -1114,6 +1354,12 @@ namespace Profiler
         }
         EndDockingWindow();
 
+        if( BeginDockingWindow( Lang::MemoryEvents, m_MainDockSpaceId, m_MemoryEventsWindowState ) )
+        {
+            UpdateMemoryEventsTab();
+        }
+        EndDockingWindow();
+
         if( BeginDockingWindow( Lang::Inspector, m_MainDockSpaceId, m_InspectorWindowState ) )
         {
             UpdateInspectorTab();
@@ -1126,6 +1372,12 @@ namespace Profiler
         }
         EndDockingWindow();
 
+        if( BeginDockingWindow( Lang::ProfilerOverhead, m_MainDockSpaceId, m_ProfilerOverheadWindowState ) )
+        {
+            UpdateProfilerOverheadTab();
+        }
+        EndDockingWindow();
+
         if( BeginDockingWindow( Lang::Settings, m_MainDockSpaceId, m_SettingsWindowState ) )
         {
             UpdateSettingsTab();
@@ -1172,8 +1424,6 @@ namespace Profiler
         ImGui::PopStyleVar();
         ImGui::PopFont();
         ImGui::Render();
-
-        m_Backend.RenderDrawData( ImGui::GetDrawData() );
     }
 
     /***********************************************************************************\
@@ -1204,6 +1454,10 @@ namespace Profiler
         m_ComputePipelineColumnColor = ImGui::GetColorU32( { 0.9f, 0.55f, 0.0f, 1.0f } ); // #ffba42
         m_RayTracingPipelineColumnColor = ImGui::GetColorU32( { 0.2f, 0.73f, 0.92f, 1.0f } ); // #34baeb
         m_InternalPipelineColumnColor = ImGui::GetColorU32( { 0.5f, 0.22f, 0.9f, 1.0f } ); // #9e30ff
+        m_CriticalPathColumnColor = ImGui::GetColorU32( { 0.9f, 0.3f, 0.2f, 1.0f } ); // #e64d33
+        m_CpuRecordingColumnColor = ImGui::GetColorU32( { 0.3f, 0.7f, 0.3f, 1.0f } ); // #4db34d
+        m_CpuSubmitColumnColor = ImGui::GetColorU32( { 0.5f, 0.5f, 0.9f, 1.0f } ); // #8080e6
+        m_CpuPresentColumnColor = ImGui::GetColorU32( { 0.7f, 0.4f, 0.8f, 1.0f } ); // #b366cc
 
         m_InspectorShaderView.InitializeStyles();
     }
@@ -1247,6 +1501,7 @@ namespace Profiler
             ImGui::DockBuilderDockWindow( Lang::Snapshots, dockFrames );
             ImGui::DockBuilderDockWindow( Lang::QueueUtilization, dockQueueUtilization );
             ImGui::DockBuilderDockWindow( Lang::TopPipelines, dockTopPipelines );
+            ImGui::DockBuilderDockWindow( Lang::PipelineCompilation, dockTopPipelines );
             ImGui::DockBuilderDockWindow( Lang::FrameBrowser, dockLeft );
             ImGui::DockBuilderDockWindow( Lang::PerformanceCounters, dockMain );
             ImGui::DockBuilderFinish( m_PerformanceTabDockSpaceId );
@@ -1498,13 +1753,13 @@ namespace Profiler
                             index.emplace_back( 0 );
 
                             // Sort frame browser data
-                            std::list<const DeviceProfilerCommandBufferData*> pCommandBuffers =
+                            std::list<const DeviceProfilerCommandBufferDataPtr*> pCommandBuffers =
                                 SortFrameBrowserData( submit.m_CommandBuffers );
 
                             // Enumerate command buffers in submit
                             for( const auto* pCommandBuffer : pCommandBuffers )
                             {
-                                PrintCommandBuffer( *pCommandBuffer, index );
+                                PrintCommandBuffer( **pCommandBuffer, index );
                                 index.back()++;
                             }
 
@@ -1713,6 +1968,61 @@ namespace Profiler
             }
         }
 
+        // CPU activity of the application threads, aligned with the queues using calibrated timestamps.
+        std::map<uint32_t, std::vector<QueueGraphColumn>> cpuThreadGraphColumns;
+        GetCpuThreadGraphColumns( cpuThreadGraphColumns );
+
+        for( const auto& [threadId, threadGraphColumns] : cpuThreadGraphColumns )
+        {
+            char threadGraphId[32];
+            snprintf( threadGraphId, sizeof( threadGraphId ), "##CpuThreadGraph%u", threadId );
+
+            ImGui::Text( "CPU %s %u", Lang::Thread, threadId );
+
+            const float threadUtilization = GetQueueUtilization( threadGraphColumns );
+            ImGuiX::TextAlignRight(
+                "%.2f %s, %.2f %%",
+                threadUtilization,
+                m_pTimestampDisplayUnitStr,
+                threadUtilization * 100.f / frameDuration );
+
+            ImGui::PushItemWidth( -1 );
+            ImGuiX::PlotHistogramEx(
+                threadGraphId,
+                threadGraphColumns.data(),
+                static_cast<int>( threadGraphColumns.size() ),
+                0,
+                sizeof( threadGraphColumns.front() ),
+                "", 0, FLT_MAX, { 0, 8 * interfaceScale },
+                ImGuiX::HistogramFlags_NoScale,
+                std::bind( &ProfilerOverlayOutput::DrawQueueGraphLabel, this, std::placeholders::_1 ) );
+        }
+
+        // Sum of the submits on the critical path of the displayed frames.
+        uint64_t criticalPathTicks = 0;
+        if( showActiveFrame )
+        {
+            criticalPathTicks = m_pData->m_CriticalPathTicks;
+        }
+        else
+        {
+            for( const auto& pFrame : framesList )
+            {
+                criticalPathTicks += pFrame->m_CriticalPathTicks;
+            }
+        }
+
+        if( criticalPathTicks > 0 )
+        {
+            const float criticalPathDuration = GetDuration( 0, criticalPathTicks );
+            ImGui::TextUnformatted( "Critical path" );
+            ImGuiX::TextAlignRight(
+                "%.2f %s, %.2f %%",
+                criticalPathDuration,
+                m_pTimestampDisplayUnitStr,
+                criticalPathDuration * 100.f / frameDuration );
+        }
+
         ImGui::PopStyleColor();
         ImGui::PopStyleVar();
         ImGui::SetCursorPosY( ImGui::GetCursorPosY() + 5 * interfaceScale );
@@ -1735,7 +2045,17 @@ namespace Profiler
         {
         case QueueGraphColumn::eIdle:
         {
-            ImGui::SetTooltip( "Idle\n%.2f %s", column.x, m_pTimestampDisplayUnitStr );
+            if( column.submitData && ( column.submitData->m_IdleReason != DeviceProfilerQueueIdleReason::eNone ) )
+            {
+                ImGui::SetTooltip( "Idle\n%.2f %s\n%s",
+                    column.x,
+                    m_pTimestampDisplayUnitStr,
+                    m_pStringSerializer->GetQueueIdleReasonName( column.submitData->m_IdleReason ).c_str() );
+            }
+            else
+            {
+                ImGui::SetTooltip( "Idle\n%.2f %s", column.x, m_pTimestampDisplayUnitStr );
+            }
             break;
         }
         case QueueGraphColumn::eCommandBuffer:
@@ -1750,6 +2070,20 @@ namespace Profiler
                     column.x,
                     m_pTimestampDisplayUnitStr );
 
+                if( column.submitData )
+                {
+                    if( column.submitData->m_CriticalPath )
+                    {
+                        ImGui::TextUnformatted( "On the critical path" );
+                    }
+                    else
+                    {
+                        ImGui::Text( "Slack: %.2f %s",
+                            GetDuration( 0, column.submitData->m_SlackTicks ),
+                            m_pTimestampDisplayUnitStr );
+                    }
+                }
+
                 ImGui::PushStyleColor( ImGuiCol_Text, { 0.55f, 0.55f, 0.55f, 1.0f } );
                 ImGui::TextUnformatted( "Click to show in Frame Browser" );
                 ImGui::PopStyleColor();
@@ -1758,6 +2092,34 @@ namespace Profiler
             }
             break;
         }
+        case QueueGraphColumn::eCpuSpan:
+        {
+            const DeviceProfilerCpuSpanData& span =
+                *reinterpret_cast<const DeviceProfilerCpuSpanData*>( column.userData );
+
+            switch( span.m_Type )
+            {
+            case DeviceProfilerCpuSpanType::eCommandBufferRecording:
+                ImGui::SetTooltip( "Recording %s\n%.2f %s",
+                    m_pStringSerializer->GetName( span.m_CommandBuffer ).c_str(),
+                    column.x,
+                    m_pTimestampDisplayUnitStr );
+                break;
+            case DeviceProfilerCpuSpanType::eQueueSubmit:
+                ImGui::SetTooltip( "vkQueueSubmit %s\n%.2f %s",
+                    m_pStringSerializer->GetName( span.m_Queue ).c_str(),
+                    column.x,
+                    m_pTimestampDisplayUnitStr );
+                break;
+            case DeviceProfilerCpuSpanType::eQueuePresent:
+                ImGui::SetTooltip( "vkQueuePresentKHR %s\n%.2f %s",
+                    m_pStringSerializer->GetName( span.m_Queue ).c_str(),
+                    column.x,
+                    m_pTimestampDisplayUnitStr );
+                break;
+            }
+            break;
+        }
         case QueueGraphColumn::eSignalSemaphores:
         {
             const std::vector<VkSemaphoreHandle>& semaphores =
@@ -2156,6 +2518,209 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Function:
+        UpdatePipelineCompilationTab
+
+    Description:
+        Updates "Pipeline compilation" tab.
+
+    \***********************************************************************************/
+    void ProfilerOverlayOutput::UpdatePipelineCompilationTab()
+    {
+        const float interfaceScale = ImGui::GetIO().FontGlobalScale;
+
+        // Collect compilations completed in the displayed frames.
+        const bool showActiveFrame = GetShowActiveFrame();
+        const FrameDataList& framesList = GetActiveFramesList();
+        std::shared_ptr<DeviceProfilerFrameData> pFirstFrame = showActiveFrame ? m_pData : framesList.front();
+        std::shared_ptr<DeviceProfilerFrameData> pLastFrame = showActiveFrame ? m_pData : framesList.back();
+
+        std::vector<const DeviceProfilerPipelineCompilationData*> compilations;
+        uint64_t compilationTicks = 0;
+
+        auto collectCompilations = [&]( const DeviceProfilerFrameData& frameData )
+        {
+            for( const DeviceProfilerPipelineCompilationData& compilation : frameData.m_PipelineCompilations )
+            {
+                compilations.push_back( &compilation );
+            }
+            compilationTicks += frameData.m_PipelineCompilationTicks;
+        };
+
+        if( showActiveFrame )
+        {
+            collectCompilations( *m_pData );
+        }
+        else
+        {
+            for( const auto& pFrame : framesList )
+            {
+                collectCompilations( *pFrame );
+            }
+        }
+
+        if( compilations.empty() )
+        {
+            ImGui::TextUnformatted( Lang::NoPipelineCompilations );
+            return;
+        }
+
+        // Compilation timestamps are CPU timestamps.
+        const double cpuTimestampFreq = static_cast<double>( OSGetTimestampFrequency( pLastFrame->m_SyncTimestamps.m_HostTimeDomain ) );
+        auto getCpuDuration = [&]( uint64_t ticks ) -> float
+        {
+            return static_cast<float>( ( ticks * 1000.0 ) / cpuTimestampFreq ) * m_TimestampDisplayUnit;
+        };
+
+        uint32_t pipelineCount = 0;
+        uint32_t feedbackCount = 0;
+        uint32_t cacheHitCount = 0;
+        uint64_t timelineBeginTimestamp = pFirstFrame->m_CPU.m_BeginTimestamp;
+        uint64_t timelineEndTimestamp = pLastFrame->m_CPU.m_EndTimestamp;
+        std::map<uint32_t, std::vector<const DeviceProfilerPipelineCompilationData*>> threadCompilations;
+
+        for( const DeviceProfilerPipelineCompilationData* pCompilation : compilations )
+        {
+            for( const DeviceProfilerPipelineCreationFeedbackData& feedback : pCompilation->m_Pipelines )
+            {
+                pipelineCount++;
+                feedbackCount += feedback.HasFeedback() ? 1 : 0;
+                cacheHitCount += feedback.IsCacheHit() ? 1 : 0;
+            }
+
+            timelineBeginTimestamp = std::min( timelineBeginTimestamp, pCompilation->m_BeginTimestamp );
+            timelineEndTimestamp = std::max( timelineEndTimestamp, pCompilation->m_EndTimestamp );
+            threadCompilations[ pCompilation->m_ThreadId ].push_back( pCompilation );
+        }
+
+        // Header
+        ImGui::Text( "%s: %.2f %s", Lang::CompilationTime, getCpuDuration( compilationTicks ), m_pTimestampDisplayUnitStr );
+        ImGuiX::TextAlignRight( "%s: %u, %s: %u / %u", Lang::Pipelines, pipelineCount, Lang::CacheHits, cacheHitCount, feedbackCount );
+
+        // Timeline of the compilations on each thread.
+        const float timelineDuration = static_cast<float>( std::max<uint64_t>( timelineEndTimestamp - timelineBeginTimestamp, 1 ) );
+        const ImU32 backgroundColor = ImGui::GetColorU32( ImGuiCol_FrameBg );
+        const ImU32 compilationColor = m_ComputePipelineColumnColor;
+        const ImU32 deferredCompilationColor = m_GraphicsPipelineColumnColor;
+
+        ImDrawList* pDrawList = ImGui::GetWindowDrawList();
+
+        for( const auto& [threadId, threadCompilationList] : threadCompilations )
+        {
+            ImGui::Text( "%s %u", Lang::Thread, threadId );
+
+            const ImVec2 timelinePos = ImGui::GetCursorScreenPos();
+            const ImVec2 timelineSize = { ImGui::GetContentRegionAvail().x, 8 * interfaceScale };
+            ImGui::Dummy( timelineSize );
+
+            pDrawList->AddRectFilled( timelinePos, { timelinePos.x + timelineSize.x, timelinePos.y + timelineSize.y }, backgroundColor );
+
+            for( const DeviceProfilerPipelineCompilationData* pCompilation : threadCompilationList )
+            {
+                const float beginOffset = ( pCompilation->m_BeginTimestamp - timelineBeginTimestamp ) / timelineDuration;
+                const float endOffset = ( pCompilation->m_EndTimestamp - timelineBeginTimestamp ) / timelineDuration;
+
+                // Keep very short compilations visible.
+                const ImVec2 rectMin = { timelinePos.x + beginOffset * timelineSize.x, timelinePos.y };
+                const ImVec2 rectMax = { std::max( timelinePos.x + endOffset * timelineSize.x, rectMin.x + 1 ), timelinePos.y + timelineSize.y };
+
+                pDrawList->AddRectFilled( rectMin, rectMax, pCompilation->m_Deferred ? deferredCompilationColor : compilationColor );
+
+                if( ImGui::IsMouseHoveringRect( rectMin, rectMax ) && ImGui::BeginTooltip() )
+                {
+                    for( const DeviceProfilerPipelineCreationFeedbackData& feedback : pCompilation->m_Pipelines )
+                    {
+                        ImGui::TextUnformatted( m_pStringSerializer->GetName( DeviceProfilerPipelineData( feedback.m_Pipeline ), false /*showEntryPoints*/ ).c_str() );
+                    }
+
+                    ImGui::Text( "%s: %.2f %s",
+                        Lang::Duration,
+                        getCpuDuration( pCompilation->m_EndTimestamp - pCompilation->m_BeginTimestamp ),
+                        m_pTimestampDisplayUnitStr );
+
+                    if( pCompilation->m_Deferred )
+                    {
+                        ImGui::TextUnformatted( Lang::Deferred );
+                    }
+
+                    ImGui::EndTooltip();
+                }
+            }
+        }
+
+        ImGui::SetCursorPosY( ImGui::GetCursorPosY() + 5 * interfaceScale );
+
+        // Table with the compiled pipelines.
+        if( ImGui::BeginTable( "PipelineCompilationTable", 5,
+                ImGuiTableFlags_Hideable |
+                ImGuiTableFlags_PadOuterX |
+                ImGuiTableFlags_NoClip ) )
+        {
+            ImGui::TableSetupColumn( Lang::Pipeline, ImGuiTableColumnFlags_WidthStretch | ImGuiTableColumnFlags_NoHide );
+            ImGui::TableSetupColumn( Lang::Thread, ImGuiTableColumnFlags_WidthFixed );
+            ImGuiX::TableSetupColumn( Lang::CompilationTime, ImGuiTableColumnFlags_WidthStretch, ImGuiXTableColumnFlags_AlignHeaderRight, 0.25f );
+            ImGuiX::TableSetupColumn( Lang::DriverTime, ImGuiTableColumnFlags_WidthStretch, ImGuiXTableColumnFlags_AlignHeaderRight, 0.25f );
+            ImGuiX::TableSetupColumn( Lang::CacheHits, ImGuiTableColumnFlags_WidthFixed, ImGuiXTableColumnFlags_AlignHeaderRight );
+            ImGuiX::TableHeadersRow( m_Resources.GetBoldFont() );
+
+            for( const DeviceProfilerPipelineCompilationData* pCompilation : compilations )
+            {
+                // Pipelines created in a single call share the same compilation time.
+                const float compilationDuration = getCpuDuration( pCompilation->m_EndTimestamp - pCompilation->m_BeginTimestamp );
+
+                for( const DeviceProfilerPipelineCreationFeedbackData& feedback : pCompilation->m_Pipelines )
+                {
+                    ImGui::TableNextRow();
+
+                    if( ImGui::TableNextColumn() )
+                    {
+                        ImGui::TextUnformatted( m_pStringSerializer->GetName( DeviceProfilerPipelineData( feedback.m_Pipeline ), false /*showEntryPoints*/ ).c_str() );
+                    }
+
+                    if( ImGui::TableNextColumn() )
+                    {
+                        ImGui::Text( "%u", pCompilation->m_ThreadId );
+                    }
+
+                    if( ImGui::TableNextColumn() )
+                    {
+                        ImGuiX::TextAlignRight( "%.2f %s", compilationDuration, m_pTimestampDisplayUnitStr );
+                    }
+
+                    if( ImGui::TableNextColumn() && feedback.HasFeedback() )
+                    {
+                        // Creation feedback durations are in nanoseconds.
+                        ImGuiX::TextAlignRight( "%.2f %s",
+                            static_cast<float>( feedback.m_Duration / 1'000'000.0 ) * m_TimestampDisplayUnit,
+                            m_pTimestampDisplayUnitStr );
+                    }
+
+                    if( ImGui::TableNextColumn() && feedback.HasFeedback() )
+                    {
+                        // All stages are loaded from the cache if the whole pipeline is found there.
+                        size_t stageCacheHitCount = feedback.IsCacheHit() ? feedback.m_Stages.size() : 0;
+                        if( !feedback.IsCacheHit() )
+                        {
+                            for( const DeviceProfilerPipelineCreationFeedbackData::Stage& stage : feedback.m_Stages )
+                            {
+                                if( stage.m_Flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT )
+                                {
+                                    stageCacheHitCount++;
+                                }
+                            }
+                        }
+
+                        ImGuiX::TextAlignRight( "%zu / %zu", stageCacheHitCount, feedback.m_Stages.size() );
+                    }
+                }
+            }
+
+            ImGui::EndTable();
+        }
+    }
+
+    /***********************************************************************************\
+
     Function:
         UpdatePerformanceCountersTab
 
@@ -2182,8 +2747,10 @@ namespace Profiler
         {
             for( const auto& submit : submitBatch.m_Submits )
             {
-                for( const auto& commandBuffer : submit.m_CommandBuffers )
+                for( const auto& pCommandBuffer : submit.m_CommandBuffers )
                 {
+                    const DeviceProfilerCommandBufferData& commandBuffer = *pCommandBuffer;
+
                     if( (performanceQueryResultsFiltered == false) &&
                         (commandBuffer.m_Handle != VK_NULL_HANDLE) &&
                         (commandBuffer.m_Handle == m_PerformanceQueryCommandBufferFilter) )
@@ -3686,13 +4253,16 @@ namespace Profiler
         std::shared_ptr<DeviceProfilerFrameData> pRestoreData =
             std::exchange( m_pData, GetFrameData( m_MemoryCompareSelFrameIndex ) );
 
+        // Allocations and resources at the end of the selected frame.
+        const DeviceProfilerMemorySnapshotData& memorySnapshot = GetMemorySnapshot( m_pData );
+
         // Compare memory usage in the selected frames and get the results.
         const DeviceProfilerMemoryComparisonResults& memoryComparisonResults = m_MemoryComparator.GetResults();
 
         auto GetBufferMemoryData = [&]( VkBufferHandle buffer )
         {
-            auto currentBufferData = m_pData->m_Memory.m_Buffers.find( buffer );
-            if( currentBufferData != m_pData->m_Memory.m_Buffers.end() )
+            auto currentBufferData = memorySnapshot.m_Buffers.find( buffer );
+            if( currentBufferData != memorySnapshot.m_Buffers.end() )
             {
                 return currentBufferData->second;
             }
@@ -4272,7 +4842,7 @@ namespace Profiler
                 };
 
                 // List all resources.
-                for( const auto& [buffer, data] : m_pData->m_Memory.m_Buffers )
+                for( const auto& [buffer, data] : memorySnapshot.m_Buffers )
                 {
                     DrawResourceBrowserBufferTableRow(
                         buffer,
@@ -4290,7 +4860,7 @@ namespace Profiler
                         ResourceCompareResult::eRemoved );
                 }
 
-                for( const auto& [image, data] : m_pData->m_Memory.m_Images )
+                for( const auto& [image, data] : memorySnapshot.m_Images )
                 {
                     DrawResourceBrowserImageTableRow(
                         image,
@@ -4308,7 +4878,7 @@ namespace Profiler
                         ResourceCompareResult::eRemoved );
                 }
 
-                for( const auto& [accelerationStructure, data] : m_pData->m_Memory.m_AccelerationStructures )
+                for( const auto& [accelerationStructure, data] : memorySnapshot.m_AccelerationStructures )
                 {
                     DrawResourceBrowserAccelerationStructureTableRow(
                         accelerationStructure,
@@ -4326,7 +4896,7 @@ namespace Profiler
                         ResourceCompareResult::eRemoved );
                 }
 
-                for( const auto& [micromap, data] : m_pData->m_Memory.m_Micromaps )
+                for( const auto& [micromap, data] : memorySnapshot.m_Micromaps )
                 {
                     DrawResourceBrowserMicromapTableRow(
                         micromap,
@@ -4391,6 +4961,27 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Function:
+        GetMemorySnapshot
+
+    Description:
+        Returns the allocations and resources at the end of the frame.
+        The state is rebuilt from the memory snapshot only when another frame is selected.
+
+    \***********************************************************************************/
+    const DeviceProfilerMemorySnapshotData& ProfilerOverlayOutput::GetMemorySnapshot( const std::shared_ptr<DeviceProfilerFrameData>& pData )
+    {
+        if( m_pMemorySnapshotFrameData != pData )
+        {
+            m_pMemorySnapshot = DeviceProfilerMemoryHistory::GetFrameSnapshot( pData->m_Memory );
+            m_pMemorySnapshotFrameData = pData;
+        }
+
+        return *m_pMemorySnapshot;
+    }
+
+    /***********************************************************************************\
+
     Function:
         ResetResourceInspector
 
@@ -4427,7 +5018,7 @@ namespace Profiler
         const DeviceProfilerAccelerationStructureMemoryData& accelerationStructureData,
         const DeviceProfilerBufferMemoryData& bufferData )
     {
-        if( !m_pData->m_Memory.m_AccelerationStructures.count( accelerationStructure ) )
+        if( !GetMemorySnapshot( m_pData ).m_AccelerationStructures.count( accelerationStructure ) )
         {
             // Buffer data not found.
             ImGui::Text( "'%s' at 0x%016" PRIx64 " does not exist in the current frame.\n"
@@ -4483,7 +5074,7 @@ namespace Profiler
         const DeviceProfilerMicromapMemoryData& micromapData,
         const DeviceProfilerBufferMemoryData& bufferData )
     {
-        if( !m_pData->m_Memory.m_Micromaps.count( micromap ) )
+        if( !GetMemorySnapshot( m_pData ).m_Micromaps.count( micromap ) )
         {
             // Buffer data not found.
             ImGui::Text( "'%s' at 0x%016" PRIx64 " does not exist in the current frame.\n"
@@ -4538,7 +5129,9 @@ namespace Profiler
         VkBufferHandle buffer,
         const DeviceProfilerBufferMemoryData& bufferData )
     {
-        if( !m_pData->m_Memory.m_Buffers.count( buffer ) )
+        const DeviceProfilerMemorySnapshotData& memorySnapshot = GetMemorySnapshot( m_pData );
+
+        if( !memorySnapshot.m_Buffers.count( buffer ) )
         {
             // Buffer data not found.
             ImGui::Text( "'%s' at 0x%016" PRIx64 " does not exist in the current frame.\n"
@@ -4608,8 +5201,8 @@ namespace Profiler
                     ImGui::Text( "%" PRIu64 "   ", binding.m_Size );
                 }
 
-                auto allocationIt = m_pData->m_Memory.m_Allocations.find( binding.m_Memory );
-                if( allocationIt != m_pData->m_Memory.m_Allocations.end() )
+                auto allocationIt = memorySnapshot.m_Allocations.find( binding.m_Memory );
+                if( allocationIt != memorySnapshot.m_Allocations.end() )
                 {
                     const DeviceProfilerDeviceMemoryData& memoryData = allocationIt->second;
                     const VkMemoryPropertyFlags memoryPropertyFlags = memoryProperties.memoryTypes[memoryData.m_TypeIndex].propertyFlags;
@@ -4647,7 +5240,9 @@ namespace Profiler
         VkImageHandle image,
         const DeviceProfilerImageMemoryData& imageData )
     {
-        if( !m_pData->m_Memory.m_Images.count( image ) )
+        const DeviceProfilerMemorySnapshotData& memorySnapshot = GetMemorySnapshot( m_pData );
+
+        if( !memorySnapshot.m_Images.count( image ) )
         {
             // Buffer data not found.
             ImGui::Text( "'%s' at 0x%016" PRIx64 " does not exist in the current frame.\n"
@@ -4812,8 +5407,8 @@ namespace Profiler
                     }
                 }
 
-                auto allocationIt = m_pData->m_Memory.m_Allocations.find( memory );
-                if( allocationIt != m_pData->m_Memory.m_Allocations.end() )
+                auto allocationIt = memorySnapshot.m_Allocations.find( memory );
+                if( allocationIt != memorySnapshot.m_Allocations.end() )
                 {
                     const DeviceProfilerDeviceMemoryData& memoryData = allocationIt->second;
                     const VkMemoryPropertyFlags memoryPropertyFlags = memoryProperties.memoryTypes[memoryData.m_TypeIndex].propertyFlags;
@@ -5211,6 +5806,9 @@ namespace Profiler
 
         if( serializer.Open( fileName ) )
         {
+            const std::shared_ptr<const DeviceProfilerMemorySnapshotData> pSnapshot =
+                DeviceProfilerMemoryHistory::GetFrameSnapshot( pData->m_Memory );
+
             std::vector<std::string> row;
             std::vector<std::string> columns;
             const auto& memoryProperties = m_Frontend.GetPhysicalDeviceMemoryProperties();
@@ -5222,7 +5820,7 @@ namespace Profiler
             };
 
             // Dump buffers.
-            if( !pData->m_Memory.m_Buffers.empty() )
+            if( !pSnapshot->m_Buffers.empty() )
             {
                 columns = {
                     "VkBuffer",
@@ -5246,7 +5844,7 @@ namespace Profiler
                 };
                 serializer.WriteHeader( columns );
 
-                for( const auto& [bufferHandle, buffer] : pData->m_Memory.m_Buffers )
+                for( const auto& [bufferHandle, buffer] : pSnapshot->m_Buffers )
                 {
                     const std::string bufferName = m_pStringSerializer->GetName( bufferHandle );
                     if( !FilterResourceByNameAndUsage( bufferName, buffer.m_BufferUsage, bufferUsageFilter ) )
@@ -5281,8 +5879,8 @@ namespace Profiler
                             row.push_back( fmt::format( "{}", binding.m_BufferOffset ) );
                             row.push_back( fmt::format( "{}", binding.m_Size ) );
 
-                            auto memoryAllocationIt = pData->m_Memory.m_Allocations.find( binding.m_Memory );
-                            if( memoryAllocationIt != pData->m_Memory.m_Allocations.end() )
+                            auto memoryAllocationIt = pSnapshot->m_Allocations.find( binding.m_Memory );
+                            if( memoryAllocationIt != pSnapshot->m_Allocations.end() )
                             {
                                 const auto& memoryData = memoryAllocationIt->second;
                                 row.push_back( fmt::format( "{}", memoryData.m_HeapIndex ) );
@@ -5304,7 +5902,7 @@ namespace Profiler
             }
 
             // Dump images.
-            if( !pData->m_Memory.m_Images.empty() )
+            if( !pSnapshot->m_Images.empty() )
             {
                 columns = {
                     "VkImage",
@@ -5346,7 +5944,7 @@ namespace Profiler
                 };
                 serializer.WriteHeader( columns );
 
-                for( const auto& [imageHandle, image] : pData->m_Memory.m_Images )
+                for( const auto& [imageHandle, image] : pSnapshot->m_Images )
                 {
                     const std::string imageName = m_pStringSerializer->GetName( imageHandle );
                     if( !FilterResourceByNameAndUsage( imageName, image.m_ImageUsage, imageUsageFilter ) )
@@ -5414,8 +6012,8 @@ namespace Profiler
 
                             if( memory != VK_NULL_HANDLE )
                             {
-                                auto memoryAllocationIt = pData->m_Memory.m_Allocations.find( memory );
-                                if( memoryAllocationIt != pData->m_Memory.m_Allocations.end() )
+                                auto memoryAllocationIt = pSnapshot->m_Allocations.find( memory );
+                                if( memoryAllocationIt != pSnapshot->m_Allocations.end() )
                                 {
                                     const auto& memoryData = memoryAllocationIt->second;
                                     row.push_back( fmt::format( "{}", memoryData.m_HeapIndex ) );
@@ -5438,7 +6036,7 @@ namespace Profiler
             }
 
             // Dump acceleration structures.
-            if( !pData->m_Memory.m_AccelerationStructures.empty() )
+            if( !pSnapshot->m_AccelerationStructures.empty() )
             {
                 columns = {
                     "VkAccelerationStructureKHR",
@@ -5451,7 +6049,7 @@ namespace Profiler
                 };
                 serializer.WriteHeader( columns );
 
-                for( const auto& [accelerationStructureHandle, accelerationStructure] : pData->m_Memory.m_AccelerationStructures )
+                for( const auto& [accelerationStructureHandle, accelerationStructure] : pSnapshot->m_AccelerationStructures )
                 {
                     // Acceleration structure types are a simple enum, convert to bitmask for filtering.
                     VkFlags accelerationStructureTypeBit = ( 1U << accelerationStructure.m_Type );
@@ -5477,7 +6075,7 @@ namespace Profiler
             }
 
             // Dump micromaps.
-            if( !pData->m_Memory.m_Micromaps.empty() )
+            if( !pSnapshot->m_Micromaps.empty() )
             {
                 columns = {
                     "VkMicromapEXT",
@@ -5490,7 +6088,7 @@ namespace Profiler
                 };
                 serializer.WriteHeader( columns );
 
-                for( const auto& [micromapHandle, micromap] : pData->m_Memory.m_Micromaps )
+                for( const auto& [micromapHandle, micromap] : pSnapshot->m_Micromaps )
                 {
                     // Micromap types are a simple enum, convert to bitmask for filtering.
                     VkFlags micromapTypeBit = ( 1U << micromap.m_Type );
@@ -5635,7 +6233,7 @@ namespace Profiler
                 shader.m_pShaderModule->m_Identifier );
 
             const auto& bytecode = shader.m_pShaderModule->m_Bytecode;
-            m_InspectorShaderView.AddBytecode( bytecode.data(), bytecode.size() );
+            m_InspectorShaderView.AddBytecode( shader.m_pShaderModule->m_Hash, bytecode.data(), bytecode.size() );
         }
 
         // Enumerate shader internal representations associated with the selected stage.
@@ -6400,7 +6998,20 @@ namespace Profiler
                     // Total duration
                     if( ImGui::TableNextColumn() )
                     {
-                        PrintStatsDuration( stats, stats.m_TicksSum );
+                        if( stats.m_SkippedSampleCount > 0 )
+                        {
+                            // Some commands were not sampled, print the estimated duration with 95% confidence interval.
+                            ImGuiX::TextAlignRight(
+                                ImGuiX::TableGetColumnWidth(),
+                                "~%.2f +/- %.2f %s",
+                                m_TimestampDisplayUnit * stats.GetEstimatedTicksSum() * m_TimestampPeriod.count(),
+                                m_TimestampDisplayUnit * stats.GetEstimatedTicksSumError() * m_TimestampPeriod.count(),
+                                m_pTimestampDisplayUnitStr );
+                        }
+                        else
+                        {
+                            PrintStatsDuration( stats, stats.m_TicksSum );
+                        }
                     }
 
                     // Min duration
@@ -6440,59 +7051,371 @@ namespace Profiler
 
                 ImGui::PushFont( m_Resources.GetBoldFont() );
                 ImGui::TableNextColumn();
-                ImGui::TextUnformatted( Lang::StatName );
+                ImGui::TextUnformatted( Lang::StatName );
+                ImGui::TableNextColumn();
+                ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), Lang::StatCount );
+                ImGui::TableNextColumn();
+                ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), Lang::StatTotal );
+                ImGui::TableNextColumn();
+                ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), Lang::StatMin );
+                ImGui::TableNextColumn();
+                ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), Lang::StatMax );
+                ImGui::TableNextColumn();
+                ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), Lang::StatAvg );
+                ImGui::PopFont();
+
+                PrintStats( Lang::DrawCalls, m_pData->m_Stats.m_DrawStats );
+                PrintStats( Lang::DrawCallsIndirect, m_pData->m_Stats.m_DrawIndirectStats );
+                PrintStats( Lang::DrawMeshTasksCalls, m_pData->m_Stats.m_DrawMeshTasksStats );
+                PrintStats( Lang::DrawMeshTasksIndirectCalls, m_pData->m_Stats.m_DrawMeshTasksIndirectStats );
+                PrintStats( Lang::DispatchCalls, m_pData->m_Stats.m_DispatchStats );
+                PrintStats( Lang::DispatchCallsIndirect, m_pData->m_Stats.m_DispatchIndirectStats );
+                PrintStats( Lang::TraceRaysCalls, m_pData->m_Stats.m_TraceRaysStats );
+                PrintStats( Lang::TraceRaysIndirectCalls, m_pData->m_Stats.m_TraceRaysIndirectStats );
+                PrintStats( Lang::CopyBufferCalls, m_pData->m_Stats.m_CopyBufferStats );
+                PrintStats( Lang::CopyBufferToImageCalls, m_pData->m_Stats.m_CopyBufferToImageStats );
+                PrintStats( Lang::CopyImageCalls, m_pData->m_Stats.m_CopyImageStats );
+                PrintStats( Lang::CopyImageToBufferCalls, m_pData->m_Stats.m_CopyImageToBufferStats );
+                PrintStats( Lang::PipelineBarriers, m_pData->m_Stats.m_PipelineBarrierStats );
+                PrintStats( Lang::ColorClearCalls, m_pData->m_Stats.m_ClearColorStats );
+                PrintStats( Lang::DepthStencilClearCalls, m_pData->m_Stats.m_ClearDepthStencilStats );
+                PrintStats( Lang::ResolveCalls, m_pData->m_Stats.m_ResolveStats );
+                PrintStats( Lang::BlitCalls, m_pData->m_Stats.m_BlitImageStats );
+                PrintStats( Lang::FillBufferCalls, m_pData->m_Stats.m_FillBufferStats );
+                PrintStats( Lang::UpdateBufferCalls, m_pData->m_Stats.m_UpdateBufferStats );
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+
+                if( m_ShowEmptyStatistics )
+                {
+                    if( ImGui::TextLink( Lang::HideEmptyStatistics ) )
+                    {
+                        m_ShowEmptyStatistics = false;
+                    }
+                }
+                else
+                {
+                    if( ImGui::TextLink( Lang::ShowEmptyStatistics ) )
+                    {
+                        m_ShowEmptyStatistics = true;
+                    }
+                }
+
+                ImGui::EndTable();
+            }
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        UpdateMemoryEventsTab
+
+    Description:
+        Updates "Memory events" tab.
+
+    \***********************************************************************************/
+    void ProfilerOverlayOutput::UpdateMemoryEventsTab()
+    {
+        const DeviceProfilerConfig& config = m_Frontend.GetProfilerConfig();
+        if( !config.m_EnableMemoryProfiling || !config.m_EnableMemoryEventLog )
+        {
+            ImGui::TextUnformatted( Lang::MemoryEventLogDisabled );
+            return;
+        }
+
+        const DeviceProfilerMemoryData& memory = m_pData->m_Memory;
+
+        if( memory.m_DroppedEventCount > 0 )
+        {
+            ImGui::PushStyleColor( ImGuiCol_Text, IM_COL32( 255, 0, 0, 255 ) );
+            ImGui::Text( "%" PRIu64 " %s", memory.m_DroppedEventCount, Lang::MemoryEventsDropped );
+            ImGui::PopStyleColor();
+        }
+
+        // Number and size of the events logged in the selected frame.
+        if( ImGui::BeginTable( "##MemoryChurnTable", 3,
+                ImGuiTableFlags_BordersInnerH |
+                ImGuiTableFlags_PadOuterX |
+                ImGuiTableFlags_NoClip |
+                ImGuiTableFlags_SizingStretchProp ) )
+        {
+            ImGui::TableSetupColumn( Lang::MemoryEventChurn, ImGuiTableColumnFlags_NoHide, 3.0f );
+            ImGui::TableSetupColumn( Lang::MemoryEventCount, 0, 1.0f );
+            ImGui::TableSetupColumn( Lang::MemoryEventSize, 0, 1.0f );
+            ImGui::TableNextRow();
+
+            ImGui::PushFont( m_Resources.GetBoldFont() );
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted( Lang::MemoryEventChurn );
+            ImGui::TableNextColumn();
+            ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), Lang::MemoryEventCount );
+            ImGui::TableNextColumn();
+            ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), Lang::MemoryEventSize );
+            ImGui::PopFont();
+
+            auto PrintChurn = [&]( const char* pName, uint64_t count, uint64_t size )
+                {
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted( pName );
+                    ImGui::TableNextColumn();
+                    ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), "%" PRIu64, count );
+                    ImGui::TableNextColumn();
+                    ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), "%s", m_pStringSerializer->GetByteSize( size ).c_str() );
+                };
+
+            PrintChurn( Lang::MemoryEventAllocate, memory.m_Churn.m_AllocationCount, memory.m_Churn.m_AllocationSize );
+            PrintChurn( Lang::MemoryEventFree, memory.m_Churn.m_FreeCount, memory.m_Churn.m_FreeSize );
+            PrintChurn( Lang::MemoryEventBind, memory.m_Churn.m_BindCount, memory.m_Churn.m_BindSize );
+            PrintChurn( Lang::MemoryEventUnbind, memory.m_Churn.m_UnbindCount, memory.m_Churn.m_UnbindSize );
+            ImGui::EndTable();
+        }
+
+        ImGui::Spacing();
+
+        // Occupancy of the allocations at the end of the frame selected from the history.
+        if( m_MemoryHistory.IsEmpty() )
+        {
+            return;
+        }
+
+        const uint32_t firstFrameIndex = m_MemoryHistory.GetFirstFrameIndex();
+        const uint32_t lastFrameIndex = m_MemoryHistory.GetLastFrameIndex();
+
+        if( m_MemoryHistoryFollowLatest )
+        {
+            m_MemoryHistoryFrameIndex = lastFrameIndex;
+        }
+
+        m_MemoryHistoryFrameIndex = std::clamp( m_MemoryHistoryFrameIndex, firstFrameIndex, lastFrameIndex );
+
+        ImGui::PushFont( m_Resources.GetBoldFont() );
+        ImGui::TextUnformatted( Lang::MemoryFragmentation );
+        ImGui::PopFont();
+
+        int frameIndex = static_cast<int>( m_MemoryHistoryFrameIndex );
+        if( ImGui::SliderInt( Lang::MemoryHistoryFrame, &frameIndex, static_cast<int>( firstFrameIndex ), static_cast<int>( lastFrameIndex ) ) )
+        {
+            m_MemoryHistoryFrameIndex = static_cast<uint32_t>( frameIndex );
+            m_MemoryHistoryFollowLatest = ( m_MemoryHistoryFrameIndex == lastFrameIndex );
+        }
+
+        ImGui::SameLine();
+        ImGui::Checkbox( Lang::MemoryHistoryFollowLatest, &m_MemoryHistoryFollowLatest );
+
+        const DeviceProfilerMemoryHistoryState* pState = m_MemoryHistory.GetState( m_MemoryHistoryFrameIndex );
+        if( !pState )
+        {
+            return;
+        }
+
+        // Show the most fragmented allocations first.
+        std::vector<std::pair<VkDeviceMemoryHandle, DeviceProfilerMemoryFragmentationData>> allocations;
+        allocations.reserve( pState->m_Allocations.size() );
+
+        for( const auto& [deviceMemory, allocation] : pState->m_Allocations )
+        {
+            allocations.emplace_back( deviceMemory, pState->GetFragmentation( deviceMemory ) );
+        }
+
+        std::sort( allocations.begin(), allocations.end(),
+            []( const auto& a, const auto& b )
+            {
+                return a.second.m_Fragmentation > b.second.m_Fragmentation;
+            } );
+
+        if( ImGui::BeginTable( "##MemoryFragmentationTable", 8,
+                ImGuiTableFlags_BordersInnerH |
+                ImGuiTableFlags_PadOuterX |
+                ImGuiTableFlags_ScrollY |
+                ImGuiTableFlags_SizingStretchProp ) )
+        {
+            ImGui::TableSetupScrollFreeze( 0, 1 );
+            ImGui::TableSetupColumn( Lang::MemoryAllocation, ImGuiTableColumnFlags_NoHide, 3.0f );
+            ImGui::TableSetupColumn( Lang::MemoryHeap, 0, 0.5f );
+            ImGui::TableSetupColumn( Lang::MemoryEventSize, 0, 1.0f );
+            ImGui::TableSetupColumn( Lang::MemoryBoundSize, 0, 1.0f );
+            ImGui::TableSetupColumn( Lang::MemoryFreeSize, 0, 1.0f );
+            ImGui::TableSetupColumn( Lang::MemoryLargestFreeBlock, 0, 1.0f );
+            ImGui::TableSetupColumn( Lang::MemoryFreeBlocks, 0, 1.0f );
+            ImGui::TableSetupColumn( Lang::MemoryFragmentation, 0, 1.0f );
+            ImGuiX::TableHeadersRow( m_Resources.GetBoldFont() );
+
+            for( const auto& [deviceMemory, fragmentation] : allocations )
+            {
+                const DeviceProfilerDeviceMemoryData& allocation = pState->m_Allocations.at( deviceMemory );
+
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted( m_pStringSerializer->GetName( deviceMemory ).c_str() );
+                ImGui::TableNextColumn();
+                ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), "%u", allocation.m_HeapIndex );
+                ImGui::TableNextColumn();
+                ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), "%s", m_pStringSerializer->GetByteSize( allocation.m_Size ).c_str() );
                 ImGui::TableNextColumn();
-                ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), Lang::StatCount );
+                ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), "%s", m_pStringSerializer->GetByteSize( fragmentation.m_BoundSize ).c_str() );
                 ImGui::TableNextColumn();
-                ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), Lang::StatTotal );
+                ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), "%s", m_pStringSerializer->GetByteSize( fragmentation.m_FreeSize ).c_str() );
                 ImGui::TableNextColumn();
-                ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), Lang::StatMin );
+                ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), "%s", m_pStringSerializer->GetByteSize( fragmentation.m_LargestFreeBlockSize ).c_str() );
                 ImGui::TableNextColumn();
-                ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), Lang::StatMax );
+                ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), "%" PRIu64, fragmentation.m_FreeBlockCount );
                 ImGui::TableNextColumn();
-                ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), Lang::StatAvg );
-                ImGui::PopFont();
+                ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), "%.2f %%", 100.f * fragmentation.m_Fragmentation );
+            }
 
-                PrintStats( Lang::DrawCalls, m_pData->m_Stats.m_DrawStats );
-                PrintStats( Lang::DrawCallsIndirect, m_pData->m_Stats.m_DrawIndirectStats );
-                PrintStats( Lang::DrawMeshTasksCalls, m_pData->m_Stats.m_DrawMeshTasksStats );
-                PrintStats( Lang::DrawMeshTasksIndirectCalls, m_pData->m_Stats.m_DrawMeshTasksIndirectStats );
-                PrintStats( Lang::DispatchCalls, m_pData->m_Stats.m_DispatchStats );
-                PrintStats( Lang::DispatchCallsIndirect, m_pData->m_Stats.m_DispatchIndirectStats );
-                PrintStats( Lang::TraceRaysCalls, m_pData->m_Stats.m_TraceRaysStats );
-                PrintStats( Lang::TraceRaysIndirectCalls, m_pData->m_Stats.m_TraceRaysIndirectStats );
-                PrintStats( Lang::CopyBufferCalls, m_pData->m_Stats.m_CopyBufferStats );
-                PrintStats( Lang::CopyBufferToImageCalls, m_pData->m_Stats.m_CopyBufferToImageStats );
-                PrintStats( Lang::CopyImageCalls, m_pData->m_Stats.m_CopyImageStats );
-                PrintStats( Lang::CopyImageToBufferCalls, m_pData->m_Stats.m_CopyImageToBufferStats );
-                PrintStats( Lang::PipelineBarriers, m_pData->m_Stats.m_PipelineBarrierStats );
-                PrintStats( Lang::ColorClearCalls, m_pData->m_Stats.m_ClearColorStats );
-                PrintStats( Lang::DepthStencilClearCalls, m_pData->m_Stats.m_ClearDepthStencilStats );
-                PrintStats( Lang::ResolveCalls, m_pData->m_Stats.m_ResolveStats );
-                PrintStats( Lang::BlitCalls, m_pData->m_Stats.m_BlitImageStats );
-                PrintStats( Lang::FillBufferCalls, m_pData->m_Stats.m_FillBufferStats );
-                PrintStats( Lang::UpdateBufferCalls, m_pData->m_Stats.m_UpdateBufferStats );
+            ImGui::EndTable();
+        }
+    }
+
+    /***********************************************************************************\
 
+    Function:
+        UpdateProfilerOverheadTab
+
+    Description:
+        Updates "Profiler overhead" tab.
+
+    \***********************************************************************************/
+    void ProfilerOverlayOutput::UpdateProfilerOverheadTab()
+    {
+        const DeviceProfilerOverheadData& overhead = m_pData->m_Overhead;
+
+        auto BeginOverheadTable = [&]( const char* pId, const char* pHeader, const char* pValueHeader, const char* pShareHeader )
+            {
+                if( !ImGui::BeginTable( pId, 3,
+                        ImGuiTableFlags_BordersInnerH |
+                        ImGuiTableFlags_PadOuterX |
+                        ImGuiTableFlags_NoClip |
+                        ImGuiTableFlags_SizingStretchProp ) )
+                {
+                    return false;
+                }
+
+                ImGui::TableSetupColumn( pHeader, ImGuiTableColumnFlags_NoHide, 3.0f );
+                ImGui::TableSetupColumn( pValueHeader, 0, 1.0f );
+                ImGui::TableSetupColumn( pShareHeader, 0, 1.0f );
                 ImGui::TableNextRow();
+
+                ImGui::PushFont( m_Resources.GetBoldFont() );
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted( pHeader );
                 ImGui::TableNextColumn();
+                ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), pValueHeader );
+                ImGui::TableNextColumn();
+                ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), pShareHeader );
+                ImGui::PopFont();
+                return true;
+            };
 
-                if( m_ShowEmptyStatistics )
+        auto PrintShare = [&]( uint64_t value, uint64_t total )
+            {
+                if( total > 0 )
                 {
-                    if( ImGui::TextLink( Lang::HideEmptyStatistics ) )
-                    {
-                        m_ShowEmptyStatistics = false;
-                    }
+                    ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), "%.2f %%", ( 100.0 * value ) / total );
                 }
                 else
                 {
-                    if( ImGui::TextLink( Lang::ShowEmptyStatistics ) )
-                    {
-                        m_ShowEmptyStatistics = true;
-                    }
+                    ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), "-" );
                 }
+            };
 
-                ImGui::EndTable();
-            }
+        // CPU time spent in the layer since the previous frame, in nanoseconds.
+        // The share is relative to the time elapsed since the previous frame.
+        auto PrintCpuTime = [&]( const char* pName, uint64_t time )
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted( pName );
+                ImGui::TableNextColumn();
+                ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), "%.2f %s",
+                    m_TimestampDisplayUnit * static_cast<float>( time / 1'000'000.0 ),
+                    m_pTimestampDisplayUnitStr );
+                ImGui::TableNextColumn();
+                PrintShare( time, overhead.m_CpuMeasurementTime );
+            };
+
+        const DeviceProfilerConfig& config = m_Frontend.GetProfilerConfig();
+        if( !config.m_EnableOverheadAccounting && ( config.m_OverheadCpuTimeBudget <= 0 ) )
+        {
+            ImGui::TextUnformatted( Lang::OverheadCpuTimeDisabled );
+        }
+        else if( BeginOverheadTable( "##ProfilerOverheadCpuTable", Lang::OverheadCpuTime, Lang::StatTotal, Lang::OverheadShare ) )
+        {
+            PrintCpuTime( Lang::OverheadCommandRecording, overhead.GetCpuTime( DeviceProfilerCpuOverheadCategory::eCommandRecording ) );
+            PrintCpuTime( Lang::OverheadQueueSubmission, overhead.GetCpuTime( DeviceProfilerCpuOverheadCategory::eQueueSubmission ) );
+            PrintCpuTime( Lang::OverheadDataResolve, overhead.GetCpuTime( DeviceProfilerCpuOverheadCategory::eDataResolve ) );
+            PrintCpuTime( Lang::OverheadOutput, overhead.GetCpuTime( DeviceProfilerCpuOverheadCategory::eOutput ) );
+            PrintCpuTime( Lang::StatTotal, overhead.GetTotalCpuTime() );
+            ImGui::EndTable();
+        }
+
+        auto PrintMemorySize = [&]( const char* pName, uint64_t size, uint64_t total )
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted( pName );
+                ImGui::TableNextColumn();
+                ImGuiX::TextAlignRight( ImGuiX::TableGetColumnWidth(), "%.02f MB", size / 1048576.f );
+                ImGui::TableNextColumn();
+                PrintShare( size, total );
+            };
+
+        ImGui::Spacing();
+
+        if( BeginOverheadTable( "##ProfilerOverheadHostMemoryTable", Lang::OverheadHostMemory, Lang::OverheadSize, Lang::OverheadShare ) )
+        {
+            const uint64_t totalHostMemory = overhead.GetTotalHostMemory();
+            PrintMemorySize( Lang::OverheadFrameData, overhead.GetHostMemory( DeviceProfilerHostMemoryOverheadCategory::eFrameData ), totalHostMemory );
+            PrintMemorySize( Lang::OverheadMemorySnapshots, overhead.GetHostMemory( DeviceProfilerHostMemoryOverheadCategory::eMemorySnapshots ), totalHostMemory );
+            PrintMemorySize( Lang::OverheadShaderBytecode, overhead.GetHostMemory( DeviceProfilerHostMemoryOverheadCategory::eShaderBytecode ), totalHostMemory );
+            PrintMemorySize( Lang::OverheadPipelineCreateInfos, overhead.GetHostMemory( DeviceProfilerHostMemoryOverheadCategory::ePipelineCreateInfos ), totalHostMemory );
+            PrintMemorySize( Lang::StatTotal, totalHostMemory, totalHostMemory );
+            ImGui::EndTable();
+        }
+
+        if( config.m_EnableOverheadAccounting )
+        {
+            // Size of the command buffer data copied since the previous frame.
+            ImGui::Text( "%s: %.02f MB", Lang::OverheadCopiedFrameData, overhead.m_CopiedDataSize / 1048576.f );
+        }
+
+        ImGui::Spacing();
+
+        if( BeginOverheadTable( "##ProfilerOverheadGpuMemoryTable", Lang::OverheadGpuMemory, Lang::OverheadSize, Lang::OverheadShare ) )
+        {
+            const uint64_t totalGpuMemory = overhead.GetTotalGpuMemory();
+            PrintMemorySize( Lang::OverheadQueryPools, overhead.GetGpuMemory( DeviceProfilerGpuMemoryOverheadCategory::eQueryPools ), totalGpuMemory );
+            PrintMemorySize( Lang::OverheadQueryDataBuffers, overhead.GetGpuMemory( DeviceProfilerGpuMemoryOverheadCategory::eQueryDataBuffers ), totalGpuMemory );
+            PrintMemorySize( Lang::OverheadIndirectArguments, overhead.GetGpuMemory( DeviceProfilerGpuMemoryOverheadCategory::eIndirectArguments ), totalGpuMemory );
+            PrintMemorySize( Lang::StatTotal, totalGpuMemory, totalGpuMemory );
+            ImGui::EndTable();
+        }
+
+        ImGui::Spacing();
+
+        // Degradations applied after the configured budgets were exceeded.
+        ImGui::PushFont( m_Resources.GetBoldFont() );
+        ImGui::TextUnformatted( Lang::OverheadDegradations );
+        ImGui::PopFont();
+
+        if( overhead.m_Degradations == 0 )
+        {
+            ImGui::TextUnformatted( Lang::OverheadNoDegradations );
+        }
+        if( overhead.m_Degradations & VK_PROFILER_OVERHEAD_DEGRADATION_DATA_BUFFER_SIZE_REDUCED_BIT_EXT )
+        {
+            ImGui::BulletText( "%s", Lang::OverheadDataBufferSizeReduced );
+        }
+        if( overhead.m_Degradations & VK_PROFILER_OVERHEAD_DEGRADATION_INDIRECT_ARGUMENTS_DISABLED_BIT_EXT )
+        {
+            ImGui::BulletText( "%s", Lang::OverheadIndirectArgumentsDisabled );
+        }
+        if( overhead.m_Degradations & VK_PROFILER_OVERHEAD_DEGRADATION_SAMPLING_MODE_COARSENED_BIT_EXT )
+        {
+            ImGui::BulletText( "%s", Lang::OverheadSamplingModeCoarsened );
         }
     }
 
@@ -6671,8 +7594,10 @@ namespace Profiler
 
                     bool firstCommandBuffer = true;
 
-                    for( const auto& commandBuffer : submit.m_CommandBuffers )
+                    for( const auto& pCommandBuffer : submit.m_CommandBuffers )
                     {
+                        const DeviceProfilerCommandBufferData& commandBuffer = *pCommandBuffer;
+
                         if( !commandBuffer.m_DataValid )
                         {
                             // Take command buffers with no data into account.
@@ -6688,6 +7613,12 @@ namespace Profiler
                             idle.color = 0;
                             idle.userDataType = QueueGraphColumn::eIdle;
                             idle.userData = nullptr;
+
+                            // Idle time before the first command buffer is classified by the critical path analysis.
+                            if( firstCommandBuffer )
+                            {
+                                idle.submitData = &submit;
+                            }
                         }
 
                         if( firstCommandBuffer && !submit.m_WaitSemaphores.empty() )
@@ -6699,10 +7630,13 @@ namespace Profiler
                         QueueGraphColumn& column = columns.emplace_back();
                         column.x = GetDuration( commandBuffer );
                         column.y = 1;
-                        column.color = ImGuiX::ColorAlpha( m_GraphicsPipelineColumnColor, isActiveFrame ? 1.0f : 0.2f );
+                        column.color = ImGuiX::ColorAlpha(
+                            submit.m_CriticalPath ? m_CriticalPathColumnColor : m_GraphicsPipelineColumnColor,
+                            isActiveFrame ? 1.0f : 0.2f );
                         column.userDataType = QueueGraphColumn::eCommandBuffer;
                         column.userData = &commandBuffer;
                         column.nodeIndex = index;
+                        column.submitData = &submit;
 
                         lastTimestamp = commandBuffer.m_EndTimestamp.m_Value;
                         firstCommandBuffer = false;
@@ -6748,6 +7682,125 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Function:
+        GetCpuThreadGraphColumns
+
+    Description:
+        Enumerate columns for the CPU activity graphs of the application threads.
+        CPU timestamps are converted to the GPU time domain using the calibrated
+        timestamps of each frame, so frames without calibration data are skipped.
+
+    \***********************************************************************************/
+    void ProfilerOverlayOutput::GetCpuThreadGraphColumns( std::map<uint32_t, std::vector<QueueGraphColumn>>& columns ) const
+    {
+        const bool showActiveFrame = GetShowActiveFrame();
+        const FrameDataList& framesList = GetActiveFramesList();
+        std::shared_ptr<DeviceProfilerFrameData> pFirstFrame = showActiveFrame ? m_pData : framesList.front();
+        std::shared_ptr<DeviceProfilerFrameData> pLastFrame = showActiveFrame ? m_pData : framesList.back();
+
+        const uint64_t graphBeginTimestamp = pFirstFrame->m_BeginTimestamp;
+        const uint64_t graphEndTimestamp = pLastFrame->m_EndTimestamp;
+        const double timestampPeriodNs = static_cast<double>( m_TimestampPeriod.count() ) * 1'000'000.0;
+
+        std::map<uint32_t, uint64_t> lastTimestamps;
+
+        for( const auto& pFrame : framesList )
+        {
+            if( showActiveFrame && ( pFrame != m_pData ) )
+            {
+                continue;
+            }
+
+            const DeviceProfilerSynchronizationTimestamps& syncTimestamps = pFrame->m_SyncTimestamps;
+            if( ( syncTimestamps.m_HostCalibratedTimestamp == 0 ) ||
+                ( syncTimestamps.m_DeviceCalibratedTimestamp == 0 ) ||
+                ( timestampPeriodNs <= 0 ) )
+            {
+                continue;
+            }
+
+            const uint64_t hostTimestampFrequency = OSGetTimestampFrequency( syncTimestamps.m_HostTimeDomain );
+            if( hostTimestampFrequency == 0 )
+            {
+                continue;
+            }
+
+            const double hostToDeviceTicks = 1'000'000'000.0 / ( hostTimestampFrequency * timestampPeriodNs );
+
+            auto ToDeviceTimestamp = [&]( uint64_t hostTimestamp ) -> uint64_t {
+                const int64_t hostDelta = static_cast<int64_t>( hostTimestamp - syncTimestamps.m_HostCalibratedTimestamp );
+                const int64_t deviceTimestamp = static_cast<int64_t>( syncTimestamps.m_DeviceCalibratedTimestamp ) +
+                    static_cast<int64_t>( hostDelta * hostToDeviceTicks );
+                return std::clamp<uint64_t>( std::max<int64_t>( deviceTimestamp, 0 ), graphBeginTimestamp, graphEndTimestamp );
+            };
+
+            for( const DeviceProfilerCpuSpanData& span : pFrame->m_CPU.m_Spans )
+            {
+                const uint64_t beginTimestamp = ToDeviceTimestamp( span.m_BeginTimestamp );
+                const uint64_t endTimestamp = ToDeviceTimestamp( span.m_EndTimestamp );
+
+                auto [lastTimestampIt, _] = lastTimestamps.try_emplace( span.m_ThreadId, graphBeginTimestamp );
+                uint64_t& lastTimestamp = lastTimestampIt->second;
+
+                // Skip spans hidden by the previous spans of the thread (e.g., nested command buffer recording).
+                if( endTimestamp <= lastTimestamp )
+                {
+                    continue;
+                }
+
+                std::vector<QueueGraphColumn>& threadColumns = columns[ span.m_ThreadId ];
+                const uint64_t visibleBeginTimestamp = std::max( beginTimestamp, lastTimestamp );
+
+                if( visibleBeginTimestamp != lastTimestamp )
+                {
+                    QueueGraphColumn& idle = threadColumns.emplace_back();
+                    idle.x = GetDuration( lastTimestamp, visibleBeginTimestamp );
+                    idle.y = 1;
+                    idle.color = 0;
+                    idle.userDataType = QueueGraphColumn::eIdle;
+                    idle.userData = nullptr;
+                }
+
+                QueueGraphColumn& column = threadColumns.emplace_back();
+                column.x = GetDuration( visibleBeginTimestamp, endTimestamp );
+                column.y = 1;
+                column.userDataType = QueueGraphColumn::eCpuSpan;
+                column.userData = &span;
+
+                switch( span.m_Type )
+                {
+                case DeviceProfilerCpuSpanType::eCommandBufferRecording:
+                    column.color = m_CpuRecordingColumnColor;
+                    break;
+                case DeviceProfilerCpuSpanType::eQueueSubmit:
+                    column.color = m_CpuSubmitColumnColor;
+                    break;
+                case DeviceProfilerCpuSpanType::eQueuePresent:
+                    column.color = m_CpuPresentColumnColor;
+                    break;
+                }
+
+                lastTimestamp = endTimestamp;
+            }
+        }
+
+        for( auto& [threadId, threadColumns] : columns )
+        {
+            const uint64_t lastTimestamp = lastTimestamps[ threadId ];
+            if( lastTimestamp != graphEndTimestamp )
+            {
+                QueueGraphColumn& idle = threadColumns.emplace_back();
+                idle.x = GetDuration( lastTimestamp, graphEndTimestamp );
+                idle.y = 1;
+                idle.color = 0;
+                idle.userDataType = QueueGraphColumn::eIdle;
+                idle.userData = nullptr;
+            }
+        }
+    }
+
+    /***********************************************************************************\
+
     Function:
         GetQueueUtilization
 
@@ -6760,7 +7813,8 @@ namespace Profiler
         float utilization = 0.0f;
         for( const auto& column : columns )
         {
-            if( column.userDataType == QueueGraphColumn::eCommandBuffer )
+            if( ( column.userDataType == QueueGraphColumn::eCommandBuffer ) ||
+                ( column.userDataType == QueueGraphColumn::eCpuSpan ) )
             {
                 utilization += column.x * column.y;
             }
@@ -6881,8 +7935,10 @@ namespace Profiler
                     index.emplace_back( 0 );
 
                     // Enumerate command buffers in submit
-                    for( const auto& commandBuffer : submit.m_CommandBuffers )
+                    for( const auto& pCommandBuffer : submit.m_CommandBuffers )
                     {
+                        const DeviceProfilerCommandBufferData& commandBuffer = *pCommandBuffer;
+
                         // Insert idle time since last command buffer
                         if( m_HistogramShowIdle &&
                             ( pLastQueueTimestamp != nullptr ) &&
@@ -7019,7 +8075,7 @@ namespace Profiler
                 {
                     for( const auto& data : subpass.m_Data )
                     {
-                        GetPerformanceGraphColumns( std::get<DeviceProfilerCommandBufferData>( data ), index, columns );
+                        GetPerformanceGraphColumns( *std::get<DeviceProfilerCommandBufferDataPtr>( data ), index, columns );
                         index.back()++;
                     }
                 }
@@ -7036,7 +8092,7 @@ namespace Profiler
                             break;
 
                         case DeviceProfilerSubpassDataType::eCommandBuffer:
-                            GetPerformanceGraphColumns( std::get<DeviceProfilerCommandBufferData>( data ), index, columns );
+                            GetPerformanceGraphColumns( *std::get<DeviceProfilerCommandBufferDataPtr>( data ), index, columns );
                             break;
                         }
                         index.back()++;
@@ -8006,7 +9062,7 @@ namespace Profiler
 
         if( (now - m_SerializationFinishTimestamp) < 4s )
         {
-            const ImVec2 outputSize = m_Backend.GetRenderArea();
+            const ImVec2 outputSize = ImGui::GetIO().DisplaySize;
             const ImVec2 windowPos = {
                 static_cast<float>(outputSize.x - m_SerializationOutputWindowSize.width),
                 static_cast<float>(outputSize.y - m_SerializationOutputWindowSize.height) };
@@ -8054,6 +9110,92 @@ namespace Profiler
 
             m_SerializationWindowVisible = true;
         }
+
+        if( (now - m_HitchNotificationTimestamp) < 4s )
+        {
+            const ImVec2 outputSize = ImGui::GetIO().DisplaySize;
+
+            // Display hitches above the serialization output.
+            float windowPosY = outputSize.y;
+            if( m_SerializationWindowVisible && ((now - m_SerializationFinishTimestamp) < 4s) )
+            {
+                windowPosY -= static_cast<float>(m_SerializationOutputWindowSize.height);
+            }
+
+            const float fadeOutStep =
+                1.f - std::max( 0.f, std::min( 1.f,
+                                         duration_cast<milliseconds>(now - (m_HitchNotificationTimestamp + 3s)).count() / 1000.f ) );
+
+            ImGui::PushStyleVar( ImGuiStyleVar_Alpha, fadeOutStep );
+            ImGui::PushStyleColor( ImGuiCol_WindowBg, { 0.6f, 0.3f, 0, 1 } );
+
+            ImGui::SetNextWindowPos( { outputSize.x, windowPosY }, ImGuiCond_Always, { 1, 1 } );
+            ImGui::Begin( "Hitch Notification", nullptr,
+                ImGuiWindowFlags_NoMove |
+                    ImGuiWindowFlags_NoResize |
+                    ImGuiWindowFlags_NoTitleBar |
+                    ImGuiWindowFlags_NoCollapse |
+                    ImGuiWindowFlags_NoDocking |
+                    ImGuiWindowFlags_NoFocusOnAppearing |
+                    ImGuiWindowFlags_NoSavedSettings |
+                    ImGuiWindowFlags_AlwaysAutoResize );
+
+            ImGui::TextUnformatted( m_HitchNotificationMessage.c_str() );
+
+            ImGui::End();
+            ImGui::PopStyleColor();
+            ImGui::PopStyleVar();
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        UpdateHitchNotification
+
+    Description:
+        Prepare notification about the hitches detected in the frame.
+
+    \***********************************************************************************/
+    void ProfilerOverlayOutput::UpdateHitchNotification( const DeviceProfilerFrameData& data )
+    {
+        constexpr size_t maxDisplayedHitches = 5;
+        const size_t hitchCount = data.m_Hitches.size();
+        const float timestampPeriodMs = m_TimestampPeriod.count();
+
+        m_HitchNotificationMessage.clear();
+
+        for( size_t i = 0; i < std::min( hitchCount, maxDisplayedHitches ); ++i )
+        {
+            const DeviceProfilerHitchData& hitch = data.m_Hitches[i];
+            const std::string regionName = m_pStringSerializer->GetName( hitch, m_ShowEntryPoints );
+
+            char line[ 512 ];
+            snprintf( line, sizeof( line ), Lang::HitchDetectedFmt,
+                hitch.m_FrameIndex,
+                regionName.c_str(),
+                hitch.m_Ticks * timestampPeriodMs,
+                hitch.m_MeanTicks * timestampPeriodMs,
+                hitch.m_P99Ticks * timestampPeriodMs );
+
+            if( !m_HitchNotificationMessage.empty() )
+            {
+                m_HitchNotificationMessage += "\n";
+            }
+
+            m_HitchNotificationMessage += line;
+        }
+
+        if( hitchCount > maxDisplayedHitches )
+        {
+            char line[ 64 ];
+            snprintf( line, sizeof( line ), Lang::MoreHitchesFmt, hitchCount - maxDisplayedHitches );
+
+            m_HitchNotificationMessage += "\n";
+            m_HitchNotificationMessage += line;
+        }
+
+        m_HitchNotificationTimestamp = std::chrono::high_resolution_clock::now();
     }
 
     /***********************************************************************************\
@@ -8278,6 +9420,8 @@ namespace Profiler
             inRenderPassSubtree = ImGui::TreeNode( indexStr, "%s",
                 m_pStringSerializer->GetName( renderPass ).c_str() );
 
+            DrawPipelineStatisticsBadge( renderPass.m_PipelineStatistics );
+
             // Print duration next to the node
             PrintDuration( renderPass );
         }
@@ -8388,11 +9532,11 @@ namespace Profiler
             {
                 // Sort frame browser data
                 std::list<const DeviceProfilerSubpassData::Data*> pDataSorted =
-                    SortFrameBrowserData<DeviceProfilerCommandBufferData>( subpass.m_Data );
+                    SortFrameBrowserData<DeviceProfilerCommandBufferDataPtr>( subpass.m_Data );
 
                 for( const DeviceProfilerSubpassData::Data* pData : pDataSorted )
                 {
-                    PrintCommandBuffer( std::get<DeviceProfilerCommandBufferData>( *pData ), index );
+                    PrintCommandBuffer( *std::get<DeviceProfilerCommandBufferDataPtr>( *pData ), index );
                     index.back()++;
                 }
             }
@@ -8413,7 +9557,7 @@ namespace Profiler
                         break;
 
                     case DeviceProfilerSubpassDataType::eCommandBuffer:
-                        PrintCommandBuffer( std::get<DeviceProfilerCommandBufferData>( *pData ), index );
+                        PrintCommandBuffer( *std::get<DeviceProfilerCommandBufferDataPtr>( *pData ), index );
                         break;
                     }
                     index.back()++;
@@ -8471,6 +9615,8 @@ namespace Profiler
 
         if( !printPipelineInline )
         {
+            DrawPipelineStatisticsBadge( pipeline.m_PipelineStatistics );
+
             // Print duration next to the node
             PrintDuration( pipeline );
         }
@@ -8789,6 +9935,67 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Function:
+        DrawPipelineStatisticsBadge
+
+    Description:
+        Draws a badge with a tooltip listing the collected pipeline statistics.
+
+    \***********************************************************************************/
+    void ProfilerOverlayOutput::DrawPipelineStatisticsBadge( const DeviceProfilerPipelineStatistics& statistics )
+    {
+        if( statistics.m_Flags == 0 )
+        {
+            return;
+        }
+
+        ImGui::SameLine();
+        ImGuiX::BadgeUnformatted( IM_COL32( 25, 96, 133, 255 ), 5.f, "PS" );
+
+        if( ImGui::IsItemHovered( ImGuiHoveredFlags_ForTooltip ) )
+        {
+            if( ImGui::BeginTooltip() )
+            {
+                ImGui::PushFont( m_Resources.GetBoldFont() );
+                ImGui::TextUnformatted( Lang::PipelineStatistics );
+                ImGui::PopFont();
+
+                if( ImGui::BeginTable( "##PipelineStatisticsTable", 2 ) )
+                {
+                    auto PrintStatistic = [&]( VkQueryPipelineStatisticFlagBits flag, const char* pName, uint64_t value )
+                    {
+                        if( statistics.m_Flags & flag )
+                        {
+                            ImGui::TableNextRow();
+                            ImGui::TableNextColumn();
+                            ImGui::TextUnformatted( pName );
+                            ImGui::TableNextColumn();
+                            ImGuiX::TextAlignRight( "%llu", static_cast<unsigned long long>( value ) );
+                        }
+                    };
+
+                    PrintStatistic( VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT, Lang::InputAssemblyVertices, statistics.m_InputAssemblyVertices );
+                    PrintStatistic( VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT, Lang::InputAssemblyPrimitives, statistics.m_InputAssemblyPrimitives );
+                    PrintStatistic( VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT, Lang::VertexShaderInvocations, statistics.m_VertexShaderInvocations );
+                    PrintStatistic( VK_QUERY_PIPELINE_STATISTIC_TESSELLATION_CONTROL_SHADER_PATCHES_BIT, Lang::TessellationControlShaderPatches, statistics.m_TessellationControlShaderPatches );
+                    PrintStatistic( VK_QUERY_PIPELINE_STATISTIC_TESSELLATION_EVALUATION_SHADER_INVOCATIONS_BIT, Lang::TessellationEvaluationShaderInvocations, statistics.m_TessellationEvaluationShaderInvocations );
+                    PrintStatistic( VK_QUERY_PIPELINE_STATISTIC_GEOMETRY_SHADER_INVOCATIONS_BIT, Lang::GeometryShaderInvocations, statistics.m_GeometryShaderInvocations );
+                    PrintStatistic( VK_QUERY_PIPELINE_STATISTIC_GEOMETRY_SHADER_PRIMITIVES_BIT, Lang::GeometryShaderPrimitives, statistics.m_GeometryShaderPrimitives );
+                    PrintStatistic( VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT, Lang::ClippingInvocations, statistics.m_ClippingInvocations );
+                    PrintStatistic( VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT, Lang::ClippingPrimitives, statistics.m_ClippingPrimitives );
+                    PrintStatistic( VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT, Lang::FragmentShaderInvocations, statistics.m_FragmentShaderInvocations );
+                    PrintStatistic( VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT, Lang::ComputeShaderInvocations, statistics.m_ComputeShaderInvocations );
+
+                    ImGui::EndTable();
+                }
+
+                ImGui::EndTooltip();
+            }
+        }
+    }
+
+    /***********************************************************************************\
+
     Function:
         DrawPipelineStageBadge
 
@@ -25,17 +25,23 @@
 #include "profiler/profiler_helpers.h"
 #include "profiler/profiler_stat_comparators.h"
 #include "profiler_helpers/profiler_memory_comparator.h"
+#include "profiler_helpers/profiler_memory_history.h"
 #include "profiler_helpers/profiler_time_helpers.h"
 #include "profiler_overlay_backend.h"
+#include "profiler_overlay_refresh_limiter.h"
 #include "profiler_overlay_settings.h"
 #include "profiler_overlay_resources.h"
 #include "profiler_overlay_shader_view.h"
 #include <vulkan/vk_layer.h>
 #include <list>
+#include <map>
 #include <vector>
 #include <stack>
 #include <memory>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
 #include <functional>
 #include <regex>
 
@@ -82,6 +88,7 @@ namespace Profiler
         void LoadTopPipelinesFromFile( const std::string& );
 
         void SetMaxFrameCount( uint32_t maxFrameCount );
+        void SetFullscreen( bool fullscreen );
 
     private:
         OverlaySettings m_Settings;
@@ -161,6 +168,17 @@ namespace Profiler
 
         std::shared_ptr<DeviceProfilerFrameData> m_pData;
 
+        // Threaded UI construction state.
+        std::thread m_UIThread;
+        std::mutex m_UIThreadMutex;
+        std::condition_variable m_UIThreadCondition;
+        bool m_UIThreadExit;
+        bool m_UIFrameRequested;
+        std::atomic_uint32_t m_PendingUpdateCount;
+
+        // Limits the UI refresh rate when the overlay is rendered from the cached image.
+        OverlayRefreshLimiter m_UIRefreshLimiter;
+
         float m_Opacity;
         bool m_Pause;
         bool m_Fullscreen;
@@ -244,6 +262,15 @@ namespace Profiler
         std::vector<float> m_MemoryConsumptionHistory[VK_MAX_MEMORY_HEAPS];
         float m_MemoryConsumptionHistoryMax[VK_MAX_MEMORY_HEAPS];
 
+        // Allocations and resources at the end of the frame displayed in the memory tab.
+        std::shared_ptr<DeviceProfilerFrameData> m_pMemorySnapshotFrameData;
+        std::shared_ptr<const DeviceProfilerMemorySnapshotData> m_pMemorySnapshot;
+
+        // Memory events state.
+        DeviceProfilerMemoryHistory m_MemoryHistory;
+        uint32_t m_MemoryHistoryFrameIndex;
+        bool m_MemoryHistoryFollowLatest;
+
         std::string m_ResourceBrowserNameFilter;
         VkBufferUsageFlags m_ResourceBrowserBufferUsageFilter;
         VkImageUsageFlags m_ResourceBrowserImageUsageFilter;
@@ -352,12 +379,20 @@ namespace Profiler
         struct TraceExporter;
         std::unique_ptr<TraceExporter> m_pTraceExporter;
 
+        // Hitch notifications
+        std::string m_HitchNotificationMessage;
+        std::chrono::high_resolution_clock::time_point m_HitchNotificationTimestamp;
+
         // Performance graph colors
         uint32_t m_RenderPassColumnColor;
         uint32_t m_GraphicsPipelineColumnColor;
         uint32_t m_ComputePipelineColumnColor;
         uint32_t m_RayTracingPipelineColumnColor;
         uint32_t m_InternalPipelineColumnColor;
+        uint32_t m_CriticalPathColumnColor;
+        uint32_t m_CpuRecordingColumnColor;
+        uint32_t m_CpuSubmitColumnColor;
+        uint32_t m_CpuPresentColumnColor;
 
         std::unique_ptr<class DeviceProfilerStringSerializer> m_pStringSerializer;
 
@@ -385,23 +420,35 @@ namespace Profiler
         WindowState m_PerformanceWindowState;
         WindowState m_QueueUtilizationWindowState;
         WindowState m_TopPipelinesWindowState;
+        WindowState m_PipelineCompilationWindowState;
         WindowState m_PerformanceCountersWindowState;
         WindowState m_MemoryWindowState;
+        WindowState m_MemoryEventsWindowState;
         WindowState m_InspectorWindowState;
         WindowState m_StatisticsWindowState;
+        WindowState m_ProfilerOverheadWindowState;
         WindowState m_SettingsWindowState;
 
         void ResetMembers();
 
         void InitializeImGuiStyle();
 
+        void UpdateData();
+        void BuildFrame();
+        void PresentThreaded();
+        bool IsUIRefreshRequired( const ImDrawData* pDrawData );
+        void UIThreadProc();
+
         void UpdatePerformanceTab();
         void UpdateQueueUtilizationTab();
         void UpdateTopPipelinesTab();
+        void UpdatePipelineCompilationTab();
         void UpdatePerformanceCountersTab();
         void UpdateMemoryTab();
+        void UpdateMemoryEventsTab();
         void UpdateInspectorTab();
         void UpdateStatisticsTab();
+        void UpdateProfilerOverheadTab();
         void UpdateSettingsTab();
 
         // Performance graph helpers
@@ -416,6 +463,7 @@ namespace Profiler
 
         struct QueueGraphColumn;
         void GetQueueGraphColumns( VkQueue, std::vector<QueueGraphColumn>& ) const;
+        void GetCpuThreadGraphColumns( std::map<uint32_t, std::vector<QueueGraphColumn>>& ) const;
         float GetQueueUtilization( const std::vector<QueueGraphColumn>& ) const;
         void DrawQueueGraphLabel( const ImGuiX::HistogramColumnData& );
         void SelectQueueGraphColumn( const ImGuiX::HistogramColumnData& );
@@ -444,9 +492,11 @@ namespace Profiler
 
         // Notifications
         void UpdateNotificationWindow();
+        void UpdateHitchNotification( const DeviceProfilerFrameData& );
         void UpdateApplicationInfoWindow();
 
         // Resource inspector helpers
+        const DeviceProfilerMemorySnapshotData& GetMemorySnapshot( const std::shared_ptr<DeviceProfilerFrameData>& );
         void ResetResourceInspector();
         void DrawResourceInspectorAccelerationStructureInfo( VkAccelerationStructureKHRHandle, const DeviceProfilerAccelerationStructureMemoryData&, const DeviceProfilerBufferMemoryData& );
         void DrawResourceInspectorMicromapInfo( VkMicromapEXTHandle, const DeviceProfilerMicromapMemoryData&, const DeviceProfilerBufferMemoryData& );
@@ -486,6 +536,7 @@ namespace Profiler
         void DrawSignificanceRect( float significance, const FrameBrowserTreeNodeIndex& index );
         void DrawBadge( uint32_t color, const char* shortName, const char* fmt, ... );
         void DrawPipelineCapabilityBadges( const DeviceProfilerPipelineData& pipeline );
+        void DrawPipelineStatisticsBadge( const DeviceProfilerPipelineStatistics& statistics );
         void DrawPipelineStageBadge( const DeviceProfilerPipelineData& pipeline, VkShaderStageFlagBits stage, const char* pStageName );
         void DrawPipelineContextMenu( const DeviceProfilerPipelineData& pipeline, const char* id = nullptr );
 
@@ -45,9 +45,16 @@ namespace Profiler
 
         virtual void WaitIdle() {}
 
+        virtual void SetRenderCacheEnabled( bool ) {}
+
         virtual bool NewFrame() = 0;
         virtual void RenderDrawData( ImDrawData* draw_data ) = 0;
 
+        // Threaded UI: the draw data is recorded on the UI thread with the ImGui context current,
+        // and the latest recorded frame is submitted on the present thread without the context.
+        virtual bool RecordDrawData( ImDrawData* draw_data ) = 0;
+        virtual void SubmitRecordedDrawData() = 0;
+
         virtual float GetDPIScale() const = 0;
         virtual ImVec2 GetRenderArea() const = 0;
 
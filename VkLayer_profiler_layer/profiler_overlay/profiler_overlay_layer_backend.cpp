@@ -24,10 +24,11 @@
 #include "profiler_layer_objects/VkQueue_object.h"
 #include "profiler_layer_objects/VkSurfaceKhr_object.h"
 #include "profiler_layer_objects/VkSwapchainKhr_object.h"
-#include "profiler_layer_functions/core/VkDevice_functions_base.h"
+#include "profiler/profiler_shader.h"
 
 #include <imgui.h>
 #include <imgui_impl_vulkan.h>
+#include <farmhash.h>
 
 #ifdef VK_USE_PLATFORM_WIN32_KHR
 #include "profiler_overlay_layer_backend_win32.h"
@@ -42,8 +43,112 @@
 #include "profiler_overlay_layer_backend_wayland.h"
 #endif
 
+namespace
+{
+    // Composite pass of the cached overlay image.
+    // The vertex shader generates a triangle covering the whole render area:
+    //
+    //  #version 450
+    //  layout(location = 0) out vec2 texcoord;
+    //  void main()
+    //  {
+    //      texcoord = vec2( ( gl_VertexIndex << 1 ) & 2, gl_VertexIndex & 2 );
+    //      gl_Position = vec4( texcoord * 2.0 - 1.0, 0.0, 1.0 );
+    //  }
+    static constexpr char g_scCompositeVertexShader[] = R"(
+                        OpCapability Shader
+                        OpMemoryModel Logical GLSL450
+                        OpEntryPoint Vertex %main "main" %gl_VertexIndex %gl_Position %texcoord
+                        OpDecorate %gl_VertexIndex BuiltIn VertexIndex
+                        OpDecorate %gl_Position BuiltIn Position
+                        OpDecorate %texcoord Location 0
+               %void = OpTypeVoid
+            %void_fn = OpTypeFunction %void
+                %int = OpTypeInt 32 1
+              %float = OpTypeFloat 32
+            %v2float = OpTypeVector %float 2
+            %v4float = OpTypeVector %float 4
+          %input_int = OpTypePointer Input %int
+     %output_v2float = OpTypePointer Output %v2float
+     %output_v4float = OpTypePointer Output %v4float
+              %int_1 = OpConstant %int 1
+              %int_2 = OpConstant %int 2
+            %float_0 = OpConstant %float 0
+            %float_1 = OpConstant %float 1
+            %float_2 = OpConstant %float 2
+          %v2float_1 = OpConstantComposite %v2float %float_1 %float_1
+     %gl_VertexIndex = OpVariable %input_int Input
+        %gl_Position = OpVariable %output_v4float Output
+           %texcoord = OpVariable %output_v2float Output
+               %main = OpFunction %void None %void_fn
+              %entry = OpLabel
+              %index = OpLoad %int %gl_VertexIndex
+            %shifted = OpShiftLeftLogical %int %index %int_1
+             %x_bits = OpBitwiseAnd %int %shifted %int_2
+             %y_bits = OpBitwiseAnd %int %index %int_2
+                  %x = OpConvertSToF %float %x_bits
+                  %y = OpConvertSToF %float %y_bits
+                 %uv = OpCompositeConstruct %v2float %x %y
+                        OpStore %texcoord %uv
+             %scaled = OpVectorTimesScalar %v2float %uv %float_2
+               %clip = OpFSub %v2float %scaled %v2float_1
+             %clip_x = OpCompositeExtract %float %clip 0
+             %clip_y = OpCompositeExtract %float %clip 1
+           %position = OpCompositeConstruct %v4float %clip_x %clip_y %float_0 %float_1
+                        OpStore %gl_Position %position
+                        OpReturn
+                        OpFunctionEnd
+)";
+
+    // The fragment shader copies the cached image. The colors are already multiplied
+    // by alpha, so the pipeline blends them with ONE and ONE_MINUS_SRC_ALPHA factors:
+    //
+    //  #version 450
+    //  layout(set = 0, binding = 0) uniform sampler2D overlay;
+    //  layout(location = 0) in vec2 texcoord;
+    //  layout(location = 0) out vec4 color;
+    //  void main()
+    //  {
+    //      color = texture( overlay, texcoord );
+    //  }
+    static constexpr char g_scCompositeFragmentShader[] = R"(
+                        OpCapability Shader
+                        OpMemoryModel Logical GLSL450
+                        OpEntryPoint Fragment %main "main" %texcoord %color
+                        OpExecutionMode %main OriginUpperLeft
+                        OpDecorate %texcoord Location 0
+                        OpDecorate %color Location 0
+                        OpDecorate %overlay DescriptorSet 0
+                        OpDecorate %overlay Binding 0
+               %void = OpTypeVoid
+            %void_fn = OpTypeFunction %void
+              %float = OpTypeFloat 32
+            %v2float = OpTypeVector %float 2
+            %v4float = OpTypeVector %float 4
+              %image = OpTypeImage %float 2D 0 0 0 1 Unknown
+      %sampled_image = OpTypeSampledImage %image
+%uniformconstant_sampled_image = OpTypePointer UniformConstant %sampled_image
+      %input_v2float = OpTypePointer Input %v2float
+     %output_v4float = OpTypePointer Output %v4float
+            %overlay = OpVariable %uniformconstant_sampled_image UniformConstant
+           %texcoord = OpVariable %input_v2float Input
+              %color = OpVariable %output_v4float Output
+               %main = OpFunction %void None %void_fn
+              %entry = OpLabel
+            %sampler = OpLoad %sampled_image %overlay
+                 %uv = OpLoad %v2float %texcoord
+              %texel = OpImageSampleImplicitLod %v4float %sampler %uv
+                        OpStore %color %texel
+                        OpReturn
+                        OpFunctionEnd
+)";
+}
+
 namespace Profiler
 {
+    // Initialize the map of devices used by the functions loaded for ImGui
+    ConcurrentMap<VkDevice, VkDevice_Object*> OverlayLayerBackend::Devices;
+
     /***********************************************************************************\
 
     Function:
@@ -90,6 +195,9 @@ namespace Profiler
             return VK_ERROR_INITIALIZATION_FAILED;
         }
 
+        // Register the device for the functions loaded for ImGui.
+        Devices.insert_or_assign( m_pDevice->Handle, m_pDevice );
+
         // Create descriptor pool
         if( result == VK_SUCCESS )
         {
@@ -127,6 +235,16 @@ namespace Profiler
                 &info,
                 nullptr,
                 &m_CommandPool );
+
+            // Command pools are externally synchronized, the UI thread records the draw data to a separate one.
+            if( result == VK_SUCCESS )
+            {
+                result = m_pDevice->Callbacks.CreateCommandPool(
+                    m_pDevice->Handle,
+                    &info,
+                    nullptr,
+                    &m_RecordCommandPool );
+            }
         }
 
         // Create linear sampler
@@ -177,7 +295,7 @@ namespace Profiler
     {
         WaitIdle();
 
-        DestroyImGuiBackend();
+        ShutdownImGuiBackend();
         DestroySwapchainResources();
         DestroyResources();
 
@@ -197,6 +315,14 @@ namespace Profiler
                 nullptr );
         }
 
+        if( m_RecordCommandPool != VK_NULL_HANDLE )
+        {
+            m_pDevice->Callbacks.DestroyCommandPool(
+                m_pDevice->Handle,
+                m_RecordCommandPool,
+                nullptr );
+        }
+
         if( m_LinearSampler != VK_NULL_HANDLE )
         {
             m_pDevice->Callbacks.DestroySampler(
@@ -207,6 +333,11 @@ namespace Profiler
 
         m_MemoryManager.Destroy();
 
+        if( m_pDevice != nullptr )
+        {
+            Devices.remove( m_pDevice->Handle );
+        }
+
         ResetMembers();
     }
 
@@ -235,8 +366,16 @@ namespace Profiler
     \***********************************************************************************/
     VkResult OverlayLayerBackend::SetSwapchain( VkSwapchainKHR swapchain, const VkSwapchainCreateInfoKHR& createInfo )
     {
+        std::scoped_lock lk( m_Mutex );
+
         VkResult result = VK_SUCCESS;
 
+        // Frames recorded by the UI thread reference the render passes of the previous swapchain.
+        InvalidateRecordedDrawData();
+
+        // Cached overlay image must match the extent and format of the new swapchain.
+        DestroyRenderCache();
+
         // Get swapchain images
         uint32_t swapchainImageCount = 0;
         m_pDevice->Callbacks.GetSwapchainImagesKHR(
@@ -502,6 +641,29 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Function:
+        SetRenderCacheEnabled
+
+    Description:
+        Render the overlay to an offscreen image that is re-rendered only when the
+        draw data changes, and composite it onto the swapchain images.
+
+    \***********************************************************************************/
+    void OverlayLayerBackend::SetRenderCacheEnabled( bool enabled )
+    {
+        std::scoped_lock lk( m_Mutex );
+
+        if( m_RenderCacheEnabled != enabled )
+        {
+            m_RenderCacheEnabled = enabled;
+
+            // Reinitialize ImGui backend with the vertex buffer count adjusted to the number of passes per frame.
+            m_ResetBackendsBeforeNextFrame = true;
+        }
+    }
+
+    /***********************************************************************************\
+
     Function:
         InitializeImGuiBackend
 
@@ -511,10 +673,12 @@ namespace Profiler
     \***********************************************************************************/
     bool OverlayLayerBackend::PrepareImGuiBackend()
     {
+        std::scoped_lock lk( m_Mutex );
+
         if( m_ResetBackendsBeforeNextFrame )
         {
             // Reset ImGui backend due to swapchain recreation.
-            DestroyImGuiBackend();
+            ShutdownImGuiBackend();
             m_ResetBackendsBeforeNextFrame = false;
         }
 
@@ -536,6 +700,14 @@ namespace Profiler
             initInfo.RenderPass = m_RenderPass;
             initInfo.MinImageCount = m_MinImageCount;
             initInfo.ImageCount = static_cast<uint32_t>( m_Images.size() );
+
+            if( m_RenderCacheEnabled )
+            {
+                // The backend cycles through ImageCount vertex and index buffers, one per RenderDrawData call.
+                // Render cache may record 2 calls per frame, so double the count to avoid overwriting buffers
+                // that are still in use by the frames in flight.
+                initInfo.ImageCount *= 2;
+            }
             initInfo.MSAASamples = VK_SAMPLE_COUNT_1_BIT;
 
             // Initialize the Vulkan backend.
@@ -544,6 +716,7 @@ namespace Profiler
                 return false;
             }
 
+            m_ImGuiBufferCount = initInfo.ImageCount;
             m_VulkanBackendInitialized = true;
         }
 
@@ -605,6 +778,25 @@ namespace Profiler
     \***********************************************************************************/
     void OverlayLayerBackend::DestroyImGuiBackend()
     {
+        std::scoped_lock lk( m_Mutex );
+
+        ShutdownImGuiBackend();
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        ShutdownImGuiBackend
+
+    Description:
+        Destroy the ImGui backends and the command buffers recorded with them.
+        Requires the backend mutex to be locked.
+
+    \***********************************************************************************/
+    void OverlayLayerBackend::ShutdownImGuiBackend()
+    {
+        FreeRecordedDrawData();
+
         if( m_VulkanBackendInitialized )
         {
             ImGui_ImplVulkan_Shutdown();
@@ -675,24 +867,22 @@ namespace Profiler
         NewFrame
 
     Description:
-        Begin rendering of a new frame.
+        Begin a new ImGui frame and poll the platform input events.
+        The backends must be prepared with PrepareImGuiBackend first.
 
     \***********************************************************************************/
     bool OverlayLayerBackend::NewFrame()
     {
-        bool backendPrepared = PrepareImGuiBackend();
-        if( backendPrepared )
-        {
-            ImGui_ImplVulkan_NewFrame();
-            m_pPlatformBackend->NewFrame();
-        }
+        std::scoped_lock lk( m_Mutex );
 
-        if( m_ResourcesUploadEvent != VK_NULL_HANDLE )
+        if( !m_VulkanBackendInitialized || !m_pPlatformBackend || m_ResetBackendsBeforeNextFrame )
         {
-            DestroyUploadResources();
+            return false;
         }
 
-        return backendPrepared;
+        ImGui_ImplVulkan_NewFrame();
+        m_pPlatformBackend->NewFrame();
+        return true;
     }
 
     /***********************************************************************************\
@@ -705,9 +895,187 @@ namespace Profiler
 
     \***********************************************************************************/
     void OverlayLayerBackend::RenderDrawData( ImDrawData* pDrawData )
+    {
+        std::scoped_lock lk( m_Mutex );
+
+        Render( pDrawData, nullptr );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        RecordDrawData
+
+    Description:
+        Record ImGui draw data to a secondary command buffer submitted by the present
+        thread in SubmitRecordedDrawData. Requires the overlay's ImGui context to be
+        current. The backend mutex is not held while the commands are recorded.
+
+        Returns false if the frame was not recorded, e.g., when the GPU still uses the
+        next command buffer.
+
+    \***********************************************************************************/
+    bool OverlayLayerBackend::RecordDrawData( ImDrawData* pDrawData )
+    {
+        VkResult result = VK_SUCCESS;
+        RecordedDrawData recordedDrawData;
+        uint32_t recordedDrawDataIndex = 0;
+        uint32_t swapchainGeneration = 0;
+        bool vertexBuffersUsed = false;
+
+        VkCommandBufferInheritanceInfo inheritanceInfo = {};
+        inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+
+        // The ImGui backend doesn't use the vertex buffers if there is nothing to render to.
+        if( ( pDrawData == nullptr ) ||
+            ( pDrawData->DisplaySize.x * pDrawData->FramebufferScale.x <= 0.0f ) ||
+            ( pDrawData->DisplaySize.y * pDrawData->FramebufferScale.y <= 0.0f ) )
+        {
+            return false;
+        }
+
+        {
+            std::scoped_lock lk( m_Mutex );
+
+            if( !m_VulkanBackendInitialized )
+            {
+                return false;
+            }
+
+            if( m_RecordedDrawData.empty() )
+            {
+                result = AllocateRecordedDrawData();
+            }
+
+            if( result == VK_SUCCESS )
+            {
+                recordedDrawDataIndex = m_NextRecordedDrawDataIndex;
+                recordedDrawData = m_RecordedDrawData[recordedDrawDataIndex];
+
+                // Skip the frame if the command buffer is used by the present thread or the GPU.
+                if( ( recordedDrawDataIndex == m_LatestRecordedDrawDataIndex ) ||
+                    ( ( recordedDrawData.LastSubmittedFence != VK_NULL_HANDLE ) &&
+                      ( m_pDevice->Callbacks.GetFenceStatus( m_pDevice->Handle, recordedDrawData.LastSubmittedFence ) != VK_SUCCESS ) ) )
+                {
+                    result = VK_NOT_READY;
+                }
+            }
+
+            if( ( result == VK_SUCCESS ) && m_RenderCacheEnabled )
+            {
+                if( InitializeRenderCache() != VK_SUCCESS )
+                {
+                    // Fall back to rendering directly to the swapchain images if the cache is not available.
+                    m_RenderCacheEnabled = false;
+                }
+            }
+
+            if( result == VK_SUCCESS )
+            {
+                recordedDrawData.LastSubmittedFence = VK_NULL_HANDLE;
+                recordedDrawData.RenderCache = m_RenderCacheEnabled;
+
+                if( recordedDrawData.RenderCache )
+                {
+                    inheritanceInfo.renderPass = m_RenderCache.RenderPass;
+                    inheritanceInfo.framebuffer = m_RenderCache.Framebuffer;
+                }
+                else
+                {
+                    inheritanceInfo.renderPass = m_RenderPass;
+                }
+
+                swapchainGeneration = m_SwapchainGeneration;
+            }
+        }
+
+        if( result == VK_SUCCESS )
+        {
+            VkCommandBufferBeginInfo info = {};
+            info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            info.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+            info.pInheritanceInfo = &inheritanceInfo;
+
+            // The latest recorded frame is submitted in each present until the next one is recorded.
+            info.flags |= VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+
+            result = m_pDevice->Callbacks.BeginCommandBuffer( recordedDrawData.CommandBuffer, &info );
+        }
+
+        if( result == VK_SUCCESS )
+        {
+            ImGui_ImplVulkan_RenderDrawData( pDrawData, recordedDrawData.CommandBuffer );
+            vertexBuffersUsed = true;
+
+            result = m_pDevice->Callbacks.EndCommandBuffer( recordedDrawData.CommandBuffer );
+        }
+
+        if( ( result == VK_SUCCESS ) && recordedDrawData.RenderCache )
+        {
+            recordedDrawData.DrawDataHash = GetDrawDataHash( pDrawData );
+        }
+
+        {
+            std::scoped_lock lk( m_Mutex );
+
+            // The ImGui backend moved to its next vertex buffer, keep the command buffers in sync with it.
+            if( vertexBuffersUsed && !m_RecordedDrawData.empty() )
+            {
+                m_NextRecordedDrawDataIndex = ( recordedDrawDataIndex + 1 ) % static_cast<uint32_t>( m_RecordedDrawData.size() );
+            }
+
+            // Don't publish frames recorded for the previous swapchain.
+            if( ( result == VK_SUCCESS ) && ( swapchainGeneration == m_SwapchainGeneration ) )
+            {
+                m_RecordedDrawData[recordedDrawDataIndex] = recordedDrawData;
+                m_LatestRecordedDrawDataIndex = recordedDrawDataIndex;
+            }
+        }
+
+        return ( result == VK_SUCCESS );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        SubmitRecordedDrawData
+
+    Description:
+        Submit the latest frame recorded by the UI thread. Doesn't require the ImGui
+        context, so the present thread doesn't wait for the UI thread building the
+        next frame.
+
+    \***********************************************************************************/
+    void OverlayLayerBackend::SubmitRecordedDrawData()
+    {
+        std::scoped_lock lk( m_Mutex );
+
+        if( m_LatestRecordedDrawDataIndex < m_RecordedDrawData.size() )
+        {
+            Render( nullptr, &m_RecordedDrawData[m_LatestRecordedDrawDataIndex] );
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        Render
+
+    Description:
+        Record and submit the overlay commands for the presented image.
+        Executes the recorded draw data if provided, otherwise records the ImGui
+        draw data directly. Requires the backend mutex to be locked.
+
+    \***********************************************************************************/
+    void OverlayLayerBackend::Render( ImDrawData* pDrawData, RecordedDrawData* pRecordedDrawData )
     {
         VkResult result = VK_SUCCESS;
 
+        if( m_ResourcesUploadEvent != VK_NULL_HANDLE )
+        {
+            DestroyUploadResources();
+        }
+
         // Grab command buffer for overlay commands.
         uint32_t imageIndex = 0;
         if( m_PresentInfo.swapchainCount && m_PresentInfo.pImageIndices )
@@ -738,6 +1106,23 @@ namespace Profiler
             RecordUploadCommands( commandBuffer );
         }
 
+        // The recorded draw data was recorded for the render cache if it was enabled at that time.
+        bool renderCache = pRecordedDrawData ? pRecordedDrawData->RenderCache : m_RenderCacheEnabled;
+
+        if( ( result == VK_SUCCESS ) && renderCache )
+        {
+            if( pRecordedDrawData || ( InitializeRenderCache() == VK_SUCCESS ) )
+            {
+                RecordRenderCacheCommands( commandBuffer, pDrawData, pRecordedDrawData );
+            }
+            else
+            {
+                // Fall back to rendering directly to the swapchain images if the cache is not available.
+                m_RenderCacheEnabled = false;
+                renderCache = false;
+            }
+        }
+
         if( result == VK_SUCCESS )
         {
             VkRenderPassBeginInfo info = {};
@@ -748,8 +1133,22 @@ namespace Profiler
             info.renderArea.extent.height = m_RenderArea.height;
 
             // Record Imgui Draw Data into the command buffer.
-            m_pDevice->Callbacks.CmdBeginRenderPass( commandBuffer, &info, VK_SUBPASS_CONTENTS_INLINE );
-            ImGui_ImplVulkan_RenderDrawData( pDrawData, commandBuffer );
+            const VkSubpassContents subpassContents = ( pRecordedDrawData && !renderCache )
+                ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+                : VK_SUBPASS_CONTENTS_INLINE;
+
+            m_pDevice->Callbacks.CmdBeginRenderPass( commandBuffer, &info, subpassContents );
+
+            if( renderCache )
+            {
+                // Composite the cached overlay onto the swapchain image.
+                RecordCompositeCommands( commandBuffer );
+            }
+            else
+            {
+                RecordDrawCommands( commandBuffer, pDrawData, pRecordedDrawData );
+            }
+
             m_pDevice->Callbacks.CmdEndRenderPass( commandBuffer );
 
             result = m_pDevice->Callbacks.EndCommandBuffer( commandBuffer );
@@ -780,6 +1179,12 @@ namespace Profiler
         {
             m_LastSubmittedFence = fence;
 
+            if( pRecordedDrawData )
+            {
+                // Fences signal in submission order, so the last one is enough to check if the commands are still in use.
+                pRecordedDrawData->LastSubmittedFence = fence;
+            }
+
             // Override wait semaphore.
             m_PresentInfo.waitSemaphoreCount = 1;
             m_PresentInfo.pWaitSemaphores = &semaphore;
@@ -797,6 +1202,8 @@ namespace Profiler
     \***********************************************************************************/
     uint64_t OverlayLayerBackend::CreateImage( int width, int height, const void* pData )
     {
+        std::scoped_lock lk( m_Mutex );
+
         ImageResource imageResource;
         VkResult result = InitializeImage( imageResource, width, height, pData );
 
@@ -820,6 +1227,8 @@ namespace Profiler
     \***********************************************************************************/
     void OverlayLayerBackend::DestroyImage( uint64_t image )
     {
+        std::scoped_lock lk( m_Mutex );
+
         auto it = std::find_if( m_ImageResources.begin(), m_ImageResources.end(),
             [image]( const ImageResource& imageResource )
             {
@@ -844,6 +1253,8 @@ namespace Profiler
     \***********************************************************************************/
     void OverlayLayerBackend::CreateFontsImage()
     {
+        std::scoped_lock lk( m_Mutex );
+
         ImGui_ImplVulkan_CreateFontsTexture();
     }
 
@@ -858,6 +1269,8 @@ namespace Profiler
     \***********************************************************************************/
     void OverlayLayerBackend::DestroyFontsImage()
     {
+        std::scoped_lock lk( m_Mutex );
+
         ImGui_ImplVulkan_DestroyFontsTexture();
     }
 
@@ -876,19 +1289,114 @@ namespace Profiler
         m_pGraphicsQueue = nullptr;
 
         m_CommandPool = VK_NULL_HANDLE;
+        m_RecordCommandPool = VK_NULL_HANDLE;
         m_DescriptorPool = VK_NULL_HANDLE;
 
         m_Initialized = false;
+        m_RenderCacheEnabled = false;
 
         m_ResourcesUploadEvent = VK_NULL_HANDLE;
         m_LinearSampler = VK_NULL_HANDLE;
         m_ImageResources.clear();
 
+        m_RecordedDrawData.clear();
+        m_ImGuiBufferCount = 0;
+        m_NextRecordedDrawDataIndex = 0;
+        m_LatestRecordedDrawDataIndex = UINT32_MAX;
+        m_SwapchainGeneration = 0;
+
         ResetSwapchainMembers();
     }
 
     /***********************************************************************************\
 
+    Function:
+        AllocateRecordedDrawData
+
+    Description:
+        Allocate the secondary command buffers for the draw data recorded by the UI
+        thread, one for each vertex buffer of the ImGui backend.
+
+    \***********************************************************************************/
+    VkResult OverlayLayerBackend::AllocateRecordedDrawData()
+    {
+        VkCommandBufferAllocateInfo allocInfo = {};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocInfo.commandPool = m_RecordCommandPool;
+        allocInfo.commandBufferCount = m_ImGuiBufferCount;
+
+        std::vector<VkCommandBuffer> commandBuffers( m_ImGuiBufferCount );
+        VkResult result = AllocateCommandBuffers(
+            m_pDevice->Handle,
+            &allocInfo,
+            commandBuffers.data() );
+
+        if( result == VK_SUCCESS )
+        {
+            m_RecordedDrawData.resize( m_ImGuiBufferCount );
+
+            for( uint32_t i = 0; i < m_ImGuiBufferCount; ++i )
+            {
+                m_RecordedDrawData[i].CommandBuffer = commandBuffers[i];
+            }
+        }
+
+        m_NextRecordedDrawDataIndex = 0;
+        m_LatestRecordedDrawDataIndex = UINT32_MAX;
+
+        return result;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        FreeRecordedDrawData
+
+    Description:
+        Free the command buffers recorded by the UI thread.
+
+    \***********************************************************************************/
+    void OverlayLayerBackend::FreeRecordedDrawData()
+    {
+        if( !m_RecordedDrawData.empty() )
+        {
+            // The latest frame may still be rendered.
+            WaitIdle();
+
+            for( const RecordedDrawData& recordedDrawData : m_RecordedDrawData )
+            {
+                m_pDevice->Callbacks.FreeCommandBuffers(
+                    m_pDevice->Handle,
+                    m_RecordCommandPool,
+                    1, &recordedDrawData.CommandBuffer );
+            }
+
+            m_RecordedDrawData.clear();
+        }
+
+        m_NextRecordedDrawDataIndex = 0;
+        m_LatestRecordedDrawDataIndex = UINT32_MAX;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        InvalidateRecordedDrawData
+
+    Description:
+        Stop submitting the recorded draw data and drop the frames being recorded.
+        Called when the resources referenced by the command buffers are destroyed.
+
+    \***********************************************************************************/
+    void OverlayLayerBackend::InvalidateRecordedDrawData()
+    {
+        m_LatestRecordedDrawDataIndex = UINT32_MAX;
+        m_SwapchainGeneration++;
+    }
+
+    /***********************************************************************************\
+
     Function:
         DestroySwapchainResources
 
@@ -898,6 +1406,9 @@ namespace Profiler
     \***********************************************************************************/
     void OverlayLayerBackend::DestroySwapchainResources()
     {
+        InvalidateRecordedDrawData();
+        DestroyRenderCache();
+
         if( m_RenderPass != VK_NULL_HANDLE )
         {
             m_pDevice->Callbacks.DestroyRenderPass( m_pDevice->Handle, m_RenderPass, nullptr );
@@ -978,6 +1489,625 @@ namespace Profiler
         m_CommandFences.clear();
         m_CommandSemaphores.clear();
         m_LastSubmittedFence = VK_NULL_HANDLE;
+
+        m_RenderCache = RenderCache();
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        InitializeRenderCache
+
+    Description:
+        Create the offscreen image for the overlay and the pipeline that composites
+        it onto the swapchain images. Does nothing if the cache is already initialized.
+
+    \***********************************************************************************/
+    VkResult OverlayLayerBackend::InitializeRenderCache()
+    {
+        if( m_RenderCache.RenderPass != VK_NULL_HANDLE )
+        {
+            return VK_SUCCESS;
+        }
+
+        VkResult result = VK_SUCCESS;
+        ImageResource& image = m_RenderCache.Image;
+        image.ImageExtent = m_RenderArea;
+
+        // The image is rendered with ImGui pipeline created for the swapchain render pass,
+        // so it must have the same format, and it must be possible to sample it in the composite pass.
+        {
+            const VkFormatFeatureFlags requiredFeatures =
+                VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BLEND_BIT |
+                VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
+
+            VkFormatProperties formatProperties = {};
+            m_pDevice->pInstance->Callbacks.GetPhysicalDeviceFormatProperties(
+                m_pDevice->pPhysicalDevice->Handle,
+                m_ImageFormat,
+                &formatProperties );
+
+            if( ( formatProperties.optimalTilingFeatures & requiredFeatures ) != requiredFeatures )
+            {
+                result = VK_ERROR_FORMAT_NOT_SUPPORTED;
+            }
+        }
+
+        // Create render pass.
+        if( result == VK_SUCCESS )
+        {
+            VkAttachmentDescription attachment = {};
+            attachment.format = m_ImageFormat;
+            attachment.samples = VK_SAMPLE_COUNT_1_BIT;
+            attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+            attachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+            attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            attachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            attachment.finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+            VkAttachmentReference colorAttachment = {};
+            colorAttachment.attachment = 0;
+            colorAttachment.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+            VkSubpassDescription subpass = {};
+            subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+            subpass.colorAttachmentCount = 1;
+            subpass.pColorAttachments = &colorAttachment;
+
+            // Wait for the composite pass of the previous frame before overwriting the image,
+            // and make the results visible to the composite pass of the current frame.
+            VkSubpassDependency dependencies[2] = {};
+            dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+            dependencies[0].dstSubpass = 0;
+            dependencies[0].srcStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+            dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+            dependencies[0].srcAccessMask = 0;
+            dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            dependencies[1].srcSubpass = 0;
+            dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+            dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+            dependencies[1].dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+            dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            dependencies[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+            VkRenderPassCreateInfo info = {};
+            info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+            info.attachmentCount = 1;
+            info.pAttachments = &attachment;
+            info.subpassCount = 1;
+            info.pSubpasses = &subpass;
+            info.dependencyCount = std::extent_v<decltype( dependencies )>;
+            info.pDependencies = dependencies;
+
+            result = m_pDevice->Callbacks.CreateRenderPass(
+                m_pDevice->Handle,
+                &info,
+                nullptr,
+                &m_RenderCache.RenderPass );
+        }
+
+        // Create image object.
+        if( result == VK_SUCCESS )
+        {
+            VkImageCreateInfo imageCreateInfo = {};
+            imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+            imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+            imageCreateInfo.format = m_ImageFormat;
+            imageCreateInfo.extent.width = image.ImageExtent.width;
+            imageCreateInfo.extent.height = image.ImageExtent.height;
+            imageCreateInfo.extent.depth = 1;
+            imageCreateInfo.mipLevels = 1;
+            imageCreateInfo.arrayLayers = 1;
+            imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+            imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+            imageCreateInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+            imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+            VmaAllocationCreateInfo allocationCreateInfo = {};
+            allocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+
+            result = m_MemoryManager.AllocateImage(
+                imageCreateInfo,
+                allocationCreateInfo,
+                &image.Image,
+                &image.ImageAllocation );
+        }
+
+        // Create image view.
+        if( result == VK_SUCCESS )
+        {
+            VkImageViewCreateInfo imageViewCreateInfo = {};
+            imageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+            imageViewCreateInfo.image = image.Image;
+            imageViewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+            imageViewCreateInfo.format = m_ImageFormat;
+            imageViewCreateInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            imageViewCreateInfo.subresourceRange.baseMipLevel = 0;
+            imageViewCreateInfo.subresourceRange.levelCount = 1;
+            imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
+            imageViewCreateInfo.subresourceRange.layerCount = 1;
+
+            result = m_pDevice->Callbacks.CreateImageView(
+                m_pDevice->Handle,
+                &imageViewCreateInfo,
+                nullptr,
+                &image.ImageView );
+        }
+
+        // Create framebuffer.
+        if( result == VK_SUCCESS )
+        {
+            VkFramebufferCreateInfo info = {};
+            info.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+            info.renderPass = m_RenderCache.RenderPass;
+            info.attachmentCount = 1;
+            info.pAttachments = &image.ImageView;
+            info.width = image.ImageExtent.width;
+            info.height = image.ImageExtent.height;
+            info.layers = 1;
+
+            result = m_pDevice->Callbacks.CreateFramebuffer(
+                m_pDevice->Handle,
+                &info,
+                nullptr,
+                &m_RenderCache.Framebuffer );
+        }
+
+        // Create pipeline of the composite pass.
+        if( result == VK_SUCCESS )
+        {
+            result = CreateCompositePipeline();
+        }
+
+        // Create descriptor set for the composite pass.
+        if( result == VK_SUCCESS )
+        {
+            VkDescriptorSetAllocateInfo info = {};
+            info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+            info.descriptorPool = m_DescriptorPool;
+            info.descriptorSetCount = 1;
+            info.pSetLayouts = &m_RenderCache.CompositeDescriptorSetLayout;
+
+            result = m_pDevice->Callbacks.AllocateDescriptorSets(
+                m_pDevice->Handle,
+                &info,
+                &image.ImageDescriptorSet );
+        }
+
+        if( result == VK_SUCCESS )
+        {
+            VkDescriptorImageInfo imageInfo = {};
+            imageInfo.sampler = m_LinearSampler;
+            imageInfo.imageView = image.ImageView;
+            imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+            VkWriteDescriptorSet write = {};
+            write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            write.dstSet = image.ImageDescriptorSet;
+            write.dstBinding = 0;
+            write.descriptorCount = 1;
+            write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            write.pImageInfo = &imageInfo;
+
+            m_pDevice->Callbacks.UpdateDescriptorSets( m_pDevice->Handle, 1, &write, 0, nullptr );
+        }
+
+        // Don't leave the cache in partly-initialized state.
+        if( result != VK_SUCCESS )
+        {
+            DestroyRenderCache();
+        }
+
+        return result;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        AssembleCompositeShaders
+
+    Description:
+        Assemble and validate the shader modules of the composite pass.
+
+    \***********************************************************************************/
+    bool OverlayLayerBackend::AssembleCompositeShaders( std::vector<uint32_t>& vertexShader, std::vector<uint32_t>& fragmentShader )
+    {
+        const bool vertexShaderAssembled = AssembleShaderModule(
+            g_scCompositeVertexShader,
+            std::size( g_scCompositeVertexShader ) - 1,
+            vertexShader );
+
+        const bool fragmentShaderAssembled = AssembleShaderModule(
+            g_scCompositeFragmentShader,
+            std::size( g_scCompositeFragmentShader ) - 1,
+            fragmentShader );
+
+        return vertexShaderAssembled && fragmentShaderAssembled;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        CreateCompositePipeline
+
+    Description:
+        Create the pipeline that draws the cached overlay image over the swapchain image.
+        ImGui pipeline can't be used for this, because it multiplies the colors of the
+        image by alpha for the second time.
+
+    \***********************************************************************************/
+    VkResult OverlayLayerBackend::CreateCompositePipeline()
+    {
+        std::vector<uint32_t> vertexShaderCode;
+        std::vector<uint32_t> fragmentShaderCode;
+        const bool assembled = AssembleCompositeShaders( vertexShaderCode, fragmentShaderCode );
+
+        assert( assembled );
+
+        VkResult result = assembled
+            ? VK_SUCCESS
+            : VK_ERROR_INITIALIZATION_FAILED;
+
+        VkShaderModule shaderModules[2] = {};
+
+        // Create descriptor set layout.
+        if( result == VK_SUCCESS )
+        {
+            VkDescriptorSetLayoutBinding binding = {};
+            binding.binding = 0;
+            binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            binding.descriptorCount = 1;
+            binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+            VkDescriptorSetLayoutCreateInfo info = {};
+            info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+            info.bindingCount = 1;
+            info.pBindings = &binding;
+
+            result = m_pDevice->Callbacks.CreateDescriptorSetLayout(
+                m_pDevice->Handle,
+                &info,
+                nullptr,
+                &m_RenderCache.CompositeDescriptorSetLayout );
+        }
+
+        // Create pipeline layout.
+        if( result == VK_SUCCESS )
+        {
+            VkPipelineLayoutCreateInfo info = {};
+            info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+            info.setLayoutCount = 1;
+            info.pSetLayouts = &m_RenderCache.CompositeDescriptorSetLayout;
+
+            result = m_pDevice->Callbacks.CreatePipelineLayout(
+                m_pDevice->Handle,
+                &info,
+                nullptr,
+                &m_RenderCache.CompositePipelineLayout );
+        }
+
+        // Create shader modules.
+        if( result == VK_SUCCESS )
+        {
+            VkShaderModuleCreateInfo info = {};
+            info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+            info.codeSize = vertexShaderCode.size() * sizeof( uint32_t );
+            info.pCode = vertexShaderCode.data();
+
+            result = m_pDevice->Callbacks.CreateShaderModule(
+                m_pDevice->Handle,
+                &info,
+                nullptr,
+                &shaderModules[0] );
+        }
+
+        if( result == VK_SUCCESS )
+        {
+            VkShaderModuleCreateInfo info = {};
+            info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+            info.codeSize = fragmentShaderCode.size() * sizeof( uint32_t );
+            info.pCode = fragmentShaderCode.data();
+
+            result = m_pDevice->Callbacks.CreateShaderModule(
+                m_pDevice->Handle,
+                &info,
+                nullptr,
+                &shaderModules[1] );
+        }
+
+        // Create graphics pipeline compatible with the swapchain render pass.
+        if( result == VK_SUCCESS )
+        {
+            VkPipelineShaderStageCreateInfo stages[2] = {};
+            stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+            stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+            stages[0].module = shaderModules[0];
+            stages[0].pName = "main";
+            stages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+            stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+            stages[1].module = shaderModules[1];
+            stages[1].pName = "main";
+
+            // The vertices are generated in the vertex shader.
+            VkPipelineVertexInputStateCreateInfo vertexInputState = {};
+            vertexInputState.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+
+            VkPipelineInputAssemblyStateCreateInfo inputAssemblyState = {};
+            inputAssemblyState.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+            inputAssemblyState.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+            VkPipelineViewportStateCreateInfo viewportState = {};
+            viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+            viewportState.viewportCount = 1;
+            viewportState.scissorCount = 1;
+
+            VkPipelineRasterizationStateCreateInfo rasterizationState = {};
+            rasterizationState.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+            rasterizationState.polygonMode = VK_POLYGON_MODE_FILL;
+            rasterizationState.cullMode = VK_CULL_MODE_NONE;
+            rasterizationState.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+            rasterizationState.lineWidth = 1.0f;
+
+            VkPipelineMultisampleStateCreateInfo multisampleState = {};
+            multisampleState.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+            multisampleState.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+            // The cached image contains premultiplied colors.
+            VkPipelineColorBlendAttachmentState colorBlendAttachment = {};
+            colorBlendAttachment.blendEnable = VK_TRUE;
+            colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+            colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+            colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+            colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+            colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+            colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+            colorBlendAttachment.colorWriteMask =
+                VK_COLOR_COMPONENT_R_BIT |
+                VK_COLOR_COMPONENT_G_BIT |
+                VK_COLOR_COMPONENT_B_BIT |
+                VK_COLOR_COMPONENT_A_BIT;
+
+            VkPipelineColorBlendStateCreateInfo colorBlendState = {};
+            colorBlendState.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+            colorBlendState.attachmentCount = 1;
+            colorBlendState.pAttachments = &colorBlendAttachment;
+
+            const VkDynamicState dynamicStates[] = {
+                VK_DYNAMIC_STATE_VIEWPORT,
+                VK_DYNAMIC_STATE_SCISSOR
+            };
+
+            VkPipelineDynamicStateCreateInfo dynamicState = {};
+            dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+            dynamicState.dynamicStateCount = std::extent_v<decltype( dynamicStates )>;
+            dynamicState.pDynamicStates = dynamicStates;
+
+            VkGraphicsPipelineCreateInfo info = {};
+            info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+            info.stageCount = std::extent_v<decltype( stages )>;
+            info.pStages = stages;
+            info.pVertexInputState = &vertexInputState;
+            info.pInputAssemblyState = &inputAssemblyState;
+            info.pViewportState = &viewportState;
+            info.pRasterizationState = &rasterizationState;
+            info.pMultisampleState = &multisampleState;
+            info.pColorBlendState = &colorBlendState;
+            info.pDynamicState = &dynamicState;
+            info.layout = m_RenderCache.CompositePipelineLayout;
+            info.renderPass = m_RenderPass;
+            info.subpass = 0;
+
+            result = m_pDevice->Callbacks.CreateGraphicsPipelines(
+                m_pDevice->Handle,
+                VK_NULL_HANDLE,
+                1, &info,
+                nullptr,
+                &m_RenderCache.CompositePipeline );
+        }
+
+        // Shader modules are not needed after the pipeline is created.
+        for( VkShaderModule shaderModule : shaderModules )
+        {
+            if( shaderModule != VK_NULL_HANDLE )
+            {
+                m_pDevice->Callbacks.DestroyShaderModule( m_pDevice->Handle, shaderModule, nullptr );
+            }
+        }
+
+        return result;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        DestroyRenderCache
+
+    Description:
+        Destroy the offscreen image of the overlay.
+
+    \***********************************************************************************/
+    void OverlayLayerBackend::DestroyRenderCache()
+    {
+        if( m_RenderCache.RenderPass == VK_NULL_HANDLE )
+        {
+            return;
+        }
+
+        // The image may still be used by the last submitted composite pass.
+        WaitIdle();
+
+        ImageResource& image = m_RenderCache.Image;
+        if( image.ImageDescriptorSet != VK_NULL_HANDLE )
+        {
+            m_pDevice->Callbacks.FreeDescriptorSets( m_pDevice->Handle, m_DescriptorPool, 1, &image.ImageDescriptorSet );
+            image.ImageDescriptorSet = VK_NULL_HANDLE;
+        }
+
+        if( m_RenderCache.Framebuffer != VK_NULL_HANDLE )
+        {
+            m_pDevice->Callbacks.DestroyFramebuffer( m_pDevice->Handle, m_RenderCache.Framebuffer, nullptr );
+        }
+
+        DestroyImage( image );
+
+        if( m_RenderCache.CompositePipeline != VK_NULL_HANDLE )
+        {
+            m_pDevice->Callbacks.DestroyPipeline( m_pDevice->Handle, m_RenderCache.CompositePipeline, nullptr );
+        }
+
+        if( m_RenderCache.CompositePipelineLayout != VK_NULL_HANDLE )
+        {
+            m_pDevice->Callbacks.DestroyPipelineLayout( m_pDevice->Handle, m_RenderCache.CompositePipelineLayout, nullptr );
+        }
+
+        if( m_RenderCache.CompositeDescriptorSetLayout != VK_NULL_HANDLE )
+        {
+            m_pDevice->Callbacks.DestroyDescriptorSetLayout( m_pDevice->Handle, m_RenderCache.CompositeDescriptorSetLayout, nullptr );
+        }
+
+        m_pDevice->Callbacks.DestroyRenderPass( m_pDevice->Handle, m_RenderCache.RenderPass, nullptr );
+
+        m_RenderCache = RenderCache();
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        RecordRenderCacheCommands
+
+    Description:
+        Render the overlay to the offscreen image if the draw data has changed since
+        the last time the image was rendered.
+
+    \***********************************************************************************/
+    void OverlayLayerBackend::RecordRenderCacheCommands( VkCommandBuffer commandBuffer, ImDrawData* pDrawData, const RecordedDrawData* pRecordedDrawData )
+    {
+        const uint64_t drawDataHash = pRecordedDrawData
+            ? pRecordedDrawData->DrawDataHash
+            : GetDrawDataHash( pDrawData );
+
+        if( !m_RenderCache.Valid || ( m_RenderCache.DrawDataHash != drawDataHash ) )
+        {
+            VkClearValue clearValue = {};
+
+            VkRenderPassBeginInfo info = {};
+            info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+            info.renderPass = m_RenderCache.RenderPass;
+            info.framebuffer = m_RenderCache.Framebuffer;
+            info.renderArea.extent = m_RenderCache.Image.ImageExtent;
+            info.clearValueCount = 1;
+            info.pClearValues = &clearValue;
+
+            const VkSubpassContents subpassContents = pRecordedDrawData
+                ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+                : VK_SUBPASS_CONTENTS_INLINE;
+
+            m_pDevice->Callbacks.CmdBeginRenderPass( commandBuffer, &info, subpassContents );
+            RecordDrawCommands( commandBuffer, pDrawData, pRecordedDrawData );
+            m_pDevice->Callbacks.CmdEndRenderPass( commandBuffer );
+
+            m_RenderCache.DrawDataHash = drawDataHash;
+            m_RenderCache.Valid = true;
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        RecordDrawCommands
+
+    Description:
+        Execute the recorded draw data or record the ImGui draw data directly.
+        Must be recorded in a render pass compatible with the swapchain render pass.
+
+    \***********************************************************************************/
+    void OverlayLayerBackend::RecordDrawCommands( VkCommandBuffer commandBuffer, ImDrawData* pDrawData, const RecordedDrawData* pRecordedDrawData )
+    {
+        if( pRecordedDrawData )
+        {
+            m_pDevice->Callbacks.CmdExecuteCommands( commandBuffer, 1, &pRecordedDrawData->CommandBuffer );
+        }
+        else
+        {
+            ImGui_ImplVulkan_RenderDrawData( pDrawData, commandBuffer );
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        RecordCompositeCommands
+
+    Description:
+        Draw the cached overlay image over the swapchain image.
+        Must be recorded in the swapchain render pass.
+
+    \***********************************************************************************/
+    void OverlayLayerBackend::RecordCompositeCommands( VkCommandBuffer commandBuffer )
+    {
+        VkViewport viewport = {};
+        viewport.width = static_cast<float>( m_RenderArea.width );
+        viewport.height = static_cast<float>( m_RenderArea.height );
+        viewport.maxDepth = 1.0f;
+
+        VkRect2D scissor = {};
+        scissor.extent = m_RenderArea;
+
+        m_pDevice->Callbacks.CmdBindPipeline(
+            commandBuffer,
+            VK_PIPELINE_BIND_POINT_GRAPHICS,
+            m_RenderCache.CompositePipeline );
+
+        m_pDevice->Callbacks.CmdBindDescriptorSets(
+            commandBuffer,
+            VK_PIPELINE_BIND_POINT_GRAPHICS,
+            m_RenderCache.CompositePipelineLayout,
+            0, 1, &m_RenderCache.Image.ImageDescriptorSet,
+            0, nullptr );
+
+        m_pDevice->Callbacks.CmdSetViewport( commandBuffer, 0, 1, &viewport );
+        m_pDevice->Callbacks.CmdSetScissor( commandBuffer, 0, 1, &scissor );
+        m_pDevice->Callbacks.CmdDraw( commandBuffer, 3, 1, 0, 0 );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        GetDrawDataHash
+
+    Description:
+        Compute a hash of the draw data to detect changes in the rendered UI.
+
+    \***********************************************************************************/
+    uint64_t OverlayLayerBackend::GetDrawDataHash( const ImDrawData* pDrawData )
+    {
+        uint64_t hash = Farmhash::Fingerprint64(
+            reinterpret_cast<const char*>( &pDrawData->DisplaySize ),
+            sizeof( pDrawData->DisplaySize ) );
+
+        for( int i = 0; i < pDrawData->CmdListsCount; ++i )
+        {
+            const ImDrawList* pDrawList = pDrawData->CmdLists[i];
+
+            hash = Farmhash::Hash64WithSeed(
+                reinterpret_cast<const char*>( pDrawList->CmdBuffer.Data ),
+                pDrawList->CmdBuffer.size_in_bytes(),
+                hash );
+
+            hash = Farmhash::Hash64WithSeed(
+                reinterpret_cast<const char*>( pDrawList->VtxBuffer.Data ),
+                pDrawList->VtxBuffer.size_in_bytes(),
+                hash );
+
+            hash = Farmhash::Hash64WithSeed(
+                reinterpret_cast<const char*>( pDrawList->IdxBuffer.Data ),
+                pDrawList->IdxBuffer.size_in_bytes(),
+                hash );
+        }
+
+        return hash;
     }
 
     /***********************************************************************************\
@@ -1383,18 +2513,20 @@ namespace Profiler
     \***********************************************************************************/
     VkResult OverlayLayerBackend::AllocateCommandBuffers( VkDevice device, const VkCommandBufferAllocateInfo* pAllocateInfo, VkCommandBuffer* pCommandBuffers )
     {
-        auto& dd = Profiler::VkDevice_Functions_Base::DeviceDispatch.Get( device );
+        VkDevice_Object& deviceObject = *Devices.at( device );
 
         // Allocate the command buffers.
-        VkResult result = dd.Device.Callbacks.AllocateCommandBuffers(
+        VkResult result = deviceObject.Callbacks.AllocateCommandBuffers(
             device, pAllocateInfo, pCommandBuffers );
 
         // Command buffers are dispatchable handles, update pointers to parent's dispatch table.
+        // The loader data is not set when the backend runs in the viewer, outside of the layer.
         uint32_t initializedCommandBufferCount = 0;
-        for( ; ( initializedCommandBufferCount < pAllocateInfo->commandBufferCount ) && ( result == VK_SUCCESS );
+        for( ; ( initializedCommandBufferCount < pAllocateInfo->commandBufferCount ) && ( result == VK_SUCCESS ) &&
+               ( deviceObject.SetDeviceLoaderData != nullptr );
              ++initializedCommandBufferCount )
         {
-            result = dd.Device.SetDeviceLoaderData(
+            result = deviceObject.SetDeviceLoaderData(
                 device,
                 pCommandBuffers[initializedCommandBufferCount] );
         }
@@ -1403,7 +2535,7 @@ namespace Profiler
         {
             // Initialization of loader data failed, free all initialized command buffers.
             // Remaining command buffers must not be passed due to missing loader data.
-            dd.Device.Callbacks.FreeCommandBuffers(
+            deviceObject.Callbacks.FreeCommandBuffers(
                 device,
                 pAllocateInfo->commandPool,
                 initializedCommandBufferCount,
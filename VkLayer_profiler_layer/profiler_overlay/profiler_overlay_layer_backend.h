@@ -21,7 +21,9 @@
 #pragma once
 #include "profiler_overlay_backend.h"
 #include "profiler/profiler_memory_manager.h"
+#include "utils/lockable_unordered_map.h"
 
+#include <mutex>
 #include <vector>
 
 #include <vulkan/vulkan.h>
@@ -76,6 +78,8 @@ namespace Profiler
         void SetFramePresentInfo( const VkPresentInfoKHR& presentInfo );
         const VkPresentInfoKHR& GetFramePresentInfo() const;
 
+        void SetRenderCacheEnabled( bool enabled ) override;
+
         bool PrepareImGuiBackend() override;
         void DestroyImGuiBackend() override;
 
@@ -84,6 +88,9 @@ namespace Profiler
         bool NewFrame() override;
         void RenderDrawData( ImDrawData* pDrawData ) override;
 
+        bool RecordDrawData( ImDrawData* pDrawData ) override;
+        void SubmitRecordedDrawData() override;
+
         float GetDPIScale() const override;
         ImVec2 GetRenderArea() const override;
 
@@ -92,19 +99,26 @@ namespace Profiler
         void CreateFontsImage() override;
         void DestroyFontsImage() override;
 
+        static bool AssembleCompositeShaders( std::vector<uint32_t>& vertexShader, std::vector<uint32_t>& fragmentShader );
+
     private:
         VkDevice_Object* m_pDevice;
         VkQueue_Object* m_pGraphicsQueue;
 
         VkCommandPool m_CommandPool;
+        VkCommandPool m_RecordCommandPool;
         VkDescriptorPool m_DescriptorPool;
 
+        // Serializes the backend state updates between the UI thread and the present thread.
+        std::mutex m_Mutex;
+
         DeviceProfilerMemoryManager m_MemoryManager;
 
         bool m_Initialized : 1;
 
         bool m_ResetBackendsBeforeNextFrame : 1;
         bool m_VulkanBackendInitialized : 1;
+        bool m_RenderCacheEnabled : 1;
 
         OverlayLayerPlatformBackend* m_pPlatformBackend;
 
@@ -144,11 +158,60 @@ namespace Profiler
             bool RequiresUpload = false;
         };
 
+        struct RenderCache
+        {
+            VkRenderPass RenderPass = VK_NULL_HANDLE;
+            VkFramebuffer Framebuffer = VK_NULL_HANDLE;
+            ImageResource Image = {};
+
+            // The image contains premultiplied colors, so it is composited with a dedicated pipeline.
+            VkDescriptorSetLayout CompositeDescriptorSetLayout = VK_NULL_HANDLE;
+            VkPipelineLayout CompositePipelineLayout = VK_NULL_HANDLE;
+            VkPipeline CompositePipeline = VK_NULL_HANDLE;
+
+            uint64_t DrawDataHash = 0;
+            bool Valid = false;
+        };
+
+        // Overlay rendered in the previous frames, composited onto the swapchain images.
+        RenderCache m_RenderCache;
+
+        struct RecordedDrawData
+        {
+            VkCommandBuffer CommandBuffer = VK_NULL_HANDLE;
+            VkFence LastSubmittedFence = VK_NULL_HANDLE;
+            uint64_t DrawDataHash = 0;
+            bool RenderCache = false;
+        };
+
+        // Secondary command buffers recorded by the UI thread, used in the same order as the
+        // vertex buffers of the ImGui backend, so both are reused only after the GPU is done with them.
+        std::vector<RecordedDrawData> m_RecordedDrawData;
+        uint32_t m_ImGuiBufferCount;
+        uint32_t m_NextRecordedDrawDataIndex;
+        uint32_t m_LatestRecordedDrawDataIndex;
+        uint32_t m_SwapchainGeneration;
+
         void ResetMembers();
 
+        void ShutdownImGuiBackend();
+        void Render( ImDrawData* pDrawData, RecordedDrawData* pRecordedDrawData );
+        void RecordDrawCommands( VkCommandBuffer commandBuffer, ImDrawData* pDrawData, const RecordedDrawData* pRecordedDrawData );
+
+        VkResult AllocateRecordedDrawData();
+        void FreeRecordedDrawData();
+        void InvalidateRecordedDrawData();
+
         void DestroySwapchainResources();
         void ResetSwapchainMembers();
 
+        VkResult InitializeRenderCache();
+        VkResult CreateCompositePipeline();
+        void DestroyRenderCache();
+        void RecordRenderCacheCommands( VkCommandBuffer commandBuffer, ImDrawData* pDrawData, const RecordedDrawData* pRecordedDrawData );
+        void RecordCompositeCommands( VkCommandBuffer commandBuffer );
+        static uint64_t GetDrawDataHash( const ImDrawData* pDrawData );
+
         void RecordUploadCommands( VkCommandBuffer commandBuffer );
         void DestroyUploadResources();
         void DestroyResources();
@@ -159,6 +222,9 @@ namespace Profiler
         void RecordImageUploadCommands( VkCommandBuffer commandBuffer, ImageResource& image );
         void TransitionImageLayout( VkCommandBuffer commandBuffer, ImageResource& image, VkImageLayout oldLayout, VkImageLayout newLayout );
 
+        // Devices of the initialized backends, used by the functions loaded for ImGui.
+        static ConcurrentMap<VkDevice, VkDevice_Object*> Devices;
+
         static PFN_vkVoidFunction FunctionLoader( const char* pFunctionName, void* pUserData );
         static VkResult AllocateCommandBuffers(
             VkDevice device,
@@ -334,8 +334,7 @@ namespace Profiler
                 xcb_motion_notify_event_t* motionNotifyEvent =
                     reinterpret_cast<xcb_motion_notify_event_t*>(event);
 
-                io.MousePos.x = motionNotifyEvent->event_x;
-                io.MousePos.y = motionNotifyEvent->event_y;
+                io.AddMousePosEvent( motionNotifyEvent->event_x, motionNotifyEvent->event_y );
                 break;
             }
 
@@ -352,12 +351,12 @@ namespace Profiler
                     if( buttonPressEvent->detail == XCB_BUTTON_INDEX_1 ) button = 0;
                     if( buttonPressEvent->detail == XCB_BUTTON_INDEX_2 ) button = 2;
                     if( buttonPressEvent->detail == XCB_BUTTON_INDEX_3 ) button = 1;
-                    io.MouseDown[ button ] = true;
+                    io.AddMouseButtonEvent( button, true );
                 }
                 else
                 {
                     // TODO: scroll speed
-                    io.MouseWheel += (buttonPressEvent->detail == XCB_BUTTON_INDEX_4) ? 1 : -1;
+                    io.AddMouseWheelEvent( 0.0f, (buttonPressEvent->detail == XCB_BUTTON_INDEX_4) ? 1.0f : -1.0f );
                 }
                 break;
             }
@@ -375,7 +374,7 @@ namespace Profiler
                     if( buttonReleaseEvent->detail == XCB_BUTTON_INDEX_1 ) button = 0;
                     if( buttonReleaseEvent->detail == XCB_BUTTON_INDEX_2 ) button = 2;
                     if( buttonReleaseEvent->detail == XCB_BUTTON_INDEX_3 ) button = 1;
-                    io.MouseDown[ button ] = false;
+                    io.AddMouseButtonEvent( button, false );
                 }
                 break;
             }
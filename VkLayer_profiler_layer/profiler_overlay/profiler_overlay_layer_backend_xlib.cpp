@@ -247,8 +247,8 @@ namespace Profiler
             Unsorted );
 
         // Handle incoming input events
-        // Don't block if there are no pending events
-        while( XEventsQueued( m_Display, QueuedAlready ) )
+        // Read the events from the connection, but don't block if there are no pending events
+        while( XEventsQueued( m_Display, QueuedAfterReading ) )
         {
             XEvent event;
             // TODO: error check
@@ -320,8 +320,7 @@ namespace Profiler
             case MotionNotify:
             {
                 // Update mouse position
-                io.MousePos.x = event.xmotion.x;
-                io.MousePos.y = event.xmotion.y;
+                io.AddMousePosEvent( event.xmotion.x, event.xmotion.y );
                 break;
             }
 
@@ -335,12 +334,12 @@ namespace Profiler
                     if( event.xbutton.button == Button2 ) button = 2;
                     if( event.xbutton.button == Button3 ) button = 1;
                     // TODO: XGrabPointer?
-                    io.MouseDown[ button ] = true;
+                    io.AddMouseButtonEvent( button, true );
                 }
                 else
                 {
                     // TODO: scroll speed
-                    io.MouseWheel += event.xbutton.button == Button4 ? 1 : -1;
+                    io.AddMouseWheelEvent( 0.0f, event.xbutton.button == Button4 ? 1.0f : -1.0f );
                 }
                 break;
             }
@@ -354,7 +353,7 @@ namespace Profiler
                     if( event.xbutton.button == Button1 ) button = 0;
                     if( event.xbutton.button == Button2 ) button = 2;
                     if( event.xbutton.button == Button3 ) button = 1;
-                    io.MouseDown[ button ] = false;
+                    io.AddMouseButtonEvent( button, false );
                     // TODO: XUngrabPointer?
                 }
                 break;
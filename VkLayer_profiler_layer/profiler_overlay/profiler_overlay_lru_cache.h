@@ -0,0 +1,144 @@
+// Copyright (c) 2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace Profiler
+{
+    /***********************************************************************************\
+
+    Class:
+        OverlayLruCache
+
+    Description:
+        Cache of shared values bounded by their total size.
+
+        Values are inserted with no size and accounted once their size is known, so
+        the entries can be inserted before their values are computed. Least recently
+        used entries are evicted first. The most recently used entry is always kept.
+
+        The cache is not synchronized.
+
+    \***********************************************************************************/
+    template<typename KeyType, typename ValueType, typename HashType = std::hash<KeyType>>
+    class OverlayLruCache
+    {
+    public:
+        explicit OverlayLruCache( size_t maxSize )
+            : m_MaxSize( maxSize )
+            , m_Size( 0 )
+            , m_Entries()
+            , m_Index()
+        {
+        }
+
+        /***********************************************************************************\
+
+        Function:
+            Find
+
+        Description:
+            Returns the cached value and marks it as the most recently used one.
+            Returns nullptr if the key is not in the cache.
+
+        \***********************************************************************************/
+        std::shared_ptr<ValueType> Find( const KeyType& key )
+        {
+            auto it = m_Index.find( key );
+            if( it == m_Index.end() )
+            {
+                return nullptr;
+            }
+
+            m_Entries.splice( m_Entries.begin(), m_Entries, it->second );
+            return it->second->m_pValue;
+        }
+
+        /***********************************************************************************\
+
+        Function:
+            Insert
+
+        Description:
+            Inserts the value as the most recently used one. The key must not be in
+            the cache.
+
+        \***********************************************************************************/
+        void Insert( const KeyType& key, std::shared_ptr<ValueType> pValue )
+        {
+            m_Entries.push_front( { key, std::move( pValue ), 0 } );
+            m_Index.emplace( key, m_Entries.begin() );
+        }
+
+        /***********************************************************************************\
+
+        Function:
+            SetSize
+
+        Description:
+            Accounts the size of the value and evicts the least recently used entries
+            until the cache fits in the limit. Does not account the value if it has
+            already been evicted or replaced.
+
+        \***********************************************************************************/
+        void SetSize( const KeyType& key, const ValueType* pValue, size_t size )
+        {
+            auto it = m_Index.find( key );
+            if( ( it != m_Index.end() ) && ( it->second->m_pValue.get() == pValue ) )
+            {
+                m_Size += size - it->second->m_Size;
+                it->second->m_Size = size;
+            }
+
+            Trim();
+        }
+
+        size_t GetSize() const { return m_Size; }
+        size_t GetCount() const { return m_Entries.size(); }
+
+    private:
+        struct Entry
+        {
+            KeyType m_Key;
+            std::shared_ptr<ValueType> m_pValue;
+            size_t m_Size;
+        };
+
+        size_t m_MaxSize;
+        size_t m_Size;
+
+        std::list<Entry> m_Entries;
+        std::unordered_map<KeyType, typename std::list<Entry>::iterator, HashType> m_Index;
+
+        void Trim()
+        {
+            while( ( m_Size > m_MaxSize ) && ( m_Entries.size() > 1 ) )
+            {
+                const Entry& entry = m_Entries.back();
+                m_Size -= entry.m_Size;
+                m_Index.erase( entry.m_Key );
+                m_Entries.pop_back();
+            }
+        }
+    };
+}
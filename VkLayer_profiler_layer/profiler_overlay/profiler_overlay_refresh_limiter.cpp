@@ -0,0 +1,116 @@
+// Copyright (c) 2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "profiler_overlay_refresh_limiter.h"
+
+#include <imgui.h>
+
+namespace Profiler
+{
+    /***********************************************************************************\
+
+    Function:
+        OverlayRefreshLimiter
+
+    Description:
+        Constructor. The refresh rate is not limited by default.
+
+    \***********************************************************************************/
+    OverlayRefreshLimiter::OverlayRefreshLimiter()
+        : m_RefreshPeriod( Clock::duration::zero() )
+        , m_LastRefreshTime()
+    {
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        SetRefreshRate
+
+    Description:
+        Set the maximum number of UI refreshes per second.
+        Values lower than or equal to 0 disable the limit.
+
+    \***********************************************************************************/
+    void OverlayRefreshLimiter::SetRefreshRate( int refreshRate )
+    {
+        m_RefreshPeriod = Clock::duration::zero();
+        m_LastRefreshTime = Clock::time_point();
+
+        if( refreshRate > 0 )
+        {
+            m_RefreshPeriod = std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>( 1.0 / refreshRate ) );
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        IsEnabled
+
+    Description:
+        Check whether the refresh rate is limited.
+
+    \***********************************************************************************/
+    bool OverlayRefreshLimiter::IsEnabled() const
+    {
+        return m_RefreshPeriod > Clock::duration::zero();
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        IsRefreshRequired
+
+    Description:
+        Check whether the UI has to be rebuilt at the given time.
+        pDrawData is the draw data built in the last refresh, and inputPending must be
+        set if any input events were received since then.
+
+    \***********************************************************************************/
+    bool OverlayRefreshLimiter::IsRefreshRequired(
+        const ImDrawData* pDrawData,
+        const ImVec2& displaySize,
+        bool inputPending,
+        Clock::time_point now )
+    {
+        if( !IsEnabled() )
+        {
+            return true;
+        }
+
+        const bool refreshRequired =
+            ( pDrawData == nullptr ) ||
+            ( !pDrawData->Valid ) ||
+            ( pDrawData->DisplaySize.x != displaySize.x ) ||
+            ( pDrawData->DisplaySize.y != displaySize.y ) ||
+            ( inputPending ) ||
+            ( now - m_LastRefreshTime >= m_RefreshPeriod );
+
+        if( refreshRequired )
+        {
+            m_LastRefreshTime = now;
+        }
+
+        return refreshRequired;
+    }
+}
@@ -0,0 +1,63 @@
+// Copyright (c) 2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include <chrono>
+
+struct ImDrawData;
+struct ImVec2;
+
+namespace Profiler
+{
+    /***********************************************************************************\
+
+    Class:
+        OverlayRefreshLimiter
+
+    Description:
+        Decides whether the overlay UI has to be rebuilt in the current frame.
+
+        When the refresh rate is limited, the UI is rebuilt immediately after user input
+        or resize of the render area, and periodically to display the latest data.
+        Otherwise the previous draw data is rendered again from the backend's cache.
+
+    \***********************************************************************************/
+    class OverlayRefreshLimiter
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        OverlayRefreshLimiter();
+
+        void SetRefreshRate( int refreshRate );
+        bool IsEnabled() const;
+
+        bool IsRefreshRequired(
+            const ImDrawData* pDrawData,
+            const ImVec2& displaySize,
+            bool inputPending,
+            Clock::time_point now );
+
+    private:
+        Clock::duration m_RefreshPeriod;
+        Clock::time_point m_LastRefreshTime;
+    };
+}
@@ -19,15 +19,23 @@
 // SOFTWARE.
 
 #include "profiler_overlay_shader_view.h"
+#include "profiler_overlay_lru_cache.h"
 #include "profiler_overlay_resources.h"
 #include "profiler/profiler_shader.h"
 #include "profiler/profiler_helpers.h"
 #include "profiler/profiler_frontend.h"
 #include "profiler_layer_objects/VkDevice_object.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <string_view>
 #include <sstream>
 #include <filesystem>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
 #include <inttypes.h>
 
 #include <spirv/unified1/spirv.h>
@@ -40,6 +48,9 @@
 
 #include "imgui_widgets/imgui_ex.h"
 
+// Languages
+#include "lang/lang.h"
+
 #ifndef PROFILER_BUILD_SPIRV_DOCS
 #define PROFILER_BUILD_SPIRV_DOCS 0
 #endif
@@ -65,12 +76,43 @@ namespace
         std::unordered_map<uint32_t, const char*> m_pStrings;
     };
 
+    struct ShaderDisassemblyOutput
+    {
+        std::string         m_Name;
+        std::string         m_Data;
+        Profiler::ShaderFormat m_Format;
+    };
+
     struct SpirvCrossUserData
     {
-        Profiler::OverlayShaderView* m_pShaderView;
+        std::vector<ShaderDisassemblyOutput>* m_pOutputs;
         const char*         m_pTabName;
     };
 
+    struct ShaderDisassemblyKey
+    {
+        uint32_t            m_ShaderHash;
+        int                 m_SpvTargetEnv;
+        std::string         m_EntryPointName;
+
+        inline bool operator==( const ShaderDisassemblyKey& rh ) const
+        {
+            return m_ShaderHash == rh.m_ShaderHash &&
+                m_SpvTargetEnv == rh.m_SpvTargetEnv &&
+                m_EntryPointName == rh.m_EntryPointName;
+        }
+    };
+
+    struct ShaderDisassemblyKeyHash
+    {
+        inline size_t operator()( const ShaderDisassemblyKey& key ) const
+        {
+            return std::hash<std::string>()( key.m_EntryPointName ) ^
+                (static_cast<size_t>( key.m_ShaderHash ) << 8) ^
+                static_cast<size_t>( key.m_SpvTargetEnv );
+        }
+    };
+
     /***********************************************************************************\
 
     Function:
@@ -391,101 +433,131 @@ namespace
     /***********************************************************************************\
 
     Function:
-        GetSpirvLanguageDefinition
+        CreateSpirvLanguageDefinition
 
     Description:
-        Returns a reference to the spirv language definition for syntax highlighting.
+        Builds the spirv language definition for syntax highlighting.
 
     \***********************************************************************************/
-    static TextEditor::LanguageDefinition GetSpirvLanguageDefinition(
-        [[maybe_unused]] const Profiler::OverlayResources& resources,
-        [[maybe_unused]] bool& showSpirvDocs )
+    static TextEditor::LanguageDefinition CreateSpirvLanguageDefinition()
     {
-        static bool initialized = false;
-        static TextEditor::LanguageDefinition languageDefinition;
+        TextEditor::LanguageDefinition languageDefinition;
 
         // Precompiled regexes for tokenizing the SPIR-V language.
         static std::vector<std::pair<std::regex, TextEditor::PaletteIndex>> tokenRegexStrings;
 
-        if( !initialized )
-        {
-            // Initialize the language definition on the first call to this function.
-            languageDefinition.mName = "SPIR-V";
+        languageDefinition.mName = "SPIR-V";
 
-            // Tokenizer.
-            languageDefinition.mTokenize = []( const char* in_begin, const char* in_end, const char*& out_begin, const char*& out_end, TextEditor::PaletteIndex& paletteIndex ) -> bool {
-                std::cmatch results;
+        // Tokenizer.
+        languageDefinition.mTokenize = []( const char* in_begin, const char* in_end, const char*& out_begin, const char*& out_end, TextEditor::PaletteIndex& paletteIndex ) -> bool {
+            std::cmatch results;
 
-                while( in_begin < in_end && isascii( *in_begin ) && isblank( *in_begin ) )
-                {
-                    in_begin++;
-                }
+            while( in_begin < in_end && isascii( *in_begin ) && isblank( *in_begin ) )
+            {
+                in_begin++;
+            }
 
-                if( in_begin == in_end )
-                {
-                    out_begin = in_end;
-                    out_end = in_end;
-                    paletteIndex = TextEditor::PaletteIndex::Default;
-                    return true;
-                }
+            if( in_begin == in_end )
+            {
+                out_begin = in_end;
+                out_end = in_end;
+                paletteIndex = TextEditor::PaletteIndex::Default;
+                return true;
+            }
 
-                // Tokenize strings using a function to avoid stack overflow on Windows.
-                // https://developercommunity.visualstudio.com/t/grouping-within-repetition-causes-regex-stack-erro/885115
-                if( TokenizeSpirvLanguageString( in_begin, in_end, out_begin, out_end ) )
-                {
-                    paletteIndex = TextEditor::PaletteIndex::String;
-                    return true;
-                }
+            // Tokenize strings using a function to avoid stack overflow on Windows.
+            // https://developercommunity.visualstudio.com/t/grouping-within-repetition-causes-regex-stack-erro/885115
+            if( TokenizeSpirvLanguageString( in_begin, in_end, out_begin, out_end ) )
+            {
+                paletteIndex = TextEditor::PaletteIndex::String;
+                return true;
+            }
 
-                try
+            try
+            {
+                // Handle other tokens with regex.
+                for( const auto& [tokenRegex, index] : tokenRegexStrings )
                 {
-                    // Handle other tokens with regex.
-                    for( const auto& [tokenRegex, index] : tokenRegexStrings )
+                    if( std::regex_search( in_begin, in_end, results, tokenRegex, std::regex_constants::match_continuous ) )
                     {
-                        if( std::regex_search( in_begin, in_end, results, tokenRegex, std::regex_constants::match_continuous ) )
-                        {
-                            auto& v = *results.begin();
-                            out_begin = v.first;
-                            out_end = v.second;
-                            paletteIndex = index;
-                            return true;
-                        }
+                        auto& v = *results.begin();
+                        out_begin = v.first;
+                        out_end = v.second;
+                        paletteIndex = index;
+                        return true;
                     }
                 }
-                catch( const std::regex_error& )
+            }
+            catch( const std::regex_error& )
+            {
+                // Tokenization by regex failed, jump to the next word.
+                while( in_begin < in_end && isascii( *in_begin ) && !isblank( *in_begin ) )
                 {
-                    // Tokenization by regex failed, jump to the next word.
-                    while( in_begin < in_end && isascii( *in_begin ) && !isblank( *in_begin ) )
-                    {
-                        in_begin++;
-                    }
-
-                    out_begin = in_begin;
-                    out_end = in_end;
+                    in_begin++;
                 }
 
-                paletteIndex = TextEditor::PaletteIndex::Max;
-                return false;
-            };
+                out_begin = in_begin;
+                out_end = in_end;
+            }
 
-            tokenRegexStrings.push_back( std::pair( std::regex( "\\'\\\\?[^\\']\\'" ), TextEditor::PaletteIndex::CharLiteral ) );
-            tokenRegexStrings.push_back( std::pair( std::regex( "Op[a-zA-Z0-9]+" ), TextEditor::PaletteIndex::Keyword ) );
-            tokenRegexStrings.push_back( std::pair( std::regex( "[a-zA-Z_%][a-zA-Z0-9_]*" ), TextEditor::PaletteIndex::Identifier ) );
-            tokenRegexStrings.push_back( std::pair( std::regex( "[+-]?([0-9]+([.][0-9]*)?|[.][0-9]+)([eE][+-]?[0-9]+)?[fF]?" ), TextEditor::PaletteIndex::Number ) );
-            tokenRegexStrings.push_back( std::pair( std::regex( "[+-]?[0-9]+[Uu]?[lL]?[lL]?" ), TextEditor::PaletteIndex::Number ) );
-            tokenRegexStrings.push_back( std::pair( std::regex( "0[0-7]+[Uu]?[lL]?[lL]?" ), TextEditor::PaletteIndex::Number ) );
-            tokenRegexStrings.push_back( std::pair( std::regex( "0[xX][0-9a-fA-F]+[uU]?[lL]?[lL]?" ), TextEditor::PaletteIndex::Number ) );
-            tokenRegexStrings.push_back( std::pair( std::regex( "[\\[\\]\\{\\}\\!\\^\\&\\*\\(\\)\\-\\+\\=\\~\\|\\<\\>\\?\\/\\,\\.]" ), TextEditor::PaletteIndex::Punctuation ) );
-
-            // Comments.
-            languageDefinition.mSingleLineComment = ";";
-            languageDefinition.mCommentStart = ";";
-            languageDefinition.mCommentEnd = "\n";
-
-            // Parser options.
-            languageDefinition.mAutoIndentation = true;
-            languageDefinition.mCaseSensitive = true;
-        }
+            paletteIndex = TextEditor::PaletteIndex::Max;
+            return false;
+        };
+
+        tokenRegexStrings.push_back( std::pair( std::regex( "\\'\\\\?[^\\']\\'" ), TextEditor::PaletteIndex::CharLiteral ) );
+        tokenRegexStrings.push_back( std::pair( std::regex( "Op[a-zA-Z0-9]+" ), TextEditor::PaletteIndex::Keyword ) );
+        tokenRegexStrings.push_back( std::pair( std::regex( "[a-zA-Z_%][a-zA-Z0-9_]*" ), TextEditor::PaletteIndex::Identifier ) );
+        tokenRegexStrings.push_back( std::pair( std::regex( "[+-]?([0-9]+([.][0-9]*)?|[.][0-9]+)([eE][+-]?[0-9]+)?[fF]?" ), TextEditor::PaletteIndex::Number ) );
+        tokenRegexStrings.push_back( std::pair( std::regex( "[+-]?[0-9]+[Uu]?[lL]?[lL]?" ), TextEditor::PaletteIndex::Number ) );
+        tokenRegexStrings.push_back( std::pair( std::regex( "0[0-7]+[Uu]?[lL]?[lL]?" ), TextEditor::PaletteIndex::Number ) );
+        tokenRegexStrings.push_back( std::pair( std::regex( "0[xX][0-9a-fA-F]+[uU]?[lL]?[lL]?" ), TextEditor::PaletteIndex::Number ) );
+        tokenRegexStrings.push_back( std::pair( std::regex( "[\\[\\]\\{\\}\\!\\^\\&\\*\\(\\)\\-\\+\\=\\~\\|\\<\\>\\?\\/\\,\\.]" ), TextEditor::PaletteIndex::Punctuation ) );
+
+        // Comments.
+        languageDefinition.mSingleLineComment = ";";
+        languageDefinition.mCommentStart = ";";
+        languageDefinition.mCommentEnd = "\n";
+
+        // Parser options.
+        languageDefinition.mAutoIndentation = true;
+        languageDefinition.mCaseSensitive = true;
+
+        return languageDefinition;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        GetSpirvBaseLanguageDefinition
+
+    Description:
+        Returns a reference to the spirv language definition without the tooltips.
+
+        Compilation of the regexes is expensive, so the definition is built only once.
+        Initialization of the static is thread-safe, so it can be called from the
+        shader disassembler thread to have it ready before the view is opened.
+
+    \***********************************************************************************/
+    static const TextEditor::LanguageDefinition& GetSpirvBaseLanguageDefinition()
+    {
+        static const TextEditor::LanguageDefinition languageDefinition = CreateSpirvLanguageDefinition();
+        return languageDefinition;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        GetSpirvLanguageDefinition
+
+    Description:
+        Returns the spirv language definition for syntax highlighting.
+
+    \***********************************************************************************/
+    static TextEditor::LanguageDefinition GetSpirvLanguageDefinition(
+        [[maybe_unused]] const Profiler::OverlayResources& resources,
+        [[maybe_unused]] bool& showSpirvDocs )
+    {
+        TextEditor::LanguageDefinition languageDefinition = GetSpirvBaseLanguageDefinition();
 
 #if PROFILER_BUILD_SPIRV_DOCS
         // Documentation.
@@ -562,160 +634,671 @@ namespace
 
         return languageDefinition;
     }
-}
-
-namespace Profiler
-{
-    struct OverlayShaderView::ShaderRepresentation
-    {
-        const char*              m_pName;
-        const void*              m_pData;
-        size_t                   m_DataSize;
-        ShaderFormat             m_Format;
-    };
-
-    struct OverlayShaderView::ShaderExecutableRepresentation
-        : OverlayShaderView::ShaderRepresentation
-    {
-        ProfilerShaderExecutable m_Executable;
-        uint32_t                 m_InternalRepresentationIndex;
-    };
-
-    struct OverlayShaderView::ShaderExporter
-    {
-        IGFD::FileDialog       m_FileDialog;
-        IGFD::FileDialogConfig m_FileDialogConfig;
-        ShaderRepresentation*  m_pShaderRepresentation;
-        ShaderFormat           m_ShaderFormat;
-    };
 
     /***********************************************************************************\
 
     Function:
-        OverlayShaderView
+        AddShaderDisassemblyOutput
 
     Description:
-        Constructor.
+        Appends a shader representation to the disassembly outputs.
 
     \***********************************************************************************/
-    OverlayShaderView::OverlayShaderView( const OverlayResources& resources )
-        : m_Resources( resources )
-        , m_pTextEditor( nullptr )
-        , m_ShaderName( "shader" )
-        , m_EntryPointName( "main" )
-        , m_ShaderIdentifier()
-        , m_pShaderRepresentations( 0 )
-        , m_SpvTargetEnv( SPV_ENV_UNIVERSAL_1_0 )
-        , m_ShowSpirvDocs( PROFILER_BUILD_SPIRV_DOCS )
-        , m_ShowFullShaderIdentifier( false )
-        , m_CurrentTabIndex( -1 )
-        , m_DefaultWindowBgColor( 0 )
-        , m_DefaultTitleBgColor( 0 )
-        , m_DefaultTitleBgActiveColor( 0 )
-        , m_pShaderExporter( nullptr )
-        , m_ShaderSavedCallback( nullptr )
+    static void AddShaderDisassemblyOutput(
+        std::vector<ShaderDisassemblyOutput>& outputs,
+        const char* pName,
+        const void* pData,
+        size_t dataSize,
+        Profiler::ShaderFormat format )
     {
-        m_pTextEditor = std::make_unique<TextEditor>();
-        m_pTextEditor->SetReadOnly( true );
-        m_pTextEditor->SetShowWhitespaces( false );
+        ShaderDisassemblyOutput& output = outputs.emplace_back();
+        output.m_Name = pName;
+        output.m_Data.assign( static_cast<const char*>( pData ), dataSize );
+        output.m_Format = format;
     }
 
     /***********************************************************************************\
 
     Function:
-        ~OverlayShaderView
+        DisassembleSpirv
 
     Description:
-        Destructor.
-
-    \***********************************************************************************/
-    OverlayShaderView::~OverlayShaderView()
-    {
-        Clear();
-    }
-
-    /***********************************************************************************\
-
-    Function:
-        InitializeStyles
+        Disassembles the SPIR-V binary to a human-readable assembly code and returns it
+        as a "Disassembly" shader representation, followed by the embedded sources or
+        sources recompiled by the SPIR-V Cross.
 
-    Description:
-        Configures the shader viewer for the current ImGui style.
+        The function does not access any ImGui state, so it can be called from any thread.
 
     \***********************************************************************************/
-    void OverlayShaderView::InitializeStyles()
+    static void DisassembleSpirv(
+        spv_target_env targetEnv,
+        const std::string& entryPointName,
+        const uint32_t* pBinary,
+        size_t wordCount,
+        std::vector<ShaderDisassemblyOutput>& outputs )
     {
-        m_DefaultWindowBgColor = ImGui::GetColorU32( ImGuiCol_WindowBg );
-        m_DefaultTitleBgColor = ImGui::GetColorU32( ImGuiCol_TitleBg );
-        m_DefaultTitleBgActiveColor = ImGui::GetColorU32( ImGuiCol_TitleBgActive );
-    }
-
-    /***********************************************************************************\
-
-    Function:
-        SetTargetDevice
-
-    Description:
-        Selects the SPIR-V target env used for disassembling the shaders.
+        spv_context context = spvContextCreate( targetEnv );
+        spv_text text = nullptr;
+        spv_diagnostic diagnostic = nullptr;
 
-    \***********************************************************************************/
-    void OverlayShaderView::Initialize( DeviceProfilerFrontend& frontend )
-    {
-        m_SpvTargetEnv = SPV_ENV_UNIVERSAL_1_0;
+        // Parse the SPIR-V binary first and remove any instructions that will become redundant.
+        // This step is optional, so we ignore any diagnostic errors returned from this function.
+        SpirvParseOutputData parsedSpirv;
+        spv_result_t result = spvBinaryParse( context, &parsedSpirv, pBinary, wordCount, ParseSpirvHeader, ParseSpirvInstruction, nullptr );
 
-        // Select the target env based on the api version used by the application.
-        switch( frontend.GetApplicationInfo().apiVersion )
+        if( result == SPV_SUCCESS )
         {
-        default:
-        case VK_API_VERSION_1_0:
-            m_SpvTargetEnv = SPV_ENV_VULKAN_1_0;
-            break;
+            pBinary = parsedSpirv.m_Bytecode.data();
+            wordCount = parsedSpirv.m_Bytecode.size();
+        }
+        else
+        {
+            // Clear the data if the parsing failed to avoid using it in partially-loaded state.
+            parsedSpirv = {};
+        }
 
-        case VK_API_VERSION_1_1:
-            m_SpvTargetEnv = frontend.GetEnabledDeviceExtensions().count( VK_KHR_SPIRV_1_4_EXTENSION_NAME )
-                ? SPV_ENV_VULKAN_1_1_SPIRV_1_4
-                : SPV_ENV_VULKAN_1_1;
-            break;
+        // Disassembler options.
+        uint32_t options =
+            SPV_BINARY_TO_TEXT_OPTION_INDENT |
+            SPV_BINARY_TO_TEXT_OPTION_COMMENT |
+            SPV_BINARY_TO_TEXT_OPTION_FRIENDLY_NAMES;
 
-        case VK_API_VERSION_1_2:
-            m_SpvTargetEnv = SPV_ENV_VULKAN_1_2;
-            break;
+        // Disassemble the binary.
+        result = spvBinaryToText( context, pBinary, wordCount, options, &text, &diagnostic );
 
-        case VK_API_VERSION_1_3:
-            m_SpvTargetEnv = SPV_ENV_VULKAN_1_3;
-            break;
+        if( result == SPV_SUCCESS )
+        {
+            AddShaderDisassemblyOutput( outputs, "Disassembly", text->str, text->length, Profiler::ShaderFormat::eSpirv );
 
-        case VK_API_VERSION_1_4:
-            m_SpvTargetEnv = SPV_ENV_VULKAN_1_4;
-            break;
-        }
-    }
+            bool hasValidSources = false;
 
-    /***********************************************************************************\
+            for( Source& source : parsedSpirv.m_Sources )
+            {
+                // Skip sources with no embedded shader code.
+                if( source.m_Data.empty() )
+                {
+                    continue;
+                }
 
-    Function:
-        SetShaderName
+                // Extract filename of the embedded source.
+                const char* pFilename = parsedSpirv.m_pStrings[ source.m_FilenameStringID ];
+                if( !pFilename || !strlen( pFilename ) )
+                {
+                    pFilename = "Source";
+                }
 
-    Description:
-        Sets the currently displayed shader name.
-        The name is used to construct file names when saving the representations to file.
+                // Use the last path component for tab name.
+                const char* pBasename = strrchr( pFilename, '/' );
+                if( !pBasename )
+                {
+                    pBasename = strrchr( pFilename, '\\' );
+                }
 
-    \***********************************************************************************/
-    void OverlayShaderView::SetShaderName( const std::string& name )
-    {
-        m_ShaderName = name;
-    }
+                AddShaderDisassemblyOutput( outputs, pBasename ? pBasename + 1 : pFilename, source.m_Data.c_str(), source.m_Data.length() + 1,
+                    GetSpirvSourceShaderFormat( source.m_Language ) );
 
-    /***********************************************************************************\
+                hasValidSources = true;
+            }
 
-    Function:
-        SetEntryPointName
+            // Disassemble the binary to a source using the SPIR-V Cross if sources are not available.
+            if( !hasValidSources )
+            {
+                SpvSourceLanguage sourceLanguage = SpvSourceLanguageUnknown;
+                uint32_t sourceLanguageVersion = 0;
 
-    Description:
-        Sets the entry point name used by the shader module.
-        Required to correctly disassemble the SPIR-V binary into GLSL/HLSL.
+                if( !parsedSpirv.m_Sources.empty() )
+                {
+                    const Source& source = parsedSpirv.m_Sources.front();
+                    sourceLanguage = source.m_Language;
+                    sourceLanguageVersion = source.m_LanguageVersion;
 
-    \***********************************************************************************/
+                    // Check if all sources of the shader module use the same language.
+                    for( const Source& src : parsedSpirv.m_Sources )
+                    {
+                        if( src.m_Language != sourceLanguage )
+                        {
+                            sourceLanguage = SpvSourceLanguageUnknown;
+                            sourceLanguageVersion = 0;
+                            break;
+                        }
+                    }
+                }
+
+                if( sourceLanguage == SpvSourceLanguageUnknown )
+                {
+                    // Use the default language for the SPIR-V Cross.
+                    sourceLanguage = SpvSourceLanguageGLSL;
+                    sourceLanguageVersion = 460;
+                }
+
+                Profiler::ShaderFormat shaderFormat = GetSpirvSourceShaderFormat( sourceLanguage );
+
+                std::string tabName;
+                tabName += GetShaderLanguageName( shaderFormat );
+                tabName += " (SPIR-V Cross)";
+
+                // Create a SPIR-V Cross context.
+                spvc_context spvcContext = nullptr;
+                spvc_result spvcResult = spvc_context_create( &spvcContext );
+
+                if( spvcResult == SPVC_SUCCESS )
+                {
+                    SpirvCrossUserData userData = {};
+                    userData.m_pOutputs = &outputs;
+                    userData.m_pTabName = tabName.c_str();
+
+                    // Catch errors reported by the SPIR-V Cross and display them in the shader view.
+                    spvc_context_set_error_callback(
+                        spvcContext, []( void* pUserData, const char* message ) {
+                            SpirvCrossUserData* pData = static_cast<SpirvCrossUserData*>( pUserData );
+                            std::string errorMessage = "SPIR-V Cross error:\n";
+                            errorMessage.append( message );
+                            AddShaderDisassemblyOutput( *pData->m_pOutputs,
+                                pData->m_pTabName, errorMessage.c_str(), errorMessage.length(), Profiler::ShaderFormat::eText );
+                        },
+                        &userData );
+
+                    // Parse the SPIR-V binary into an intermediate representation.
+                    spvc_parsed_ir spvcParsedIR = nullptr;
+                    spvcResult = spvc_context_parse_spirv( spvcContext, pBinary, wordCount, &spvcParsedIR );
+
+                    if( spvcResult == SPVC_SUCCESS )
+                    {
+                        spvc_backend spvcCompilerBackend = GetSpirvCrossBackend( sourceLanguage );
+
+                        // Create a compiler for the parsed SPIR-V binary.
+                        spvc_compiler spvcCompiler = nullptr;
+                        spvcResult = spvc_context_create_compiler(
+                            spvcContext,
+                            spvcCompilerBackend,
+                            spvcParsedIR,
+                            SPVC_CAPTURE_MODE_TAKE_OWNERSHIP,
+                            &spvcCompiler );
+
+                        if( spvcResult == SPVC_SUCCESS )
+                        {
+                            // Find the entry point used in the viewed shader module.
+                            size_t spvcEntryPointCount = 0;
+                            const spvc_entry_point* pSpvcEntryPoints = nullptr;
+                            spvc_compiler_get_entry_points( spvcCompiler, &pSpvcEntryPoints, &spvcEntryPointCount );
+
+                            size_t entryPointIndex = 0;
+                            for( size_t i = 0; i < spvcEntryPointCount; ++i )
+                            {
+                                if( strcmp( pSpvcEntryPoints[ i ].name, entryPointName.c_str() ) == 0 )
+                                {
+                                    entryPointIndex = i;
+                                    break;
+                                }
+                            }
+
+                            spvc_compiler_set_entry_point(
+                                spvcCompiler, pSpvcEntryPoints[ entryPointIndex ].name, pSpvcEntryPoints[ entryPointIndex ].execution_model );
+
+                            // Configure the compiler.
+                            spvc_compiler_options options = nullptr;
+                            spvc_compiler_create_compiler_options( spvcCompiler, &options );
+
+                            switch( sourceLanguage )
+                            {
+                            case SpvSourceLanguageESSL:
+                                spvc_compiler_options_set_bool( options, SPVC_COMPILER_OPTION_GLSL_ES, true );
+                                [[fallthrough]];
+
+                            case SpvSourceLanguageGLSL:
+                                spvc_compiler_options_set_uint( options, SPVC_COMPILER_OPTION_GLSL_VERSION, sourceLanguageVersion );
+                                spvc_compiler_options_set_bool( options, SPVC_COMPILER_OPTION_GLSL_VULKAN_SEMANTICS, true );
+                                break;
+
+                            case SpvSourceLanguageHLSL:
+                                spvc_compiler_options_set_uint( options, SPVC_COMPILER_OPTION_HLSL_SHADER_MODEL, sourceLanguageVersion );
+                                break;
+                            }
+
+                            spvc_compiler_install_compiler_options( spvcCompiler, options );
+
+                            // Compile the SPIR-V binary.
+                            const char* pSource = nullptr;
+                            spvcResult = spvc_compiler_compile( spvcCompiler, &pSource );
+
+                            if( spvcResult == SPVC_SUCCESS )
+                            {
+                                AddShaderDisassemblyOutput( outputs,
+                                    tabName.c_str(), pSource, strlen( pSource ), shaderFormat );
+                            }
+                        }
+                    }
+
+                    spvc_context_destroy( spvcContext );
+                }
+            }
+        }
+
+        if( result != SPV_SUCCESS )
+        {
+            // Report an error if the SPIR-V binary parsing failed.
+            std::string errorMessage = "Failed to parse SPIR-V binary";
+
+            if( diagnostic )
+            {
+                errorMessage += ":\n";
+                errorMessage += diagnostic->error;
+
+                if( diagnostic->isTextSource )
+                {
+                    errorMessage += " (line " + std::to_string( diagnostic->position.line ) + "," + std::to_string( diagnostic->position.column ) + ")";
+                }
+                else
+                {
+                    errorMessage += " (word " + std::to_string( diagnostic->position.index ) + ")";
+                }
+            }
+
+            AddShaderDisassemblyOutput( outputs, "Disassembly", errorMessage.c_str(), errorMessage.length(), Profiler::ShaderFormat::eText );
+        }
+
+        spvDiagnosticDestroy( diagnostic );
+        spvTextDestroy( text );
+        spvContextDestroy( context );
+    }
+}
+
+namespace Profiler
+{
+    struct OverlayShaderView::ShaderRepresentation
+    {
+        const char*              m_pName;
+        const void*              m_pData;
+        size_t                   m_DataSize;
+        ShaderFormat             m_Format;
+    };
+
+    struct OverlayShaderView::ShaderExecutableRepresentation
+        : OverlayShaderView::ShaderRepresentation
+    {
+        ProfilerShaderExecutable m_Executable;
+        uint32_t                 m_InternalRepresentationIndex;
+    };
+
+    struct OverlayShaderView::ShaderExporter
+    {
+        IGFD::FileDialog       m_FileDialog;
+        IGFD::FileDialogConfig m_FileDialogConfig;
+        ShaderRepresentation*  m_pShaderRepresentation;
+        ShaderFormat           m_ShaderFormat;
+    };
+
+    struct OverlayShaderView::ShaderDisassembly
+    {
+        ShaderDisassemblyKey                 m_Key = {};
+        std::vector<ShaderDisassemblyOutput> m_Outputs = {};
+        size_t                               m_Size = 0;
+        std::atomic_bool                     m_Ready = false;
+    };
+
+    /***********************************************************************************\
+
+    Class:
+        ShaderDisassembler
+
+    Description:
+        Disassembles SPIR-V binaries in the background and caches the results, so that
+        the shaders opened in the inspector don't stall the application's present.
+
+        The cache is shared by all inspector sessions and is bounded by the total size
+        of the shader representations. Least recently used entries are evicted first.
+
+    \***********************************************************************************/
+    class OverlayShaderView::ShaderDisassembler
+    {
+    public:
+        ShaderDisassembler( bool enableThreading );
+        ~ShaderDisassembler();
+
+        std::shared_ptr<ShaderDisassembly> Disassemble( const ShaderDisassemblyKey& key, const uint32_t* pBinary, size_t wordCount );
+
+    private:
+        struct Request
+        {
+            std::shared_ptr<ShaderDisassembly> m_pDisassembly;
+            std::vector<uint32_t>              m_Bytecode;
+        };
+
+        // Max total size of the cached shader representations.
+        static constexpr size_t m_scMaxCacheSize = 64 * 1024 * 1024;
+
+        std::mutex                         m_Mutex;
+
+        OverlayLruCache<ShaderDisassemblyKey, ShaderDisassembly, ShaderDisassemblyKeyHash> m_Cache;
+
+        std::thread                        m_Thread;
+        std::condition_variable            m_InputAvailable;
+        std::queue<Request>                m_Requests;
+        bool                               m_QuitSignal;
+
+        void ThreadProc();
+
+        static void Process( ShaderDisassembly& disassembly, const uint32_t* pBinary, size_t wordCount );
+        void Complete( ShaderDisassembly& disassembly );
+    };
+
+    /***********************************************************************************\
+
+    Function:
+        ShaderDisassembler
+
+    Description:
+        Constructor.
+
+    \***********************************************************************************/
+    OverlayShaderView::ShaderDisassembler::ShaderDisassembler( bool enableThreading )
+        : m_Mutex()
+        , m_Cache( m_scMaxCacheSize )
+        , m_Thread()
+        , m_InputAvailable()
+        , m_Requests()
+        , m_QuitSignal( false )
+    {
+        if( enableThreading )
+        {
+            m_Thread = std::thread( &ShaderDisassembler::ThreadProc, this );
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        ~ShaderDisassembler
+
+    Description:
+        Destructor. Stops the disassembler thread and drops the pending requests.
+
+    \***********************************************************************************/
+    OverlayShaderView::ShaderDisassembler::~ShaderDisassembler()
+    {
+        std::unique_lock lock( m_Mutex );
+        m_QuitSignal = true;
+        m_InputAvailable.notify_all();
+        lock.unlock();
+
+        if( m_Thread.joinable() )
+        {
+            m_Thread.join();
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        Disassemble
+
+    Description:
+        Returns the cached disassembly of the shader, or schedules the disassembly and
+        returns an entry that will become ready once the worker thread completes it.
+
+        If threading is disabled, the shader is disassembled immediately.
+
+    \***********************************************************************************/
+    std::shared_ptr<OverlayShaderView::ShaderDisassembly> OverlayShaderView::ShaderDisassembler::Disassemble(
+        const ShaderDisassemblyKey& key,
+        const uint32_t* pBinary,
+        size_t wordCount )
+    {
+        std::scoped_lock lock( m_Mutex );
+
+        std::shared_ptr<ShaderDisassembly> pDisassembly = m_Cache.Find( key );
+        if( pDisassembly )
+        {
+            return pDisassembly;
+        }
+
+        pDisassembly = std::make_shared<ShaderDisassembly>();
+        pDisassembly->m_Key = key;
+
+        // Pending entries are not accounted in the cache size until they are completed.
+        m_Cache.Insert( key, pDisassembly );
+
+        if( m_Thread.joinable() )
+        {
+            // Copy the bytecode, the caller's data may be released before the request is processed.
+            Request& request = m_Requests.emplace();
+            request.m_pDisassembly = pDisassembly;
+            request.m_Bytecode.assign( pBinary, pBinary + wordCount );
+
+            m_InputAvailable.notify_one();
+        }
+        else
+        {
+            Process( *pDisassembly, pBinary, wordCount );
+            Complete( *pDisassembly );
+        }
+
+        return pDisassembly;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        ThreadProc
+
+    Description:
+        Processes the queued disassembly requests.
+
+    \***********************************************************************************/
+    void OverlayShaderView::ShaderDisassembler::ThreadProc()
+    {
+        std::unique_lock lock( m_Mutex );
+
+        while( !m_QuitSignal )
+        {
+            m_InputAvailable.wait( lock, [this]
+                { return !m_Requests.empty() || m_QuitSignal; } );
+
+            while( !m_Requests.empty() && !m_QuitSignal )
+            {
+                Request request = std::move( m_Requests.front() );
+                m_Requests.pop();
+                lock.unlock();
+
+                Process( *request.m_pDisassembly, request.m_Bytecode.data(), request.m_Bytecode.size() );
+
+                lock.lock();
+                Complete( *request.m_pDisassembly );
+            }
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        Process
+
+    Description:
+        Disassembles the shader and prepares the syntax highlighting rules.
+        Must not access any shared state of the disassembler.
+
+    \***********************************************************************************/
+    void OverlayShaderView::ShaderDisassembler::Process( ShaderDisassembly& disassembly, const uint32_t* pBinary, size_t wordCount )
+    {
+        DisassembleSpirv(
+            static_cast<spv_target_env>( disassembly.m_Key.m_SpvTargetEnv ),
+            disassembly.m_Key.m_EntryPointName,
+            pBinary,
+            wordCount,
+            disassembly.m_Outputs );
+
+        size_t size = sizeof( ShaderDisassembly );
+        bool hasSpirvOutput = false;
+
+        for( const ShaderDisassemblyOutput& output : disassembly.m_Outputs )
+        {
+            size += output.m_Name.size() + output.m_Data.size();
+            hasSpirvOutput |= (output.m_Format == ShaderFormat::eSpirv);
+        }
+
+        if( hasSpirvOutput )
+        {
+            // Build the syntax highlighting rules before the view needs them.
+            GetSpirvBaseLanguageDefinition();
+        }
+
+        disassembly.m_Size = size;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        Complete
+
+    Description:
+        Marks the disassembly as ready and accounts its size in the cache.
+        m_Mutex must be locked before calling this function.
+
+    \***********************************************************************************/
+    void OverlayShaderView::ShaderDisassembler::Complete( ShaderDisassembly& disassembly )
+    {
+        // The entry may have already been evicted from the cache.
+        m_Cache.SetSize( disassembly.m_Key, &disassembly, disassembly.m_Size );
+
+        disassembly.m_Ready = true;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        OverlayShaderView
+
+    Description:
+        Constructor.
+
+    \***********************************************************************************/
+    OverlayShaderView::OverlayShaderView( const OverlayResources& resources )
+        : m_Resources( resources )
+        , m_pTextEditor( nullptr )
+        , m_ShaderName( "shader" )
+        , m_EntryPointName( "main" )
+        , m_ShaderIdentifier()
+        , m_pShaderRepresentations( 0 )
+        , m_SpvTargetEnv( SPV_ENV_UNIVERSAL_1_0 )
+        , m_ShowSpirvDocs( PROFILER_BUILD_SPIRV_DOCS )
+        , m_ShowFullShaderIdentifier( false )
+        , m_CurrentTabIndex( -1 )
+        , m_DefaultWindowBgColor( 0 )
+        , m_DefaultTitleBgColor( 0 )
+        , m_DefaultTitleBgActiveColor( 0 )
+        , m_pShaderExporter( nullptr )
+        , m_ShaderSavedCallback( nullptr )
+        , m_pShaderDisassembler( nullptr )
+        , m_pPendingShaderDisassembly( nullptr )
+    {
+        m_pTextEditor = std::make_unique<TextEditor>();
+        m_pTextEditor->SetReadOnly( true );
+        m_pTextEditor->SetShowWhitespaces( false );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        ~OverlayShaderView
+
+    Description:
+        Destructor.
+
+    \***********************************************************************************/
+    OverlayShaderView::~OverlayShaderView()
+    {
+        Clear();
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        InitializeStyles
+
+    Description:
+        Configures the shader viewer for the current ImGui style.
+
+    \***********************************************************************************/
+    void OverlayShaderView::InitializeStyles()
+    {
+        m_DefaultWindowBgColor = ImGui::GetColorU32( ImGuiCol_WindowBg );
+        m_DefaultTitleBgColor = ImGui::GetColorU32( ImGuiCol_TitleBg );
+        m_DefaultTitleBgActiveColor = ImGui::GetColorU32( ImGuiCol_TitleBgActive );
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        SetTargetDevice
+
+    Description:
+        Selects the SPIR-V target env used for disassembling the shaders.
+
+    \***********************************************************************************/
+    void OverlayShaderView::Initialize( DeviceProfilerFrontend& frontend )
+    {
+        m_SpvTargetEnv = SPV_ENV_UNIVERSAL_1_0;
+
+        // Select the target env based on the api version used by the application.
+        switch( frontend.GetApplicationInfo().apiVersion )
+        {
+        default:
+        case VK_API_VERSION_1_0:
+            m_SpvTargetEnv = SPV_ENV_VULKAN_1_0;
+            break;
+
+        case VK_API_VERSION_1_1:
+            m_SpvTargetEnv = frontend.GetEnabledDeviceExtensions().count( VK_KHR_SPIRV_1_4_EXTENSION_NAME )
+                ? SPV_ENV_VULKAN_1_1_SPIRV_1_4
+                : SPV_ENV_VULKAN_1_1;
+            break;
+
+        case VK_API_VERSION_1_2:
+            m_SpvTargetEnv = SPV_ENV_VULKAN_1_2;
+            break;
+
+        case VK_API_VERSION_1_3:
+            m_SpvTargetEnv = SPV_ENV_VULKAN_1_3;
+            break;
+
+        case VK_API_VERSION_1_4:
+            m_SpvTargetEnv = SPV_ENV_VULKAN_1_4;
+            break;
+        }
+
+        // Keep the disassembly cache if the view is reinitialized.
+        if( !m_pShaderDisassembler )
+        {
+            m_pShaderDisassembler = std::make_unique<ShaderDisassembler>(
+                frontend.GetProfilerConfig().m_EnableThreading );
+        }
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        SetShaderName
+
+    Description:
+        Sets the currently displayed shader name.
+        The name is used to construct file names when saving the representations to file.
+
+    \***********************************************************************************/
+    void OverlayShaderView::SetShaderName( const std::string& name )
+    {
+        m_ShaderName = name;
+    }
+
+    /***********************************************************************************\
+
+    Function:
+        SetEntryPointName
+
+    Description:
+        Sets the entry point name used by the shader module.
+        Required to correctly disassemble the SPIR-V binary into GLSL/HLSL.
+
+    \***********************************************************************************/
     void OverlayShaderView::SetEntryPointName( const std::string& name )
     {
         m_EntryPointName = name;
@@ -779,6 +1362,7 @@ namespace Profiler
         m_EntryPointName = "main";
         m_ShaderIdentifier.clear();
         m_pShaderRepresentations.clear();
+        m_pPendingShaderDisassembly.reset();
         m_ShowFullShaderIdentifier = false;
 
         // Reset current tab index.
@@ -794,232 +1378,99 @@ namespace Profiler
         Disassembles the SPIR-V binary to a human-readable assembly code and adds it
         as a "Disassembly" shader representation.
 
+        Disassembly runs in the background. Until it is ready, a placeholder tab is
+        displayed in place of the shader representations.
+
     \***********************************************************************************/
-    void OverlayShaderView::AddBytecode( const uint32_t* pBinary, size_t wordCount )
+    void OverlayShaderView::AddBytecode( uint32_t shaderHash, const uint32_t* pBinary, size_t wordCount )
     {
-        spv_context context = spvContextCreate( static_cast<spv_target_env>(m_SpvTargetEnv) );
-        spv_text text = nullptr;
-        spv_diagnostic diagnostic = nullptr;
-
-        // Parse the SPIR-V binary first and remove any instructions that will become redundant.
-        // This step is optional, so we ignore any diagnostic errors returned from this function.
-        SpirvParseOutputData parsedSpirv;
-        spv_result_t result = spvBinaryParse( context, &parsedSpirv, pBinary, wordCount, ParseSpirvHeader, ParseSpirvInstruction, nullptr );
-
-        if( result == SPV_SUCCESS )
-        {
-            pBinary = parsedSpirv.m_Bytecode.data();
-            wordCount = parsedSpirv.m_Bytecode.size();
-        }
-        else
+        if( !m_pShaderDisassembler )
         {
-            // Clear the data if the parsing failed to avoid using it in partially-loaded state.
-            parsedSpirv = {};
+            m_pShaderDisassembler = std::make_unique<ShaderDisassembler>( true /*enableThreading*/ );
         }
 
-        // Disassembler options.
-        uint32_t options =
-            SPV_BINARY_TO_TEXT_OPTION_INDENT |
-            SPV_BINARY_TO_TEXT_OPTION_COMMENT |
-            SPV_BINARY_TO_TEXT_OPTION_FRIENDLY_NAMES;
+        ShaderDisassemblyKey key = {};
+        key.m_ShaderHash = shaderHash;
+        key.m_SpvTargetEnv = m_SpvTargetEnv;
+        key.m_EntryPointName = m_EntryPointName;
 
-        // Disassemble the binary.
-        result = spvBinaryToText( context, pBinary, wordCount, options, &text, &diagnostic );
+        std::shared_ptr<ShaderDisassembly> pDisassembly =
+            m_pShaderDisassembler->Disassemble( key, pBinary, wordCount );
 
-        if( result == SPV_SUCCESS )
+        if( pDisassembly->m_Ready )
         {
-            AddShaderRepresentation( "Disassembly", text->str, text->length, ShaderFormat::eSpirv );
-
-            bool hasValidSources = false;
-
-            for( Source& source : parsedSpirv.m_Sources )
-            {
-                // Skip sources with no embedded shader code.
-                if( source.m_Data.empty() )
-                {
-                    continue;
-                }
-
-                // Extract filename of the embedded source.
-                const char* pFilename = parsedSpirv.m_pStrings[ source.m_FilenameStringID ];
-                if( !pFilename || !strlen( pFilename ) )
-                {
-                    pFilename = "Source";
-                }
-
-                // Use the last path component for tab name.
-                const char* pBasename = strrchr( pFilename, '/' );
-                if( !pBasename )
-                {
-                    pBasename = strrchr( pFilename, '\\' );
-                }
-
-                AddShaderRepresentation( pBasename ? pBasename + 1 : pFilename, source.m_Data.c_str(), source.m_Data.length() + 1,
-                    GetSpirvSourceShaderFormat( source.m_Language ) );
-
-                hasValidSources = true;
-            }
-
-            // Disassemble the binary to a source using the SPIR-V Cross if sources are not available.
-            if( !hasValidSources )
-            {
-                SpvSourceLanguage sourceLanguage = SpvSourceLanguageUnknown;
-                uint32_t sourceLanguageVersion = 0;
-
-                if( !parsedSpirv.m_Sources.empty() )
-                {
-                    const Source& source = parsedSpirv.m_Sources.front();
-                    sourceLanguage = source.m_Language;
-                    sourceLanguageVersion = source.m_LanguageVersion;
-
-                    // Check if all sources of the shader module use the same language.
-                    for( const Source& src : parsedSpirv.m_Sources )
-                    {
-                        if( src.m_Language != sourceLanguage )
-                        {
-                            sourceLanguage = SpvSourceLanguageUnknown;
-                            sourceLanguageVersion = 0;
-                            break;
-                        }
-                    }
-                }
-
-                if( sourceLanguage == SpvSourceLanguageUnknown )
-                {
-                    // Use the default language for the SPIR-V Cross.
-                    sourceLanguage = SpvSourceLanguageGLSL;
-                    sourceLanguageVersion = 460;
-                }
-
-                Profiler::ShaderFormat shaderFormat = GetSpirvSourceShaderFormat( sourceLanguage );
-
-                std::string tabName;
-                tabName += GetShaderLanguageName( shaderFormat );
-                tabName += " (SPIR-V Cross)";
-
-                // Create a SPIR-V Cross context.
-                spvc_context spvcContext = nullptr;
-                spvc_result spvcResult = spvc_context_create( &spvcContext );
-
-                if( spvcResult == SPVC_SUCCESS )
-                {
-                    SpirvCrossUserData userData = {};
-                    userData.m_pShaderView = this;
-                    userData.m_pTabName = tabName.c_str();
-
-                    // Catch errors reported by the SPIR-V Cross and display them in the shader view.
-                    spvc_context_set_error_callback(
-                        spvcContext, []( void* pUserData, const char* message ) {
-                            SpirvCrossUserData* pData = static_cast<SpirvCrossUserData*>( pUserData );
-                            std::string errorMessage = "SPIR-V Cross error:\n";
-                            errorMessage.append( message );
-                            pData->m_pShaderView->AddShaderRepresentation(
-                                pData->m_pTabName, errorMessage.c_str(), errorMessage.length(), ShaderFormat::eText );
-                        },
-                        &userData );
-
-                    // Parse the SPIR-V binary into an intermediate representation.
-                    spvc_parsed_ir spvcParsedIR = nullptr;
-                    spvcResult = spvc_context_parse_spirv( spvcContext, pBinary, wordCount, &spvcParsedIR );
-
-                    if( spvcResult == SPVC_SUCCESS )
-                    {
-                        spvc_backend spvcCompilerBackend = GetSpirvCrossBackend( sourceLanguage );
-
-                        // Create a compiler for the parsed SPIR-V binary.
-                        spvc_compiler spvcCompiler = nullptr;
-                        spvcResult = spvc_context_create_compiler(
-                            spvcContext,
-                            spvcCompilerBackend,
-                            spvcParsedIR,
-                            SPVC_CAPTURE_MODE_TAKE_OWNERSHIP,
-                            &spvcCompiler );
+            AddShaderDisassembly( *pDisassembly, m_pShaderRepresentations.size() );
+            return;
+        }
 
-                        if( spvcResult == SPVC_SUCCESS )
-                        {
-                            // Find the entry point used in the viewed shader module.
-                            size_t spvcEntryPointCount = 0;
-                            const spvc_entry_point* pSpvcEntryPoints = nullptr;
-                            spvc_compiler_get_entry_points( spvcCompiler, &pSpvcEntryPoints, &spvcEntryPointCount );
+        AddShaderRepresentation( "Disassembly", nullptr, 0, m_scPendingShaderFormat );
+        m_pPendingShaderDisassembly = std::move( pDisassembly );
+    }
 
-                            size_t entryPointIndex = 0;
-                            for( size_t i = 0; i < spvcEntryPointCount; ++i )
-                            {
-                                if( strcmp( pSpvcEntryPoints[ i ].name, m_EntryPointName.c_str() ) == 0 )
-                                {
-                                    entryPointIndex = i;
-                                    break;
-                                }
-                            }
+    /***********************************************************************************\
 
-                            spvc_compiler_set_entry_point(
-                                spvcCompiler, pSpvcEntryPoints[ entryPointIndex ].name, pSpvcEntryPoints[ entryPointIndex ].execution_model );
+    Function:
+        AddShaderDisassembly
 
-                            // Configure the compiler.
-                            spvc_compiler_options options = nullptr;
-                            spvc_compiler_create_compiler_options( spvcCompiler, &options );
+    Description:
+        Inserts the disassembled shader representations at the given index.
 
-                            switch( sourceLanguage )
-                            {
-                            case SpvSourceLanguageESSL:
-                                spvc_compiler_options_set_bool( options, SPVC_COMPILER_OPTION_GLSL_ES, true );
-                                [[fallthrough]];
+    \***********************************************************************************/
+    void OverlayShaderView::AddShaderDisassembly( const ShaderDisassembly& disassembly, size_t index )
+    {
+        const size_t firstIndex = m_pShaderRepresentations.size();
 
-                            case SpvSourceLanguageGLSL:
-                                spvc_compiler_options_set_uint( options, SPVC_COMPILER_OPTION_GLSL_VERSION, sourceLanguageVersion );
-                                spvc_compiler_options_set_bool( options, SPVC_COMPILER_OPTION_GLSL_VULKAN_SEMANTICS, true );
-                                break;
+        for( const ShaderDisassemblyOutput& output : disassembly.m_Outputs )
+        {
+            AddShaderRepresentation(
+                output.m_Name.c_str(),
+                output.m_Data.data(),
+                output.m_Data.size(),
+                output.m_Format );
+        }
 
-                            case SpvSourceLanguageHLSL:
-                                spvc_compiler_options_set_uint( options, SPVC_COMPILER_OPTION_HLSL_SHADER_MODEL, sourceLanguageVersion );
-                                break;
-                            }
+        // Move the new representations to the requested position.
+        std::rotate(
+            m_pShaderRepresentations.begin() + index,
+            m_pShaderRepresentations.begin() + firstIndex,
+            m_pShaderRepresentations.end() );
+    }
 
-                            spvc_compiler_install_compiler_options( spvcCompiler, options );
+    /***********************************************************************************\
 
-                            // Compile the SPIR-V binary.
-                            const char* pSource = nullptr;
-                            spvcResult = spvc_compiler_compile( spvcCompiler, &pSource );
+    Function:
+        UpdatePendingShaderDisassembly
 
-                            if( spvcResult == SPVC_SUCCESS )
-                            {
-                                AddShaderRepresentation(
-                                    tabName.c_str(), pSource, strlen( pSource ), shaderFormat );
-                            }
-                        }
-                    }
+    Description:
+        Replaces the placeholder with the shader representations once the background
+        disassembly is completed.
 
-                    spvc_context_destroy( spvcContext );
-                }
-            }
+    \***********************************************************************************/
+    void OverlayShaderView::UpdatePendingShaderDisassembly()
+    {
+        if( !m_pPendingShaderDisassembly || !m_pPendingShaderDisassembly->m_Ready )
+        {
+            return;
         }
 
-        if( result != SPV_SUCCESS )
+        auto it = std::find_if( m_pShaderRepresentations.begin(), m_pShaderRepresentations.end(),
+            []( const ShaderRepresentation* pShaderRepresentation )
+            { return pShaderRepresentation->m_Format == m_scPendingShaderFormat; } );
+
+        if( it != m_pShaderRepresentations.end() )
         {
-            // Report an error if the SPIR-V binary parsing failed.
-            std::string errorMessage = "Failed to parse SPIR-V binary";
+            const size_t index = std::distance( m_pShaderRepresentations.begin(), it );
 
-            if( diagnostic )
-            {
-                errorMessage += ":\n";
-                errorMessage += diagnostic->error;
+            free( *it );
+            m_pShaderRepresentations.erase( it );
 
-                if( diagnostic->isTextSource )
-                {
-                    errorMessage += " (line " + std::to_string( diagnostic->position.line ) + "," + std::to_string( diagnostic->position.column ) + ")";
-                }
-                else
-                {
-                    errorMessage += " (word " + std::to_string( diagnostic->position.index ) + ")";
-                }
-            }
+            AddShaderDisassembly( *m_pPendingShaderDisassembly, index );
 
-            AddShaderRepresentation( "Disassembly", errorMessage.c_str(), errorMessage.length(), ShaderFormat::eText );
+            // Reload the text editor with the new contents of the current tab.
+            m_CurrentTabIndex = -1;
         }
 
-        spvDiagnosticDestroy( diagnostic );
-        spvTextDestroy( text );
-        spvContextDestroy( context );
+        m_pPendingShaderDisassembly.reset();
     }
 
     /***********************************************************************************\
@@ -1127,6 +1578,8 @@ namespace Profiler
     \***********************************************************************************/
     void OverlayShaderView::Draw()
     {
+        UpdatePendingShaderDisassembly();
+
         ImGui::PushFont( m_Resources.GetDefaultFont() );
         ImGui::PushStyleVar( ImGuiStyleVar_TabRounding, 0.0f );
 
@@ -1178,6 +1631,16 @@ namespace Profiler
                 }
             }
 
+            // Show a placeholder until the shader is disassembled.
+            if( shaderRepresentationFormat == m_scPendingShaderFormat )
+            {
+                ImGui::PushStyleColor( ImGuiCol_Text, IM_COL32( 128, 128, 128, 255 ) );
+                ImGui::TextUnformatted( Lang::ShaderDisassemblyPending );
+                ImGui::PopStyleColor();
+                ImGui::EndTabItem();
+                return;
+            }
+
             // Early out if shader representation data is not available.
             if( !pShaderRepresentation->m_pData )
             {
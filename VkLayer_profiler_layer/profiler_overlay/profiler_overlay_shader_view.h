@@ -82,7 +82,7 @@ namespace Profiler
 
         void Clear();
 
-        void AddBytecode( const uint32_t* pBinary, size_t wordCount );
+        void AddBytecode( uint32_t shaderHash, const uint32_t* pBinary, size_t wordCount );
         void AddShaderRepresentation( const char* pName, const void* pData, size_t dataSize, ShaderFormat format );
         void AddShaderExecutable( const ProfilerShaderExecutable& executable );
 
@@ -95,8 +95,11 @@ namespace Profiler
         struct ShaderRepresentation;
         struct ShaderExecutableRepresentation;
         struct ShaderExporter;
+        struct ShaderDisassembly;
+        class ShaderDisassembler;
 
         static constexpr ShaderFormat      m_scExecutableShaderFormat = ShaderFormat( -1 );
+        static constexpr ShaderFormat      m_scPendingShaderFormat = ShaderFormat( -2 );
 
         const OverlayResources&            m_Resources;
         std::unique_ptr<TextEditor>        m_pTextEditor;
@@ -119,6 +122,12 @@ namespace Profiler
         std::unique_ptr<ShaderExporter>    m_pShaderExporter;
         ShaderSavedCallback                m_ShaderSavedCallback;
 
+        std::unique_ptr<ShaderDisassembler> m_pShaderDisassembler;
+        std::shared_ptr<ShaderDisassembly> m_pPendingShaderDisassembly;
+
+        void UpdatePendingShaderDisassembly();
+        void AddShaderDisassembly( const ShaderDisassembly& disassembly, size_t index );
+
         void DrawShaderIdentifier();
         void DrawShaderRepresentation( int tabIndex, ShaderRepresentation* pShaderRepresentation );
         void DrawShaderStatistics( ShaderExecutableRepresentation* pShaderExecutable );
@@ -0,0 +1,461 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "profiler_shared_memory.h"
+#include "profiler_shared_memory_layout.h"
+#include "profiler/profiler_data.h"
+#include "profiler/profiler_helpers.h"
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <string.h>
+
+#include <fmt/format.h>
+
+namespace
+{
+    // Number of segment names tried before the output fails if the default names are taken.
+    static constexpr uint32_t g_scSharedMemoryMaxNameAttempts = 16;
+
+    // Index appended to the default segment names, unique for each output created by the process.
+    static std::atomic_uint32_t g_NextSharedMemoryIndex = 0;
+}
+
+namespace Profiler
+{
+    static_assert( sizeof( DeviceProfilerDrawcallStats ) / sizeof( DeviceProfilerDrawcallStats::Stats ) == ProfilerSharedMemoryStatsCount,
+        "ProfilerSharedMemoryStatsCount must match the number of entries in DeviceProfilerDrawcallStats" );
+
+    /*************************************************************************\
+
+    Function:
+        ProfilerSharedMemoryOutput
+
+    Description:
+        Constructor.
+
+    \*************************************************************************/
+    ProfilerSharedMemoryOutput::ProfilerSharedMemoryOutput( DeviceProfilerFrontend& frontend )
+        : DeviceProfilerOutput( frontend )
+        , m_Serializer( frontend )
+    {
+        ResetMembers();
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ~ProfilerSharedMemoryOutput
+
+    Description:
+        Destructor.
+
+    \*************************************************************************/
+    ProfilerSharedMemoryOutput::~ProfilerSharedMemoryOutput()
+    {
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Initialize
+
+    Description:
+        Creates the shared memory segment and writes the header.
+
+        Each device gets its own segment. By default the segments are named
+        VkProfiler_<pid>_<index>, and the next index is tried if the name is
+        taken, e.g. by a segment left by a terminated process with the same
+        identifier. The output fails if the configured name is taken.
+
+        Data of the device is written before the segment is marked as
+        initialized, so it is immutable for the readers.
+
+    \*************************************************************************/
+    bool ProfilerSharedMemoryOutput::Initialize()
+    {
+        const DeviceProfilerConfig& config = m_Frontend.GetProfilerConfig();
+
+        const bool useDefaultName = config.m_SharedMemoryName.empty();
+        const uint32_t maxAttempts = useDefaultName ? g_scSharedMemoryMaxNameAttempts : 1;
+
+        void* pMemory = nullptr;
+        for( uint32_t attempt = 0; ( attempt < maxAttempts ) && ( pMemory == nullptr ); ++attempt )
+        {
+            m_Name = config.m_SharedMemoryName;
+            if( useDefaultName )
+            {
+                m_Name = fmt::format( "VkProfiler_{}_{}",
+                    ProfilerPlatformFunctions::GetCurrentProcessId(),
+                    g_NextSharedMemoryIndex.fetch_add( 1, std::memory_order_relaxed ) );
+            }
+
+            pMemory = ProfilerPlatformFunctions::CreateSharedMemory(
+                m_Name.c_str(),
+                ProfilerSharedMemorySegmentSize,
+                &m_pHandle );
+        }
+
+        if( pMemory == nullptr )
+        {
+            ProfilerPlatformFunctions::WriteDebug( "Failed to create shared memory segment '%s'\n", m_Name.c_str() );
+            ResetMembers();
+            return false;
+        }
+
+        m_pHeader = new( pMemory ) ProfilerSharedMemoryHeader();
+        m_pHeader->m_Version = ProfilerSharedMemoryVersion;
+        m_pHeader->m_ProcessId = ProfilerPlatformFunctions::GetCurrentProcessId();
+        m_pHeader->m_FrameCapacity = ProfilerSharedMemoryFrameCount;
+
+        const VkPhysicalDeviceProperties& deviceProperties = m_Frontend.GetPhysicalDeviceProperties();
+        m_pHeader->m_TimestampPeriod = deviceProperties.limits.timestampPeriod;
+        strncpy( m_pHeader->m_DeviceName, deviceProperties.deviceName, ProfilerSharedMemoryNameLength - 1 );
+
+        const VkApplicationInfo& applicationInfo = m_Frontend.GetApplicationInfo();
+        if( applicationInfo.pApplicationName != nullptr )
+        {
+            strncpy( m_pHeader->m_ApplicationName, applicationInfo.pApplicationName, ProfilerSharedMemoryNameLength - 1 );
+        }
+
+        m_pHeader->m_SegmentSize = ProfilerSharedMemorySegmentSize;
+        m_pHeader->m_DeviceDataOffset = sizeof( ProfilerSharedMemoryHeader );
+        m_pHeader->m_FrameDataOffset = sizeof( ProfilerSharedMemoryHeader ) + ProfilerSharedMemoryDeviceDataCapacity;
+        m_pHeader->m_FrameDataCapacity = ProfilerSharedMemoryFrameDataCapacity;
+
+        const std::vector<uint8_t>& deviceData = m_Serializer.SerializeDeviceData();
+        if( deviceData.size() <= ProfilerSharedMemoryDeviceDataCapacity )
+        {
+            uint8_t* pDeviceData = reinterpret_cast<uint8_t*>( m_pHeader ) + m_pHeader->m_DeviceDataOffset;
+            memcpy( pDeviceData, deviceData.data(), deviceData.size() );
+            m_pHeader->m_DeviceDataSize = deviceData.size();
+        }
+        else
+        {
+            ProfilerPlatformFunctions::WriteDebug( "Device data doesn't fit in shared memory segment '%s' (%zu bytes)\n",
+                m_Name.c_str(),
+                deviceData.size() );
+        }
+
+        PublishState();
+
+        // Readers check the magic value to detect fully initialized segments.
+        std::atomic_thread_fence( std::memory_order_release );
+        m_pHeader->m_Magic = ProfilerSharedMemoryMagic;
+
+        return true;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Destroy
+
+    Description:
+        Removes the shared memory segment.
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryOutput::Destroy()
+    {
+        if( m_pHeader != nullptr )
+        {
+            m_pHeader->~ProfilerSharedMemoryHeader();
+
+            ProfilerPlatformFunctions::DestroySharedMemory(
+                m_Name.c_str(),
+                m_pHeader,
+                ProfilerSharedMemorySegmentSize,
+                m_pHandle );
+        }
+
+        ResetMembers();
+    }
+
+    /*************************************************************************\
+
+    Function:
+        IsAvailable
+
+    Description:
+        Checks if the shared memory segment has been created.
+
+    \*************************************************************************/
+    bool ProfilerSharedMemoryOutput::IsAvailable()
+    {
+        return m_pHeader != nullptr;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Update
+
+    Description:
+        Executes pending commands and publishes the collected frames.
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryOutput::Update()
+    {
+        if( m_pHeader == nullptr )
+        {
+            return;
+        }
+
+        ExecuteCommands();
+        PublishState();
+
+        auto pData = m_Frontend.GetData();
+        while( pData )
+        {
+            Publish( *pData );
+            pData = m_Frontend.GetData();
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Present
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryOutput::Present()
+    {
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetName
+
+    Description:
+        Returns name of the shared memory segment.
+
+    \*************************************************************************/
+    const std::string& ProfilerSharedMemoryOutput::GetName() const
+    {
+        return m_Name;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ResetMembers
+
+    Description:
+        Set all members to initial values.
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryOutput::ResetMembers()
+    {
+        m_Name.clear();
+        m_pHeader = nullptr;
+        m_pHandle = nullptr;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Publish
+
+    Description:
+        Writes summary of the frame to the next slot of the ring, and the
+        complete data of the frame to the frame data ring.
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryOutput::Publish( const DeviceProfilerFrameData& data )
+    {
+        ProfilerSharedMemoryHeader& header = *m_pHeader;
+
+        const std::vector<uint8_t>& frameData = m_Serializer.SerializeFrameData( data );
+        const uint64_t frameDataSize = frameData.size();
+        const uint64_t frameDataOffset = header.m_FrameDataReserveIndex.load( std::memory_order_relaxed );
+
+        // Frames larger than the ring are published only as summaries.
+        const bool frameDataFits = ( frameDataSize <= header.m_FrameDataCapacity );
+        if( frameDataFits )
+        {
+            // Reserve the bytes before overwriting them, so the readers can detect
+            // that the data they are copying is no longer valid.
+            header.m_FrameDataReserveIndex.store( frameDataOffset + frameDataSize, std::memory_order_relaxed );
+            std::atomic_thread_fence( std::memory_order_release );
+
+            uint8_t* pFrameDataRing = reinterpret_cast<uint8_t*>( m_pHeader ) + header.m_FrameDataOffset;
+            const uint64_t ringOffset = frameDataOffset % header.m_FrameDataCapacity;
+            const uint64_t firstPartSize = std::min( frameDataSize, header.m_FrameDataCapacity - ringOffset );
+
+            memcpy( pFrameDataRing + ringOffset, frameData.data(), firstPartSize );
+            memcpy( pFrameDataRing, frameData.data() + firstPartSize, frameDataSize - firstPartSize );
+        }
+        else
+        {
+            ProfilerPlatformFunctions::WriteDebug( "Frame data doesn't fit in shared memory segment '%s' (%llu bytes)\n",
+                m_Name.c_str(),
+                static_cast<unsigned long long>( frameDataSize ) );
+        }
+
+        const uint64_t frameWriteIndex = header.m_FrameWriteIndex.load( std::memory_order_relaxed );
+        ProfilerSharedMemoryFrame& slot = header.m_Frames[ frameWriteIndex % ProfilerSharedMemoryFrameCount ];
+        ProfilerSharedMemoryFrameData& frame = slot.m_Data;
+
+        // Mark the slot as being written.
+        const uint64_t sequence = slot.m_Sequence.load( std::memory_order_relaxed );
+        slot.m_Sequence.store( sequence + 1, std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_release );
+
+        header.m_HostTimestampFrequency = m_Frontend.GetHostTimestampFrequency( data.m_SyncTimestamps.m_HostTimeDomain );
+
+        frame.m_FrameIndex = data.m_CPU.m_FrameIndex;
+        frame.m_GpuTicks = data.m_Ticks;
+        frame.m_CpuBeginTimestamp = data.m_CPU.m_BeginTimestamp;
+        frame.m_CpuEndTimestamp = data.m_CPU.m_EndTimestamp;
+        frame.m_FramesPerSec = data.m_CPU.m_FramesPerSec;
+
+        frame.m_SubmitCount = 0;
+        for( const DeviceProfilerSubmitBatchData& submitBatch : data.m_Submits )
+        {
+            frame.m_SubmitCount += static_cast<uint32_t>( submitBatch.m_Submits.size() );
+        }
+
+        frame.m_TotalAllocationSize = data.m_Memory.m_TotalAllocationSize;
+        frame.m_TotalAllocationCount = data.m_Memory.m_TotalAllocationCount;
+
+        uint32_t statsIndex = 0;
+        for( const DeviceProfilerDrawcallStats::Stats& stats : data.m_Stats )
+        {
+            frame.m_Stats[ statsIndex ].m_Count = stats.m_Count;
+            frame.m_Stats[ statsIndex ].m_Ticks = stats.GetEstimatedTicksSum();
+            statsIndex++;
+        }
+
+        // Top pipelines are sorted by duration.
+        frame.m_TopPipelineCount = static_cast<uint32_t>(
+            std::min<size_t>( data.m_TopPipelines.size(), ProfilerSharedMemoryTopPipelineCount ) );
+
+        for( uint32_t i = 0; i < frame.m_TopPipelineCount; ++i )
+        {
+            const DeviceProfilerPipelineData& pipeline = data.m_TopPipelines[ i ];
+            frame.m_TopPipelines[ i ].m_ShaderTupleHash = pipeline.m_ShaderTuple.m_Hash;
+            frame.m_TopPipelines[ i ].m_BindPoint = static_cast<uint32_t>( pipeline.m_BindPoint );
+            frame.m_TopPipelines[ i ].m_Ticks = pipeline.m_EndTimestamp.m_Value - pipeline.m_BeginTimestamp.m_Value;
+        }
+
+        frame.m_DataOffset = frameDataOffset;
+        frame.m_DataSize = frameDataFits ? frameDataSize : 0;
+
+        // Mark the slot as complete and make it visible to the readers.
+        slot.m_Sequence.store( sequence + 2, std::memory_order_release );
+        header.m_FrameWriteIndex.store( frameWriteIndex + 1, std::memory_order_release );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        PublishState
+
+    Description:
+        Writes the current state of the profiler, so the viewer can display
+        the results of the commands it has sent.
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryOutput::PublishState()
+    {
+        ProfilerSharedMemoryHeader& header = *m_pHeader;
+
+        header.m_SamplingMode.store( static_cast<uint32_t>( m_Frontend.GetProfilerSamplingMode() ), std::memory_order_relaxed );
+        header.m_FrameDelimiter.store( static_cast<uint32_t>( m_Frontend.GetProfilerFrameDelimiter() ), std::memory_order_relaxed );
+        header.m_PerformanceMetricsSetIndex.store( m_Frontend.GetPerformanceMetricsSetIndex(), std::memory_order_relaxed );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ExecuteCommands
+
+    Description:
+        Executes control commands written by the viewer.
+        The commands come from another process, so their values are checked
+        before they are converted to the enumerations.
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryOutput::ExecuteCommands()
+    {
+        ProfilerSharedMemoryHeader& header = *m_pHeader;
+
+        uint32_t commandReadIndex = header.m_CommandReadIndex.load( std::memory_order_relaxed );
+        const uint32_t commandWriteIndex = header.m_CommandWriteIndex.load( std::memory_order_acquire );
+
+        // Skip the commands overwritten by the viewer if it didn't wait for the free space.
+        if( ( commandWriteIndex - commandReadIndex ) > ProfilerSharedMemoryCommandCount )
+        {
+            commandReadIndex = commandWriteIndex - ProfilerSharedMemoryCommandCount;
+        }
+
+        while( commandReadIndex != commandWriteIndex )
+        {
+            const ProfilerSharedMemoryCommand command =
+                header.m_Commands[ commandReadIndex % ProfilerSharedMemoryCommandCount ];
+
+            bool valid = false;
+
+            switch( command.m_Type )
+            {
+            case ProfilerSharedMemoryCommandType::eSetSamplingMode:
+                valid = ( command.m_Value <= VK_PROFILER_MODE_PER_FRAME_EXT );
+                if( valid )
+                {
+                    m_Frontend.SetProfilerSamplingMode( static_cast<VkProfilerModeEXT>( command.m_Value ) );
+                }
+                break;
+
+            case ProfilerSharedMemoryCommandType::eSetFrameDelimiter:
+                valid = ( command.m_Value <= VK_PROFILER_FRAME_DELIMITER_FRAME_BOUNDARY_EXT );
+                if( valid )
+                {
+                    m_Frontend.SetProfilerFrameDelimiter( static_cast<VkProfilerFrameDelimiterEXT>( command.m_Value ) );
+                }
+                break;
+
+            case ProfilerSharedMemoryCommandType::eSetPerformanceMetricsSetIndex:
+                valid = ( command.m_Value < m_Frontend.GetPerformanceMetricsSets( 0, nullptr ) );
+                if( valid )
+                {
+                    m_Frontend.SetPreformanceMetricsSetIndex( command.m_Value );
+                }
+                break;
+
+            default:
+                break;
+            }
+
+            if( !valid )
+            {
+                ProfilerPlatformFunctions::WriteDebug( "Ignored invalid shared memory command (type=%u, value=%u)\n",
+                    static_cast<uint32_t>( command.m_Type ),
+                    command.m_Value );
+            }
+
+            commandReadIndex++;
+        }
+
+        header.m_CommandReadIndex.store( commandReadIndex, std::memory_order_release );
+    }
+}
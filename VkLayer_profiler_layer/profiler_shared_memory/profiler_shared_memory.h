@@ -0,0 +1,74 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include "profiler_shared_memory_serializer.h"
+#include "profiler/profiler_frontend.h"
+#include <string>
+
+namespace Profiler
+{
+    struct ProfilerSharedMemoryHeader;
+
+    /*************************************************************************\
+
+    Class:
+        ProfilerSharedMemoryOutput
+
+    Description:
+        Publishes frames to a named shared memory segment, so that the data
+        can be displayed by a viewer running in a separate process. Each frame
+        is published as a compact summary and as complete serialized data.
+        Control commands written by the viewer are executed in Update.
+
+        See profiler_shared_memory_layout.h for the layout of the segment.
+
+    \*************************************************************************/
+    class ProfilerSharedMemoryOutput : public DeviceProfilerOutput
+    {
+    public:
+        ProfilerSharedMemoryOutput( DeviceProfilerFrontend& frontend );
+        ~ProfilerSharedMemoryOutput();
+
+        bool Initialize() override;
+        void Destroy() override;
+
+        bool IsAvailable() override;
+
+        void Update() override;
+        void Present() override;
+
+        const std::string& GetName() const;
+
+    private:
+        std::string m_Name;
+
+        ProfilerSharedMemoryHeader* m_pHeader;
+        void* m_pHandle;
+
+        ProfilerSharedMemorySerializer m_Serializer;
+
+        void ResetMembers();
+
+        void Publish( const struct DeviceProfilerFrameData& data );
+        void PublishState();
+        void ExecuteCommands();
+    };
+}
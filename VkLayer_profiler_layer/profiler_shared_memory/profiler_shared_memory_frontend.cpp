@@ -0,0 +1,701 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "profiler_shared_memory_frontend.h"
+#include "profiler/profiler_counters.h"
+#include "profiler/profiler_helpers.h"
+#include <algorithm>
+#include <tuple>
+
+namespace Profiler
+{
+    /*************************************************************************\
+
+    Function:
+        ProfilerSharedMemoryFrontend
+
+    Description:
+        Constructor.
+
+    \*************************************************************************/
+    ProfilerSharedMemoryFrontend::ProfilerSharedMemoryFrontend()
+        : m_Reader()
+        , m_Deserializer()
+        , m_DeviceData()
+        , m_Queues()
+        , m_Config()
+        , m_ObjectNames()
+        , m_NextFrameIndex( 0 )
+        , m_DataBufferSize( ProfilerSharedMemoryFrameCount )
+        , m_FrameData()
+    {
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Initialize
+
+    Description:
+        Opens the shared memory segment and reads the properties of the
+        profiled device. Frames published before the segment was opened are
+        returned by GetData if they are still available.
+
+    \*************************************************************************/
+    bool ProfilerSharedMemoryFrontend::Initialize( const char* pName )
+    {
+        Destroy();
+
+        bool success = m_Reader.Open( pName );
+
+        if( success )
+        {
+            std::vector<uint8_t> deviceData;
+            success = m_Reader.ReadDeviceData( deviceData ) &&
+                m_Deserializer.DeserializeDeviceData( deviceData, m_DeviceData );
+        }
+
+        if( success )
+        {
+            // Names are stored separately, so the pointers remain valid when the structure is copied.
+            m_DeviceData.m_ApplicationInfo.pApplicationName = m_DeviceData.m_ApplicationName.c_str();
+            m_DeviceData.m_ApplicationInfo.pEngineName = m_DeviceData.m_EngineName.c_str();
+
+            for( const ProfilerSharedMemoryQueueData& queue : m_DeviceData.m_Queues )
+            {
+                m_Queues.emplace(
+                    std::piecewise_construct,
+                    std::forward_as_tuple( queue.m_Handle ),
+                    std::forward_as_tuple( queue.m_Handle, queue.m_Flags, queue.m_Family, queue.m_Index ) );
+            }
+
+            // Settings of the overlay are taken from the environment of the viewer.
+            m_Config.LoadFromEnvironment();
+
+            const uint64_t publishedFrameCount = m_Reader.GetPublishedFrameCount();
+            m_NextFrameIndex = publishedFrameCount - std::min<uint64_t>( publishedFrameCount, ProfilerSharedMemoryFrameCount );
+        }
+
+        if( !success )
+        {
+            ProfilerPlatformFunctions::WriteDebug( "Failed to read shared memory segment '%s'\n", pName );
+            Destroy();
+        }
+
+        return success;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Destroy
+
+    Description:
+        Closes the shared memory segment.
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryFrontend::Destroy()
+    {
+        m_Reader.Close();
+
+        m_DeviceData = {};
+        m_Queues.clear();
+        m_ObjectNames.clear();
+        m_NextFrameIndex = 0;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetPublishedFrameCount
+
+    Description:
+        Returns number of frames published by the layer since the segment has
+        been created. Can be called from any thread.
+
+    \*************************************************************************/
+    uint64_t ProfilerSharedMemoryFrontend::GetPublishedFrameCount() const
+    {
+        return m_Reader.IsOpen() ? m_Reader.GetPublishedFrameCount() : 0;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        IsAvailable
+
+    Description:
+        Checks if the shared memory segment has been opened.
+
+    \*************************************************************************/
+    bool ProfilerSharedMemoryFrontend::IsAvailable()
+    {
+        return m_Reader.IsOpen();
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetApplicationInfo
+
+    Description:
+        Returns VkApplicationInfo provided by the profiled application.
+
+    \*************************************************************************/
+    const VkApplicationInfo& ProfilerSharedMemoryFrontend::GetApplicationInfo()
+    {
+        return m_DeviceData.m_ApplicationInfo;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetPhysicalDeviceProperties
+
+    Description:
+        Returns properties of the profiled device.
+
+    \*************************************************************************/
+    const VkPhysicalDeviceProperties& ProfilerSharedMemoryFrontend::GetPhysicalDeviceProperties()
+    {
+        return m_DeviceData.m_PhysicalDeviceProperties;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetPhysicalDeviceMemoryProperties
+
+    Description:
+        Returns memory properties of the profiled device.
+
+    \*************************************************************************/
+    const VkPhysicalDeviceMemoryProperties& ProfilerSharedMemoryFrontend::GetPhysicalDeviceMemoryProperties()
+    {
+        return m_DeviceData.m_PhysicalDeviceMemoryProperties;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetQueueFamilyProperties
+
+    Description:
+        Returns queue family properties of the profiled device.
+
+    \*************************************************************************/
+    const std::vector<VkQueueFamilyProperties>& ProfilerSharedMemoryFrontend::GetQueueFamilyProperties()
+    {
+        return m_DeviceData.m_QueueFamilyProperties;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetEnabledInstanceExtensions
+
+    Description:
+        Returns list of instance extensions enabled by the profiled application.
+
+    \*************************************************************************/
+    const std::unordered_set<std::string>& ProfilerSharedMemoryFrontend::GetEnabledInstanceExtensions()
+    {
+        return m_DeviceData.m_EnabledInstanceExtensions;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetEnabledDeviceExtensions
+
+    Description:
+        Returns list of device extensions enabled by the profiled application.
+
+    \*************************************************************************/
+    const std::unordered_set<std::string>& ProfilerSharedMemoryFrontend::GetEnabledDeviceExtensions()
+    {
+        return m_DeviceData.m_EnabledDeviceExtensions;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetDeviceQueues
+
+    Description:
+        Returns list of queues created with the profiled device. The handles
+        are valid only in the profiled process and are used as identifiers.
+
+    \*************************************************************************/
+    const std::unordered_map<VkQueue, VkQueue_Object>& ProfilerSharedMemoryFrontend::GetDeviceQueues()
+    {
+        return m_Queues;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        SupportsCustomPerformanceMetricsSets
+
+    Description:
+        Custom performance metrics sets cannot be created from the viewer.
+
+    \*************************************************************************/
+    bool ProfilerSharedMemoryFrontend::SupportsCustomPerformanceMetricsSets()
+    {
+        return false;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        CreateCustomPerformanceMetricsSet
+
+    Description:
+
+    \*************************************************************************/
+    uint32_t ProfilerSharedMemoryFrontend::CreateCustomPerformanceMetricsSet( const VkProfilerCustomPerformanceMetricsSetCreateInfoEXT* )
+    {
+        return UINT32_MAX;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        DestroyCustomPerformanceMetricsSet
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryFrontend::DestroyCustomPerformanceMetricsSet( uint32_t )
+    {
+    }
+
+    /*************************************************************************\
+
+    Function:
+        UpdateCustomPerformanceMetricsSets
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryFrontend::UpdateCustomPerformanceMetricsSets( uint32_t, const VkProfilerCustomPerformanceMetricsSetUpdateInfoEXT* )
+    {
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetPerformanceCounterProperties
+
+    Description:
+        Returns list of performance counters available on the profiled device.
+
+    \*************************************************************************/
+    uint32_t ProfilerSharedMemoryFrontend::GetPerformanceCounterProperties( uint32_t counterCount, VkProfilerPerformanceCounterProperties2EXT* pCounters )
+    {
+        CopyPerformanceCounterProperties( m_DeviceData.m_PerformanceCounterProperties, counterCount, pCounters );
+        return static_cast<uint32_t>( m_DeviceData.m_PerformanceCounterProperties.size() );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetPerformanceMetricsSets
+
+    Description:
+        Returns list of available performance metrics sets.
+
+    \*************************************************************************/
+    uint32_t ProfilerSharedMemoryFrontend::GetPerformanceMetricsSets( uint32_t setCount, VkProfilerPerformanceMetricsSetProperties2EXT* pSets )
+    {
+        const uint32_t availableSetCount = static_cast<uint32_t>( m_DeviceData.m_PerformanceMetricsSets.size() );
+        const uint32_t writeCount = std::min( setCount, availableSetCount );
+        for( uint32_t i = 0; i < writeCount; ++i )
+        {
+            GetPerformanceMetricsSetProperties( i, &pSets[ i ] );
+        }
+
+        return availableSetCount;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetPerformanceMetricsSetProperties
+
+    Description:
+        Returns properties of a given performance metrics set.
+        The structure chain provided by the caller is preserved.
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryFrontend::GetPerformanceMetricsSetProperties( uint32_t setIndex, VkProfilerPerformanceMetricsSetProperties2EXT* pProperties )
+    {
+        if( setIndex < m_DeviceData.m_PerformanceMetricsSets.size() )
+        {
+            const VkStructureType sType = pProperties->sType;
+            void* pNext = pProperties->pNext;
+
+            *pProperties = m_DeviceData.m_PerformanceMetricsSets[ setIndex ];
+            pProperties->sType = sType;
+            pProperties->pNext = pNext;
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetPerformanceMetricsSetCounterProperties
+
+    Description:
+        Returns list of performance counter properties for a given metrics set.
+
+    \*************************************************************************/
+    uint32_t ProfilerSharedMemoryFrontend::GetPerformanceMetricsSetCounterProperties( uint32_t setIndex, uint32_t counterCount, VkProfilerPerformanceCounterProperties2EXT* pCounters )
+    {
+        if( setIndex < m_DeviceData.m_PerformanceMetricsSetCounterProperties.size() )
+        {
+            const auto& counters = m_DeviceData.m_PerformanceMetricsSetCounterProperties[ setIndex ];
+            CopyPerformanceCounterProperties( counters, counterCount, pCounters );
+            return static_cast<uint32_t>( counters.size() );
+        }
+
+        return 0;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetPerformanceCounterRequiredPasses
+
+    Description:
+        Custom performance metrics sets are not supported, so there are no
+        passes to compute.
+
+    \*************************************************************************/
+    uint32_t ProfilerSharedMemoryFrontend::GetPerformanceCounterRequiredPasses( uint32_t, const uint32_t* )
+    {
+        return 0;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetAvailablePerformanceCounters
+
+    Description:
+        Custom performance metrics sets are not supported, so no counters can
+        be selected.
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryFrontend::GetAvailablePerformanceCounters( uint32_t, const uint32_t*, uint32_t& availableCounterCount, uint32_t* )
+    {
+        availableCounterCount = 0;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        SetPreformanceMetricsSetIndex
+
+    Description:
+        Requests the layer to change the active performance metrics set.
+
+    \*************************************************************************/
+    VkResult ProfilerSharedMemoryFrontend::SetPreformanceMetricsSetIndex( uint32_t setIndex )
+    {
+        if( setIndex >= m_DeviceData.m_PerformanceMetricsSets.size() )
+        {
+            return VK_ERROR_VALIDATION_FAILED_EXT;
+        }
+
+        if( !m_Reader.SendCommand( ProfilerSharedMemoryCommandType::eSetPerformanceMetricsSetIndex, setIndex ) )
+        {
+            return VK_NOT_READY;
+        }
+
+        return VK_SUCCESS;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetPerformanceMetricsSetIndex
+
+    Description:
+        Returns the active performance metrics set, as reported by the layer.
+
+    \*************************************************************************/
+    uint32_t ProfilerSharedMemoryFrontend::GetPerformanceMetricsSetIndex()
+    {
+        return m_Reader.GetHeader().m_PerformanceMetricsSetIndex.load( std::memory_order_relaxed );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetPerformanceCountersSamplingMode
+
+    Description:
+        Returns the performance counters sampling mode.
+
+    \*************************************************************************/
+    VkProfilerPerformanceCountersSamplingModeEXT ProfilerSharedMemoryFrontend::GetPerformanceCountersSamplingMode()
+    {
+        return m_DeviceData.m_PerformanceCountersSamplingMode;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetDeviceCreateTimestamp
+
+    Description:
+        Returns the device creation timestamp in the selected time domain.
+
+    \*************************************************************************/
+    uint64_t ProfilerSharedMemoryFrontend::GetDeviceCreateTimestamp( VkTimeDomainEXT timeDomain )
+    {
+        auto it = m_DeviceData.m_DeviceCreateTimestamps.find( timeDomain );
+        if( it != m_DeviceData.m_DeviceCreateTimestamps.end() )
+        {
+            return it->second;
+        }
+
+        return 0;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetHostTimestampFrequency
+
+    Description:
+        Returns the timestamp query frequency in the selected time domain.
+        The viewer runs on the same machine as the profiled application, so
+        the host clocks are shared.
+
+    \*************************************************************************/
+    uint64_t ProfilerSharedMemoryFrontend::GetHostTimestampFrequency( VkTimeDomainEXT timeDomain )
+    {
+        return OSGetTimestampFrequency( timeDomain );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetProfilerConfig
+
+    Description:
+        Returns the configuration of the viewer.
+
+    \*************************************************************************/
+    const DeviceProfilerConfig& ProfilerSharedMemoryFrontend::GetProfilerConfig()
+    {
+        return m_Config;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetProfilerFrameDelimiter
+
+    Description:
+        Returns the frame delimiter currently used by the layer.
+
+    \*************************************************************************/
+    VkProfilerFrameDelimiterEXT ProfilerSharedMemoryFrontend::GetProfilerFrameDelimiter()
+    {
+        return static_cast<VkProfilerFrameDelimiterEXT>( m_Reader.GetHeader().m_FrameDelimiter.load( std::memory_order_relaxed ) );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        SetProfilerFrameDelimiter
+
+    Description:
+        Requests the layer to change the frame delimiter.
+
+    \*************************************************************************/
+    VkResult ProfilerSharedMemoryFrontend::SetProfilerFrameDelimiter( VkProfilerFrameDelimiterEXT frameDelimiter )
+    {
+        if( !m_Reader.SendCommand( ProfilerSharedMemoryCommandType::eSetFrameDelimiter, static_cast<uint32_t>( frameDelimiter ) ) )
+        {
+            return VK_NOT_READY;
+        }
+
+        return VK_SUCCESS;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetProfilerSamplingMode
+
+    Description:
+        Returns the data sampling mode currently used by the layer.
+
+    \*************************************************************************/
+    VkProfilerModeEXT ProfilerSharedMemoryFrontend::GetProfilerSamplingMode()
+    {
+        return static_cast<VkProfilerModeEXT>( m_Reader.GetHeader().m_SamplingMode.load( std::memory_order_relaxed ) );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        SetProfilerSamplingMode
+
+    Description:
+        Requests the layer to change the data sampling mode.
+
+    \*************************************************************************/
+    VkResult ProfilerSharedMemoryFrontend::SetProfilerSamplingMode( VkProfilerModeEXT mode )
+    {
+        if( !m_Reader.SendCommand( ProfilerSharedMemoryCommandType::eSetSamplingMode, static_cast<uint32_t>( mode ) ) )
+        {
+            return VK_NOT_READY;
+        }
+
+        return VK_SUCCESS;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetObjectName
+
+    Description:
+        Returns the name of the object, published with the frames that
+        reference it or set in the viewer.
+
+    \*************************************************************************/
+    std::string ProfilerSharedMemoryFrontend::GetObjectName( const VkObject& object )
+    {
+        auto it = m_ObjectNames.find( object );
+        if( it != m_ObjectNames.end() )
+        {
+            return it->second;
+        }
+
+        return std::string();
+    }
+
+    /*************************************************************************\
+
+    Function:
+        SetObjectName
+
+    Description:
+        Sets the name of the object in the viewer. The name is not sent to the
+        layer and is replaced if the layer publishes another one.
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryFrontend::SetObjectName( const VkObject& object, const std::string& name )
+    {
+        m_ObjectNames[ object ] = name;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetData
+
+    Description:
+        Returns the oldest published frame not returned yet, or nullptr if
+        there are no new frames. Frames that have been overwritten, didn't fit
+        in the frame data ring, or exceed the data buffer size are skipped.
+
+    \*************************************************************************/
+    std::shared_ptr<DeviceProfilerFrameData> ProfilerSharedMemoryFrontend::GetData()
+    {
+        if( !m_Reader.IsOpen() )
+        {
+            return nullptr;
+        }
+
+        const uint64_t publishedFrameCount = m_Reader.GetPublishedFrameCount();
+        const uint64_t bufferedFrameCount = std::min<uint64_t>( m_DataBufferSize, ProfilerSharedMemoryFrameCount );
+
+        if( publishedFrameCount - m_NextFrameIndex > bufferedFrameCount )
+        {
+            m_NextFrameIndex = publishedFrameCount - bufferedFrameCount;
+        }
+
+        while( m_NextFrameIndex < publishedFrameCount )
+        {
+            ProfilerSharedMemoryFrameData frame;
+            const bool frameRead =
+                m_Reader.ReadFrame( m_NextFrameIndex++, frame ) &&
+                m_Reader.ReadFrameData( frame, m_FrameData );
+
+            if( frameRead )
+            {
+                auto pData = std::make_shared<DeviceProfilerFrameData>();
+                if( m_Deserializer.DeserializeFrameData( m_FrameData, *pData, m_ObjectNames ) )
+                {
+                    return pData;
+                }
+            }
+        }
+
+        return nullptr;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        SetDataBufferSize
+
+    Description:
+        Sets the maximum number of frames returned by GetData when the viewer
+        falls behind the layer. Limited by the capacity of the frame ring.
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryFrontend::SetDataBufferSize( uint32_t maxFrames )
+    {
+        m_DataBufferSize = std::max( maxFrames, 1u );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        CopyPerformanceCounterProperties
+
+    Description:
+        Copies properties of the counters preserving the structure chains
+        provided by the caller.
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryFrontend::CopyPerformanceCounterProperties( const std::vector<VkProfilerPerformanceCounterProperties2EXT>& counters, uint32_t counterCount, VkProfilerPerformanceCounterProperties2EXT* pCounters ) const
+    {
+        const size_t writeCount = std::min<size_t>( counterCount, counters.size() );
+        for( size_t i = 0; i < writeCount; ++i )
+        {
+            const VkStructureType sType = pCounters[ i ].sType;
+            void* pNext = pCounters[ i ].pNext;
+
+            pCounters[ i ] = counters[ i ];
+            pCounters[ i ].sType = sType;
+            pCounters[ i ].pNext = pNext;
+        }
+    }
+}
@@ -0,0 +1,118 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+#include "profiler_shared_memory_reader.h"
+#include "profiler_shared_memory_serializer.h"
+#include "profiler/profiler_frontend.h"
+#include "profiler_layer_objects/VkQueue_object.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Profiler
+{
+    /*************************************************************************\
+
+    Class:
+        ProfilerSharedMemoryFrontend
+
+    Description:
+        Implementation of the DeviceProfilerFrontend interface for displaying
+        data published by ProfilerSharedMemoryOutput in another process.
+
+        Properties of the device are read once when the segment is opened.
+        Changes of the profiler state are sent to the layer as commands and
+        become visible after the layer executes them. Custom performance
+        metrics sets are not supported.
+
+    \*************************************************************************/
+    class ProfilerSharedMemoryFrontend final
+        : public DeviceProfilerFrontend
+    {
+    public:
+        ProfilerSharedMemoryFrontend();
+
+        bool Initialize( const char* pName );
+        void Destroy();
+
+        uint64_t GetPublishedFrameCount() const;
+
+        bool IsAvailable() final;
+
+        const VkApplicationInfo& GetApplicationInfo() final;
+        const VkPhysicalDeviceProperties& GetPhysicalDeviceProperties() final;
+        const VkPhysicalDeviceMemoryProperties& GetPhysicalDeviceMemoryProperties() final;
+        const std::vector<VkQueueFamilyProperties>& GetQueueFamilyProperties() final;
+
+        const std::unordered_set<std::string>& GetEnabledInstanceExtensions() final;
+        const std::unordered_set<std::string>& GetEnabledDeviceExtensions() final;
+
+        const std::unordered_map<VkQueue, VkQueue_Object>& GetDeviceQueues() final;
+
+        bool SupportsCustomPerformanceMetricsSets() final;
+        uint32_t CreateCustomPerformanceMetricsSet( const VkProfilerCustomPerformanceMetricsSetCreateInfoEXT* pCreateInfo ) final;
+        void DestroyCustomPerformanceMetricsSet( uint32_t setIndex ) final;
+        void UpdateCustomPerformanceMetricsSets( uint32_t updateCount, const VkProfilerCustomPerformanceMetricsSetUpdateInfoEXT* pUpdateInfos ) final;
+        uint32_t GetPerformanceCounterProperties( uint32_t counterCount, VkProfilerPerformanceCounterProperties2EXT* pCounters ) final;
+        uint32_t GetPerformanceMetricsSets( uint32_t setCount, VkProfilerPerformanceMetricsSetProperties2EXT* pSets ) final;
+        void GetPerformanceMetricsSetProperties( uint32_t setIndex, VkProfilerPerformanceMetricsSetProperties2EXT* pProperties ) final;
+        uint32_t GetPerformanceMetricsSetCounterProperties( uint32_t setIndex, uint32_t counterCount, VkProfilerPerformanceCounterProperties2EXT* pCounters ) final;
+        uint32_t GetPerformanceCounterRequiredPasses( uint32_t counterCount, const uint32_t* pCounters ) final;
+        void GetAvailablePerformanceCounters( uint32_t selectedCounterCount, const uint32_t* pSelectedCounters, uint32_t& availableCounterCount, uint32_t* pAvailableCounters ) final;
+        VkResult SetPreformanceMetricsSetIndex( uint32_t setIndex ) final;
+        uint32_t GetPerformanceMetricsSetIndex() final;
+        VkProfilerPerformanceCountersSamplingModeEXT GetPerformanceCountersSamplingMode() final;
+
+        uint64_t GetDeviceCreateTimestamp( VkTimeDomainEXT timeDomain ) final;
+        uint64_t GetHostTimestampFrequency( VkTimeDomainEXT timeDomain ) final;
+
+        const DeviceProfilerConfig& GetProfilerConfig() final;
+
+        VkProfilerFrameDelimiterEXT GetProfilerFrameDelimiter() final;
+        VkResult SetProfilerFrameDelimiter( VkProfilerFrameDelimiterEXT frameDelimiter ) final;
+
+        VkProfilerModeEXT GetProfilerSamplingMode() final;
+        VkResult SetProfilerSamplingMode( VkProfilerModeEXT mode ) final;
+
+        std::string GetObjectName( const VkObject& object ) final;
+        void SetObjectName( const VkObject& object, const std::string& name ) final;
+
+        std::shared_ptr<DeviceProfilerFrameData> GetData() final;
+        void SetDataBufferSize( uint32_t maxFrames ) final;
+
+    private:
+        ProfilerSharedMemoryReader m_Reader;
+        ProfilerSharedMemoryDeserializer m_Deserializer;
+
+        ProfilerSharedMemoryDeviceData m_DeviceData;
+        std::unordered_map<VkQueue, VkQueue_Object> m_Queues;
+        DeviceProfilerConfig m_Config;
+
+        std::unordered_map<VkObject, std::string> m_ObjectNames;
+
+        // Index of the next published frame to return from GetData.
+        uint64_t m_NextFrameIndex;
+        uint32_t m_DataBufferSize;
+
+        std::vector<uint8_t> m_FrameData;
+
+        void CopyPerformanceCounterProperties( const std::vector<VkProfilerPerformanceCounterProperties2EXT>& counters, uint32_t counterCount, VkProfilerPerformanceCounterProperties2EXT* pCounters ) const;
+    };
+}
@@ -0,0 +1,254 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <stdint.h>
+#include <atomic>
+
+namespace Profiler
+{
+    /*************************************************************************\
+
+    Description:
+        Layout of the shared memory segment written by ProfilerSharedMemoryOutput.
+
+        The header doesn't depend on the layer's internal data structures, so it
+        can be included by viewers running in a separate process on the same
+        machine. Any change of the layout must increment the version number.
+
+        Frames are written to a ring of fixed-size slots by a single writer
+        (the layer). Each slot is guarded by a sequence counter, which is odd
+        while the slot is being written. Readers copy the slot and retry if the
+        counter was odd or changed during the copy. The segment is created
+        zero-initialized, so after the frame with index N is published, the
+        counter of its slot is equal to 2 * ( N / m_FrameCapacity + 1 ).
+
+        Complete data of the frames, serialized by ProfilerSharedMemorySerializer,
+        is written to a ring of bytes following the header. m_FrameDataReserveIndex
+        is the total number of bytes written to the ring and is advanced before
+        the data of a frame is written, so a reader can detect if the data it has
+        copied was overwritten in the meantime. Blobs may wrap around the end of
+        the ring. Data of the device, which doesn't change between the frames,
+        is written once before the segment is initialized.
+
+        Commands are written by a single reader process to a ring consumed by
+        the layer. The reader increments m_CommandWriteIndex after writing the
+        command, the layer increments m_CommandReadIndex after executing it.
+        Values of the commands are validated by the layer before use.
+
+        See ProfilerSharedMemoryReader for the implementation of the reader.
+
+    \*************************************************************************/
+    static constexpr uint32_t ProfilerSharedMemoryMagic = 0x53504B56; // "VKPS"
+    static constexpr uint32_t ProfilerSharedMemoryVersion = 2;
+
+    static constexpr uint32_t ProfilerSharedMemoryFrameCount = 64;
+    static constexpr uint32_t ProfilerSharedMemoryCommandCount = 16;
+    static constexpr uint32_t ProfilerSharedMemoryStatsCount = 24;
+    static constexpr uint32_t ProfilerSharedMemoryTopPipelineCount = 16;
+    static constexpr uint32_t ProfilerSharedMemoryNameLength = 256;
+
+    // Sizes of the regions following the header. Physical pages are allocated
+    // when they are written for the first time, so the unused space doesn't
+    // occupy memory.
+    static constexpr uint64_t ProfilerSharedMemoryDeviceDataCapacity = 16 * 1024 * 1024;
+    static constexpr uint64_t ProfilerSharedMemoryFrameDataCapacity = 64 * 1024 * 1024;
+
+    static_assert( std::atomic_uint64_t::is_always_lock_free,
+        "Atomics placed in shared memory must be lock-free" );
+
+    /*************************************************************************\
+
+    Structure:
+        ProfilerSharedMemoryStats
+
+    Description:
+        Number and total duration of commands of a single type.
+        The order of entries matches DeviceProfilerDrawcallStats.
+
+    \*************************************************************************/
+    struct ProfilerSharedMemoryStats
+    {
+        uint64_t m_Count;
+        uint64_t m_Ticks;
+    };
+
+    /*************************************************************************\
+
+    Structure:
+        ProfilerSharedMemoryPipeline
+
+    Description:
+        Total duration of a pipeline in the frame.
+
+    \*************************************************************************/
+    struct ProfilerSharedMemoryPipeline
+    {
+        uint32_t m_ShaderTupleHash;
+        uint32_t m_BindPoint;
+        uint64_t m_Ticks;
+    };
+
+    /*************************************************************************\
+
+    Structure:
+        ProfilerSharedMemoryFrameData
+
+    Description:
+        Compact summary of a single frame.
+        GPU durations are in ticks of the device timestamp queries, CPU
+        timestamps are in ticks of the host clock.
+
+        m_DataOffset is the position of the serialized frame data in the stream
+        of bytes written to the frame data ring. m_DataSize is 0 if the frame
+        didn't fit in the ring.
+
+    \*************************************************************************/
+    struct ProfilerSharedMemoryFrameData
+    {
+        uint64_t m_FrameIndex;
+        uint64_t m_GpuTicks;
+        uint64_t m_CpuBeginTimestamp;
+        uint64_t m_CpuEndTimestamp;
+        float m_FramesPerSec;
+        uint32_t m_SubmitCount;
+
+        uint64_t m_TotalAllocationSize;
+        uint64_t m_TotalAllocationCount;
+
+        ProfilerSharedMemoryStats m_Stats[ ProfilerSharedMemoryStatsCount ];
+
+        uint32_t m_TopPipelineCount;
+        uint32_t m_Reserved;
+        ProfilerSharedMemoryPipeline m_TopPipelines[ ProfilerSharedMemoryTopPipelineCount ];
+
+        uint64_t m_DataOffset;
+        uint64_t m_DataSize;
+    };
+
+    /*************************************************************************\
+
+    Structure:
+        ProfilerSharedMemoryFrame
+
+    Description:
+        Slot of the frame ring.
+        The data is plain, so the readers can copy it with memcpy.
+
+    \*************************************************************************/
+    struct ProfilerSharedMemoryFrame
+    {
+        std::atomic_uint64_t m_Sequence;
+        ProfilerSharedMemoryFrameData m_Data;
+    };
+
+    /*************************************************************************\
+
+    Enumeration:
+        ProfilerSharedMemoryCommandType
+
+    Description:
+        Control commands sent by the viewer to the layer.
+        m_Value of the command holds the value of the corresponding public
+        enumeration (VkProfilerModeEXT, VkProfilerFrameDelimiterEXT) or the
+        index of the performance metrics set.
+
+    \*************************************************************************/
+    enum class ProfilerSharedMemoryCommandType : uint32_t
+    {
+        eNone = 0,
+        eSetSamplingMode = 1,
+        eSetFrameDelimiter = 2,
+        eSetPerformanceMetricsSetIndex = 3,
+    };
+
+    /*************************************************************************\
+
+    Structure:
+        ProfilerSharedMemoryCommand
+
+    Description:
+        Single entry in the command queue.
+
+    \*************************************************************************/
+    struct ProfilerSharedMemoryCommand
+    {
+        ProfilerSharedMemoryCommandType m_Type;
+        uint32_t m_Value;
+    };
+
+    /*************************************************************************\
+
+    Structure:
+        ProfilerSharedMemoryHeader
+
+    Description:
+        Beginning of the shared memory segment.
+
+    \*************************************************************************/
+    struct ProfilerSharedMemoryHeader
+    {
+        uint32_t m_Magic;
+        uint32_t m_Version;
+        uint32_t m_ProcessId;
+        uint32_t m_FrameCapacity;
+
+        // Period of the device timestamp queries, in nanoseconds.
+        float m_TimestampPeriod;
+        uint32_t m_Reserved;
+
+        // Frequency of the host timestamps, in ticks per second.
+        uint64_t m_HostTimestampFrequency;
+
+        char m_ApplicationName[ ProfilerSharedMemoryNameLength ];
+        char m_DeviceName[ ProfilerSharedMemoryNameLength ];
+
+        // Size of the whole segment and locations of the regions following the header.
+        uint64_t m_SegmentSize;
+        uint64_t m_DeviceDataOffset;
+        uint64_t m_DeviceDataSize;
+        uint64_t m_FrameDataOffset;
+        uint64_t m_FrameDataCapacity;
+
+        // Total number of bytes reserved in the frame data ring so far.
+        std::atomic_uint64_t m_FrameDataReserveIndex;
+
+        // Current state of the profiler, updated by the layer after executing the commands.
+        std::atomic_uint32_t m_SamplingMode;
+        std::atomic_uint32_t m_FrameDelimiter;
+        std::atomic_uint32_t m_PerformanceMetricsSetIndex;
+        uint32_t m_Reserved2;
+
+        // Total number of frames published so far.
+        // The most recent frame is stored at ( m_FrameWriteIndex - 1 ) % m_FrameCapacity.
+        std::atomic_uint64_t m_FrameWriteIndex;
+
+        std::atomic_uint32_t m_CommandWriteIndex;
+        std::atomic_uint32_t m_CommandReadIndex;
+        ProfilerSharedMemoryCommand m_Commands[ ProfilerSharedMemoryCommandCount ];
+
+        ProfilerSharedMemoryFrame m_Frames[ ProfilerSharedMemoryFrameCount ];
+    };
+
+    static constexpr uint64_t ProfilerSharedMemorySegmentSize =
+        sizeof( ProfilerSharedMemoryHeader ) +
+        ProfilerSharedMemoryDeviceDataCapacity +
+        ProfilerSharedMemoryFrameDataCapacity;
+}
@@ -0,0 +1,316 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "profiler_shared_memory_reader.h"
+#include "profiler/profiler_helpers.h"
+#include <algorithm>
+#include <string.h>
+
+namespace Profiler
+{
+    /*************************************************************************\
+
+    Function:
+        ProfilerSharedMemoryReader
+
+    Description:
+        Constructor.
+
+    \*************************************************************************/
+    ProfilerSharedMemoryReader::ProfilerSharedMemoryReader()
+        : m_pHeader( nullptr )
+        , m_pHandle( nullptr )
+    {
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ~ProfilerSharedMemoryReader
+
+    Description:
+        Destructor.
+
+    \*************************************************************************/
+    ProfilerSharedMemoryReader::~ProfilerSharedMemoryReader()
+    {
+        Close();
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Open
+
+    Description:
+        Maps the shared memory segment created by the layer.
+        Fails if the segment has not been fully initialized yet or if it was
+        created by a layer with a different version of the layout.
+
+    \*************************************************************************/
+    bool ProfilerSharedMemoryReader::Open( const char* pName )
+    {
+        Close();
+
+        void* pMemory = ProfilerPlatformFunctions::OpenSharedMemory(
+            pName,
+            ProfilerSharedMemorySegmentSize,
+            &m_pHandle );
+
+        if( pMemory == nullptr )
+        {
+            m_pHandle = nullptr;
+            return false;
+        }
+
+        m_pHeader = static_cast<ProfilerSharedMemoryHeader*>( pMemory );
+
+        // The magic value is written after the rest of the header.
+        const bool initialized = ( m_pHeader->m_Magic == ProfilerSharedMemoryMagic );
+        std::atomic_thread_fence( std::memory_order_acquire );
+
+        if( !initialized ||
+            ( m_pHeader->m_Version != ProfilerSharedMemoryVersion ) ||
+            ( m_pHeader->m_FrameCapacity != ProfilerSharedMemoryFrameCount ) ||
+            ( m_pHeader->m_SegmentSize != ProfilerSharedMemorySegmentSize ) ||
+            ( m_pHeader->m_DeviceDataOffset != sizeof( ProfilerSharedMemoryHeader ) ) ||
+            ( m_pHeader->m_DeviceDataSize > ProfilerSharedMemoryDeviceDataCapacity ) ||
+            ( m_pHeader->m_FrameDataOffset != sizeof( ProfilerSharedMemoryHeader ) + ProfilerSharedMemoryDeviceDataCapacity ) ||
+            ( m_pHeader->m_FrameDataCapacity != ProfilerSharedMemoryFrameDataCapacity ) )
+        {
+            Close();
+            return false;
+        }
+
+        return true;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Close
+
+    Description:
+        Unmaps the shared memory segment.
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryReader::Close()
+    {
+        if( m_pHeader != nullptr )
+        {
+            ProfilerPlatformFunctions::CloseSharedMemory(
+                m_pHeader,
+                ProfilerSharedMemorySegmentSize,
+                m_pHandle );
+        }
+
+        m_pHeader = nullptr;
+        m_pHandle = nullptr;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        IsOpen
+
+    Description:
+        Checks if the shared memory segment is mapped.
+
+    \*************************************************************************/
+    bool ProfilerSharedMemoryReader::IsOpen() const
+    {
+        return m_pHeader != nullptr;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetHeader
+
+    Description:
+        Returns the header of the segment. Requires the segment to be open.
+
+    \*************************************************************************/
+    const ProfilerSharedMemoryHeader& ProfilerSharedMemoryReader::GetHeader() const
+    {
+        return *m_pHeader;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetPublishedFrameCount
+
+    Description:
+        Returns total number of frames published by the layer so far.
+
+    \*************************************************************************/
+    uint64_t ProfilerSharedMemoryReader::GetPublishedFrameCount() const
+    {
+        return m_pHeader->m_FrameWriteIndex.load( std::memory_order_acquire );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadFrame
+
+    Description:
+        Copies the frame with the given index.
+        Fails if the frame has not been published yet, if it has already been
+        overwritten by a newer frame, or if the layer was writing the slot in
+        all attempts.
+
+    \*************************************************************************/
+    bool ProfilerSharedMemoryReader::ReadFrame( uint64_t index, ProfilerSharedMemoryFrameData& frame ) const
+    {
+        if( index >= GetPublishedFrameCount() )
+        {
+            return false;
+        }
+
+        const ProfilerSharedMemoryFrame& slot = m_pHeader->m_Frames[ index % ProfilerSharedMemoryFrameCount ];
+
+        // Value of the sequence counter after the requested frame was written to the slot.
+        const uint64_t expectedSequence = 2 * ( index / ProfilerSharedMemoryFrameCount + 1 );
+
+        for( uint32_t attempt = 0; attempt < MaxReadAttempts; ++attempt )
+        {
+            const uint64_t sequence = slot.m_Sequence.load( std::memory_order_acquire );
+            if( sequence > expectedSequence + 1 )
+            {
+                // The frame has been overwritten.
+                return false;
+            }
+
+            if( sequence != expectedSequence )
+            {
+                // The slot is being written.
+                continue;
+            }
+
+            memcpy( &frame, &slot.m_Data, sizeof( ProfilerSharedMemoryFrameData ) );
+
+            // The copy is valid only if the slot was not modified in the meantime.
+            std::atomic_thread_fence( std::memory_order_acquire );
+            if( slot.m_Sequence.load( std::memory_order_relaxed ) == sequence )
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadDeviceData
+
+    Description:
+        Copies the serialized data of the device.
+        The data is written before the segment is initialized and doesn't
+        change, so it can be copied without synchronization.
+
+    \*************************************************************************/
+    bool ProfilerSharedMemoryReader::ReadDeviceData( std::vector<uint8_t>& data ) const
+    {
+        const uint8_t* pDeviceData = reinterpret_cast<const uint8_t*>( m_pHeader ) + m_pHeader->m_DeviceDataOffset;
+        data.assign( pDeviceData, pDeviceData + m_pHeader->m_DeviceDataSize );
+
+        return !data.empty();
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadFrameData
+
+    Description:
+        Copies the serialized data of the frame.
+        Fails if the frame didn't fit in the frame data ring or if the data has
+        been overwritten by newer frames before or during the copy.
+
+    \*************************************************************************/
+    bool ProfilerSharedMemoryReader::ReadFrameData( const ProfilerSharedMemoryFrameData& frame, std::vector<uint8_t>& data ) const
+    {
+        const uint64_t capacity = m_pHeader->m_FrameDataCapacity;
+
+        if( ( frame.m_DataSize == 0 ) || ( frame.m_DataSize > capacity ) )
+        {
+            return false;
+        }
+
+        // The data is overwritten once the layer reserves the bytes that follow
+        // it in the stream by more than the capacity of the ring.
+        auto IsOverwritten = [&]( uint64_t reserveIndex ) {
+            return ( reserveIndex - frame.m_DataOffset ) > capacity;
+        };
+
+        if( IsOverwritten( m_pHeader->m_FrameDataReserveIndex.load( std::memory_order_acquire ) ) )
+        {
+            return false;
+        }
+
+        const uint8_t* pFrameDataRing = reinterpret_cast<const uint8_t*>( m_pHeader ) + m_pHeader->m_FrameDataOffset;
+        const uint64_t ringOffset = frame.m_DataOffset % capacity;
+        const uint64_t firstPartSize = std::min( frame.m_DataSize, capacity - ringOffset );
+
+        data.resize( frame.m_DataSize );
+        memcpy( data.data(), pFrameDataRing + ringOffset, firstPartSize );
+        memcpy( data.data() + firstPartSize, pFrameDataRing, frame.m_DataSize - firstPartSize );
+
+        // The copy is valid only if the layer didn't start overwriting the data in the meantime.
+        std::atomic_thread_fence( std::memory_order_acquire );
+        return !IsOverwritten( m_pHeader->m_FrameDataReserveIndex.load( std::memory_order_relaxed ) );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        SendCommand
+
+    Description:
+        Appends the command to the queue executed by the layer in the next
+        update. Fails if the layer has not consumed the previous commands yet.
+
+    \*************************************************************************/
+    bool ProfilerSharedMemoryReader::SendCommand( ProfilerSharedMemoryCommandType type, uint32_t value )
+    {
+        ProfilerSharedMemoryHeader& header = *m_pHeader;
+
+        // The reader is the only writer of the command queue.
+        const uint32_t commandWriteIndex = header.m_CommandWriteIndex.load( std::memory_order_relaxed );
+        const uint32_t commandReadIndex = header.m_CommandReadIndex.load( std::memory_order_acquire );
+
+        if( ( commandWriteIndex - commandReadIndex ) >= ProfilerSharedMemoryCommandCount )
+        {
+            return false;
+        }
+
+        ProfilerSharedMemoryCommand& command = header.m_Commands[ commandWriteIndex % ProfilerSharedMemoryCommandCount ];
+        command.m_Type = type;
+        command.m_Value = value;
+
+        header.m_CommandWriteIndex.store( commandWriteIndex + 1, std::memory_order_release );
+        return true;
+    }
+}
@@ -0,0 +1,75 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+#include "profiler_shared_memory_layout.h"
+#include <vector>
+
+namespace Profiler
+{
+    /*************************************************************************\
+
+    Class:
+        ProfilerSharedMemoryReader
+
+    Description:
+        Reads the frames published by ProfilerSharedMemoryOutput and sends
+        control commands to the layer. Used by viewers running in a separate
+        process.
+
+        Frames are identified by the order in which they were published,
+        from 0 to GetPublishedFrameCount() - 1. Only the most recent
+        m_FrameCapacity frames can be read. Complete data of the frames can
+        be read as long as it has not been overwritten in the frame data ring.
+
+    \*************************************************************************/
+    class ProfilerSharedMemoryReader
+    {
+    public:
+        ProfilerSharedMemoryReader();
+        ~ProfilerSharedMemoryReader();
+
+        ProfilerSharedMemoryReader( const ProfilerSharedMemoryReader& ) = delete;
+        ProfilerSharedMemoryReader& operator=( const ProfilerSharedMemoryReader& ) = delete;
+
+        bool Open( const char* pName );
+        void Close();
+
+        bool IsOpen() const;
+
+        const ProfilerSharedMemoryHeader& GetHeader() const;
+
+        uint64_t GetPublishedFrameCount() const;
+        bool ReadFrame( uint64_t index, ProfilerSharedMemoryFrameData& frame ) const;
+
+        bool ReadDeviceData( std::vector<uint8_t>& data ) const;
+        bool ReadFrameData( const ProfilerSharedMemoryFrameData& frame, std::vector<uint8_t>& data ) const;
+
+        bool SendCommand( ProfilerSharedMemoryCommandType type, uint32_t value );
+
+    private:
+        // Number of attempts to copy a slot that is being written concurrently.
+        static constexpr uint32_t MaxReadAttempts = 4;
+
+        ProfilerSharedMemoryHeader* m_pHeader;
+        void* m_pHandle;
+    };
+}
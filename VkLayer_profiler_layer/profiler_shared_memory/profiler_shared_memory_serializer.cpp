@@ -0,0 +1,1782 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "profiler_shared_memory_serializer.h"
+#include "profiler/profiler_frontend.h"
+#include "profiler_layer_objects/VkQueue_object.h"
+#include <stdlib.h>
+#include <string.h>
+#include <iterator>
+#include <type_traits>
+
+namespace
+{
+    // Computes a hash of the sizes of the types copied as they are. Data written by
+    // a layer built with different definitions of the structures is rejected.
+    template<typename... T>
+    constexpr uint64_t GetFormatHash()
+    {
+        uint64_t hash = 14695981039346656037ull;
+        ( ( hash = ( hash ^ sizeof( T ) ) * 1099511628211ull ), ... );
+        return hash;
+    }
+
+#define PROFILER_PAYLOAD_TYPE( type, name, ... ) Profiler::type,
+
+    static constexpr uint64_t g_scFormatHash = GetFormatHash<
+        PROFILER_MAP_DRAWCALL_PAYLOAD( PROFILER_PAYLOAD_TYPE )
+        Profiler::DeviceProfilerDrawcallPayload,
+        Profiler::DeviceProfilerDrawcallStats,
+        Profiler::DeviceProfilerTimestamp,
+        Profiler::DeviceProfilerTimestampValue,
+        Profiler::DeviceProfilerPipelineStatistics,
+        Profiler::DeviceProfilerRenderPassBeginData,
+        Profiler::DeviceProfilerRenderPassEndData,
+        Profiler::DeviceProfilerSemaphoreDependencyData,
+        Profiler::DeviceProfilerMemoryHeapData,
+        Profiler::DeviceProfilerMemoryTypeData,
+        Profiler::DeviceProfilerMemoryChurnData,
+        Profiler::DeviceProfilerCpuSpanData,
+        Profiler::DeviceProfilerSynchronizationTimestamps,
+        Profiler::DeviceProfilerPipelineCreationFeedbackData::Stage,
+        Profiler::DeviceProfilerOverheadData,
+        Profiler::ProfilerSharedMemoryQueueData,
+        Profiler::VkObject,
+        VkProfilerPerformanceCounterResultEXT,
+        VkProfilerPerformanceCounterProperties2EXT,
+        VkProfilerPerformanceMetricsSetProperties2EXT,
+        VkPhysicalDeviceProperties,
+        VkPhysicalDeviceMemoryProperties,
+        VkQueueFamilyProperties,
+        VkMultiDrawInfoEXT,
+        VkMultiDrawIndexedInfoEXT>();
+
+#undef PROFILER_PAYLOAD_TYPE
+
+    // Host time domains in which the device creation timestamp may be requested.
+    static constexpr VkTimeDomainEXT g_scTimeDomains[] = {
+        VK_TIME_DOMAIN_DEVICE_EXT,
+        VK_TIME_DOMAIN_CLOCK_MONOTONIC_EXT,
+        VK_TIME_DOMAIN_CLOCK_MONOTONIC_RAW_EXT,
+        VK_TIME_DOMAIN_QUERY_PERFORMANCE_COUNTER_EXT };
+
+    // Value of the command buffer reference if the pointer is null.
+    static constexpr uint32_t g_scNullCommandBufferIndex = UINT32_MAX;
+}
+
+namespace Profiler
+{
+    /*************************************************************************\
+
+    Function:
+        ProfilerSharedMemorySerializer
+
+    Description:
+        Constructor.
+
+    \*************************************************************************/
+    ProfilerSharedMemorySerializer::ProfilerSharedMemorySerializer( DeviceProfilerFrontend& frontend )
+        : m_Frontend( frontend )
+        , m_Data()
+        , m_CommandBufferIndices()
+        , m_CommandBuffers()
+        , m_Objects()
+    {
+    }
+
+    /*************************************************************************\
+
+    Function:
+        SerializeDeviceData
+
+    Description:
+        Serializes the properties of the device. The returned buffer is valid
+        until the next call to the serializer.
+
+    \*************************************************************************/
+    const std::vector<uint8_t>& ProfilerSharedMemorySerializer::SerializeDeviceData()
+    {
+        m_Data.clear();
+        Write( g_scFormatHash );
+
+        const VkApplicationInfo& applicationInfo = m_Frontend.GetApplicationInfo();
+        Write( applicationInfo.applicationVersion );
+        Write( applicationInfo.engineVersion );
+        Write( applicationInfo.apiVersion );
+        WriteString( applicationInfo.pApplicationName );
+        WriteString( applicationInfo.pEngineName );
+
+        Write( m_Frontend.GetPhysicalDeviceProperties() );
+        Write( m_Frontend.GetPhysicalDeviceMemoryProperties() );
+        WriteVector( m_Frontend.GetQueueFamilyProperties() );
+
+        const std::unordered_map<VkQueue, VkQueue_Object>& queues = m_Frontend.GetDeviceQueues();
+        Write( static_cast<uint32_t>( queues.size() ) );
+        for( const auto& [handle, queue] : queues )
+        {
+            ProfilerSharedMemoryQueueData queueData;
+            queueData.m_Handle = queue.Handle;
+            queueData.m_Flags = queue.Flags;
+            queueData.m_Family = queue.Family;
+            queueData.m_Index = queue.Index;
+            Write( queueData );
+        }
+
+        for( const std::unordered_set<std::string>* pExtensions : {
+                 &m_Frontend.GetEnabledInstanceExtensions(),
+                 &m_Frontend.GetEnabledDeviceExtensions() } )
+        {
+            Write( static_cast<uint32_t>( pExtensions->size() ) );
+            for( const std::string& extension : *pExtensions )
+            {
+                WriteString( extension );
+            }
+        }
+
+        const uint32_t counterCount = m_Frontend.GetPerformanceCounterProperties( 0, nullptr );
+        std::vector<VkProfilerPerformanceCounterProperties2EXT> counters( counterCount );
+        m_Frontend.GetPerformanceCounterProperties( counterCount, counters.data() );
+        WriteVector( counters );
+
+        const uint32_t setCount = m_Frontend.GetPerformanceMetricsSets( 0, nullptr );
+        std::vector<VkProfilerPerformanceMetricsSetProperties2EXT> sets( setCount );
+        m_Frontend.GetPerformanceMetricsSets( setCount, sets.data() );
+        WriteVector( sets );
+
+        for( uint32_t setIndex = 0; setIndex < setCount; ++setIndex )
+        {
+            const uint32_t setCounterCount = m_Frontend.GetPerformanceMetricsSetCounterProperties( setIndex, 0, nullptr );
+            std::vector<VkProfilerPerformanceCounterProperties2EXT> setCounters( setCounterCount );
+            m_Frontend.GetPerformanceMetricsSetCounterProperties( setIndex, setCounterCount, setCounters.data() );
+            WriteVector( setCounters );
+        }
+
+        Write( m_Frontend.GetPerformanceCountersSamplingMode() );
+
+        for( VkTimeDomainEXT timeDomain : g_scTimeDomains )
+        {
+            Write( timeDomain );
+            Write( m_Frontend.GetDeviceCreateTimestamp( timeDomain ) );
+        }
+
+        return m_Data;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        SerializeFrameData
+
+    Description:
+        Serializes the frame and names of the objects referenced by it.
+        The returned buffer is valid until the next call to the serializer.
+
+    \*************************************************************************/
+    const std::vector<uint8_t>& ProfilerSharedMemorySerializer::SerializeFrameData( const DeviceProfilerFrameData& data )
+    {
+        m_Data.clear();
+        m_CommandBufferIndices.clear();
+        m_CommandBuffers.clear();
+        m_Objects.clear();
+
+        Write( g_scFormatHash );
+
+        // Command buffers are written before the submits, so the secondary
+        // command buffers are written before the primary ones executing them.
+        for( const DeviceProfilerSubmitBatchData& submitBatch : data.m_Submits )
+        {
+            for( const DeviceProfilerSubmitData& submit : submitBatch.m_Submits )
+            {
+                for( const DeviceProfilerCommandBufferDataPtr& pCommandBuffer : submit.m_CommandBuffers )
+                {
+                    if( pCommandBuffer )
+                    {
+                        CollectCommandBuffer( *pCommandBuffer );
+                    }
+                }
+            }
+        }
+
+        Write( static_cast<uint32_t>( m_CommandBuffers.size() ) );
+        for( const DeviceProfilerCommandBufferData* pCommandBuffer : m_CommandBuffers )
+        {
+            WriteCommandBuffer( *pCommandBuffer );
+        }
+
+        Write( static_cast<uint32_t>( data.m_Submits.size() ) );
+        for( const DeviceProfilerSubmitBatchData& submitBatch : data.m_Submits )
+        {
+            WriteSubmitBatch( submitBatch );
+        }
+
+        Write( static_cast<uint32_t>( data.m_TopPipelines.size() ) );
+        for( const DeviceProfilerPipelineData& pipeline : data.m_TopPipelines )
+        {
+            WritePipelineData( pipeline );
+        }
+
+        Write( data.m_Stats );
+        Write( data.m_Ticks );
+        Write( data.m_BeginTimestamp );
+        Write( data.m_EndTimestamp );
+        Write( data.m_FrameDelimiter );
+
+        WriteMemory( data.m_Memory );
+        WriteCPU( data.m_CPU );
+        WritePerformanceCounters( data.m_PerformanceCounters );
+        Write( data.m_SyncTimestamps );
+
+        Write( static_cast<uint32_t>( data.m_Hitches.size() ) );
+        for( const DeviceProfilerHitchData& hitch : data.m_Hitches )
+        {
+            WriteHitch( hitch );
+        }
+
+        WriteVector( data.m_SemaphoreDependencies );
+        Write( data.m_CriticalPathTicks );
+
+        Write( static_cast<uint32_t>( data.m_PipelineCompilations.size() ) );
+        for( const DeviceProfilerPipelineCompilationData& compilation : data.m_PipelineCompilations )
+        {
+            WritePipelineCompilation( compilation );
+        }
+
+        Write( data.m_PipelineCompilationTicks );
+        Write( data.m_Overhead );
+
+        WriteObjectNames();
+
+        return m_Data;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        CollectCommandBuffer
+
+    Description:
+        Assigns indices to the command buffer and the secondary command
+        buffers executed by it. Command buffers shared by many submits are
+        collected once.
+
+    \*************************************************************************/
+    void ProfilerSharedMemorySerializer::CollectCommandBuffer( const DeviceProfilerCommandBufferData& data )
+    {
+        if( m_CommandBufferIndices.count( &data ) )
+        {
+            return;
+        }
+
+        for( const DeviceProfilerRenderPassData& renderPass : data.m_RenderPasses )
+        {
+            for( const DeviceProfilerSubpassData& subpass : renderPass.m_Subpasses )
+            {
+                for( const DeviceProfilerSubpassData::Data& subpassData : subpass.m_Data )
+                {
+                    if( subpassData.GetType() == DeviceProfilerSubpassDataType::eCommandBuffer )
+                    {
+                        const DeviceProfilerCommandBufferDataPtr& pCommandBuffer =
+                            std::get<DeviceProfilerCommandBufferDataPtr>( subpassData );
+
+                        if( pCommandBuffer )
+                        {
+                            CollectCommandBuffer( *pCommandBuffer );
+                        }
+                    }
+                }
+            }
+        }
+
+        m_CommandBufferIndices.emplace( &data, static_cast<uint32_t>( m_CommandBuffers.size() ) );
+        m_CommandBuffers.push_back( &data );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WriteBytes
+
+    Description:
+        Appends raw data to the buffer.
+
+    \*************************************************************************/
+    void ProfilerSharedMemorySerializer::WriteBytes( const void* pData, size_t size )
+    {
+        if( size > 0 )
+        {
+            const uint8_t* pBytes = static_cast<const uint8_t*>( pData );
+            m_Data.insert( m_Data.end(), pBytes, pBytes + size );
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Write
+
+    Description:
+        Appends a plain structure to the buffer.
+
+    \*************************************************************************/
+    template<typename T>
+    void ProfilerSharedMemorySerializer::Write( const T& value )
+    {
+        static_assert( std::is_trivially_copyable_v<T>, "Only plain structures can be copied to the shared memory" );
+        WriteBytes( &value, sizeof( T ) );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WriteVector
+
+    Description:
+        Appends number of elements and an array of plain structures to the
+        buffer.
+
+    \*************************************************************************/
+    template<typename T>
+    void ProfilerSharedMemorySerializer::WriteVector( const std::vector<T>& values )
+    {
+        static_assert( std::is_trivially_copyable_v<T>, "Only plain structures can be copied to the shared memory" );
+        Write( static_cast<uint32_t>( values.size() ) );
+        WriteBytes( values.data(), values.size() * sizeof( T ) );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WriteString
+
+    Description:
+        Appends length and characters of the string to the buffer.
+        Null strings are written as empty.
+
+    \*************************************************************************/
+    void ProfilerSharedMemorySerializer::WriteString( const char* pString )
+    {
+        const uint32_t length = ( pString != nullptr ) ? static_cast<uint32_t>( strlen( pString ) ) : 0;
+        Write( length );
+        WriteBytes( pString, length );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WriteString
+
+    Description:
+        Appends length and characters of the string to the buffer.
+
+    \*************************************************************************/
+    void ProfilerSharedMemorySerializer::WriteString( const std::string& string )
+    {
+        Write( static_cast<uint32_t>( string.length() ) );
+        WriteBytes( string.data(), string.length() );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WriteObject
+
+    Description:
+        Appends the object handle to the buffer and remembers the object to
+        write its name at the end of the frame.
+
+    \*************************************************************************/
+    void ProfilerSharedMemorySerializer::WriteObject( const VkObject& object )
+    {
+        Write( object );
+
+        if( object.m_Handle != 0 )
+        {
+            m_Objects.insert( object );
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WriteSubmitBatch
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemorySerializer::WriteSubmitBatch( const DeviceProfilerSubmitBatchData& data )
+    {
+        WriteObject( data.m_Handle );
+        Write( data.m_Timestamp );
+        Write( data.m_ThreadId );
+
+        Write( static_cast<uint32_t>( data.m_Submits.size() ) );
+        for( const DeviceProfilerSubmitData& submit : data.m_Submits )
+        {
+            WriteSubmit( submit );
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WriteSubmit
+
+    Description:
+        Command buffers are written as indices to the command buffer table.
+
+    \*************************************************************************/
+    void ProfilerSharedMemorySerializer::WriteSubmit( const DeviceProfilerSubmitData& data )
+    {
+        Write( static_cast<uint32_t>( data.m_CommandBuffers.size() ) );
+        for( const DeviceProfilerCommandBufferDataPtr& pCommandBuffer : data.m_CommandBuffers )
+        {
+            Write( pCommandBuffer ? m_CommandBufferIndices.at( pCommandBuffer.get() ) : g_scNullCommandBufferIndex );
+        }
+
+        for( const std::vector<VkSemaphoreHandle>* pSemaphores : { &data.m_SignalSemaphores, &data.m_WaitSemaphores } )
+        {
+            Write( static_cast<uint32_t>( pSemaphores->size() ) );
+            for( const VkSemaphoreHandle& semaphore : *pSemaphores )
+            {
+                WriteObject( semaphore );
+            }
+        }
+
+        Write( data.m_BeginTimestamp );
+        Write( data.m_EndTimestamp );
+        Write( data.m_IdleTicks );
+        Write( data.m_IdleReason );
+        Write( data.m_SlackTicks );
+        Write( data.m_CriticalPath );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WriteCommandBuffer
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemorySerializer::WriteCommandBuffer( const DeviceProfilerCommandBufferData& data )
+    {
+        WriteObject( data.m_Handle );
+        Write( data.m_Level );
+        Write( data.m_Stats );
+        Write( data.m_BeginTimestamp );
+        Write( data.m_EndTimestamp );
+        Write( data.m_DataValid );
+        Write( data.m_HasTraceTriggerLabel );
+
+        Write( static_cast<uint32_t>( data.m_RenderPasses.size() ) );
+        for( const DeviceProfilerRenderPassData& renderPass : data.m_RenderPasses )
+        {
+            WriteRenderPass( renderPass );
+        }
+
+        WritePerformanceCounters( data.m_PerformanceCounters );
+        WriteVector( data.m_IndirectPayload );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WriteRenderPass
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemorySerializer::WriteRenderPass( const DeviceProfilerRenderPassData& data )
+    {
+        WriteObject( data.m_Handle );
+        Write( data.m_BeginTimestamp );
+        Write( data.m_EndTimestamp );
+        Write( data.m_Type );
+        Write( data.m_Dynamic );
+        Write( data.m_ClearsColorAttachments );
+        Write( data.m_ClearsDepthStencilAttachments );
+        Write( data.m_ResolvesAttachments );
+        Write( data.m_Begin );
+        Write( data.m_End );
+        Write( data.m_PipelineStatistics );
+
+        Write( static_cast<uint32_t>( data.m_Subpasses.size() ) );
+        for( const DeviceProfilerSubpassData& subpass : data.m_Subpasses )
+        {
+            WriteSubpass( subpass );
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WriteSubpass
+
+    Description:
+        Secondary command buffers are written as indices to the command
+        buffer table.
+
+    \*************************************************************************/
+    void ProfilerSharedMemorySerializer::WriteSubpass( const DeviceProfilerSubpassData& data )
+    {
+        Write( data.m_Index );
+        Write( data.m_Contents );
+        Write( data.m_BeginTimestamp );
+        Write( data.m_EndTimestamp );
+
+        Write( static_cast<uint32_t>( data.m_Data.size() ) );
+        for( const DeviceProfilerSubpassData::Data& subpassData : data.m_Data )
+        {
+            Write( subpassData.GetType() );
+
+            switch( subpassData.GetType() )
+            {
+            case DeviceProfilerSubpassDataType::ePipeline:
+                WritePipelineData( std::get<DeviceProfilerPipelineData>( subpassData ) );
+                break;
+
+            case DeviceProfilerSubpassDataType::eCommandBuffer:
+            {
+                const DeviceProfilerCommandBufferDataPtr& pCommandBuffer =
+                    std::get<DeviceProfilerCommandBufferDataPtr>( subpassData );
+
+                Write( pCommandBuffer ? m_CommandBufferIndices.at( pCommandBuffer.get() ) : g_scNullCommandBufferIndex );
+                break;
+            }
+            }
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WritePipeline
+
+    Description:
+        Shader modules, executables and create infos are not written.
+
+    \*************************************************************************/
+    void ProfilerSharedMemorySerializer::WritePipeline( const DeviceProfilerPipeline& data )
+    {
+        WriteObject( data.m_Handle );
+        Write( data.m_BindPoint );
+        Write( data.m_Type );
+        Write( data.m_Internal );
+        Write( data.m_UsesRayQuery );
+        Write( data.m_UsesRayTracing );
+        Write( data.m_UsesMeshShading );
+        Write( data.m_UsesShaderObjects );
+        Write( data.m_RayTracingPipelineStackSize );
+
+        Write( data.m_ShaderTuple.m_Hash );
+        Write( static_cast<uint32_t>( data.m_ShaderTuple.m_Shaders.size() ) );
+        for( const ProfilerShader& shader : data.m_ShaderTuple.m_Shaders )
+        {
+            Write( shader.m_Hash );
+            Write( shader.m_Index );
+            Write( shader.m_Stage );
+            WriteString( shader.m_EntryPoint );
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WritePipelineData
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemorySerializer::WritePipelineData( const DeviceProfilerPipelineData& data )
+    {
+        WritePipeline( data );
+        Write( data.m_BeginTimestamp );
+        Write( data.m_EndTimestamp );
+        Write( data.m_PipelineStatistics );
+
+        Write( static_cast<uint32_t>( data.m_Drawcalls.size() ) );
+        for( const DeviceProfilerDrawcall& drawcall : data.m_Drawcalls )
+        {
+            WriteDrawcall( drawcall );
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WriteDrawcall
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemorySerializer::WriteDrawcall( const DeviceProfilerDrawcall& data )
+    {
+        Write( data.m_Type );
+        Write( data.m_BeginTimestamp );
+        Write( data.m_EndTimestamp );
+
+    #define PROFILER_WRITE_DRAWCALL_PAYLOAD( type, name, ... ) \
+        case type::m_scDrawcallType: WritePayload( data.m_Payload.name ); break;
+
+        switch( data.m_Type )
+        {
+            PROFILER_MAP_DRAWCALL_PAYLOAD( PROFILER_WRITE_DRAWCALL_PAYLOAD )
+        }
+
+    #undef PROFILER_WRITE_DRAWCALL_PAYLOAD
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WritePayload
+
+    Description:
+        Writes the payload as it is and collects the objects referenced by it.
+        Pointers in the payloads without a specialized overload are not
+        followed and are cleared by the reader.
+
+    \*************************************************************************/
+    template<typename PayloadT>
+    void ProfilerSharedMemorySerializer::WritePayload( const PayloadT& payload )
+    {
+        Write( payload );
+
+        PayloadT resolvedPayload = payload;
+        resolvedPayload.ResolveObjectHandles( *this );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WriteDebugLabelPayload
+
+    Description:
+
+    \*************************************************************************/
+    template<DeviceProfilerDrawcallType Type>
+    void ProfilerSharedMemorySerializer::WriteDebugLabelPayload( const DeviceProfilerDrawcallDebugLabelBasePayload<Type>& payload )
+    {
+        Write( payload );
+        WriteString( payload.m_pName );
+    }
+
+    void ProfilerSharedMemorySerializer::WritePayload( const DeviceProfilerDrawcallInsertDebugLabelPayload& payload )
+    {
+        WriteDebugLabelPayload( payload );
+    }
+
+    void ProfilerSharedMemorySerializer::WritePayload( const DeviceProfilerDrawcallBeginDebugLabelPayload& payload )
+    {
+        WriteDebugLabelPayload( payload );
+    }
+
+    void ProfilerSharedMemorySerializer::WritePayload( const DeviceProfilerDrawcallEndDebugLabelPayload& payload )
+    {
+        WriteDebugLabelPayload( payload );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WritePayload
+
+    Description:
+        Writes the payload and the draw infos captured from the application.
+
+    \*************************************************************************/
+    void ProfilerSharedMemorySerializer::WritePayload( const DeviceProfilerDrawcallDrawMultiPayload& payload )
+    {
+        Write( payload );
+
+        const uint32_t drawCount = ( payload.m_pVertexInfo != nullptr ) ? payload.m_DrawCount : 0;
+        Write( drawCount );
+        WriteBytes( payload.m_pVertexInfo, drawCount * sizeof( VkMultiDrawInfoEXT ) );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WritePayload
+
+    Description:
+        Writes the payload and the draw infos captured from the application.
+        Vertex offsets are stored in the draw infos.
+
+    \*************************************************************************/
+    void ProfilerSharedMemorySerializer::WritePayload( const DeviceProfilerDrawcallDrawMultiIndexedPayload& payload )
+    {
+        Write( payload );
+
+        const uint32_t drawCount = ( payload.m_pIndexInfo != nullptr ) ? payload.m_DrawCount : 0;
+        Write( drawCount );
+
+        for( uint32_t i = 0; i < drawCount; ++i )
+        {
+            VkMultiDrawIndexedInfoEXT indexInfo = payload.m_pIndexInfo[ i ];
+            if( payload.m_pVertexOffset != nullptr )
+            {
+                indexInfo.vertexOffset = payload.m_pVertexOffset[ i ];
+            }
+
+            Write( indexInfo );
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WritePerformanceCounters
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemorySerializer::WritePerformanceCounters( const DeviceProfilerPerformanceCountersData& data )
+    {
+        Write( data.m_MetricsSetIndex );
+        WriteVector( data.m_Results );
+        WriteVector( data.m_StreamTimestamps );
+
+        Write( static_cast<uint32_t>( data.m_StreamResults.size() ) );
+        for( const DeviceProfilerPerformanceCounterStreamData& stream : data.m_StreamResults )
+        {
+            Write( stream.m_MaxValue );
+            Write( stream.m_MinValue );
+            WriteVector( stream.m_Samples );
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WriteMemory
+
+    Description:
+        Snapshots and events of the memory are not written.
+
+    \*************************************************************************/
+    void ProfilerSharedMemorySerializer::WriteMemory( const DeviceProfilerMemoryData& data )
+    {
+        Write( data.m_TotalAllocationSize );
+        Write( data.m_TotalAllocationCount );
+        WriteVector( data.m_Heaps );
+        WriteVector( data.m_Types );
+        Write( data.m_Churn );
+        Write( data.m_DroppedEventCount );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WriteCPU
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemorySerializer::WriteCPU( const DeviceProfilerCPUData& data )
+    {
+        Write( data.m_BeginTimestamp );
+        Write( data.m_EndTimestamp );
+        Write( data.m_FramesPerSec );
+        Write( data.m_FrameIndex );
+        Write( data.m_ThreadId );
+        WriteVector( data.m_Spans );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WriteHitch
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemorySerializer::WriteHitch( const DeviceProfilerHitchData& data )
+    {
+        Write( data.m_RegionType );
+        WritePipeline( data.m_Pipeline );
+        WriteObject( data.m_RenderPass );
+        WriteString( data.m_DebugLabel );
+        Write( data.m_FrameIndex );
+        Write( data.m_Ticks );
+        Write( data.m_MeanTicks );
+        Write( data.m_StdDevTicks );
+        Write( data.m_P99Ticks );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WritePipelineCompilation
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemorySerializer::WritePipelineCompilation( const DeviceProfilerPipelineCompilationData& data )
+    {
+        Write( data.m_ThreadId );
+        Write( data.m_BeginTimestamp );
+        Write( data.m_EndTimestamp );
+        Write( data.m_Deferred );
+
+        Write( static_cast<uint32_t>( data.m_Pipelines.size() ) );
+        for( const DeviceProfilerPipelineCreationFeedbackData& pipeline : data.m_Pipelines )
+        {
+            WritePipeline( pipeline.m_Pipeline );
+            Write( pipeline.m_Flags );
+            Write( pipeline.m_Duration );
+            WriteVector( pipeline.m_Stages );
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WriteObjectNames
+
+    Description:
+        Writes names of the objects referenced by the frame. Objects without
+        names are skipped.
+
+    \*************************************************************************/
+    void ProfilerSharedMemorySerializer::WriteObjectNames()
+    {
+        std::vector<std::pair<VkObject, std::string>> objectNames;
+        objectNames.reserve( m_Objects.size() );
+
+        for( const VkObject& object : m_Objects )
+        {
+            std::string name = m_Frontend.GetObjectName( object );
+            if( !name.empty() )
+            {
+                objectNames.emplace_back( object, std::move( name ) );
+            }
+        }
+
+        Write( static_cast<uint32_t>( objectNames.size() ) );
+        for( const auto& [object, name] : objectNames )
+        {
+            Write( object );
+            WriteString( name );
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ProfilerSharedMemoryDeserializer
+
+    Description:
+        Constructor.
+
+    \*************************************************************************/
+    ProfilerSharedMemoryDeserializer::ProfilerSharedMemoryDeserializer()
+        : m_pData( nullptr )
+        , m_Size( 0 )
+        , m_Offset( 0 )
+        , m_Valid( false )
+        , m_CommandBuffers()
+    {
+    }
+
+    /*************************************************************************\
+
+    Function:
+        DeserializeDeviceData
+
+    Description:
+        Reads the properties of the device.
+
+    \*************************************************************************/
+    bool ProfilerSharedMemoryDeserializer::DeserializeDeviceData( const std::vector<uint8_t>& data, ProfilerSharedMemoryDeviceData& deviceData )
+    {
+        Reset( data );
+
+        if( !ReadFormatHash() )
+        {
+            return false;
+        }
+
+        deviceData.m_ApplicationInfo = {};
+        deviceData.m_ApplicationInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+        Read( deviceData.m_ApplicationInfo.applicationVersion );
+        Read( deviceData.m_ApplicationInfo.engineVersion );
+        Read( deviceData.m_ApplicationInfo.apiVersion );
+        ReadString( deviceData.m_ApplicationName );
+        ReadString( deviceData.m_EngineName );
+
+        Read( deviceData.m_PhysicalDeviceProperties );
+        Read( deviceData.m_PhysicalDeviceMemoryProperties );
+        ReadVector( deviceData.m_QueueFamilyProperties );
+        ReadVector( deviceData.m_Queues );
+
+        for( std::unordered_set<std::string>* pExtensions : {
+                 &deviceData.m_EnabledInstanceExtensions,
+                 &deviceData.m_EnabledDeviceExtensions } )
+        {
+            pExtensions->clear();
+
+            const uint32_t extensionCount = ReadCount( sizeof( uint32_t ) );
+            for( uint32_t i = 0; ( i < extensionCount ) && m_Valid; ++i )
+            {
+                std::string extension;
+                ReadString( extension );
+                pExtensions->insert( std::move( extension ) );
+            }
+        }
+
+        ReadVector( deviceData.m_PerformanceCounterProperties );
+        ReadVector( deviceData.m_PerformanceMetricsSets );
+
+        deviceData.m_PerformanceMetricsSetCounterProperties.clear();
+        deviceData.m_PerformanceMetricsSetCounterProperties.resize( deviceData.m_PerformanceMetricsSets.size() );
+        for( auto& setCounters : deviceData.m_PerformanceMetricsSetCounterProperties )
+        {
+            ReadVector( setCounters );
+        }
+
+        // Extension chains of the writer are not valid in this process.
+        for( VkProfilerPerformanceCounterProperties2EXT& counter : deviceData.m_PerformanceCounterProperties )
+        {
+            counter.pNext = nullptr;
+        }
+
+        for( auto& setCounters : deviceData.m_PerformanceMetricsSetCounterProperties )
+        {
+            for( VkProfilerPerformanceCounterProperties2EXT& counter : setCounters )
+            {
+                counter.pNext = nullptr;
+            }
+        }
+
+        for( VkProfilerPerformanceMetricsSetProperties2EXT& set : deviceData.m_PerformanceMetricsSets )
+        {
+            set.pNext = nullptr;
+        }
+
+        Read( deviceData.m_PerformanceCountersSamplingMode );
+
+        deviceData.m_DeviceCreateTimestamps.clear();
+        for( size_t i = 0; i < std::size( g_scTimeDomains ); ++i )
+        {
+            VkTimeDomainEXT timeDomain = {};
+            uint64_t timestamp = 0;
+            Read( timeDomain );
+            Read( timestamp );
+            deviceData.m_DeviceCreateTimestamps[ timeDomain ] = timestamp;
+        }
+
+        return m_Valid && ( m_Offset == m_Size );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        DeserializeFrameData
+
+    Description:
+        Reads the frame and names of the objects referenced by it.
+        Names are added to objectNames.
+
+    \*************************************************************************/
+    bool ProfilerSharedMemoryDeserializer::DeserializeFrameData( const std::vector<uint8_t>& data, DeviceProfilerFrameData& frameData, std::unordered_map<VkObject, std::string>& objectNames )
+    {
+        Reset( data );
+
+        if( !ReadFormatHash() )
+        {
+            return false;
+        }
+
+        const uint32_t commandBufferCount = ReadCount( sizeof( VkObject ) );
+        for( uint32_t i = 0; ( i < commandBufferCount ) && m_Valid; ++i )
+        {
+            auto pCommandBuffer = std::make_shared<DeviceProfilerCommandBufferData>();
+            ReadCommandBuffer( *pCommandBuffer );
+            m_CommandBuffers.push_back( std::move( pCommandBuffer ) );
+        }
+
+        const uint32_t submitBatchCount = ReadCount( sizeof( VkObject ) );
+        for( uint32_t i = 0; ( i < submitBatchCount ) && m_Valid; ++i )
+        {
+            ReadSubmitBatch( frameData.m_Submits.emplace_back() );
+        }
+
+        const uint32_t topPipelineCount = ReadCount( sizeof( VkObject ) );
+        for( uint32_t i = 0; ( i < topPipelineCount ) && m_Valid; ++i )
+        {
+            ReadPipelineData( frameData.m_TopPipelines.emplace_back() );
+        }
+
+        Read( frameData.m_Stats );
+        Read( frameData.m_Ticks );
+        Read( frameData.m_BeginTimestamp );
+        Read( frameData.m_EndTimestamp );
+        Read( frameData.m_FrameDelimiter );
+
+        ReadMemory( frameData.m_Memory );
+        ReadCPU( frameData.m_CPU );
+        ReadPerformanceCounters( frameData.m_PerformanceCounters );
+        Read( frameData.m_SyncTimestamps );
+
+        const uint32_t hitchCount = ReadCount( sizeof( DeviceProfilerHitchRegionType ) );
+        for( uint32_t i = 0; ( i < hitchCount ) && m_Valid; ++i )
+        {
+            ReadHitch( frameData.m_Hitches.emplace_back() );
+        }
+
+        ReadVector( frameData.m_SemaphoreDependencies );
+        Read( frameData.m_CriticalPathTicks );
+
+        const uint32_t compilationCount = ReadCount( sizeof( uint32_t ) );
+        for( uint32_t i = 0; ( i < compilationCount ) && m_Valid; ++i )
+        {
+            ReadPipelineCompilation( frameData.m_PipelineCompilations.emplace_back() );
+        }
+
+        Read( frameData.m_PipelineCompilationTicks );
+        Read( frameData.m_Overhead );
+
+        ReadObjectNames( objectNames );
+
+        m_CommandBuffers.clear();
+
+        return m_Valid && ( m_Offset == m_Size );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Reset
+
+    Description:
+        Starts reading the buffer.
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryDeserializer::Reset( const std::vector<uint8_t>& data )
+    {
+        m_pData = data.data();
+        m_Size = data.size();
+        m_Offset = 0;
+        m_Valid = true;
+        m_CommandBuffers.clear();
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadBytes
+
+    Description:
+        Copies raw data from the buffer. Marks the data as invalid and fills
+        the output with zeros if the buffer is too small.
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryDeserializer::ReadBytes( void* pData, size_t size )
+    {
+        if( !m_Valid || ( size > m_Size - m_Offset ) )
+        {
+            memset( pData, 0, size );
+            m_Offset = m_Size;
+            m_Valid = false;
+            return;
+        }
+
+        if( size > 0 )
+        {
+            memcpy( pData, m_pData + m_Offset, size );
+            m_Offset += size;
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Read
+
+    Description:
+        Copies a plain structure from the buffer.
+
+    \*************************************************************************/
+    template<typename T>
+    void ProfilerSharedMemoryDeserializer::Read( T& value )
+    {
+        static_assert( std::is_trivially_copyable_v<T>, "Only plain structures can be copied from the shared memory" );
+        ReadBytes( &value, sizeof( T ) );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadCount
+
+    Description:
+        Reads number of elements that follow. Marks the data as invalid if
+        the elements, each at least elementSize bytes long, cannot fit in the
+        rest of the buffer.
+
+    \*************************************************************************/
+    uint32_t ProfilerSharedMemoryDeserializer::ReadCount( size_t elementSize )
+    {
+        uint32_t count = 0;
+        Read( count );
+
+        if( static_cast<uint64_t>( count ) * elementSize > m_Size - m_Offset )
+        {
+            m_Offset = m_Size;
+            m_Valid = false;
+            return 0;
+        }
+
+        return count;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadVector
+
+    Description:
+        Copies an array of plain structures from the buffer.
+
+    \*************************************************************************/
+    template<typename T>
+    void ProfilerSharedMemoryDeserializer::ReadVector( std::vector<T>& values )
+    {
+        static_assert( std::is_trivially_copyable_v<T>, "Only plain structures can be copied from the shared memory" );
+        values.resize( ReadCount( sizeof( T ) ) );
+        ReadBytes( values.data(), values.size() * sizeof( T ) );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadString
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryDeserializer::ReadString( std::string& string )
+    {
+        string.resize( ReadCount( sizeof( char ) ) );
+        ReadBytes( string.data(), string.length() );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadStringCopy
+
+    Description:
+        Reads a string to a null-terminated copy allocated with malloc, as
+        expected by the drawcall payloads.
+
+    \*************************************************************************/
+    char* ProfilerSharedMemoryDeserializer::ReadStringCopy()
+    {
+        std::string string;
+        ReadString( string );
+
+        char* pString = static_cast<char*>( malloc( string.length() + 1 ) );
+        if( pString != nullptr )
+        {
+            memcpy( pString, string.c_str(), string.length() + 1 );
+        }
+
+        return pString;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadFormatHash
+
+    Description:
+        Checks if the data was written by a layer using the same definitions
+        of the structures.
+
+    \*************************************************************************/
+    bool ProfilerSharedMemoryDeserializer::ReadFormatHash()
+    {
+        uint64_t formatHash = 0;
+        Read( formatHash );
+
+        return m_Valid && ( formatHash == g_scFormatHash );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadSubmitBatch
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryDeserializer::ReadSubmitBatch( DeviceProfilerSubmitBatchData& data )
+    {
+        Read( data.m_Handle );
+        Read( data.m_Timestamp );
+        Read( data.m_ThreadId );
+
+        const uint32_t submitCount = ReadCount( sizeof( uint32_t ) );
+        for( uint32_t i = 0; ( i < submitCount ) && m_Valid; ++i )
+        {
+            ReadSubmit( data.m_Submits.emplace_back() );
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadSubmit
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryDeserializer::ReadSubmit( DeviceProfilerSubmitData& data )
+    {
+        const uint32_t commandBufferCount = ReadCount( sizeof( uint32_t ) );
+        for( uint32_t i = 0; ( i < commandBufferCount ) && m_Valid; ++i )
+        {
+            ReadCommandBufferReference( data.m_CommandBuffers.emplace_back() );
+        }
+
+        for( std::vector<VkSemaphoreHandle>* pSemaphores : { &data.m_SignalSemaphores, &data.m_WaitSemaphores } )
+        {
+            ReadVector( *pSemaphores );
+        }
+
+        Read( data.m_BeginTimestamp );
+        Read( data.m_EndTimestamp );
+        Read( data.m_IdleTicks );
+        Read( data.m_IdleReason );
+        Read( data.m_SlackTicks );
+        Read( data.m_CriticalPath );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadCommandBuffer
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryDeserializer::ReadCommandBuffer( DeviceProfilerCommandBufferData& data )
+    {
+        Read( data.m_Handle );
+        Read( data.m_Level );
+        Read( data.m_Stats );
+        Read( data.m_BeginTimestamp );
+        Read( data.m_EndTimestamp );
+        Read( data.m_DataValid );
+        Read( data.m_HasTraceTriggerLabel );
+
+        const uint32_t renderPassCount = ReadCount( sizeof( VkObject ) );
+        for( uint32_t i = 0; ( i < renderPassCount ) && m_Valid; ++i )
+        {
+            ReadRenderPass( data.m_RenderPasses.emplace_back() );
+        }
+
+        ReadPerformanceCounters( data.m_PerformanceCounters );
+        ReadVector( data.m_IndirectPayload );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadCommandBufferReference
+
+    Description:
+        Resolves index to the command buffer table. Command buffers can
+        reference only the command buffers read before them.
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryDeserializer::ReadCommandBufferReference( DeviceProfilerCommandBufferDataPtr& pData )
+    {
+        uint32_t index = g_scNullCommandBufferIndex;
+        Read( index );
+
+        if( index == g_scNullCommandBufferIndex )
+        {
+            pData = nullptr;
+        }
+        else if( index < m_CommandBuffers.size() )
+        {
+            pData = m_CommandBuffers[ index ];
+        }
+        else
+        {
+            m_Valid = false;
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadRenderPass
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryDeserializer::ReadRenderPass( DeviceProfilerRenderPassData& data )
+    {
+        Read( data.m_Handle );
+        Read( data.m_BeginTimestamp );
+        Read( data.m_EndTimestamp );
+        Read( data.m_Type );
+        Read( data.m_Dynamic );
+        Read( data.m_ClearsColorAttachments );
+        Read( data.m_ClearsDepthStencilAttachments );
+        Read( data.m_ResolvesAttachments );
+        Read( data.m_Begin );
+        Read( data.m_End );
+        Read( data.m_PipelineStatistics );
+
+        const uint32_t subpassCount = ReadCount( sizeof( uint32_t ) );
+        for( uint32_t i = 0; ( i < subpassCount ) && m_Valid; ++i )
+        {
+            ReadSubpass( data.m_Subpasses.emplace_back() );
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadSubpass
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryDeserializer::ReadSubpass( DeviceProfilerSubpassData& data )
+    {
+        Read( data.m_Index );
+        Read( data.m_Contents );
+        Read( data.m_BeginTimestamp );
+        Read( data.m_EndTimestamp );
+
+        const uint32_t dataCount = ReadCount( sizeof( DeviceProfilerSubpassDataType ) );
+        for( uint32_t i = 0; ( i < dataCount ) && m_Valid; ++i )
+        {
+            DeviceProfilerSubpassDataType type = {};
+            Read( type );
+
+            switch( type )
+            {
+            case DeviceProfilerSubpassDataType::ePipeline:
+            {
+                DeviceProfilerPipelineData pipeline;
+                ReadPipelineData( pipeline );
+                data.m_Data.emplace_back( std::move( pipeline ) );
+                break;
+            }
+
+            case DeviceProfilerSubpassDataType::eCommandBuffer:
+            {
+                DeviceProfilerCommandBufferDataPtr pCommandBuffer;
+                ReadCommandBufferReference( pCommandBuffer );
+                data.m_Data.emplace_back( std::move( pCommandBuffer ) );
+                break;
+            }
+
+            default:
+                m_Valid = false;
+                break;
+            }
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadPipeline
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryDeserializer::ReadPipeline( DeviceProfilerPipeline& data )
+    {
+        Read( data.m_Handle );
+        Read( data.m_BindPoint );
+        Read( data.m_Type );
+        Read( data.m_Internal );
+        Read( data.m_UsesRayQuery );
+        Read( data.m_UsesRayTracing );
+        Read( data.m_UsesMeshShading );
+        Read( data.m_UsesShaderObjects );
+        Read( data.m_RayTracingPipelineStackSize );
+
+        Read( data.m_ShaderTuple.m_Hash );
+
+        const uint32_t shaderCount = ReadCount( 3 * sizeof( uint32_t ) );
+        for( uint32_t i = 0; ( i < shaderCount ) && m_Valid; ++i )
+        {
+            ProfilerShader& shader = data.m_ShaderTuple.m_Shaders.emplace_back();
+            Read( shader.m_Hash );
+            Read( shader.m_Index );
+            Read( shader.m_Stage );
+            ReadString( shader.m_EntryPoint );
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadPipelineData
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryDeserializer::ReadPipelineData( DeviceProfilerPipelineData& data )
+    {
+        ReadPipeline( data );
+        Read( data.m_BeginTimestamp );
+        Read( data.m_EndTimestamp );
+        Read( data.m_PipelineStatistics );
+
+        const uint32_t drawcallCount = ReadCount( sizeof( DeviceProfilerDrawcallType ) );
+        for( uint32_t i = 0; ( i < drawcallCount ) && m_Valid; ++i )
+        {
+            ReadDrawcall( data.m_Drawcalls.emplace_back() );
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadDrawcall
+
+    Description:
+        The type of the drawcall is set after its payload has been read, so
+        the drawcall can be safely destroyed if the data is invalid.
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryDeserializer::ReadDrawcall( DeviceProfilerDrawcall& data )
+    {
+        DeviceProfilerDrawcallType type = {};
+        Read( type );
+        Read( data.m_BeginTimestamp );
+        Read( data.m_EndTimestamp );
+
+    #define PROFILER_READ_DRAWCALL_PAYLOAD( type, name, ... ) \
+        case type::m_scDrawcallType: ReadPayload<type>( data ); break;
+
+        switch( type )
+        {
+            PROFILER_MAP_DRAWCALL_PAYLOAD( PROFILER_READ_DRAWCALL_PAYLOAD )
+
+        default:
+            m_Valid = false;
+            break;
+        }
+
+    #undef PROFILER_READ_DRAWCALL_PAYLOAD
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadPayload
+
+    Description:
+        Reads the payload and replaces its pointers with copies owned by the
+        drawcall.
+
+    \*************************************************************************/
+    template<typename PayloadT>
+    void ProfilerSharedMemoryDeserializer::ReadPayload( DeviceProfilerDrawcall& drawcall )
+    {
+        PayloadT payload = {};
+        Read( payload );
+        ReadDynamicAllocations( payload );
+
+        drawcall.m_Type = PayloadT::m_scDrawcallType;
+        drawcall.m_Payload = payload;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadDynamicAllocations
+
+    Description:
+        Plain payloads don't have any dynamic allocations.
+
+    \*************************************************************************/
+    template<typename PayloadT>
+    void ProfilerSharedMemoryDeserializer::ReadDynamicAllocations( PayloadT& )
+    {
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadDebugLabelDynamicAllocations
+
+    Description:
+
+    \*************************************************************************/
+    template<DeviceProfilerDrawcallType Type>
+    void ProfilerSharedMemoryDeserializer::ReadDebugLabelDynamicAllocations( DeviceProfilerDrawcallDebugLabelBasePayload<Type>& payload )
+    {
+        payload.m_pName = ReadStringCopy();
+        payload.m_OwnsDynamicAllocations = true;
+    }
+
+    void ProfilerSharedMemoryDeserializer::ReadDynamicAllocations( DeviceProfilerDrawcallInsertDebugLabelPayload& payload )
+    {
+        ReadDebugLabelDynamicAllocations( payload );
+    }
+
+    void ProfilerSharedMemoryDeserializer::ReadDynamicAllocations( DeviceProfilerDrawcallBeginDebugLabelPayload& payload )
+    {
+        ReadDebugLabelDynamicAllocations( payload );
+    }
+
+    void ProfilerSharedMemoryDeserializer::ReadDynamicAllocations( DeviceProfilerDrawcallEndDebugLabelPayload& payload )
+    {
+        ReadDebugLabelDynamicAllocations( payload );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadDynamicAllocations
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryDeserializer::ReadDynamicAllocations( DeviceProfilerDrawcallDrawMultiPayload& payload )
+    {
+        payload.m_DrawCount = ReadCount( sizeof( VkMultiDrawInfoEXT ) );
+        payload.m_pVertexInfo = nullptr;
+        payload.m_OwnsDynamicAllocations = true;
+
+        if( payload.m_DrawCount > 0 )
+        {
+            VkMultiDrawInfoEXT* pVertexInfo = static_cast<VkMultiDrawInfoEXT*>(
+                malloc( payload.m_DrawCount * sizeof( VkMultiDrawInfoEXT ) ) );
+
+            if( pVertexInfo == nullptr )
+            {
+                m_Valid = false;
+                payload.m_DrawCount = 0;
+                return;
+            }
+
+            ReadBytes( pVertexInfo, payload.m_DrawCount * sizeof( VkMultiDrawInfoEXT ) );
+            payload.m_pVertexInfo = pVertexInfo;
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadDynamicAllocations
+
+    Description:
+        Vertex offsets are stored in the draw infos.
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryDeserializer::ReadDynamicAllocations( DeviceProfilerDrawcallDrawMultiIndexedPayload& payload )
+    {
+        payload.m_DrawCount = ReadCount( sizeof( VkMultiDrawIndexedInfoEXT ) );
+        payload.m_pIndexInfo = nullptr;
+        payload.m_pVertexOffset = nullptr;
+        payload.m_OwnsDynamicAllocations = true;
+
+        if( payload.m_DrawCount > 0 )
+        {
+            VkMultiDrawIndexedInfoEXT* pIndexInfo = static_cast<VkMultiDrawIndexedInfoEXT*>(
+                malloc( payload.m_DrawCount * sizeof( VkMultiDrawIndexedInfoEXT ) ) );
+
+            if( pIndexInfo == nullptr )
+            {
+                m_Valid = false;
+                payload.m_DrawCount = 0;
+                return;
+            }
+
+            ReadBytes( pIndexInfo, payload.m_DrawCount * sizeof( VkMultiDrawIndexedInfoEXT ) );
+            payload.m_pIndexInfo = pIndexInfo;
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadDynamicAllocations
+
+    Description:
+        Build infos are not serialized.
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryDeserializer::ReadDynamicAllocations( DeviceProfilerDrawcallBuildAccelerationStructuresPayload& payload )
+    {
+        payload.m_pSharedData = nullptr;
+        payload.m_pInfos = nullptr;
+        payload.m_ppRanges = nullptr;
+    }
+
+    void ProfilerSharedMemoryDeserializer::ReadDynamicAllocations( DeviceProfilerDrawcallBuildAccelerationStructuresIndirectPayload& payload )
+    {
+        payload.m_pSharedData = nullptr;
+        payload.m_pInfos = nullptr;
+        payload.m_ppMaxPrimitiveCounts = nullptr;
+    }
+
+    void ProfilerSharedMemoryDeserializer::ReadDynamicAllocations( DeviceProfilerDrawcallBuildMicromapsPayload& payload )
+    {
+        payload.m_pSharedData = nullptr;
+        payload.m_pInfos = nullptr;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadPerformanceCounters
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryDeserializer::ReadPerformanceCounters( DeviceProfilerPerformanceCountersData& data )
+    {
+        Read( data.m_MetricsSetIndex );
+        ReadVector( data.m_Results );
+        ReadVector( data.m_StreamTimestamps );
+
+        const uint32_t streamCount = ReadCount( 2 * sizeof( VkProfilerPerformanceCounterResultEXT ) );
+        for( uint32_t i = 0; ( i < streamCount ) && m_Valid; ++i )
+        {
+            DeviceProfilerPerformanceCounterStreamData& stream = data.m_StreamResults.emplace_back();
+            Read( stream.m_MaxValue );
+            Read( stream.m_MinValue );
+            ReadVector( stream.m_Samples );
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadMemory
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryDeserializer::ReadMemory( DeviceProfilerMemoryData& data )
+    {
+        Read( data.m_TotalAllocationSize );
+        Read( data.m_TotalAllocationCount );
+        ReadVector( data.m_Heaps );
+        ReadVector( data.m_Types );
+        Read( data.m_Churn );
+        Read( data.m_DroppedEventCount );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadCPU
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryDeserializer::ReadCPU( DeviceProfilerCPUData& data )
+    {
+        Read( data.m_BeginTimestamp );
+        Read( data.m_EndTimestamp );
+        Read( data.m_FramesPerSec );
+        Read( data.m_FrameIndex );
+        Read( data.m_ThreadId );
+        ReadVector( data.m_Spans );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadHitch
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryDeserializer::ReadHitch( DeviceProfilerHitchData& data )
+    {
+        Read( data.m_RegionType );
+        ReadPipeline( data.m_Pipeline );
+        Read( data.m_RenderPass );
+        ReadString( data.m_DebugLabel );
+        Read( data.m_FrameIndex );
+        Read( data.m_Ticks );
+        Read( data.m_MeanTicks );
+        Read( data.m_StdDevTicks );
+        Read( data.m_P99Ticks );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadPipelineCompilation
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryDeserializer::ReadPipelineCompilation( DeviceProfilerPipelineCompilationData& data )
+    {
+        Read( data.m_ThreadId );
+        Read( data.m_BeginTimestamp );
+        Read( data.m_EndTimestamp );
+        Read( data.m_Deferred );
+
+        const uint32_t pipelineCount = ReadCount( sizeof( VkObject ) );
+        for( uint32_t i = 0; ( i < pipelineCount ) && m_Valid; ++i )
+        {
+            DeviceProfilerPipelineCreationFeedbackData& pipeline = data.m_Pipelines.emplace_back();
+            ReadPipeline( pipeline.m_Pipeline );
+            Read( pipeline.m_Flags );
+            Read( pipeline.m_Duration );
+            ReadVector( pipeline.m_Stages );
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ReadObjectNames
+
+    Description:
+
+    \*************************************************************************/
+    void ProfilerSharedMemoryDeserializer::ReadObjectNames( std::unordered_map<VkObject, std::string>& objectNames )
+    {
+        const uint32_t objectCount = ReadCount( sizeof( VkObject ) );
+        for( uint32_t i = 0; ( i < objectCount ) && m_Valid; ++i )
+        {
+            VkObject object;
+            std::string name;
+            Read( object );
+            ReadString( name );
+
+            if( m_Valid )
+            {
+                objectNames[ object ] = std::move( name );
+            }
+        }
+    }
+}
@@ -0,0 +1,236 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+#include "profiler/profiler_data.h"
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Profiler
+{
+    class DeviceProfilerFrontend;
+
+    /*************************************************************************\
+
+    Structure:
+        ProfilerSharedMemoryQueueData
+
+    Description:
+        Properties of a queue created by the profiled application.
+
+    \*************************************************************************/
+    struct ProfilerSharedMemoryQueueData
+    {
+        VkQueue m_Handle = {};
+        VkQueueFlags m_Flags = {};
+        uint32_t m_Family = {};
+        uint32_t m_Index = {};
+    };
+
+    /*************************************************************************\
+
+    Structure:
+        ProfilerSharedMemoryDeviceData
+
+    Description:
+        Properties of the profiled device, which don't change between the
+        frames. Names of the application and the engine are stored separately,
+        pointers in m_ApplicationInfo are null.
+
+    \*************************************************************************/
+    struct ProfilerSharedMemoryDeviceData
+    {
+        VkApplicationInfo m_ApplicationInfo = {};
+        std::string m_ApplicationName = {};
+        std::string m_EngineName = {};
+
+        VkPhysicalDeviceProperties m_PhysicalDeviceProperties = {};
+        VkPhysicalDeviceMemoryProperties m_PhysicalDeviceMemoryProperties = {};
+        std::vector<VkQueueFamilyProperties> m_QueueFamilyProperties = {};
+        std::vector<ProfilerSharedMemoryQueueData> m_Queues = {};
+
+        std::unordered_set<std::string> m_EnabledInstanceExtensions = {};
+        std::unordered_set<std::string> m_EnabledDeviceExtensions = {};
+
+        std::vector<VkProfilerPerformanceCounterProperties2EXT> m_PerformanceCounterProperties = {};
+        std::vector<VkProfilerPerformanceMetricsSetProperties2EXT> m_PerformanceMetricsSets = {};
+        std::vector<std::vector<VkProfilerPerformanceCounterProperties2EXT>> m_PerformanceMetricsSetCounterProperties = {};
+        VkProfilerPerformanceCountersSamplingModeEXT m_PerformanceCountersSamplingMode = {};
+
+        std::unordered_map<VkTimeDomainEXT, uint64_t> m_DeviceCreateTimestamps = {};
+    };
+
+    /*************************************************************************\
+
+    Class:
+        ProfilerSharedMemorySerializer
+
+    Description:
+        Serializes the data of the device and the frames to the format stored
+        in the shared memory segment.
+
+        Plain structures are copied as they are, so the data can be read only
+        by a viewer built from the same sources. Command buffers referenced by
+        many submits are written once. Pipeline create infos, shader modules,
+        TIP ranges, memory snapshots and memory events are not serialized, and
+        neither are the build infos of acceleration structures and micromaps.
+
+    \*************************************************************************/
+    class ProfilerSharedMemorySerializer
+    {
+    public:
+        explicit ProfilerSharedMemorySerializer( DeviceProfilerFrontend& frontend );
+
+        const std::vector<uint8_t>& SerializeDeviceData();
+        const std::vector<uint8_t>& SerializeFrameData( const DeviceProfilerFrameData& data );
+
+        // Resolves object handles to collect the objects referenced by the drawcalls.
+        template<typename T>
+        inline void ResolveObjectHandle( const T& object ) const { m_Objects.insert( static_cast<const VkObject&>( object ) ); }
+
+    private:
+        DeviceProfilerFrontend& m_Frontend;
+
+        std::vector<uint8_t> m_Data;
+
+        std::unordered_map<const DeviceProfilerCommandBufferData*, uint32_t> m_CommandBufferIndices;
+        std::vector<const DeviceProfilerCommandBufferData*> m_CommandBuffers;
+        mutable std::unordered_set<VkObject> m_Objects;
+
+        void CollectCommandBuffer( const DeviceProfilerCommandBufferData& data );
+
+        void WriteBytes( const void* pData, size_t size );
+        void WriteString( const char* pString );
+        void WriteString( const std::string& string );
+        void WriteObject( const VkObject& object );
+
+        template<typename T>
+        void Write( const T& value );
+
+        template<typename T>
+        void WriteVector( const std::vector<T>& values );
+
+        void WriteSubmitBatch( const DeviceProfilerSubmitBatchData& data );
+        void WriteSubmit( const DeviceProfilerSubmitData& data );
+        void WriteCommandBuffer( const DeviceProfilerCommandBufferData& data );
+        void WriteRenderPass( const DeviceProfilerRenderPassData& data );
+        void WriteSubpass( const DeviceProfilerSubpassData& data );
+        void WritePipeline( const DeviceProfilerPipeline& data );
+        void WritePipelineData( const DeviceProfilerPipelineData& data );
+        void WriteDrawcall( const DeviceProfilerDrawcall& data );
+        void WritePerformanceCounters( const DeviceProfilerPerformanceCountersData& data );
+        void WriteMemory( const DeviceProfilerMemoryData& data );
+        void WriteCPU( const DeviceProfilerCPUData& data );
+        void WriteHitch( const DeviceProfilerHitchData& data );
+        void WritePipelineCompilation( const DeviceProfilerPipelineCompilationData& data );
+        void WriteObjectNames();
+
+        template<typename PayloadT>
+        void WritePayload( const PayloadT& payload );
+
+        template<DeviceProfilerDrawcallType Type>
+        void WriteDebugLabelPayload( const DeviceProfilerDrawcallDebugLabelBasePayload<Type>& payload );
+
+        void WritePayload( const DeviceProfilerDrawcallInsertDebugLabelPayload& payload );
+        void WritePayload( const DeviceProfilerDrawcallBeginDebugLabelPayload& payload );
+        void WritePayload( const DeviceProfilerDrawcallEndDebugLabelPayload& payload );
+        void WritePayload( const DeviceProfilerDrawcallDrawMultiPayload& payload );
+        void WritePayload( const DeviceProfilerDrawcallDrawMultiIndexedPayload& payload );
+    };
+
+    /*************************************************************************\
+
+    Class:
+        ProfilerSharedMemoryDeserializer
+
+    Description:
+        Reads the data written by ProfilerSharedMemorySerializer.
+
+        The data comes from another process, so all sizes are checked before
+        use. Deserialization fails if the data is truncated or if it has been
+        written by a layer built from different sources.
+
+    \*************************************************************************/
+    class ProfilerSharedMemoryDeserializer
+    {
+    public:
+        ProfilerSharedMemoryDeserializer();
+
+        bool DeserializeDeviceData( const std::vector<uint8_t>& data, ProfilerSharedMemoryDeviceData& deviceData );
+        bool DeserializeFrameData( const std::vector<uint8_t>& data, DeviceProfilerFrameData& frameData, std::unordered_map<VkObject, std::string>& objectNames );
+
+    private:
+        const uint8_t* m_pData;
+        size_t m_Size;
+        size_t m_Offset;
+        bool m_Valid;
+
+        std::vector<DeviceProfilerCommandBufferDataPtr> m_CommandBuffers;
+
+        void Reset( const std::vector<uint8_t>& data );
+
+        void ReadBytes( void* pData, size_t size );
+        void ReadString( std::string& string );
+        char* ReadStringCopy();
+        uint32_t ReadCount( size_t elementSize );
+        bool ReadFormatHash();
+
+        template<typename T>
+        void Read( T& value );
+
+        template<typename T>
+        void ReadVector( std::vector<T>& values );
+
+        void ReadSubmitBatch( DeviceProfilerSubmitBatchData& data );
+        void ReadSubmit( DeviceProfilerSubmitData& data );
+        void ReadCommandBuffer( DeviceProfilerCommandBufferData& data );
+        void ReadCommandBufferReference( DeviceProfilerCommandBufferDataPtr& pData );
+        void ReadRenderPass( DeviceProfilerRenderPassData& data );
+        void ReadSubpass( DeviceProfilerSubpassData& data );
+        void ReadPipeline( DeviceProfilerPipeline& data );
+        void ReadPipelineData( DeviceProfilerPipelineData& data );
+        void ReadDrawcall( DeviceProfilerDrawcall& data );
+        void ReadPerformanceCounters( DeviceProfilerPerformanceCountersData& data );
+        void ReadMemory( DeviceProfilerMemoryData& data );
+        void ReadCPU( DeviceProfilerCPUData& data );
+        void ReadHitch( DeviceProfilerHitchData& data );
+        void ReadPipelineCompilation( DeviceProfilerPipelineCompilationData& data );
+        void ReadObjectNames( std::unordered_map<VkObject, std::string>& objectNames );
+
+        template<typename PayloadT>
+        void ReadPayload( DeviceProfilerDrawcall& drawcall );
+
+        template<typename PayloadT>
+        void ReadDynamicAllocations( PayloadT& payload );
+
+        template<DeviceProfilerDrawcallType Type>
+        void ReadDebugLabelDynamicAllocations( DeviceProfilerDrawcallDebugLabelBasePayload<Type>& payload );
+
+        void ReadDynamicAllocations( DeviceProfilerDrawcallInsertDebugLabelPayload& payload );
+        void ReadDynamicAllocations( DeviceProfilerDrawcallBeginDebugLabelPayload& payload );
+        void ReadDynamicAllocations( DeviceProfilerDrawcallEndDebugLabelPayload& payload );
+        void ReadDynamicAllocations( DeviceProfilerDrawcallDrawMultiPayload& payload );
+        void ReadDynamicAllocations( DeviceProfilerDrawcallDrawMultiIndexedPayload& payload );
+        void ReadDynamicAllocations( DeviceProfilerDrawcallBuildAccelerationStructuresPayload& payload );
+        void ReadDynamicAllocations( DeviceProfilerDrawcallBuildAccelerationStructuresIndirectPayload& payload );
+        void ReadDynamicAllocations( DeviceProfilerDrawcallBuildMicromapsPayload& payload );
+    };
+}
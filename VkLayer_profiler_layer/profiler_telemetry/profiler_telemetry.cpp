@@ -0,0 +1,796 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "profiler_telemetry.h"
+#include "profiler/profiler_data.h"
+#include "profiler/profiler_helpers.h"
+#include "profiler_layer_objects/VkQueue_object.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <string.h>
+
+#include <fmt/format.h>
+
+namespace Profiler
+{
+    static const char* const g_StatsColumnNames[] = {
+        "draw",
+        "draw_indirect",
+        "draw_mesh_tasks",
+        "draw_mesh_tasks_indirect",
+        "dispatch",
+        "dispatch_indirect",
+        "copy_buffer",
+        "copy_buffer_to_image",
+        "copy_image",
+        "copy_image_to_buffer",
+        "clear_color",
+        "clear_depth_stencil",
+        "resolve",
+        "blit_image",
+        "fill_buffer",
+        "update_buffer",
+        "trace_rays",
+        "trace_rays_indirect",
+        "build_acceleration_structures",
+        "build_acceleration_structures_indirect",
+        "copy_acceleration_structure",
+        "copy_acceleration_structure_to_memory",
+        "copy_memory_to_acceleration_structure",
+        "pipeline_barrier",
+    };
+
+    static_assert( sizeof( DeviceProfilerDrawcallStats ) / sizeof( DeviceProfilerDrawcallStats::Stats ) == std::size( g_StatsColumnNames ),
+        "g_StatsColumnNames must match the number of entries in DeviceProfilerDrawcallStats" );
+
+    /*************************************************************************\
+
+    Function:
+        GetPerformanceCounterValue
+
+    Description:
+        Converts the performance counter result to double.
+
+    \*************************************************************************/
+    static double GetPerformanceCounterValue( const VkProfilerPerformanceCounterResultEXT& result, VkProfilerPerformanceCounterStorageEXT storage )
+    {
+        switch( storage )
+        {
+        case VK_PROFILER_PERFORMANCE_COUNTER_STORAGE_INT32_EXT:
+            return static_cast<double>( result.int32 );
+        case VK_PROFILER_PERFORMANCE_COUNTER_STORAGE_INT64_EXT:
+            return static_cast<double>( result.int64 );
+        case VK_PROFILER_PERFORMANCE_COUNTER_STORAGE_UINT32_EXT:
+            return static_cast<double>( result.uint32 );
+        case VK_PROFILER_PERFORMANCE_COUNTER_STORAGE_UINT64_EXT:
+            return static_cast<double>( result.uint64 );
+        case VK_PROFILER_PERFORMANCE_COUNTER_STORAGE_FLOAT32_EXT:
+            return static_cast<double>( result.float32 );
+        case VK_PROFILER_PERFORMANCE_COUNTER_STORAGE_FLOAT64_EXT:
+            return result.float64;
+        default:
+            return 0;
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ProfilerTelemetryOutput
+
+    Description:
+        Constructor.
+
+    \*************************************************************************/
+    ProfilerTelemetryOutput::ProfilerTelemetryOutput( DeviceProfilerFrontend& frontend )
+        : DeviceProfilerOutput( frontend )
+    {
+        ResetMembers();
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ~ProfilerTelemetryOutput
+
+    Description:
+        Destructor.
+
+    \*************************************************************************/
+    ProfilerTelemetryOutput::~ProfilerTelemetryOutput()
+    {
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Initialize
+
+    Description:
+        Opens the first telemetry file and starts the writer thread.
+
+    \*************************************************************************/
+    bool ProfilerTelemetryOutput::Initialize()
+    {
+        const DeviceProfilerConfig& config = m_Frontend.GetProfilerConfig();
+
+        m_FileCompression = ( config.m_OutputCompression == output_compression_t::zstd )
+            ? DeviceProfilerFileCompression::eZstd
+            : DeviceProfilerFileCompression::eNone;
+
+        m_FileName = config.m_TelemetryFile;
+        if( m_FileName.empty() )
+        {
+            m_FileName = GetDefaultTelemetryFileName( m_FileCompression );
+        }
+
+        if( m_FileCompression == DeviceProfilerFileCompression::eNone )
+        {
+            m_FileCompression = DeviceProfilerOutputFileStream::GetCompressionFromFileName( m_FileName );
+        }
+
+        if( !DeviceProfilerOutputFileStream::IsCompressionSupported( m_FileCompression ) )
+        {
+            ProfilerPlatformFunctions::WriteDebug( "Compression is not supported in this build, writing uncompressed telemetry\n" );
+            m_FileCompression = DeviceProfilerFileCompression::eNone;
+        }
+
+        m_FileSizeLimit = static_cast<uint64_t>( std::max( config.m_TelemetryFileSizeLimit, 0 ) ) * 1024 * 1024;
+        m_FileCount = static_cast<uint32_t>( std::max( config.m_TelemetryFileCount, 0 ) );
+        m_FlushInterval = std::chrono::milliseconds( std::max( config.m_TelemetryFlushInterval, 0 ) );
+        m_LastFlushTime = std::chrono::steady_clock::now();
+
+        // Parse comma-separated list of the performance counters.
+        std::stringstream performanceCounters( config.m_TelemetryPerformanceCounters );
+        std::string performanceCounterName;
+        while( std::getline( performanceCounters, performanceCounterName, ',' ) )
+        {
+            const size_t begin = performanceCounterName.find_first_not_of( " \t" );
+            const size_t end = performanceCounterName.find_last_not_of( " \t" );
+            if( begin != std::string::npos )
+            {
+                m_PerformanceCounterNames.push_back( performanceCounterName.substr( begin, end - begin + 1 ) );
+            }
+        }
+
+        // Sort the queues to keep the order of the columns stable between the runs.
+        std::vector<const VkQueue_Object*> queues;
+        for( const auto& [queueHandle, queue] : m_Frontend.GetDeviceQueues() )
+        {
+            queues.push_back( &queue );
+        }
+
+        std::sort( queues.begin(), queues.end(),
+            []( const VkQueue_Object* pLeft, const VkQueue_Object* pRight )
+            {
+                return ( pLeft->Family < pRight->Family ) ||
+                       ( ( pLeft->Family == pRight->Family ) && ( pLeft->Index < pRight->Index ) );
+            } );
+
+        for( const VkQueue_Object* pQueue : queues )
+        {
+            m_Queues.push_back( pQueue->Handle );
+            m_QueueColumnNames.push_back( fmt::format( "queue_{}_{}_ms", pQueue->Family, pQueue->Index ) );
+        }
+
+        m_QueueTicks.resize( m_Queues.size() );
+
+        const VkPhysicalDeviceProperties& deviceProperties = m_Frontend.GetPhysicalDeviceProperties();
+        m_TimestampPeriodMs = deviceProperties.limits.timestampPeriod / 1000000.0;
+
+        if( !OpenFile( 0 ) )
+        {
+            Destroy();
+            return false;
+        }
+
+        // Start telemetry writer thread.
+        if( config.m_EnableThreading )
+        {
+            m_TelemetryThread = std::thread( &ProfilerTelemetryOutput::TelemetryThreadProc, this );
+            m_TelemetryThreadRunning = true;
+        }
+
+        return true;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Destroy
+
+    Description:
+        Writes the remaining rows and closes the telemetry file.
+
+    \*************************************************************************/
+    void ProfilerTelemetryOutput::Destroy()
+    {
+        StopTelemetryThread();
+
+        if( m_FileOpened )
+        {
+            WritePendingRows();
+            m_Serializer.Close();
+        }
+
+        ResetMembers();
+    }
+
+    /*************************************************************************\
+
+    Function:
+        IsAvailable
+
+    Description:
+        Checks if the telemetry file is opened.
+
+    \*************************************************************************/
+    bool ProfilerTelemetryOutput::IsAvailable()
+    {
+        return m_FileOpened;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Update
+
+    Description:
+        Collects summaries of the frames and passes them to the writer when
+        a full batch is collected or the flush interval has elapsed.
+
+    \*************************************************************************/
+    void ProfilerTelemetryOutput::Update()
+    {
+        auto pData = m_Frontend.GetData();
+        while( pData )
+        {
+            UpdateLayout( *pData );
+
+            ProfilerTelemetryRow row;
+            {
+                std::scoped_lock lock( m_RowsMutex );
+                if( !m_FreeRows.empty() )
+                {
+                    row = std::move( m_FreeRows.back() );
+                    m_FreeRows.pop_back();
+                }
+            }
+
+            CollectRow( *pData, row );
+
+            {
+                std::scoped_lock lock( m_RowsMutex );
+                m_PendingRows.push_back( std::move( row ) );
+            }
+
+            pData = m_Frontend.GetData();
+        }
+
+        bool flushRequired = false;
+        {
+            std::scoped_lock lock( m_RowsMutex );
+            flushRequired = !m_PendingRows.empty() &&
+                ( ( m_PendingRows.size() >= BatchSize ) ||
+                  ( std::chrono::steady_clock::now() - m_LastFlushTime >= m_FlushInterval ) );
+
+            m_FlushRequested |= flushRequired;
+        }
+
+        if( flushRequired )
+        {
+            if( m_TelemetryThreadRunning )
+            {
+                m_TelemetryThreadInputAvailable.notify_one();
+            }
+            else
+            {
+                WritePendingRows();
+            }
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Present
+
+    Description:
+        No-op.
+
+    \*************************************************************************/
+    void ProfilerTelemetryOutput::Present()
+    {
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetDefaultTelemetryFileName
+
+    Description:
+        Constructs default name of the telemetry file.
+
+    \*************************************************************************/
+    std::string ProfilerTelemetryOutput::GetDefaultTelemetryFileName( DeviceProfilerFileCompression compression )
+    {
+        using namespace std::chrono;
+
+        // Get current time and date
+        const auto currentTimePointInTimeT = system_clock::to_time_t( system_clock::now() );
+
+        tm localTime;
+        ProfilerPlatformFunctions::GetLocalTime( &localTime, currentTimePointInTimeT );
+
+        // Construct output file name
+        std::stringstream stringBuilder;
+        stringBuilder << ProfilerPlatformFunctions::GetProcessName() << "_";
+        stringBuilder << ProfilerPlatformFunctions::GetCurrentProcessId() << "_";
+        stringBuilder << std::put_time( &localTime, "%Y-%m-%d_%H-%M-%S" );
+        stringBuilder << "_telemetry.csv";
+
+        if( compression == DeviceProfilerFileCompression::eZstd )
+        {
+            stringBuilder << ".zst";
+        }
+
+        return stringBuilder.str();
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ResetMembers
+
+    Description:
+        Set all members to initial values.
+
+    \*************************************************************************/
+    void ProfilerTelemetryOutput::ResetMembers()
+    {
+        m_FileName.clear();
+        m_FileSizeLimit = 0;
+        m_FileCount = 0;
+        m_FileIndex = 0;
+        m_FileCompression = DeviceProfilerFileCompression::eNone;
+        m_FileOpened = false;
+
+        m_pFileLayout = nullptr;
+        m_FormattedValues.clear();
+
+        m_pLayout = nullptr;
+        m_HeapCount = 0;
+
+        m_Queues.clear();
+        m_QueueColumnNames.clear();
+        m_QueueTicks.clear();
+        m_TimestampPeriodMs = 0;
+
+        m_PerformanceCounterNames.clear();
+        m_PerformanceCounterIndices.clear();
+        m_PerformanceCounterStorages.clear();
+        m_PerformanceCountersMetricsSetIndex = UINT32_MAX;
+
+        m_PendingRows.clear();
+        m_FreeRows.clear();
+        m_WriteRows.clear();
+
+        m_FlushInterval = std::chrono::steady_clock::duration::zero();
+        m_LastFlushTime = std::chrono::steady_clock::time_point();
+        m_FlushRequested = false;
+
+        m_TelemetryThread = std::thread();
+        m_TelemetryThreadRunning = false;
+        m_TelemetryThreadQuitSignal = false;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        UpdateLayout
+
+    Description:
+        Rebuilds the column layout when the metrics set or the number of
+        memory heaps reported in the frame changes.
+
+    \*************************************************************************/
+    void ProfilerTelemetryOutput::UpdateLayout( const DeviceProfilerFrameData& data )
+    {
+        const uint32_t metricsSetIndex = m_PerformanceCounterNames.empty()
+            ? UINT32_MAX
+            : data.m_PerformanceCounters.m_MetricsSetIndex;
+
+        if( ( m_pLayout != nullptr ) &&
+            ( m_PerformanceCountersMetricsSetIndex == metricsSetIndex ) &&
+            ( m_HeapCount == data.m_Memory.m_Heaps.size() ) )
+        {
+            return;
+        }
+
+        m_PerformanceCountersMetricsSetIndex = metricsSetIndex;
+        m_HeapCount = data.m_Memory.m_Heaps.size();
+
+        auto pLayout = std::make_shared<std::vector<ProfilerTelemetryColumn>>();
+        pLayout->push_back( { "frame_index", false } );
+        pLayout->push_back( { "cpu_time_ms", true } );
+        pLayout->push_back( { "fps", true } );
+        pLayout->push_back( { "gpu_time_ms", true } );
+
+        for( const std::string& queueColumnName : m_QueueColumnNames )
+        {
+            pLayout->push_back( { queueColumnName, true } );
+        }
+
+        for( const char* pStatsColumnName : g_StatsColumnNames )
+        {
+            pLayout->push_back( { fmt::format( "{}_count", pStatsColumnName ), false } );
+            pLayout->push_back( { fmt::format( "{}_ms", pStatsColumnName ), true } );
+        }
+
+        pLayout->push_back( { "total_allocation_size", false } );
+        pLayout->push_back( { "total_allocation_count", false } );
+
+        for( size_t i = 0; i < m_HeapCount; ++i )
+        {
+            pLayout->push_back( { fmt::format( "heap_{}_allocation_size", i ), false } );
+        }
+
+        // Resolve the performance counters in the active metrics set.
+        m_PerformanceCounterIndices.clear();
+        m_PerformanceCounterStorages.clear();
+
+        if( metricsSetIndex != UINT32_MAX )
+        {
+            const uint32_t counterCount = m_Frontend.GetPerformanceMetricsSetCounterProperties( metricsSetIndex, 0, nullptr );
+            std::vector<VkProfilerPerformanceCounterProperties2EXT> counterProperties( counterCount,
+                { VK_STRUCTURE_TYPE_PROFILER_PERFORMANCE_COUNTER_PROPERTIES_2_EXT } );
+
+            m_Frontend.GetPerformanceMetricsSetCounterProperties( metricsSetIndex, counterCount, counterProperties.data() );
+
+            for( const std::string& counterName : m_PerformanceCounterNames )
+            {
+                auto it = std::find_if( counterProperties.begin(), counterProperties.end(),
+                    [&]( const VkProfilerPerformanceCounterProperties2EXT& properties )
+                    { return strcmp( properties.shortName, counterName.c_str() ) == 0; } );
+
+                if( it == counterProperties.end() )
+                {
+                    ProfilerPlatformFunctions::WriteDebug( "Performance counter '%s' not found in the active metrics set\n", counterName.c_str() );
+                    continue;
+                }
+
+                m_PerformanceCounterIndices.push_back( static_cast<uint32_t>( it - counterProperties.begin() ) );
+                m_PerformanceCounterStorages.push_back( it->storage );
+                pLayout->push_back( { counterName, true } );
+            }
+        }
+
+        m_pLayout = std::move( pLayout );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        CollectRow
+
+    Description:
+        Copies summary of the frame to the row.
+
+    \*************************************************************************/
+    void ProfilerTelemetryOutput::CollectRow( const DeviceProfilerFrameData& data, ProfilerTelemetryRow& row )
+    {
+        row.m_pLayout = m_pLayout;
+        row.m_Values.clear();
+
+        const uint64_t hostTimestampFrequency = m_Frontend.GetHostTimestampFrequency( data.m_SyncTimestamps.m_HostTimeDomain );
+        const double cpuTimeMs = ( hostTimestampFrequency > 0 )
+            ? ( 1000.0 * ( data.m_CPU.m_EndTimestamp - data.m_CPU.m_BeginTimestamp ) / hostTimestampFrequency )
+            : 0;
+
+        row.m_Values.push_back( static_cast<double>( data.m_CPU.m_FrameIndex ) );
+        row.m_Values.push_back( cpuTimeMs );
+        row.m_Values.push_back( data.m_CPU.m_FramesPerSec );
+        row.m_Values.push_back( data.m_Ticks * m_TimestampPeriodMs );
+
+        // Sum durations of the submissions executed on each queue.
+        std::fill( m_QueueTicks.begin(), m_QueueTicks.end(), 0 );
+
+        for( const DeviceProfilerSubmitBatchData& submitBatch : data.m_Submits )
+        {
+            auto it = std::find( m_Queues.begin(), m_Queues.end(), submitBatch.m_Handle );
+            if( it == m_Queues.end() )
+            {
+                continue;
+            }
+
+            uint64_t& queueTicks = m_QueueTicks[ it - m_Queues.begin() ];
+            for( const DeviceProfilerSubmitData& submit : submitBatch.m_Submits )
+            {
+                if( submit.m_EndTimestamp.m_Value > submit.m_BeginTimestamp.m_Value )
+                {
+                    queueTicks += submit.m_EndTimestamp.m_Value - submit.m_BeginTimestamp.m_Value;
+                }
+            }
+        }
+
+        for( uint64_t queueTicks : m_QueueTicks )
+        {
+            row.m_Values.push_back( queueTicks * m_TimestampPeriodMs );
+        }
+
+        for( const DeviceProfilerDrawcallStats::Stats& stats : data.m_Stats )
+        {
+            row.m_Values.push_back( static_cast<double>( stats.m_Count ) );
+            row.m_Values.push_back( stats.GetEstimatedTicksSum() * m_TimestampPeriodMs );
+        }
+
+        row.m_Values.push_back( static_cast<double>( data.m_Memory.m_TotalAllocationSize ) );
+        row.m_Values.push_back( static_cast<double>( data.m_Memory.m_TotalAllocationCount ) );
+
+        for( const DeviceProfilerMemoryHeapData& heap : data.m_Memory.m_Heaps )
+        {
+            row.m_Values.push_back( static_cast<double>( heap.m_AllocationSize ) );
+        }
+
+        const size_t performanceCounterCount = m_PerformanceCounterIndices.size();
+        for( size_t i = 0; i < performanceCounterCount; ++i )
+        {
+            const uint32_t counterIndex = m_PerformanceCounterIndices[ i ];
+            if( counterIndex < data.m_PerformanceCounters.m_Results.size() )
+            {
+                row.m_Values.push_back( GetPerformanceCounterValue(
+                    data.m_PerformanceCounters.m_Results[ counterIndex ],
+                    m_PerformanceCounterStorages[ i ] ) );
+            }
+            else
+            {
+                row.m_Values.push_back( 0 );
+            }
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WritePendingRows
+
+    Description:
+        Writes all collected rows to the file and returns them to the pool.
+
+        Must not be called concurrently, rows are written either by the
+        writer thread or by the thread calling Update.
+
+    \*************************************************************************/
+    void ProfilerTelemetryOutput::WritePendingRows()
+    {
+        std::unique_lock lock( m_RowsMutex );
+        std::swap( m_WriteRows, m_PendingRows );
+        m_LastFlushTime = std::chrono::steady_clock::now();
+        m_FlushRequested = false;
+        lock.unlock();
+
+        if( m_WriteRows.empty() )
+        {
+            return;
+        }
+
+        for( const ProfilerTelemetryRow& row : m_WriteRows )
+        {
+            WriteRow( row );
+        }
+
+        m_Serializer.Flush();
+
+        lock.lock();
+        std::move( m_WriteRows.begin(), m_WriteRows.end(), std::back_inserter( m_FreeRows ) );
+        m_WriteRows.clear();
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WriteRow
+
+    Description:
+        Writes the row to the file. Starts a new file if the current one
+        exceeds the size limit or the layout of the columns has changed.
+
+    \*************************************************************************/
+    void ProfilerTelemetryOutput::WriteRow( const ProfilerTelemetryRow& row )
+    {
+        if( !m_FileOpened )
+        {
+            return;
+        }
+
+        const bool layoutChanged = ( m_pFileLayout != row.m_pLayout );
+        const bool fileFull = ( m_FileSizeLimit > 0 ) && ( m_Serializer.GetFileSize() >= m_FileSizeLimit );
+
+        if( ( m_pFileLayout != nullptr ) && ( layoutChanged || fileFull ) )
+        {
+            if( !OpenFile( m_FileIndex + 1 ) )
+            {
+                return;
+            }
+        }
+
+        const std::vector<ProfilerTelemetryColumn>& layout = *row.m_pLayout;
+        const size_t columnCount = layout.size();
+        m_FormattedValues.resize( columnCount );
+
+        if( m_pFileLayout == nullptr )
+        {
+            for( size_t i = 0; i < columnCount; ++i )
+            {
+                m_FormattedValues[ i ] = layout[ i ].m_Name;
+            }
+
+            m_Serializer.WriteHeader( m_FormattedValues );
+            m_pFileLayout = row.m_pLayout;
+        }
+
+        for( size_t i = 0; i < columnCount; ++i )
+        {
+            m_FormattedValues[ i ] = layout[ i ].m_Fractional
+                ? fmt::format( "{:.3f}", row.m_Values[ i ] )
+                : fmt::format( "{}", static_cast<uint64_t>( row.m_Values[ i ] ) );
+        }
+
+        m_Serializer.WriteRow( m_FormattedValues );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetFilePath
+
+    Description:
+        Returns path to the telemetry file with the given index.
+        Rotated files have the index appended to the name, before the
+        extension of the compressed file, e.g. telemetry_1.csv.zst.
+
+    \*************************************************************************/
+    std::filesystem::path ProfilerTelemetryOutput::GetFilePath( uint32_t fileIndex ) const
+    {
+        if( fileIndex == 0 )
+        {
+            return m_FileName;
+        }
+
+        std::filesystem::path stem = m_FileName.stem();
+        std::string extension = m_FileName.extension().string();
+
+        if( DeviceProfilerOutputFileStream::GetCompressionFromFileName( m_FileName ) != DeviceProfilerFileCompression::eNone )
+        {
+            extension = stem.extension().string() + extension;
+            stem = stem.stem();
+        }
+
+        std::filesystem::path path = m_FileName;
+        path.replace_filename( fmt::format( "{}_{}{}",
+            stem.string(),
+            fileIndex,
+            extension ) );
+
+        return path;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        OpenFile
+
+    Description:
+        Closes the current file, opens the file with the given index and
+        removes the oldest file if the number of files exceeds the limit.
+
+    \*************************************************************************/
+    bool ProfilerTelemetryOutput::OpenFile( uint32_t fileIndex )
+    {
+        m_Serializer.Close();
+
+        m_FileIndex = fileIndex;
+        m_pFileLayout = nullptr;
+
+        if( ( m_FileCount > 0 ) && ( fileIndex >= m_FileCount ) )
+        {
+            std::error_code error;
+            std::filesystem::remove( GetFilePath( fileIndex - m_FileCount ), error );
+        }
+
+        const std::string fileName = GetFilePath( fileIndex ).string();
+
+        m_FileOpened = m_Serializer.Open( fileName, m_FileCompression );
+        if( !m_FileOpened )
+        {
+            ProfilerPlatformFunctions::WriteDebug( "Failed to open telemetry file '%s'\n", fileName.c_str() );
+        }
+
+        return m_FileOpened;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        TelemetryThreadProc
+
+    Description:
+        Writes the collected rows in batches. Partial batches are written
+        periodically to keep the file up to date when the frame rate is low
+        or the application stops presenting.
+
+    \*************************************************************************/
+    void ProfilerTelemetryOutput::TelemetryThreadProc()
+    {
+        while( true )
+        {
+            {
+                std::unique_lock lock( m_RowsMutex );
+                auto predicate = [this]
+                    { return m_FlushRequested || m_TelemetryThreadQuitSignal; };
+
+                if( m_FlushInterval > std::chrono::steady_clock::duration::zero() )
+                {
+                    m_TelemetryThreadInputAvailable.wait_for( lock, m_FlushInterval, predicate );
+                }
+                else
+                {
+                    m_TelemetryThreadInputAvailable.wait( lock, predicate );
+                }
+
+                if( m_TelemetryThreadQuitSignal )
+                {
+                    break;
+                }
+            }
+
+            WritePendingRows();
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        StopTelemetryThread
+
+    Description:
+        Signals the writer thread to quit and waits until it exits. Rows
+        collected after the last write remain pending and are written by
+        the caller.
+
+    \*************************************************************************/
+    void ProfilerTelemetryOutput::StopTelemetryThread()
+    {
+        std::unique_lock lock( m_RowsMutex );
+        m_TelemetryThreadQuitSignal = true;
+        m_TelemetryThreadInputAvailable.notify_all();
+        lock.unlock();
+
+        if( m_TelemetryThread.joinable() )
+        {
+            m_TelemetryThread.join();
+        }
+
+        m_TelemetryThreadRunning = false;
+    }
+}
@@ -0,0 +1,163 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include "profiler/profiler_frontend.h"
+#include "profiler_helpers/profiler_csv_helpers.h"
+#include "profiler_ext/VkProfilerEXT.h"
+#include <vulkan/vulkan.h>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Profiler
+{
+    /*************************************************************************\
+
+    Structure:
+        ProfilerTelemetryColumn
+
+    Description:
+        Describes a single column of the telemetry file.
+
+    \*************************************************************************/
+    struct ProfilerTelemetryColumn
+    {
+        std::string m_Name;
+        bool m_Fractional;
+    };
+
+    /*************************************************************************\
+
+    Structure:
+        ProfilerTelemetryRow
+
+    Description:
+        Numeric summary of a single frame.
+
+        Rows reference the layout of the columns they were collected with.
+        When the layout changes, the writer starts a new file.
+
+    \*************************************************************************/
+    struct ProfilerTelemetryRow
+    {
+        std::shared_ptr<const std::vector<ProfilerTelemetryColumn>> m_pLayout;
+        std::vector<double> m_Values;
+    };
+
+    /*************************************************************************\
+
+    Class:
+        ProfilerTelemetryOutput
+
+    Description:
+        Writes compact per-frame summaries to a CSV file for long-running
+        sessions.
+
+        Update only copies a fixed set of numbers from each frame. Rows are
+        formatted and written in batches, on a separate thread if threading
+        is enabled. Partial batches are written when the flush interval
+        elapses. The files are rotated when they exceed the size limit,
+        and the oldest files are removed.
+
+    \*************************************************************************/
+    class ProfilerTelemetryOutput : public DeviceProfilerOutput
+    {
+    public:
+        ProfilerTelemetryOutput( DeviceProfilerFrontend& frontend );
+        ~ProfilerTelemetryOutput();
+
+        bool Initialize() override;
+        void Destroy() override;
+
+        bool IsAvailable() override;
+
+        void Update() override;
+        void Present() override;
+
+        static std::string GetDefaultTelemetryFileName( DeviceProfilerFileCompression compression = DeviceProfilerFileCompression::eNone );
+
+    private:
+        // Number of rows written to the file at once.
+        static constexpr size_t BatchSize = 64;
+
+        // Output files
+        std::filesystem::path m_FileName;
+        uint64_t m_FileSizeLimit;
+        uint32_t m_FileCount;
+        uint32_t m_FileIndex;
+        DeviceProfilerFileCompression m_FileCompression;
+
+        DeviceProfilerCsvSerializer m_Serializer;
+        bool m_FileOpened;
+
+        std::shared_ptr<const std::vector<ProfilerTelemetryColumn>> m_pFileLayout;
+        std::vector<std::string> m_FormattedValues;
+
+        // Column layout
+        std::shared_ptr<const std::vector<ProfilerTelemetryColumn>> m_pLayout;
+        size_t m_HeapCount;
+
+        std::vector<VkQueue> m_Queues;
+        std::vector<std::string> m_QueueColumnNames;
+        std::vector<uint64_t> m_QueueTicks;
+        double m_TimestampPeriodMs;
+
+        std::vector<std::string> m_PerformanceCounterNames;
+        std::vector<uint32_t> m_PerformanceCounterIndices;
+        std::vector<VkProfilerPerformanceCounterStorageEXT> m_PerformanceCounterStorages;
+        uint32_t m_PerformanceCountersMetricsSetIndex;
+
+        // Rows are recycled to avoid allocations in Update
+        std::vector<ProfilerTelemetryRow> m_PendingRows;
+        std::vector<ProfilerTelemetryRow> m_FreeRows;
+        std::vector<ProfilerTelemetryRow> m_WriteRows;
+
+        // Partial batches are written when the interval elapses since the last write
+        std::chrono::steady_clock::duration m_FlushInterval;
+        std::chrono::steady_clock::time_point m_LastFlushTime;
+        bool m_FlushRequested;
+
+        std::thread m_TelemetryThread;
+        std::condition_variable m_TelemetryThreadInputAvailable;
+        bool m_TelemetryThreadRunning;
+        bool m_TelemetryThreadQuitSignal;
+        std::mutex m_RowsMutex;
+
+        void ResetMembers();
+
+        void UpdateLayout( const struct DeviceProfilerFrameData& data );
+        void CollectRow( const struct DeviceProfilerFrameData& data, ProfilerTelemetryRow& row );
+
+        void WritePendingRows();
+        void WriteRow( const ProfilerTelemetryRow& row );
+
+        std::filesystem::path GetFilePath( uint32_t fileIndex ) const;
+        bool OpenFile( uint32_t fileIndex );
+
+        void TelemetryThreadProc();
+        void StopTelemetryThread();
+    };
+}
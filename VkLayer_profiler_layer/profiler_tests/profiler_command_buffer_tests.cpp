@@ -22,6 +22,9 @@
 #include "profiler_vulkan_simple_triangle.h"
 #include "profiler/profiler_stat_comparators.h"
 
+#include <mutex>
+#include <thread>
+
 #define VALIDATE_RANGES( parentRange, childRange )                                                    \
     {                                                                                                 \
         const auto parentRange##_Time = GetDuration( parentRange );                                   \
@@ -196,7 +199,7 @@ namespace Profiler
             ASSERT_EQ( 1, submit.m_Submits.size() );
             ASSERT_EQ( 1, submit.m_Submits.front().m_CommandBuffers.size() );
 
-            const auto& cmdBufferData = submit.m_Submits.front().m_CommandBuffers.front();
+            const auto& cmdBufferData = *submit.m_Submits.front().m_CommandBuffers.front();
             EXPECT_EQ( commandBuffers[0], cmdBufferData.m_Handle );
             EXPECT_EQ( 1, cmdBufferData.m_Stats.m_DrawStats.m_Count );
             EXPECT_FALSE( cmdBufferData.m_RenderPasses.empty() );
@@ -214,7 +217,7 @@ namespace Profiler
 
             const auto& subpassContentsData = subpassData.m_Data.front();
             EXPECT_EQ( DeviceProfilerSubpassDataType::eCommandBuffer, subpassContentsData.GetType() );
-            const auto& secondaryCmdBufferData = std::get<DeviceProfilerCommandBufferData>( subpassContentsData );
+            const auto& secondaryCmdBufferData = *std::get<DeviceProfilerCommandBufferDataPtr>( subpassContentsData );
             EXPECT_EQ( commandBuffers[1], secondaryCmdBufferData.m_Handle );
             EXPECT_FALSE( secondaryCmdBufferData.m_RenderPasses.empty() );
             EXPECT_EQ( 1, secondaryCmdBufferData.m_Stats.m_DrawStats.m_Count );
@@ -411,7 +414,7 @@ namespace Profiler
             ASSERT_EQ( 1, submit.m_Submits.front().m_CommandBuffers.size() );
 
             // Validate the primary command buffer.
-            const auto& cmdBufferData = submit.m_Submits.front().m_CommandBuffers.front();
+            const auto& cmdBufferData = *submit.m_Submits.front().m_CommandBuffers.front();
             EXPECT_EQ( commandBuffers[0], cmdBufferData.m_Handle );
             EXPECT_EQ( 1, cmdBufferData.m_Stats.m_DrawStats.m_Count );
             EXPECT_EQ( 1, cmdBufferData.m_Stats.m_CopyImageStats.m_Count );
@@ -446,7 +449,7 @@ namespace Profiler
             EXPECT_EQ( VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS, copySubpassData.m_Contents );
 
             const auto& copySubpassContentsData = copySubpassData.m_Data.front();
-            const auto& secondaryCmdBufferData = std::get<DeviceProfilerCommandBufferData>( copySubpassContentsData );
+            const auto& secondaryCmdBufferData = *std::get<DeviceProfilerCommandBufferDataPtr>( copySubpassContentsData );
             EXPECT_EQ( commandBuffers[1], secondaryCmdBufferData.m_Handle );
 
             const auto& copyCmdBufferRenderPassData = secondaryCmdBufferData.m_RenderPasses.front();
@@ -652,7 +655,7 @@ namespace Profiler
             ASSERT_EQ( 1, submit.m_Submits.front().m_CommandBuffers.size() );
 
             // Validate the primary command buffer.
-            const auto& cmdBufferData = submit.m_Submits.front().m_CommandBuffers.front();
+            const auto& cmdBufferData = *submit.m_Submits.front().m_CommandBuffers.front();
             EXPECT_EQ( commandBuffers[0], cmdBufferData.m_Handle );
             EXPECT_EQ( 1, cmdBufferData.m_Stats.m_DrawStats.m_Count );
             EXPECT_EQ( 2, cmdBufferData.m_Stats.m_CopyImageStats.m_Count );
@@ -712,7 +715,7 @@ namespace Profiler
                 VALIDATE_RANGES( copyRenderPassData, copySubpassData );
 
                 const auto& copySubpassContentsData = copySubpassData.m_Data.front();
-                const auto& secondaryCmdBufferData = std::get<DeviceProfilerCommandBufferData>( copySubpassContentsData );
+                const auto& secondaryCmdBufferData = *std::get<DeviceProfilerCommandBufferDataPtr>( copySubpassContentsData );
                 EXPECT_EQ( commandBuffers[1], secondaryCmdBufferData.m_Handle );
 
                 const auto& copyCmdBufferRenderPassData = secondaryCmdBufferData.m_RenderPasses.front();
@@ -857,7 +860,7 @@ namespace Profiler
             ASSERT_EQ( 1, submit.m_Submits.front().m_CommandBuffers.size() );
 
             // Primary command buffer
-            const auto& cmdBufferData = submit.m_Submits.front().m_CommandBuffers.front();
+            const auto& cmdBufferData = *submit.m_Submits.front().m_CommandBuffers.front();
             EXPECT_EQ( commandBuffers[0], cmdBufferData.m_Handle );
             EXPECT_EQ( 1, cmdBufferData.m_Stats.m_DrawStats.m_Count );
             EXPECT_FALSE( cmdBufferData.m_RenderPasses.empty() );
@@ -875,7 +878,7 @@ namespace Profiler
 
             const auto& subpassContentsData = subpassData.m_Data.front();
             EXPECT_EQ( DeviceProfilerSubpassDataType::eCommandBuffer, subpassContentsData.GetType() );
-            const auto& secondaryCmdBufferData = std::get<DeviceProfilerCommandBufferData>( subpassContentsData );
+            const auto& secondaryCmdBufferData = *std::get<DeviceProfilerCommandBufferDataPtr>( subpassContentsData );
             EXPECT_EQ( commandBuffers[3], secondaryCmdBufferData.m_Handle );
             EXPECT_FALSE( secondaryCmdBufferData.m_RenderPasses.empty() );
             EXPECT_EQ( 1, secondaryCmdBufferData.m_Stats.m_DrawStats.m_Count );
@@ -895,7 +898,7 @@ namespace Profiler
 
             const auto& inheritedSubpassContentsData = inheritedSubpassData.m_Data.front();
             EXPECT_EQ( DeviceProfilerSubpassDataType::eCommandBuffer, inheritedSubpassContentsData.GetType() );
-            const auto& secondaryCmdBufferData2 = std::get<DeviceProfilerCommandBufferData>( inheritedSubpassContentsData );
+            const auto& secondaryCmdBufferData2 = *std::get<DeviceProfilerCommandBufferDataPtr>( inheritedSubpassContentsData );
             EXPECT_EQ( commandBuffers[2], secondaryCmdBufferData2.m_Handle );
             EXPECT_FALSE( secondaryCmdBufferData2.m_RenderPasses.empty() );
             EXPECT_EQ( 1, secondaryCmdBufferData2.m_Stats.m_DrawStats.m_Count );
@@ -915,7 +918,7 @@ namespace Profiler
 
             const auto& inheritedSubpassContentsData2 = inheritedSubpassData2.m_Data.front();
             EXPECT_EQ( DeviceProfilerSubpassDataType::eCommandBuffer, inheritedSubpassContentsData2.GetType() );
-            const auto& secondaryCmdBufferData3 = std::get<DeviceProfilerCommandBufferData>( inheritedSubpassContentsData2 );
+            const auto& secondaryCmdBufferData3 = *std::get<DeviceProfilerCommandBufferDataPtr>( inheritedSubpassContentsData2 );
             EXPECT_EQ( commandBuffers[1], secondaryCmdBufferData3.m_Handle );
             EXPECT_FALSE( secondaryCmdBufferData3.m_RenderPasses.empty() );
             EXPECT_EQ( 1, secondaryCmdBufferData3.m_Stats.m_DrawStats.m_Count );
@@ -1030,7 +1033,7 @@ namespace Profiler
             ASSERT_EQ( 1, submit.m_Submits.size() );
             ASSERT_EQ( 1, submit.m_Submits.front().m_CommandBuffers.size() );
 
-            const auto& cmdBufferData = submit.m_Submits.front().m_CommandBuffers.front();
+            const auto& cmdBufferData = *submit.m_Submits.front().m_CommandBuffers.front();
             EXPECT_EQ( commandBuffer, cmdBufferData.m_Handle );
             EXPECT_EQ( 1, cmdBufferData.m_Stats.m_DrawStats.m_Count );
             EXPECT_EQ( 1, cmdBufferData.m_Stats.m_PipelineBarrierStats.m_Count );
@@ -1057,10 +1060,669 @@ namespace Profiler
             ASSERT_EQ( 1, submit.m_Submits.size() );
             ASSERT_EQ( 1, submit.m_Submits.front().m_CommandBuffers.size() );
 
-            const auto& cmdBufferData = submit.m_Submits.front().m_CommandBuffers.front();
+            const auto& cmdBufferData = *submit.m_Submits.front().m_CommandBuffers.front();
             EXPECT_EQ( commandBuffer, cmdBufferData.m_Handle );
             EXPECT_EQ( 1, cmdBufferData.m_Stats.m_DrawStats.m_Count );
             EXPECT_EQ( 1, cmdBufferData.m_Stats.m_PipelineBarrierStats.m_Count );
         }
     }
+
+    TEST_F( ProfilerCommandBufferULT, SharedCommandBufferData )
+    {
+        Prof->m_Overhead.SetCopyMeasurementEnabled( true );
+
+        VkCommandBuffer commandBuffer = {};
+
+        { // Allocate command buffer
+            VkCommandBufferAllocateInfo allocateInfo = {};
+            allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocateInfo.commandBufferCount = 1;
+            allocateInfo.commandPool = Vk->CommandPool;
+            ASSERT_EQ( VK_SUCCESS, vkAllocateCommandBuffers( Vk->Device, &allocateInfo, &commandBuffer ) );
+        }
+        { // Record command buffer that can be submitted many times
+            VkCommandBufferBeginInfo beginInfo = {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            ASSERT_EQ( VK_SUCCESS, vkBeginCommandBuffer( commandBuffer, &beginInfo ) );
+
+            VkMemoryBarrier barrier = {};
+            barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            barrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+
+            vkCmdPipelineBarrier( commandBuffer,
+                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                0,
+                1, &barrier,
+                0, nullptr,
+                0, nullptr );
+
+            ASSERT_EQ( VK_SUCCESS, vkEndCommandBuffer( commandBuffer ) );
+        }
+
+        VkSubmitInfo submitInfo = {};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &commandBuffer;
+
+        std::shared_ptr<DeviceProfilerFrameData> pData1;
+        std::shared_ptr<DeviceProfilerFrameData> pData2;
+
+        { // Submit and collect data
+            ASSERT_EQ( VK_SUCCESS, vkQueueSubmit( Vk->Queue, 1, &submitInfo, VK_NULL_HANDLE ) );
+            vkDeviceWaitIdle( Vk->Device );
+            Prof->FinishFrame();
+
+            pData1 = Prof->GetData();
+            ASSERT_NE( nullptr, pData1 );
+            ASSERT_EQ( 1, pData1->m_Submits.size() );
+        }
+        { // Validate data
+            // Data of the command buffer is passed to the frame without copying.
+            EXPECT_EQ( 0, pData1->m_Overhead.m_CopiedDataSize );
+        }
+        { // Submit again while the previous frame is still referenced
+            ASSERT_EQ( VK_SUCCESS, vkQueueSubmit( Vk->Queue, 1, &submitInfo, VK_NULL_HANDLE ) );
+            vkDeviceWaitIdle( Vk->Device );
+            Prof->FinishFrame();
+
+            pData2 = Prof->GetData();
+            ASSERT_NE( nullptr, pData2 );
+            ASSERT_EQ( 1, pData2->m_Submits.size() );
+        }
+        { // Validate data
+            const auto& pCmdBufferData1 = pData1->m_Submits.front().m_Submits.front().m_CommandBuffers.front();
+            const auto& pCmdBufferData2 = pData2->m_Submits.front().m_Submits.front().m_CommandBuffers.front();
+
+            // Data referenced by the previous frame is copied before it is modified.
+            EXPECT_NE( pCmdBufferData1, pCmdBufferData2 );
+            EXPECT_LT( 0, pData2->m_Overhead.m_CopiedDataSize );
+
+            // The previous frame is not affected by the new submission.
+            EXPECT_EQ( commandBuffer, pCmdBufferData1->m_Handle );
+            EXPECT_EQ( 1, pCmdBufferData1->m_Stats.m_PipelineBarrierStats.m_Count );
+            EXPECT_EQ( commandBuffer, pCmdBufferData2->m_Handle );
+            EXPECT_EQ( 1, pCmdBufferData2->m_Stats.m_PipelineBarrierStats.m_Count );
+        }
+        { // Release the frames and submit again
+            pData1.reset();
+            pData2.reset();
+
+            ASSERT_EQ( VK_SUCCESS, vkQueueSubmit( Vk->Queue, 1, &submitInfo, VK_NULL_HANDLE ) );
+            vkDeviceWaitIdle( Vk->Device );
+            Prof->FinishFrame();
+
+            pData1 = Prof->GetData();
+            ASSERT_NE( nullptr, pData1 );
+        }
+        { // Validate data
+            // Data not referenced by any frame is reused.
+            EXPECT_EQ( 0, pData1->m_Overhead.m_CopiedDataSize );
+        }
+    }
+
+    TEST_F( ProfilerCommandBufferULT, MultiThreadedSubmission )
+    {
+        constexpr uint32_t threadCount = 4;
+        constexpr uint32_t submitsPerThread = 64;
+        constexpr uint32_t frameCount = 32;
+
+        // Keep all resolved frames until they are validated.
+        Prof->SetDataBufferSize( threadCount * submitsPerThread + frameCount + 2 );
+        while( Prof->GetData() != nullptr ) {}
+
+        std::vector<VkCommandBuffer> commandBuffers( threadCount );
+
+        { // Allocate command buffers
+            VkCommandBufferAllocateInfo allocateInfo = {};
+            allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocateInfo.commandBufferCount = threadCount;
+            allocateInfo.commandPool = Vk->CommandPool;
+            ASSERT_EQ( VK_SUCCESS, vkAllocateCommandBuffers( Vk->Device, &allocateInfo, commandBuffers.data() ) );
+        }
+        for( VkCommandBuffer commandBuffer : commandBuffers )
+        { // Record command buffers
+            VkCommandBufferBeginInfo beginInfo = {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+            ASSERT_EQ( VK_SUCCESS, vkBeginCommandBuffer( commandBuffer, &beginInfo ) );
+            ASSERT_EQ( VK_SUCCESS, vkEndCommandBuffer( commandBuffer ) );
+        }
+        { // Submit from multiple threads while frames are being delimited
+            // Access to the queue must be externally synchronized, as with vkQueuePresentKHR.
+            std::mutex queueMutex;
+            std::vector<std::thread> threads;
+
+            for( uint32_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+            {
+                threads.emplace_back( [&, threadIndex]() {
+                    VkSubmitInfo submitInfo = {};
+                    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+                    submitInfo.commandBufferCount = 1;
+                    submitInfo.pCommandBuffers = &commandBuffers[ threadIndex ];
+
+                    for( uint32_t i = 0; i < submitsPerThread; ++i )
+                    {
+                        std::scoped_lock lk( queueMutex );
+                        EXPECT_EQ( VK_SUCCESS, vkQueueSubmit( Vk->Queue, 1, &submitInfo, VK_NULL_HANDLE ) );
+                    }
+                } );
+            }
+
+            for( uint32_t i = 0; i < frameCount; ++i )
+            {
+                std::this_thread::yield();
+                std::scoped_lock lk( queueMutex );
+                Prof->FinishFrame();
+            }
+
+            for( std::thread& thread : threads )
+            {
+                thread.join();
+            }
+        }
+        { // Collect data
+            vkDeviceWaitIdle( Vk->Device );
+            Prof->FinishFrame();
+        }
+        { // Validate data
+            uint32_t submittedCommandBufferCount = 0;
+            uint32_t resolvedFrameCount = 0;
+            const DeviceProfilerFrameData* pPrevFrameData = nullptr;
+
+            std::vector<std::shared_ptr<DeviceProfilerFrameData>> pFrames;
+            while( std::shared_ptr<DeviceProfilerFrameData> pData = Prof->GetData() )
+            {
+                pFrames.push_back( std::move( pData ) );
+            }
+
+            for( const std::shared_ptr<DeviceProfilerFrameData>& pData : pFrames )
+            {
+                const DeviceProfilerFrameData& data = *pData;
+                if( data.m_Submits.empty() )
+                {
+                    continue;
+                }
+
+                if( pPrevFrameData != nullptr )
+                {
+                    // Frames are resolved in order and their properties are captured in submission order.
+                    EXPECT_LT( pPrevFrameData->m_CPU.m_FrameIndex, data.m_CPU.m_FrameIndex );
+                    EXPECT_LE( pPrevFrameData->m_CPU.m_BeginTimestamp, data.m_CPU.m_BeginTimestamp );
+                    EXPECT_LE( pPrevFrameData->m_SyncTimestamps.m_HostCalibratedTimestamp, data.m_SyncTimestamps.m_HostCalibratedTimestamp );
+                }
+
+                // Submits in the frame are ordered by submission.
+                uint64_t prevSubmitTimestamp = data.m_CPU.m_BeginTimestamp;
+                for( const DeviceProfilerSubmitBatchData& submitBatch : data.m_Submits )
+                {
+                    EXPECT_LE( prevSubmitTimestamp, submitBatch.m_Timestamp );
+                    prevSubmitTimestamp = submitBatch.m_Timestamp;
+
+                    for( const DeviceProfilerSubmitData& submit : submitBatch.m_Submits )
+                    {
+                        submittedCommandBufferCount += static_cast<uint32_t>( submit.m_CommandBuffers.size() );
+                    }
+                }
+
+                pPrevFrameData = &data;
+                resolvedFrameCount++;
+            }
+
+            // No submission is lost.
+            EXPECT_EQ( threadCount * submitsPerThread, submittedCommandBufferCount );
+            EXPECT_LE( 1, resolvedFrameCount );
+            EXPECT_GE( frameCount + 1, resolvedFrameCount );
+        }
+    }
+
+    TEST_F( ProfilerCommandBufferULT, DrawcallTimestampBudget )
+    {
+        // Allow 2 timestamped commands per frame.
+        Prof->m_Config.m_DrawcallTimestampBudget = 2;
+
+        // Create simple triangle app
+        VulkanSimpleTriangle simpleTriangle( Vk );
+        VkCommandBuffer commandBuffers[ 2 ] = {};
+
+        { // Allocate command buffers
+            VkCommandBufferAllocateInfo allocateInfo = {};
+            allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocateInfo.commandBufferCount = 2;
+            allocateInfo.commandPool = Vk->CommandPool;
+            ASSERT_EQ( VK_SUCCESS, vkAllocateCommandBuffers( Vk->Device, &allocateInfo, commandBuffers ) );
+        }
+
+        // All draws in the first frame are timestamped.
+        // The budget is exceeded, so only every other draw is timestamped in the next frame.
+        const uint32_t expectedSampleCounts[ 2 ] = { 4, 2 };
+
+        // Record and submit 4 draws in each frame.
+        for( uint32_t frameIndex = 0; frameIndex < 2; ++frameIndex )
+        {
+            VkCommandBuffer commandBuffer = commandBuffers[ frameIndex ];
+            const uint32_t expectedSampleCount = expectedSampleCounts[ frameIndex ];
+
+            { // Begin command buffer
+                VkCommandBufferBeginInfo beginInfo = {};
+                beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+                beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+                ASSERT_EQ( VK_SUCCESS, vkBeginCommandBuffer( commandBuffer, &beginInfo ) );
+            }
+            { // Begin render pass
+                VkRenderPassBeginInfo beginInfo = {};
+                beginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+                beginInfo.renderPass = simpleTriangle.RenderPass;
+                beginInfo.renderArea = simpleTriangle.RenderArea;
+                beginInfo.framebuffer = simpleTriangle.Framebuffer;
+                vkCmdBeginRenderPass( commandBuffer, &beginInfo, VK_SUBPASS_CONTENTS_INLINE );
+            }
+            { // Record commands
+                vkCmdBindPipeline( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, simpleTriangle.Pipeline );
+                vkCmdDraw( commandBuffer, 3, 1, 0, 0 );
+                vkCmdDraw( commandBuffer, 3, 1, 0, 0 );
+                vkCmdDraw( commandBuffer, 3, 1, 0, 0 );
+                vkCmdDraw( commandBuffer, 3, 1, 0, 0 );
+            }
+            { // End render pass
+                vkCmdEndRenderPass( commandBuffer );
+            }
+            { // End command buffer
+                ASSERT_EQ( VK_SUCCESS, vkEndCommandBuffer( commandBuffer ) );
+            }
+            { // Submit command buffer
+                VkSubmitInfo submitInfo = {};
+                submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+                submitInfo.commandBufferCount = 1;
+                submitInfo.pCommandBuffers = &commandBuffer;
+                ASSERT_EQ( VK_SUCCESS, vkQueueSubmit( Vk->Queue, 1, &submitInfo, VK_NULL_HANDLE ) );
+            }
+            { // Collect data
+                vkDeviceWaitIdle( Vk->Device );
+                Prof->FinishFrame();
+            }
+            { // Validate data
+                std::shared_ptr<DeviceProfilerFrameData> pData = Prof->GetData();
+                ASSERT_NE( nullptr, pData );
+
+                const DeviceProfilerFrameData& data = *pData;
+                ASSERT_EQ( 1, data.m_Submits.size() );
+                ASSERT_EQ( 1, data.m_Submits.front().m_Submits.size() );
+                ASSERT_EQ( 1, data.m_Submits.front().m_Submits.front().m_CommandBuffers.size() );
+
+                const auto& cmdBufferData = *data.m_Submits.front().m_Submits.front().m_CommandBuffers.front();
+                EXPECT_EQ( 4, cmdBufferData.m_Stats.m_DrawStats.m_Count );
+                EXPECT_EQ( 4 - expectedSampleCount, cmdBufferData.m_Stats.m_DrawStats.m_SkippedSampleCount );
+
+                const auto& subpassData = cmdBufferData.m_RenderPasses.front().m_Subpasses.front();
+                const auto& pipelineData = std::get<DeviceProfilerPipelineData>( subpassData.m_Data.front() );
+                ASSERT_EQ( 4, pipelineData.m_Drawcalls.size() );
+
+                uint32_t sampleCount = 0;
+                for( const auto& drawcallData : pipelineData.m_Drawcalls )
+                {
+                    if( drawcallData.m_BeginTimestamp.m_Value != UINT64_MAX )
+                    {
+                        VALIDATE_RANGES( pipelineData, drawcallData );
+                        sampleCount++;
+                    }
+                    else
+                    {
+                        // Not sampled drawcalls keep the invalid timestamps.
+                        EXPECT_EQ( UINT64_MAX, drawcallData.m_BeginTimestamp.m_Value );
+                        EXPECT_EQ( UINT64_MAX, drawcallData.m_EndTimestamp.m_Value );
+                    }
+                }
+
+                EXPECT_EQ( expectedSampleCount, sampleCount );
+            }
+        }
+    }
+
+    class ProfilerPipelineStatisticsULT : public ProfilerBaseULT
+    {
+    protected:
+        struct PipelineStatisticsQueryFeature : VulkanFeature
+        {
+            PipelineStatisticsQueryFeature()
+                : VulkanFeature( "pipelineStatisticsQuery", std::string(), false )
+            {
+            }
+
+            bool CheckSupport( const VkPhysicalDeviceFeatures2* pFeatures ) const override
+            {
+                return pFeatures->features.pipelineStatisticsQuery;
+            }
+
+            void Configure( VkPhysicalDeviceFeatures2* pFeatures ) override
+            {
+                pFeatures->features.pipelineStatisticsQuery = VK_TRUE;
+            }
+        } pipelineStatisticsQueryFeature;
+
+        struct TransformFeedbackExtension : VulkanExtension
+        {
+            TransformFeedbackExtension()
+                : VulkanExtension( VK_EXT_TRANSFORM_FEEDBACK_EXTENSION_NAME, false )
+            {
+            }
+        } transformFeedbackExtension;
+
+        void SetUpVulkan( VulkanState::CreateInfo& createInfo ) override
+        {
+            createInfo.DeviceFeatures.push_back( &pipelineStatisticsQueryFeature );
+            createInfo.DeviceExtensions.push_back( &transformFeedbackExtension );
+        }
+    };
+
+    TEST_F( ProfilerPipelineStatisticsULT, SuspendDuringApplicationQuery )
+    {
+        SkipIfUnsupported( pipelineStatisticsQueryFeature );
+
+        // Pipeline statistics queries are allocated with the command buffer.
+        Prof->m_Config.m_EnablePipelineStatistics = true;
+
+        // Create simple triangle app
+        VulkanSimpleTriangle simpleTriangle( Vk );
+        VkCommandBuffer commandBuffer = {};
+        VkQueryPool queryPool = {};
+
+        { // Create application's query pool
+            VkQueryPoolCreateInfo createInfo = {};
+            createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+            createInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+            createInfo.queryCount = 2;
+            createInfo.pipelineStatistics = VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT;
+            ASSERT_EQ( VK_SUCCESS, vkCreateQueryPool( Vk->Device, &createInfo, nullptr, &queryPool ) );
+            EXPECT_EQ( VK_QUERY_TYPE_PIPELINE_STATISTICS, Prof->GetQueryPoolType( queryPool ) );
+        }
+        { // Allocate command buffers
+            VkCommandBufferAllocateInfo allocateInfo = {};
+            allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocateInfo.commandBufferCount = 1;
+            allocateInfo.commandPool = Vk->CommandPool;
+            ASSERT_EQ( VK_SUCCESS, vkAllocateCommandBuffers( Vk->Device, &allocateInfo, &commandBuffer ) );
+        }
+        { // Begin command buffer
+            VkCommandBufferBeginInfo beginInfo = {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            ASSERT_EQ( VK_SUCCESS, vkBeginCommandBuffer( commandBuffer, &beginInfo ) );
+            vkCmdResetQueryPool( commandBuffer, queryPool, 0, 2 );
+        }
+
+        VkRenderPassBeginInfo renderPassBeginInfo = {};
+        renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        renderPassBeginInfo.renderPass = simpleTriangle.RenderPass;
+        renderPassBeginInfo.renderArea = simpleTriangle.RenderArea;
+        renderPassBeginInfo.framebuffer = simpleTriangle.Framebuffer;
+
+        { // Application's query begins after the profiler's query
+            vkCmdBeginRenderPass( commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE );
+            vkCmdBindPipeline( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, simpleTriangle.Pipeline );
+            vkCmdDraw( commandBuffer, 3, 1, 0, 0 );
+            vkCmdBeginQuery( commandBuffer, queryPool, 0, 0 );
+            vkCmdDraw( commandBuffer, 3, 1, 0, 0 );
+            vkCmdEndQuery( commandBuffer, queryPool, 0 );
+            vkCmdDraw( commandBuffer, 3, 1, 0, 0 );
+            vkCmdEndRenderPass( commandBuffer );
+        }
+        { // Application's query begins before the profiler's query
+            vkCmdBeginQuery( commandBuffer, queryPool, 1, 0 );
+            vkCmdBeginRenderPass( commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE );
+            vkCmdBindPipeline( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, simpleTriangle.Pipeline );
+            vkCmdDraw( commandBuffer, 3, 1, 0, 0 );
+            vkCmdEndRenderPass( commandBuffer );
+            vkCmdEndQuery( commandBuffer, queryPool, 1 );
+        }
+        { // Collection is resumed after the application's query ends
+            vkCmdBeginRenderPass( commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE );
+            vkCmdBindPipeline( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, simpleTriangle.Pipeline );
+            vkCmdDraw( commandBuffer, 3, 1, 0, 0 );
+            vkCmdEndRenderPass( commandBuffer );
+        }
+        { // End command buffer
+            ASSERT_EQ( VK_SUCCESS, vkEndCommandBuffer( commandBuffer ) );
+        }
+        { // Submit command buffer
+            VkSubmitInfo submitInfo = {};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &commandBuffer;
+            ASSERT_EQ( VK_SUCCESS, vkQueueSubmit( Vk->Queue, 1, &submitInfo, VK_NULL_HANDLE ) );
+        }
+        { // Collect data
+            vkDeviceWaitIdle( Vk->Device );
+            Prof->FinishFrame();
+        }
+        { // Validate application's query results
+            uint64_t results[ 2 ] = {};
+            ASSERT_EQ( VK_SUCCESS, vkGetQueryPoolResults( Vk->Device, queryPool, 0, 2, sizeof( results ), results, sizeof( uint64_t ),
+                                       VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT ) );
+            EXPECT_LT( 0, results[ 0 ] );
+            EXPECT_LT( 0, results[ 1 ] );
+        }
+        { // Validate data
+            std::shared_ptr<DeviceProfilerFrameData> pData = Prof->GetData();
+            ASSERT_NE( nullptr, pData );
+
+            const DeviceProfilerFrameData& data = *pData;
+            ASSERT_EQ( 1, data.m_Submits.size() );
+            ASSERT_EQ( 1, data.m_Submits.front().m_Submits.size() );
+            ASSERT_EQ( 1, data.m_Submits.front().m_Submits.front().m_CommandBuffers.size() );
+
+            const auto& cmdBufferData = *data.m_Submits.front().m_Submits.front().m_CommandBuffers.front();
+            ASSERT_EQ( 3, cmdBufferData.m_RenderPasses.size() );
+
+            const auto GetPipelineStatistics = [&]( size_t renderPassIndex ) -> const DeviceProfilerPipelineStatistics& {
+                const auto& subpassData = cmdBufferData.m_RenderPasses[ renderPassIndex ].m_Subpasses.front();
+                return std::get<DeviceProfilerPipelineData>( subpassData.m_Data.front() ).m_PipelineStatistics;
+            };
+
+            // Partial statistics of the pipeline interrupted by the application's query are discarded.
+            EXPECT_EQ( UINT64_MAX, GetPipelineStatistics( 0 ).m_Index );
+            EXPECT_EQ( 0, GetPipelineStatistics( 0 ).m_VertexShaderInvocations );
+
+            // No query is begun while the application's query is active.
+            EXPECT_EQ( UINT64_MAX, GetPipelineStatistics( 1 ).m_Index );
+            EXPECT_EQ( 0, GetPipelineStatistics( 1 ).m_VertexShaderInvocations );
+
+            EXPECT_NE( UINT64_MAX, GetPipelineStatistics( 2 ).m_Index );
+            EXPECT_LT( 0, GetPipelineStatistics( 2 ).m_VertexShaderInvocations );
+        }
+
+        vkDestroyQueryPool( Vk->Device, queryPool, nullptr );
+        EXPECT_EQ( VK_QUERY_TYPE_MAX_ENUM, Prof->GetQueryPoolType( queryPool ) );
+    }
+
+    TEST_F( ProfilerPipelineStatisticsULT, SuspendDuringApplicationIndexedQuery )
+    {
+        SkipIfUnsupported( pipelineStatisticsQueryFeature );
+        SkipIfUnsupported( transformFeedbackExtension );
+
+        // Pipeline statistics queries are allocated with the command buffer.
+        Prof->m_Config.m_EnablePipelineStatistics = true;
+
+        auto pfnCmdBeginQueryIndexedEXT = (PFN_vkCmdBeginQueryIndexedEXT)vkGetDeviceProcAddr( Vk->Device, "vkCmdBeginQueryIndexedEXT" );
+        auto pfnCmdEndQueryIndexedEXT = (PFN_vkCmdEndQueryIndexedEXT)vkGetDeviceProcAddr( Vk->Device, "vkCmdEndQueryIndexedEXT" );
+        ASSERT_NE( nullptr, pfnCmdBeginQueryIndexedEXT );
+        ASSERT_NE( nullptr, pfnCmdEndQueryIndexedEXT );
+
+        // Create simple triangle app
+        VulkanSimpleTriangle simpleTriangle( Vk );
+        VkCommandBuffer commandBuffer = {};
+        VkQueryPool queryPool = {};
+
+        { // Create application's query pool
+            VkQueryPoolCreateInfo createInfo = {};
+            createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+            createInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+            createInfo.queryCount = 1;
+            createInfo.pipelineStatistics = VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT;
+            ASSERT_EQ( VK_SUCCESS, vkCreateQueryPool( Vk->Device, &createInfo, nullptr, &queryPool ) );
+        }
+        { // Allocate command buffers
+            VkCommandBufferAllocateInfo allocateInfo = {};
+            allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocateInfo.commandBufferCount = 1;
+            allocateInfo.commandPool = Vk->CommandPool;
+            ASSERT_EQ( VK_SUCCESS, vkAllocateCommandBuffers( Vk->Device, &allocateInfo, &commandBuffer ) );
+        }
+        { // Begin command buffer
+            VkCommandBufferBeginInfo beginInfo = {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            ASSERT_EQ( VK_SUCCESS, vkBeginCommandBuffer( commandBuffer, &beginInfo ) );
+            vkCmdResetQueryPool( commandBuffer, queryPool, 0, 1 );
+        }
+
+        VkRenderPassBeginInfo renderPassBeginInfo = {};
+        renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        renderPassBeginInfo.renderPass = simpleTriangle.RenderPass;
+        renderPassBeginInfo.renderArea = simpleTriangle.RenderArea;
+        renderPassBeginInfo.framebuffer = simpleTriangle.Framebuffer;
+
+        { // Application's indexed query begins after the profiler's query
+            vkCmdBeginRenderPass( commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE );
+            vkCmdBindPipeline( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, simpleTriangle.Pipeline );
+            vkCmdDraw( commandBuffer, 3, 1, 0, 0 );
+            pfnCmdBeginQueryIndexedEXT( commandBuffer, queryPool, 0, 0, 0 );
+            vkCmdDraw( commandBuffer, 3, 1, 0, 0 );
+            pfnCmdEndQueryIndexedEXT( commandBuffer, queryPool, 0, 0 );
+            vkCmdEndRenderPass( commandBuffer );
+        }
+        { // Collection is resumed after the application's query ends
+            vkCmdBeginRenderPass( commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE );
+            vkCmdBindPipeline( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, simpleTriangle.Pipeline );
+            vkCmdDraw( commandBuffer, 3, 1, 0, 0 );
+            vkCmdEndRenderPass( commandBuffer );
+        }
+        { // End command buffer
+            ASSERT_EQ( VK_SUCCESS, vkEndCommandBuffer( commandBuffer ) );
+        }
+        { // Submit command buffer
+            VkSubmitInfo submitInfo = {};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &commandBuffer;
+            ASSERT_EQ( VK_SUCCESS, vkQueueSubmit( Vk->Queue, 1, &submitInfo, VK_NULL_HANDLE ) );
+        }
+        { // Collect data
+            vkDeviceWaitIdle( Vk->Device );
+            Prof->FinishFrame();
+        }
+        { // Validate application's query results
+            uint64_t result = 0;
+            ASSERT_EQ( VK_SUCCESS, vkGetQueryPoolResults( Vk->Device, queryPool, 0, 1, sizeof( result ), &result, sizeof( uint64_t ),
+                                       VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT ) );
+            EXPECT_LT( 0, result );
+        }
+        { // Validate data
+            std::shared_ptr<DeviceProfilerFrameData> pData = Prof->GetData();
+            ASSERT_NE( nullptr, pData );
+
+            const DeviceProfilerFrameData& data = *pData;
+            ASSERT_EQ( 1, data.m_Submits.size() );
+            ASSERT_EQ( 1, data.m_Submits.front().m_Submits.size() );
+            ASSERT_EQ( 1, data.m_Submits.front().m_Submits.front().m_CommandBuffers.size() );
+
+            const auto& cmdBufferData = *data.m_Submits.front().m_Submits.front().m_CommandBuffers.front();
+            ASSERT_EQ( 2, cmdBufferData.m_RenderPasses.size() );
+
+            const auto GetPipelineStatistics = [&]( size_t renderPassIndex ) -> const DeviceProfilerPipelineStatistics& {
+                const auto& subpassData = cmdBufferData.m_RenderPasses[ renderPassIndex ].m_Subpasses.front();
+                return std::get<DeviceProfilerPipelineData>( subpassData.m_Data.front() ).m_PipelineStatistics;
+            };
+
+            // Partial statistics of the pipeline interrupted by the application's query are discarded.
+            EXPECT_EQ( UINT64_MAX, GetPipelineStatistics( 0 ).m_Index );
+            EXPECT_EQ( 0, GetPipelineStatistics( 0 ).m_VertexShaderInvocations );
+
+            // Statistics are collected again once the application's query ends.
+            EXPECT_NE( UINT64_MAX, GetPipelineStatistics( 1 ).m_Index );
+            EXPECT_LT( 0, GetPipelineStatistics( 1 ).m_VertexShaderInvocations );
+        }
+
+        vkDestroyQueryPool( Vk->Device, queryPool, nullptr );
+    }
+
+    TEST_F( ProfilerCommandBufferULT, DISABLED_ResolveDrawcallsBenchmark )
+    {
+        // Drawcalls are timestamped in the default sampling mode.
+        const uint32_t drawcallCount = 100'000;
+
+        // Create simple triangle app
+        VulkanSimpleTriangle simpleTriangle( Vk );
+        VkCommandBuffer commandBuffer = {};
+
+        { // Allocate command buffer
+            VkCommandBufferAllocateInfo allocateInfo = {};
+            allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocateInfo.commandBufferCount = 1;
+            allocateInfo.commandPool = Vk->CommandPool;
+            ASSERT_EQ( VK_SUCCESS, vkAllocateCommandBuffers( Vk->Device, &allocateInfo, &commandBuffer ) );
+        }
+        { // Begin command buffer
+            VkCommandBufferBeginInfo beginInfo = {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            ASSERT_EQ( VK_SUCCESS, vkBeginCommandBuffer( commandBuffer, &beginInfo ) );
+        }
+        { // Begin render pass
+            VkRenderPassBeginInfo beginInfo = {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+            beginInfo.renderPass = simpleTriangle.RenderPass;
+            beginInfo.renderArea = simpleTriangle.RenderArea;
+            beginInfo.framebuffer = simpleTriangle.Framebuffer;
+            vkCmdBeginRenderPass( commandBuffer, &beginInfo, VK_SUBPASS_CONTENTS_INLINE );
+        }
+        { // Record commands
+            vkCmdBindPipeline( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, simpleTriangle.Pipeline );
+
+            for( uint32_t i = 0; i < drawcallCount; ++i )
+            {
+                vkCmdDraw( commandBuffer, 3, 1, 0, 0 );
+            }
+        }
+        { // End render pass
+            vkCmdEndRenderPass( commandBuffer );
+        }
+        { // End command buffer
+            ASSERT_EQ( VK_SUCCESS, vkEndCommandBuffer( commandBuffer ) );
+        }
+        { // Submit command buffer
+            VkSubmitInfo submitInfo = {};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &commandBuffer;
+            ASSERT_EQ( VK_SUCCESS, vkQueueSubmit( Vk->Queue, 1, &submitInfo, VK_NULL_HANDLE ) );
+            vkDeviceWaitIdle( Vk->Device );
+        }
+
+        // Resolve the command buffer.
+        const auto begin = std::chrono::steady_clock::now();
+        Prof->FinishFrame();
+        const auto end = std::chrono::steady_clock::now();
+
+        { // Validate data
+            std::shared_ptr<DeviceProfilerFrameData> pData = Prof->GetData();
+            ASSERT_NE( nullptr, pData );
+
+            const auto& cmdBufferData = *pData->m_Submits.front().m_Submits.front().m_CommandBuffers.front();
+            EXPECT_EQ( drawcallCount, cmdBufferData.m_Stats.m_DrawStats.m_Count );
+        }
+
+        const double seconds = std::chrono::duration<double>( end - begin ).count();
+        const double drawcallsPerSecond = ( seconds > 0 ) ? ( drawcallCount / seconds ) : 0;
+
+        RecordProperty( "DrawcallCount", std::to_string( drawcallCount ) );
+        RecordProperty( "DrawcallSize", std::to_string( sizeof( DeviceProfilerDrawcall ) ) );
+        RecordProperty( "DrawcallsPerSecond", std::to_string( static_cast<uint64_t>( drawcallsPerSecond ) ) );
+    }
 }
@@ -21,6 +21,11 @@
 #include "profiler_testing_common.h"
 
 #include "profiler/profiler_data.h"
+#include "profiler/profiler_cpu_timeline.h"
+#include "profiler/profiler_critical_path.h"
+#include "profiler/profiler_hitch_detector.h"
+#include "profiler/profiler_memory_event_log.h"
+#include "profiler_helpers/profiler_memory_history.h"
 
 template<typename T>
 void ExpectStructureEqual( const T& expected, const T& actual )
@@ -210,4 +215,495 @@ namespace Profiler
 
         copiedPayload.FreeDynamicAllocations();
     }
+
+    TEST( ProfilerDataULT, CopyAccelerationStructureBuildInfosShared )
+    {
+        VkAccelerationStructureGeometryKHR geometries[ 2 ] = {};
+        geometries[ 0 ].sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR;
+        geometries[ 0 ].geometryType = VK_GEOMETRY_TYPE_TRIANGLES_KHR;
+        geometries[ 1 ].sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR;
+        geometries[ 1 ].geometryType = VK_GEOMETRY_TYPE_AABBS_KHR;
+
+        VkAccelerationStructureBuildGeometryInfoKHR buildInfo = {};
+        buildInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
+        buildInfo.type = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR;
+        buildInfo.mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_UPDATE_KHR;
+        buildInfo.geometryCount = 2;
+        buildInfo.pGeometries = geometries;
+
+        VkAccelerationStructureBuildRangeInfoKHR rangeInfos[ 2 ] = {};
+        rangeInfos[ 0 ].primitiveCount = 100;
+        rangeInfos[ 1 ].primitiveCount = 200;
+
+        VkAccelerationStructureBuildRangeInfoKHR* pRangeInfos = rangeInfos;
+
+        DeviceProfilerDrawcall drawcall;
+        drawcall.m_Type = DeviceProfilerDrawcallType::eBuildAccelerationStructuresKHR;
+        drawcall.m_Payload.m_BuildAccelerationStructures.m_InfoCount = 1;
+        drawcall.m_Payload.m_BuildAccelerationStructures.m_pInfos = &buildInfo;
+        drawcall.m_Payload.m_BuildAccelerationStructures.m_ppRanges = &pRangeInfos;
+
+        // The first copy captures the data from the application.
+        DeviceProfilerDrawcall copiedDrawcall( drawcall );
+        const auto& copiedPayload = copiedDrawcall.m_Payload.m_BuildAccelerationStructures;
+
+        ASSERT_NE( nullptr, copiedPayload.m_pSharedData );
+        ASSERT_NE( &buildInfo, copiedPayload.m_pInfos );
+        ExpectStructureEqual( buildInfo, *copiedPayload.m_pInfos );
+        ExpectStructureEqual( rangeInfos[ 0 ], copiedPayload.m_ppRanges[ 0 ][ 0 ] );
+        ExpectStructureEqual( rangeInfos[ 1 ], copiedPayload.m_ppRanges[ 0 ][ 1 ] );
+        EXPECT_EQ( 1u, copiedPayload.m_pSharedData->m_ReferenceCount.load() );
+
+        {
+            // Further copies share the captured data.
+            DeviceProfilerDrawcall sharedDrawcall( copiedDrawcall );
+            const auto& sharedPayload = sharedDrawcall.m_Payload.m_BuildAccelerationStructures;
+
+            EXPECT_EQ( copiedPayload.m_pSharedData, sharedPayload.m_pSharedData );
+            EXPECT_EQ( copiedPayload.m_pInfos, sharedPayload.m_pInfos );
+            EXPECT_EQ( copiedPayload.m_ppRanges, sharedPayload.m_ppRanges );
+            EXPECT_EQ( 2u, copiedPayload.m_pSharedData->m_ReferenceCount.load() );
+        }
+
+        EXPECT_EQ( 1u, copiedPayload.m_pSharedData->m_ReferenceCount.load() );
+    }
+
+    TEST( ProfilerDataULT, CopyPipelineCreateInfoSharesStateBlocks )
+    {
+        VkPipelineRasterizationStateCreateInfo rasterizationState[2] = {};
+        VkPipelineColorBlendAttachmentState colorBlendAttachment[2] = {};
+        VkPipelineColorBlendStateCreateInfo colorBlendState[2] = {};
+        VkGraphicsPipelineCreateInfo createInfo[2] = {};
+
+        for( uint32_t i = 0; i < 2; ++i )
+        {
+            rasterizationState[i].sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+            rasterizationState[i].polygonMode = VK_POLYGON_MODE_FILL;
+            rasterizationState[i].cullMode = VK_CULL_MODE_BACK_BIT;
+            rasterizationState[i].lineWidth = 1.0f;
+
+            colorBlendAttachment[i].colorWriteMask = VK_COLOR_COMPONENT_R_BIT;
+
+            colorBlendState[i].sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+            colorBlendState[i].attachmentCount = 1;
+            colorBlendState[i].pAttachments = &colorBlendAttachment[i];
+
+            createInfo[i].sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+            createInfo[i].pRasterizationState = &rasterizationState[i];
+            createInfo[i].pColorBlendState = &colorBlendState[i];
+        }
+
+        // Make the color blend states different.
+        colorBlendAttachment[1].blendEnable = VK_TRUE;
+
+        auto pCopy0 = DeviceProfilerPipeline::CopyPipelineCreateInfo( &createInfo[0] );
+        auto pCopy1 = DeviceProfilerPipeline::CopyPipelineCreateInfo( &createInfo[1] );
+        ASSERT_NE( nullptr, pCopy0 );
+        ASSERT_NE( nullptr, pCopy1 );
+
+        const VkGraphicsPipelineCreateInfo& copy0 = pCopy0->m_GraphicsPipelineCreateInfo;
+        const VkGraphicsPipelineCreateInfo& copy1 = pCopy1->m_GraphicsPipelineCreateInfo;
+
+        // Identical states are stored once.
+        ASSERT_NE( nullptr, copy0.pRasterizationState );
+        EXPECT_EQ( copy0.pRasterizationState, copy1.pRasterizationState );
+        ExpectStructureEqual( rasterizationState[0], *copy0.pRasterizationState );
+
+        // Different states are stored separately.
+        ASSERT_NE( nullptr, copy0.pColorBlendState );
+        ASSERT_NE( nullptr, copy1.pColorBlendState );
+        EXPECT_NE( copy0.pColorBlendState, copy1.pColorBlendState );
+        EXPECT_EQ( VK_FALSE, copy0.pColorBlendState->pAttachments[0].blendEnable );
+        EXPECT_EQ( VK_TRUE, copy1.pColorBlendState->pAttachments[0].blendEnable );
+
+        // Missing states are not copied.
+        EXPECT_EQ( nullptr, copy0.pVertexInputState );
+        EXPECT_EQ( nullptr, copy0.pDynamicState );
+
+        // Shared states remain valid after other pipelines are released.
+        const VkPipelineRasterizationStateCreateInfo* pSharedRasterizationState = copy1.pRasterizationState;
+        pCopy0.reset();
+        EXPECT_EQ( VK_CULL_MODE_BACK_BIT, pSharedRasterizationState->cullMode );
+    }
+
+    TEST( ProfilerDataULT, EstimateSampledDrawcallStats )
+    {
+        DeviceProfilerDrawcallStats::Stats stats = {};
+        stats.m_Count = 4;
+        stats.AddTicks( 100 );
+        stats.AddTicks( 300 );
+
+        // All measured commands.
+        EXPECT_EQ( 400, stats.GetEstimatedTicksSum() );
+        EXPECT_EQ( 0, stats.GetEstimatedTicksSumError() );
+        EXPECT_EQ( 100, stats.GetTicksAvg() );
+
+        // Half of the commands not measured.
+        stats.AddSkippedSample();
+        stats.AddSkippedSample();
+        EXPECT_EQ( 400, stats.m_TicksSum );
+        EXPECT_EQ( 800, stats.GetEstimatedTicksSum() );
+        EXPECT_EQ( 200, stats.GetTicksAvg() );
+        EXPECT_GT( stats.GetEstimatedTicksSumError(), 0 );
+
+        DeviceProfilerDrawcallStats::Stats mergedStats = {};
+        mergedStats.AddStats( stats );
+        EXPECT_EQ( stats.m_SampleCount, mergedStats.m_SampleCount );
+        EXPECT_EQ( stats.m_SkippedSampleCount, mergedStats.m_SkippedSampleCount );
+        EXPECT_EQ( stats.GetEstimatedTicksSum(), mergedStats.GetEstimatedTicksSum() );
+    }
+
+    TEST( ProfilerDataULT, EstimateRunningStatistics )
+    {
+        ProfilerRunningStatistics stats = {};
+
+        // Feed values 0..999 in a pseudo-random order.
+        for( uint32_t i = 0; i < 1000; ++i )
+        {
+            stats.AddSample( ( i * 7919 ) % 1000, 0.05 );
+        }
+
+        EXPECT_EQ( 1000, stats.m_SampleCount );
+        EXPECT_NEAR( 990, stats.m_P99.GetValue(), 15 );
+
+        // Moving average follows the recent samples.
+        for( uint32_t i = 0; i < 1000; ++i )
+        {
+            stats.AddSample( 100, 0.05 );
+        }
+
+        EXPECT_NEAR( 100, stats.m_Mean, 0.01 );
+        EXPECT_NEAR( 0, stats.GetStdDev(), 0.01 );
+    }
+
+    TEST( ProfilerDataULT, DetectHitches )
+    {
+        DeviceProfilerHitchDetector detector;
+        detector.Initialize( 3.f );
+
+        auto ProcessFrame = [&]( uint32_t frameIndex, uint64_t pipelineTicks )
+        {
+            DeviceProfilerFrameData frameData = {};
+            frameData.m_CPU.m_FrameIndex = frameIndex;
+
+            DeviceProfilerPipelineData& pipeline = frameData.m_TopPipelines.emplace_back();
+            pipeline.m_ShaderTuple.m_Hash = 0x1234;
+            pipeline.m_BeginTimestamp.m_Value = 0;
+            pipeline.m_EndTimestamp.m_Value = pipelineTicks;
+
+            detector.ProcessFrame( frameData );
+            return frameData.m_Hitches;
+        };
+
+        // Collect the history.
+        for( uint32_t i = 0; i < 100; ++i )
+        {
+            EXPECT_TRUE( ProcessFrame( i, 1000 + ( i % 5 ) ).empty() );
+        }
+
+        // Small deviation is not reported.
+        EXPECT_TRUE( ProcessFrame( 100, 1010 ).empty() );
+
+        // Spike is reported.
+        std::vector<DeviceProfilerHitchData> hitches = ProcessFrame( 101, 2000 );
+        ASSERT_EQ( 1, hitches.size() );
+        EXPECT_EQ( DeviceProfilerHitchRegionType::ePipeline, hitches[0].m_RegionType );
+        EXPECT_EQ( 0x1234, hitches[0].m_Pipeline.m_ShaderTuple.m_Hash );
+        EXPECT_EQ( 101, hitches[0].m_FrameIndex );
+        EXPECT_EQ( 2000, hitches[0].m_Ticks );
+        EXPECT_NEAR( 1002, hitches[0].m_MeanTicks, 5 );
+    }
+
+    TEST( ProfilerDataULT, AnalyzeCriticalPath )
+    {
+        DeviceProfilerCriticalPathAnalyzer analyzer;
+        analyzer.Initialize( 1.f );
+
+        const VkQueueHandle graphicsQueue = VkObjectTraits<VkQueue>::GetObjectHandleAsVulkanHandle( 0x1 );
+        const VkQueueHandle computeQueue = VkObjectTraits<VkQueue>::GetObjectHandleAsVulkanHandle( 0x2 );
+        const VkSemaphoreHandle semaphore = VkObjectTraits<VkSemaphore>::GetObjectHandleAsVulkanHandle( 0x10 );
+
+        auto AppendSubmit = [&]( DeviceProfilerFrameData& frameData, VkQueueHandle queue, uint64_t begin, uint64_t end ) -> DeviceProfilerSubmitData&
+        {
+            DeviceProfilerSubmitBatchData& submitBatch = frameData.m_Submits.emplace_back();
+            submitBatch.m_Handle = queue;
+
+            DeviceProfilerSubmitData& submit = submitBatch.m_Submits.emplace_back();
+            submit.m_BeginTimestamp.m_Value = begin;
+            submit.m_EndTimestamp.m_Value = end;
+            return submit;
+        };
+
+        DeviceProfilerFrameData frameData = {};
+        frameData.m_BeginTimestamp = 0;
+        frameData.m_EndTimestamp = 400;
+
+        // Compute work waits for the first graphics submit.
+        AppendSubmit( frameData, graphicsQueue, 0, 100 ).m_SignalSemaphores.push_back( semaphore );
+        AppendSubmit( frameData, computeQueue, 150, 400 ).m_WaitSemaphores.push_back( semaphore );
+        AppendSubmit( frameData, graphicsQueue, 120, 200 );
+
+        analyzer.ProcessFrame( frameData );
+
+        const DeviceProfilerSubmitData& graphicsSubmit0 = frameData.m_Submits[0].m_Submits[0];
+        const DeviceProfilerSubmitData& computeSubmit = frameData.m_Submits[1].m_Submits[0];
+        const DeviceProfilerSubmitData& graphicsSubmit1 = frameData.m_Submits[2].m_Submits[0];
+
+        ASSERT_EQ( 1, frameData.m_SemaphoreDependencies.size() );
+        EXPECT_EQ( 0, frameData.m_SemaphoreDependencies[0].m_SignalSubmit.m_SubmitBatchIndex );
+        EXPECT_EQ( 1, frameData.m_SemaphoreDependencies[0].m_WaitSubmit.m_SubmitBatchIndex );
+
+        // The last submit and its semaphore dependency form the critical path.
+        EXPECT_TRUE( graphicsSubmit0.m_CriticalPath );
+        EXPECT_TRUE( computeSubmit.m_CriticalPath );
+        EXPECT_FALSE( graphicsSubmit1.m_CriticalPath );
+        EXPECT_EQ( 350, frameData.m_CriticalPathTicks );
+
+        EXPECT_EQ( 50, graphicsSubmit0.m_SlackTicks );
+        EXPECT_EQ( 0, computeSubmit.m_SlackTicks );
+        EXPECT_EQ( 200, graphicsSubmit1.m_SlackTicks );
+
+        // Idle time on the compute queue is caused by the semaphore.
+        EXPECT_EQ( 150, computeSubmit.m_IdleTicks );
+        EXPECT_EQ( DeviceProfilerQueueIdleReason::eSemaphoreWait, computeSubmit.m_IdleReason );
+        EXPECT_EQ( 20, graphicsSubmit1.m_IdleTicks );
+        EXPECT_EQ( DeviceProfilerQueueIdleReason::eUnknown, graphicsSubmit1.m_IdleReason );
+    }
+
+    TEST( ProfilerDataULT, CollectCpuSpans )
+    {
+        DeviceProfilerCpuTimeline timeline;
+
+        auto AppendSpan = [&]( DeviceProfilerCpuSpanType type, uint64_t begin, uint64_t end )
+        {
+            DeviceProfilerCpuSpanData span = {};
+            span.m_Type = type;
+            span.m_BeginTimestamp = begin;
+            span.m_EndTimestamp = end;
+            timeline.AppendSpan( span );
+        };
+
+        AppendSpan( DeviceProfilerCpuSpanType::eCommandBufferRecording, 0, 100 );
+        AppendSpan( DeviceProfilerCpuSpanType::eQueueSubmit, 110, 120 );
+        AppendSpan( DeviceProfilerCpuSpanType::eQueuePresent, 150, 200 );
+
+        // Spans that ended before the end of the frame are collected.
+        std::vector<DeviceProfilerCpuSpanData> spans;
+        timeline.CollectSpans( 120, spans );
+        ASSERT_EQ( 2, spans.size() );
+        EXPECT_EQ( DeviceProfilerCpuSpanType::eCommandBufferRecording, spans[0].m_Type );
+        EXPECT_EQ( DeviceProfilerCpuSpanType::eQueueSubmit, spans[1].m_Type );
+        EXPECT_EQ( ProfilerPlatformFunctions::GetCurrentThreadId(), spans[0].m_ThreadId );
+
+        // Remaining spans are collected with the next frame.
+        spans.clear();
+        timeline.CollectSpans( 200, spans );
+        ASSERT_EQ( 1, spans.size() );
+        EXPECT_EQ( DeviceProfilerCpuSpanType::eQueuePresent, spans[0].m_Type );
+
+        spans.clear();
+        timeline.CollectSpans( 300, spans );
+        EXPECT_TRUE( spans.empty() );
+
+        timeline.Destroy();
+    }
+
+    TEST( ProfilerDataULT, CollectMemoryEvents )
+    {
+        DeviceProfilerMemoryEventLog log;
+        log.Initialize( 4 );
+
+        auto AppendEvent = [&]( uint64_t timestamp )
+        {
+            DeviceProfilerMemoryEventData event = {};
+            event.m_Type = DeviceProfilerMemoryEventType::eAllocate;
+            event.m_Timestamp = timestamp;
+            log.AppendEvent( event );
+        };
+
+        AppendEvent( 1 );
+        AppendEvent( 2 );
+
+        std::vector<DeviceProfilerMemoryEventData> events;
+        EXPECT_EQ( 0, log.CollectEvents( events ) );
+        ASSERT_EQ( 2, events.size() );
+        EXPECT_EQ( 1, events[0].m_Timestamp );
+        EXPECT_EQ( 2, events[1].m_Timestamp );
+        EXPECT_EQ( ProfilerPlatformFunctions::GetCurrentThreadId(), events[0].m_ThreadId );
+
+        // The oldest events are dropped when the capacity is exceeded.
+        for( uint64_t timestamp = 3; timestamp <= 8; ++timestamp )
+        {
+            AppendEvent( timestamp );
+        }
+
+        events.clear();
+        EXPECT_EQ( 2, log.CollectEvents( events ) );
+        ASSERT_EQ( 4, events.size() );
+        EXPECT_EQ( 5, events[0].m_Timestamp );
+        EXPECT_EQ( 8, events[3].m_Timestamp );
+
+        // The ring starts from the beginning after the collection.
+        AppendEvent( 9 );
+
+        events.clear();
+        EXPECT_EQ( 0, log.CollectEvents( events ) );
+        ASSERT_EQ( 1, events.size() );
+        EXPECT_EQ( 9, events[0].m_Timestamp );
+
+        log.Destroy();
+
+        events.clear();
+        EXPECT_EQ( 0, log.CollectEvents( events ) );
+        EXPECT_TRUE( events.empty() );
+    }
+
+    TEST( ProfilerDataULT, ReplayMemoryEvents )
+    {
+        const VkDeviceMemoryHandle memory = VkObjectTraits<VkDeviceMemory>::GetObjectHandleAsVulkanHandle( 0x1 );
+        const VkDeviceMemoryHandle otherMemory = VkObjectTraits<VkDeviceMemory>::GetObjectHandleAsVulkanHandle( 0x2 );
+        const VkBufferHandle buffer0 = VkObjectTraits<VkBuffer>::GetObjectHandleAsVulkanHandle( 0x10 );
+        const VkBufferHandle buffer1 = VkObjectTraits<VkBuffer>::GetObjectHandleAsVulkanHandle( 0x11 );
+
+        auto MakeEvent = []( DeviceProfilerMemoryEventType type, VkDeviceMemoryHandle memory, VkDeviceSize offset, VkDeviceSize size, VkObject resource )
+        {
+            DeviceProfilerMemoryEventData event = {};
+            event.m_Type = type;
+            event.m_Memory = memory;
+            event.m_MemoryOffset = offset;
+            event.m_Size = size;
+            event.m_Resource = resource;
+            return event;
+        };
+
+        // Snapshot of the first frame, buffer0 occupies the beginning of the memory.
+        auto pSnapshot = std::make_shared<DeviceProfilerMemorySnapshotData>();
+        pSnapshot->m_Allocations[memory].m_Size = 1024;
+
+        DeviceProfilerBufferMemoryBindingData binding = {};
+        binding.m_Memory = memory;
+        binding.m_MemoryOffset = 0;
+        binding.m_Size = 200;
+
+        DeviceProfilerBufferMemoryData& bufferData = pSnapshot->m_Buffers[buffer0];
+        bufferData.m_BufferSize = 200;
+        bufferData.m_MemoryRequirements.size = 256;
+        bufferData.m_MemoryBindings = binding;
+
+        DeviceProfilerMemoryData frame0 = {};
+        frame0.m_pSnapshot = pSnapshot;
+
+        // buffer1 is bound in the middle of the memory.
+        // The following frames share the snapshot of the first one.
+        auto pChanges1 = std::make_shared<DeviceProfilerMemorySnapshotChangesData>();
+        pChanges1->m_Updated.m_Allocations[otherMemory].m_Size = 128;
+
+        binding.m_MemoryOffset = 512;
+        DeviceProfilerBufferMemoryData& buffer1Data = pChanges1->m_Updated.m_Buffers[buffer1];
+        buffer1Data.m_BufferSize = 200;
+        buffer1Data.m_MemoryRequirements.size = 256;
+        buffer1Data.m_MemoryBindings = binding;
+
+        DeviceProfilerMemoryData frame1 = {};
+        frame1.m_pSnapshot = pSnapshot;
+        frame1.m_pChanges = pChanges1;
+        frame1.m_SnapshotAge = 1;
+        frame1.m_Events.push_back( MakeEvent( DeviceProfilerMemoryEventType::eCreate, VkDeviceMemoryHandle(), 0, 0, buffer1 ) );
+        frame1.m_Events.push_back( MakeEvent( DeviceProfilerMemoryEventType::eBind, memory, 512, 256, buffer1 ) );
+        frame1.m_Events.push_back( MakeEvent( DeviceProfilerMemoryEventType::eAllocate, otherMemory, 0, 128, VkObject() ) );
+
+        // buffer0 is destroyed.
+        auto pChanges2 = std::make_shared<DeviceProfilerMemorySnapshotChangesData>();
+        pChanges2->m_pPrevious = pChanges1;
+        pChanges2->m_Removed.push_back( buffer0 );
+        pChanges2->m_Removed.push_back( otherMemory );
+
+        DeviceProfilerMemoryData frame2 = {};
+        frame2.m_pSnapshot = pSnapshot;
+        frame2.m_pChanges = pChanges2;
+        frame2.m_SnapshotAge = 2;
+        frame2.m_Events.push_back( MakeEvent( DeviceProfilerMemoryEventType::eUnbind, memory, 0, 256, buffer0 ) );
+        frame2.m_Events.push_back( MakeEvent( DeviceProfilerMemoryEventType::eDestroy, VkDeviceMemoryHandle(), 0, 0, buffer0 ) );
+        frame2.m_Events.push_back( MakeEvent( DeviceProfilerMemoryEventType::eFree, otherMemory, 0, 128, VkObject() ) );
+
+        // The state of the frames is rebuilt from the changes made since the snapshot.
+        EXPECT_EQ( pSnapshot, DeviceProfilerMemoryHistory::GetFrameSnapshot( frame0 ) );
+
+        std::shared_ptr<const DeviceProfilerMemorySnapshotData> pFrameSnapshot = DeviceProfilerMemoryHistory::GetFrameSnapshot( frame1 );
+        ASSERT_NE( nullptr, pFrameSnapshot );
+        EXPECT_EQ( 2, pFrameSnapshot->m_Allocations.size() );
+        EXPECT_EQ( 2, pFrameSnapshot->m_Buffers.size() );
+        ASSERT_EQ( 1, pFrameSnapshot->m_Buffers.count( buffer1 ) );
+        EXPECT_EQ( 512, pFrameSnapshot->m_Buffers.at( buffer1 ).GetMemoryBindings()->m_MemoryOffset );
+
+        pFrameSnapshot = DeviceProfilerMemoryHistory::GetFrameSnapshot( frame2 );
+        ASSERT_NE( nullptr, pFrameSnapshot );
+        EXPECT_EQ( 1, pFrameSnapshot->m_Allocations.size() );
+        EXPECT_EQ( 1, pFrameSnapshot->m_Allocations.count( memory ) );
+        EXPECT_EQ( 1, pFrameSnapshot->m_Buffers.size() );
+        EXPECT_EQ( 1, pFrameSnapshot->m_Buffers.count( buffer1 ) );
+
+        // The shared snapshot is not modified.
+        EXPECT_EQ( 1, pSnapshot->m_Allocations.size() );
+        EXPECT_EQ( 1, pSnapshot->m_Buffers.size() );
+        EXPECT_EQ( 1, pSnapshot->m_Buffers.count( buffer0 ) );
+
+        DeviceProfilerMemoryHistory history;
+        history.AppendFrame( 10, frame0 );
+        history.AppendFrame( 11, frame1 );
+        history.AppendFrame( 12, frame2 );
+
+        EXPECT_EQ( 10, history.GetFirstFrameIndex() );
+        EXPECT_EQ( 12, history.GetLastFrameIndex() );
+        EXPECT_EQ( nullptr, history.GetState( 9 ) );
+        EXPECT_EQ( nullptr, history.GetState( 13 ) );
+
+        const DeviceProfilerMemoryHistoryState* pState = history.GetState( 10 );
+        ASSERT_NE( nullptr, pState );
+        DeviceProfilerMemoryFragmentationData fragmentation = pState->GetFragmentation( memory );
+        EXPECT_EQ( 256, fragmentation.m_BoundSize );
+        EXPECT_EQ( 768, fragmentation.m_FreeSize );
+        EXPECT_EQ( 1, fragmentation.m_FreeBlockCount );
+        EXPECT_FLOAT_EQ( 0.f, fragmentation.m_Fragmentation );
+
+        pState = history.GetState( 12 );
+        ASSERT_NE( nullptr, pState );
+        EXPECT_EQ( 0, pState->m_Allocations.count( otherMemory ) );
+        fragmentation = pState->GetFragmentation( memory );
+        EXPECT_EQ( 256, fragmentation.m_BoundSize );
+        EXPECT_EQ( 768, fragmentation.m_FreeSize );
+        EXPECT_EQ( 512, fragmentation.m_LargestFreeBlockSize );
+        EXPECT_EQ( 2, fragmentation.m_FreeBlockCount );
+        EXPECT_FLOAT_EQ( 1.f / 3.f, fragmentation.m_Fragmentation );
+
+        // Going back in history replays the events from the snapshot.
+        pState = history.GetState( 11 );
+        ASSERT_NE( nullptr, pState );
+        EXPECT_EQ( 1, pState->m_Allocations.count( otherMemory ) );
+        fragmentation = pState->GetFragmentation( memory );
+        EXPECT_EQ( 512, fragmentation.m_BoundSize );
+        EXPECT_EQ( 512, fragmentation.m_FreeSize );
+        EXPECT_EQ( 256, fragmentation.m_LargestFreeBlockSize );
+        EXPECT_EQ( 2, fragmentation.m_FreeBlockCount );
+        EXPECT_FLOAT_EQ( 0.5f, fragmentation.m_Fragmentation );
+
+        // Skipped frame restarts the history.
+        history.AppendFrame( 14, frame0 );
+        EXPECT_EQ( 14, history.GetFirstFrameIndex() );
+        EXPECT_EQ( 14, history.GetLastFrameIndex() );
+        EXPECT_EQ( nullptr, history.GetState( 12 ) );
+
+        // History is restarted from the rebuilt state if the snapshot was captured in a previous frame.
+        history.AppendFrame( 16, frame2 );
+        EXPECT_FALSE( history.IsEmpty() );
+        EXPECT_EQ( 16, history.GetFirstFrameIndex() );
+
+        pState = history.GetState( 16 );
+        ASSERT_NE( nullptr, pState );
+        EXPECT_EQ( 0, pState->m_Allocations.count( otherMemory ) );
+        fragmentation = pState->GetFragmentation( memory );
+        EXPECT_EQ( 256, fragmentation.m_BoundSize );
+        EXPECT_EQ( 512, fragmentation.m_LargestFreeBlockSize );
+        EXPECT_EQ( 2, fragmentation.m_FreeBlockCount );
+    }
 }
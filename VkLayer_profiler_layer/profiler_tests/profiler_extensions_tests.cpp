@@ -24,6 +24,7 @@
 
 #include "profiler/profiler.h"
 
+#include <algorithm>
 #include <set>
 #include <string>
 
@@ -597,4 +598,410 @@ namespace Profiler
             freeProfilerFrameDataEXT( Vk->Device, &data );
         }
     }
+
+    TEST_F( ProfilerExtensionsULT, vkGetProfilerFrameDataBufferEXT )
+    {
+        VulkanState::CreateInfo vulkanCreateInfo;
+        VulkanExtension profilerExtension( VK_EXT_PROFILER_EXTENSION_NAME, true );
+        vulkanCreateInfo.DeviceExtensions.push_back( &profilerExtension );
+
+        // Create vulkan instance with profiler layer enabled externally
+        SetUpVulkan( vulkanCreateInfo );
+
+        // Initialize simple triangle app
+        VulkanSimpleTriangle simpleTriangle( Vk );
+
+        VkCommandBuffer commandBuffer;
+
+        { // Allocate command buffer
+            VkCommandBufferAllocateInfo allocateInfo = {};
+            allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocateInfo.commandPool = Vk->CommandPool;
+            allocateInfo.commandBufferCount = 1;
+            ASSERT_EQ( VK_SUCCESS, vkAllocateCommandBuffers( Vk->Device, &allocateInfo, &commandBuffer ) );
+        }
+        { // Begin command buffer
+            VkCommandBufferBeginInfo beginInfo = {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            ASSERT_EQ( VK_SUCCESS, vkBeginCommandBuffer( commandBuffer, &beginInfo ) );
+        }
+        { // Image layout transitions
+            VkImageMemoryBarrier barrier = {};
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.srcAccessMask = 0;
+            barrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            barrier.srcQueueFamilyIndex = Vk->QueueFamilyIndex;
+            barrier.dstQueueFamilyIndex = Vk->QueueFamilyIndex;
+            barrier.image = simpleTriangle.FramebufferImage;
+            barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+            barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+            vkCmdPipelineBarrier( commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_DEPENDENCY_BY_REGION_BIT, 0, nullptr, 0, nullptr, 1, &barrier );
+        }
+        { // Begin render pass
+            VkRenderPassBeginInfo beginInfo = {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+            beginInfo.renderPass = simpleTriangle.RenderPass;
+            beginInfo.framebuffer = simpleTriangle.Framebuffer;
+            beginInfo.renderArea = simpleTriangle.RenderArea;
+            vkCmdBeginRenderPass( commandBuffer, &beginInfo, VK_SUBPASS_CONTENTS_INLINE );
+        }
+        { // Draw triangles
+            vkCmdBindPipeline( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, simpleTriangle.Pipeline );
+            vkCmdDraw( commandBuffer, 3, 1000, 0, 0 );
+            vkCmdDraw( commandBuffer, 3, 1000, 0, 0 );
+        }
+        { // End render pass
+            vkCmdEndRenderPass( commandBuffer );
+        }
+        { // End command buffer
+            ASSERT_EQ( VK_SUCCESS, vkEndCommandBuffer( commandBuffer ) );
+        }
+        { // Submit command buffer
+            VkSubmitInfo submitInfo = {};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &commandBuffer;
+            ASSERT_EQ( VK_SUCCESS, vkQueueSubmit( Vk->Queue, 1, &submitInfo, VK_NULL_HANDLE ) );
+        }
+
+        VkProfilerDataEXT data = {};
+        data.sType = VK_STRUCTURE_TYPE_PROFILER_DATA_EXT;
+
+        PFN_vkFlushProfilerEXT flushProfilerEXT = (PFN_vkFlushProfilerEXT)vkGetDeviceProcAddr( Vk->Device, "vkFlushProfilerEXT" );
+        PFN_vkGetProfilerFrameDataBufferEXT getProfilerFrameDataBufferEXT = (PFN_vkGetProfilerFrameDataBufferEXT)vkGetDeviceProcAddr( Vk->Device, "vkGetProfilerFrameDataBufferEXT" );
+
+        ASSERT_NE( nullptr, flushProfilerEXT );
+        ASSERT_NE( nullptr, getProfilerFrameDataBufferEXT );
+
+        // Serialize regions up to render passes (frame, submit, submit info, command buffer, render pass)
+        const uint32_t maxDepth = 4;
+
+        size_t bufferSize = 0;
+        std::vector<uint64_t> buffer;
+
+        { // Collect data
+            vkDeviceWaitIdle( Vk->Device );
+            ASSERT_EQ( VK_SUCCESS, flushProfilerEXT( Vk->Device ) );
+            ASSERT_EQ( VK_SUCCESS, getProfilerFrameDataBufferEXT( Vk->Device, maxDepth, &data, &bufferSize, nullptr ) );
+
+            // The queried size includes padding required for a buffer at any address
+            const size_t dataSize = 4 * sizeof( VkProfilerRegionDataEXT ) + sizeof( VkProfilerRenderPassDataEXT );
+            const size_t maxPadding = std::max( alignof( VkProfilerRegionDataEXT ), alignof( VkProfilerRenderPassDataEXT ) ) - 1;
+            EXPECT_EQ( dataSize + maxPadding, bufferSize );
+
+            size_t smallBufferSize = dataSize - 1;
+            buffer.resize( ( bufferSize + sizeof( uint64_t ) - 1 ) / sizeof( uint64_t ) );
+            EXPECT_EQ( VK_INCOMPLETE, getProfilerFrameDataBufferEXT( Vk->Device, maxDepth, &data, &smallBufferSize, buffer.data() ) );
+            EXPECT_EQ( bufferSize, smallBufferSize );
+
+            // The buffer is aligned, so no padding is used
+            ASSERT_EQ( VK_SUCCESS, getProfilerFrameDataBufferEXT( Vk->Device, maxDepth, &data, &bufferSize, buffer.data() ) );
+            EXPECT_EQ( dataSize, bufferSize );
+        }
+        { // Validate data
+            const uint8_t* pBufferBegin = reinterpret_cast<const uint8_t*>( buffer.data() );
+            const uint8_t* pBufferEnd = pBufferBegin + bufferSize;
+            auto IsInBuffer = [&]( const void* ptr ) {
+                return ( ptr >= pBufferBegin ) && ( ptr < pBufferEnd );
+            };
+
+            EXPECT_EQ( VK_STRUCTURE_TYPE_PROFILER_REGION_DATA_EXT, data.frame.sType );
+            EXPECT_EQ( VK_PROFILER_REGION_TYPE_FRAME_EXT, data.frame.regionType );
+            EXPECT_EQ( 1, data.frame.subregionCount );
+            EXPECT_LT( 0, data.frame.duration );
+            ASSERT_TRUE( IsInBuffer( data.frame.pSubregions ) );
+
+            const VkProfilerRegionDataEXT& submitData = data.frame.pSubregions[ 0 ];
+            EXPECT_EQ( VK_PROFILER_REGION_TYPE_SUBMIT_EXT, submitData.regionType );
+            EXPECT_EQ( 1, submitData.subregionCount );
+            ASSERT_TRUE( IsInBuffer( submitData.pSubregions ) );
+
+            const VkProfilerRegionDataEXT& submitInfoData = submitData.pSubregions[ 0 ];
+            EXPECT_EQ( VK_PROFILER_REGION_TYPE_SUBMIT_INFO_EXT, submitInfoData.regionType );
+            EXPECT_EQ( 1, submitInfoData.subregionCount );
+            ASSERT_TRUE( IsInBuffer( submitInfoData.pSubregions ) );
+
+            const VkProfilerRegionDataEXT& commandBufferData = submitInfoData.pSubregions[ 0 ];
+            EXPECT_EQ( VK_PROFILER_REGION_TYPE_COMMAND_BUFFER_EXT, commandBufferData.regionType );
+            EXPECT_EQ( 1, commandBufferData.subregionCount );
+            EXPECT_EQ( commandBuffer, commandBufferData.properties.commandBuffer.handle );
+            ASSERT_TRUE( IsInBuffer( commandBufferData.pSubregions ) );
+
+            const VkProfilerRegionDataEXT& renderPassData = commandBufferData.pSubregions[ 0 ];
+            EXPECT_EQ( VK_PROFILER_REGION_TYPE_RENDER_PASS_EXT, renderPassData.regionType );
+            EXPECT_LT( 0, renderPassData.duration );
+            EXPECT_EQ( simpleTriangle.RenderPass, renderPassData.properties.renderPass.handle );
+            ASSERT_TRUE( IsInBuffer( renderPassData.pNext ) );
+
+            // Subpasses are below the requested depth
+            EXPECT_EQ( 0, renderPassData.subregionCount );
+            EXPECT_EQ( nullptr, renderPassData.pSubregions );
+
+            const VkProfilerRenderPassDataEXT& renderPassDataSpec = *(const VkProfilerRenderPassDataEXT*)renderPassData.pNext;
+            EXPECT_EQ( VK_STRUCTURE_TYPE_PROFILER_RENDER_PASS_DATA_EXT, renderPassDataSpec.sType );
+            EXPECT_EQ( nullptr, renderPassDataSpec.pNext );
+        }
+    }
+
+    TEST_F( ProfilerExtensionsULT, vkGetProfilerFrameDataBufferEXT_MisalignedBuffer )
+    {
+        VulkanState::CreateInfo vulkanCreateInfo;
+        VulkanExtension profilerExtension( VK_EXT_PROFILER_EXTENSION_NAME, true );
+        vulkanCreateInfo.DeviceExtensions.push_back( &profilerExtension );
+
+        // Create vulkan instance with profiler layer enabled externally
+        SetUpVulkan( vulkanCreateInfo );
+
+        // Initialize simple triangle app
+        VulkanSimpleTriangle simpleTriangle( Vk );
+
+        VkCommandBuffer commandBuffer;
+
+        { // Allocate command buffer
+            VkCommandBufferAllocateInfo allocateInfo = {};
+            allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocateInfo.commandPool = Vk->CommandPool;
+            allocateInfo.commandBufferCount = 1;
+            ASSERT_EQ( VK_SUCCESS, vkAllocateCommandBuffers( Vk->Device, &allocateInfo, &commandBuffer ) );
+        }
+        { // Begin command buffer
+            VkCommandBufferBeginInfo beginInfo = {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            ASSERT_EQ( VK_SUCCESS, vkBeginCommandBuffer( commandBuffer, &beginInfo ) );
+        }
+        { // Image layout transitions
+            VkImageMemoryBarrier barrier = {};
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.srcAccessMask = 0;
+            barrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            barrier.srcQueueFamilyIndex = Vk->QueueFamilyIndex;
+            barrier.dstQueueFamilyIndex = Vk->QueueFamilyIndex;
+            barrier.image = simpleTriangle.FramebufferImage;
+            barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            barrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+            barrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+            vkCmdPipelineBarrier( commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_DEPENDENCY_BY_REGION_BIT, 0, nullptr, 0, nullptr, 1, &barrier );
+        }
+        { // Draw triangle in a render pass
+            VkRenderPassBeginInfo beginInfo = {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+            beginInfo.renderPass = simpleTriangle.RenderPass;
+            beginInfo.framebuffer = simpleTriangle.Framebuffer;
+            beginInfo.renderArea = simpleTriangle.RenderArea;
+            vkCmdBeginRenderPass( commandBuffer, &beginInfo, VK_SUBPASS_CONTENTS_INLINE );
+            vkCmdBindPipeline( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, simpleTriangle.Pipeline );
+            vkCmdDraw( commandBuffer, 3, 1, 0, 0 );
+            vkCmdEndRenderPass( commandBuffer );
+        }
+        { // End command buffer
+            ASSERT_EQ( VK_SUCCESS, vkEndCommandBuffer( commandBuffer ) );
+        }
+        { // Submit command buffer
+            VkSubmitInfo submitInfo = {};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &commandBuffer;
+            ASSERT_EQ( VK_SUCCESS, vkQueueSubmit( Vk->Queue, 1, &submitInfo, VK_NULL_HANDLE ) );
+        }
+
+        VkProfilerDataEXT data = {};
+        data.sType = VK_STRUCTURE_TYPE_PROFILER_DATA_EXT;
+
+        PFN_vkFlushProfilerEXT flushProfilerEXT = (PFN_vkFlushProfilerEXT)vkGetDeviceProcAddr( Vk->Device, "vkFlushProfilerEXT" );
+        PFN_vkGetProfilerFrameDataBufferEXT getProfilerFrameDataBufferEXT = (PFN_vkGetProfilerFrameDataBufferEXT)vkGetDeviceProcAddr( Vk->Device, "vkGetProfilerFrameDataBufferEXT" );
+
+        ASSERT_NE( nullptr, flushProfilerEXT );
+        ASSERT_NE( nullptr, getProfilerFrameDataBufferEXT );
+
+        // Serialize regions up to render passes (frame, submit, submit info, command buffer, render pass)
+        const uint32_t maxDepth = 4;
+
+        vkDeviceWaitIdle( Vk->Device );
+        ASSERT_EQ( VK_SUCCESS, flushProfilerEXT( Vk->Device ) );
+
+        size_t querySize = 0;
+        ASSERT_EQ( VK_SUCCESS, getProfilerFrameDataBufferEXT( Vk->Device, maxDepth, &data, &querySize, nullptr ) );
+
+        // Storage aligned for uint64_t, so each byte offset below gives a distinct misalignment
+        std::vector<uint64_t> storage( ( querySize + 2 * sizeof( uint64_t ) ) / sizeof( uint64_t ) );
+
+        for( size_t misalignment = 1; misalignment < alignof( VkProfilerRegionDataEXT ); ++misalignment )
+        {
+            uint8_t* pBufferBegin = reinterpret_cast<uint8_t*>( storage.data() ) + misalignment;
+
+            // The queried size must be sufficient regardless of the buffer's address
+            size_t bufferSize = querySize;
+            ASSERT_EQ( VK_SUCCESS, getProfilerFrameDataBufferEXT( Vk->Device, maxDepth, &data, &bufferSize, pBufferBegin ) );
+            EXPECT_GE( querySize, bufferSize );
+
+            const uint8_t* pBufferEnd = pBufferBegin + bufferSize;
+            auto IsInBufferAndAligned = [&]( const void* ptr, size_t alignment ) {
+                return ( ptr >= pBufferBegin ) && ( ptr < pBufferEnd ) &&
+                    ( ( reinterpret_cast<uintptr_t>( ptr ) % alignment ) == 0 );
+            };
+
+            const VkProfilerRegionDataEXT* pRegion = &data.frame;
+            for( uint32_t depth = 0; depth < maxDepth; ++depth )
+            {
+                ASSERT_EQ( 1, pRegion->subregionCount );
+                ASSERT_TRUE( IsInBufferAndAligned( pRegion->pSubregions, alignof( VkProfilerRegionDataEXT ) ) );
+                pRegion = &pRegion->pSubregions[ 0 ];
+            }
+
+            EXPECT_EQ( VK_PROFILER_REGION_TYPE_RENDER_PASS_EXT, pRegion->regionType );
+            ASSERT_TRUE( IsInBufferAndAligned( pRegion->pNext, alignof( VkProfilerRenderPassDataEXT ) ) );
+
+            const VkProfilerRenderPassDataEXT& renderPassDataSpec = *(const VkProfilerRenderPassDataEXT*)pRegion->pNext;
+            EXPECT_EQ( VK_STRUCTURE_TYPE_PROFILER_RENDER_PASS_DATA_EXT, renderPassDataSpec.sType );
+        }
+    }
+
+    TEST_F( ProfilerExtensionsULT, vkGetProfilerOverheadEXT )
+    {
+        EnvironmentVariableScope enable_overhead_accounting_var( "VKPROF_enable_overhead_accounting", "true" );
+
+        VulkanState::CreateInfo vulkanCreateInfo;
+        VulkanExtension profilerExtension( VK_EXT_PROFILER_EXTENSION_NAME, true );
+        vulkanCreateInfo.DeviceExtensions.push_back( &profilerExtension );
+
+        // Create vulkan instance with profiler layer enabled externally
+        SetUpVulkan( vulkanCreateInfo );
+
+        VkCommandBuffer commandBuffer;
+
+        { // Allocate command buffer
+            VkCommandBufferAllocateInfo allocateInfo = {};
+            allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocateInfo.commandPool = Vk->CommandPool;
+            allocateInfo.commandBufferCount = 1;
+            ASSERT_EQ( VK_SUCCESS, vkAllocateCommandBuffers( Vk->Device, &allocateInfo, &commandBuffer ) );
+        }
+        { // Record command buffer
+            VkCommandBufferBeginInfo beginInfo = {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            ASSERT_EQ( VK_SUCCESS, vkBeginCommandBuffer( commandBuffer, &beginInfo ) );
+            ASSERT_EQ( VK_SUCCESS, vkEndCommandBuffer( commandBuffer ) );
+        }
+        { // Submit command buffer
+            VkSubmitInfo submitInfo = {};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &commandBuffer;
+            ASSERT_EQ( VK_SUCCESS, vkQueueSubmit( Vk->Queue, 1, &submitInfo, VK_NULL_HANDLE ) );
+        }
+
+        PFN_vkFlushProfilerEXT flushProfilerEXT = (PFN_vkFlushProfilerEXT)vkGetDeviceProcAddr( Vk->Device, "vkFlushProfilerEXT" );
+        PFN_vkGetProfilerOverheadEXT getProfilerOverheadEXT = (PFN_vkGetProfilerOverheadEXT)vkGetDeviceProcAddr( Vk->Device, "vkGetProfilerOverheadEXT" );
+
+        ASSERT_NE( nullptr, flushProfilerEXT );
+        ASSERT_NE( nullptr, getProfilerOverheadEXT );
+
+        VkProfilerOverheadPropertiesEXT overhead = {};
+        overhead.sType = VK_STRUCTURE_TYPE_PROFILER_OVERHEAD_PROPERTIES_EXT;
+
+        { // Collect data
+            vkDeviceWaitIdle( Vk->Device );
+            ASSERT_EQ( VK_SUCCESS, flushProfilerEXT( Vk->Device ) );
+            ASSERT_EQ( VK_SUCCESS, getProfilerOverheadEXT( Vk->Device, &overhead ) );
+        }
+        { // Validate data
+            EXPECT_LT( 0, overhead.measurementTime );
+            EXPECT_LT( 0, overhead.queueSubmissionTime );
+            EXPECT_LT( 0, overhead.frameDataHostMemorySize );
+
+            // One-time-submit command buffers are moved into the frame data without copying
+            EXPECT_EQ( 0, overhead.copiedFrameDataSize );
+
+            // No budgets are set by default
+            EXPECT_EQ( 0, overhead.degradationFlags );
+        }
+        { // Invalid structure type
+            VkProfilerOverheadPropertiesEXT invalidOverhead = {};
+            invalidOverhead.sType = VK_STRUCTURE_TYPE_PROFILER_REGION_DATA_EXT;
+            EXPECT_EQ( VK_ERROR_INITIALIZATION_FAILED, getProfilerOverheadEXT( Vk->Device, &invalidOverhead ) );
+            EXPECT_EQ( 0, invalidOverhead.measurementTime );
+        }
+    }
+
+    TEST_F( ProfilerExtensionsULT, vkGetProfilerOverheadEXT_CopiedFrameData )
+    {
+        EnvironmentVariableScope enable_overhead_accounting_var( "VKPROF_enable_overhead_accounting", "true" );
+
+        VulkanState::CreateInfo vulkanCreateInfo;
+        VulkanExtension profilerExtension( VK_EXT_PROFILER_EXTENSION_NAME, true );
+        vulkanCreateInfo.DeviceExtensions.push_back( &profilerExtension );
+
+        // Create vulkan instance with profiler layer enabled externally
+        SetUpVulkan( vulkanCreateInfo );
+
+        PFN_vkFlushProfilerEXT flushProfilerEXT = (PFN_vkFlushProfilerEXT)vkGetDeviceProcAddr( Vk->Device, "vkFlushProfilerEXT" );
+        PFN_vkGetProfilerOverheadEXT getProfilerOverheadEXT = (PFN_vkGetProfilerOverheadEXT)vkGetDeviceProcAddr( Vk->Device, "vkGetProfilerOverheadEXT" );
+
+        ASSERT_NE( nullptr, flushProfilerEXT );
+        ASSERT_NE( nullptr, getProfilerOverheadEXT );
+
+        VkCommandBuffer commandBuffer;
+
+        { // Allocate command buffer
+            VkCommandBufferAllocateInfo allocateInfo = {};
+            allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocateInfo.commandPool = Vk->CommandPool;
+            allocateInfo.commandBufferCount = 1;
+            ASSERT_EQ( VK_SUCCESS, vkAllocateCommandBuffers( Vk->Device, &allocateInfo, &commandBuffer ) );
+        }
+        { // Record command buffer that can be submitted many times
+            VkCommandBufferBeginInfo beginInfo = {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            ASSERT_EQ( VK_SUCCESS, vkBeginCommandBuffer( commandBuffer, &beginInfo ) );
+            ASSERT_EQ( VK_SUCCESS, vkEndCommandBuffer( commandBuffer ) );
+        }
+        VkSubmitInfo submitInfo = {};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &commandBuffer;
+
+        VkProfilerOverheadPropertiesEXT overhead = {};
+        overhead.sType = VK_STRUCTURE_TYPE_PROFILER_OVERHEAD_PROPERTIES_EXT;
+
+        { // Submit command buffer and collect data
+            ASSERT_EQ( VK_SUCCESS, vkQueueSubmit( Vk->Queue, 1, &submitInfo, VK_NULL_HANDLE ) );
+            vkDeviceWaitIdle( Vk->Device );
+            ASSERT_EQ( VK_SUCCESS, flushProfilerEXT( Vk->Device ) );
+            ASSERT_EQ( VK_SUCCESS, getProfilerOverheadEXT( Vk->Device, &overhead ) );
+        }
+        { // Validate data
+            // Data of the command buffer is shared with the frame without copying
+            EXPECT_EQ( 0, overhead.copiedFrameDataSize );
+        }
+        { // Submit command buffer again while the previous frame is still kept by the profiler
+            ASSERT_EQ( VK_SUCCESS, vkQueueSubmit( Vk->Queue, 1, &submitInfo, VK_NULL_HANDLE ) );
+            vkDeviceWaitIdle( Vk->Device );
+            ASSERT_EQ( VK_SUCCESS, flushProfilerEXT( Vk->Device ) );
+            ASSERT_EQ( VK_SUCCESS, getProfilerOverheadEXT( Vk->Device, &overhead ) );
+        }
+        { // Validate data
+            // Data referenced by the previous frame is copied before it is modified
+            EXPECT_LT( 0, overhead.copiedFrameDataSize );
+        }
+        { // Collect data of the next frame without any submissions
+            ASSERT_EQ( VK_SUCCESS, flushProfilerEXT( Vk->Device ) );
+            ASSERT_EQ( VK_SUCCESS, getProfilerOverheadEXT( Vk->Device, &overhead ) );
+        }
+        { // Validate data
+            // The size is reported per frame
+            EXPECT_EQ( 0, overhead.copiedFrameDataSize );
+        }
+    }
 }
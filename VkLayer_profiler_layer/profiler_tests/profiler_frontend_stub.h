@@ -0,0 +1,121 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include "profiler/profiler_data.h"
+#include "profiler/profiler_frontend.h"
+#include "profiler/profiler_counters.h"
+#include "profiler_layer_objects/VkQueue_object.h"
+
+#include <deque>
+#include <memory>
+
+namespace Profiler
+{
+    /***********************************************************************************\
+
+    Class:
+        DeviceProfilerFrontendStub
+
+    Description:
+        Minimal frontend providing the data required by the outputs.
+        Frames pushed to m_Data are returned by GetData in order.
+
+    \***********************************************************************************/
+    class DeviceProfilerFrontendStub : public DeviceProfilerFrontend
+    {
+    public:
+        DeviceProfilerFrontendStub()
+        {
+            m_PhysicalDeviceProperties.limits.timestampPeriod = 1.0f;
+        }
+
+        bool IsAvailable() override { return true; }
+
+        const VkApplicationInfo& GetApplicationInfo() override { return m_ApplicationInfo; }
+        const VkPhysicalDeviceProperties& GetPhysicalDeviceProperties() override { return m_PhysicalDeviceProperties; }
+        const VkPhysicalDeviceMemoryProperties& GetPhysicalDeviceMemoryProperties() override { return m_PhysicalDeviceMemoryProperties; }
+        const std::vector<VkQueueFamilyProperties>& GetQueueFamilyProperties() override { return m_QueueFamilyProperties; }
+
+        const std::unordered_set<std::string>& GetEnabledInstanceExtensions() override { return m_Extensions; }
+        const std::unordered_set<std::string>& GetEnabledDeviceExtensions() override { return m_Extensions; }
+
+        const std::unordered_map<VkQueue, VkQueue_Object>& GetDeviceQueues() override { return m_Queues; }
+
+        bool SupportsCustomPerformanceMetricsSets() override { return false; }
+        uint32_t CreateCustomPerformanceMetricsSet( const VkProfilerCustomPerformanceMetricsSetCreateInfoEXT* ) override { return UINT32_MAX; }
+        void DestroyCustomPerformanceMetricsSet( uint32_t ) override {}
+        void UpdateCustomPerformanceMetricsSets( uint32_t, const VkProfilerCustomPerformanceMetricsSetUpdateInfoEXT* ) override {}
+        uint32_t GetPerformanceCounterProperties( uint32_t, VkProfilerPerformanceCounterProperties2EXT* ) override { return 0; }
+        uint32_t GetPerformanceMetricsSets( uint32_t, VkProfilerPerformanceMetricsSetProperties2EXT* ) override { return m_PerformanceMetricsSetCount; }
+        void GetPerformanceMetricsSetProperties( uint32_t, VkProfilerPerformanceMetricsSetProperties2EXT* ) override {}
+        uint32_t GetPerformanceMetricsSetCounterProperties( uint32_t, uint32_t, VkProfilerPerformanceCounterProperties2EXT* ) override { return 0; }
+        uint32_t GetPerformanceCounterRequiredPasses( uint32_t, const uint32_t* ) override { return 0; }
+        void GetAvailablePerformanceCounters( uint32_t, const uint32_t*, uint32_t& availableCounterCount, uint32_t* ) override { availableCounterCount = 0; }
+        VkResult SetPreformanceMetricsSetIndex( uint32_t index ) override { m_PerformanceMetricsSetIndex = index; return VK_SUCCESS; }
+        uint32_t GetPerformanceMetricsSetIndex() override { return m_PerformanceMetricsSetIndex; }
+        VkProfilerPerformanceCountersSamplingModeEXT GetPerformanceCountersSamplingMode() override { return VK_PROFILER_PERFORMANCE_COUNTERS_SAMPLING_MODE_QUERY_EXT; }
+
+        uint64_t GetDeviceCreateTimestamp( VkTimeDomainEXT ) override { return 0; }
+        uint64_t GetHostTimestampFrequency( VkTimeDomainEXT timeDomain ) override { return OSGetTimestampFrequency( timeDomain ); }
+
+        const DeviceProfilerConfig& GetProfilerConfig() override { return m_Config; }
+
+        VkProfilerFrameDelimiterEXT GetProfilerFrameDelimiter() override { return m_FrameDelimiter; }
+        VkResult SetProfilerFrameDelimiter( VkProfilerFrameDelimiterEXT frameDelimiter ) override { m_FrameDelimiter = frameDelimiter; return VK_SUCCESS; }
+
+        VkProfilerModeEXT GetProfilerSamplingMode() override { return m_SamplingMode; }
+        VkResult SetProfilerSamplingMode( VkProfilerModeEXT samplingMode ) override { m_SamplingMode = samplingMode; return VK_SUCCESS; }
+
+        std::string GetObjectName( const VkObject& ) override { return std::string(); }
+        void SetObjectName( const VkObject&, const std::string& ) override {}
+
+        std::shared_ptr<DeviceProfilerFrameData> GetData() override
+        {
+            if( m_Data.empty() )
+            {
+                return nullptr;
+            }
+
+            std::shared_ptr<DeviceProfilerFrameData> pData = std::move( m_Data.front() );
+            m_Data.pop_front();
+            return pData;
+        }
+
+        void SetDataBufferSize( uint32_t ) override {}
+
+        DeviceProfilerConfig m_Config;
+        std::deque<std::shared_ptr<DeviceProfilerFrameData>> m_Data;
+
+        // State changed by the control commands of the outputs.
+        VkProfilerModeEXT m_SamplingMode = VK_PROFILER_MODE_PER_DRAWCALL_EXT;
+        VkProfilerFrameDelimiterEXT m_FrameDelimiter = VK_PROFILER_FRAME_DELIMITER_PRESENT_EXT;
+        uint32_t m_PerformanceMetricsSetCount = 0;
+        uint32_t m_PerformanceMetricsSetIndex = UINT32_MAX;
+
+    private:
+        VkApplicationInfo m_ApplicationInfo = {};
+        VkPhysicalDeviceProperties m_PhysicalDeviceProperties = {};
+        VkPhysicalDeviceMemoryProperties m_PhysicalDeviceMemoryProperties = {};
+        std::vector<VkQueueFamilyProperties> m_QueueFamilyProperties;
+        std::unordered_set<std::string> m_Extensions;
+        std::unordered_map<VkQueue, VkQueue_Object> m_Queues;
+    };
+}
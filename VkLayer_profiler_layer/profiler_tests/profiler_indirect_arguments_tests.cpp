@@ -0,0 +1,292 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "profiler_testing_common.h"
+#include "profiler_vulkan_simple_triangle.h"
+
+#include "profiler/profiler_indirect_arguments.h"
+
+#include <stddef.h>
+#include <string.h>
+
+namespace Profiler
+{
+    class ProfilerIndirectArgumentsULT : public testing::Test
+    {
+    protected:
+        struct CapturedRegion
+        {
+            VkDeviceSize m_Offset;
+            size_t m_Size;
+            uint32_t m_DrawCount;
+            uint32_t m_MaxDrawCount;
+            uint32_t m_Stride;
+        };
+
+        std::vector<CapturedRegion> Regions;
+        std::vector<uint32_t> CaptureData;
+
+        // Captures the arguments of a vkCmdDraw*IndirectCount command in the same layout as the command buffer:
+        // the draw count is followed by maxDrawCount records of stride bytes.
+        void Capture( uint32_t drawCount, uint32_t maxDrawCount, uint32_t stride )
+        {
+            CapturedRegion& region = Regions.emplace_back();
+            region.m_Offset = CaptureData.size() * sizeof( uint32_t );
+            region.m_Size = sizeof( uint32_t ) + static_cast<size_t>( maxDrawCount ) * stride;
+            region.m_DrawCount = drawCount;
+            region.m_MaxDrawCount = maxDrawCount;
+            region.m_Stride = stride;
+
+            CaptureData.push_back( drawCount );
+            for( size_t i = 0; i < ( region.m_Size - sizeof( uint32_t ) ) / sizeof( uint32_t ); ++i )
+            {
+                CaptureData.push_back( static_cast<uint32_t>( ( Regions.size() << 16 ) | i ) );
+            }
+        }
+    };
+
+    TEST_F( ProfilerIndirectArgumentsULT, CompactionRegionLayout )
+    {
+        // The region is passed to the shader in push constants at offsets 0, 4 and 8.
+        EXPECT_EQ( 12u, sizeof( DeviceProfilerIndirectArgumentCompactionRegion ) );
+        EXPECT_EQ( 0u, offsetof( DeviceProfilerIndirectArgumentCompactionRegion, m_Offset ) );
+        EXPECT_EQ( 4u, offsetof( DeviceProfilerIndirectArgumentCompactionRegion, m_MaxDrawCount ) );
+        EXPECT_EQ( 8u, offsetof( DeviceProfilerIndirectArgumentCompactionRegion, m_Stride ) );
+
+        // Offsets and strides are converted from bytes to dwords.
+        const DeviceProfilerIndirectArgumentCompactionRegion region =
+            DeviceProfilerIndirectArgumentCompactor::GetCompactionRegion( 64, 8, sizeof( VkDrawIndexedIndirectCommand ) );
+
+        EXPECT_EQ( 16u, region.m_Offset );
+        EXPECT_EQ( 8u, region.m_MaxDrawCount );
+        EXPECT_EQ( 5u, region.m_Stride );
+    }
+
+    TEST_F( ProfilerIndirectArgumentsULT, CompactedRegionSizeWithoutCompaction )
+    {
+        // Without compaction, the readback buffer holds the full capture with the unclamped count.
+        Capture( 100, 4, sizeof( VkDrawIndirectCommand ) );
+
+        EXPECT_EQ( sizeof( uint32_t ) + 4 * sizeof( VkDrawIndirectCommand ),
+            DeviceProfilerIndirectArgumentCompactor::GetCompactedRegionSize(
+                CaptureData.data(), Regions[ 0 ].m_Size, Regions[ 0 ].m_Stride ) );
+    }
+
+    TEST_F( ProfilerIndirectArgumentsULT, AssembleShader )
+    {
+        std::vector<uint32_t> code;
+        ASSERT_TRUE( DeviceProfilerIndirectArgumentCompactor::AssembleShader( code ) );
+
+        // Header: magic number, version, generator, bound and reserved schema.
+        ASSERT_LT( 5u, code.size() );
+        EXPECT_EQ( 0x07230203u, code[ 0 ] );
+        EXPECT_EQ( 0x00010000u, code[ 1 ] );
+        EXPECT_NE( 0u, code[ 3 ] );
+        EXPECT_EQ( 0u, code[ 4 ] );
+
+        // Each instruction starts with its word count in the high 16 bits,
+        // which must add up to the size of the module.
+        bool entryPointFound = false;
+        size_t offset = 5;
+        while( offset < code.size() )
+        {
+            const uint32_t wordCount = code[ offset ] >> 16;
+            const uint32_t opcode = code[ offset ] & 0xFFFF;
+            ASSERT_NE( 0u, wordCount ) << "word " << offset;
+            ASSERT_LE( offset + wordCount, code.size() ) << "word " << offset;
+
+            // OpEntryPoint GLCompute
+            if( ( opcode == 15 ) && ( wordCount > 1 ) && ( code[ offset + 1 ] == 5 ) )
+            {
+                entryPointFound = true;
+            }
+
+            offset += wordCount;
+        }
+
+        EXPECT_EQ( code.size(), offset );
+        EXPECT_TRUE( entryPointFound );
+    }
+
+    class ProfilerIndirectArgumentsCaptureULT : public ProfilerBaseULT
+    {
+    protected:
+        struct DrawIndirectCountExtension : VulkanExtension
+        {
+            DrawIndirectCountExtension()
+                : VulkanExtension( VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME, false )
+            {
+            }
+        } drawIndirectCountExtension;
+
+        void SetUpVulkan( VulkanState::CreateInfo& createInfo ) override
+        {
+            createInfo.DeviceExtensions.push_back( &drawIndirectCountExtension );
+        }
+
+        // Creates a host-visible buffer and fills it with the data.
+        void CreateBuffer( VkBufferUsageFlags usage, const void* pData, size_t size, VkBuffer* pBuffer, VmaAllocation* pAllocation )
+        {
+            VmaAllocationCreateInfo allocationCreateInfo = {};
+            allocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+            allocationCreateInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+            VkBufferCreateInfo bufferCreateInfo = {};
+            bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            bufferCreateInfo.size = size;
+            bufferCreateInfo.usage = usage;
+
+            VmaAllocationInfo allocationInfo = {};
+            ASSERT_EQ( VK_SUCCESS, vmaCreateBuffer( Vk->Allocator, &bufferCreateInfo, &allocationCreateInfo, pBuffer, pAllocation, &allocationInfo ) );
+            ASSERT_NE( nullptr, allocationInfo.pMappedData );
+
+            memcpy( allocationInfo.pMappedData, pData, size );
+            ASSERT_EQ( VK_SUCCESS, vmaFlushAllocation( Vk->Allocator, *pAllocation, 0, VK_WHOLE_SIZE ) );
+        }
+    };
+
+    TEST_F( ProfilerIndirectArgumentsCaptureULT, CaptureDrawIndirectCount )
+    {
+        SkipIfUnsupported( drawIndirectCountExtension );
+
+        auto pfnCmdDrawIndirectCountKHR = (PFN_vkCmdDrawIndirectCountKHR)vkGetDeviceProcAddr( Vk->Device, "vkCmdDrawIndirectCountKHR" );
+        ASSERT_NE( nullptr, pfnCmdDrawIndirectCountKHR );
+
+        // The compaction pipeline is created with the device when the capture is enabled in the configuration.
+        Prof->m_Config.m_CaptureIndirectArguments = true;
+        ASSERT_EQ( VK_SUCCESS, Prof->m_IndirectArgumentCompactor.Initialize( Prof->m_pDevice ) );
+
+        // Create simple triangle app
+        VulkanSimpleTriangle simpleTriangle( Vk );
+        VkCommandBuffer commandBuffer = {};
+
+        // The second count exceeds the max draw count of its command and must be clamped.
+        const uint32_t drawCounts[ 2 ] = { 2, 10 };
+        const uint32_t maxDrawCounts[ 2 ] = { 4, 3 };
+        const VkDrawIndirectCommand drawCommands[ 4 ] = {
+            { 3, 1, 0, 0 },
+            { 3, 2, 0, 1 },
+            { 3, 3, 0, 3 },
+            { 3, 4, 0, 6 } };
+
+        VkBuffer countBuffer = {};
+        VmaAllocation countBufferAllocation = {};
+        VkBuffer argsBuffer = {};
+        VmaAllocation argsBufferAllocation = {};
+
+        { // Create indirect buffers
+            CreateBuffer( VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, drawCounts, sizeof( drawCounts ), &countBuffer, &countBufferAllocation );
+            CreateBuffer( VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, drawCommands, sizeof( drawCommands ), &argsBuffer, &argsBufferAllocation );
+        }
+        { // Allocate command buffer
+            VkCommandBufferAllocateInfo allocateInfo = {};
+            allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocateInfo.commandBufferCount = 1;
+            allocateInfo.commandPool = Vk->CommandPool;
+            ASSERT_EQ( VK_SUCCESS, vkAllocateCommandBuffers( Vk->Device, &allocateInfo, &commandBuffer ) );
+        }
+        { // Begin command buffer
+            VkCommandBufferBeginInfo beginInfo = {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            ASSERT_EQ( VK_SUCCESS, vkBeginCommandBuffer( commandBuffer, &beginInfo ) );
+        }
+        { // Begin render pass
+            VkRenderPassBeginInfo beginInfo = {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+            beginInfo.renderPass = simpleTriangle.RenderPass;
+            beginInfo.renderArea = simpleTriangle.RenderArea;
+            beginInfo.framebuffer = simpleTriangle.Framebuffer;
+            vkCmdBeginRenderPass( commandBuffer, &beginInfo, VK_SUBPASS_CONTENTS_INLINE );
+        }
+        { // Record commands
+            vkCmdBindPipeline( commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, simpleTriangle.Pipeline );
+            pfnCmdDrawIndirectCountKHR( commandBuffer, argsBuffer, 0, countBuffer, 0, maxDrawCounts[ 0 ], sizeof( VkDrawIndirectCommand ) );
+            pfnCmdDrawIndirectCountKHR( commandBuffer, argsBuffer, 0, countBuffer, sizeof( uint32_t ), maxDrawCounts[ 1 ], sizeof( VkDrawIndirectCommand ) );
+        }
+        { // End render pass
+            vkCmdEndRenderPass( commandBuffer );
+        }
+        { // End command buffer
+            ASSERT_EQ( VK_SUCCESS, vkEndCommandBuffer( commandBuffer ) );
+        }
+        { // Submit command buffer
+            VkSubmitInfo submitInfo = {};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &commandBuffer;
+            ASSERT_EQ( VK_SUCCESS, vkQueueSubmit( Vk->Queue, 1, &submitInfo, VK_NULL_HANDLE ) );
+        }
+        { // Collect data
+            vkDeviceWaitIdle( Vk->Device );
+            Prof->FinishFrame();
+        }
+        { // Validate data
+            std::shared_ptr<DeviceProfilerFrameData> pData = Prof->GetData();
+            ASSERT_NE( nullptr, pData );
+
+            const DeviceProfilerFrameData& data = *pData;
+            ASSERT_EQ( 1, data.m_Submits.size() );
+            ASSERT_EQ( 1, data.m_Submits.front().m_Submits.size() );
+            ASSERT_EQ( 1, data.m_Submits.front().m_Submits.front().m_CommandBuffers.size() );
+
+            const auto& cmdBufferData = *data.m_Submits.front().m_Submits.front().m_CommandBuffers.front();
+            const auto& subpassData = cmdBufferData.m_RenderPasses.front().m_Subpasses.front();
+            const auto& pipelineData = std::get<DeviceProfilerPipelineData>( subpassData.m_Data.front() );
+            ASSERT_EQ( 2, pipelineData.m_Drawcalls.size() );
+
+            // Only the draws below the clamped count are copied to the payload.
+            EXPECT_EQ( 2 * sizeof( uint32_t ) + 5 * sizeof( VkDrawIndirectCommand ), cmdBufferData.m_IndirectPayload.size() );
+
+            for( uint32_t i = 0; i < 2; ++i )
+            {
+                const DeviceProfilerDrawcall& drawcall = pipelineData.m_Drawcalls[ i ];
+                ASSERT_EQ( DeviceProfilerDrawcallType::eDrawIndirectCount, drawcall.m_Type );
+
+                const DeviceProfilerDrawcallDrawIndirectCountPayload& payload = drawcall.m_Payload.m_DrawIndirectCount;
+                ASSERT_LE( payload.m_IndirectCountOffset + sizeof( uint32_t ), cmdBufferData.m_IndirectPayload.size() );
+
+                uint32_t drawCount = 0;
+                memcpy( &drawCount, cmdBufferData.m_IndirectPayload.data() + payload.m_IndirectCountOffset, sizeof( drawCount ) );
+
+                const uint32_t expectedDrawCount = std::min( drawCounts[ i ], maxDrawCounts[ i ] );
+                EXPECT_EQ( expectedDrawCount, drawCount ) << "drawcall " << i;
+
+                ASSERT_LE( payload.m_IndirectArgsOffset + drawCount * sizeof( VkDrawIndirectCommand ), cmdBufferData.m_IndirectPayload.size() );
+                for( uint32_t drawIndex = 0; drawIndex < drawCount; ++drawIndex )
+                {
+                    VkDrawIndirectCommand cmd = {};
+                    memcpy( &cmd,
+                        cmdBufferData.m_IndirectPayload.data() + payload.m_IndirectArgsOffset + drawIndex * payload.m_Stride,
+                        sizeof( cmd ) );
+
+                    EXPECT_EQ( drawCommands[ drawIndex ].vertexCount, cmd.vertexCount ) << "drawcall " << i << ", draw " << drawIndex;
+                    EXPECT_EQ( drawCommands[ drawIndex ].instanceCount, cmd.instanceCount ) << "drawcall " << i << ", draw " << drawIndex;
+                    EXPECT_EQ( drawCommands[ drawIndex ].firstVertex, cmd.firstVertex ) << "drawcall " << i << ", draw " << drawIndex;
+                    EXPECT_EQ( drawCommands[ drawIndex ].firstInstance, cmd.firstInstance ) << "drawcall " << i << ", draw " << drawIndex;
+                }
+            }
+        }
+
+        vmaDestroyBuffer( Vk->Allocator, argsBuffer, argsBufferAllocation );
+        vmaDestroyBuffer( Vk->Allocator, countBuffer, countBufferAllocation );
+    }
+}
@@ -20,6 +20,8 @@
 
 #include "profiler_testing_common.h"
 
+#include "profiler_helpers/profiler_memory_history.h"
+
 namespace Profiler
 {
     class DeviceProfilerMemoryULT : public ProfilerBaseULT
@@ -501,6 +503,104 @@ namespace Profiler
 
     /***********************************************************************************\
 
+    Test:
+        SnapshotInterval
+
+    Description:
+        This test verifies that the state of the frames captured between the memory
+        snapshots is rebuilt from the changes made since the last snapshot.
+
+        The memory event log is enabled and the snapshot is captured every 3 frames.
+        A memory allocation and a buffer are created in the frames sharing the snapshot.
+        The expected result is that the shared snapshot does not contain them, while
+        the state rebuilt for the frame does. Destroyed objects are removed from the
+        rebuilt state.
+
+    \***********************************************************************************/
+    TEST_F( DeviceProfilerMemoryULT, SnapshotInterval )
+    {
+        static constexpr size_t TEST_ALLOCATION_SIZE = 4096; // 4kB
+
+        Prof->m_MemoryTracker.Destroy();
+        Prof->m_Config.m_EnableMemoryEventLog = true;
+        Prof->m_Config.m_MemorySnapshotInterval = 3;
+        ASSERT_EQ( VK_SUCCESS, Prof->m_MemoryTracker.Initialize( Prof->m_pDevice, Prof->m_Config ) );
+
+        VkDeviceMemory deviceMemory = {};
+        VkBuffer buffer = {};
+
+        { // Snapshot frame
+            Prof->FinishFrame();
+
+            std::shared_ptr<DeviceProfilerFrameData> pData = Prof->GetData();
+            EXPECT_EQ( 0, pData->m_Memory.m_SnapshotAge );
+            EXPECT_EQ( nullptr, pData->m_Memory.m_pChanges );
+        }
+
+        { // Allocate memory and create a buffer
+            VkMemoryAllocateInfo allocateInfo = {};
+            allocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+            allocateInfo.memoryTypeIndex = FindMemoryType( VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT );
+            allocateInfo.allocationSize = TEST_ALLOCATION_SIZE;
+            ASSERT_EQ( VK_SUCCESS, vkAllocateMemory( Vk->Device, &allocateInfo, nullptr, &deviceMemory ) );
+
+            VkBufferCreateInfo bufferCreateInfo = {};
+            bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            bufferCreateInfo.size = 1024;
+            bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+            ASSERT_EQ( VK_SUCCESS, vkCreateBuffer( Vk->Device, &bufferCreateInfo, nullptr, &buffer ) );
+        }
+
+        const VkDeviceMemoryHandle memoryHandle = Prof->GetObjectHandle( VkDeviceMemoryHandle( deviceMemory ) );
+        const VkBufferHandle bufferHandle = Prof->GetObjectHandle( VkBufferHandle( buffer ) );
+
+        { // Frame sharing the snapshot
+            Prof->FinishFrame();
+
+            std::shared_ptr<DeviceProfilerFrameData> pData = Prof->GetData();
+            EXPECT_EQ( 1, pData->m_Memory.m_SnapshotAge );
+            ASSERT_NE( nullptr, pData->m_Memory.m_pChanges );
+            EXPECT_EQ( 0, pData->m_Memory.m_pSnapshot->m_Allocations.count( memoryHandle ) );
+            EXPECT_EQ( 0, pData->m_Memory.m_pSnapshot->m_Buffers.count( bufferHandle ) );
+
+            std::shared_ptr<const DeviceProfilerMemorySnapshotData> pSnapshot =
+                DeviceProfilerMemoryHistory::GetFrameSnapshot( pData->m_Memory );
+            ASSERT_NE( nullptr, pSnapshot );
+            ASSERT_EQ( 1, pSnapshot->m_Allocations.count( memoryHandle ) );
+            EXPECT_EQ( TEST_ALLOCATION_SIZE, pSnapshot->m_Allocations.at( memoryHandle ).m_Size );
+            EXPECT_EQ( 1, pSnapshot->m_Buffers.count( bufferHandle ) );
+        }
+
+        vkDestroyBuffer( Vk->Device, buffer, nullptr );
+
+        { // Changes of the previous frames are preserved
+            Prof->FinishFrame();
+
+            std::shared_ptr<DeviceProfilerFrameData> pData = Prof->GetData();
+            EXPECT_EQ( 2, pData->m_Memory.m_SnapshotAge );
+            ASSERT_NE( nullptr, pData->m_Memory.m_pChanges );
+
+            std::shared_ptr<const DeviceProfilerMemorySnapshotData> pSnapshot =
+                DeviceProfilerMemoryHistory::GetFrameSnapshot( pData->m_Memory );
+            ASSERT_NE( nullptr, pSnapshot );
+            EXPECT_EQ( 1, pSnapshot->m_Allocations.count( memoryHandle ) );
+            EXPECT_EQ( 0, pSnapshot->m_Buffers.count( bufferHandle ) );
+        }
+
+        { // Next snapshot
+            Prof->FinishFrame();
+
+            std::shared_ptr<DeviceProfilerFrameData> pData = Prof->GetData();
+            EXPECT_EQ( 0, pData->m_Memory.m_SnapshotAge );
+            EXPECT_EQ( nullptr, pData->m_Memory.m_pChanges );
+            EXPECT_EQ( 1, pData->m_Memory.m_pSnapshot->m_Allocations.count( memoryHandle ) );
+        }
+
+        vkFreeMemory( Vk->Device, deviceMemory, nullptr );
+    }
+
+    /***********************************************************************************\
+
     Test:
         SparseBinding_Simple
 
@@ -530,7 +630,7 @@ namespace Profiler
             Prof->FinishFrame();
 
             std::shared_ptr<DeviceProfilerFrameData> pData = Prof->GetData();
-            const DeviceProfilerBufferMemoryData& bufferData = pData->m_Memory.m_Buffers.at( Prof->GetObjectHandle( VkBufferHandle( buffer ) ) );
+            const DeviceProfilerBufferMemoryData& bufferData = pData->m_Memory.m_pSnapshot->m_Buffers.at( Prof->GetObjectHandle( VkBufferHandle( buffer ) ) );
 
             ASSERT_EQ( 1, bufferData.GetMemoryBindingCount() );
 
@@ -583,7 +683,7 @@ namespace Profiler
             Prof->FinishFrame();
 
             std::shared_ptr<DeviceProfilerFrameData> pData = Prof->GetData();
-            const DeviceProfilerBufferMemoryData& bufferData = pData->m_Memory.m_Buffers.at( Prof->GetObjectHandle( VkBufferHandle( buffer ) ) );
+            const DeviceProfilerBufferMemoryData& bufferData = pData->m_Memory.m_pSnapshot->m_Buffers.at( Prof->GetObjectHandle( VkBufferHandle( buffer ) ) );
 
             EXPECT_EQ( 0, bufferData.GetMemoryBindingCount() );
         }
@@ -633,7 +733,7 @@ namespace Profiler
             Prof->FinishFrame();
 
             std::shared_ptr<DeviceProfilerFrameData> pData = Prof->GetData();
-            const DeviceProfilerBufferMemoryData& bufferData = pData->m_Memory.m_Buffers.at( Prof->GetObjectHandle( VkBufferHandle( buffer ) ) );
+            const DeviceProfilerBufferMemoryData& bufferData = pData->m_Memory.m_pSnapshot->m_Buffers.at( Prof->GetObjectHandle( VkBufferHandle( buffer ) ) );
 
             ASSERT_EQ( 1, bufferData.GetMemoryBindingCount() );
 
@@ -689,7 +789,7 @@ namespace Profiler
             Prof->FinishFrame();
 
             std::shared_ptr<DeviceProfilerFrameData> pData = Prof->GetData();
-            const DeviceProfilerBufferMemoryData& bufferData = pData->m_Memory.m_Buffers.at( Prof->GetObjectHandle( VkBufferHandle( buffer ) ) );
+            const DeviceProfilerBufferMemoryData& bufferData = pData->m_Memory.m_pSnapshot->m_Buffers.at( Prof->GetObjectHandle( VkBufferHandle( buffer ) ) );
 
             ASSERT_EQ( 1, bufferData.GetMemoryBindingCount() );
 
@@ -747,7 +847,7 @@ namespace Profiler
             Prof->FinishFrame();
 
             std::shared_ptr<DeviceProfilerFrameData> pData = Prof->GetData();
-            const DeviceProfilerBufferMemoryData& bufferData = pData->m_Memory.m_Buffers.at( Prof->GetObjectHandle( VkBufferHandle( buffer ) ) );
+            const DeviceProfilerBufferMemoryData& bufferData = pData->m_Memory.m_pSnapshot->m_Buffers.at( Prof->GetObjectHandle( VkBufferHandle( buffer ) ) );
 
             ASSERT_EQ( 2, bufferData.GetMemoryBindingCount() );
 
@@ -824,7 +924,7 @@ namespace Profiler
             Prof->FinishFrame();
 
             std::shared_ptr<DeviceProfilerFrameData> pData = Prof->GetData();
-            const DeviceProfilerBufferMemoryData& bufferData = pData->m_Memory.m_Buffers.at( Prof->GetObjectHandle( VkBufferHandle( buffer ) ) );
+            const DeviceProfilerBufferMemoryData& bufferData = pData->m_Memory.m_pSnapshot->m_Buffers.at( Prof->GetObjectHandle( VkBufferHandle( buffer ) ) );
 
             ASSERT_EQ( count - 2, bufferData.GetMemoryBindingCount() );
 
@@ -0,0 +1,429 @@
+// Copyright (c) 2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "profiler_testing_common.h"
+#include "profiler_frontend_stub.h"
+
+#include "profiler_overlay/profiler_overlay.h"
+#include "profiler_overlay/profiler_overlay_layer_backend.h"
+#include "profiler_overlay/profiler_overlay_lru_cache.h"
+#include "profiler_overlay/profiler_overlay_refresh_limiter.h"
+
+#include <imgui.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Profiler
+{
+    class ProfilerOverlayULT : public testing::Test
+    {
+    protected:
+        using Clock = OverlayRefreshLimiter::Clock;
+
+        static constexpr int RefreshRate = 10;
+        static constexpr std::chrono::milliseconds RefreshPeriod = std::chrono::milliseconds( 100 );
+
+        ImVec2 DisplaySize = ImVec2( 1920, 1080 );
+        ImDrawData DrawData;
+
+        Clock::time_point Start;
+
+        void SetUp() override
+        {
+            DrawData.Valid = true;
+            DrawData.DisplaySize = DisplaySize;
+
+            // Arbitrary point far enough from the epoch of the clock.
+            Start = Clock::time_point( std::chrono::hours( 1 ) );
+        }
+
+        // Validates the module and returns the execution model of its only entry point.
+        static uint32_t GetEntryPointExecutionModel( const std::vector<uint32_t>& code )
+        {
+            uint32_t executionModel = UINT32_MAX;
+
+            // Header: magic number, version, generator, bound and reserved schema.
+            EXPECT_LT( 5u, code.size() );
+            EXPECT_EQ( 0x07230203u, code[ 0 ] );
+            EXPECT_NE( 0u, code[ 3 ] );
+
+            size_t offset = 5;
+            while( offset < code.size() )
+            {
+                const uint32_t wordCount = code[ offset ] >> 16;
+                const uint32_t opcode = code[ offset ] & 0xFFFF;
+                if( ( wordCount == 0 ) || ( offset + wordCount > code.size() ) )
+                {
+                    ADD_FAILURE() << "Invalid instruction at word " << offset;
+                    break;
+                }
+
+                // OpEntryPoint
+                if( ( opcode == 15 ) && ( wordCount > 1 ) )
+                {
+                    EXPECT_EQ( UINT32_MAX, executionModel );
+                    executionModel = code[ offset + 1 ];
+                }
+
+                offset += wordCount;
+            }
+
+            EXPECT_EQ( code.size(), offset );
+            return executionModel;
+        }
+    };
+
+    TEST_F( ProfilerOverlayULT, RefreshNotLimitedByDefault )
+    {
+        OverlayRefreshLimiter limiter;
+        EXPECT_FALSE( limiter.IsEnabled() );
+
+        // The UI is rebuilt in every frame.
+        EXPECT_TRUE( limiter.IsRefreshRequired( &DrawData, DisplaySize, false, Start ) );
+        EXPECT_TRUE( limiter.IsRefreshRequired( &DrawData, DisplaySize, false, Start ) );
+        EXPECT_TRUE( limiter.IsRefreshRequired( &DrawData, DisplaySize, false, Start + std::chrono::milliseconds( 1 ) ) );
+    }
+
+    TEST_F( ProfilerOverlayULT, RefreshLimited )
+    {
+        OverlayRefreshLimiter limiter;
+        limiter.SetRefreshRate( RefreshRate );
+        EXPECT_TRUE( limiter.IsEnabled() );
+
+        // The first frame is always built.
+        EXPECT_TRUE( limiter.IsRefreshRequired( &DrawData, DisplaySize, false, Start ) );
+
+        // The cached frame is reused until the refresh period elapses.
+        EXPECT_FALSE( limiter.IsRefreshRequired( &DrawData, DisplaySize, false, Start + std::chrono::milliseconds( 1 ) ) );
+        EXPECT_FALSE( limiter.IsRefreshRequired( &DrawData, DisplaySize, false, Start + RefreshPeriod - std::chrono::milliseconds( 1 ) ) );
+        EXPECT_TRUE( limiter.IsRefreshRequired( &DrawData, DisplaySize, false, Start + RefreshPeriod ) );
+
+        // The period is measured from the last refresh.
+        EXPECT_FALSE( limiter.IsRefreshRequired( &DrawData, DisplaySize, false, Start + RefreshPeriod + std::chrono::milliseconds( 1 ) ) );
+        EXPECT_TRUE( limiter.IsRefreshRequired( &DrawData, DisplaySize, false, Start + 2 * RefreshPeriod ) );
+    }
+
+    TEST_F( ProfilerOverlayULT, RefreshAfterInput )
+    {
+        OverlayRefreshLimiter limiter;
+        limiter.SetRefreshRate( RefreshRate );
+
+        EXPECT_TRUE( limiter.IsRefreshRequired( &DrawData, DisplaySize, false, Start ) );
+        EXPECT_FALSE( limiter.IsRefreshRequired( &DrawData, DisplaySize, false, Start + std::chrono::milliseconds( 1 ) ) );
+
+        // Pending input events rebuild the UI immediately and restart the period.
+        EXPECT_TRUE( limiter.IsRefreshRequired( &DrawData, DisplaySize, true, Start + std::chrono::milliseconds( 2 ) ) );
+        EXPECT_FALSE( limiter.IsRefreshRequired( &DrawData, DisplaySize, false, Start + RefreshPeriod ) );
+        EXPECT_TRUE( limiter.IsRefreshRequired( &DrawData, DisplaySize, false, Start + RefreshPeriod + std::chrono::milliseconds( 2 ) ) );
+    }
+
+    TEST_F( ProfilerOverlayULT, RefreshAfterResize )
+    {
+        OverlayRefreshLimiter limiter;
+        limiter.SetRefreshRate( RefreshRate );
+
+        EXPECT_TRUE( limiter.IsRefreshRequired( &DrawData, DisplaySize, false, Start ) );
+
+        // The cached frame doesn't match the new size of the render area.
+        const ImVec2 resizedDisplaySize( 1280, 720 );
+        EXPECT_TRUE( limiter.IsRefreshRequired( &DrawData, resizedDisplaySize, false, Start + std::chrono::milliseconds( 1 ) ) );
+
+        DrawData.DisplaySize = resizedDisplaySize;
+        EXPECT_FALSE( limiter.IsRefreshRequired( &DrawData, resizedDisplaySize, false, Start + std::chrono::milliseconds( 2 ) ) );
+    }
+
+    TEST_F( ProfilerOverlayULT, RefreshWithoutDrawData )
+    {
+        OverlayRefreshLimiter limiter;
+        limiter.SetRefreshRate( RefreshRate );
+
+        EXPECT_TRUE( limiter.IsRefreshRequired( &DrawData, DisplaySize, false, Start ) );
+
+        // There is no frame to render from the cache.
+        EXPECT_TRUE( limiter.IsRefreshRequired( nullptr, DisplaySize, false, Start + std::chrono::milliseconds( 1 ) ) );
+
+        DrawData.Valid = false;
+        EXPECT_TRUE( limiter.IsRefreshRequired( &DrawData, DisplaySize, false, Start + std::chrono::milliseconds( 2 ) ) );
+    }
+
+    TEST_F( ProfilerOverlayULT, DisableRefreshLimit )
+    {
+        OverlayRefreshLimiter limiter;
+        limiter.SetRefreshRate( RefreshRate );
+
+        EXPECT_TRUE( limiter.IsRefreshRequired( &DrawData, DisplaySize, false, Start ) );
+        EXPECT_FALSE( limiter.IsRefreshRequired( &DrawData, DisplaySize, false, Start + std::chrono::milliseconds( 1 ) ) );
+
+        limiter.SetRefreshRate( 0 );
+        EXPECT_FALSE( limiter.IsEnabled() );
+        EXPECT_TRUE( limiter.IsRefreshRequired( &DrawData, DisplaySize, false, Start + std::chrono::milliseconds( 2 ) ) );
+    }
+
+    TEST_F( ProfilerOverlayULT, AssembleCompositeShaders )
+    {
+        std::vector<uint32_t> vertexShader;
+        std::vector<uint32_t> fragmentShader;
+        ASSERT_TRUE( OverlayLayerBackend::AssembleCompositeShaders( vertexShader, fragmentShader ) );
+
+        // ExecutionModel Vertex and Fragment
+        EXPECT_EQ( 0u, GetEntryPointExecutionModel( vertexShader ) );
+        EXPECT_EQ( 4u, GetEntryPointExecutionModel( fragmentShader ) );
+    }
+
+    TEST_F( ProfilerOverlayULT, LruCacheHit )
+    {
+        OverlayLruCache<int, int> cache( 100 );
+        EXPECT_EQ( nullptr, cache.Find( 1 ) );
+
+        auto pValue = std::make_shared<int>( 10 );
+        cache.Insert( 1, pValue );
+        cache.SetSize( 1, pValue.get(), 40 );
+
+        EXPECT_EQ( pValue, cache.Find( 1 ) );
+        EXPECT_EQ( 1, cache.GetCount() );
+        EXPECT_EQ( 40, cache.GetSize() );
+    }
+
+    TEST_F( ProfilerOverlayULT, LruCacheEvictsLeastRecentlyUsed )
+    {
+        OverlayLruCache<int, int> cache( 100 );
+
+        auto Insert = [&]( int key, size_t size )
+        {
+            auto pValue = std::make_shared<int>( key );
+            cache.Insert( key, pValue );
+            cache.SetSize( key, pValue.get(), size );
+        };
+
+        Insert( 1, 40 );
+        Insert( 2, 40 );
+
+        // Using the first entry makes the second one the least recently used.
+        EXPECT_NE( nullptr, cache.Find( 1 ) );
+
+        Insert( 3, 40 );
+        EXPECT_EQ( 2, cache.GetCount() );
+        EXPECT_EQ( 80, cache.GetSize() );
+        EXPECT_NE( nullptr, cache.Find( 1 ) );
+        EXPECT_EQ( nullptr, cache.Find( 2 ) );
+        EXPECT_NE( nullptr, cache.Find( 3 ) );
+
+        // The most recently used entry is kept even if it exceeds the limit alone.
+        Insert( 4, 200 );
+        EXPECT_EQ( 1, cache.GetCount() );
+        EXPECT_EQ( 200, cache.GetSize() );
+        EXPECT_NE( nullptr, cache.Find( 4 ) );
+    }
+
+    TEST_F( ProfilerOverlayULT, LruCachePendingEntries )
+    {
+        OverlayLruCache<int, int> cache( 100 );
+
+        // Entries are not accounted until their size is set.
+        auto pPending = std::make_shared<int>( 1 );
+        cache.Insert( 1, pPending );
+        EXPECT_EQ( 0, cache.GetSize() );
+
+        auto pValue = std::make_shared<int>( 2 );
+        cache.Insert( 2, pValue );
+        cache.SetSize( 2, pValue.get(), 150 );
+
+        // The pending entry is evicted before it completes.
+        EXPECT_EQ( 1, cache.GetCount() );
+        EXPECT_EQ( nullptr, cache.Find( 1 ) );
+
+        // Completing the evicted entry doesn't change the size of the cache.
+        cache.SetSize( 1, pPending.get(), 50 );
+        EXPECT_EQ( 150, cache.GetSize() );
+
+        // Neither does completing an entry replaced by another value with the same key.
+        // The replacement is the most recently used entry, so the other one is evicted.
+        auto pReplacement = std::make_shared<int>( 1 );
+        cache.Insert( 1, pReplacement );
+        cache.SetSize( 1, pPending.get(), 50 );
+        EXPECT_EQ( 0, cache.GetSize() );
+        EXPECT_EQ( 1, cache.GetCount() );
+        EXPECT_EQ( pReplacement, cache.Find( 1 ) );
+    }
+
+    class ProfilerOverlayThreadedUIULT : public testing::Test
+    {
+    protected:
+        // Backend recording the threads that use it.
+        class OverlayBackendMock : public OverlayBackend
+        {
+        public:
+            std::mutex Mutex;
+            std::condition_variable Condition;
+
+            std::thread::id NewFrameThreadId;
+            std::thread::id RecordThreadId;
+            std::thread::id SubmitThreadId;
+
+            uint32_t RecordedFrameCount = 0;
+            uint32_t SubmittedFrameCount = 0;
+            uint32_t RenderDrawDataCount = 0;
+            uint64_t ImageCount = 0;
+
+            // Simulates a UI thread that is slower than the application.
+            bool BlockRecording = false;
+
+            bool PrepareImGuiBackend() override { return true; }
+            void DestroyImGuiBackend() override {}
+
+            bool NewFrame() override
+            {
+                std::scoped_lock lk( Mutex );
+                NewFrameThreadId = std::this_thread::get_id();
+                return true;
+            }
+
+            void RenderDrawData( ImDrawData* ) override
+            {
+                std::scoped_lock lk( Mutex );
+                RenderDrawDataCount++;
+            }
+
+            bool RecordDrawData( ImDrawData* pDrawData ) override
+            {
+                std::unique_lock lk( Mutex );
+                EXPECT_NE( nullptr, ImGui::GetCurrentContext() );
+                EXPECT_NE( nullptr, pDrawData );
+
+                RecordThreadId = std::this_thread::get_id();
+                RecordedFrameCount++;
+                Condition.notify_all();
+
+                Condition.wait( lk, [this]() { return !BlockRecording; } );
+                return true;
+            }
+
+            void SubmitRecordedDrawData() override
+            {
+                std::scoped_lock lk( Mutex );
+                SubmitThreadId = std::this_thread::get_id();
+                SubmittedFrameCount++;
+            }
+
+            float GetDPIScale() const override { return 1.0f; }
+            ImVec2 GetRenderArea() const override { return ImVec2( 1280, 720 ); }
+
+            uint64_t CreateImage( int, int, const void* ) override { return ++ImageCount; }
+            void DestroyImage( uint64_t ) override {}
+
+            void CreateFontsImage() override
+            {
+                // Build the font atlas like the renderer backend does.
+                unsigned char* pPixels = nullptr;
+                int width = 0, height = 0;
+                ImGui::GetIO().Fonts->GetTexDataAsRGBA32( &pPixels, &width, &height );
+            }
+
+            void DestroyFontsImage() override {}
+
+            bool WaitForRecordedFrames( uint32_t frameCount )
+            {
+                std::unique_lock lk( Mutex );
+                return Condition.wait_for( lk, std::chrono::seconds( 5 ),
+                    [&]() { return RecordedFrameCount >= frameCount; } );
+            }
+
+            void SetBlockRecording( bool block )
+            {
+                {
+                    std::scoped_lock lk( Mutex );
+                    BlockRecording = block;
+                }
+
+                Condition.notify_all();
+            }
+        };
+
+        DeviceProfilerFrontendStub Frontend;
+        OverlayBackendMock Backend;
+        std::unique_ptr<ProfilerOverlayOutput> pOverlay;
+
+        void SetUp() override
+        {
+            Frontend.m_Config.m_OverlayThreadedUi = true;
+
+            pOverlay = std::make_unique<ProfilerOverlayOutput>( Frontend, Backend );
+            ASSERT_TRUE( pOverlay->Initialize() );
+
+            // The UI thread consumes the data before building the first frame.
+            Frontend.m_Data.push_back( std::make_shared<DeviceProfilerFrameData>() );
+            pOverlay->Update();
+        }
+
+        void TearDown() override
+        {
+            Backend.SetBlockRecording( false );
+
+            if( pOverlay )
+            {
+                pOverlay->Destroy();
+                pOverlay.reset();
+            }
+        }
+    };
+
+    TEST_F( ProfilerOverlayThreadedUIULT, RecordOnUIThread )
+    {
+        // The first present requests the first frame from the UI thread.
+        pOverlay->Present();
+        ASSERT_TRUE( Backend.WaitForRecordedFrames( 1 ) );
+
+        // The refresh limiter may skip the next frames, but the latest recorded one is still submitted.
+        pOverlay->Present();
+
+        std::scoped_lock lk( Backend.Mutex );
+        EXPECT_EQ( 2, Backend.SubmittedFrameCount );
+        EXPECT_EQ( 0, Backend.RenderDrawDataCount );
+
+        // The ImGui context is used only by the UI thread, the present thread only submits the recorded frames.
+        EXPECT_EQ( std::this_thread::get_id(), Backend.SubmitThreadId );
+        EXPECT_NE( std::this_thread::get_id(), Backend.RecordThreadId );
+        EXPECT_EQ( Backend.RecordThreadId, Backend.NewFrameThreadId );
+    }
+
+    TEST_F( ProfilerOverlayThreadedUIULT, PresentDoesNotWaitForUIThread )
+    {
+        Backend.SetBlockRecording( true );
+
+        pOverlay->Present();
+        ASSERT_TRUE( Backend.WaitForRecordedFrames( 1 ) );
+
+        // The UI thread is blocked while it holds the ImGui mutex.
+        auto present = std::async( std::launch::async, [&]() { pOverlay->Present(); } );
+        EXPECT_EQ( std::future_status::ready, present.wait_for( std::chrono::seconds( 5 ) ) );
+
+        Backend.SetBlockRecording( false );
+        present.wait();
+
+        std::scoped_lock lk( Backend.Mutex );
+        EXPECT_EQ( 2, Backend.SubmittedFrameCount );
+    }
+}
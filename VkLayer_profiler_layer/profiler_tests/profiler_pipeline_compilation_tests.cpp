@@ -0,0 +1,249 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "profiler_testing_common.h"
+#include "profiler_vulkan_simple_triangle.h"
+#include "profiler_vulkan_simple_triangle_rt.h"
+
+namespace Profiler
+{
+    class ProfilerPipelineCompilationULT : public ProfilerBaseULT
+    {
+    protected:
+        VulkanExtension pipelineCreationFeedbackExtension { VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME, false };
+
+        void SetUpVulkan( VulkanState::CreateInfo& createInfo ) override
+        {
+            createInfo.DeviceExtensions.push_back( &pipelineCreationFeedbackExtension );
+        }
+
+        std::shared_ptr<DeviceProfilerFrameData> FinishFrame()
+        {
+            Prof->FinishFrame();
+            return Prof->GetData();
+        }
+
+        static const DeviceProfilerPipelineCompilationData* FindCompilation( const DeviceProfilerFrameData& frameData, VkPipeline pipeline )
+        {
+            for( const DeviceProfilerPipelineCompilationData& compilation : frameData.m_PipelineCompilations )
+            {
+                for( const DeviceProfilerPipelineCreationFeedbackData& pipelineData : compilation.m_Pipelines )
+                {
+                    if( pipeline == pipelineData.m_Pipeline.m_Handle )
+                    {
+                        return &compilation;
+                    }
+                }
+            }
+
+            return nullptr;
+        }
+
+        static uint64_t GetCompilationTicks( const DeviceProfilerPipelineCompilationData& compilation )
+        {
+            return compilation.m_EndTimestamp - compilation.m_BeginTimestamp;
+        }
+    };
+
+    class ProfilerPipelineCompilationRTULT : public ProfilerPipelineCompilationULT
+    {
+    protected:
+        void SetUpVulkan( VulkanState::CreateInfo& createInfo ) override
+        {
+            ProfilerPipelineCompilationULT::SetUpVulkan( createInfo );
+            VulkanSimpleTriangleRT::ConfigureVulkan( createInfo );
+        }
+    };
+
+    TEST_F( ProfilerPipelineCompilationULT, CollectGraphicsPipelineCompilation )
+    {
+        VulkanSimpleTriangle simpleTriangle( Vk );
+
+        std::shared_ptr<DeviceProfilerFrameData> pFrameData = FinishFrame();
+        ASSERT_NE( nullptr, pFrameData );
+
+        const DeviceProfilerPipelineCompilationData* pCompilation = FindCompilation( *pFrameData, simpleTriangle.Pipeline );
+        ASSERT_NE( nullptr, pCompilation );
+
+        EXPECT_EQ( ProfilerPlatformFunctions::GetCurrentThreadId(), pCompilation->m_ThreadId );
+        EXPECT_FALSE( pCompilation->m_Deferred );
+        EXPECT_LE( pCompilation->m_BeginTimestamp, pCompilation->m_EndTimestamp );
+        EXPECT_LE( pCompilation->m_EndTimestamp, pFrameData->m_CPU.m_EndTimestamp );
+        EXPECT_GE( pFrameData->m_PipelineCompilationTicks, GetCompilationTicks( *pCompilation ) );
+
+        ASSERT_EQ( 1u, pCompilation->m_Pipelines.size() );
+        const DeviceProfilerPipelineCreationFeedbackData& pipelineData = pCompilation->m_Pipelines.front();
+
+        if( !Prof->ShouldCapturePipelineCreationFeedback() )
+        {
+            EXPECT_FALSE( pipelineData.HasFeedback() );
+            EXPECT_TRUE( pipelineData.m_Stages.empty() );
+        }
+
+        // Stage feedback is stored only for the valid stages, in the order of the create info.
+        EXPECT_LE( pipelineData.m_Stages.size(), 2u );
+        for( size_t i = 0; i < pipelineData.m_Stages.size(); ++i )
+        {
+            EXPECT_TRUE( pipelineData.m_Stages[ i ].m_Flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT );
+            EXPECT_TRUE( ( pipelineData.m_Stages[ i ].m_Stage == VK_SHADER_STAGE_VERTEX_BIT ) ||
+                ( pipelineData.m_Stages[ i ].m_Stage == VK_SHADER_STAGE_FRAGMENT_BIT ) );
+        }
+
+        // The compilation is reported only once.
+        pFrameData = FinishFrame();
+        ASSERT_NE( nullptr, pFrameData );
+        EXPECT_EQ( nullptr, FindCompilation( *pFrameData, simpleTriangle.Pipeline ) );
+    }
+
+    TEST_F( ProfilerPipelineCompilationULT, ReadApplicationCreationFeedback )
+    {
+        SkipIfUnsupported( pipelineCreationFeedbackExtension );
+
+        VkPipelineCreationFeedback pipelineFeedback = {};
+        VkPipelineCreationFeedback stageFeedbacks[ 2 ] = {};
+
+        VkPipelineCreationFeedbackCreateInfo feedbackCreateInfo = {};
+        feedbackCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO;
+        feedbackCreateInfo.pPipelineCreationFeedback = &pipelineFeedback;
+        feedbackCreateInfo.pipelineStageCreationFeedbackCount = 2;
+        feedbackCreateInfo.pPipelineStageCreationFeedbacks = stageFeedbacks;
+
+        VulkanSimpleTriangle simpleTriangle( Vk, &feedbackCreateInfo );
+
+        std::shared_ptr<DeviceProfilerFrameData> pFrameData = FinishFrame();
+        ASSERT_NE( nullptr, pFrameData );
+
+        const DeviceProfilerPipelineCompilationData* pCompilation = FindCompilation( *pFrameData, simpleTriangle.Pipeline );
+        ASSERT_NE( nullptr, pCompilation );
+        ASSERT_EQ( 1u, pCompilation->m_Pipelines.size() );
+
+        // The feedback chained by the application is read instead of being replaced.
+        const DeviceProfilerPipelineCreationFeedbackData& pipelineData = pCompilation->m_Pipelines.front();
+        EXPECT_EQ( pipelineFeedback.flags, pipelineData.m_Flags );
+        EXPECT_EQ( pipelineFeedback.duration, pipelineData.m_Duration );
+
+        size_t validStageCount = 0;
+        for( const VkPipelineCreationFeedback& stageFeedback : stageFeedbacks )
+        {
+            if( stageFeedback.flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT )
+            {
+                ASSERT_LT( validStageCount, pipelineData.m_Stages.size() );
+                EXPECT_EQ( stageFeedback.flags, pipelineData.m_Stages[ validStageCount ].m_Flags );
+                EXPECT_EQ( stageFeedback.duration, pipelineData.m_Stages[ validStageCount ].m_Duration );
+                validStageCount++;
+            }
+        }
+
+        EXPECT_EQ( validStageCount, pipelineData.m_Stages.size() );
+    }
+
+    TEST_F( ProfilerPipelineCompilationULT, CollectCompilationsOutOfOrder )
+    {
+        // Compilation on another thread that has not completed before the end of the frame.
+        DeviceProfilerPipelineCompilationData pendingCompilation;
+        pendingCompilation.m_BeginTimestamp = Prof->m_CpuTimestampCounter.GetCurrentValue();
+        pendingCompilation.m_EndTimestamp = UINT64_MAX;
+        Prof->CreatePipelines( 0, static_cast<const VkComputePipelineCreateInfo*>( nullptr ), nullptr, pendingCompilation );
+
+        // Compilation that completed in this frame must not wait for the previous one.
+        DeviceProfilerPipelineCompilationData completedCompilation;
+        completedCompilation.m_BeginTimestamp = Prof->m_CpuTimestampCounter.GetCurrentValue();
+        completedCompilation.m_EndTimestamp = Prof->m_CpuTimestampCounter.GetCurrentValue();
+        Prof->CreatePipelines( 0, static_cast<const VkComputePipelineCreateInfo*>( nullptr ), nullptr, completedCompilation );
+
+        std::shared_ptr<DeviceProfilerFrameData> pFrameData = FinishFrame();
+        ASSERT_NE( nullptr, pFrameData );
+        ASSERT_EQ( 1u, pFrameData->m_PipelineCompilations.size() );
+        EXPECT_EQ( completedCompilation.m_EndTimestamp, pFrameData->m_PipelineCompilations.front().m_EndTimestamp );
+        EXPECT_EQ( GetCompilationTicks( completedCompilation ), pFrameData->m_PipelineCompilationTicks );
+    }
+
+    TEST_F( ProfilerPipelineCompilationULT, CollectDeferredCompilationInLaterFrame )
+    {
+        // Same sequence as in vkCreateRayTracingPipelinesKHR with a deferred operation,
+        // without the dependency on the ray tracing support.
+        const VkDeferredOperationKHR deferredOperation = (VkDeferredOperationKHR)(uintptr_t)0x1000;
+        Prof->CreateDeferredOperation( deferredOperation );
+
+        DeviceProfilerPipelineCompilationData compilation;
+        compilation.m_ThreadId = ProfilerPlatformFunctions::GetCurrentThreadId();
+        compilation.m_BeginTimestamp = Prof->m_CpuTimestampCounter.GetCurrentValue();
+
+        DeviceProfiler* pProfiler = Prof;
+        Prof->SetDeferredOperationCallback( deferredOperation,
+            [pProfiler, compilation]( VkDeferredOperationKHR ) mutable {
+                compilation.m_EndTimestamp = pProfiler->m_CpuTimestampCounter.GetCurrentValue();
+                compilation.m_Deferred = true;
+                pProfiler->CreatePipelines( 0, static_cast<const VkRayTracingPipelineCreateInfoKHR*>( nullptr ), nullptr, compilation, true /*deferred*/ );
+            } );
+
+        // The operation has not been joined before the end of the first frame.
+        std::shared_ptr<DeviceProfilerFrameData> pFirstFrameData = FinishFrame();
+        ASSERT_NE( nullptr, pFirstFrameData );
+        EXPECT_TRUE( pFirstFrameData->m_PipelineCompilations.empty() );
+        EXPECT_EQ( 0u, pFirstFrameData->m_PipelineCompilationTicks );
+
+        Prof->ExecuteDeferredOperationCallback( deferredOperation );
+        Prof->DestroyDeferredOperation( deferredOperation );
+
+        // The compilation is assigned to the frame in which it has been joined.
+        std::shared_ptr<DeviceProfilerFrameData> pSecondFrameData = FinishFrame();
+        ASSERT_NE( nullptr, pSecondFrameData );
+        ASSERT_EQ( 1u, pSecondFrameData->m_PipelineCompilations.size() );
+
+        const DeviceProfilerPipelineCompilationData& deferredCompilation = pSecondFrameData->m_PipelineCompilations.front();
+        EXPECT_TRUE( deferredCompilation.m_Deferred );
+        EXPECT_LT( deferredCompilation.m_BeginTimestamp, pFirstFrameData->m_CPU.m_EndTimestamp );
+        EXPECT_GT( deferredCompilation.m_EndTimestamp, pFirstFrameData->m_CPU.m_EndTimestamp );
+        EXPECT_LE( deferredCompilation.m_EndTimestamp, pSecondFrameData->m_CPU.m_EndTimestamp );
+        EXPECT_EQ( GetCompilationTicks( deferredCompilation ), pSecondFrameData->m_PipelineCompilationTicks );
+    }
+
+    TEST_F( ProfilerPipelineCompilationRTULT, CollectDeferredRayTracingPipelineCompilation )
+    {
+        VulkanSimpleTriangleRT simpleTriangle( Vk );
+        VkDeferredOperationKHR deferredOperation = simpleTriangle.CreatePipelineDeferred();
+
+        std::shared_ptr<DeviceProfilerFrameData> pFirstFrameData = FinishFrame();
+        ASSERT_NE( nullptr, pFirstFrameData );
+
+        if( !pFirstFrameData->m_PipelineCompilations.empty() )
+        {
+            // The driver may complete the operation immediately (VK_OPERATION_NOT_DEFERRED_KHR).
+            simpleTriangle.JoinDeferredOperation( deferredOperation );
+            GTEST_SKIP() << "Pipeline creation has not been deferred";
+        }
+
+        simpleTriangle.JoinDeferredOperation( deferredOperation );
+
+        std::shared_ptr<DeviceProfilerFrameData> pSecondFrameData = FinishFrame();
+        ASSERT_NE( nullptr, pSecondFrameData );
+
+        const DeviceProfilerPipelineCompilationData* pCompilation = FindCompilation( *pSecondFrameData, simpleTriangle.Pipeline );
+        ASSERT_NE( nullptr, pCompilation );
+
+        EXPECT_TRUE( pCompilation->m_Deferred );
+        EXPECT_EQ( ProfilerPlatformFunctions::GetCurrentThreadId(), pCompilation->m_ThreadId );
+        EXPECT_LT( pCompilation->m_BeginTimestamp, pFirstFrameData->m_CPU.m_EndTimestamp );
+        EXPECT_GT( pCompilation->m_EndTimestamp, pFirstFrameData->m_CPU.m_EndTimestamp );
+        EXPECT_GE( pSecondFrameData->m_PipelineCompilationTicks, GetCompilationTicks( *pCompilation ) );
+        ASSERT_EQ( 1u, pCompilation->m_Pipelines.size() );
+    }
+}
@@ -0,0 +1,540 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "profiler_testing_common.h"
+#include "profiler_frontend_stub.h"
+
+#include "profiler_shared_memory/profiler_shared_memory.h"
+#include "profiler_shared_memory/profiler_shared_memory_frontend.h"
+#include "profiler_shared_memory/profiler_shared_memory_reader.h"
+#include "profiler_shared_memory/profiler_shared_memory_serializer.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Profiler
+{
+    class ProfilerSharedMemoryULT : public testing::Test
+    {
+    protected:
+        DeviceProfilerFrontendStub Frontend;
+        std::string SharedMemoryName;
+
+        inline void SetUp() override
+        {
+            Test::SetUp();
+
+            const testing::TestInfo* pTestInfo = testing::UnitTest::GetInstance()->current_test_info();
+            SharedMemoryName =
+                std::string( "VkProfilerTest_" ) +
+                pTestInfo->name() + "_" +
+                std::to_string( ProfilerPlatformFunctions::GetCurrentProcessId() );
+
+            Frontend.m_Config.m_SharedMemoryName = SharedMemoryName;
+        }
+
+        // Pushes frameCount frames to the frontend, numbered from firstFrameIndex.
+        void PushFrames( size_t frameCount, uint64_t firstFrameIndex = 0 )
+        {
+            for( size_t i = 0; i < frameCount; ++i )
+            {
+                auto pData = std::make_shared<DeviceProfilerFrameData>();
+                pData->m_SyncTimestamps.m_HostTimeDomain = OSGetDefaultTimeDomain();
+                pData->m_CPU.m_FrameIndex = firstFrameIndex + i;
+                pData->m_Ticks = 1000 * ( firstFrameIndex + i );
+                Frontend.m_Data.push_back( pData );
+            }
+        }
+
+        // Creates a frame with a primary command buffer executing a secondary one,
+        // which is also submitted directly.
+        static std::shared_ptr<DeviceProfilerFrameData> CreateFrame( uint64_t frameIndex )
+        {
+            static const VkMultiDrawIndexedInfoEXT indexInfo[ 2 ] = { { 0, 6, 0 }, { 6, 3, -2 } };
+
+            auto pSecondaryCommandBuffer = std::make_shared<DeviceProfilerCommandBufferData>();
+            pSecondaryCommandBuffer->m_Handle = VkObjectTraits<VkCommandBuffer>::GetObjectHandleAsVulkanHandle( 0x20 );
+            pSecondaryCommandBuffer->m_Level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+            pSecondaryCommandBuffer->m_BeginTimestamp.m_Value = 5;
+            pSecondaryCommandBuffer->m_EndTimestamp.m_Value = 8;
+            pSecondaryCommandBuffer->m_DataValid = true;
+
+            DeviceProfilerPipelineData pipeline;
+            pipeline.m_BeginTimestamp.m_Value = 1;
+            pipeline.m_EndTimestamp.m_Value = 4;
+
+            DeviceProfilerDrawcall& draw = pipeline.m_Drawcalls.emplace_back();
+            draw.m_Type = DeviceProfilerDrawcallType::eDraw;
+            draw.m_Payload.m_Draw.m_VertexCount = 3;
+            draw.m_Payload.m_Draw.m_InstanceCount = 2;
+            draw.m_BeginTimestamp.m_Value = 1;
+            draw.m_EndTimestamp.m_Value = 2;
+
+            DeviceProfilerDrawcall& label = pipeline.m_Drawcalls.emplace_back();
+            label.m_Type = DeviceProfilerDrawcallType::eInsertDebugLabel;
+            label.m_Payload.m_InsertDebugLabel.m_pName = "Label";
+            label.m_Payload.m_InsertDebugLabel.m_Color[ 0 ] = 0.5f;
+            label.m_Payload.m_InsertDebugLabel.m_OwnsDynamicAllocations = false;
+
+            DeviceProfilerDrawcall& multiDraw = pipeline.m_Drawcalls.emplace_back();
+            multiDraw.m_Type = DeviceProfilerDrawcallType::eDrawMultiIndexed;
+            multiDraw.m_Payload.m_DrawMultiIndexed.m_DrawCount = 2;
+            multiDraw.m_Payload.m_DrawMultiIndexed.m_InstanceCount = 1;
+            multiDraw.m_Payload.m_DrawMultiIndexed.m_pIndexInfo = indexInfo;
+            multiDraw.m_Payload.m_DrawMultiIndexed.m_pVertexOffset = nullptr;
+            multiDraw.m_Payload.m_DrawMultiIndexed.m_OwnsDynamicAllocations = false;
+            multiDraw.m_BeginTimestamp.m_Value = 3;
+            multiDraw.m_EndTimestamp.m_Value = 4;
+
+            DeviceProfilerSubpassData subpass;
+            subpass.m_Index = 0;
+            subpass.m_Contents = VK_SUBPASS_CONTENTS_INLINE;
+            subpass.m_BeginTimestamp.m_Value = 1;
+            subpass.m_EndTimestamp.m_Value = 8;
+            subpass.m_Data.emplace_back( std::move( pipeline ) );
+            subpass.m_Data.emplace_back( DeviceProfilerCommandBufferDataPtr( pSecondaryCommandBuffer ) );
+
+            DeviceProfilerRenderPassData renderPass;
+            renderPass.m_Handle = VkObjectTraits<VkRenderPass>::GetObjectHandleAsVulkanHandle( 0x30 );
+            renderPass.m_Type = DeviceProfilerRenderPassType::eGraphics;
+            renderPass.m_BeginTimestamp.m_Value = 1;
+            renderPass.m_EndTimestamp.m_Value = 8;
+            renderPass.m_Subpasses.push_back( std::move( subpass ) );
+
+            auto pPrimaryCommandBuffer = std::make_shared<DeviceProfilerCommandBufferData>();
+            pPrimaryCommandBuffer->m_Handle = VkObjectTraits<VkCommandBuffer>::GetObjectHandleAsVulkanHandle( 0x10 );
+            pPrimaryCommandBuffer->m_Level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            pPrimaryCommandBuffer->m_BeginTimestamp.m_Value = 1;
+            pPrimaryCommandBuffer->m_EndTimestamp.m_Value = 8;
+            pPrimaryCommandBuffer->m_DataValid = true;
+            pPrimaryCommandBuffer->m_RenderPasses.push_back( std::move( renderPass ) );
+
+            DeviceProfilerSubmitData submit;
+            submit.m_BeginTimestamp.m_Value = 1;
+            submit.m_EndTimestamp.m_Value = 8;
+            submit.m_CommandBuffers.push_back( pPrimaryCommandBuffer );
+            submit.m_CommandBuffers.push_back( pSecondaryCommandBuffer );
+
+            auto pData = std::make_shared<DeviceProfilerFrameData>();
+            pData->m_SyncTimestamps.m_HostTimeDomain = OSGetDefaultTimeDomain();
+            pData->m_CPU.m_FrameIndex = frameIndex;
+            pData->m_Ticks = 7;
+
+            DeviceProfilerSubmitBatchData& submitBatch = pData->m_Submits.emplace_back();
+            submitBatch.m_Handle = VkObjectTraits<VkQueue>::GetObjectHandleAsVulkanHandle( 0x1 );
+            submitBatch.m_ThreadId = 42;
+            submitBatch.m_Submits.push_back( std::move( submit ) );
+
+            return pData;
+        }
+
+        // Checks that the frame has the same content as the one returned by CreateFrame.
+        static void ExpectFrame( const DeviceProfilerFrameData& data, uint64_t frameIndex )
+        {
+            const VkQueueHandle queue = VkObjectTraits<VkQueue>::GetObjectHandleAsVulkanHandle( 0x1 );
+            const VkCommandBufferHandle primaryCommandBuffer = VkObjectTraits<VkCommandBuffer>::GetObjectHandleAsVulkanHandle( 0x10 );
+            const VkCommandBufferHandle secondaryCommandBuffer = VkObjectTraits<VkCommandBuffer>::GetObjectHandleAsVulkanHandle( 0x20 );
+            const VkRenderPassHandle renderPassHandle = VkObjectTraits<VkRenderPass>::GetObjectHandleAsVulkanHandle( 0x30 );
+
+            EXPECT_EQ( frameIndex, data.m_CPU.m_FrameIndex );
+            EXPECT_EQ( 7u, data.m_Ticks );
+
+            ASSERT_EQ( 1u, data.m_Submits.size() );
+            const DeviceProfilerSubmitBatchData& submitBatch = data.m_Submits.front();
+            EXPECT_EQ( queue, submitBatch.m_Handle );
+            EXPECT_EQ( 42u, submitBatch.m_ThreadId );
+
+            ASSERT_EQ( 1u, submitBatch.m_Submits.size() );
+            const DeviceProfilerSubmitData& submit = submitBatch.m_Submits.front();
+            EXPECT_EQ( 8u, submit.m_EndTimestamp.m_Value );
+
+            ASSERT_EQ( 2u, submit.m_CommandBuffers.size() );
+            ASSERT_NE( nullptr, submit.m_CommandBuffers[ 0 ] );
+            ASSERT_NE( nullptr, submit.m_CommandBuffers[ 1 ] );
+
+            const DeviceProfilerCommandBufferData& commandBuffer = *submit.m_CommandBuffers[ 0 ];
+            EXPECT_EQ( primaryCommandBuffer, commandBuffer.m_Handle );
+            EXPECT_EQ( VK_COMMAND_BUFFER_LEVEL_PRIMARY, commandBuffer.m_Level );
+            EXPECT_TRUE( commandBuffer.m_DataValid );
+
+            ASSERT_EQ( 1u, commandBuffer.m_RenderPasses.size() );
+            const DeviceProfilerRenderPassData& renderPass = commandBuffer.m_RenderPasses.front();
+            EXPECT_EQ( renderPassHandle, renderPass.m_Handle );
+            EXPECT_EQ( DeviceProfilerRenderPassType::eGraphics, renderPass.m_Type );
+
+            ASSERT_EQ( 1u, renderPass.m_Subpasses.size() );
+            const DeviceProfilerSubpassData& subpass = renderPass.m_Subpasses.front();
+            ASSERT_EQ( 2u, subpass.m_Data.size() );
+            ASSERT_EQ( DeviceProfilerSubpassDataType::ePipeline, subpass.m_Data[ 0 ].GetType() );
+            ASSERT_EQ( DeviceProfilerSubpassDataType::eCommandBuffer, subpass.m_Data[ 1 ].GetType() );
+
+            const DeviceProfilerPipelineData& pipeline = std::get<DeviceProfilerPipelineData>( subpass.m_Data[ 0 ] );
+            ASSERT_EQ( 3u, pipeline.m_Drawcalls.size() );
+
+            const DeviceProfilerDrawcall& draw = pipeline.m_Drawcalls[ 0 ];
+            EXPECT_EQ( DeviceProfilerDrawcallType::eDraw, draw.m_Type );
+            EXPECT_EQ( 3u, draw.m_Payload.m_Draw.m_VertexCount );
+            EXPECT_EQ( 2u, draw.m_Payload.m_Draw.m_InstanceCount );
+            EXPECT_EQ( 2u, draw.m_EndTimestamp.m_Value );
+
+            // Dynamic allocations are copied to the memory owned by the deserialized frame.
+            const DeviceProfilerDrawcall& label = pipeline.m_Drawcalls[ 1 ];
+            EXPECT_EQ( DeviceProfilerDrawcallType::eInsertDebugLabel, label.m_Type );
+            ASSERT_NE( nullptr, label.m_Payload.m_InsertDebugLabel.m_pName );
+            EXPECT_STREQ( "Label", label.m_Payload.m_InsertDebugLabel.m_pName );
+            EXPECT_EQ( 0.5f, label.m_Payload.m_InsertDebugLabel.m_Color[ 0 ] );
+            EXPECT_TRUE( label.m_Payload.m_InsertDebugLabel.m_OwnsDynamicAllocations );
+
+            const DeviceProfilerDrawcall& multiDraw = pipeline.m_Drawcalls[ 2 ];
+            EXPECT_EQ( DeviceProfilerDrawcallType::eDrawMultiIndexed, multiDraw.m_Type );
+            ASSERT_EQ( 2u, multiDraw.m_Payload.m_DrawMultiIndexed.m_DrawCount );
+            ASSERT_NE( nullptr, multiDraw.m_Payload.m_DrawMultiIndexed.m_pIndexInfo );
+            EXPECT_EQ( 6u, multiDraw.m_Payload.m_DrawMultiIndexed.m_pIndexInfo[ 1 ].firstIndex );
+            EXPECT_EQ( 3u, multiDraw.m_Payload.m_DrawMultiIndexed.m_pIndexInfo[ 1 ].indexCount );
+            EXPECT_EQ( -2, multiDraw.m_Payload.m_DrawMultiIndexed.m_pIndexInfo[ 1 ].vertexOffset );
+            EXPECT_TRUE( multiDraw.m_Payload.m_DrawMultiIndexed.m_OwnsDynamicAllocations );
+
+            // The secondary command buffer is shared by the subpass and the submit.
+            const DeviceProfilerCommandBufferDataPtr& pSecondaryCommandBuffer = std::get<DeviceProfilerCommandBufferDataPtr>( subpass.m_Data[ 1 ] );
+            EXPECT_EQ( submit.m_CommandBuffers[ 1 ], pSecondaryCommandBuffer );
+            EXPECT_EQ( secondaryCommandBuffer, pSecondaryCommandBuffer->m_Handle );
+            EXPECT_EQ( VK_COMMAND_BUFFER_LEVEL_SECONDARY, pSecondaryCommandBuffer->m_Level );
+            EXPECT_EQ( 5u, pSecondaryCommandBuffer->m_BeginTimestamp.m_Value );
+        }
+    };
+
+    TEST_F( ProfilerSharedMemoryULT, ReadHeader )
+    {
+        ProfilerSharedMemoryOutput output( Frontend );
+        ASSERT_TRUE( output.Initialize() );
+        EXPECT_EQ( SharedMemoryName, output.GetName() );
+
+        ProfilerSharedMemoryReader reader;
+        ASSERT_TRUE( reader.Open( SharedMemoryName.c_str() ) );
+
+        const ProfilerSharedMemoryHeader& header = reader.GetHeader();
+        EXPECT_EQ( ProfilerSharedMemoryMagic, header.m_Magic );
+        EXPECT_EQ( ProfilerSharedMemoryVersion, header.m_Version );
+        EXPECT_EQ( ProfilerPlatformFunctions::GetCurrentProcessId(), header.m_ProcessId );
+        EXPECT_EQ( ProfilerSharedMemoryFrameCount, header.m_FrameCapacity );
+        EXPECT_EQ( 0u, reader.GetPublishedFrameCount() );
+
+        // No frames have been published yet.
+        ProfilerSharedMemoryFrameData frame = {};
+        EXPECT_FALSE( reader.ReadFrame( 0, frame ) );
+
+        reader.Close();
+        output.Destroy();
+    }
+
+    TEST_F( ProfilerSharedMemoryULT, OpenMissingSegment )
+    {
+        ProfilerSharedMemoryReader reader;
+        EXPECT_FALSE( reader.Open( SharedMemoryName.c_str() ) );
+        EXPECT_FALSE( reader.IsOpen() );
+    }
+
+    TEST_F( ProfilerSharedMemoryULT, ReadFrames )
+    {
+        ProfilerSharedMemoryOutput output( Frontend );
+        ASSERT_TRUE( output.Initialize() );
+
+        ProfilerSharedMemoryReader reader;
+        ASSERT_TRUE( reader.Open( SharedMemoryName.c_str() ) );
+
+        PushFrames( 3, 100 );
+        output.Update();
+
+        ASSERT_EQ( 3u, reader.GetPublishedFrameCount() );
+
+        for( uint64_t i = 0; i < 3; ++i )
+        {
+            ProfilerSharedMemoryFrameData frame = {};
+            ASSERT_TRUE( reader.ReadFrame( i, frame ) );
+            EXPECT_EQ( 100 + i, frame.m_FrameIndex );
+            EXPECT_EQ( 1000 * ( 100 + i ), frame.m_GpuTicks );
+        }
+
+        ProfilerSharedMemoryFrameData frame = {};
+        EXPECT_FALSE( reader.ReadFrame( 3, frame ) );
+
+        reader.Close();
+        output.Destroy();
+    }
+
+    TEST_F( ProfilerSharedMemoryULT, ReadOverwrittenFrames )
+    {
+        ProfilerSharedMemoryOutput output( Frontend );
+        ASSERT_TRUE( output.Initialize() );
+
+        ProfilerSharedMemoryReader reader;
+        ASSERT_TRUE( reader.Open( SharedMemoryName.c_str() ) );
+
+        // Wrap around the ring twice.
+        const uint64_t frameCount = 2 * ProfilerSharedMemoryFrameCount + 5;
+        PushFrames( frameCount );
+        output.Update();
+
+        ASSERT_EQ( frameCount, reader.GetPublishedFrameCount() );
+
+        // Frames older than the capacity of the ring have been overwritten,
+        // even though their slots contain valid newer frames.
+        ProfilerSharedMemoryFrameData frame = {};
+        EXPECT_FALSE( reader.ReadFrame( 0, frame ) );
+        EXPECT_FALSE( reader.ReadFrame( 4, frame ) );
+        EXPECT_FALSE( reader.ReadFrame( frameCount - ProfilerSharedMemoryFrameCount - 1, frame ) );
+
+        for( uint64_t i = frameCount - ProfilerSharedMemoryFrameCount; i < frameCount; ++i )
+        {
+            ASSERT_TRUE( reader.ReadFrame( i, frame ) );
+            EXPECT_EQ( i, frame.m_FrameIndex );
+        }
+
+        reader.Close();
+        output.Destroy();
+    }
+
+    TEST_F( ProfilerSharedMemoryULT, ExecuteCommands )
+    {
+        Frontend.m_PerformanceMetricsSetCount = 2;
+
+        ProfilerSharedMemoryOutput output( Frontend );
+        ASSERT_TRUE( output.Initialize() );
+
+        ProfilerSharedMemoryReader reader;
+        ASSERT_TRUE( reader.Open( SharedMemoryName.c_str() ) );
+
+        EXPECT_TRUE( reader.SendCommand( ProfilerSharedMemoryCommandType::eSetSamplingMode, VK_PROFILER_MODE_PER_RENDER_PASS_EXT ) );
+        EXPECT_TRUE( reader.SendCommand( ProfilerSharedMemoryCommandType::eSetFrameDelimiter, VK_PROFILER_FRAME_DELIMITER_SUBMIT_EXT ) );
+        EXPECT_TRUE( reader.SendCommand( ProfilerSharedMemoryCommandType::eSetPerformanceMetricsSetIndex, 1 ) );
+
+        // Commands are executed in the next update.
+        EXPECT_EQ( VK_PROFILER_MODE_PER_DRAWCALL_EXT, Frontend.m_SamplingMode );
+        output.Update();
+
+        EXPECT_EQ( VK_PROFILER_MODE_PER_RENDER_PASS_EXT, Frontend.m_SamplingMode );
+        EXPECT_EQ( VK_PROFILER_FRAME_DELIMITER_SUBMIT_EXT, Frontend.m_FrameDelimiter );
+        EXPECT_EQ( 1u, Frontend.m_PerformanceMetricsSetIndex );
+
+        reader.Close();
+        output.Destroy();
+    }
+
+    TEST_F( ProfilerSharedMemoryULT, IgnoreInvalidCommands )
+    {
+        Frontend.m_PerformanceMetricsSetCount = 2;
+
+        ProfilerSharedMemoryOutput output( Frontend );
+        ASSERT_TRUE( output.Initialize() );
+
+        ProfilerSharedMemoryReader reader;
+        ASSERT_TRUE( reader.Open( SharedMemoryName.c_str() ) );
+
+        // Values out of range of the enumerations are not passed to the frontend.
+        EXPECT_TRUE( reader.SendCommand( ProfilerSharedMemoryCommandType::eSetSamplingMode, VK_PROFILER_MODE_PER_FRAME_EXT + 1 ) );
+        EXPECT_TRUE( reader.SendCommand( ProfilerSharedMemoryCommandType::eSetSamplingMode, UINT32_MAX ) );
+        EXPECT_TRUE( reader.SendCommand( ProfilerSharedMemoryCommandType::eSetFrameDelimiter, VK_PROFILER_FRAME_DELIMITER_FRAME_BOUNDARY_EXT + 1 ) );
+        EXPECT_TRUE( reader.SendCommand( ProfilerSharedMemoryCommandType::eSetPerformanceMetricsSetIndex, 2 ) );
+        EXPECT_TRUE( reader.SendCommand( static_cast<ProfilerSharedMemoryCommandType>( 1234 ), 0 ) );
+
+        // Valid commands after the invalid ones are still executed.
+        EXPECT_TRUE( reader.SendCommand( ProfilerSharedMemoryCommandType::eSetSamplingMode, VK_PROFILER_MODE_PER_FRAME_EXT ) );
+
+        output.Update();
+
+        EXPECT_EQ( VK_PROFILER_MODE_PER_FRAME_EXT, Frontend.m_SamplingMode );
+        EXPECT_EQ( VK_PROFILER_FRAME_DELIMITER_PRESENT_EXT, Frontend.m_FrameDelimiter );
+        EXPECT_EQ( UINT32_MAX, Frontend.m_PerformanceMetricsSetIndex );
+
+        reader.Close();
+        output.Destroy();
+    }
+
+    TEST_F( ProfilerSharedMemoryULT, CommandQueueFull )
+    {
+        ProfilerSharedMemoryOutput output( Frontend );
+        ASSERT_TRUE( output.Initialize() );
+
+        ProfilerSharedMemoryReader reader;
+        ASSERT_TRUE( reader.Open( SharedMemoryName.c_str() ) );
+
+        for( uint32_t i = 0; i < ProfilerSharedMemoryCommandCount; ++i )
+        {
+            EXPECT_TRUE( reader.SendCommand( ProfilerSharedMemoryCommandType::eSetSamplingMode, i % ( VK_PROFILER_MODE_PER_FRAME_EXT + 1 ) ) );
+        }
+
+        // The layer must consume the commands before more can be sent.
+        EXPECT_FALSE( reader.SendCommand( ProfilerSharedMemoryCommandType::eSetSamplingMode, VK_PROFILER_MODE_PER_DRAWCALL_EXT ) );
+
+        output.Update();
+
+        EXPECT_TRUE( reader.SendCommand( ProfilerSharedMemoryCommandType::eSetSamplingMode, VK_PROFILER_MODE_PER_DRAWCALL_EXT ) );
+
+        reader.Close();
+        output.Destroy();
+    }
+
+    TEST_F( ProfilerSharedMemoryULT, NameTaken )
+    {
+        ProfilerSharedMemoryOutput output( Frontend );
+        ASSERT_TRUE( output.Initialize() );
+
+        // The configured name is already used by the first output.
+        ProfilerSharedMemoryOutput output2( Frontend );
+        EXPECT_FALSE( output2.Initialize() );
+        EXPECT_FALSE( output2.IsAvailable() );
+
+        // The segment of the first output is not affected.
+        ProfilerSharedMemoryReader reader;
+        EXPECT_TRUE( reader.Open( SharedMemoryName.c_str() ) );
+
+        reader.Close();
+        output.Destroy();
+    }
+
+    TEST_F( ProfilerSharedMemoryULT, UniqueDefaultNames )
+    {
+        Frontend.m_Config.m_SharedMemoryName.clear();
+
+        ProfilerSharedMemoryOutput output( Frontend );
+        ASSERT_TRUE( output.Initialize() );
+
+        ProfilerSharedMemoryOutput output2( Frontend );
+        ASSERT_TRUE( output2.Initialize() );
+
+        // Each device publishes its frames to a separate segment.
+        const std::string prefix = "VkProfiler_" + std::to_string( ProfilerPlatformFunctions::GetCurrentProcessId() ) + "_";
+        EXPECT_EQ( 0u, output.GetName().rfind( prefix, 0 ) );
+        EXPECT_EQ( 0u, output2.GetName().rfind( prefix, 0 ) );
+        EXPECT_NE( output.GetName(), output2.GetName() );
+
+        output2.Destroy();
+        output.Destroy();
+    }
+
+    TEST_F( ProfilerSharedMemoryULT, SerializeFrameData )
+    {
+        ProfilerSharedMemorySerializer serializer( Frontend );
+        const std::vector<uint8_t> data = serializer.SerializeFrameData( *CreateFrame( 5 ) );
+
+        DeviceProfilerFrameData frameData;
+        std::unordered_map<VkObject, std::string> objectNames;
+
+        ProfilerSharedMemoryDeserializer deserializer;
+        ASSERT_TRUE( deserializer.DeserializeFrameData( data, frameData, objectNames ) );
+        ExpectFrame( frameData, 5 );
+    }
+
+    TEST_F( ProfilerSharedMemoryULT, RejectTruncatedFrameData )
+    {
+        ProfilerSharedMemorySerializer serializer( Frontend );
+        const std::vector<uint8_t> data = serializer.SerializeFrameData( *CreateFrame( 0 ) );
+
+        ProfilerSharedMemoryDeserializer deserializer;
+        for( size_t size = 0; size < data.size(); ++size )
+        {
+            const std::vector<uint8_t> truncatedData( data.begin(), data.begin() + size );
+
+            DeviceProfilerFrameData frameData;
+            std::unordered_map<VkObject, std::string> objectNames;
+            EXPECT_FALSE( deserializer.DeserializeFrameData( truncatedData, frameData, objectNames ) ) << "size = " << size;
+        }
+    }
+
+    TEST_F( ProfilerSharedMemoryULT, SerializeDeviceData )
+    {
+        ProfilerSharedMemorySerializer serializer( Frontend );
+        const std::vector<uint8_t> data = serializer.SerializeDeviceData();
+
+        ProfilerSharedMemoryDeviceData deviceData;
+        ProfilerSharedMemoryDeserializer deserializer;
+        ASSERT_TRUE( deserializer.DeserializeDeviceData( data, deviceData ) );
+        EXPECT_EQ( 1.0f, deviceData.m_PhysicalDeviceProperties.limits.timestampPeriod );
+        EXPECT_EQ( VK_PROFILER_PERFORMANCE_COUNTERS_SAMPLING_MODE_QUERY_EXT, deviceData.m_PerformanceCountersSamplingMode );
+        EXPECT_TRUE( deviceData.m_ApplicationName.empty() );
+        EXPECT_TRUE( deviceData.m_Queues.empty() );
+    }
+
+    TEST_F( ProfilerSharedMemoryULT, FrontendGetData )
+    {
+        ProfilerSharedMemoryOutput output( Frontend );
+        ASSERT_TRUE( output.Initialize() );
+
+        ProfilerSharedMemoryFrontend frontend;
+        ASSERT_TRUE( frontend.Initialize( SharedMemoryName.c_str() ) );
+        EXPECT_TRUE( frontend.IsAvailable() );
+        EXPECT_EQ( 1.0f, frontend.GetPhysicalDeviceProperties().limits.timestampPeriod );
+        EXPECT_EQ( nullptr, frontend.GetData() );
+
+        for( uint64_t i = 0; i < 3; ++i )
+        {
+            Frontend.m_Data.push_back( CreateFrame( 100 + i ) );
+        }
+
+        output.Update();
+        EXPECT_EQ( 3u, frontend.GetPublishedFrameCount() );
+
+        for( uint64_t i = 0; i < 3; ++i )
+        {
+            std::shared_ptr<DeviceProfilerFrameData> pData = frontend.GetData();
+            ASSERT_NE( nullptr, pData );
+            ExpectFrame( *pData, 100 + i );
+        }
+
+        EXPECT_EQ( nullptr, frontend.GetData() );
+
+        frontend.Destroy();
+        output.Destroy();
+    }
+
+    TEST_F( ProfilerSharedMemoryULT, FrontendSkipsOverwrittenFrames )
+    {
+        ProfilerSharedMemoryOutput output( Frontend );
+        ASSERT_TRUE( output.Initialize() );
+
+        ProfilerSharedMemoryFrontend frontend;
+        ASSERT_TRUE( frontend.Initialize( SharedMemoryName.c_str() ) );
+
+        // Wrap around the ring before the frontend reads any frame.
+        const uint64_t frameCount = 2 * ProfilerSharedMemoryFrameCount + 5;
+        for( uint64_t i = 0; i < frameCount; ++i )
+        {
+            Frontend.m_Data.push_back( CreateFrame( i ) );
+        }
+
+        output.Update();
+
+        // Only the frames still stored in the ring are returned.
+        for( uint64_t i = frameCount - ProfilerSharedMemoryFrameCount; i < frameCount; ++i )
+        {
+            std::shared_ptr<DeviceProfilerFrameData> pData = frontend.GetData();
+            ASSERT_NE( nullptr, pData );
+            EXPECT_EQ( i, pData->m_CPU.m_FrameIndex );
+        }
+
+        EXPECT_EQ( nullptr, frontend.GetData() );
+
+        frontend.Destroy();
+        output.Destroy();
+    }
+}
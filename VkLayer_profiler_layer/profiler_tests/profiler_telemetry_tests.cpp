@@ -0,0 +1,221 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "profiler_testing_common.h"
+#include "profiler_frontend_stub.h"
+
+#include "profiler_telemetry/profiler_telemetry.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+namespace Profiler
+{
+    class ProfilerTelemetryULT : public testing::Test
+    {
+    protected:
+        // Number of rows written at once, see ProfilerTelemetryOutput::BatchSize.
+        static constexpr size_t BatchSize = 64;
+
+        DeviceProfilerFrontendStub Frontend;
+        std::filesystem::path TelemetryFilePath;
+
+        inline void SetUp() override
+        {
+            Test::SetUp();
+
+            const testing::TestInfo* pTestInfo = testing::UnitTest::GetInstance()->current_test_info();
+            TelemetryFilePath = std::filesystem::temp_directory_path() /
+                ( std::string( "profiler_telemetry_" ) +
+                    pTestInfo->name() + "_" +
+                    std::to_string( ProfilerPlatformFunctions::GetCurrentProcessId() ) +
+                    ".csv" );
+
+            Frontend.m_Config.m_TelemetryFile = TelemetryFilePath.string();
+            Frontend.m_Config.m_EnableThreading = false;
+        }
+
+        inline void TearDown() override
+        {
+            for( uint32_t i = 0; i < 4; ++i )
+            {
+                std::error_code error;
+                std::filesystem::remove( GetRotatedFilePath( i ), error );
+            }
+
+            Test::TearDown();
+        }
+
+        // Returns path of the file with the given index, e.g. telemetry_1.csv.
+        std::filesystem::path GetRotatedFilePath( uint32_t fileIndex ) const
+        {
+            if( fileIndex == 0 )
+            {
+                return TelemetryFilePath;
+            }
+
+            std::filesystem::path path = TelemetryFilePath;
+            path.replace_filename( TelemetryFilePath.stem().string() + "_" + std::to_string( fileIndex ) + ".csv" );
+            return path;
+        }
+
+        // Pushes frameCount frames with heapCount memory heaps to the frontend.
+        void PushFrames( size_t frameCount, size_t heapCount = 1 )
+        {
+            auto pData = std::make_shared<DeviceProfilerFrameData>();
+            pData->m_SyncTimestamps.m_HostTimeDomain = OSGetDefaultTimeDomain();
+            pData->m_Memory.m_Heaps.resize( heapCount );
+
+            for( size_t i = 0; i < frameCount; ++i )
+            {
+                Frontend.m_Data.push_back( pData );
+            }
+        }
+
+        // Returns number of lines in the file, including the header.
+        static size_t CountLines( const std::filesystem::path& path )
+        {
+            std::ifstream file( path, std::ios::binary );
+            return std::count( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>(), '\n' );
+        }
+    };
+
+    TEST_F( ProfilerTelemetryULT, WriteFullBatches )
+    {
+        Frontend.m_Config.m_TelemetryFlushInterval = 3'600'000;
+
+        ProfilerTelemetryOutput output( Frontend );
+        ASSERT_TRUE( output.Initialize() );
+
+        // Partial batch is kept in memory until the flush interval elapses.
+        PushFrames( BatchSize - 1 );
+        output.Update();
+        EXPECT_EQ( 0u, CountLines( TelemetryFilePath ) );
+
+        PushFrames( 1 );
+        output.Update();
+        EXPECT_EQ( BatchSize + 1, CountLines( TelemetryFilePath ) );
+
+        // Remaining rows are written when the output is destroyed.
+        PushFrames( 1 );
+        output.Update();
+        output.Destroy();
+        EXPECT_EQ( BatchSize + 2, CountLines( TelemetryFilePath ) );
+    }
+
+    TEST_F( ProfilerTelemetryULT, FlushPartialBatch )
+    {
+        Frontend.m_Config.m_TelemetryFlushInterval = 0;
+
+        ProfilerTelemetryOutput output( Frontend );
+        ASSERT_TRUE( output.Initialize() );
+
+        PushFrames( 1 );
+        output.Update();
+        EXPECT_EQ( 2u, CountLines( TelemetryFilePath ) );
+
+        PushFrames( 1 );
+        output.Update();
+        EXPECT_EQ( 3u, CountLines( TelemetryFilePath ) );
+
+        output.Destroy();
+    }
+
+    TEST_F( ProfilerTelemetryULT, FlushPartialBatchThreaded )
+    {
+        Frontend.m_Config.m_EnableThreading = true;
+        Frontend.m_Config.m_TelemetryFlushInterval = 10;
+
+        ProfilerTelemetryOutput output( Frontend );
+        ASSERT_TRUE( output.Initialize() );
+
+        // The writer thread writes the partial batch without further calls to Update.
+        PushFrames( 1 );
+        output.Update();
+
+        const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds( 10 );
+        while( ( CountLines( TelemetryFilePath ) < 2 ) && ( std::chrono::steady_clock::now() < timeout ) )
+        {
+            std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+        }
+
+        EXPECT_EQ( 2u, CountLines( TelemetryFilePath ) );
+
+        output.Destroy();
+    }
+
+    TEST_F( ProfilerTelemetryULT, RotateOnLayoutChange )
+    {
+        Frontend.m_Config.m_TelemetryFlushInterval = 0;
+        Frontend.m_Config.m_TelemetryFileCount = 2;
+
+        ProfilerTelemetryOutput output( Frontend );
+        ASSERT_TRUE( output.Initialize() );
+
+        // Each change of the number of heaps starts a new file.
+        PushFrames( 1, 1 );
+        output.Update();
+        PushFrames( 1, 2 );
+        output.Update();
+        EXPECT_TRUE( std::filesystem::exists( GetRotatedFilePath( 0 ) ) );
+        EXPECT_TRUE( std::filesystem::exists( GetRotatedFilePath( 1 ) ) );
+
+        // Only the last 2 files are kept.
+        PushFrames( 1, 1 );
+        output.Update();
+        output.Destroy();
+
+        EXPECT_FALSE( std::filesystem::exists( GetRotatedFilePath( 0 ) ) );
+        EXPECT_EQ( 2u, CountLines( GetRotatedFilePath( 1 ) ) );
+        EXPECT_EQ( 2u, CountLines( GetRotatedFilePath( 2 ) ) );
+    }
+
+    TEST_F( ProfilerTelemetryULT, RotateOnSizeLimit )
+    {
+        Frontend.m_Config.m_TelemetryFlushInterval = 3'600'000;
+        Frontend.m_Config.m_TelemetryFileSizeLimit = 1;
+        Frontend.m_Config.m_TelemetryFileCount = 0;
+
+        ProfilerTelemetryOutput output( Frontend );
+        ASSERT_TRUE( output.Initialize() );
+
+        // Write rows until the second file is started.
+        size_t rowCount = 0;
+        while( !std::filesystem::exists( GetRotatedFilePath( 1 ) ) && ( rowCount < 1'000'000 ) )
+        {
+            PushFrames( BatchSize );
+            output.Update();
+            rowCount += BatchSize;
+        }
+
+        output.Destroy();
+
+        ASSERT_TRUE( std::filesystem::exists( GetRotatedFilePath( 1 ) ) );
+        EXPECT_GE( std::filesystem::file_size( GetRotatedFilePath( 0 ) ), 1024 * 1024 );
+        EXPECT_FALSE( std::filesystem::exists( GetRotatedFilePath( 2 ) ) );
+
+        // Each file starts with the header.
+        EXPECT_EQ( rowCount + 2, CountLines( GetRotatedFilePath( 0 ) ) + CountLines( GetRotatedFilePath( 1 ) ) );
+    }
+}
@@ -0,0 +1,286 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "profiler_testing_common.h"
+
+#include "profiler_trace_analyzer/profiler_trace_analyzer.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace Profiler
+{
+    class ProfilerTraceAnalyzerULT : public testing::Test
+    {
+    protected:
+        std::vector<std::filesystem::path> TraceFilePaths;
+
+        void TearDown() override
+        {
+            for( const std::filesystem::path& path : TraceFilePaths )
+            {
+                std::filesystem::remove( path );
+            }
+        }
+
+        // Returns a single trace event line in the format written by the layer.
+        static std::string Event( const char* pPhase, const char* pCategory, const std::string& name, const char* pLane, uint64_t timestamp, uint64_t duration = 0 )
+        {
+            std::string event = "{\"name\":\"" + name + "\",\"ph\":\"" + pPhase + "\",\"cat\":\"" + pCategory + "\"," +
+                "\"ts\":" + std::to_string( timestamp ) + ",\"pid\":0,\"tid\":\"" + pLane + "\"";
+
+            if( duration )
+            {
+                event += ",\"dur\":" + std::to_string( duration );
+            }
+
+            return event + "}";
+        }
+
+        // Writes the events to a temporary trace file, one event per line.
+        std::filesystem::path WriteTrace( const std::vector<std::string>& events )
+        {
+            const testing::TestInfo* pTestInfo = testing::UnitTest::GetInstance()->current_test_info();
+            const std::filesystem::path path = std::filesystem::temp_directory_path() /
+                ( std::string( "profiler_trace_analyzer_" ) +
+                    pTestInfo->name() + "_" +
+                    std::to_string( TraceFilePaths.size() ) + "_" +
+                    std::to_string( ProfilerPlatformFunctions::GetCurrentProcessId() ) +
+                    ".json" );
+
+            std::ofstream file( path, std::ios::binary );
+            file << "{\"displayTimeUnit\":\"ns\",\n \"otherData\":{},\n \"traceEvents\":[";
+
+            for( size_t i = 0; i < events.size(); ++i )
+            {
+                file << ( i ? ",\n" : "\n" ) << events[ i ];
+            }
+
+            file << ",\n]}\n";
+            file.close();
+
+            TraceFilePaths.push_back( path );
+            return path;
+        }
+    };
+
+    TEST_F( ProfilerTraceAnalyzerULT, FindEndOfEvents )
+    {
+        const std::string_view events =
+            "{\"name\":\"a\"},\n"
+            "{\"name\":\"b\"},\n"
+            "]}\n";
+
+        EXPECT_EQ( events.find( "]}" ), DeviceProfilerTraceAnalyzer::FindEndOfEvents( events ) );
+    }
+
+    TEST_F( ProfilerTraceAnalyzerULT, FindEndOfEventsIndented )
+    {
+        const std::string_view events =
+            "{\"name\":\"a\"},\r\n"
+            " \t]}\r\n";
+
+        EXPECT_EQ( events.find( " \t]}" ), DeviceProfilerTraceAnalyzer::FindEndOfEvents( events ) );
+    }
+
+    TEST_F( ProfilerTraceAnalyzerULT, FindEndOfEventsIgnoresBracketsInEvents )
+    {
+        const std::string_view events =
+            "{\"name\":\"]\",\"args\":{\"values\":[1,2]}},\n"
+            "{\"name\":\"a]\"},\n"
+            "]}\n";
+
+        EXPECT_EQ( events.find( "]}" ), DeviceProfilerTraceAnalyzer::FindEndOfEvents( events ) );
+    }
+
+    TEST_F( ProfilerTraceAnalyzerULT, FindEndOfEventsNotFound )
+    {
+        const std::string_view events =
+            "{\"name\":\"a\"},\n"
+            "{\"name\":\"b\"}";
+
+        EXPECT_EQ( events.size(), DeviceProfilerTraceAnalyzer::FindEndOfEvents( events ) );
+    }
+
+    TEST_F( ProfilerTraceAnalyzerULT, FindEndOfEventsRequiresOneEventPerLine )
+    {
+        // The analyzer relies on the layer writing each event in a single line.
+        // A ']' at the beginning of any line is treated as the end of the traceEvents array,
+        // so events formatted over multiple lines are cut at the first line closing a nested array.
+        // This test pins that contract - if the trace format changes, the analyzer must be updated too.
+        const std::string_view events =
+            "{\"name\":\"a\",\"args\":{\"values\":[\n"
+            "  1,2\n"
+            "]}},\n"
+            "]}\n";
+
+        EXPECT_EQ( events.find( "]}}" ), DeviceProfilerTraceAnalyzer::FindEndOfEvents( events ) );
+    }
+
+    TEST_F( ProfilerTraceAnalyzerULT, AggregateRegions )
+    {
+        const std::filesystem::path traceFilePath = WriteTrace( {
+            Event( "B", "Render passes", "RenderPass", "Queue", 0 ),
+            Event( "B", "Pipelines", "Pipeline", "Queue", 1 ),
+            Event( "B", "Drawcalls", "vkCmdDraw", "Queue", 1 ),
+            Event( "E", "Drawcalls", "vkCmdDraw", "Queue", 2 ),
+            Event( "E", "Pipelines", "Pipeline", "Queue", 3 ),
+            Event( "B", "Pipelines", "Pipeline", "Queue", 4 ),
+            Event( "E", "Pipelines", "Pipeline", "Queue", 8 ),
+            Event( "E", "Render passes", "RenderPass", "Queue", 10 ),
+            Event( "X", "Debug", "Label", "Debug labels", 2, 5 ) } );
+
+        DeviceProfilerTraceAnalyzer analyzer;
+        DeviceProfilerTraceAnalysis analysis;
+        ASSERT_TRUE( analyzer.Analyze( traceFilePath, analysis ) ) << analyzer.GetErrorMessage();
+
+        EXPECT_EQ( 9u, analysis.m_EventCount );
+
+        const auto& pipelines = analysis.GetRegions( DeviceProfilerTraceRegionType::ePipeline );
+        ASSERT_EQ( 1u, pipelines.size() );
+        ASSERT_EQ( 1u, pipelines.count( "Pipeline" ) );
+        EXPECT_EQ( 2u, pipelines.at( "Pipeline" ).m_Count );
+        EXPECT_DOUBLE_EQ( 6.0, pipelines.at( "Pipeline" ).m_TotalDuration );
+        EXPECT_DOUBLE_EQ( 2.0, pipelines.at( "Pipeline" ).m_MinDuration );
+        EXPECT_DOUBLE_EQ( 4.0, pipelines.at( "Pipeline" ).m_MaxDuration );
+        EXPECT_DOUBLE_EQ( 3.0, pipelines.at( "Pipeline" ).GetAverageDuration() );
+
+        const auto& renderPasses = analysis.GetRegions( DeviceProfilerTraceRegionType::eRenderPass );
+        ASSERT_EQ( 1u, renderPasses.count( "RenderPass" ) );
+        EXPECT_EQ( 1u, renderPasses.at( "RenderPass" ).m_Count );
+        EXPECT_DOUBLE_EQ( 10.0, renderPasses.at( "RenderPass" ).m_TotalDuration );
+
+        const auto& debugLabels = analysis.GetRegions( DeviceProfilerTraceRegionType::eDebugLabel );
+        ASSERT_EQ( 1u, debugLabels.count( "Label" ) );
+        EXPECT_EQ( 1u, debugLabels.at( "Label" ).m_Count );
+        EXPECT_DOUBLE_EQ( 5.0, debugLabels.at( "Label" ).m_TotalDuration );
+    }
+
+    TEST_F( ProfilerTraceAnalyzerULT, MatchRegionsPerLane )
+    {
+        // Regions on different queues overlap, but are matched only within their lanes.
+        const std::filesystem::path traceFilePath = WriteTrace( {
+            Event( "B", "Pipelines", "A", "Queue 0", 0 ),
+            Event( "B", "Pipelines", "B", "Queue 1", 1 ),
+            Event( "E", "Pipelines", "A", "Queue 0", 5 ),
+            Event( "E", "Pipelines", "B", "Queue 1", 3 ) } );
+
+        DeviceProfilerTraceAnalyzer analyzer;
+        DeviceProfilerTraceAnalysis analysis;
+        ASSERT_TRUE( analyzer.Analyze( traceFilePath, analysis ) ) << analyzer.GetErrorMessage();
+
+        const auto& pipelines = analysis.GetRegions( DeviceProfilerTraceRegionType::ePipeline );
+        ASSERT_EQ( 2u, pipelines.size() );
+        EXPECT_DOUBLE_EQ( 5.0, pipelines.at( "A" ).m_TotalDuration );
+        EXPECT_DOUBLE_EQ( 2.0, pipelines.at( "B" ).m_TotalDuration );
+    }
+
+    TEST_F( ProfilerTraceAnalyzerULT, MatchRegionsAcrossChunks )
+    {
+        // Render passes span the whole trace, so their begin and end events are always in different chunks.
+        std::vector<std::string> events;
+        events.push_back( Event( "B", "Render passes", "RenderPass 0", "Queue 0", 0 ) );
+        events.push_back( Event( "B", "Render passes", "RenderPass 1", "Queue 1", 0 ) );
+
+        const uint64_t pipelineCount = 2000;
+        for( uint64_t i = 0; i < pipelineCount; ++i )
+        {
+            const std::string name = "Pipeline " + std::to_string( i % 7 );
+            const char* pLane = ( i % 2 ) ? "Queue 1" : "Queue 0";
+            events.push_back( Event( "B", "Pipelines", name, pLane, 10 * i + 1 ) );
+            events.push_back( Event( "E", "Pipelines", name, pLane, 10 * i + 1 + ( i % 5 ) + 1 ) );
+        }
+
+        events.push_back( Event( "E", "Render passes", "RenderPass 0", "Queue 0", 10 * pipelineCount ) );
+        events.push_back( Event( "E", "Render passes", "RenderPass 1", "Queue 1", 10 * pipelineCount + 1 ) );
+
+        const std::filesystem::path traceFilePath = WriteTrace( events );
+
+        // Reference analysis of the whole trace in a single chunk.
+        DeviceProfilerTraceAnalyzer referenceAnalyzer;
+        referenceAnalyzer.SetThreadCount( 1 );
+        referenceAnalyzer.SetChunkSize( std::filesystem::file_size( traceFilePath ) + 1 );
+
+        DeviceProfilerTraceAnalysis referenceAnalysis;
+        ASSERT_TRUE( referenceAnalyzer.Analyze( traceFilePath, referenceAnalysis ) ) << referenceAnalyzer.GetErrorMessage();
+
+        // Analysis in the smallest chunks.
+        DeviceProfilerTraceAnalyzer analyzer;
+        analyzer.SetThreadCount( 4 );
+        analyzer.SetChunkSize( 0 );
+
+        DeviceProfilerTraceAnalysis analysis;
+        ASSERT_TRUE( analyzer.Analyze( traceFilePath, analysis ) ) << analyzer.GetErrorMessage();
+
+        EXPECT_EQ( events.size(), referenceAnalysis.m_EventCount );
+        EXPECT_EQ( events.size(), analysis.m_EventCount );
+
+        const auto& renderPasses = analysis.GetRegions( DeviceProfilerTraceRegionType::eRenderPass );
+        ASSERT_EQ( 2u, renderPasses.size() );
+        EXPECT_DOUBLE_EQ( 10.0 * pipelineCount, renderPasses.at( "RenderPass 0" ).m_TotalDuration );
+        EXPECT_DOUBLE_EQ( 10.0 * pipelineCount + 1, renderPasses.at( "RenderPass 1" ).m_TotalDuration );
+
+        for( size_t i = 0; i < static_cast<size_t>( DeviceProfilerTraceRegionType::eCount ); ++i )
+        {
+            const auto type = static_cast<DeviceProfilerTraceRegionType>( i );
+            const auto& regions = analysis.GetRegions( type );
+            const auto& referenceRegions = referenceAnalysis.GetRegions( type );
+
+            ASSERT_EQ( referenceRegions.size(), regions.size() );
+
+            for( const auto& [name, referenceStats] : referenceRegions )
+            {
+                ASSERT_EQ( 1u, regions.count( name ) ) << name;
+
+                const DeviceProfilerTraceRegionStats& stats = regions.at( name );
+                EXPECT_EQ( referenceStats.m_Count, stats.m_Count ) << name;
+                EXPECT_DOUBLE_EQ( referenceStats.m_TotalDuration, stats.m_TotalDuration ) << name;
+                EXPECT_DOUBLE_EQ( referenceStats.m_MinDuration, stats.m_MinDuration ) << name;
+                EXPECT_DOUBLE_EQ( referenceStats.m_MaxDuration, stats.m_MaxDuration ) << name;
+            }
+        }
+    }
+
+    TEST_F( ProfilerTraceAnalyzerULT, MissingTraceEvents )
+    {
+        const std::filesystem::path traceFilePath = std::filesystem::temp_directory_path() /
+            ( "profiler_trace_analyzer_MissingTraceEvents_" + std::to_string( ProfilerPlatformFunctions::GetCurrentProcessId() ) + ".json" );
+
+        std::ofstream( traceFilePath, std::ios::binary ) << "{\"displayTimeUnit\":\"ns\"}\n";
+        TraceFilePaths.push_back( traceFilePath );
+
+        DeviceProfilerTraceAnalyzer analyzer;
+        DeviceProfilerTraceAnalysis analysis;
+        EXPECT_FALSE( analyzer.Analyze( traceFilePath, analysis ) );
+        EXPECT_FALSE( analyzer.GetErrorMessage().empty() );
+    }
+
+    TEST_F( ProfilerTraceAnalyzerULT, InvalidEvent )
+    {
+        const std::filesystem::path traceFilePath = WriteTrace( {
+            Event( "B", "Pipelines", "A", "Queue", 0 ),
+            "{\"name\":\"A\",\"ph\":\"E\",\"cat\":\"Pipelines\",\"ts\":\"invalid\"}" } );
+
+        DeviceProfilerTraceAnalyzer analyzer;
+        DeviceProfilerTraceAnalysis analysis;
+        EXPECT_FALSE( analyzer.Analyze( traceFilePath, analysis ) );
+        EXPECT_FALSE( analyzer.GetErrorMessage().empty() );
+    }
+}
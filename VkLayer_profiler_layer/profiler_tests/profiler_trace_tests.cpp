@@ -0,0 +1,486 @@
+// Copyright (c) 2019-2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "profiler_testing_common.h"
+#include "profiler_frontend_stub.h"
+
+#include "profiler_trace/profiler_trace.h"
+#include "profiler_trace_analyzer/profiler_trace_analyzer.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <regex>
+#include <set>
+#include <sstream>
+
+namespace Profiler
+{
+    class ProfilerTraceULT : public testing::Test
+    {
+    protected:
+        DeviceProfilerFrontendStub Frontend;
+
+        // Returns a path in the temporary directory unique for the process and the test,
+        // so the tests can run in parallel.
+        static std::filesystem::path GetTempFilePath( const std::string& extension )
+        {
+            const testing::TestInfo* pTestInfo = testing::UnitTest::GetInstance()->current_test_info();
+            return std::filesystem::temp_directory_path() /
+                ( std::string( "profiler_trace_" ) +
+                    pTestInfo->name() + "_" +
+                    std::to_string( ProfilerPlatformFunctions::GetCurrentProcessId() ) +
+                    extension );
+        }
+
+        // Creates a command buffer with a single render pass containing drawcallCount draws.
+        static DeviceProfilerCommandBufferData CreateDrawcallCommandBuffer( uint32_t drawcallCount )
+        {
+            DeviceProfilerPipelineData pipeline;
+            pipeline.m_BeginTimestamp.m_Value = 1;
+            pipeline.m_EndTimestamp.m_Value = 2 * drawcallCount + 1;
+
+            for( uint32_t i = 0; i < drawcallCount; ++i )
+            {
+                DeviceProfilerDrawcall& drawcall = pipeline.m_Drawcalls.emplace_back();
+                drawcall.m_Type = DeviceProfilerDrawcallType::eDraw;
+                drawcall.m_Payload.m_Draw.m_VertexCount = 3;
+                drawcall.m_Payload.m_Draw.m_InstanceCount = 1;
+                drawcall.m_BeginTimestamp.m_Value = 2 * i + 1;
+                drawcall.m_EndTimestamp.m_Value = 2 * i + 2;
+            }
+
+            DeviceProfilerSubpassData subpass;
+            subpass.m_Index = DeviceProfilerSubpassData::ImplicitSubpassIndex;
+            subpass.m_BeginTimestamp = pipeline.m_BeginTimestamp;
+            subpass.m_EndTimestamp = pipeline.m_EndTimestamp;
+            subpass.m_Data.emplace_back( std::move( pipeline ) );
+
+            DeviceProfilerRenderPassData renderPass;
+            renderPass.m_BeginTimestamp = subpass.m_BeginTimestamp;
+            renderPass.m_EndTimestamp = subpass.m_EndTimestamp;
+            renderPass.m_Subpasses.push_back( std::move( subpass ) );
+
+            DeviceProfilerCommandBufferData commandBuffer;
+            commandBuffer.m_BeginTimestamp = renderPass.m_BeginTimestamp;
+            commandBuffer.m_EndTimestamp = renderPass.m_EndTimestamp;
+            commandBuffer.m_DataValid = true;
+            commandBuffer.m_RenderPasses.push_back( std::move( renderPass ) );
+
+            return commandBuffer;
+        }
+
+        // Creates a frame with a single submission of the command buffer.
+        static DeviceProfilerFrameData CreateFrame( DeviceProfilerCommandBufferData&& commandBuffer )
+        {
+            DeviceProfilerSubmitData submit;
+            submit.m_BeginTimestamp = commandBuffer.m_BeginTimestamp;
+            submit.m_EndTimestamp = commandBuffer.m_EndTimestamp;
+            submit.m_CommandBuffers.push_back( std::make_shared<DeviceProfilerCommandBufferData>( std::move( commandBuffer ) ) );
+
+            DeviceProfilerFrameData frame;
+            frame.m_BeginTimestamp = submit.m_BeginTimestamp.m_Value;
+            frame.m_EndTimestamp = submit.m_EndTimestamp.m_Value;
+            frame.m_Ticks = frame.m_EndTimestamp - frame.m_BeginTimestamp;
+            frame.m_SyncTimestamps.m_HostTimeDomain = OSGetDefaultTimeDomain();
+            frame.m_Submits.emplace_back().m_Submits.push_back( std::move( submit ) );
+
+            return frame;
+        }
+
+        // Creates a frame with a single command buffer containing drawcallCount draws.
+        static DeviceProfilerFrameData CreateDrawcallFrame( uint32_t drawcallCount )
+        {
+            return CreateFrame( CreateDrawcallCommandBuffer( drawcallCount ) );
+        }
+
+        // Configures the trace output to keep the given number of frames in memory until a capture is triggered.
+        std::filesystem::path ConfigureRingBuffer( uint32_t ringBufferSize )
+        {
+            const std::filesystem::path traceFilePath = GetTempFilePath( ".json" );
+            Frontend.m_Config.m_OutputTraceFile = traceFilePath.string();
+            Frontend.m_Config.m_EnableThreading = false;
+            Frontend.m_Config.m_TraceRingBufferSize = static_cast<int>( ringBufferSize );
+            return traceFilePath;
+        }
+
+        // Passes a frame with the given CPU frame time to the trace output.
+        void UpdateFrame( ProfilerTraceOutput& output, uint32_t frameIndex, float frameTimeMs = 1.f, bool hasTriggerLabel = false )
+        {
+            DeviceProfilerCommandBufferData commandBuffer = CreateDrawcallCommandBuffer( 1 );
+            commandBuffer.m_HasTraceTriggerLabel = hasTriggerLabel;
+
+            auto pFrame = std::make_shared<DeviceProfilerFrameData>( CreateFrame( std::move( commandBuffer ) ) );
+            pFrame->m_CPU.m_FrameIndex = frameIndex;
+            pFrame->m_CPU.m_BeginTimestamp = 0;
+            pFrame->m_CPU.m_EndTimestamp = static_cast<uint64_t>(
+                frameTimeMs * Frontend.GetHostTimestampFrequency( pFrame->m_SyncTimestamps.m_HostTimeDomain ) / 1000.f );
+
+            Frontend.m_Data.push_back( std::move( pFrame ) );
+            output.Update();
+        }
+
+        // Returns indices of the frames written to the trace file and removes the file.
+        static std::set<uint32_t> ReadFrameIndices( const std::filesystem::path& traceFilePath )
+        {
+            std::string trace;
+            {
+                std::ifstream traceFile( traceFilePath, std::ios::binary );
+                trace.assign( std::istreambuf_iterator<char>( traceFile ), std::istreambuf_iterator<char>() );
+            }
+
+            std::filesystem::remove( traceFilePath );
+
+            std::set<uint32_t> frameIndices;
+            const std::regex frameNameRegex( "\"name\":\"Frame #([0-9]+)\"" );
+            for( auto it = std::sregex_iterator( trace.begin(), trace.end(), frameNameRegex ); it != std::sregex_iterator(); ++it )
+            {
+                frameIndices.insert( static_cast<uint32_t>( std::stoul( ( *it )[ 1 ].str() ) ) );
+            }
+
+            return frameIndices;
+        }
+    };
+
+    // Benchmark of the trace serialization, disabled by default.
+    // Run with --gtest_also_run_disabled_tests to get the EventsPerSecond property.
+    TEST_F( ProfilerTraceULT, DISABLED_SerializeDrawcallsBenchmark )
+    {
+        const uint32_t drawcallCount = 100'000;
+        const DeviceProfilerFrameData frame = CreateDrawcallFrame( drawcallCount );
+
+        const std::filesystem::path traceFilePath = GetTempFilePath( ".json" );
+
+        DeviceProfilerTraceSerializer serializer( Frontend );
+        ASSERT_TRUE( serializer.OpenOutputFile( traceFilePath.string() ) );
+
+        const auto begin = std::chrono::steady_clock::now();
+        const bool succeeded = serializer.Serialize( frame );
+        const auto end = std::chrono::steady_clock::now();
+
+        ASSERT_TRUE( serializer.CloseOutputFile() );
+        ASSERT_TRUE( succeeded );
+
+        // Count the serialized events.
+        size_t eventCount = 0;
+        {
+            std::ifstream traceFile( traceFilePath, std::ios::binary );
+            const std::string trace( ( std::istreambuf_iterator<char>( traceFile ) ), std::istreambuf_iterator<char>() );
+
+            for( size_t offset = trace.find( "\"ph\":" ); offset != std::string::npos; offset = trace.find( "\"ph\":", offset + 1 ) )
+            {
+                eventCount++;
+            }
+        }
+
+        std::filesystem::remove( traceFilePath );
+
+        // Each drawcall is serialized as a pair of begin and end events.
+        EXPECT_LE( 2 * drawcallCount, eventCount );
+
+        const double seconds = std::chrono::duration<double>( end - begin ).count();
+        const double eventsPerSecond = ( seconds > 0 ) ? ( eventCount / seconds ) : 0;
+
+        RecordProperty( "EventCount", std::to_string( eventCount ) );
+        RecordProperty( "EventsPerSecond", std::to_string( static_cast<uint64_t>( eventsPerSecond ) ) );
+    }
+
+    TEST_F( ProfilerTraceULT, SkipNotSampledDrawcalls )
+    {
+        // Drawcalls not sampled with drawcall_sampling_rate > 1 have no timestamps.
+        DeviceProfilerCommandBufferData commandBuffer = CreateDrawcallCommandBuffer( 4 );
+        DeviceProfilerPipelineData& pipeline = std::get<DeviceProfilerPipelineData>(
+            commandBuffer.m_RenderPasses.front().m_Subpasses.front().m_Data.front() );
+
+        for( size_t i = 1; i < pipeline.m_Drawcalls.size(); i += 2 )
+        {
+            pipeline.m_Drawcalls[ i ].m_BeginTimestamp = DeviceProfilerTimestampValue();
+            pipeline.m_Drawcalls[ i ].m_EndTimestamp = DeviceProfilerTimestampValue();
+        }
+
+        const DeviceProfilerFrameData frame = CreateFrame( std::move( commandBuffer ) );
+
+        const std::filesystem::path traceFilePath = GetTempFilePath( ".json" );
+
+        DeviceProfilerTraceSerializer serializer( Frontend );
+        ASSERT_TRUE( serializer.OpenOutputFile( traceFilePath.string() ) );
+        ASSERT_TRUE( serializer.Serialize( frame ) );
+        ASSERT_TRUE( serializer.CloseOutputFile() );
+
+        std::string trace;
+        {
+            std::ifstream traceFile( traceFilePath, std::ios::binary );
+            trace.assign( std::istreambuf_iterator<char>( traceFile ), std::istreambuf_iterator<char>() );
+        }
+
+        std::filesystem::remove( traceFilePath );
+
+        // Only the begin and end events of the sampled drawcalls are written.
+        size_t drawcallEventCount = 0;
+        for( size_t offset = trace.find( "\"cat\":\"Drawcalls\"" ); offset != std::string::npos; offset = trace.find( "\"cat\":\"Drawcalls\"", offset + 1 ) )
+        {
+            drawcallEventCount++;
+        }
+
+        EXPECT_EQ( 4u, drawcallEventCount );
+    }
+
+    TEST_F( ProfilerTraceULT, SerializeCompressed )
+    {
+        if( !DeviceProfilerOutputFileStream::IsCompressionSupported( DeviceProfilerFileCompression::eZstd ) )
+        {
+            GTEST_SKIP() << "Compression is not supported in this build";
+        }
+
+        const DeviceProfilerFrameData frame = CreateDrawcallFrame( 1000 );
+
+        const std::filesystem::path traceFilePaths[] = {
+            GetTempFilePath( ".json" ),
+            GetTempFilePath( ".json.zst" ) };
+
+        std::string traces[ std::size( traceFilePaths ) ];
+
+        for( size_t i = 0; i < std::size( traceFilePaths ); ++i )
+        {
+            // Append more than one frame to check that the array of events is continued correctly.
+            DeviceProfilerTraceSerializer serializer( Frontend );
+            ASSERT_TRUE( serializer.OpenOutputFile( traceFilePaths[ i ].string() ) );
+            ASSERT_TRUE( serializer.Serialize( frame ) );
+            ASSERT_TRUE( serializer.Serialize( frame ) );
+            ASSERT_TRUE( serializer.CloseOutputFile() );
+
+            DeviceProfilerInputFileStream traceFile;
+            ASSERT_TRUE( traceFile.Open( traceFilePaths[ i ], std::ios::binary ) );
+            EXPECT_EQ( i > 0, traceFile.IsCompressed() );
+
+            traces[ i ].assign( std::istreambuf_iterator<char>( traceFile ), std::istreambuf_iterator<char>() );
+            traceFile.Close();
+
+            std::filesystem::remove( traceFilePaths[ i ] );
+        }
+
+        EXPECT_FALSE( traces[ 0 ].empty() );
+        EXPECT_EQ( traces[ 0 ], traces[ 1 ] );
+    }
+
+    TEST_F( ProfilerTraceULT, SerializeOneEventPerLine )
+    {
+        // The trace analyzer splits the traceEvents array at line boundaries,
+        // so each event must be written in a single line.
+        DeviceProfilerCommandBufferData commandBuffer = CreateDrawcallCommandBuffer( 1000 );
+        DeviceProfilerRenderPassData& renderPass = commandBuffer.m_RenderPasses.front();
+        renderPass.m_Type = DeviceProfilerRenderPassType::eGraphics;
+
+        DeviceProfilerPipelineData& pipeline = std::get<DeviceProfilerPipelineData>( renderPass.m_Subpasses.front().m_Data.front() );
+        pipeline.m_UsesShaderObjects = true;
+        pipeline.m_ShaderTuple.m_Hash = 0x1234;
+
+        const DeviceProfilerFrameData frame = CreateFrame( std::move( commandBuffer ) );
+
+        const std::filesystem::path traceFilePath = GetTempFilePath( ".json" );
+
+        DeviceProfilerTraceSerializer serializer( Frontend );
+        ASSERT_TRUE( serializer.OpenOutputFile( traceFilePath.string() ) );
+        ASSERT_TRUE( serializer.Serialize( frame ) );
+        ASSERT_TRUE( serializer.Serialize( frame ) );
+        ASSERT_TRUE( serializer.CloseOutputFile() );
+
+        std::string trace;
+        {
+            std::ifstream traceFile( traceFilePath, std::ios::binary );
+            trace.assign( std::istreambuf_iterator<char>( traceFile ), std::istreambuf_iterator<char>() );
+        }
+
+        // Each line of the array holds exactly one event.
+        const size_t eventsBegin = trace.find( '[' ) + 1;
+        const size_t eventsEnd = eventsBegin + DeviceProfilerTraceAnalyzer::FindEndOfEvents( std::string_view( trace ).substr( eventsBegin ) );
+        ASSERT_EQ( "]}", trace.substr( eventsEnd, 2 ) );
+
+        size_t eventCount = 0;
+        std::istringstream events( trace.substr( eventsBegin, eventsEnd - eventsBegin ) );
+        for( std::string line; std::getline( events, line ); )
+        {
+            if( line.empty() )
+            {
+                continue;
+            }
+
+            EXPECT_EQ( '{', line.front() ) << line;
+            EXPECT_EQ( "},", line.substr( line.size() - 2 ) ) << line;
+            EXPECT_EQ( line.find( "\"ph\":" ), line.rfind( "\"ph\":" ) ) << line;
+            eventCount++;
+        }
+
+        // Regions serialized by the layer are matched by the analyzer, including the ones split across chunks.
+        DeviceProfilerTraceAnalyzer analyzer;
+        analyzer.SetThreadCount( 4 );
+        analyzer.SetChunkSize( 0 );
+
+        DeviceProfilerTraceAnalysis analysis;
+        ASSERT_TRUE( analyzer.Analyze( traceFilePath, analysis ) ) << analyzer.GetErrorMessage();
+
+        std::filesystem::remove( traceFilePath );
+
+        EXPECT_EQ( eventCount, analysis.m_EventCount );
+
+        const auto& pipelines = analysis.GetRegions( DeviceProfilerTraceRegionType::ePipeline );
+        ASSERT_EQ( 1u, pipelines.size() );
+        EXPECT_EQ( 2u, pipelines.begin()->second.m_Count );
+
+        const auto& renderPasses = analysis.GetRegions( DeviceProfilerTraceRegionType::eRenderPass );
+        ASSERT_EQ( 1u, renderPasses.size() );
+        EXPECT_EQ( 2u, renderPasses.begin()->second.m_Count );
+    }
+
+    TEST_F( ProfilerTraceULT, CaptureOnTriggerWritesNothingUntilTriggered )
+    {
+        const std::filesystem::path traceFilePath = ConfigureRingBuffer( 4 );
+
+        ProfilerTraceOutput output( Frontend );
+        ASSERT_TRUE( output.Initialize() );
+
+        for( uint32_t i = 0; i < 8; ++i )
+        {
+            UpdateFrame( output, i );
+        }
+
+        output.Destroy();
+
+        EXPECT_TRUE( ReadFrameIndices( traceFilePath ).empty() );
+    }
+
+    TEST_F( ProfilerTraceULT, CaptureOnTriggerEvictsOldestFrames )
+    {
+        const std::filesystem::path traceFilePath = ConfigureRingBuffer( 2 );
+
+        ProfilerTraceOutput output( Frontend );
+        ASSERT_TRUE( output.Initialize() );
+
+        for( uint32_t i = 0; i < 5; ++i )
+        {
+            UpdateFrame( output, i );
+        }
+
+        // Only the most recent frames are kept in the ring buffer.
+        output.TriggerCapture();
+        UpdateFrame( output, 5 );
+
+        output.Destroy();
+
+        EXPECT_EQ( std::set<uint32_t>( { 4, 5 } ), ReadFrameIndices( traceFilePath ) );
+    }
+
+    TEST_F( ProfilerTraceULT, CaptureOnTriggerApi )
+    {
+        const std::filesystem::path traceFilePath = ConfigureRingBuffer( 4 );
+
+        ProfilerTraceOutput output( Frontend );
+        ASSERT_TRUE( output.Initialize() );
+
+        for( uint32_t i = 0; i < 3; ++i )
+        {
+            UpdateFrame( output, i );
+        }
+
+        // The trigger applies to the next frame, which is written with the buffered ones.
+        output.TriggerCapture();
+        UpdateFrame( output, 3 );
+
+        // Frames after the capture are buffered again.
+        UpdateFrame( output, 4 );
+
+        output.Destroy();
+
+        EXPECT_EQ( std::set<uint32_t>( { 0, 1, 2, 3 } ), ReadFrameIndices( traceFilePath ) );
+    }
+
+    TEST_F( ProfilerTraceULT, CaptureOnTriggerFrameTime )
+    {
+        const std::filesystem::path traceFilePath = ConfigureRingBuffer( 2 );
+        Frontend.m_Config.m_TraceTriggerFrameTime = 10.f;
+
+        ProfilerTraceOutput output( Frontend );
+        ASSERT_TRUE( output.Initialize() );
+
+        UpdateFrame( output, 0 );
+        UpdateFrame( output, 1 );
+        UpdateFrame( output, 2, 9.f );
+        UpdateFrame( output, 3, 20.f );
+        UpdateFrame( output, 4 );
+
+        output.Destroy();
+
+        EXPECT_EQ( std::set<uint32_t>( { 2, 3 } ), ReadFrameIndices( traceFilePath ) );
+    }
+
+    TEST_F( ProfilerTraceULT, CaptureOnTriggerDebugLabel )
+    {
+        const std::filesystem::path traceFilePath = ConfigureRingBuffer( 1 );
+        Frontend.m_Config.m_TraceTriggerDebugLabel = "Hitch";
+
+        ProfilerTraceOutput output( Frontend );
+        ASSERT_TRUE( output.Initialize() );
+
+        // The labels are matched when recorded, the trigger checks the command buffer flag.
+        UpdateFrame( output, 0 );
+        UpdateFrame( output, 1, 1.f, true );
+        UpdateFrame( output, 2 );
+
+        output.Destroy();
+
+        EXPECT_EQ( std::set<uint32_t>( { 1 } ), ReadFrameIndices( traceFilePath ) );
+    }
+
+    TEST_F( ProfilerTraceULT, CaptureOnTriggerPostFrameWindow )
+    {
+        const std::filesystem::path traceFilePath = ConfigureRingBuffer( 2 );
+        Frontend.m_Config.m_TraceTriggerPostFrameCount = 2;
+
+        ProfilerTraceOutput output( Frontend );
+        ASSERT_TRUE( output.Initialize() );
+
+        // Frames 2 and 3 precede the trigger, frames 4 and 5 follow it.
+        for( uint32_t i = 0; i < 8; ++i )
+        {
+            if( i == 3 )
+            {
+                output.TriggerCapture();
+            }
+
+            UpdateFrame( output, i );
+        }
+
+        // The next capture writes frame 7 from the ring buffer, frame 6 has been evicted.
+        // A trigger during the window extends it to 2 frames after the new triggering frame.
+        output.TriggerCapture();
+        UpdateFrame( output, 8 );
+        output.TriggerCapture();
+        UpdateFrame( output, 9 );
+        for( uint32_t i = 10; i < 14; ++i )
+        {
+            UpdateFrame( output, i );
+        }
+
+        output.Destroy();
+
+        EXPECT_EQ( std::set<uint32_t>( { 2, 3, 4, 5, 7, 8, 9, 10, 11 } ), ReadFrameIndices( traceFilePath ) );
+    }
+}
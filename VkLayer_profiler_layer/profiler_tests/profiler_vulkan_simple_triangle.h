@@ -40,7 +40,7 @@ namespace Profiler
         VkRect2D            RenderArea;
 
     public:
-        inline VulkanSimpleTriangle( VulkanState* Vk )
+        inline VulkanSimpleTriangle( VulkanState* Vk, const void* pPipelineCreateInfoNext = nullptr )
             : Vk( Vk )
             , RenderPass( VK_NULL_HANDLE )
             , Framebuffer( VK_NULL_HANDLE )
@@ -236,6 +236,7 @@ namespace Profiler
 
                 VkGraphicsPipelineCreateInfo createInfo = {};
                 createInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+                createInfo.pNext = pPipelineCreateInfoNext;
                 createInfo.layout = PipelineLayout;
                 createInfo.renderPass = RenderPass;
                 createInfo.subpass = 0;
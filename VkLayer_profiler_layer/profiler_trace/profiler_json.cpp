@@ -324,8 +324,9 @@ namespace Profiler
             argsBuilder
                 .Add( "infoCount", infoCount );
 
-            auto infosBuilder = argsBuilder.AddArray( "infos" );
-            for( uint32_t i = 0; i < infoCount; ++i )
+            // Build infos are not available if the payload could not be copied.
+            auto infosBuilder = argsBuilder.AddArrayOrNull( "infos", drawcall.m_Payload.m_BuildAccelerationStructures.m_pInfos != nullptr );
+            for( uint32_t i = 0; ( i < infoCount ) && infosBuilder; ++i )
             {
                 const auto& info = drawcall.m_Payload.m_BuildAccelerationStructures.m_pInfos[i];
 
@@ -413,8 +414,8 @@ namespace Profiler
             argsBuilder
                 .Add( "infoCount", infoCount );
 
-            auto infosBuilder = argsBuilder.AddArray( "infos" );
-            for( uint32_t i = 0; i < infoCount; ++i )
+            auto infosBuilder = argsBuilder.AddArrayOrNull( "infos", drawcall.m_Payload.m_BuildMicromaps.m_pInfos != nullptr );
+            for( uint32_t i = 0; ( i < infoCount ) && infosBuilder; ++i )
             {
                 const auto& info = drawcall.m_Payload.m_BuildMicromaps.m_pInfos[i];
 
@@ -460,7 +461,7 @@ namespace Profiler
         Serialize pipeline state into JSON object.
 
     \*************************************************************************/
-    void DeviceProfilerJsonSerializer::WritePipelineArgs( DeviceProfilerJsonValueBuilder& builder, const DeviceProfilerPipeline& pipeline ) const
+    void DeviceProfilerJsonSerializer::WritePipelineArgs( DeviceProfilerJsonValueBuilder& builder, const DeviceProfilerPipelineData& pipeline ) const
     {
         auto argsBuilder = builder.MakeObject();
 
@@ -500,6 +501,67 @@ namespace Profiler
             }
             }
         }
+
+        // Append pipeline statistics if collected.
+        WritePipelineStatisticsArgs( argsBuilder, pipeline.m_PipelineStatistics );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WriteRenderPassArgs
+
+    Description:
+        Serialize render pass data into JSON object.
+
+    \*************************************************************************/
+    void DeviceProfilerJsonSerializer::WriteRenderPassArgs( DeviceProfilerJsonValueBuilder& builder, const DeviceProfilerRenderPassData& renderPass ) const
+    {
+        auto argsBuilder = builder.MakeObject();
+
+        // Append pipeline statistics accumulated from all pipelines in the render pass.
+        WritePipelineStatisticsArgs( argsBuilder, renderPass.m_PipelineStatistics );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WritePipelineStatisticsArgs
+
+    Description:
+        Serialize collected pipeline statistics into JSON object.
+
+    \*************************************************************************/
+    void DeviceProfilerJsonSerializer::WritePipelineStatisticsArgs( DeviceProfilerJsonObjectBuilder& builder, const DeviceProfilerPipelineStatistics& statistics ) const
+    {
+        if( statistics.m_Flags == 0 )
+        {
+            return;
+        }
+
+        auto statisticsBuilder = builder.AddObject( "pipelineStatistics" );
+
+        auto AddStatistic = [&]( VkQueryPipelineStatisticFlagBits flag, std::string_view key, uint64_t value )
+        {
+            if( statistics.m_Flags & flag )
+            {
+                statisticsBuilder.Add( key, value );
+            }
+        };
+
+        AddStatistic( VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT, "inputAssemblyVertices", statistics.m_InputAssemblyVertices );
+        AddStatistic( VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT, "inputAssemblyPrimitives", statistics.m_InputAssemblyPrimitives );
+        AddStatistic( VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT, "vertexShaderInvocations", statistics.m_VertexShaderInvocations );
+        AddStatistic( VK_QUERY_PIPELINE_STATISTIC_GEOMETRY_SHADER_INVOCATIONS_BIT, "geometryShaderInvocations", statistics.m_GeometryShaderInvocations );
+        AddStatistic( VK_QUERY_PIPELINE_STATISTIC_GEOMETRY_SHADER_PRIMITIVES_BIT, "geometryShaderPrimitives", statistics.m_GeometryShaderPrimitives );
+        AddStatistic( VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT, "clippingInvocations", statistics.m_ClippingInvocations );
+        AddStatistic( VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT, "clippingPrimitives", statistics.m_ClippingPrimitives );
+        AddStatistic( VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT, "fragmentShaderInvocations", statistics.m_FragmentShaderInvocations );
+        AddStatistic( VK_QUERY_PIPELINE_STATISTIC_TESSELLATION_CONTROL_SHADER_PATCHES_BIT, "tessellationControlShaderPatches", statistics.m_TessellationControlShaderPatches );
+        AddStatistic( VK_QUERY_PIPELINE_STATISTIC_TESSELLATION_EVALUATION_SHADER_INVOCATIONS_BIT, "tessellationEvaluationShaderInvocations", statistics.m_TessellationEvaluationShaderInvocations );
+        AddStatistic( VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT, "computeShaderInvocations", statistics.m_ComputeShaderInvocations );
+
+        statisticsBuilder.End();
     }
 
     /*************************************************************************\
@@ -39,7 +39,8 @@ namespace Profiler
         DeviceProfilerJsonSerializer( const class DeviceProfilerStringSerializer* );
 
         void WriteCommandArgs( DeviceProfilerJsonValueBuilder&, const struct DeviceProfilerDrawcall& ) const;
-        void WritePipelineArgs( DeviceProfilerJsonValueBuilder&, const struct DeviceProfilerPipeline& ) const;
+        void WritePipelineArgs( DeviceProfilerJsonValueBuilder&, const struct DeviceProfilerPipelineData& ) const;
+        void WriteRenderPassArgs( DeviceProfilerJsonValueBuilder&, const struct DeviceProfilerRenderPassData& ) const;
 
     private:
         const class DeviceProfilerStringSerializer* m_pStringSerializer;
@@ -47,6 +48,7 @@ namespace Profiler
         void WriteColorClearValue( DeviceProfilerJsonValueBuilder&, const VkClearColorValue& ) const;
         void WriteDepthStencilClearValue( DeviceProfilerJsonValueBuilder&, const VkClearDepthStencilValue& ) const;
         void WriteShaderStageArgs( DeviceProfilerJsonValueBuilder&, const struct ProfilerShader& ) const;
+        void WritePipelineStatisticsArgs( DeviceProfilerJsonObjectBuilder&, const struct DeviceProfilerPipelineStatistics& ) const;
         void WriteGraphicsPipelineCreateInfoArgs( DeviceProfilerJsonObjectBuilder&, const VkGraphicsPipelineCreateInfo& ) const;
         void WriteComputePipelineCreateInfoArgs( DeviceProfilerJsonObjectBuilder&, const VkComputePipelineCreateInfo& ) const;
         void WriteRayTracingPipelineCreateInfoArgs( DeviceProfilerJsonObjectBuilder&, const VkRayTracingPipelineCreateInfoKHR& ) const;
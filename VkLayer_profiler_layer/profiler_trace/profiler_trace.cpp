@@ -30,6 +30,7 @@
 
 #include "VkLayer_profiler_layer.generated.h"
 
+#include <algorithm>
 #include <chrono>
 #include <fstream>
 #include <sstream>
@@ -91,6 +92,9 @@ namespace
         out << ',' << lf;
         return out;
     }
+
+    // Interval between the checks of the trace trigger file.
+    static constexpr uint64_t TriggerFileCheckPeriodMs = 500;
 }
 
 namespace Profiler
@@ -114,6 +118,7 @@ namespace Profiler
         , m_CommandQueue( VK_NULL_HANDLE )
         , m_JsonBuilder()
         , m_DebugLabelStackDepth( 0 )
+        , m_FlowEventId( 0 )
         , m_HostTimeDomain( OSGetDefaultTimeDomain() )
         , m_HostCalibratedTimestamp( 0 )
         , m_DeviceCalibratedTimestamp( 0 )
@@ -147,16 +152,32 @@ namespace Profiler
     Description:
         Open output file for writing the trace.
 
+        Files with .zst extension are always compressed. The compression runs
+        on the worker threads of the compression library.
+
     \*************************************************************************/
-    bool DeviceProfilerTraceSerializer::OpenOutputFile( const std::string& fileName )
+    bool DeviceProfilerTraceSerializer::OpenOutputFile( const std::string& fileName, DeviceProfilerFileCompression compression )
     {
         // Clear exceptions mask to prevent throwing any exceptions from the stream functions.
         m_OutputFile.exceptions( std::ios::iostate( 0 ) );
 
+        if( compression == DeviceProfilerFileCompression::eNone )
+        {
+            compression = DeviceProfilerOutputFileStream::GetCompressionFromFileName( fileName );
+        }
+
+        if( !DeviceProfilerOutputFileStream::IsCompressionSupported( compression ) )
+        {
+            m_ErrorMessages.push_back( "Compression is not supported in this build, writing uncompressed trace." );
+            compression = DeviceProfilerFileCompression::eNone;
+        }
+
         try
         {
             // Open the file for writing.
-            m_OutputFile.open( fileName, std::ios::out | std::ios::trunc | std::ios::binary );
+            // Leave most of the cores to the application and the serialization thread.
+            m_OutputFile.Open( fileName, std::ios::trunc | std::ios::binary, compression,
+                std::clamp( std::thread::hardware_concurrency() / 4, 1U, 4U ) );
         }
         catch( const std::ios_base::failure& )
         {
@@ -175,7 +196,14 @@ namespace Profiler
             m_OutputFile << '{';
             m_OutputFile << "\"displayTimeUnit\":\"ns\"," << lf;
             m_OutputFile << " \"otherData\":{}," << lf;
-            m_OutputFile << " \"traceEvents\":[" << eof;
+            m_OutputFile << " \"traceEvents\":[";
+
+            // Compressed file cannot be repositioned to insert the events before the end of the array.
+            // The end is written when the file is closed.
+            if( !m_OutputFile.IsCompressed() )
+            {
+                m_OutputFile << eof;
+            }
 
             m_OutputFileEmpty = true;
         }
@@ -204,11 +232,16 @@ namespace Profiler
     \*************************************************************************/
     bool DeviceProfilerTraceSerializer::CloseOutputFile()
     {
-        if( m_OutputFile.is_open() )
+        if( m_OutputFile.IsOpen() )
         {
             try
             {
-                m_OutputFile.close();
+                if( m_OutputFile.IsCompressed() )
+                {
+                    m_OutputFile << eof;
+                }
+
+                m_OutputFile.Close();
             }
             catch( const std::ios_base::failure& )
             {
@@ -231,6 +264,8 @@ namespace Profiler
         AppendEventsToOutputFile
 
     Description:
+        Write the serialized events to the output file. Uncompressed file
+        is kept valid after each write.
 
     \*************************************************************************/
     bool DeviceProfilerTraceSerializer::AppendEventsToOutputFile()
@@ -243,8 +278,13 @@ namespace Profiler
 
         try
         {
+            const bool compressed = m_OutputFile.IsCompressed();
+
             // Remove last 3 characters ("]}" + lf)
-            m_OutputFile.seekp( -eof_len, std::ios::end );
+            if( !compressed )
+            {
+                m_OutputFile.seekp( -eof_len, std::ios::end );
+            }
 
             // Continue the array
             if( !m_OutputFileEmpty )
@@ -256,11 +296,21 @@ namespace Profiler
                 m_OutputFile << lf;
             }
 
-            m_OutputFile << m_JsonBuilder.view() << std::flush;
+            if( !compressed )
+            {
+                m_OutputFile << m_JsonBuilder.view() << std::flush;
 
-            // Remove the last comma and insert end of array and end of object
-            m_OutputFile.seekp( -eol_len, std::ios::end );
-            m_OutputFile << eof;
+                // Remove the last comma and insert end of array and end of object
+                m_OutputFile.seekp( -eol_len, std::ios::end );
+                m_OutputFile << eof;
+            }
+            else
+            {
+                // Skip the last comma, the end of array is written when the file is closed.
+                // Don't flush the compressed stream to let the workers compress the data in the background.
+                const std::string_view events = m_JsonBuilder.view();
+                m_OutputFile.write( events.data(), static_cast<std::streamsize>( events.size() ) - eol_len );
+            }
 
             m_OutputFileEmpty = false;
         }
@@ -326,37 +376,65 @@ namespace Profiler
 
             for( const auto& submitData : submitBatchData.m_Submits )
             {
-                #if ENABLE_FLOW_EVENTS
-                for( const auto& waitSemaphore : submitData.m_WaitSemaphores )
+                // Insert idle time preceding the submit
+                if( submitData.m_IdleReason != DeviceProfilerQueueIdleReason::eNone )
                 {
-                    AppendEvent( TraceEvent(
-                        TraceEvent::Phase::eFlowEnd,
-                        m_pStringSerializer->GetName( waitSemaphore ),
-                        "Synchronization",
-                        GetNormalizedGpuTimestamp( submitData.m_BeginTimestamp.m_Value ),
+                    const std::string idleName = "Idle: " + m_pStringSerializer->GetQueueIdleReasonName( submitData.m_IdleReason );
+
+                    AppendEvent( TraceCompleteEvent(
+                        idleName,
+                        "Idle",
+                        GetNormalizedGpuTimestamp( submitData.m_BeginTimestamp.m_Value - submitData.m_IdleTicks ),
+                        submitData.m_IdleTicks * m_GpuTimestampPeriod,
                         m_CommandQueue ) );
                 }
-                #endif
 
-                for( const auto& commandBufferData : submitData.m_CommandBuffers )
+                // Insert range of the submit on the critical path of the frame
+                if( submitData.m_CriticalPath )
                 {
-                    Serialize( commandBufferData );
+                    AppendEvent( TraceCompleteEvent(
+                        "Critical path",
+                        "Critical path",
+                        GetNormalizedGpuTimestamp( submitData.m_BeginTimestamp.m_Value ),
+                        GetDuration( submitData ),
+                        m_CommandQueue ) );
                 }
 
-                #if ENABLE_FLOW_EVENTS
-                for( const auto& signalSemaphpre : submitData.m_SignalSemaphores )
+                for( const auto& pCommandBufferData : submitData.m_CommandBuffers )
                 {
-                    AppendEvent( TraceEvent(
-                        TraceEvent::Phase::eFlowStart,
-                        m_pStringSerializer->GetName( signalSemaphpre ),
-                        "Synchronization",
-                        GetNormalizedGpuTimestamp( submitData.m_EndTimestamp.m_Value ),
-                        m_CommandQueue ) );
+                    Serialize( *pCommandBufferData );
                 }
-                #endif
             }
         }
 
+        // Connect the submits synchronized with semaphores
+        for( const DeviceProfilerSemaphoreDependencyData& dependency : data.m_SemaphoreDependencies )
+        {
+            const DeviceProfilerSubmitBatchData& signalSubmitBatch = data.m_Submits[ dependency.m_SignalSubmit.m_SubmitBatchIndex ];
+            const DeviceProfilerSubmitData& signalSubmit = signalSubmitBatch.m_Submits[ dependency.m_SignalSubmit.m_SubmitIndex ];
+            const DeviceProfilerSubmitBatchData& waitSubmitBatch = data.m_Submits[ dependency.m_WaitSubmit.m_SubmitBatchIndex ];
+            const DeviceProfilerSubmitData& waitSubmit = waitSubmitBatch.m_Submits[ dependency.m_WaitSubmit.m_SubmitIndex ];
+
+            const std::string semaphoreName = m_pStringSerializer->GetName( dependency.m_Semaphore );
+            const uint64_t flowEventId = m_FlowEventId++;
+
+            AppendEvent( TraceFlowEvent(
+                TraceEvent::Phase::eFlowStart,
+                flowEventId,
+                semaphoreName,
+                "Synchronization",
+                GetNormalizedGpuTimestamp( signalSubmit.m_EndTimestamp.m_Value ),
+                signalSubmitBatch.m_Handle ) );
+
+            AppendEvent( TraceFlowEvent(
+                TraceEvent::Phase::eFlowEnd,
+                flowEventId,
+                semaphoreName,
+                "Synchronization",
+                GetNormalizedGpuTimestamp( waitSubmit.m_BeginTimestamp.m_Value ),
+                waitSubmitBatch.m_Handle ) );
+        }
+
         if( data.m_FrameDelimiter == VK_PROFILER_FRAME_DELIMITER_PRESENT_EXT )
         {
             // Insert present event
@@ -406,6 +484,47 @@ namespace Profiler
                 performanceCounterSamples.data() ) );
         }
 
+        // Insert events for hitches detected in the frame
+        for( const DeviceProfilerHitchData& hitch : data.m_Hitches )
+        {
+            const std::string hitchName = "Hitch: " + m_pStringSerializer->GetName( hitch, false /*showEntryPoints*/ );
+
+            AppendEvent( TraceInstantEvent(
+                TraceInstantEvent::Scope::eGlobal,
+                hitchName,
+                "Hitches",
+                frameGpuEndTimestamp,
+                VK_NULL_HANDLE,
+                TraceEventArgs( hitch ) ) );
+        }
+
+        // Insert profiler overhead counters
+        const Milliseconds frameCpuEndTimestamp = GetNormalizedCpuTimestamp( data.m_CPU.m_EndTimestamp );
+
+        AppendEvent( TraceEvent(
+            TraceEvent::Phase::eCounter,
+            "Profiler CPU time (ms)",
+            "Overhead",
+            frameCpuEndTimestamp,
+            VK_NULL_HANDLE,
+            TraceEventArgs( TraceEventArgs::Type::eCpuOverhead, data.m_Overhead ) ) );
+
+        AppendEvent( TraceEvent(
+            TraceEvent::Phase::eCounter,
+            "Profiler host memory (MB)",
+            "Overhead",
+            frameCpuEndTimestamp,
+            VK_NULL_HANDLE,
+            TraceEventArgs( TraceEventArgs::Type::eHostMemoryOverhead, data.m_Overhead ) ) );
+
+        AppendEvent( TraceEvent(
+            TraceEvent::Phase::eCounter,
+            "Profiler GPU memory (MB)",
+            "Overhead",
+            frameCpuEndTimestamp,
+            VK_NULL_HANDLE,
+            TraceEventArgs( TraceEventArgs::Type::eGpuMemoryOverhead, data.m_Overhead ) ) );
+
         AppendEvent( TraceEvent(
             TraceEvent::Phase::eDurationEnd,
             frameName,
@@ -416,6 +535,12 @@ namespace Profiler
         // Insert TIP events
         Serialize( data.m_TIP );
 
+        // Serialize pipeline compilations completed in the frame
+        Serialize( data.m_PipelineCompilations );
+
+        // Serialize command buffer recording and queue submissions on the application threads
+        Serialize( data.m_CPU.m_Spans );
+
         // Write the serialized events to the output file
         bool result = AppendEventsToOutputFile();
 
@@ -644,13 +769,21 @@ namespace Profiler
 
         if( isValidRenderPass )
         {
+            // Attach pipeline statistics to the render pass if collected.
+            TraceEventArgs args;
+            if( data.m_PipelineStatistics.m_Flags != 0 )
+            {
+                args = TraceEventArgs( data );
+            }
+
             // Begin
             AppendEvent( TraceEvent(
                 TraceEvent::Phase::eDurationBegin,
                 eventName,
                 "Render passes",
                 GetNormalizedGpuTimestamp( data.m_BeginTimestamp.m_Value ),
-                m_CommandQueue ) );
+                m_CommandQueue,
+                args ) );
 
             if( (data.HasBeginCommand()) &&
                 (data.m_Begin.m_BeginTimestamp.m_Value != UINT64_MAX) )
@@ -750,7 +883,7 @@ namespace Profiler
                 break;
 
             case DeviceProfilerSubpassDataType::eCommandBuffer:
-                Serialize( std::get<DeviceProfilerCommandBufferData>( data ) );
+                Serialize( *std::get<DeviceProfilerCommandBufferDataPtr>( data ) );
                 break;
             }
         }
@@ -793,8 +926,7 @@ namespace Profiler
                 "Pipelines",
                 GetNormalizedGpuTimestamp( data.m_BeginTimestamp.m_Value ),
                 m_CommandQueue,
-                {},
-                [&]( DeviceProfilerJsonValueBuilder& builder ) { m_pJsonSerializer->WritePipelineArgs( builder, data ); } ) );
+                TraceEventArgs( data ) ) );
         }
 
         for( const auto& drawcall : data.m_Drawcalls )
@@ -831,7 +963,7 @@ namespace Profiler
     {
         if( data.GetPipelineType() != DeviceProfilerPipelineType::eDebug )
         {
-            const std::string eventName = m_pStringSerializer->GetCommandName( data );
+            const std::string_view eventName = m_pStringSerializer->GetCommandName( data );
 
             // Cannot use complete events due to loss of precision
             AppendEvent( TraceEvent(
@@ -840,8 +972,7 @@ namespace Profiler
                 "Drawcalls",
                 GetNormalizedGpuTimestamp( data.m_BeginTimestamp.m_Value ),
                 m_CommandQueue,
-                {},
-                [&]( DeviceProfilerJsonValueBuilder& builder ) { m_pJsonSerializer->WriteCommandArgs( builder, data ); } ) );
+                TraceEventArgs( data ) ) );
 
             AppendEvent( TraceEvent(
                 TraceEvent::Phase::eDurationEnd,
@@ -919,11 +1050,100 @@ namespace Profiler
     Function:
         Serialize
 
+    Description:
+        Insert pipeline compilation events on the threads that created the
+        pipelines. Creation feedback reported by the driver is added to the
+        event arguments.
+
+    \*************************************************************************/
+    void DeviceProfilerTraceSerializer::Serialize( const std::vector<DeviceProfilerPipelineCompilationData>& compilations )
+    {
+        for( const DeviceProfilerPipelineCompilationData& compilation : compilations )
+        {
+            std::string eventName = ( compilation.m_Pipelines.size() == 1 )
+                ? "Compile " + m_pStringSerializer->GetName( DeviceProfilerPipelineData( compilation.m_Pipelines.front().m_Pipeline ), false /*showEntryPoints*/ )
+                : "Compile " + std::to_string( compilation.m_Pipelines.size() ) + " pipelines";
+
+            AppendEvent( ApiTraceEvent(
+                TraceEvent::Phase::eDurationBegin,
+                eventName,
+                compilation.m_ThreadId,
+                GetNormalizedCpuTimestamp( compilation.m_BeginTimestamp ),
+                TraceEventArgs( compilation ) ) );
+
+            AppendEvent( ApiTraceEvent(
+                TraceEvent::Phase::eDurationEnd,
+                eventName,
+                compilation.m_ThreadId,
+                GetNormalizedCpuTimestamp( compilation.m_EndTimestamp ) ) );
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Serialize
+
+    Description:
+        Insert CPU spans on the threads of the application. The CPU timestamps
+        are aligned with the GPU timestamps using the calibrated timestamps, so
+        the spans can be compared with the GPU execution.
+
+    \*************************************************************************/
+    void DeviceProfilerTraceSerializer::Serialize( const std::vector<DeviceProfilerCpuSpanData>& spans )
+    {
+        for( const DeviceProfilerCpuSpanData& span : spans )
+        {
+            std::string eventName;
+            switch( span.m_Type )
+            {
+            case DeviceProfilerCpuSpanType::eCommandBufferRecording:
+                eventName = "Record " + m_pStringSerializer->GetName( span.m_CommandBuffer );
+                break;
+
+            case DeviceProfilerCpuSpanType::eQueueSubmit:
+                eventName = "Submit " + m_pStringSerializer->GetName( span.m_Queue );
+                break;
+
+            case DeviceProfilerCpuSpanType::eQueuePresent:
+                eventName = "Present " + m_pStringSerializer->GetName( span.m_Queue );
+                break;
+            }
+
+            AppendEvent( ApiTraceEvent(
+                TraceEvent::Phase::eDurationBegin,
+                eventName,
+                span.m_ThreadId,
+                GetNormalizedCpuTimestamp( span.m_BeginTimestamp ) ) );
+
+            AppendEvent( ApiTraceEvent(
+                TraceEvent::Phase::eDurationEnd,
+                eventName,
+                span.m_ThreadId,
+                GetNormalizedCpuTimestamp( span.m_EndTimestamp ) ) );
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        AppendEvent
+
+    Description:
+        Write the event directly to the JSON builder.
+
     \*************************************************************************/
     void DeviceProfilerTraceSerializer::AppendEvent( const TraceEvent& event )
     {
         DeviceProfilerJsonObjectBuilder builder( m_JsonBuilder );
         event.Serialize( builder );
+
+        if( !event.m_Args.IsEmpty() )
+        {
+            auto argsBuilder = builder.Add( "args" );
+            AppendEventArgs( argsBuilder, event.m_Args );
+        }
+
         builder.End();
 
         m_JsonBuilder.append_raw( ",\n" );
@@ -931,11 +1151,126 @@ namespace Profiler
 
     /*************************************************************************\
 
+    Function:
+        AppendEventArgs
+
+    Description:
+        Write arguments of the event from the referenced profiling data.
+
+    \*************************************************************************/
+    void DeviceProfilerTraceSerializer::AppendEventArgs( DeviceProfilerJsonValueBuilder& builder, const TraceEventArgs& args )
+    {
+        switch( args.m_Type )
+        {
+        case TraceEventArgs::Type::eNone:
+            break;
+
+        case TraceEventArgs::Type::eCommand:
+        {
+            m_pJsonSerializer->WriteCommandArgs( builder, *args.m_pCommand );
+            break;
+        }
+
+        case TraceEventArgs::Type::ePipeline:
+        {
+            m_pJsonSerializer->WritePipelineArgs( builder, *args.m_pPipeline );
+            break;
+        }
+
+        case TraceEventArgs::Type::eRenderPass:
+        {
+            m_pJsonSerializer->WriteRenderPassArgs( builder, *args.m_pRenderPass );
+            break;
+        }
+
+        case TraceEventArgs::Type::eHitch:
+        {
+            const DeviceProfilerHitchData& hitch = *args.m_pHitch;
+
+            auto argsBuilder = builder.MakeObject();
+            argsBuilder.Add( "frameIndex", hitch.m_FrameIndex );
+            argsBuilder.Add( "durationMs", ( hitch.m_Ticks * m_GpuTimestampPeriod ).count() );
+            argsBuilder.Add( "averageMs", ( hitch.m_MeanTicks * m_GpuTimestampPeriod ).count() );
+            argsBuilder.Add( "stdDevMs", ( hitch.m_StdDevTicks * m_GpuTimestampPeriod ).count() );
+            argsBuilder.Add( "p99Ms", ( hitch.m_P99Ticks * m_GpuTimestampPeriod ).count() );
+            break;
+        }
+
+        case TraceEventArgs::Type::ePipelineCompilation:
+        {
+            const DeviceProfilerPipelineCompilationData& compilation = *args.m_pPipelineCompilation;
+
+            auto argsBuilder = builder.MakeObject();
+            argsBuilder.Add( "deferred", compilation.m_Deferred );
+
+            auto pipelinesBuilder = argsBuilder.AddArray( "pipelines" );
+            for( const DeviceProfilerPipelineCreationFeedbackData& feedback : compilation.m_Pipelines )
+            {
+                auto pipelineBuilder = pipelinesBuilder.AddObject();
+                pipelineBuilder.Add( "name", m_pStringSerializer->GetName( DeviceProfilerPipelineData( feedback.m_Pipeline ), false /*showEntryPoints*/ ) );
+
+                if( feedback.HasFeedback() )
+                {
+                    pipelineBuilder.Add( "cacheHit", feedback.IsCacheHit() );
+                    pipelineBuilder.Add( "durationMs", feedback.m_Duration / 1'000'000.0 );
+
+                    auto stagesBuilder = pipelineBuilder.AddArray( "stages" );
+                    for( const DeviceProfilerPipelineCreationFeedbackData::Stage& stage : feedback.m_Stages )
+                    {
+                        auto stageBuilder = stagesBuilder.AddObject();
+                        stageBuilder.Add( "stage", m_pStringSerializer->GetShaderStageName( stage.m_Stage ) );
+                        stageBuilder.Add( "cacheHit", ( stage.m_Flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT ) != 0 );
+                        stageBuilder.Add( "durationMs", stage.m_Duration / 1'000'000.0 );
+                    }
+                }
+            }
+            break;
+        }
+
+        case TraceEventArgs::Type::eCpuOverhead:
+        {
+            const DeviceProfilerOverheadData& overhead = *args.m_pOverhead;
+
+            auto argsBuilder = builder.MakeObject();
+            argsBuilder.Add( "commandRecording", overhead.GetCpuTime( DeviceProfilerCpuOverheadCategory::eCommandRecording ) / 1'000'000.0 );
+            argsBuilder.Add( "queueSubmission", overhead.GetCpuTime( DeviceProfilerCpuOverheadCategory::eQueueSubmission ) / 1'000'000.0 );
+            argsBuilder.Add( "dataResolve", overhead.GetCpuTime( DeviceProfilerCpuOverheadCategory::eDataResolve ) / 1'000'000.0 );
+            argsBuilder.Add( "output", overhead.GetCpuTime( DeviceProfilerCpuOverheadCategory::eOutput ) / 1'000'000.0 );
+            break;
+        }
+
+        case TraceEventArgs::Type::eHostMemoryOverhead:
+        {
+            const DeviceProfilerOverheadData& overhead = *args.m_pOverhead;
+
+            auto argsBuilder = builder.MakeObject();
+            argsBuilder.Add( "frameData", overhead.GetHostMemory( DeviceProfilerHostMemoryOverheadCategory::eFrameData ) / 1048576.0 );
+            argsBuilder.Add( "memorySnapshots", overhead.GetHostMemory( DeviceProfilerHostMemoryOverheadCategory::eMemorySnapshots ) / 1048576.0 );
+            argsBuilder.Add( "shaderBytecode", overhead.GetHostMemory( DeviceProfilerHostMemoryOverheadCategory::eShaderBytecode ) / 1048576.0 );
+            argsBuilder.Add( "pipelineCreateInfos", overhead.GetHostMemory( DeviceProfilerHostMemoryOverheadCategory::ePipelineCreateInfos ) / 1048576.0 );
+            break;
+        }
+
+        case TraceEventArgs::Type::eGpuMemoryOverhead:
+        {
+            const DeviceProfilerOverheadData& overhead = *args.m_pOverhead;
+
+            auto argsBuilder = builder.MakeObject();
+            argsBuilder.Add( "queryPools", overhead.GetGpuMemory( DeviceProfilerGpuMemoryOverheadCategory::eQueryPools ) / 1048576.0 );
+            argsBuilder.Add( "queryDataBuffers", overhead.GetGpuMemory( DeviceProfilerGpuMemoryOverheadCategory::eQueryDataBuffers ) / 1048576.0 );
+            argsBuilder.Add( "indirectArguments", overhead.GetGpuMemory( DeviceProfilerGpuMemoryOverheadCategory::eIndirectArguments ) / 1048576.0 );
+            break;
+        }
+        }
+    }
+
+    /*************************************************************************\
+
     Function:
         ConstructTraceFileName
 
     \*************************************************************************/
-    std::string DeviceProfilerTraceSerializer::GetDefaultTraceFileName( int samplingMode )
+    std::string DeviceProfilerTraceSerializer::GetDefaultTraceFileName( int samplingMode, DeviceProfilerFileCompression compression )
     {
         using namespace std::chrono;
 
@@ -957,6 +1292,11 @@ namespace Profiler
         stringBuilder << "_" << GetSamplingModeComponent( samplingMode );
         stringBuilder << ".json";
 
+        if( compression == DeviceProfilerFileCompression::eZstd )
+        {
+            stringBuilder << ".zst";
+        }
+
         return stringBuilder.str();
     }
 
@@ -1012,14 +1352,35 @@ namespace Profiler
         SetMaxFrameCount( config.m_FrameCount );
         SetSkipFrameCount( config.m_FrameSkipCount );
 
+        if( config.m_TraceRingBufferSize > 0 )
+        {
+            m_RingBufferSize = static_cast<uint32_t>( config.m_TraceRingBufferSize );
+            m_TriggerFrameTime = Milliseconds( config.m_TraceTriggerFrameTime );
+            m_TriggerDebugLabel = config.m_TraceTriggerDebugLabel;
+            m_TriggerFile = config.m_TraceTriggerFile;
+            m_PostTriggerFrameCount = static_cast<uint32_t>( std::max( config.m_TraceTriggerPostFrameCount, 0 ) );
+
+            if( !m_TriggerFile.empty() )
+            {
+                // Remove the trigger left by the previous run, so it doesn't capture the first frames.
+                std::error_code error;
+                std::filesystem::remove( m_TriggerFile, error );
+            }
+        }
+
+        const DeviceProfilerFileCompression compression = ( config.m_OutputCompression == output_compression_t::zstd )
+            ? DeviceProfilerFileCompression::eZstd
+            : DeviceProfilerFileCompression::eNone;
+
         std::string outputFileName = config.m_OutputTraceFile;
         if( outputFileName.empty() )
         {
             outputFileName = DeviceProfilerTraceSerializer::GetDefaultTraceFileName(
-                m_Frontend.GetProfilerSamplingMode() );
+                m_Frontend.GetProfilerSamplingMode(),
+                compression );
         }
 
-        if( !m_pTraceSerializer->OpenOutputFile( outputFileName ) )
+        if( !m_pTraceSerializer->OpenOutputFile( outputFileName, compression ) )
         {
             Destroy();
             return false;
@@ -1092,8 +1453,13 @@ namespace Profiler
         auto pData = m_Frontend.GetData();
         while( pData )
         {
+            if( m_RingBufferSize > 0 )
+            {
+                UpdateRingBuffer( pData );
+            }
+
             // Rough check to avoid locking mutex if not needed.
-            if( m_ProcessedFrameCount <= totalFrameCount )
+            else if( m_ProcessedFrameCount <= totalFrameCount )
             {
                 std::scoped_lock lock( m_TraceSerializerMutex );
 
@@ -1103,18 +1469,7 @@ namespace Profiler
                 }
                 else if( m_ProcessedFrameCount <= totalFrameCount )
                 {
-                    if( m_TraceSerializationThreadRunning )
-                    {
-                        std::scoped_lock lock( m_FrameDataQueueMutex );
-                        m_FrameDataQueue.push( pData );
-                        m_TraceSerializationThreadInputAvailable.notify_one();
-                    }
-                    else
-                    {
-                        m_pTraceSerializer->Serialize( *pData );
-                        HandleErrorMessages();
-                    }
-
+                    SerializeFrame( pData );
                     m_ProcessedFrameCount++;
                 }
             }
@@ -1169,6 +1524,21 @@ namespace Profiler
 
     /*************************************************************************\
 
+    Function:
+        TriggerCapture
+
+    Description:
+        Requests the frames kept in the ring buffer to be written to the file
+        on the next update. Can be called from any thread.
+
+    \*************************************************************************/
+    void ProfilerTraceOutput::TriggerCapture()
+    {
+        m_CaptureTriggered = true;
+    }
+
+    /*************************************************************************\
+
     Function:
         ResetMembers
 
@@ -1190,6 +1560,154 @@ namespace Profiler
         m_TraceSerializationThreadQuitSignal = false;
 
         m_FrameDataQueue = {};
+
+        m_RingBufferSize = 0;
+        m_RingBuffer.clear();
+        m_CaptureTriggered = false;
+        m_PostTriggerFrameCount = 0;
+        m_RemainingCaptureFrameCount = 0;
+
+        m_TriggerFrameTime = Milliseconds( 0 );
+        m_TriggerDebugLabel.clear();
+        m_TriggerFile.clear();
+        m_TriggerFileCheckTimestamp = 0;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        SerializeFrame
+
+    Description:
+        Passes the frame to the serialization thread or serializes it
+        immediately if threading is disabled.
+
+        m_TraceSerializerMutex must be locked before calling this function.
+
+    \*************************************************************************/
+    void ProfilerTraceOutput::SerializeFrame( const std::shared_ptr<DeviceProfilerFrameData>& pData )
+    {
+        if( m_TraceSerializationThreadRunning )
+        {
+            std::scoped_lock lock( m_FrameDataQueueMutex );
+            m_FrameDataQueue.push( pData );
+            m_TraceSerializationThreadInputAvailable.notify_one();
+        }
+        else
+        {
+            m_pTraceSerializer->Serialize( *pData );
+            HandleErrorMessages();
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        UpdateRingBuffer
+
+    Description:
+        Appends the frame to the ring buffer and writes all buffered frames
+        to the file if a capture has been triggered. The frames that follow
+        the triggering frame are written as they arrive, until the configured
+        number of post-trigger frames is reached.
+
+        The frames are shared with the frontend, so keeping them in the ring
+        buffer does not copy any data.
+
+    \*************************************************************************/
+    void ProfilerTraceOutput::UpdateRingBuffer( const std::shared_ptr<DeviceProfilerFrameData>& pData )
+    {
+        m_RingBuffer.push_back( pData );
+
+        if( m_RingBuffer.size() > m_RingBufferSize )
+        {
+            m_RingBuffer.pop_front();
+        }
+
+        // Check the triggers even if the capture has been requested to consume the trigger file.
+        const bool captureTriggered = CheckCaptureTriggers( *pData );
+
+        if( m_CaptureTriggered.exchange( false ) || captureTriggered )
+        {
+            // Write the triggering frame and the frames that follow it.
+            // A trigger that fires during the capture extends it.
+            m_RemainingCaptureFrameCount = m_PostTriggerFrameCount + 1;
+        }
+
+        if( m_RemainingCaptureFrameCount > 0 )
+        {
+            std::scoped_lock lock( m_TraceSerializerMutex );
+
+            // The first write flushes the frames that preceded the trigger.
+            for( const auto& pBufferedData : m_RingBuffer )
+            {
+                SerializeFrame( pBufferedData );
+            }
+
+            m_RingBuffer.clear();
+            m_RemainingCaptureFrameCount--;
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        CheckCaptureTriggers
+
+    Description:
+        Checks whether any of the configured capture triggers fired for the
+        frame.
+
+    \*************************************************************************/
+    bool ProfilerTraceOutput::CheckCaptureTriggers( const DeviceProfilerFrameData& data )
+    {
+        bool captureTriggered = false;
+
+        const uint64_t hostTimestampFrequency = m_Frontend.GetHostTimestampFrequency( data.m_SyncTimestamps.m_HostTimeDomain );
+
+        if( m_TriggerFrameTime.count() > 0 )
+        {
+            if( hostTimestampFrequency > 0 )
+            {
+                const Milliseconds frameTime = Milliseconds(
+                    static_cast<float>( data.m_CPU.m_EndTimestamp - data.m_CPU.m_BeginTimestamp ) * 1000.f / hostTimestampFrequency );
+
+                captureTriggered |= (frameTime > m_TriggerFrameTime);
+            }
+        }
+
+        if( !captureTriggered && !m_TriggerDebugLabel.empty() )
+        {
+            // The labels are matched when the commands are recorded, so only the
+            // command buffers are checked here instead of the whole command tree.
+            for( const auto& submitBatch : data.m_Submits )
+            {
+                for( const auto& submit : submitBatch.m_Submits )
+                {
+                    for( const auto& pCommandBuffer : submit.m_CommandBuffers )
+                    {
+                        captureTriggered |= pCommandBuffer->m_HasTraceTriggerLabel;
+                    }
+                }
+            }
+        }
+
+        // Poll the trigger file at most every TriggerFileCheckPeriodMs to keep the
+        // filesystem calls out of the per-frame path.
+        if( !m_TriggerFile.empty() &&
+            ( data.m_CPU.m_EndTimestamp - m_TriggerFileCheckTimestamp ) >= ( hostTimestampFrequency * TriggerFileCheckPeriodMs / 1000 ) )
+        {
+            m_TriggerFileCheckTimestamp = data.m_CPU.m_EndTimestamp;
+
+            // remove() returns true only if the file existed, so a single call both checks and consumes the trigger.
+            std::error_code error;
+            if( std::filesystem::remove( m_TriggerFile, error ) )
+            {
+                captureTriggered = true;
+            }
+        }
+
+        return captureTriggered;
     }
 
     /*************************************************************************\
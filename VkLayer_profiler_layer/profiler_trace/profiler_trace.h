@@ -22,6 +22,7 @@
 #include "profiler/profiler_frontend.h"
 #include "profiler_helpers/profiler_time_helpers.h"
 #include "profiler_helpers/profiler_json_builder.h"
+#include "profiler_helpers/profiler_file_stream.h"
 #include <vulkan/vulkan.h>
 #include <atomic>
 #include <list>
@@ -30,11 +31,14 @@
 #include <mutex>
 #include <thread>
 #include <condition_variable>
+#include <deque>
+#include <filesystem>
 #include <queue>
 
 namespace Profiler
 {
     struct TraceEvent;
+    struct TraceEventArgs;
 
     /*************************************************************************\
 
@@ -73,7 +77,7 @@ namespace Profiler
         DeviceProfilerTraceSerializer( DeviceProfilerFrontend& frontend );
         ~DeviceProfilerTraceSerializer();
 
-        bool OpenOutputFile( const std::string& fileName );
+        bool OpenOutputFile( const std::string& fileName, DeviceProfilerFileCompression compression = DeviceProfilerFileCompression::eNone );
         bool CloseOutputFile();
 
         bool Serialize( const struct DeviceProfilerFrameData& data );
@@ -82,7 +86,7 @@ namespace Profiler
         void ClearErrorMessages();
         const std::list<std::string>& GetErrorMessages() const;
 
-        static std::string GetDefaultTraceFileName( int samplingMode );
+        static std::string GetDefaultTraceFileName( int samplingMode, DeviceProfilerFileCompression compression = DeviceProfilerFileCompression::eNone );
 
     private:
         DeviceProfilerFrontend& m_Frontend;
@@ -93,7 +97,7 @@ namespace Profiler
         std::list<std::string> m_ErrorMessages;
 
         // Output file
-        std::ofstream m_OutputFile;
+        DeviceProfilerOutputFileStream m_OutputFile;
         bool m_OutputFileEmpty;
 
         // Currently serialized frame data
@@ -109,6 +113,9 @@ namespace Profiler
         // Tracking depth of the stack to detect labels which begin in one frame and end in the next
         uint32_t     m_DebugLabelStackDepth;
 
+        // Flow events connecting the submits must have unique identifiers in the file
+        uint64_t     m_FlowEventId;
+
         // Timestamp normalization
         VkTimeDomainEXT m_HostTimeDomain;
         uint64_t     m_HostCalibratedTimestamp;
@@ -133,8 +140,11 @@ namespace Profiler
         void Serialize( const struct DeviceProfilerPipelineData& );
         void Serialize( const struct DeviceProfilerDrawcall& );
         void Serialize( const std::vector<struct TipRange>& );
+        void Serialize( const std::vector<struct DeviceProfilerPipelineCompilationData>& );
+        void Serialize( const std::vector<struct DeviceProfilerCpuSpanData>& );
 
         void AppendEvent( const TraceEvent& event );
+        void AppendEventArgs( DeviceProfilerJsonValueBuilder& builder, const TraceEventArgs& args );
         bool AppendEventsToOutputFile();
     };
 
@@ -146,6 +156,9 @@ namespace Profiler
     Description:
         Reads data from the profiler and writes it to a file.
 
+        When ring buffer size is set, only the most recent frames are kept in
+        memory and written to the file when a capture is triggered.
+
     \*************************************************************************/
     class ProfilerTraceOutput : public DeviceProfilerOutput
     {
@@ -164,6 +177,8 @@ namespace Profiler
         void SetMaxFrameCount( uint32_t maxFrameCount );
         void SetSkipFrameCount( uint32_t skipFrameCount );
 
+        void TriggerCapture();
+
     private:
         DeviceProfilerStringSerializer* m_pStringSerializer;
         DeviceProfilerTraceSerializer* m_pTraceSerializer;
@@ -181,8 +196,26 @@ namespace Profiler
         std::mutex m_FrameDataQueueMutex;
         std::queue<std::shared_ptr<struct DeviceProfilerFrameData>> m_FrameDataQueue;
 
+        // Capture-on-trigger mode
+        uint32_t m_RingBufferSize;
+        std::deque<std::shared_ptr<struct DeviceProfilerFrameData>> m_RingBuffer;
+        std::atomic_bool m_CaptureTriggered;
+
+        // Frames written after the triggering frame.
+        uint32_t m_PostTriggerFrameCount;
+        uint32_t m_RemainingCaptureFrameCount;
+
+        Milliseconds m_TriggerFrameTime;
+        std::string m_TriggerDebugLabel;
+        std::filesystem::path m_TriggerFile;
+        uint64_t m_TriggerFileCheckTimestamp;
+
         void ResetMembers();
 
+        void SerializeFrame( const std::shared_ptr<struct DeviceProfilerFrameData>& pData );
+        void UpdateRingBuffer( const std::shared_ptr<struct DeviceProfilerFrameData>& pData );
+        bool CheckCaptureTriggers( const struct DeviceProfilerFrameData& data );
+
         void TraceSerializationThreadProc();
         void StopTraceSerializationThread();
 
@@ -20,6 +20,7 @@
 
 #include "profiler_trace_event.h"
 #include "profiler/profiler_helpers.h"
+#include <charconv>
 
 namespace Profiler
 {
@@ -31,6 +32,9 @@ namespace Profiler
     Description:
         Serialize TraceEvent to JSON object.
 
+        The 'args' field of the events with TraceEventArgs is written by the
+        trace serializer.
+
     \*************************************************************************/
     void TraceEvent::Serialize( DeviceProfilerJsonObjectBuilder& builder ) const
     {
@@ -56,151 +60,101 @@ namespace Profiler
             builder.Add( "tid", std::string_view( queueHexHandle ) );
         }
 
-        if( m_Color )
+        switch( m_Type )
         {
-            auto cnameBuilder = builder.Add( "cname" );
-            m_Color( cnameBuilder );
-        }
+        case Type::eDefault:
+            break;
 
-        if( m_Args )
+        case Type::eInstant:
         {
-            auto argsBuilder = builder.Add( "args" );
-            m_Args( argsBuilder );
+            // Instant events contain additional 's' parameter
+            builder.Add( "s", static_cast<char>( m_Scope ) );
+            break;
         }
-    }
-
-    /*************************************************************************\
-
-    Function:
-        Serialize
-
-    Description:
-        Serialize TraceInstantEvent to JSON object.
-
-    \*************************************************************************/
-    void TraceInstantEvent::Serialize( DeviceProfilerJsonObjectBuilder& builder ) const
-    {
-        TraceEvent::Serialize( builder );
-
-        // Instant events contain additional 's' parameter
-        builder.Add( "s", static_cast<char>( m_Scope ) );
-    }
-
-    /*************************************************************************\
-
-    Function:
-        Serialize
-
-    Description:
-        Serialize TraceAsyncEvent to JSON object.
-
-    \*************************************************************************/
-    void TraceAsyncEvent::Serialize( DeviceProfilerJsonObjectBuilder& builder ) const
-    {
-        TraceEvent::Serialize( builder );
-
-        // Async events contain additional 'id' parameter
-        builder.Add( "id", m_Id );
-    }
-
-    /*************************************************************************\
-
-    Function:
-        Serialize
-
-    Description:
-        Serialize TraceCompleteEvent to JSON object.
-
-    \*************************************************************************/
-    void TraceCompleteEvent::Serialize( DeviceProfilerJsonObjectBuilder& builder ) const
-    {
-        TraceEvent::Serialize( builder );
-
-        // Complete events contain additional 'dur' parameter
-        builder.Add( "dur", m_Duration.count() );
-    }
-
-    /*************************************************************************\
-
-    Function:
-        Serialize
-
-    Description:
-        Serialize TraceCounterEvent to JSON object.
 
-    \*************************************************************************/
-    void TraceCounterEvent::Serialize( DeviceProfilerJsonObjectBuilder& builder ) const
-    {
-        TraceEvent::Serialize( builder );
+        case Type::eAsync:
+        {
+            // Async events contain additional 'id' parameter
+            builder.Add( "id", m_Id );
+            break;
+        }
 
-        // Counter events contain all metrics in 'args' parameter
-        auto args = builder.AddObject( "args" );
-        for( uint32_t i = 0; i < m_CounterCount; ++i )
+        case Type::eFlow:
         {
-            const VkProfilerPerformanceCounterProperties2EXT& properties = m_pCounterProperties[i];
-            const VkProfilerPerformanceCounterResultEXT result = m_pCounterResults ? m_pCounterResults[i] : VkProfilerPerformanceCounterResultEXT();
+            // Flow events contain additional 'id' parameter
+            builder.Add( "id", m_Id );
 
-            switch( properties.storage )
+            // Bind the end of the flow to the slice enclosing the timestamp instead of the next slice
+            if( m_Phase == Phase::eFlowEnd )
             {
-            case VK_PROFILER_PERFORMANCE_COUNTER_STORAGE_INT32_EXT:
-                args.Add( properties.shortName, result.int32 );
-                break;
-            case VK_PROFILER_PERFORMANCE_COUNTER_STORAGE_UINT32_EXT:
-                args.Add( properties.shortName, result.uint32 );
-                break;
-            case VK_PROFILER_PERFORMANCE_COUNTER_STORAGE_INT64_EXT:
-                args.Add( properties.shortName, result.int64 );
-                break;
-            case VK_PROFILER_PERFORMANCE_COUNTER_STORAGE_UINT64_EXT:
-                args.Add( properties.shortName, result.uint64 );
-                break;
-            case VK_PROFILER_PERFORMANCE_COUNTER_STORAGE_FLOAT32_EXT:
-                args.Add( properties.shortName, result.float32 );
-                break;
-            case VK_PROFILER_PERFORMANCE_COUNTER_STORAGE_FLOAT64_EXT:
-                args.Add( properties.shortName, result.float64 );
-                break;
+                builder.Add( "bp", 'e' );
             }
+            break;
         }
-        args.End();
-    }
-
-    /*************************************************************************\
-
-    Function:
-        Serialize
-
-    Description:
-        Serialize DebugTraceEvent to JSON object.
-
-    \*************************************************************************/
-    void DebugTraceEvent::Serialize( DeviceProfilerJsonObjectBuilder& builder ) const
-    {
-        TraceEvent::Serialize( builder );
-
-        // Set thread id
-        builder.Add( "tid", "Debug labels" );
 
-        if( m_Phase == Phase::eInstant )
+        case Type::eComplete:
         {
-            builder.Add( "s", static_cast<char>( TraceInstantEvent::Scope::eThread ) );
+            // Complete events contain additional 'dur' parameter
+            builder.Add( "dur", m_Duration.count() );
+            break;
         }
-    }
 
-    /*************************************************************************\
+        case Type::eCounter:
+        {
+            // Counter events contain all metrics in 'args' parameter
+            auto args = builder.AddObject( "args" );
+            for( uint32_t i = 0; i < m_Counters.m_CounterCount; ++i )
+            {
+                const VkProfilerPerformanceCounterProperties2EXT& properties = m_Counters.m_pCounterProperties[i];
+                const VkProfilerPerformanceCounterResultEXT result = m_Counters.m_pCounterResults ? m_Counters.m_pCounterResults[i] : VkProfilerPerformanceCounterResultEXT();
+
+                switch( properties.storage )
+                {
+                case VK_PROFILER_PERFORMANCE_COUNTER_STORAGE_INT32_EXT:
+                    args.Add( properties.shortName, result.int32 );
+                    break;
+                case VK_PROFILER_PERFORMANCE_COUNTER_STORAGE_UINT32_EXT:
+                    args.Add( properties.shortName, result.uint32 );
+                    break;
+                case VK_PROFILER_PERFORMANCE_COUNTER_STORAGE_INT64_EXT:
+                    args.Add( properties.shortName, result.int64 );
+                    break;
+                case VK_PROFILER_PERFORMANCE_COUNTER_STORAGE_UINT64_EXT:
+                    args.Add( properties.shortName, result.uint64 );
+                    break;
+                case VK_PROFILER_PERFORMANCE_COUNTER_STORAGE_FLOAT32_EXT:
+                    args.Add( properties.shortName, result.float32 );
+                    break;
+                case VK_PROFILER_PERFORMANCE_COUNTER_STORAGE_FLOAT64_EXT:
+                    args.Add( properties.shortName, result.float64 );
+                    break;
+                }
+            }
+            args.End();
+            break;
+        }
 
-    Function:
-        Serialize
+        case Type::eDebug:
+        {
+            // Set thread id
+            builder.Add( "tid", "Debug labels" );
 
-    Description:
-        Serialize ApiTraceEvent to JSON object.
+            if( m_Phase == Phase::eInstant )
+            {
+                builder.Add( "s", static_cast<char>( Scope::eThread ) );
+            }
+            break;
+        }
 
-    \*************************************************************************/
-    void ApiTraceEvent::Serialize( DeviceProfilerJsonObjectBuilder& builder ) const
-    {
-        TraceEvent::Serialize( builder );
+        case Type::eApi:
+        {
+            // Set thread id
+            char threadName[32] = "Thread ";
+            const std::to_chars_result result = std::to_chars( threadName + 7, threadName + sizeof( threadName ), m_ThreadId );
 
-        // Set thread id
-        builder.Add( "tid", "Thread " + std::to_string( m_ThreadId ) );
+            builder.Add( "tid", std::string_view( threadName, result.ptr - threadName ) );
+            break;
+        }
+        }
     }
 }
@@ -22,19 +22,101 @@
 #include "profiler_helpers/profiler_json_builder.h"
 #include "profiler_helpers/profiler_time_helpers.h"
 #include <vulkan/vulkan.h>
-#include <functional>
+#include <assert.h>
 
 #include "profiler_ext/VkProfilerEXT.h"
 
 namespace Profiler
 {
+    struct DeviceProfilerDrawcall;
+    struct DeviceProfilerPipelineData;
+    struct DeviceProfilerRenderPassData;
+    struct DeviceProfilerHitchData;
+    struct DeviceProfilerPipelineCompilationData;
+    struct DeviceProfilerOverheadData;
+
+    /*************************************************************************\
+
+    Structure:
+        TraceEventArgs
+
+    Description:
+        Reference to the profiling data written to the 'args' field of the
+        event. The arguments are written by the trace serializer directly
+        from the referenced data when the event is appended, so the data
+        must outlive the event.
+
+    \*************************************************************************/
+    struct TraceEventArgs
+    {
+        enum class Type
+        {
+            eNone,
+            eCommand,
+            ePipeline,
+            eRenderPass,
+            eHitch,
+            ePipelineCompilation,
+            eCpuOverhead,
+            eHostMemoryOverhead,
+            eGpuMemoryOverhead
+        };
+
+        Type m_Type;
+
+        union
+        {
+            const void*                                  m_pData;
+            const DeviceProfilerDrawcall*                m_pCommand;
+            const DeviceProfilerPipelineData*            m_pPipeline;
+            const DeviceProfilerRenderPassData*          m_pRenderPass;
+            const DeviceProfilerHitchData*               m_pHitch;
+            const DeviceProfilerPipelineCompilationData* m_pPipelineCompilation;
+            const DeviceProfilerOverheadData*            m_pOverhead;
+        };
+
+        constexpr TraceEventArgs()
+            : m_Type( Type::eNone ), m_pData( nullptr ) {}
+
+        explicit TraceEventArgs( const DeviceProfilerDrawcall& data )
+            : m_Type( Type::eCommand ), m_pCommand( &data ) {}
+
+        explicit TraceEventArgs( const DeviceProfilerPipelineData& data )
+            : m_Type( Type::ePipeline ), m_pPipeline( &data ) {}
+
+        explicit TraceEventArgs( const DeviceProfilerRenderPassData& data )
+            : m_Type( Type::eRenderPass ), m_pRenderPass( &data ) {}
+
+        explicit TraceEventArgs( const DeviceProfilerHitchData& data )
+            : m_Type( Type::eHitch ), m_pHitch( &data ) {}
+
+        explicit TraceEventArgs( const DeviceProfilerPipelineCompilationData& data )
+            : m_Type( Type::ePipelineCompilation ), m_pPipelineCompilation( &data ) {}
+
+        TraceEventArgs( Type type, const DeviceProfilerOverheadData& data )
+            : m_Type( type ), m_pOverhead( &data )
+        {
+            assert( (m_Type == Type::eCpuOverhead)
+                || (m_Type == Type::eHostMemoryOverhead)
+                || (m_Type == Type::eGpuMemoryOverhead) );
+        }
+
+        bool IsEmpty() const { return m_Type == Type::eNone; }
+    };
+
     /*************************************************************************\
 
     Structure:
         TraceEvent
 
     Description:
-        Contains data common for all trace event types.
+        Single record describing an event of any type. Fields specific to
+        the event type are stored in a union selected by m_Type, so the
+        events can be created on the stack and serialized without virtual
+        calls or heap allocations.
+
+        Structures derived from TraceEvent only initialize the fields of
+        the respective type and must not add any members.
 
     See:
         https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
@@ -42,7 +124,17 @@ namespace Profiler
     \*************************************************************************/
     struct TraceEvent
     {
-        typedef std::function<void( DeviceProfilerJsonValueBuilder& )> BuildCallback;
+        enum class Type
+        {
+            eDefault,
+            eInstant,
+            eAsync,
+            eFlow,
+            eComplete,
+            eCounter,
+            eDebug,
+            eApi
+        };
 
         enum class Phase
         {
@@ -70,13 +162,36 @@ namespace Profiler
             eContextEnd = ')'
         };
 
+        enum class Scope
+        {
+            eGlobal = 'g',
+            eProcess = 'p',
+            eThread = 't',
+        };
+
+        struct CounterData
+        {
+            size_t m_CounterCount;
+            const VkProfilerPerformanceCounterProperties2EXT* m_pCounterProperties;
+            const VkProfilerPerformanceCounterResultEXT* m_pCounterResults;
+        };
+
+        Type             m_Type;
         Phase            m_Phase;
         std::string_view m_Name;
         std::string_view m_Category;
         Microseconds     m_Timestamp;
         VkQueue          m_Queue;
-        BuildCallback    m_Color;
-        BuildCallback    m_Args;
+        TraceEventArgs   m_Args;
+
+        union
+        {
+            Scope        m_Scope;       // eInstant
+            uint64_t     m_Id;          // eAsync, eFlow
+            Microseconds m_Duration;    // eComplete
+            CounterData  m_Counters;    // eCounter
+            uint32_t     m_ThreadId;    // eApi
+        };
 
         TraceEvent() = default;
 
@@ -87,19 +202,33 @@ namespace Profiler
             std::string_view category,
             TimestampType timestamp,
             VkQueue queue,
-            BuildCallback color = {},
-            BuildCallback args = {} )
-            : m_Phase( phase )
+            TraceEventArgs args = {} )
+            : TraceEvent( Type::eDefault, phase, name, category, timestamp, queue, args )
+        {
+        }
+
+        void Serialize( DeviceProfilerJsonObjectBuilder& builder ) const;
+
+    protected:
+        template<typename TimestampType>
+        inline TraceEvent(
+            Type type,
+            Phase phase,
+            std::string_view name,
+            std::string_view category,
+            TimestampType timestamp,
+            VkQueue queue,
+            TraceEventArgs args )
+            : m_Type( type )
+            , m_Phase( phase )
             , m_Name( name )
             , m_Category( category )
             , m_Timestamp( std::chrono::duration_cast<decltype( m_Timestamp )>( timestamp ) )
             , m_Queue( queue )
-            , m_Color( std::move( color ) )
-            , m_Args( std::move( args ) )
+            , m_Args( args )
+            , m_Counters()
         {
         }
-
-        virtual void Serialize( DeviceProfilerJsonObjectBuilder& builder ) const;
     };
 
     /*************************************************************************\
@@ -116,16 +245,7 @@ namespace Profiler
     \*************************************************************************/
     struct TraceInstantEvent : TraceEvent
     {
-        enum class Scope
-        {
-            eGlobal = 'g',
-            eProcess = 'p',
-            eThread = 't',
-        };
-
-        Scope m_Scope;
-
-        TraceInstantEvent() = default;
+        using Scope = TraceEvent::Scope;
 
         template<typename TimestampType>
         inline TraceInstantEvent(
@@ -134,14 +254,11 @@ namespace Profiler
             std::string_view category,
             TimestampType timestamp,
             VkQueue queue,
-            BuildCallback color = {},
-            BuildCallback args = {} )
-            : TraceEvent( Phase::eInstant, name, category, timestamp, queue, std::move( color ), std::move( args ) )
-            , m_Scope( scope )
+            TraceEventArgs args = {} )
+            : TraceEvent( Type::eInstant, Phase::eInstant, name, category, timestamp, queue, args )
         {
+            m_Scope = scope;
         }
-
-        void Serialize( DeviceProfilerJsonObjectBuilder& builder ) const override;
     };
 
     /*************************************************************************\
@@ -158,10 +275,6 @@ namespace Profiler
     \*************************************************************************/
     struct TraceAsyncEvent : TraceEvent
     {
-        uint64_t m_Id;
-
-        TraceAsyncEvent() = default;
-
         template<typename TimestampType>
         inline TraceAsyncEvent(
             Phase phase,
@@ -170,17 +283,50 @@ namespace Profiler
             std::string_view category,
             TimestampType timestamp,
             VkQueue queue,
-            BuildCallback color = {},
-            BuildCallback args = {} )
-            : TraceEvent( phase, name, category, timestamp, queue, std::move( color ), std::move( args ) )
-            , m_Id( id )
+            TraceEventArgs args = {} )
+            : TraceEvent( Type::eAsync, phase, name, category, timestamp, queue, args )
         {
             assert( (m_Phase == Phase::eAsyncStart)
                 || (m_Phase == Phase::eAsyncEnd)
                 || (m_Phase == Phase::eAsyncInstant) );
+
+            m_Id = id;
         }
+    };
+
+    /*************************************************************************\
+
+    Structure:
+        TraceFlowEvent
+
+    Description:
+        Flow events connect slices on different tracks. Events with the same
+        'id' form a single flow. Both ends of the flow are bound to the
+        slices enclosing the timestamps of the events.
+
+    See:
+        https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+
+    \*************************************************************************/
+    struct TraceFlowEvent : TraceEvent
+    {
+        template<typename TimestampType>
+        inline TraceFlowEvent(
+            Phase phase,
+            uint64_t id,
+            std::string_view name,
+            std::string_view category,
+            TimestampType timestamp,
+            VkQueue queue,
+            TraceEventArgs args = {} )
+            : TraceEvent( Type::eFlow, phase, name, category, timestamp, queue, args )
+        {
+            assert( (m_Phase == Phase::eFlowStart)
+                || (m_Phase == Phase::eFlowStep)
+                || (m_Phase == Phase::eFlowEnd) );
 
-        void Serialize( DeviceProfilerJsonObjectBuilder& builder ) const override;
+            m_Id = id;
+        }
     };
 
     /*************************************************************************\
@@ -197,10 +343,6 @@ namespace Profiler
     \*************************************************************************/
     struct TraceCompleteEvent : TraceEvent
     {
-        Microseconds m_Duration;
-
-        TraceCompleteEvent() = default;
-
         template<typename TimestampType, typename DurationType>
         inline TraceCompleteEvent(
             std::string_view name,
@@ -208,14 +350,11 @@ namespace Profiler
             TimestampType timestamp,
             DurationType duration,
             VkQueue queue,
-            BuildCallback color = {},
-            BuildCallback args = {} )
-            : TraceEvent( Phase::eComplete, name, category, timestamp, queue, std::move( color ), std::move( args ) )
-            , m_Duration( std::chrono::duration_cast<decltype( m_Duration )>( duration ) )
+            TraceEventArgs args = {} )
+            : TraceEvent( Type::eComplete, Phase::eComplete, name, category, timestamp, queue, args )
         {
+            m_Duration = std::chrono::duration_cast<Microseconds>( duration );
         }
-
-        void Serialize( DeviceProfilerJsonObjectBuilder& builder ) const override;
     };
 
     /*************************************************************************\
@@ -232,28 +371,19 @@ namespace Profiler
     \*************************************************************************/
     struct TraceCounterEvent : TraceEvent
     {
-        size_t m_CounterCount;
-        const VkProfilerPerformanceCounterProperties2EXT* m_pCounterProperties;
-        const VkProfilerPerformanceCounterResultEXT* m_pCounterResults;
-
-        TraceCounterEvent() = default;
-
         template<typename TimestampType>
         inline TraceCounterEvent(
             TimestampType timestamp,
             VkQueue queue,
             size_t counterCount,
             const VkProfilerPerformanceCounterProperties2EXT* pCounterProperties,
-            const VkProfilerPerformanceCounterResultEXT* pCounterResults,
-            BuildCallback color = {} )
-            : TraceEvent( Phase::eCounter, "", "", timestamp, queue, std::move( color ) )
-            , m_CounterCount( counterCount )
-            , m_pCounterProperties( pCounterProperties )
-            , m_pCounterResults( pCounterResults )
+            const VkProfilerPerformanceCounterResultEXT* pCounterResults )
+            : TraceEvent( Type::eCounter, Phase::eCounter, "", "", timestamp, queue, {} )
         {
+            m_Counters.m_CounterCount = counterCount;
+            m_Counters.m_pCounterProperties = pCounterProperties;
+            m_Counters.m_pCounterResults = pCounterResults;
         }
-
-        void Serialize( DeviceProfilerJsonObjectBuilder& builder ) const override;
     };
 
     /*************************************************************************\
@@ -268,20 +398,15 @@ namespace Profiler
     \*************************************************************************/
     struct DebugTraceEvent : TraceEvent
     {
-        DebugTraceEvent() = default;
-
         template<typename TimestampType>
         inline DebugTraceEvent(
             Phase phase,
             std::string_view name,
             TimestampType timestamp,
-            BuildCallback color = {},
-            BuildCallback args = {} )
-            : TraceEvent( phase, name, "Debug", timestamp, VK_NULL_HANDLE, std::move( color ), std::move( args ) )
+            TraceEventArgs args = {} )
+            : TraceEvent( Type::eDebug, phase, name, "Debug", timestamp, VK_NULL_HANDLE, args )
         {
         }
-
-        void Serialize( DeviceProfilerJsonObjectBuilder& builder ) const override;
     };
 
     /*************************************************************************\
@@ -296,23 +421,16 @@ namespace Profiler
     \*************************************************************************/
     struct ApiTraceEvent : TraceEvent
     {
-        uint32_t m_ThreadId;
-
-        ApiTraceEvent() = default;
-
         template<typename TimestampType>
         inline ApiTraceEvent(
             Phase phase,
             std::string_view name,
             uint32_t threadId,
             TimestampType timestamp,
-            BuildCallback color = {},
-            BuildCallback args = {} )
-            : TraceEvent( phase, name, "API", timestamp, VK_NULL_HANDLE, std::move( color ), std::move( args ) )
-            , m_ThreadId( threadId )
+            TraceEventArgs args = {} )
+            : TraceEvent( Type::eApi, phase, name, "API", timestamp, VK_NULL_HANDLE, args )
         {
+            m_ThreadId = threadId;
         }
-
-        void Serialize( DeviceProfilerJsonObjectBuilder& builder ) const override;
     };
 }
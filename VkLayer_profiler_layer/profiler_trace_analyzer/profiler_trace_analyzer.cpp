@@ -0,0 +1,712 @@
+// Copyright (c) 2026 Lukasz Stalmirski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "profiler_trace_analyzer.h"
+#include "profiler_helpers/profiler_json_parser.h"
+#include "profiler_helpers/profiler_file_stream.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+namespace Profiler
+{
+    static constexpr size_t DefaultChunkSize = 16 * 1024 * 1024;
+
+    /*************************************************************************\
+
+    Function:
+        GetRegionType
+
+    Description:
+        Returns type of the region described by the trace event category.
+
+    \*************************************************************************/
+    static bool GetRegionType( std::string_view category, DeviceProfilerTraceRegionType& type )
+    {
+        if( category == "Pipelines" )
+        {
+            type = DeviceProfilerTraceRegionType::ePipeline;
+            return true;
+        }
+
+        if( category == "Render passes" )
+        {
+            type = DeviceProfilerTraceRegionType::eRenderPass;
+            return true;
+        }
+
+        if( category == "Debug" )
+        {
+            type = DeviceProfilerTraceRegionType::eDebugLabel;
+            return true;
+        }
+
+        return false;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        TrimEvents
+
+    Description:
+        Removes whitespace and separators surrounding the list of events.
+
+    \*************************************************************************/
+    static std::string_view TrimEvents( std::string_view events )
+    {
+        const char* pSeparators = " \t\r\n,";
+
+        const size_t begin = events.find_first_not_of( pSeparators );
+        if( begin == std::string_view::npos )
+        {
+            return std::string_view();
+        }
+
+        const size_t end = events.find_last_not_of( pSeparators );
+        return events.substr( begin, end - begin + 1 );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        FindEndOfEvents
+
+    Description:
+        Returns offset of the line that closes the traceEvents array.
+        The layer writes each event in a separate line, so only a ']' at
+        the beginning of a line can close the array. Brackets inside the
+        events are not taken into account.
+
+    \*************************************************************************/
+    size_t DeviceProfilerTraceAnalyzer::FindEndOfEvents( std::string_view events )
+    {
+        size_t lineBegin = 0;
+        while( lineBegin < events.size() )
+        {
+            const size_t firstChar = events.find_first_not_of( " \t\r", lineBegin );
+            if( ( firstChar != std::string_view::npos ) && ( events[ firstChar ] == ']' ) )
+            {
+                return lineBegin;
+            }
+
+            const size_t lineEnd = events.find( '\n', lineBegin );
+            if( lineEnd == std::string_view::npos )
+            {
+                break;
+            }
+
+            lineBegin = lineEnd + 1;
+        }
+
+        return events.size();
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Add
+
+    Description:
+        Accumulates duration of a single region.
+
+    \*************************************************************************/
+    void DeviceProfilerTraceRegionStats::Add( double duration )
+    {
+        if( m_Count == 0 )
+        {
+            m_MinDuration = duration;
+            m_MaxDuration = duration;
+        }
+        else
+        {
+            m_MinDuration = std::min( m_MinDuration, duration );
+            m_MaxDuration = std::max( m_MaxDuration, duration );
+        }
+
+        m_TotalDuration += duration;
+        m_Count++;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Merge
+
+    Description:
+        Accumulates statistics collected separately.
+
+    \*************************************************************************/
+    void DeviceProfilerTraceRegionStats::Merge( const DeviceProfilerTraceRegionStats& other )
+    {
+        if( other.m_Count == 0 )
+        {
+            return;
+        }
+
+        if( m_Count == 0 )
+        {
+            *this = other;
+            return;
+        }
+
+        m_MinDuration = std::min( m_MinDuration, other.m_MinDuration );
+        m_MaxDuration = std::max( m_MaxDuration, other.m_MaxDuration );
+        m_TotalDuration += other.m_TotalDuration;
+        m_Count += other.m_Count;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Merge
+
+    Description:
+        Accumulates results of the analysis of a part of the trace.
+
+    \*************************************************************************/
+    void DeviceProfilerTraceAnalysis::Merge( const DeviceProfilerTraceAnalysis& other )
+    {
+        for( size_t i = 0; i < static_cast<size_t>( DeviceProfilerTraceRegionType::eCount ); ++i )
+        {
+            for( const auto& [name, stats] : other.m_Regions[ i ] )
+            {
+                m_Regions[ i ][ name ].Merge( stats );
+            }
+        }
+
+        m_EventCount += other.m_EventCount;
+        m_ByteCount += other.m_ByteCount;
+    }
+
+    /*************************************************************************\
+
+    Structure:
+        DeviceProfilerTraceAnalyzer::Chunk
+
+    Description:
+        Part of the traceEvents array split at the event boundary.
+
+    \*************************************************************************/
+    struct DeviceProfilerTraceAnalyzer::Chunk
+    {
+        size_t m_Index = 0;
+        std::string m_Data;
+    };
+
+    /*************************************************************************\
+
+    Structure:
+        DeviceProfilerTraceAnalyzer::ChunkResult
+
+    Description:
+        Statistics of the regions that begin and end in the chunk, and
+        the region boundaries that have to be matched with other chunks.
+
+    \*************************************************************************/
+    struct DeviceProfilerTraceAnalyzer::ChunkResult
+    {
+        struct OpenRegion
+        {
+            std::string m_Name;
+            double m_Timestamp;
+        };
+
+        struct Lane
+        {
+            // Timestamps of the end events of regions that began in the previous chunks.
+            std::vector<double> m_UnmatchedEnds;
+
+            // Regions that haven't ended in the chunk.
+            std::vector<OpenRegion> m_OpenRegions;
+        };
+
+        using LaneMap = std::unordered_map<std::string, Lane>;
+
+        DeviceProfilerTraceAnalysis m_Analysis;
+        LaneMap m_Lanes[ static_cast<size_t>( DeviceProfilerTraceRegionType::eCount ) ];
+        bool m_Valid = false;
+    };
+
+    /*************************************************************************\
+
+    Structure:
+        DeviceProfilerTraceAnalyzer::ChunkQueue
+
+    Description:
+        Bounded queue of chunks waiting for the worker threads.
+
+    \*************************************************************************/
+    struct DeviceProfilerTraceAnalyzer::ChunkQueue
+    {
+        std::mutex m_Mutex;
+        std::condition_variable m_ProducerCondition;
+        std::condition_variable m_ConsumerCondition;
+        std::deque<Chunk> m_Chunks;
+        size_t m_MaxSize = 1;
+        bool m_Closed = false;
+
+        void Push( Chunk&& chunk )
+        {
+            std::unique_lock lk( m_Mutex );
+            m_ProducerCondition.wait( lk, [this] { return m_Chunks.size() < m_MaxSize; } );
+            m_Chunks.push_back( std::move( chunk ) );
+            m_ConsumerCondition.notify_one();
+        }
+
+        bool Pop( Chunk& chunk )
+        {
+            std::unique_lock lk( m_Mutex );
+            m_ConsumerCondition.wait( lk, [this] { return !m_Chunks.empty() || m_Closed; } );
+
+            if( m_Chunks.empty() )
+            {
+                return false;
+            }
+
+            chunk = std::move( m_Chunks.front() );
+            m_Chunks.pop_front();
+            m_ProducerCondition.notify_one();
+            return true;
+        }
+
+        void Close()
+        {
+            std::scoped_lock lk( m_Mutex );
+            m_Closed = true;
+            m_ConsumerCondition.notify_all();
+        }
+    };
+
+    /*************************************************************************\
+
+    Function:
+        DeviceProfilerTraceAnalyzer
+
+    Description:
+        Constructor.
+
+    \*************************************************************************/
+    DeviceProfilerTraceAnalyzer::DeviceProfilerTraceAnalyzer()
+        : m_ThreadCount( std::max( 1U, std::thread::hardware_concurrency() ) )
+        , m_ChunkSize( DefaultChunkSize )
+        , m_ErrorMessage()
+    {
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ~DeviceProfilerTraceAnalyzer
+
+    Description:
+        Destructor.
+
+    \*************************************************************************/
+    DeviceProfilerTraceAnalyzer::~DeviceProfilerTraceAnalyzer()
+    {
+    }
+
+    /*************************************************************************\
+
+    Function:
+        SetThreadCount
+
+    Description:
+        Sets number of threads parsing the chunks.
+
+    \*************************************************************************/
+    void DeviceProfilerTraceAnalyzer::SetThreadCount( uint32_t threadCount )
+    {
+        m_ThreadCount = std::max( 1U, threadCount );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        SetChunkSize
+
+    Description:
+        Sets number of bytes read from the file at once.
+
+    \*************************************************************************/
+    void DeviceProfilerTraceAnalyzer::SetChunkSize( size_t chunkSize )
+    {
+        m_ChunkSize = std::max<size_t>( 4096, chunkSize );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetErrorMessage
+
+    Description:
+        Returns description of the last error.
+
+    \*************************************************************************/
+    const std::string& DeviceProfilerTraceAnalyzer::GetErrorMessage() const
+    {
+        return m_ErrorMessage;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetRegionTypeName
+
+    Description:
+        Returns human-readable name of the region type.
+
+    \*************************************************************************/
+    const char* DeviceProfilerTraceAnalyzer::GetRegionTypeName( DeviceProfilerTraceRegionType type )
+    {
+        switch( type )
+        {
+        case DeviceProfilerTraceRegionType::ePipeline:
+            return "Pipeline";
+        case DeviceProfilerTraceRegionType::eRenderPass:
+            return "Render pass";
+        case DeviceProfilerTraceRegionType::eDebugLabel:
+            return "Debug label";
+        default:
+            return "Unknown";
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Analyze
+
+    Description:
+        Reads the trace file and aggregates durations of the regions.
+        Compressed traces are decompressed while reading.
+
+    \*************************************************************************/
+    bool DeviceProfilerTraceAnalyzer::Analyze( const std::filesystem::path& filename, DeviceProfilerTraceAnalysis& analysis )
+    {
+        m_ErrorMessage.clear();
+        analysis = DeviceProfilerTraceAnalysis();
+
+        DeviceProfilerInputFileStream file;
+        if( !file.Open( filename, std::ios::binary ) )
+        {
+            m_ErrorMessage = "Could not open file '" + filename.string() + "' for reading.";
+            return false;
+        }
+
+        ChunkQueue queue;
+        queue.m_MaxSize = 2 * m_ThreadCount;
+
+        std::mutex resultsMutex;
+        std::vector<ChunkResult> results;
+
+        // Start the workers.
+        std::vector<std::thread> workers;
+        for( uint32_t i = 0; i < m_ThreadCount; ++i )
+        {
+            workers.emplace_back( [&]() {
+                DeviceProfilerJsonParser parser;
+                Chunk chunk;
+
+                while( queue.Pop( chunk ) )
+                {
+                    ChunkResult result;
+                    ProcessChunk( parser, chunk, result );
+
+                    std::scoped_lock lk( resultsMutex );
+                    results[ chunk.m_Index ] = std::move( result );
+                }
+            } );
+        }
+
+        // Split the traceEvents array into chunks at line boundaries.
+        // Raw newlines cannot appear in JSON strings, so each line written by the layer holds complete events.
+        std::string pendingData;
+        bool eventsFound = false;
+        bool endOfEvents = false;
+        size_t chunkCount = 0;
+
+        while( !endOfEvents )
+        {
+            const size_t offset = pendingData.size();
+            pendingData.resize( offset + m_ChunkSize );
+            file.read( pendingData.data() + offset, m_ChunkSize );
+
+            const size_t readSize = static_cast<size_t>( file.gcount() );
+            pendingData.resize( offset + readSize );
+            analysis.m_ByteCount += readSize;
+
+            const bool endOfFile = ( readSize < m_ChunkSize );
+            size_t chunkBegin = 0;
+
+            if( !eventsFound )
+            {
+                const size_t eventsKey = pendingData.find( "\"traceEvents\"" );
+                const size_t eventsArray = ( eventsKey != std::string::npos ) ? pendingData.find( '[', eventsKey ) : std::string::npos;
+
+                if( eventsArray == std::string::npos )
+                {
+                    if( endOfFile )
+                    {
+                        m_ErrorMessage = "File '" + filename.string() + "' does not contain traceEvents array.";
+                        break;
+                    }
+
+                    continue;
+                }
+
+                chunkBegin = eventsArray + 1;
+                eventsFound = true;
+            }
+
+            size_t chunkEnd = endOfFile ? pendingData.size() : pendingData.rfind( '\n' );
+            if( ( chunkEnd == std::string::npos ) || ( chunkEnd < chunkBegin ) )
+            {
+                pendingData.erase( 0, chunkBegin );
+                continue;
+            }
+
+            std::string_view events( pendingData.data() + chunkBegin, chunkEnd - chunkBegin );
+
+            if( endOfFile )
+            {
+                events = events.substr( 0, FindEndOfEvents( events ) );
+                endOfEvents = true;
+            }
+
+            events = TrimEvents( events );
+
+            if( !events.empty() )
+            {
+                Chunk chunk;
+                chunk.m_Index = chunkCount++;
+                chunk.m_Data = events;
+
+                {
+                    std::scoped_lock lk( resultsMutex );
+                    results.emplace_back();
+                }
+
+                queue.Push( std::move( chunk ) );
+            }
+
+            pendingData.erase( 0, chunkEnd );
+        }
+
+        queue.Close();
+
+        for( std::thread& worker : workers )
+        {
+            worker.join();
+        }
+
+        if( !m_ErrorMessage.empty() )
+        {
+            return false;
+        }
+
+        for( size_t i = 0; i < results.size(); ++i )
+        {
+            if( !results[ i ].m_Valid )
+            {
+                m_ErrorMessage = "Failed to parse events in chunk " + std::to_string( i ) + " of file '" + filename.string() + "'.";
+                return false;
+            }
+        }
+
+        MergeChunkResults( results, analysis );
+        return true;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ProcessChunk
+
+    Description:
+        Parses the events in the chunk and aggregates the regions that begin
+        and end in it.
+
+    \*************************************************************************/
+    void DeviceProfilerTraceAnalyzer::ProcessChunk( DeviceProfilerJsonParser& parser, Chunk& chunk, ChunkResult& result )
+    {
+        result.m_Valid = parser.ParseLines( chunk.m_Data );
+
+        // The data has been copied to the parser.
+        chunk.m_Data = std::string();
+
+        while( result.m_Valid )
+        {
+            DeviceProfilerJsonValueReader document = parser.GetParsedDocument();
+            if( !document.IsValid() )
+            {
+                break;
+            }
+
+            DeviceProfilerJsonObjectReader event = document.ReadObject();
+            if( !document || !event.IsValid() )
+            {
+                result.m_Valid = false;
+                break;
+            }
+
+            std::string_view name;
+            std::string_view category;
+            std::string_view lane;
+            std::string_view phase;
+            double timestamp = 0;
+            double duration = 0;
+
+            for( auto field : event )
+            {
+                if( field.first == "name" )
+                {
+                    name = field.second.ToStringView();
+                }
+                else if( field.first == "cat" )
+                {
+                    category = field.second.ToStringView();
+                }
+                else if( field.first == "ph" )
+                {
+                    phase = field.second.ToStringView();
+                }
+                else if( field.first == "ts" )
+                {
+                    timestamp = field.second.ToDouble();
+                }
+                else if( field.first == "dur" )
+                {
+                    duration = field.second.ToDouble();
+                }
+                else if( field.first == "tid" )
+                {
+                    lane = field.second.ToStringView();
+                }
+
+                if( !field.second )
+                {
+                    event.SetError();
+                }
+            }
+
+            if( !event )
+            {
+                result.m_Valid = false;
+                break;
+            }
+
+            result.m_Analysis.m_EventCount++;
+
+            DeviceProfilerTraceRegionType type;
+            if( phase.empty() || !GetRegionType( category, type ) )
+            {
+                continue;
+            }
+
+            DeviceProfilerTraceAnalysis::RegionMap& regions = result.m_Analysis.GetRegions( type );
+
+            switch( phase.front() )
+            {
+            case 'B':
+            {
+                ChunkResult::Lane& regionLane = result.m_Lanes[ static_cast<size_t>( type ) ][ std::string( lane ) ];
+                regionLane.m_OpenRegions.push_back( { std::string( name ), timestamp } );
+                break;
+            }
+
+            case 'E':
+            {
+                ChunkResult::Lane& regionLane = result.m_Lanes[ static_cast<size_t>( type ) ][ std::string( lane ) ];
+                if( regionLane.m_OpenRegions.empty() )
+                {
+                    // The region began in one of the previous chunks.
+                    regionLane.m_UnmatchedEnds.push_back( timestamp );
+                    break;
+                }
+
+                ChunkResult::OpenRegion& region = regionLane.m_OpenRegions.back();
+                regions[ region.m_Name ].Add( timestamp - region.m_Timestamp );
+                regionLane.m_OpenRegions.pop_back();
+                break;
+            }
+
+            case 'X':
+            {
+                regions[ std::string( name ) ].Add( duration );
+                break;
+            }
+            }
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        MergeChunkResults
+
+    Description:
+        Accumulates results of all chunks and matches the regions crossing
+        the chunk boundaries.
+
+    \*************************************************************************/
+    void DeviceProfilerTraceAnalyzer::MergeChunkResults( std::vector<ChunkResult>& results, DeviceProfilerTraceAnalysis& analysis )
+    {
+        ChunkResult::LaneMap openRegions[ static_cast<size_t>( DeviceProfilerTraceRegionType::eCount ) ];
+
+        for( ChunkResult& result : results )
+        {
+            analysis.Merge( result.m_Analysis );
+
+            for( size_t i = 0; i < static_cast<size_t>( DeviceProfilerTraceRegionType::eCount ); ++i )
+            {
+                DeviceProfilerTraceAnalysis::RegionMap& regions = analysis.m_Regions[ i ];
+
+                for( auto& [laneName, lane] : result.m_Lanes[ i ] )
+                {
+                    std::vector<ChunkResult::OpenRegion>& stack = openRegions[ i ][ laneName ].m_OpenRegions;
+
+                    // All unmatched ends in the chunk precede the regions that remain open.
+                    for( double endTimestamp : lane.m_UnmatchedEnds )
+                    {
+                        if( stack.empty() )
+                        {
+                            // The region began before the trace capture started.
+                            continue;
+                        }
+
+                        ChunkResult::OpenRegion& region = stack.back();
+                        regions[ region.m_Name ].Add( endTimestamp - region.m_Timestamp );
+                        stack.pop_back();
+                    }
+
+                    stack.insert( stack.end(),
+                        std::make_move_iterator( lane.m_OpenRegions.begin() ),
+                        std::make_move_iterator( lane.m_OpenRegions.end() ) );
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,141 @@
+// Copyright (c) 2026 Lukasz Stalmirski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include <stdint.h>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Profiler
+{
+    class DeviceProfilerJsonParser;
+
+    /*************************************************************************\
+
+    Enumeration:
+        DeviceProfilerTraceRegionType
+
+    Description:
+        Types of the trace regions aggregated by the analyzer.
+
+    \*************************************************************************/
+    enum class DeviceProfilerTraceRegionType
+    {
+        ePipeline,
+        eRenderPass,
+        eDebugLabel,
+        eCount
+    };
+
+    /*************************************************************************\
+
+    Structure:
+        DeviceProfilerTraceRegionStats
+
+    Description:
+        Aggregated durations of the trace regions with the same name.
+        All durations are in microseconds.
+
+    \*************************************************************************/
+    struct DeviceProfilerTraceRegionStats
+    {
+        uint64_t m_Count = 0;
+        double m_TotalDuration = 0;
+        double m_MinDuration = 0;
+        double m_MaxDuration = 0;
+
+        void Add( double duration );
+        void Merge( const DeviceProfilerTraceRegionStats& other );
+
+        double GetAverageDuration() const { return m_Count ? ( m_TotalDuration / m_Count ) : 0; }
+    };
+
+    /*************************************************************************\
+
+    Structure:
+        DeviceProfilerTraceAnalysis
+
+    Description:
+        Result of the trace analysis.
+
+    \*************************************************************************/
+    struct DeviceProfilerTraceAnalysis
+    {
+        using RegionMap = std::unordered_map<std::string, DeviceProfilerTraceRegionStats>;
+
+        RegionMap m_Regions[ static_cast<size_t>( DeviceProfilerTraceRegionType::eCount ) ];
+
+        uint64_t m_EventCount = 0;
+        uint64_t m_ByteCount = 0;
+
+        RegionMap& GetRegions( DeviceProfilerTraceRegionType type ) { return m_Regions[ static_cast<size_t>( type ) ]; }
+        const RegionMap& GetRegions( DeviceProfilerTraceRegionType type ) const { return m_Regions[ static_cast<size_t>( type ) ]; }
+
+        void Merge( const DeviceProfilerTraceAnalysis& other );
+    };
+
+    /*************************************************************************\
+
+    Class:
+        DeviceProfilerTraceAnalyzer
+
+    Description:
+        Computes per-pipeline, per-render-pass and per-debug-label statistics
+        from trace files written by the layer.
+
+        The file is streamed in chunks split at event boundaries, which are
+        parsed in parallel. Regions crossing the chunk boundaries are matched
+        when the results of the chunks are merged.
+
+    \*************************************************************************/
+    class DeviceProfilerTraceAnalyzer
+    {
+    public:
+        DeviceProfilerTraceAnalyzer();
+        ~DeviceProfilerTraceAnalyzer();
+
+        void SetThreadCount( uint32_t threadCount );
+        void SetChunkSize( size_t chunkSize );
+
+        bool Analyze( const std::filesystem::path& filename, DeviceProfilerTraceAnalysis& analysis );
+
+        const std::string& GetErrorMessage() const;
+
+        static const char* GetRegionTypeName( DeviceProfilerTraceRegionType type );
+
+        static size_t FindEndOfEvents( std::string_view events );
+
+    private:
+        struct Chunk;
+        struct ChunkResult;
+        struct ChunkQueue;
+
+        uint32_t m_ThreadCount;
+        size_t m_ChunkSize;
+
+        std::string m_ErrorMessage;
+
+        static void ProcessChunk( DeviceProfilerJsonParser& parser, Chunk& chunk, ChunkResult& result );
+        static void MergeChunkResults( std::vector<ChunkResult>& results, DeviceProfilerTraceAnalysis& analysis );
+    };
+}
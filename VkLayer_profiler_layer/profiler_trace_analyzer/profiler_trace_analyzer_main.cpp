@@ -0,0 +1,553 @@
+// Copyright (c) 2026 Lukasz Stalmirski
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "profiler_trace_analyzer.h"
+#include "profiler_helpers/profiler_csv_helpers.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include <fmt/format.h>
+
+using namespace Profiler;
+
+namespace
+{
+    /*************************************************************************\
+
+    Structure:
+        Options
+
+    Description:
+        Command line options of the analyzer.
+
+    \*************************************************************************/
+    struct Options
+    {
+        std::filesystem::path m_TraceA;
+        std::filesystem::path m_TraceB;
+        std::filesystem::path m_Output;
+        std::string m_NameA;
+        std::string m_NameB;
+        uint32_t m_ThreadCount = 0;
+        size_t m_ChunkSize = 0;
+        size_t m_BenchmarkSize = 0;
+    };
+
+    /*************************************************************************\
+
+    Function:
+        PrintUsage
+
+    Description:
+        Prints command line syntax of the analyzer.
+
+    \*************************************************************************/
+    void PrintUsage( const char* pProgramName )
+    {
+        std::cout <<
+            "Usage: " << pProgramName << " [options] <trace> [<trace_b>]\n"
+            "\n"
+            "Aggregates durations of pipelines, render passes and debug labels in a trace file\n"
+            "written by the profiling layer. When two traces are given, writes the differences\n"
+            "between them.\n"
+            "\n"
+            "Options:\n"
+            "  -o, --output <file>     Path to the output CSV file.\n"
+            "  --name-a <name>         Name of the first trace in the output file.\n"
+            "  --name-b <name>         Name of the second trace in the output file.\n"
+            "  -j, --threads <count>   Number of parsing threads (default: all cores).\n"
+            "  --chunk-size <MB>       Size of the chunks parsed in parallel (default: 16).\n"
+            "  --benchmark <MB>        Generate a trace of the given size and measure the analysis time.\n"
+            "  -h, --help              Print this message.\n";
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ParseOptions
+
+    Description:
+        Parses the command line arguments.
+
+    \*************************************************************************/
+    bool ParseOptions( int argc, char** argv, Options& options )
+    {
+        std::vector<std::string_view> positional;
+
+        for( int i = 1; i < argc; ++i )
+        {
+            const std::string_view arg = argv[ i ];
+            const bool hasValue = ( i + 1 < argc );
+
+            if( ( arg == "-h" ) || ( arg == "--help" ) )
+            {
+                return false;
+            }
+            else if( ( ( arg == "-o" ) || ( arg == "--output" ) ) && hasValue )
+            {
+                options.m_Output = argv[ ++i ];
+            }
+            else if( ( arg == "--name-a" ) && hasValue )
+            {
+                options.m_NameA = argv[ ++i ];
+            }
+            else if( ( arg == "--name-b" ) && hasValue )
+            {
+                options.m_NameB = argv[ ++i ];
+            }
+            else if( ( ( arg == "-j" ) || ( arg == "--threads" ) ) && hasValue )
+            {
+                options.m_ThreadCount = static_cast<uint32_t>( std::stoul( argv[ ++i ] ) );
+            }
+            else if( ( arg == "--chunk-size" ) && hasValue )
+            {
+                options.m_ChunkSize = std::stoull( argv[ ++i ] ) * 1024 * 1024;
+            }
+            else if( ( arg == "--benchmark" ) && hasValue )
+            {
+                options.m_BenchmarkSize = std::stoull( argv[ ++i ] ) * 1024 * 1024;
+            }
+            else if( !arg.empty() && ( arg.front() == '-' ) )
+            {
+                std::cerr << "Unknown option '" << arg << "'.\n";
+                return false;
+            }
+            else
+            {
+                positional.push_back( arg );
+            }
+        }
+
+        if( options.m_BenchmarkSize != 0 )
+        {
+            return positional.empty();
+        }
+
+        if( positional.empty() || ( positional.size() > 2 ) )
+        {
+            return false;
+        }
+
+        options.m_TraceA = positional[ 0 ];
+        if( options.m_NameA.empty() )
+        {
+            options.m_NameA = options.m_TraceA.stem().string();
+        }
+
+        if( positional.size() == 2 )
+        {
+            options.m_TraceB = positional[ 1 ];
+            if( options.m_NameB.empty() )
+            {
+                options.m_NameB = options.m_TraceB.stem().string();
+            }
+        }
+
+        if( options.m_Output.empty() )
+        {
+            options.m_Output = options.m_TraceB.empty()
+                ? ( options.m_NameA + ".csv" )
+                : ( options.m_NameA + "_vs_" + options.m_NameB + ".csv" );
+        }
+
+        return true;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GetCsvName
+
+    Description:
+        Returns region name that can be safely written to a CSV file.
+
+    \*************************************************************************/
+    std::string GetCsvName( std::string name )
+    {
+        std::replace( name.begin(), name.end(), ',', ';' );
+        std::replace( name.begin(), name.end(), '\n', ' ' );
+        return name;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WriteAnalysis
+
+    Description:
+        Writes statistics of a single trace to the CSV file.
+
+    \*************************************************************************/
+    bool WriteAnalysis( const Options& options, const DeviceProfilerTraceAnalysis& analysis )
+    {
+        DeviceProfilerCsvSerializer serializer;
+        if( !serializer.Open( options.m_Output.string() ) )
+        {
+            return false;
+        }
+
+        serializer.WriteHeader( {
+            "Type", "Name", "Count", "Total (us)", "Average (us)", "Min (us)", "Max (us)" } );
+
+        for( uint32_t i = 0; i < static_cast<uint32_t>( DeviceProfilerTraceRegionType::eCount ); ++i )
+        {
+            const DeviceProfilerTraceRegionType type = static_cast<DeviceProfilerTraceRegionType>( i );
+
+            // Sort the regions from the longest.
+            std::vector<const DeviceProfilerTraceAnalysis::RegionMap::value_type*> regions;
+            for( const auto& region : analysis.GetRegions( type ) )
+            {
+                regions.push_back( &region );
+            }
+
+            std::sort( regions.begin(), regions.end(),
+                []( const auto* pA, const auto* pB ) { return pA->second.m_TotalDuration > pB->second.m_TotalDuration; } );
+
+            for( const auto* pRegion : regions )
+            {
+                const DeviceProfilerTraceRegionStats& stats = pRegion->second;
+                serializer.WriteRow( {
+                    DeviceProfilerTraceAnalyzer::GetRegionTypeName( type ),
+                    GetCsvName( pRegion->first ),
+                    std::to_string( stats.m_Count ),
+                    fmt::format( "{:.3f}", stats.m_TotalDuration ),
+                    fmt::format( "{:.3f}", stats.GetAverageDuration() ),
+                    fmt::format( "{:.3f}", stats.m_MinDuration ),
+                    fmt::format( "{:.3f}", stats.m_MaxDuration ) } );
+            }
+        }
+
+        return true;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WriteComparison
+
+    Description:
+        Writes differences between two traces to the CSV file.
+
+    \*************************************************************************/
+    bool WriteComparison( const Options& options, const DeviceProfilerTraceAnalysis& analysisA, const DeviceProfilerTraceAnalysis& analysisB )
+    {
+        struct Row
+        {
+            const std::string* m_pName;
+            DeviceProfilerTraceRegionStats m_A;
+            DeviceProfilerTraceRegionStats m_B;
+
+            double GetDelta() const { return m_B.m_TotalDuration - m_A.m_TotalDuration; }
+        };
+
+        DeviceProfilerCsvSerializer serializer;
+        if( !serializer.Open( options.m_Output.string() ) )
+        {
+            return false;
+        }
+
+        serializer.WriteHeader( {
+            "Type", "Name",
+            options.m_NameA + " count", options.m_NameA + " (us)",
+            options.m_NameB + " count", options.m_NameB + " (us)",
+            "Delta (us)", "Delta %" } );
+
+        for( uint32_t i = 0; i < static_cast<uint32_t>( DeviceProfilerTraceRegionType::eCount ); ++i )
+        {
+            const DeviceProfilerTraceRegionType type = static_cast<DeviceProfilerTraceRegionType>( i );
+            const DeviceProfilerTraceAnalysis::RegionMap& regionsA = analysisA.GetRegions( type );
+            const DeviceProfilerTraceAnalysis::RegionMap& regionsB = analysisB.GetRegions( type );
+
+            std::vector<Row> rows;
+            for( const auto& [name, stats] : regionsA )
+            {
+                auto it = regionsB.find( name );
+                rows.push_back( { &name, stats, ( it != regionsB.end() ) ? it->second : DeviceProfilerTraceRegionStats() } );
+            }
+
+            for( const auto& [name, stats] : regionsB )
+            {
+                if( regionsA.count( name ) == 0 )
+                {
+                    rows.push_back( { &name, DeviceProfilerTraceRegionStats(), stats } );
+                }
+            }
+
+            // Sort the regions by the most significant change.
+            std::sort( rows.begin(), rows.end(),
+                []( const Row& a, const Row& b ) { return std::abs( a.GetDelta() ) > std::abs( b.GetDelta() ); } );
+
+            for( const Row& row : rows )
+            {
+                const double delta = row.GetDelta();
+                const double deltaPercent = ( row.m_A.m_TotalDuration != 0 )
+                    ? ( 100.0 * delta / row.m_A.m_TotalDuration )
+                    : 100.0;
+
+                serializer.WriteRow( {
+                    DeviceProfilerTraceAnalyzer::GetRegionTypeName( type ),
+                    GetCsvName( *row.m_pName ),
+                    std::to_string( row.m_A.m_Count ),
+                    fmt::format( "{:.3f}", row.m_A.m_TotalDuration ),
+                    std::to_string( row.m_B.m_Count ),
+                    fmt::format( "{:.3f}", row.m_B.m_TotalDuration ),
+                    fmt::format( "{:.3f}", delta ),
+                    fmt::format( "{:.2f}", deltaPercent ) } );
+            }
+        }
+
+        return true;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        GenerateBenchmarkTrace
+
+    Description:
+        Writes a synthetic per-drawcall trace of approximately the given size.
+        The layout of the events follows the trace output of the layer.
+
+    \*************************************************************************/
+    bool GenerateBenchmarkTrace( const std::filesystem::path& filename, size_t size )
+    {
+        std::ofstream file( filename, std::ios::out | std::ios::trunc | std::ios::binary );
+        if( !file.is_open() )
+        {
+            return false;
+        }
+
+        static constexpr const char* pQueue = "VkQueue 0x000055d5c0a3e2f0";
+        static constexpr uint32_t RenderPassesPerFrame = 8;
+        static constexpr uint32_t PipelinesPerRenderPass = 16;
+        static constexpr uint32_t DrawcallsPerPipeline = 8;
+        static constexpr uint32_t PipelineCount = 256;
+
+        fmt::memory_buffer buffer;
+        size_t writtenSize = 0;
+        double timestamp = 0;
+
+        auto appendEvent = [&]( std::string_view name, std::string_view category, char phase, const char* pLane ) {
+            fmt::format_to( std::back_inserter( buffer ),
+                "{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"{}\",\"ts\":{:.3f},\"pid\":0,\"tid\":\"{}\"}},\n",
+                name, category, phase, timestamp, pLane );
+        };
+
+        fmt::format_to( std::back_inserter( buffer ),
+            "{{\"displayTimeUnit\":\"ns\",\n \"otherData\":{{}},\n \"traceEvents\":[\n" );
+
+        for( uint32_t frameIndex = 0; writtenSize < size; ++frameIndex )
+        {
+            const std::string frameName = fmt::format( "Frame #{}", frameIndex );
+            appendEvent( frameName, "", 'B', pQueue );
+
+            for( uint32_t renderPassIndex = 0; renderPassIndex < RenderPassesPerFrame; ++renderPassIndex )
+            {
+                const std::string renderPassName = fmt::format( "VkRenderPass 0x{:016x}", 0x1000 + renderPassIndex );
+                const std::string debugLabelName = fmt::format( "Pass {}", renderPassIndex );
+                appendEvent( debugLabelName, "Debug", 'B', "Debug labels" );
+                appendEvent( renderPassName, "Render passes", 'B', pQueue );
+
+                for( uint32_t i = 0; i < PipelinesPerRenderPass; ++i )
+                {
+                    const uint32_t pipelineIndex = ( frameIndex * 7 + renderPassIndex * PipelinesPerRenderPass + i ) % PipelineCount;
+                    const std::string pipelineName = fmt::format( "VS=0x{:08x} PS=0x{:08x}", 0xA000 + pipelineIndex, 0xB000 + pipelineIndex );
+                    appendEvent( pipelineName, "Pipelines", 'B', pQueue );
+
+                    for( uint32_t drawcallIndex = 0; drawcallIndex < DrawcallsPerPipeline; ++drawcallIndex )
+                    {
+                        appendEvent( "vkCmdDrawIndexed (3072, 1, 0, 0, 0)", "Drawcalls", 'B', pQueue );
+                        timestamp += 1.0 + 0.25 * ( pipelineIndex % 5 );
+                        appendEvent( "vkCmdDrawIndexed (3072, 1, 0, 0, 0)", "Drawcalls", 'E', pQueue );
+                    }
+
+                    appendEvent( pipelineName, "Pipelines", 'E', pQueue );
+                }
+
+                appendEvent( renderPassName, "Render passes", 'E', pQueue );
+                appendEvent( debugLabelName, "Debug", 'E', "Debug labels" );
+            }
+
+            appendEvent( frameName, "", 'E', pQueue );
+
+            file.write( buffer.data(), buffer.size() );
+            writtenSize += buffer.size();
+            buffer.clear();
+        }
+
+        // Remove the last comma and close the array.
+        file.seekp( -2, std::ios::end );
+        file << "\n]}\n";
+
+        return !file.fail();
+    }
+
+    /*************************************************************************\
+
+    Function:
+        RunBenchmark
+
+    Description:
+        Measures the analysis time of a generated trace with increasing
+        number of threads.
+
+    \*************************************************************************/
+    int RunBenchmark( const Options& options )
+    {
+        const std::filesystem::path filename =
+            std::filesystem::temp_directory_path() / "profiler_trace_analyzer_benchmark.json";
+
+        std::cout << "Generating " << ( options.m_BenchmarkSize >> 20 ) << " MB trace in " << filename.string() << "...\n";
+
+        if( !GenerateBenchmarkTrace( filename, options.m_BenchmarkSize ) )
+        {
+            std::cerr << "Failed to generate the benchmark trace.\n";
+            return 1;
+        }
+
+        const uint32_t maxThreadCount = ( options.m_ThreadCount != 0 )
+            ? options.m_ThreadCount
+            : std::max( 1U, std::thread::hardware_concurrency() );
+
+        int exitCode = 0;
+
+        for( uint32_t threadCount = 1;; threadCount = std::min( threadCount * 2, maxThreadCount ) )
+        {
+            DeviceProfilerTraceAnalyzer analyzer;
+            analyzer.SetThreadCount( threadCount );
+
+            if( options.m_ChunkSize != 0 )
+            {
+                analyzer.SetChunkSize( options.m_ChunkSize );
+            }
+
+            DeviceProfilerTraceAnalysis analysis;
+
+            const auto begin = std::chrono::steady_clock::now();
+            const bool success = analyzer.Analyze( filename, analysis );
+            const auto end = std::chrono::steady_clock::now();
+
+            if( !success )
+            {
+                std::cerr << analyzer.GetErrorMessage() << "\n";
+                exitCode = 1;
+                break;
+            }
+
+            const double seconds = std::chrono::duration<double>( end - begin ).count();
+            std::cout << fmt::format( "{:3} thread(s): {:8.3f} s, {:8.1f} MB/s, {} events\n",
+                threadCount,
+                seconds,
+                ( analysis.m_ByteCount / ( 1024.0 * 1024.0 ) ) / seconds,
+                analysis.m_EventCount );
+
+            if( threadCount == maxThreadCount )
+            {
+                break;
+            }
+        }
+
+        std::filesystem::remove( filename );
+        return exitCode;
+    }
+}
+
+/*************************************************************************\
+
+Function:
+    main
+
+Description:
+    Entry point of the trace analyzer.
+
+\*************************************************************************/
+int main( int argc, char** argv )
+{
+    Options options;
+
+    try
+    {
+        if( !ParseOptions( argc, argv, options ) )
+        {
+            PrintUsage( argv[ 0 ] );
+            return 1;
+        }
+    }
+    catch( const std::exception& )
+    {
+        PrintUsage( argv[ 0 ] );
+        return 1;
+    }
+
+    if( options.m_BenchmarkSize != 0 )
+    {
+        return RunBenchmark( options );
+    }
+
+    DeviceProfilerTraceAnalyzer analyzer;
+
+    if( options.m_ThreadCount != 0 )
+    {
+        analyzer.SetThreadCount( options.m_ThreadCount );
+    }
+
+    if( options.m_ChunkSize != 0 )
+    {
+        analyzer.SetChunkSize( options.m_ChunkSize );
+    }
+
+    DeviceProfilerTraceAnalysis analysisA;
+    if( !analyzer.Analyze( options.m_TraceA, analysisA ) )
+    {
+        std::cerr << analyzer.GetErrorMessage() << "\n";
+        return 1;
+    }
+
+    bool success = false;
+
+    if( options.m_TraceB.empty() )
+    {
+        success = WriteAnalysis( options, analysisA );
+    }
+    else
+    {
+        DeviceProfilerTraceAnalysis analysisB;
+        if( !analyzer.Analyze( options.m_TraceB, analysisB ) )
+        {
+            std::cerr << analyzer.GetErrorMessage() << "\n";
+            return 1;
+        }
+
+        success = WriteComparison( options, analysisA, analysisB );
+    }
+
+    if( !success )
+    {
+        std::cerr << "Could not open file '" << options.m_Output.string() << "' for writing.\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,1244 @@
+// Copyright (c) 2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "profiler_viewer.h"
+#include "profiler/profiler_helpers.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+namespace
+{
+    // Size of the viewer window when it is created.
+    static constexpr uint32_t g_scDefaultWindowWidth = 1280;
+    static constexpr uint32_t g_scDefaultWindowHeight = 800;
+
+    // Background of the overlay.
+    static constexpr VkClearColorValue g_scClearColor = { { 0.06f, 0.06f, 0.06f, 1.0f } };
+}
+
+namespace Profiler
+{
+    /*************************************************************************\
+
+    Function:
+        ProfilerViewer
+
+    Description:
+        Constructor.
+
+    \*************************************************************************/
+    ProfilerViewer::ProfilerViewer()
+        : m_Frontend()
+        , m_Instance()
+        , m_Device()
+        , m_OverlayBackend()
+        , m_pOverlay()
+    {
+        ResetMembers();
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ~ProfilerViewer
+
+    Description:
+        Destructor.
+
+    \*************************************************************************/
+    ProfilerViewer::~ProfilerViewer()
+    {
+        Destroy();
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Initialize
+
+    Description:
+        Opens the shared memory segment and creates the window and the
+        Vulkan objects required to present the overlay.
+
+    \*************************************************************************/
+    bool ProfilerViewer::Initialize( const char* pSegmentName )
+    {
+        Destroy();
+
+        bool success = m_Frontend.Initialize( pSegmentName );
+
+        if( success )
+        {
+            const VkApplicationInfo& applicationInfo = m_Frontend.GetApplicationInfo();
+
+            std::string title = "Vulkan Profiler - ";
+            title += ( applicationInfo.pApplicationName && applicationInfo.pApplicationName[ 0 ] )
+                ? applicationInfo.pApplicationName
+                : pSegmentName;
+
+            success = InitializeWindow( title.c_str() );
+        }
+
+        VkResult result = success ? VK_SUCCESS : VK_ERROR_INITIALIZATION_FAILED;
+
+        if( result == VK_SUCCESS )
+        {
+            result = CreateInstance();
+        }
+
+        if( result == VK_SUCCESS )
+        {
+            result = CreateDevice();
+        }
+
+        if( result == VK_SUCCESS )
+        {
+            result = m_OverlayBackend.Initialize( m_Device );
+        }
+
+        if( result == VK_SUCCESS )
+        {
+            result = CreateSwapchain();
+        }
+
+        if( result == VK_SUCCESS )
+        {
+            m_pOverlay = std::make_unique<ProfilerOverlayOutput>( m_Frontend, m_OverlayBackend );
+
+            if( !m_pOverlay->Initialize() )
+            {
+                m_pOverlay.reset();
+                result = VK_ERROR_INITIALIZATION_FAILED;
+            }
+        }
+
+        if( result == VK_SUCCESS )
+        {
+            // The overlay is the only content of the window.
+            m_pOverlay->SetFullscreen( true );
+
+            // Start with the frames already published to the segment.
+            const uint64_t publishedFrameCount = m_Frontend.GetPublishedFrameCount();
+            m_UpdatedFrameCount = publishedFrameCount - std::min<uint64_t>( publishedFrameCount, ProfilerSharedMemoryFrameCount );
+        }
+
+        if( result != VK_SUCCESS )
+        {
+            Destroy();
+        }
+
+        return ( result == VK_SUCCESS );
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Destroy
+
+    Description:
+        Destroys the overlay, the Vulkan objects and the window.
+
+    \*************************************************************************/
+    void ProfilerViewer::Destroy()
+    {
+        if( m_Device.Handle != VK_NULL_HANDLE )
+        {
+            m_Device.Callbacks.DeviceWaitIdle( m_Device.Handle );
+        }
+
+        if( m_pOverlay )
+        {
+            m_pOverlay->Destroy();
+            m_pOverlay.reset();
+        }
+
+        if( m_OverlayBackend.IsInitialized() )
+        {
+            m_OverlayBackend.Destroy();
+        }
+
+        if( m_Device.Handle != VK_NULL_HANDLE )
+        {
+            DestroySwapchainResources();
+
+            if( m_Swapchain != VK_NULL_HANDLE )
+            {
+                m_Device.Callbacks.DestroySwapchainKHR( m_Device.Handle, m_Swapchain, nullptr );
+            }
+
+            if( m_CommandPool != VK_NULL_HANDLE )
+            {
+                m_Device.Callbacks.DestroyCommandPool( m_Device.Handle, m_CommandPool, nullptr );
+            }
+
+            m_Device.Callbacks.DestroyDevice( m_Device.Handle, nullptr );
+        }
+
+        if( m_Instance.Handle != VK_NULL_HANDLE )
+        {
+            if( m_Surface != VK_NULL_HANDLE )
+            {
+                m_Instance.Callbacks.DestroySurfaceKHR( m_Instance.Handle, m_Surface, nullptr );
+            }
+
+            m_Instance.Callbacks.DestroyInstance( m_Instance.Handle, nullptr );
+        }
+
+        DestroyWindow();
+
+        m_Frontend.Destroy();
+
+        ResetMembers();
+    }
+
+    /*************************************************************************\
+
+    Function:
+        Run
+
+    Description:
+        Renders the overlay until the window is closed.
+
+    \*************************************************************************/
+    void ProfilerViewer::Run()
+    {
+        while( m_pOverlay && !m_Exit )
+        {
+            ProcessWindowEvents();
+
+            if( m_Exit )
+            {
+                break;
+            }
+
+            if( m_SwapchainOutdated )
+            {
+                VkResult result = CreateSwapchain();
+
+                if( result == VK_NOT_READY )
+                {
+                    // The window is minimized, wait until it is restored.
+                    std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+                    continue;
+                }
+
+                if( result != VK_SUCCESS )
+                {
+                    ProfilerPlatformFunctions::WriteDebug( "Failed to recreate the swapchain (VkResult %d)\n", result );
+                    break;
+                }
+            }
+
+            RenderFrame();
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ResetMembers
+
+    Description:
+        Sets all members to their initial values.
+
+    \*************************************************************************/
+    void ProfilerViewer::ResetMembers()
+    {
+        m_Instance.Handle = VK_NULL_HANDLE;
+        m_Instance.Callbacks = {};
+        m_Instance.SetInstanceLoaderData = nullptr;
+        m_Instance.ApplicationInfo = {};
+        m_Instance.ApplicationName.clear();
+        m_Instance.EngineName.clear();
+        m_Instance.LoaderVersion = 0;
+        m_Instance.EnabledExtensions.clear();
+        m_Instance.PhysicalDevices.clear();
+        m_Instance.Surfaces.clear();
+
+        m_Device.Handle = VK_NULL_HANDLE;
+        m_Device.pInstance = nullptr;
+        m_Device.pPhysicalDevice = nullptr;
+        m_Device.EnabledFeatures = {};
+        m_Device.Callbacks = {};
+        m_Device.SetDeviceLoaderData = nullptr;
+        m_Device.Queues.clear();
+        m_Device.EnabledExtensions.clear();
+        m_Device.Swapchains.clear();
+        m_pQueue = nullptr;
+
+        m_Surface = VK_NULL_HANDLE;
+        m_Swapchain = VK_NULL_HANDLE;
+        m_SwapchainCreateInfo = {};
+        m_SwapchainImages.clear();
+        m_SwapchainOutdated = false;
+
+        m_CommandPool = VK_NULL_HANDLE;
+        m_CommandBuffers.clear();
+        m_CommandFences.clear();
+        m_AcquireSemaphores.clear();
+        m_ClearSemaphores.clear();
+        m_NextAcquireSemaphore = VK_NULL_HANDLE;
+
+        m_UpdatedFrameCount = 0;
+        m_Exit = false;
+
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+        m_Window = nullptr;
+#elif defined( VK_USE_PLATFORM_XCB_KHR )
+        m_pConnection = nullptr;
+        m_Window = 0;
+        m_DeleteWindowAtom = 0;
+#endif
+    }
+
+    /*************************************************************************\
+
+    Function:
+        CreateInstance
+
+    Description:
+        Creates the Vulkan instance and the surface of the viewer window.
+
+    \*************************************************************************/
+    VkResult ProfilerViewer::CreateInstance()
+    {
+        const char* pExtensions[] = {
+            VK_KHR_SURFACE_EXTENSION_NAME,
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+            VK_KHR_WIN32_SURFACE_EXTENSION_NAME
+#elif defined( VK_USE_PLATFORM_XCB_KHR )
+            VK_KHR_XCB_SURFACE_EXTENSION_NAME
+#endif
+        };
+
+        m_Instance.ApplicationName = "VkProfilerViewer";
+
+        VkApplicationInfo& applicationInfo = m_Instance.ApplicationInfo;
+        applicationInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+        applicationInfo.pApplicationName = m_Instance.ApplicationName.c_str();
+        applicationInfo.apiVersion = VK_API_VERSION_1_1;
+
+        VkInstanceCreateInfo createInfo = {};
+        createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+        createInfo.pApplicationInfo = &applicationInfo;
+        createInfo.enabledExtensionCount = std::extent_v<decltype( pExtensions )>;
+        createInfo.ppEnabledExtensionNames = pExtensions;
+
+        VkResult result = vkCreateInstance( &createInfo, nullptr, &m_Instance.Handle );
+
+        if( result == VK_SUCCESS )
+        {
+            m_Instance.Callbacks.Initialize( m_Instance.Handle, vkGetInstanceProcAddr );
+            m_Instance.EnabledExtensions.insert( std::begin( pExtensions ), std::end( pExtensions ) );
+
+            vkEnumerateInstanceVersion( &m_Instance.LoaderVersion );
+        }
+
+        // Create the surface of the viewer window.
+        if( result == VK_SUCCESS )
+        {
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+            VkWin32SurfaceCreateInfoKHR surfaceCreateInfo = {};
+            surfaceCreateInfo.sType = VK_STRUCTURE_TYPE_WIN32_SURFACE_CREATE_INFO_KHR;
+            surfaceCreateInfo.hinstance = GetModuleHandle( nullptr );
+            surfaceCreateInfo.hwnd = m_Window;
+
+            result = m_Instance.Callbacks.CreateWin32SurfaceKHR(
+                m_Instance.Handle,
+                &surfaceCreateInfo,
+                nullptr,
+                &m_Surface );
+#elif defined( VK_USE_PLATFORM_XCB_KHR )
+            VkXcbSurfaceCreateInfoKHR surfaceCreateInfo = {};
+            surfaceCreateInfo.sType = VK_STRUCTURE_TYPE_XCB_SURFACE_CREATE_INFO_KHR;
+            surfaceCreateInfo.connection = m_pConnection;
+            surfaceCreateInfo.window = m_Window;
+
+            result = m_Instance.Callbacks.CreateXcbSurfaceKHR(
+                m_Instance.Handle,
+                &surfaceCreateInfo,
+                nullptr,
+                &m_Surface );
+#endif
+        }
+
+        if( result == VK_SUCCESS )
+        {
+            // The overlay backend finds the window of the swapchain in the surfaces of the instance.
+            VkSurfaceKhr_Object surfaceObject = {};
+            surfaceObject.Handle = m_Surface;
+            surfaceObject.Window = OSWindowHandle( m_Window );
+
+            m_Instance.Surfaces.emplace( m_Surface, surfaceObject );
+        }
+
+        return result;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        CreateDevice
+
+    Description:
+        Selects a physical device that can present to the viewer window and
+        creates the logical device with a single graphics queue.
+
+    \*************************************************************************/
+    VkResult ProfilerViewer::CreateDevice()
+    {
+        uint32_t physicalDeviceCount = 0;
+        m_Instance.Callbacks.EnumeratePhysicalDevices( m_Instance.Handle, &physicalDeviceCount, nullptr );
+
+        std::vector<VkPhysicalDevice> physicalDevices( physicalDeviceCount );
+        VkResult result = m_Instance.Callbacks.EnumeratePhysicalDevices(
+            m_Instance.Handle, &physicalDeviceCount, physicalDevices.data() );
+
+        VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+        std::vector<VkQueueFamilyProperties> queueFamilyProperties;
+        uint32_t queueFamilyIndex = 0;
+
+        // Find a graphics queue that can present to the window.
+        for( uint32_t i = 0; ( i < physicalDeviceCount ) && ( physicalDevice == VK_NULL_HANDLE ) && ( result == VK_SUCCESS ); ++i )
+        {
+            uint32_t queueFamilyCount = 0;
+            m_Instance.Callbacks.GetPhysicalDeviceQueueFamilyProperties( physicalDevices[ i ], &queueFamilyCount, nullptr );
+
+            queueFamilyProperties.resize( queueFamilyCount );
+            m_Instance.Callbacks.GetPhysicalDeviceQueueFamilyProperties( physicalDevices[ i ], &queueFamilyCount, queueFamilyProperties.data() );
+
+            for( uint32_t j = 0; j < queueFamilyCount; ++j )
+            {
+                VkBool32 presentSupported = VK_FALSE;
+                m_Instance.Callbacks.GetPhysicalDeviceSurfaceSupportKHR( physicalDevices[ i ], j, m_Surface, &presentSupported );
+
+                if( ( queueFamilyProperties[ j ].queueFlags & VK_QUEUE_GRAPHICS_BIT ) && presentSupported )
+                {
+                    physicalDevice = physicalDevices[ i ];
+                    queueFamilyIndex = j;
+                    break;
+                }
+            }
+        }
+
+        if( ( result == VK_SUCCESS ) && ( physicalDevice == VK_NULL_HANDLE ) )
+        {
+            result = VK_ERROR_INITIALIZATION_FAILED;
+        }
+
+        VkPhysicalDevice_Object* pPhysicalDevice = nullptr;
+
+        if( result == VK_SUCCESS )
+        {
+            pPhysicalDevice = &m_Instance.PhysicalDevices[ physicalDevice ];
+            pPhysicalDevice->Handle = physicalDevice;
+            pPhysicalDevice->pInstance = &m_Instance;
+            pPhysicalDevice->QueueFamilyProperties = queueFamilyProperties;
+
+            m_Instance.Callbacks.GetPhysicalDeviceProperties( physicalDevice, &pPhysicalDevice->Properties );
+            m_Instance.Callbacks.GetPhysicalDeviceMemoryProperties( physicalDevice, &pPhysicalDevice->MemoryProperties );
+            m_Instance.Callbacks.GetPhysicalDeviceFeatures( physicalDevice, &pPhysicalDevice->Features );
+
+            pPhysicalDevice->VendorID = static_cast<VkPhysicalDevice_Vendor_ID>( pPhysicalDevice->Properties.vendorID );
+
+            const float queuePriority = 1.0f;
+
+            VkDeviceQueueCreateInfo queueCreateInfo = {};
+            queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+            queueCreateInfo.queueFamilyIndex = queueFamilyIndex;
+            queueCreateInfo.queueCount = 1;
+            queueCreateInfo.pQueuePriorities = &queuePriority;
+
+            const char* pExtensions[] = {
+                VK_KHR_SWAPCHAIN_EXTENSION_NAME
+            };
+
+            VkDeviceCreateInfo createInfo = {};
+            createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+            createInfo.queueCreateInfoCount = 1;
+            createInfo.pQueueCreateInfos = &queueCreateInfo;
+            createInfo.enabledExtensionCount = std::extent_v<decltype( pExtensions )>;
+            createInfo.ppEnabledExtensionNames = pExtensions;
+
+            result = m_Instance.Callbacks.CreateDevice(
+                physicalDevice,
+                &createInfo,
+                nullptr,
+                &m_Device.Handle );
+
+            if( result == VK_SUCCESS )
+            {
+                m_Device.EnabledExtensions.insert( std::begin( pExtensions ), std::end( pExtensions ) );
+            }
+        }
+
+        if( result == VK_SUCCESS )
+        {
+            m_Device.pInstance = &m_Instance;
+            m_Device.pPhysicalDevice = pPhysicalDevice;
+
+            // The viewer is not a layer, so the dispatchable objects created by the overlay
+            // don't need the loader data and the functions are loaded from the loader.
+            m_Device.Callbacks.Initialize( m_Device.Handle, vkGetDeviceProcAddr );
+            m_Device.SetDeviceLoaderData = nullptr;
+
+            VkQueue queue = VK_NULL_HANDLE;
+            m_Device.Callbacks.GetDeviceQueue( m_Device.Handle, queueFamilyIndex, 0, &queue );
+
+            auto it = m_Device.Queues.try_emplace(
+                queue,
+                queue,
+                queueFamilyProperties[ queueFamilyIndex ].queueFlags,
+                queueFamilyIndex,
+                0 );
+
+            m_pQueue = &it.first->second;
+        }
+
+        // Create command pool for the clear commands.
+        if( result == VK_SUCCESS )
+        {
+            VkCommandPoolCreateInfo createInfo = {};
+            createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+            createInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+            createInfo.queueFamilyIndex = queueFamilyIndex;
+
+            result = m_Device.Callbacks.CreateCommandPool(
+                m_Device.Handle,
+                &createInfo,
+                nullptr,
+                &m_CommandPool );
+        }
+
+        return result;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        CreateSwapchain
+
+    Description:
+        Creates or recreates the swapchain to match the size of the window.
+        Returns VK_NOT_READY if the window is minimized.
+
+    \*************************************************************************/
+    VkResult ProfilerViewer::CreateSwapchain()
+    {
+        VkSurfaceCapabilitiesKHR surfaceCapabilities = {};
+        VkResult result = m_Instance.Callbacks.GetPhysicalDeviceSurfaceCapabilitiesKHR(
+            m_Device.pPhysicalDevice->Handle,
+            m_Surface,
+            &surfaceCapabilities );
+
+        VkExtent2D extent = surfaceCapabilities.currentExtent;
+
+        if( extent.width == UINT32_MAX )
+        {
+            // The size of the surface is determined by the swapchain.
+            extent.width = std::clamp( g_scDefaultWindowWidth, surfaceCapabilities.minImageExtent.width, surfaceCapabilities.maxImageExtent.width );
+            extent.height = std::clamp( g_scDefaultWindowHeight, surfaceCapabilities.minImageExtent.height, surfaceCapabilities.maxImageExtent.height );
+        }
+
+        if( ( result == VK_SUCCESS ) && ( ( extent.width == 0 ) || ( extent.height == 0 ) ) )
+        {
+            return VK_NOT_READY;
+        }
+
+        VkSurfaceFormatKHR surfaceFormat = { VK_FORMAT_B8G8R8A8_UNORM, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR };
+
+        if( result == VK_SUCCESS )
+        {
+            uint32_t surfaceFormatCount = 0;
+            m_Instance.Callbacks.GetPhysicalDeviceSurfaceFormatsKHR(
+                m_Device.pPhysicalDevice->Handle, m_Surface, &surfaceFormatCount, nullptr );
+
+            std::vector<VkSurfaceFormatKHR> surfaceFormats( surfaceFormatCount );
+            result = m_Instance.Callbacks.GetPhysicalDeviceSurfaceFormatsKHR(
+                m_Device.pPhysicalDevice->Handle, m_Surface, &surfaceFormatCount, surfaceFormats.data() );
+
+            // The overlay colors are defined in the UNORM space, prefer the formats without the sRGB conversion.
+            auto it = std::find_if( surfaceFormats.begin(), surfaceFormats.end(),
+                []( const VkSurfaceFormatKHR& format ) {
+                    return ( format.format == VK_FORMAT_B8G8R8A8_UNORM ) || ( format.format == VK_FORMAT_R8G8B8A8_UNORM );
+                } );
+
+            if( it != surfaceFormats.end() )
+            {
+                surfaceFormat = *it;
+            }
+            else if( !surfaceFormats.empty() && ( surfaceFormats.front().format != VK_FORMAT_UNDEFINED ) )
+            {
+                surfaceFormat = surfaceFormats.front();
+            }
+        }
+
+        // Wait until the previous swapchain is not used anymore.
+        if( result == VK_SUCCESS )
+        {
+            result = m_Device.Callbacks.DeviceWaitIdle( m_Device.Handle );
+        }
+
+        if( result == VK_SUCCESS )
+        {
+            DestroySwapchainResources();
+
+            uint32_t imageCount = surfaceCapabilities.minImageCount + 1;
+            if( surfaceCapabilities.maxImageCount != 0 )
+            {
+                imageCount = std::min( imageCount, surfaceCapabilities.maxImageCount );
+            }
+
+            VkCompositeAlphaFlagBitsKHR compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+            if( !( surfaceCapabilities.supportedCompositeAlpha & compositeAlpha ) )
+            {
+                // Select the lowest supported bit.
+                compositeAlpha = static_cast<VkCompositeAlphaFlagBitsKHR>(
+                    surfaceCapabilities.supportedCompositeAlpha & ( ~surfaceCapabilities.supportedCompositeAlpha + 1 ) );
+            }
+
+            VkSwapchainCreateInfoKHR& createInfo = m_SwapchainCreateInfo;
+            createInfo = {};
+            createInfo.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+            createInfo.surface = m_Surface;
+            createInfo.minImageCount = imageCount;
+            createInfo.imageFormat = surfaceFormat.format;
+            createInfo.imageColorSpace = surfaceFormat.colorSpace;
+            createInfo.imageExtent = extent;
+            createInfo.imageArrayLayers = 1;
+            createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+            createInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            createInfo.preTransform = surfaceCapabilities.currentTransform;
+            createInfo.compositeAlpha = compositeAlpha;
+            createInfo.presentMode = VK_PRESENT_MODE_FIFO_KHR;
+            createInfo.clipped = VK_TRUE;
+            createInfo.oldSwapchain = m_Swapchain;
+
+            VkSwapchainKHR swapchain = VK_NULL_HANDLE;
+            result = m_Device.Callbacks.CreateSwapchainKHR(
+                m_Device.Handle,
+                &createInfo,
+                nullptr,
+                &swapchain );
+
+            if( result == VK_SUCCESS )
+            {
+                result = m_OverlayBackend.SetSwapchain( swapchain, createInfo );
+            }
+
+            // The old swapchain is retired even if the new one could not be created.
+            if( m_Swapchain != VK_NULL_HANDLE )
+            {
+                m_Device.Callbacks.DestroySwapchainKHR( m_Device.Handle, m_Swapchain, nullptr );
+            }
+
+            m_Swapchain = swapchain;
+            createInfo.oldSwapchain = VK_NULL_HANDLE;
+        }
+
+        if( result == VK_SUCCESS )
+        {
+            result = CreateSwapchainResources();
+        }
+
+        m_SwapchainOutdated = ( result != VK_SUCCESS );
+
+        return result;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        CreateSwapchainResources
+
+    Description:
+        Creates the command buffers and the synchronization objects used to
+        clear the swapchain images.
+
+    \*************************************************************************/
+    VkResult ProfilerViewer::CreateSwapchainResources()
+    {
+        uint32_t imageCount = 0;
+        m_Device.Callbacks.GetSwapchainImagesKHR( m_Device.Handle, m_Swapchain, &imageCount, nullptr );
+
+        m_SwapchainImages.resize( imageCount );
+        VkResult result = m_Device.Callbacks.GetSwapchainImagesKHR(
+            m_Device.Handle, m_Swapchain, &imageCount, m_SwapchainImages.data() );
+
+        if( result == VK_SUCCESS )
+        {
+            VkCommandBufferAllocateInfo allocateInfo = {};
+            allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocateInfo.commandPool = m_CommandPool;
+            allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+            allocateInfo.commandBufferCount = imageCount;
+
+            std::vector<VkCommandBuffer> commandBuffers( imageCount );
+            result = m_Device.Callbacks.AllocateCommandBuffers(
+                m_Device.Handle,
+                &allocateInfo,
+                commandBuffers.data() );
+
+            if( result == VK_SUCCESS )
+            {
+                m_CommandBuffers = std::move( commandBuffers );
+            }
+        }
+
+        VkFenceCreateInfo fenceCreateInfo = {};
+        fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        fenceCreateInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+        VkSemaphoreCreateInfo semaphoreCreateInfo = {};
+        semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+        for( uint32_t i = 0; ( i < imageCount ) && ( result == VK_SUCCESS ); ++i )
+        {
+            VkFence fence = VK_NULL_HANDLE;
+            result = m_Device.Callbacks.CreateFence( m_Device.Handle, &fenceCreateInfo, nullptr, &fence );
+
+            if( result == VK_SUCCESS )
+            {
+                m_CommandFences.push_back( fence );
+
+                VkSemaphore semaphore = VK_NULL_HANDLE;
+                result = m_Device.Callbacks.CreateSemaphore( m_Device.Handle, &semaphoreCreateInfo, nullptr, &semaphore );
+
+                if( result == VK_SUCCESS )
+                {
+                    m_AcquireSemaphores.push_back( semaphore );
+                }
+            }
+
+            if( result == VK_SUCCESS )
+            {
+                VkSemaphore semaphore = VK_NULL_HANDLE;
+                result = m_Device.Callbacks.CreateSemaphore( m_Device.Handle, &semaphoreCreateInfo, nullptr, &semaphore );
+
+                if( result == VK_SUCCESS )
+                {
+                    m_ClearSemaphores.push_back( semaphore );
+                }
+            }
+        }
+
+        // The image index is not known before the image is acquired, so an additional semaphore is required.
+        if( result == VK_SUCCESS )
+        {
+            result = m_Device.Callbacks.CreateSemaphore(
+                m_Device.Handle,
+                &semaphoreCreateInfo,
+                nullptr,
+                &m_NextAcquireSemaphore );
+        }
+
+        return result;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        DestroySwapchainResources
+
+    Description:
+        Destroys the objects created in CreateSwapchainResources.
+        The device must be idle.
+
+    \*************************************************************************/
+    void ProfilerViewer::DestroySwapchainResources()
+    {
+        if( !m_CommandBuffers.empty() )
+        {
+            m_Device.Callbacks.FreeCommandBuffers(
+                m_Device.Handle,
+                m_CommandPool,
+                static_cast<uint32_t>( m_CommandBuffers.size() ),
+                m_CommandBuffers.data() );
+        }
+
+        for( VkFence fence : m_CommandFences )
+        {
+            m_Device.Callbacks.DestroyFence( m_Device.Handle, fence, nullptr );
+        }
+
+        for( VkSemaphore semaphore : m_AcquireSemaphores )
+        {
+            m_Device.Callbacks.DestroySemaphore( m_Device.Handle, semaphore, nullptr );
+        }
+
+        for( VkSemaphore semaphore : m_ClearSemaphores )
+        {
+            m_Device.Callbacks.DestroySemaphore( m_Device.Handle, semaphore, nullptr );
+        }
+
+        if( m_NextAcquireSemaphore != VK_NULL_HANDLE )
+        {
+            m_Device.Callbacks.DestroySemaphore( m_Device.Handle, m_NextAcquireSemaphore, nullptr );
+        }
+
+        m_SwapchainImages.clear();
+        m_CommandBuffers.clear();
+        m_CommandFences.clear();
+        m_AcquireSemaphores.clear();
+        m_ClearSemaphores.clear();
+        m_NextAcquireSemaphore = VK_NULL_HANDLE;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        RenderFrame
+
+    Description:
+        Clears the next swapchain image, renders the overlay and presents it.
+
+    \*************************************************************************/
+    void ProfilerViewer::RenderFrame()
+    {
+        uint32_t imageIndex = 0;
+        VkResult result = m_Device.Callbacks.AcquireNextImageKHR(
+            m_Device.Handle,
+            m_Swapchain,
+            UINT64_MAX,
+            m_NextAcquireSemaphore,
+            VK_NULL_HANDLE,
+            &imageIndex );
+
+        if( result == VK_ERROR_OUT_OF_DATE_KHR )
+        {
+            m_SwapchainOutdated = true;
+            return;
+        }
+
+        if( result == VK_SUBOPTIMAL_KHR )
+        {
+            // The image can still be presented, recreate the swapchain in the next frame.
+            m_SwapchainOutdated = true;
+            result = VK_SUCCESS;
+        }
+
+        if( result == VK_SUCCESS )
+        {
+            // The fence guards the command buffer and the semaphores of the image.
+            VkFence fence = m_CommandFences[ imageIndex ];
+            m_Device.Callbacks.WaitForFences( m_Device.Handle, 1, &fence, VK_TRUE, UINT64_MAX );
+            m_Device.Callbacks.ResetFences( m_Device.Handle, 1, &fence );
+
+            // The semaphore previously used with this image is not in use anymore.
+            std::swap( m_NextAcquireSemaphore, m_AcquireSemaphores[ imageIndex ] );
+
+            VkCommandBufferBeginInfo beginInfo = {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+            result = m_Device.Callbacks.BeginCommandBuffer( m_CommandBuffers[ imageIndex ], &beginInfo );
+        }
+
+        if( result == VK_SUCCESS )
+        {
+            VkCommandBuffer commandBuffer = m_CommandBuffers[ imageIndex ];
+
+            VkImageMemoryBarrier barrier = {};
+            barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.srcAccessMask = 0;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image = m_SwapchainImages[ imageIndex ];
+            barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+
+            m_Device.Callbacks.CmdPipelineBarrier(
+                commandBuffer,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                0, 0, nullptr, 0, nullptr, 1, &barrier );
+
+            m_Device.Callbacks.CmdClearColorImage(
+                commandBuffer,
+                barrier.image,
+                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                &g_scClearColor,
+                1, &barrier.subresourceRange );
+
+            // The overlay loads the contents of the image in the present layout.
+            // The semaphore signaled after the clear makes the writes visible to the overlay.
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = 0;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+
+            m_Device.Callbacks.CmdPipelineBarrier(
+                commandBuffer,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                0, 0, nullptr, 0, nullptr, 1, &barrier );
+
+            result = m_Device.Callbacks.EndCommandBuffer( commandBuffer );
+        }
+
+        if( result == VK_SUCCESS )
+        {
+            // Synchronize access to the queue with the overlay, the same way the layer does.
+            VkQueue_Object_Scope queueScope( *m_pQueue );
+
+            const VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+
+            VkSubmitInfo submitInfo = {};
+            submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.waitSemaphoreCount = 1;
+            submitInfo.pWaitSemaphores = &m_AcquireSemaphores[ imageIndex ];
+            submitInfo.pWaitDstStageMask = &waitStage;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers = &m_CommandBuffers[ imageIndex ];
+            submitInfo.signalSemaphoreCount = 1;
+            submitInfo.pSignalSemaphores = &m_ClearSemaphores[ imageIndex ];
+
+            result = m_Device.Callbacks.QueueSubmit(
+                m_pQueue->Handle,
+                1, &submitInfo,
+                m_CommandFences[ imageIndex ] );
+
+            if( result == VK_SUCCESS )
+            {
+                VkPresentInfoKHR presentInfo = {};
+                presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+                presentInfo.waitSemaphoreCount = 1;
+                presentInfo.pWaitSemaphores = &m_ClearSemaphores[ imageIndex ];
+                presentInfo.swapchainCount = 1;
+                presentInfo.pSwapchains = &m_Swapchain;
+                presentInfo.pImageIndices = &imageIndex;
+
+                m_OverlayBackend.SetFramePresentInfo( presentInfo );
+
+                // Pass all frames published since the previous update, the overlay consumes one frame per update.
+                const uint64_t publishedFrameCount = m_Frontend.GetPublishedFrameCount();
+                const uint64_t updateCount = std::min<uint64_t>( publishedFrameCount - m_UpdatedFrameCount, ProfilerSharedMemoryFrameCount );
+
+                for( uint64_t i = 0; i < updateCount; ++i )
+                {
+                    m_pOverlay->Update();
+                }
+
+                m_UpdatedFrameCount = publishedFrameCount;
+
+                m_pOverlay->Present();
+
+                result = m_Device.Callbacks.QueuePresentKHR(
+                    m_pQueue->Handle,
+                    &m_OverlayBackend.GetFramePresentInfo() );
+            }
+        }
+
+        if( ( result == VK_ERROR_OUT_OF_DATE_KHR ) || ( result == VK_SUBOPTIMAL_KHR ) )
+        {
+            m_SwapchainOutdated = true;
+            result = VK_SUCCESS;
+        }
+
+        if( result != VK_SUCCESS )
+        {
+            ProfilerPlatformFunctions::WriteDebug( "Failed to present the overlay (VkResult %d)\n", result );
+            m_Exit = true;
+        }
+    }
+
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+    /*************************************************************************\
+
+    Function:
+        InitializeWindow
+
+    Description:
+        Creates the window of the viewer.
+
+    \*************************************************************************/
+    bool ProfilerViewer::InitializeWindow( const char* pTitle )
+    {
+        const HINSTANCE hInstance = GetModuleHandle( nullptr );
+
+        WNDCLASSEXA windowClass = {};
+        windowClass.cbSize = sizeof( windowClass );
+        windowClass.lpfnWndProc = ProfilerViewer::WindowProc;
+        windowClass.hInstance = hInstance;
+        windowClass.hCursor = LoadCursor( nullptr, IDC_ARROW );
+        windowClass.lpszClassName = "VkProfilerViewer";
+
+        // Registration fails if the class has already been registered by the previous window.
+        RegisterClassExA( &windowClass );
+
+        m_Window = CreateWindowExA(
+            0,
+            windowClass.lpszClassName,
+            pTitle,
+            WS_OVERLAPPEDWINDOW,
+            CW_USEDEFAULT, CW_USEDEFAULT,
+            g_scDefaultWindowWidth, g_scDefaultWindowHeight,
+            nullptr,
+            nullptr,
+            hInstance,
+            nullptr );
+
+        if( m_Window == nullptr )
+        {
+            return false;
+        }
+
+        SetWindowLongPtrA( m_Window, GWLP_USERDATA, reinterpret_cast<LONG_PTR>( this ) );
+        ShowWindow( m_Window, SW_SHOW );
+
+        return true;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        DestroyWindow
+
+    Description:
+        Destroys the window of the viewer.
+
+    \*************************************************************************/
+    void ProfilerViewer::DestroyWindow()
+    {
+        if( m_Window != nullptr )
+        {
+            ::DestroyWindow( m_Window );
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ProcessWindowEvents
+
+    Description:
+        Dispatches the messages sent to the window.
+
+    \*************************************************************************/
+    void ProfilerViewer::ProcessWindowEvents()
+    {
+        MSG msg = {};
+        while( PeekMessageA( &msg, nullptr, 0, 0, PM_REMOVE ) )
+        {
+            if( msg.message == WM_QUIT )
+            {
+                m_Exit = true;
+            }
+
+            TranslateMessage( &msg );
+            DispatchMessageA( &msg );
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        WindowProc
+
+    Description:
+        Handles the messages of the viewer window. Input messages are handled
+        by the platform backend of the overlay.
+
+    \*************************************************************************/
+    LRESULT CALLBACK ProfilerViewer::WindowProc( HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam )
+    {
+        ProfilerViewer* pViewer = reinterpret_cast<ProfilerViewer*>( GetWindowLongPtrA( hWnd, GWLP_USERDATA ) );
+
+        if( pViewer != nullptr )
+        {
+            switch( msg )
+            {
+            case WM_SIZE:
+                pViewer->m_SwapchainOutdated = true;
+                break;
+
+            case WM_CLOSE:
+                pViewer->m_Exit = true;
+                return 0;
+            }
+        }
+
+        return DefWindowProcA( hWnd, msg, wParam, lParam );
+    }
+
+#elif defined( VK_USE_PLATFORM_XCB_KHR )
+    /*************************************************************************\
+
+    Function:
+        InitializeWindow
+
+    Description:
+        Creates the window of the viewer.
+
+    \*************************************************************************/
+    bool ProfilerViewer::InitializeWindow( const char* pTitle )
+    {
+        m_pConnection = xcb_connect( nullptr, nullptr );
+
+        if( xcb_connection_has_error( m_pConnection ) )
+        {
+            return false;
+        }
+
+        xcb_screen_t* pScreen = xcb_setup_roots_iterator( xcb_get_setup( m_pConnection ) ).data;
+
+        // Input events are selected by the platform backend of the overlay.
+        const uint32_t valueMask = XCB_CW_BACK_PIXEL | XCB_CW_EVENT_MASK;
+        const uint32_t values[] = {
+            pScreen->black_pixel,
+            XCB_EVENT_MASK_STRUCTURE_NOTIFY };
+
+        m_Window = xcb_generate_id( m_pConnection );
+        xcb_create_window(
+            m_pConnection,
+            XCB_COPY_FROM_PARENT,
+            m_Window,
+            pScreen->root,
+            0, 0,
+            g_scDefaultWindowWidth, g_scDefaultWindowHeight,
+            0,
+            XCB_WINDOW_CLASS_INPUT_OUTPUT,
+            pScreen->root_visual,
+            valueMask,
+            values );
+
+        xcb_change_property(
+            m_pConnection,
+            XCB_PROP_MODE_REPLACE,
+            m_Window,
+            XCB_ATOM_WM_NAME,
+            XCB_ATOM_STRING,
+            8,
+            static_cast<uint32_t>( strlen( pTitle ) ),
+            pTitle );
+
+        // Ask the window manager to send a message instead of killing the connection when the window is closed.
+        xcb_intern_atom_cookie_t protocolsCookie = xcb_intern_atom( m_pConnection, 1, 12, "WM_PROTOCOLS" );
+        xcb_intern_atom_cookie_t deleteWindowCookie = xcb_intern_atom( m_pConnection, 0, 16, "WM_DELETE_WINDOW" );
+
+        xcb_intern_atom_reply_t* pProtocolsReply = xcb_intern_atom_reply( m_pConnection, protocolsCookie, nullptr );
+        xcb_intern_atom_reply_t* pDeleteWindowReply = xcb_intern_atom_reply( m_pConnection, deleteWindowCookie, nullptr );
+
+        if( pProtocolsReply && pDeleteWindowReply )
+        {
+            m_DeleteWindowAtom = pDeleteWindowReply->atom;
+
+            xcb_change_property(
+                m_pConnection,
+                XCB_PROP_MODE_REPLACE,
+                m_Window,
+                pProtocolsReply->atom,
+                XCB_ATOM_ATOM,
+                32,
+                1,
+                &m_DeleteWindowAtom );
+        }
+
+        free( pProtocolsReply );
+        free( pDeleteWindowReply );
+
+        xcb_map_window( m_pConnection, m_Window );
+        xcb_flush( m_pConnection );
+
+        return true;
+    }
+
+    /*************************************************************************\
+
+    Function:
+        DestroyWindow
+
+    Description:
+        Destroys the window of the viewer.
+
+    \*************************************************************************/
+    void ProfilerViewer::DestroyWindow()
+    {
+        if( m_pConnection != nullptr )
+        {
+            if( m_Window != 0 )
+            {
+                xcb_destroy_window( m_pConnection, m_Window );
+            }
+
+            xcb_disconnect( m_pConnection );
+        }
+    }
+
+    /*************************************************************************\
+
+    Function:
+        ProcessWindowEvents
+
+    Description:
+        Handles the events of the window. Input events are handled by the
+        platform backend of the overlay.
+
+    \*************************************************************************/
+    void ProfilerViewer::ProcessWindowEvents()
+    {
+        xcb_generic_event_t* pEvent = nullptr;
+        while( ( pEvent = xcb_poll_for_event( m_pConnection ) ) != nullptr )
+        {
+            switch( pEvent->response_type & ~0x80 )
+            {
+            case XCB_CONFIGURE_NOTIFY:
+            {
+                const xcb_configure_notify_event_t* pConfigureEvent =
+                    reinterpret_cast<const xcb_configure_notify_event_t*>( pEvent );
+
+                if( ( pConfigureEvent->width != m_SwapchainCreateInfo.imageExtent.width ) ||
+                    ( pConfigureEvent->height != m_SwapchainCreateInfo.imageExtent.height ) )
+                {
+                    m_SwapchainOutdated = true;
+                }
+                break;
+            }
+
+            case XCB_CLIENT_MESSAGE:
+            {
+                const xcb_client_message_event_t* pMessageEvent =
+                    reinterpret_cast<const xcb_client_message_event_t*>( pEvent );
+
+                if( pMessageEvent->data.data32[ 0 ] == m_DeleteWindowAtom )
+                {
+                    m_Exit = true;
+                }
+                break;
+            }
+            }
+
+            free( pEvent );
+        }
+
+        if( xcb_connection_has_error( m_pConnection ) )
+        {
+            m_Exit = true;
+        }
+    }
+#endif
+}
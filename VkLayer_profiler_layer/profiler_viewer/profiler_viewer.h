@@ -0,0 +1,112 @@
+// Copyright (c) 2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+#include "profiler_overlay/profiler_overlay.h"
+#include "profiler_overlay/profiler_overlay_layer_backend.h"
+#include "profiler_shared_memory/profiler_shared_memory_frontend.h"
+#include "profiler_layer_objects/VkDevice_object.h"
+#include "profiler_layer_objects/VkInstance_object.h"
+#include <memory>
+#include <vector>
+
+namespace Profiler
+{
+    /*************************************************************************\
+
+    Class:
+        ProfilerViewer
+
+    Description:
+        Displays the data published by ProfilerSharedMemoryOutput in the
+        overlay, rendered to a window of the viewer process.
+
+        The viewer creates its own Vulkan instance and device, and describes
+        them with the same objects the layer creates for the profiled
+        application, so the overlay backend can be used without the layer.
+
+    \*************************************************************************/
+    class ProfilerViewer
+    {
+    public:
+        ProfilerViewer();
+        ~ProfilerViewer();
+
+        bool Initialize( const char* pSegmentName );
+        void Destroy();
+
+        void Run();
+
+    private:
+        ProfilerSharedMemoryFrontend m_Frontend;
+
+        VkInstance_Object m_Instance;
+        VkDevice_Object m_Device;
+        VkQueue_Object* m_pQueue;
+
+        VkSurfaceKHR m_Surface;
+        VkSwapchainKHR m_Swapchain;
+        VkSwapchainCreateInfoKHR m_SwapchainCreateInfo;
+        std::vector<VkImage> m_SwapchainImages;
+        bool m_SwapchainOutdated;
+
+        VkCommandPool m_CommandPool;
+
+        // Acquired images are cleared before the overlay is rendered on top of them.
+        std::vector<VkCommandBuffer> m_CommandBuffers;
+        std::vector<VkFence> m_CommandFences;
+        std::vector<VkSemaphore> m_AcquireSemaphores;
+        std::vector<VkSemaphore> m_ClearSemaphores;
+        VkSemaphore m_NextAcquireSemaphore;
+
+        OverlayLayerBackend m_OverlayBackend;
+        std::unique_ptr<ProfilerOverlayOutput> m_pOverlay;
+
+        // Number of published frames passed to the overlay.
+        uint64_t m_UpdatedFrameCount;
+
+        bool m_Exit;
+
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+        HWND m_Window;
+#elif defined( VK_USE_PLATFORM_XCB_KHR )
+        xcb_connection_t* m_pConnection;
+        xcb_window_t m_Window;
+        xcb_atom_t m_DeleteWindowAtom;
+#endif
+
+        void ResetMembers();
+
+        bool InitializeWindow( const char* pTitle );
+        void DestroyWindow();
+        void ProcessWindowEvents();
+
+        VkResult CreateInstance();
+        VkResult CreateDevice();
+        VkResult CreateSwapchain();
+        VkResult CreateSwapchainResources();
+        void DestroySwapchainResources();
+
+        void RenderFrame();
+
+#ifdef VK_USE_PLATFORM_WIN32_KHR
+        static LRESULT CALLBACK WindowProc( HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam );
+#endif
+    };
+}
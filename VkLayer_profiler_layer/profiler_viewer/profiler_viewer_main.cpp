@@ -0,0 +1,84 @@
+// Copyright (c) 2026 Lukasz Stalmirski
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "profiler_viewer.h"
+
+#include <iostream>
+#include <string_view>
+
+using namespace Profiler;
+
+namespace
+{
+    /*************************************************************************\
+
+    Function:
+        PrintUsage
+
+    Description:
+        Prints command line syntax of the viewer.
+
+    \*************************************************************************/
+    void PrintUsage( const char* pProgramName )
+    {
+        std::cout <<
+            "Usage: " << pProgramName << " <segment>\n"
+            "\n"
+            "Displays the data published by the profiling layer to a shared memory segment\n"
+            "in the overlay. The layer publishes the data when the 'output' option is set to\n"
+            "'shared_memory'. By default the segments are named VkProfiler_<pid>_<index>.\n"
+            "\n"
+            "Options:\n"
+            "  -h, --help              Print this message.\n";
+    }
+}
+
+/*************************************************************************\
+
+Function:
+    main
+
+Description:
+    Entry point of the viewer.
+
+\*************************************************************************/
+int main( int argc, char** argv )
+{
+    const std::string_view arg = ( argc == 2 ) ? argv[ 1 ] : "";
+
+    if( arg.empty() || ( arg == "-h" ) || ( arg == "--help" ) )
+    {
+        PrintUsage( argv[ 0 ] );
+        return 1;
+    }
+
+    ProfilerViewer viewer;
+
+    if( !viewer.Initialize( argv[ 1 ] ) )
+    {
+        std::cerr << "Could not display shared memory segment '" << arg << "'.\n";
+        return 1;
+    }
+
+    viewer.Run();
+    viewer.Destroy();
+
+    return 0;
+}
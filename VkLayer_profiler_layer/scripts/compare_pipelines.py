@@ -18,12 +18,28 @@
 # OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 # SOFTWARE.
 
+import io
 import pathlib
 import json
 
+# Magic number at the beginning of each zstd frame.
+ZSTD_MAGIC = b'\x28\xb5\x2f\xfd'
+
+def load_trace(file_name):
+    with open(file_name, 'rb') as f:
+        if f.read(len(ZSTD_MAGIC)) != ZSTD_MAGIC:
+            f.seek(0)
+            return json.load(io.TextIOWrapper(f, encoding='utf-8'))
+        try:
+            import zstandard
+        except ImportError:
+            raise SystemExit(f'error: {file_name} is compressed with zstd, install the zstandard module to read it')
+        f.seek(0)
+        with zstandard.ZstdDecompressor().stream_reader(f, read_across_frames=True) as reader:
+            return json.load(io.TextIOWrapper(reader, encoding='utf-8'))
+
 def extract_pipelines(file_name):
-    with open(file_name) as f:
-        data = json.load(f)
+    data = load_trace(file_name)
     pipelines = {}
     current_pipeline = None
     current_pipeline_name = ''
@@ -45,13 +61,19 @@ def extract_pipelines(file_name):
                 continue
     return pipelines
 
+def get_trace_name(file_name):
+    path = pathlib.Path(file_name)
+    if path.suffix == '.zst':
+        path = path.with_suffix('')
+    return path.stem
+
 def compare_pipelines(trace_a, trace_b, name_a = None, name_b = None):
     pipelines_a = extract_pipelines(trace_a)
     pipelines_b = extract_pipelines(trace_b)
     if not name_a:
-        name_a = pathlib.Path(trace_a).stem
+        name_a = get_trace_name(trace_a)
     if not name_b:
-        name_b = pathlib.Path(trace_b).stem
+        name_b = get_trace_name(trace_b)
     print(f'Pipeline,{name_a},{name_b},Delta,Delta %')
     for pipeline_name in pipelines_a.keys():
         try: